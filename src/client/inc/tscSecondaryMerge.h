@@ -24,6 +24,7 @@ extern "C" {
 #include "qfill.h"
 #include "taosmsg.h"
 #include "tlosertree.h"
+#include "tmergetree.h"
 #include "tsclient.h"
 
 #define MAX_NUM_OF_SUBQUERY_RETRY 3
@@ -57,6 +58,8 @@ typedef struct SLocalReducer {
   int32_t                numOfCompleted;
   int32_t                numOfVnode;
   SLoserTreeInfo *       pLoserTree;
+  SMergeTree *           pMergeTree;         // instead of pLoserTree if ordered by one integer or timestamp column
+  int32_t                groupOrderType;     // order of the keys of pMergeTree
   char *                 prevRowOfInput;
   tFilePage *            pResultBuf;
   int32_t                nResultBufSize;
@@ -76,6 +79,8 @@ typedef struct SLocalReducer {
   SResultInfo *          pResInfo;
   bool                   discard;
   int32_t                offset;             // limit offset value
+  int32_t                sessionEndCol;      // column of the end of session windows, -1 if not a session query
+  int64_t                sessionEnd;         // end of the session window of previous rows
 } SLocalReducer;
 
 typedef struct SSubqueryState {
@@ -85,6 +90,7 @@ typedef struct SSubqueryState {
    */
   int32_t  numOfCompleted;
   int32_t  numOfTotal;          // number of total sub-queries
+  int32_t  numOfLaunched;       // number of launched sub-queries, the others are queued
   int32_t  code;                // code from subqueries
   uint64_t numOfRetrievedRows;  // total number of points in this query
 } SSubqueryState;
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TDENGINE_TSCSQLCACHE_H
+#define TDENGINE_TSCSQLCACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "tsclient.h"
+
+typedef struct SSqlTemplate SSqlTemplate;
+
+/*
+ * Validated select statements are kept in a cache of the client as templates, keyed by the current database and the
+ * statement with the values of the conditions replaced by '?'.
+ *
+ * A statement repeated with only different time range is built from the template directly, without tokenizing,
+ * parsing and validating the sql string. The template is discarded once the meta of the queried table is changed.
+ */
+void tscInitSqlCache();
+void tscCleanupSqlCache();
+
+/**
+ * Build the query of the sql string from the cached template.
+ *
+ * @param pSql
+ * @param code  result of the query built from the template, TSDB_CODE_ACTION_IN_PROGRESS if the vgroup list of
+ *              the super table is being retrieved
+ * @return      false if no template is available for the sql string, and it should be parsed
+ */
+bool tscGetQueryFromSqlCache(SSqlObj *pSql, int32_t *code);
+
+/**
+ * Keep the query of the successfully parsed sql string as a template.
+ *
+ * @param pSql
+ * @param parseStart  time in microsecond before the sql string is parsed, when the value of now is decided
+ */
+void tscPutQueryIntoSqlCache(SSqlObj *pSql, int64_t parseStart);
+
+/**
+ * Build the template of a prepared select statement from its parsed query. The template is only built if all the
+ * placeholders can be bound without parsing the sql string, i.e., the ones in the conditions on the primary timestamp
+ * column and the numeric normal columns, and the ones of limit and offset.
+ *
+ * @param pSql         the statement executed with the first bound values
+ * @param sql          sql string of the prepared statement with the placeholders
+ * @param params       the bound values
+ * @param numOfParams
+ * @param parseStart   time in microsecond before the sql string is parsed
+ * @return             NULL if the template is not available for the statement
+ */
+SSqlTemplate *tscCreateStmtTemplate(SSqlObj *pSql, const char *sql, tVariant *params, int32_t numOfParams,
+                                    int64_t parseStart);
+
+/**
+ * Build the query of the prepared statement from the template, with the new bound values.
+ *
+ * @return false if the template can not be used, e.g., the table meta is changed, and the sql string should be parsed
+ */
+bool tscGetQueryFromStmtTemplate(SSqlObj *pSql, SSqlTemplate *pTemplate, tVariant *params, int32_t *code);
+
+void tscDestroySqlTemplate(SSqlTemplate *pTemplate);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // TDENGINE_TSCSQLCACHE_H
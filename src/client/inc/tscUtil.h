@@ -184,6 +184,7 @@ void      tscSqlExprInfoDestroy(SArray* pExprInfo);
 SColumn* tscColumnClone(const SColumn* src);
 SColumn* tscColumnListInsert(SArray* pColList, SColumnIndex* colIndex);
 SArray* tscColumnListClone(const SArray* src, int16_t tableIndex);
+void    tscColumnListCopy(SArray* dst, const SArray* src, int16_t tableIndex);
 void tscColumnListDestroy(SArray* pColList);
 
 SColumnFilterInfo* tscFilterInfoClone(const SColumnFilterInfo* src, int32_t numOfFilters);
@@ -224,10 +225,21 @@ int32_t tscAddSubqueryInfo(SSqlCmd *pCmd);
 void tscInitQueryInfo(SQueryInfo* pQueryInfo);
 
 void tscClearSubqueryInfo(SSqlCmd* pCmd);
+void tscQueryInfoCopy(SQueryInfo* dst, const SQueryInfo* src);
+void tscQueryInfoDestroy(SQueryInfo* pQueryInfo);
 
 int  tscGetSTableVgroupInfo(SSqlObj* pSql, int32_t clauseIndex);
+
+/**
+ * Remove the vgroups of the super table from its vgroup list if none of their child tables can be qualified for the
+ * tag condition, according to the tag summary retrieved along with the vgroup list.
+ *
+ * @return the number of remaining vgroups
+ */
+int32_t tscPruneVgroupsByTagCond(SSqlObj* pSql, SQueryInfo* pQueryInfo, STableMetaInfo* pTableMetaInfo);
 int  tscGetTableMeta(SSqlObj* pSql, STableMetaInfo* pTableMetaInfo);
 int  tscGetMeterMetaEx(SSqlObj* pSql, STableMetaInfo* pTableMetaInfo, bool createIfNotExists);
+int32_t tscGetMultiTableMeta(SSqlObj* pSql, const char* tableIds, int32_t numOfTables);
 
 void tscResetForNextRetrieve(SSqlRes* pRes);
 
@@ -261,6 +273,7 @@ int16_t tscGetJoinTagColIndexByUid(STagCond* pTagCond, uint64_t uid);
 void tscPrintSelectClause(SSqlObj* pSql, int32_t subClauseIndex);
 
 bool hasMoreVnodesToTry(SSqlObj *pSql);
+bool tscSetVnodeExhausted(SSqlObj *pSql);
 void tscTryQueryNextVnode(SSqlObj *pSql, __async_cb_func_t fp);
 void tscAsyncQuerySingleRowForNextVnode(void *param, TAOS_RES *tres, int numOfRows);
 void tscTryQueryNextClause(SSqlObj* pSql, void (*queryFp)());
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TDENGINE_TSCWRITEBUFFER_H
+#define TDENGINE_TSCWRITEBUFFER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "tsclient.h"
+
+/*
+ * The inserts of the same user to the same vgroup, issued by any threads of the client, wait in the write buffer while
+ * a submit message is being sent to the vgroup, and are coalesced into the next submit message once it is written. At
+ * most tsWriteBufferSize bytes are coalesced into a message, the other inserts wait for the next ones. Only one message
+ * to a vgroup is in flight, so the inserts are written in the order they are put into the buffer. Each insert is
+ * notified with its own rows once the message is written.
+ *
+ * If the coalesced message fails, the inserts are sent one by one, so that the error of each insert is handled and
+ * reported to its own caller.
+ */
+void tscInitWriteBuffer();
+void tscCleanupWriteBuffer();
+
+/**
+ * @param pSql  the insert to a vgroup, of which the submit message has been copied into the payload
+ * @return      false if the insert should be sent separately, e.g., the buffer is disabled
+ */
+bool tscPutIntoWriteBuffer(SSqlObj *pSql);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // TDENGINE_TSCWRITEBUFFER_H
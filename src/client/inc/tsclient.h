@@ -65,6 +65,7 @@ typedef struct STableMeta {
 typedef struct STableMetaInfo {
   STableMeta *  pTableMeta;      // table meta, cached in client side and acquired by name
   SVgroupsInfo *vgroupList;
+  int64_t       vgroupListVersion;  // version of vgroupList given by mnode
   SArray       *pVgroupTables;   // SArray<SVgroupTableInfo>
   
   /*
@@ -197,6 +198,9 @@ typedef struct SQueryInfo {
   STimeWindow     window;
   int64_t         intervalTime;  // aggregation time interval
   int64_t         slidingTime;   // sliding window in mseconds
+  int8_t          windowType;    // session or state window query
+  int64_t         sessionGap;    // max time gap between the adjacent rows of a session window
+  int16_t         stateColId;    // rows are in one state window until the value of this column changes
   SSqlGroupbyExpr groupbyExpr;   // group by tags info
 
   SArray *         colList;      // SArray<SColumn*>
@@ -311,6 +315,7 @@ typedef struct SSqlObj {
   uint32_t         queryId;
   void *           pStream;
   void *           pSubscription;
+  void *           pStmt;  // the prepared statement, of which the query is built from the template once parsed
   char *           sqlstr;
   char             retry;
   char             maxRetry;
@@ -320,7 +325,7 @@ typedef struct SSqlObj {
   tsem_t           rspSem;
   SSqlCmd          cmd;
   SSqlRes          res;
-  uint8_t          numOfSubs;
+  int32_t          numOfSubs;
   struct SSqlObj **pSubs;
   struct SSqlObj * prev, *next;
 } SSqlObj;
@@ -417,8 +422,13 @@ int32_t tscInvalidSQLErrMsg(char *msg, const char *additionalInfo, const char *s
 
 void    tscQueueAsyncFreeResult(SSqlObj *pSql);
 int32_t tscToSQLCmd(SSqlObj *pSql, struct SSqlInfo *pInfo);
+int32_t tscGetTimeRangeFromTokens(STimeWindow *win, SSQLToken *pValue, int32_t numOfTokens, int32_t optr,
+                                  int16_t timePrecision);
 void    tscGetResultColumnChr(SSqlRes *pRes, SFieldInfo* pFieldInfo, int32_t column);
 
+bool tscGetQueryFromStmt(SSqlObj *pSql, int32_t *code);
+void tscKeepStmtTemplate(SSqlObj *pSql, int64_t parseStart);
+
 extern void *    tscCacheHandle;
 extern void *    tscTmr;
 extern void *    tscQhandle;
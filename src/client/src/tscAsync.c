@@ -164,6 +164,12 @@ static void tscProcessAsyncRetrieveImpl(void *param, TAOS_RES *tres, int numOfRo
   SSqlCmd *pCmd = &pSql->cmd;
   SSqlRes *pRes = &pSql->res;
 
+  // no qualified tables in the vnode, try the next one
+  if (pRes->qhandle == 0 && numOfRows == 0 && tscSetVnodeExhausted(pSql)) {
+    (*fp)(param, tres, 0);
+    return;
+  }
+
   if ((pRes->qhandle == 0 || numOfRows != 0) && pCmd->command < TSDB_SQL_LOCAL) {
     if (pRes->qhandle == 0) {
       tscError("qhandle is NULL");
@@ -208,7 +214,7 @@ void taos_fetch_rows_a(TAOS_RES *taosa, void (*fp)(void *, TAOS_RES *, int), voi
   SSqlRes *pRes = &pSql->res;
   SSqlCmd *pCmd = &pSql->cmd;
 
-  if (pRes->qhandle == 0) {
+  if (pRes->qhandle == 0 && !tscSetVnodeExhausted(pSql)) {
     tscError("qhandle is NULL");
     tscQueueAsyncError(fp, param, TSDB_CODE_INVALID_QHANDLE);
     return;
@@ -466,7 +472,15 @@ void tscTableMetaCallBack(void *param, TAOS_RES *res, int code) {
 
       if (code == TSDB_CODE_ACTION_IN_PROGRESS) return;
     } else {  // normal async query continues
-      if (pCmd->parseFinished) {
+      if (pCmd->parseFinished && pCmd->command == TSDB_SQL_SELECT) {
+        // the query is built from the sql template, only the vgroup list of the super table is retrieved
+        tscTrace("%p vgroup list is retrieved for the query built from sql template", pSql);
+
+        if (tscPruneVgroupsByTagCond(pSql, pQueryInfo, tscGetMetaInfo(pQueryInfo, 0)) == 0) {
+          pQueryInfo->command = TSDB_SQL_RETRIEVE_EMPTY_RESULT;
+          pCmd->command = TSDB_SQL_RETRIEVE_EMPTY_RESULT;
+        }
+      } else if (pCmd->parseFinished) {
         tscTrace("%p re-send data to vnode in table Meta callback since sql parsed completed", pSql);
         
         STableMetaInfo* pTableMetaInfo = tscGetTableMetaInfoFromCmd(pCmd, pCmd->clauseIndex, 0);
@@ -523,3 +537,18 @@ void tscTableMetaCallBack(void *param, TAOS_RES *res, int code) {
 
   tscDoQuery(pSql);
 }
+
+/*
+ * the meta of the tables are put in cache if the multi-table meta is retrieved, otherwise they are retrieved
+ * one by one during parsing, so the parse of sql string is resumed in both cases.
+ */
+void tscMultiTableMetaCallBack(void *param, TAOS_RES *res, int code) {
+  SSqlObj *pSql = (SSqlObj *)param;
+  if (pSql == NULL || pSql->signature != pSql) return;
+
+  if (code < 0) {
+    tscTrace("%p failed to get multi table meta, code:%s, get table meta one by one", pSql, tstrerror(code));
+  }
+
+  tscTableMetaCallBack(param, res, TSDB_CODE_SUCCESS);
+}
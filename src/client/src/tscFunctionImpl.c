@@ -82,12 +82,6 @@ typedef struct tValuePair {
   char *   pTags;  // the corresponding tags of each record in the final result
 } tValuePair;
 
-typedef struct SSpreadInfo {
-  double min;
-  double max;
-  int8_t hasResult;
-} SSpreadInfo;
-
 typedef struct SSumInfo {
   union {
     int64_t isum;
@@ -105,8 +99,7 @@ typedef struct SAvgInfo {
 typedef struct SStddevInfo {
   double  avg;
   int64_t num;
-  double  res;
-  int8_t  stage;
+  double  m2;  // sum of the squared deviations from avg
 } SStddevInfo;
 
 typedef struct SFirstLastInfo {
@@ -216,6 +209,12 @@ int32_t getResultDataInfo(int32_t dataType, int32_t dataBytes, int32_t functionI
       *interBytes = *bytes;
       return TSDB_CODE_SUCCESS;
       
+    } else if (functionId == TSDB_FUNC_STDDEV || functionId == TSDB_FUNC_VARIANCE) {
+      *type = TSDB_DATA_TYPE_BINARY;
+      *bytes = sizeof(SStddevInfo);
+      *interBytes = *bytes;
+      return TSDB_CODE_SUCCESS;
+      
     } else if (functionId >= TSDB_FUNC_RATE && functionId <= TSDB_FUNC_AVG_IRATE) {
       *type = TSDB_DATA_TYPE_DOUBLE;
       *bytes = sizeof(SRateInfo);
@@ -284,7 +283,7 @@ int32_t getResultDataInfo(int32_t dataType, int32_t dataBytes, int32_t functionI
     *type = TSDB_DATA_TYPE_DOUBLE;
     *bytes = sizeof(double);
     *interBytes = sizeof(SRateInfo);
-  } else if (functionId == TSDB_FUNC_STDDEV) {
+  } else if (functionId == TSDB_FUNC_STDDEV || functionId == TSDB_FUNC_VARIANCE) {
     *type = TSDB_DATA_TYPE_DOUBLE;
     *bytes = sizeof(double);
     *interBytes = sizeof(SStddevInfo);
@@ -1327,141 +1326,193 @@ static void min_function_f(SQLFunctionCtx *pCtx, int32_t index) {
   }
 }
 
-#define LOOP_STDDEV_IMPL(type, r, d, ctx, delta, tsdbType)             \
-  for (int32_t i = 0; i < (ctx)->size; ++i) {                          \
-    if ((ctx)->hasNull && isNull((char *)&((type *)d)[i], tsdbType)) { \
-      continue;                                                        \
-    }                                                                  \
-    (r) += POW2(((type *)d)[i] - (delta));                             \
+/*
+ * The standard deviation and variance are calculated in one scan: the count, mean and the sum of squared deviations
+ * from the mean (m2) of each data block are merged into the result by the parallel algorithm of Chan et al., which is
+ * also used to merge the intermediate results of the vnodes for super table query.
+ */
+static void stddev_merge_info(SStddevInfo *pStd, int64_t num, double avg, double m2) {
+  if (num <= 0) {
+    return;
+  }
+
+  if (pStd->num == 0) {
+    pStd->num = num;
+    pStd->avg = avg;
+    pStd->m2 = m2;
+    return;
+  }
+
+  int64_t total = pStd->num + num;
+  double  delta = avg - pStd->avg;
+
+  pStd->avg += delta * num / total;
+  pStd->m2 += m2 + delta * delta * ((double)pStd->num * num / total);
+  pStd->num = total;
+}
+
+// the mean of the block is calculated first, so that m2 is the sum of the squared deviations of small magnitude
+#define LOOP_STDDEV_IMPL(type, d, ctx, num, avg, m2)                        \
+  {                                                                         \
+    type * p = (type *)(d);                                                 \
+    double sum = 0;                                                         \
+    for (int32_t i = 0; i < (ctx)->size; ++i) {                             \
+      if ((ctx)->hasNull && isNull((char *)&p[i], (ctx)->inputType)) {      \
+        continue;                                                           \
+      }                                                                     \
+      sum += p[i];                                                          \
+      (num)++;                                                              \
+    }                                                                       \
+    if ((num) > 0) {                                                        \
+      (avg) = sum / (num);                                                  \
+      for (int32_t i = 0; i < (ctx)->size; ++i) {                           \
+        if ((ctx)->hasNull && isNull((char *)&p[i], (ctx)->inputType)) {    \
+          continue;                                                         \
+        }                                                                   \
+        (m2) += POW2(p[i] - (avg));                                         \
+      }                                                                     \
+    }                                                                       \
   }
 
 static void stddev_function(SQLFunctionCtx *pCtx) {
-  // the second stage to calculate standard deviation
-  SStddevInfo *pStd = GET_RES_INFO(pCtx)->interResultBuf;
+  SResultInfo *pResInfo = GET_RES_INFO(pCtx);
+  SStddevInfo *pStd = pResInfo->interResultBuf;
   
-  if (pStd->stage == 0) {  // the first stage is to calculate average value
-    avg_function(pCtx);
-  } else {
-    double *retVal = &pStd->res;
-    double  avg = pStd->avg;
-    
-    void *pData = GET_INPUT_CHAR(pCtx);
-    
-    switch (pCtx->inputType) {
-      case TSDB_DATA_TYPE_INT: {
-        for (int32_t i = 0; i < pCtx->size; ++i) {
-          if (pCtx->hasNull && isNull((const char*) (&((int32_t *)pData)[i]), pCtx->inputType)) {
-            continue;
-          }
-          *retVal += POW2(((int32_t *)pData)[i] - avg);
-        }
-        break;
-      }
-      case TSDB_DATA_TYPE_FLOAT: {
-        LOOP_STDDEV_IMPL(float, *retVal, pData, pCtx, avg, pCtx->inputType);
-        break;
-      }
-      case TSDB_DATA_TYPE_DOUBLE: {
-        LOOP_STDDEV_IMPL(double, *retVal, pData, pCtx, avg, pCtx->inputType);
-        break;
-      }
-      case TSDB_DATA_TYPE_BIGINT: {
-        LOOP_STDDEV_IMPL(int64_t, *retVal, pData, pCtx, avg, pCtx->inputType);
-        break;
-      }
-      case TSDB_DATA_TYPE_SMALLINT: {
-        LOOP_STDDEV_IMPL(int16_t, *retVal, pData, pCtx, avg, pCtx->inputType);
-        break;
-      }
-      case TSDB_DATA_TYPE_TINYINT: {
-        LOOP_STDDEV_IMPL(int8_t, *retVal, pData, pCtx, avg, pCtx->inputType);
-        break;
-      }
-      default:
-        tscError("stddev function not support data type:%d", pCtx->inputType);
+  int64_t num = 0;
+  double  avg = 0;
+  double  m2 = 0;
+  
+  void *pData = GET_INPUT_CHAR(pCtx);
+  
+  switch (pCtx->inputType) {
+    case TSDB_DATA_TYPE_INT: {
+      LOOP_STDDEV_IMPL(int32_t, pData, pCtx, num, avg, m2);
+      break;
     }
-    
-    // TODO get the correct data
-    SET_VAL(pCtx, 1, 1);
+    case TSDB_DATA_TYPE_FLOAT: {
+      LOOP_STDDEV_IMPL(float, pData, pCtx, num, avg, m2);
+      break;
+    }
+    case TSDB_DATA_TYPE_DOUBLE: {
+      LOOP_STDDEV_IMPL(double, pData, pCtx, num, avg, m2);
+      break;
+    }
+    case TSDB_DATA_TYPE_BIGINT: {
+      LOOP_STDDEV_IMPL(int64_t, pData, pCtx, num, avg, m2);
+      break;
+    }
+    case TSDB_DATA_TYPE_SMALLINT: {
+      LOOP_STDDEV_IMPL(int16_t, pData, pCtx, num, avg, m2);
+      break;
+    }
+    case TSDB_DATA_TYPE_TINYINT: {
+      LOOP_STDDEV_IMPL(int8_t, pData, pCtx, num, avg, m2);
+      break;
+    }
+    default:
+      tscError("stddev function not support data type:%d", pCtx->inputType);
+  }
+  
+  SET_VAL(pCtx, num, 1);
+  stddev_merge_info(pStd, num, avg, m2);
+  
+  if (num > 0) {
+    pResInfo->hasResult = DATA_SET_FLAG;
+  }
+  
+  // keep the data into the final output buffer for super table query since this execution may be the last one
+  if (pResInfo->superTableQ) {
+    memcpy(pCtx->aOutputBuf, pResInfo->interResultBuf, sizeof(SStddevInfo));
   }
 }
 
 static void stddev_function_f(SQLFunctionCtx *pCtx, int32_t index) {
-  // the second stage to calculate standard deviation
+  void *pData = GET_INPUT_CHAR_INDEX(pCtx, index);
+  if (pCtx->hasNull && isNull(pData, pCtx->inputType)) {
+    return;
+  }
+  
   SResultInfo *pResInfo = GET_RES_INFO(pCtx);
   SStddevInfo *pStd = pResInfo->interResultBuf;
   
-  /* the first stage is to calculate average value */
-  if (pStd->stage == 0) {
-    avg_function_f(pCtx, index);
-  } else {
-    double avg = pStd->avg;
-    void * pData = GET_INPUT_CHAR_INDEX(pCtx, index);
-    
-    if (pCtx->hasNull && isNull(pData, pCtx->inputType)) {
-      return;
+  double v = 0;
+  switch (pCtx->inputType) {
+    case TSDB_DATA_TYPE_INT: {
+      v = GET_INT32_VAL(pData);
+      break;
     }
-    
-    switch (pCtx->inputType) {
-      case TSDB_DATA_TYPE_INT: {
-        pStd->res += POW2(GET_INT32_VAL(pData) - avg);
-        break;
-      }
-      case TSDB_DATA_TYPE_FLOAT: {
-        pStd->res += POW2(GET_FLOAT_VAL(pData) - avg);
-        break;
-      }
-      case TSDB_DATA_TYPE_DOUBLE: {
-        pStd->res += POW2(GET_DOUBLE_VAL(pData) - avg);
-        break;
-      }
-      case TSDB_DATA_TYPE_BIGINT: {
-        pStd->res += POW2(GET_INT64_VAL(pData) - avg);
-        break;
-      }
-      case TSDB_DATA_TYPE_SMALLINT: {
-        pStd->res += POW2(GET_INT16_VAL(pData) - avg);
-        break;
-      }
-      case TSDB_DATA_TYPE_TINYINT: {
-        pStd->res += POW2(GET_INT8_VAL(pData) - avg);
-        break;
-      }
-      default:
-        tscError("stddev function not support data type:%d", pCtx->inputType);
+    case TSDB_DATA_TYPE_FLOAT: {
+      v = GET_FLOAT_VAL(pData);
+      break;
     }
-    
-    SET_VAL(pCtx, 1, 1);
+    case TSDB_DATA_TYPE_DOUBLE: {
+      v = GET_DOUBLE_VAL(pData);
+      break;
+    }
+    case TSDB_DATA_TYPE_BIGINT: {
+      v = GET_INT64_VAL(pData);
+      break;
+    }
+    case TSDB_DATA_TYPE_SMALLINT: {
+      v = GET_INT16_VAL(pData);
+      break;
+    }
+    case TSDB_DATA_TYPE_TINYINT: {
+      v = GET_INT8_VAL(pData);
+      break;
+    }
+    default:
+      tscError("stddev function not support data type:%d", pCtx->inputType);
+      return;
+  }
+  
+  // Welford's update with one value
+  pStd->num += 1;
+  
+  double delta = v - pStd->avg;
+  pStd->avg += delta / pStd->num;
+  pStd->m2 += delta * (v - pStd->avg);
+  
+  SET_VAL(pCtx, 1, 1);
+  pResInfo->hasResult = DATA_SET_FLAG;
+  
+  if (pResInfo->superTableQ) {
+    memcpy(pCtx->aOutputBuf, pResInfo->interResultBuf, sizeof(SStddevInfo));
   }
 }
 
-static void stddev_next_step(SQLFunctionCtx *pCtx) {
-  /*
-   * the stddevInfo and the average info struct share the same buffer area
-   * And the position of each element in their struct is exactly the same matched
-   */
+static void stddev_func_merge(SQLFunctionCtx *pCtx) {
   SResultInfo *pResInfo = GET_RES_INFO(pCtx);
-  SStddevInfo *pStd = pResInfo->interResultBuf;
+  assert(pResInfo->superTableQ);
   
-  if (pStd->stage == 0) {
-    /*
-     * stddev is calculated in two stage:
-     * 1. get the average value of all data;
-     * 2. get final result, based on the average values;
-     * so, if this routine is in second stage, no further step is required
-     */
-    pStd->stage++;
-    avg_finalizer(pCtx);
-    
-    pResInfo->initialized = true; // set it initialized to avoid re-initialization
-    
-    // save average value into tmpBuf, for second stage scan
-    SAvgInfo *pAvg = pResInfo->interResultBuf;
-    
-    pStd->avg = GET_DOUBLE_VAL(pCtx->aOutputBuf);
-    assert((isnan(pAvg->sum) && pAvg->num == 0) || (pStd->num == pAvg->num && pStd->avg == pAvg->sum));
-  } else {
-    pResInfo->complete = true;
+  SStddevInfo *pStd = (SStddevInfo *)pResInfo->interResultBuf;
+  char *       input = GET_INPUT_CHAR(pCtx);
+  
+  for (int32_t i = 0; i < pCtx->size; ++i, input += pCtx->inputBytes) {
+    SStddevInfo *pInput = (SStddevInfo *)input;
+    stddev_merge_info(pStd, pInput->num, pInput->avg, pInput->m2);
+  }
+  
+  if (pStd->num > 0) {
+    pResInfo->hasResult = DATA_SET_FLAG;
+    memcpy(pCtx->aOutputBuf, pResInfo->interResultBuf, sizeof(SStddevInfo));
+  }
+}
+
+// the output buffer only holds the final result, so the merged intermediate result is kept in the interResultBuf
+static void stddev_func_second_merge(SQLFunctionCtx *pCtx) {
+  SResultInfo *pResInfo = GET_RES_INFO(pCtx);
+  
+  SStddevInfo *pStd = (SStddevInfo *)pResInfo->interResultBuf;
+  char *       input = GET_INPUT_CHAR(pCtx);
+  
+  for (int32_t i = 0; i < pCtx->size; ++i, input += pCtx->inputBytes) {
+    SStddevInfo *pInput = (SStddevInfo *)input;
+    stddev_merge_info(pStd, pInput->num, pInput->avg, pInput->m2);
+  }
+  
+  if (pStd->num > 0) {
+    pResInfo->hasResult = DATA_SET_FLAG;
   }
 }
 
@@ -1471,8 +1522,8 @@ static void stddev_finalizer(SQLFunctionCtx *pCtx) {
   if (pStd->num <= 0) {
     setNull(pCtx->aOutputBuf, pCtx->outputType, pCtx->outputBytes);
   } else {
-    double *retValue = (double *)pCtx->aOutputBuf;
-    *retValue = sqrt(pStd->res / pStd->num);
+    double variance = pStd->m2 / pStd->num;
+    *(double *)pCtx->aOutputBuf = (pCtx->functionId == TSDB_FUNC_VARIANCE) ? variance : sqrt(variance);
     SET_VAL(pCtx, 1, 1);
   }
   
@@ -4492,8 +4543,8 @@ int32_t funcCompatDefList[] = {
     4,         -1,       -1,         1,        1,      1,          1,           1,        1,     -1,
     //  tag,       colprj,  tagprj,   arithmetic, diff, first_dist, last_dist,    interp      rate   irate
     1,          1,        1,         1,       -1,      1,          1,           5,        1,      1,
-    // sum_rate, sum_irate, avg_rate, avg_irate
-    1,          1,        1,         1,
+    // sum_rate, sum_irate, avg_rate, avg_irate, tid_tag, variance
+    1,          1,        1,         1,        1,       1,
 };
 
 SQLAggFuncElem aAggs[] = {{
@@ -4575,15 +4626,15 @@ SQLAggFuncElem aAggs[] = {{
                               // 5
                               "stddev",
                               TSDB_FUNC_STDDEV,
-                              TSDB_FUNC_INVALID_ID,
-                              TSDB_FUNCSTATE_SO | TSDB_FUNCSTATE_STREAM | TSDB_FUNCSTATE_OF,
+                              TSDB_FUNC_STDDEV,
+                              TSDB_BASE_FUNC_SO,
                               function_setup,
                               stddev_function,
                               stddev_function_f,
-                              stddev_next_step,
+                              no_next_step,
                               stddev_finalizer,
-                              noop1,
-                              noop1,
+                              stddev_func_merge,
+                              stddev_func_second_merge,
                               data_req_load_info,
                           },
                           {
@@ -5024,4 +5075,19 @@ SQLAggFuncElem aAggs[] = {{
                               noop1,
                               noop1,
                               data_req_load_info,
+                          },
+                          {
+                              // 35, shares the intermediate result and the routines with stddev
+                              "variance",
+                              TSDB_FUNC_VARIANCE,
+                              TSDB_FUNC_VARIANCE,
+                              TSDB_BASE_FUNC_SO,
+                              function_setup,
+                              stddev_function,
+                              stddev_function_f,
+                              no_next_step,
+                              stddev_finalizer,
+                              stddev_func_merge,
+                              stddev_func_second_merge,
+                              data_req_load_info,
                           }};
@@ -22,12 +22,14 @@
 
 #include "hash.h"
 #include "tscUtil.h"
+#include "tcache.h"
 #include "tschemautil.h"
 #include "tsclient.h"
 #include "ttokendef.h"
 #include "taosdef.h"
 
 #include "tscLog.h"
+#include "tscSqlCache.h"
 #include "tscSubquery.h"
 #include "tstoken.h"
 #include "ttime.h"
@@ -1003,6 +1005,185 @@ static int32_t validateDataSource(SSqlCmd *pCmd, int8_t type, const char *sql) {
   return TSDB_CODE_SUCCESS;
 }
 
+static char *tscNextToken(char *str, SSQLToken *pToken) {
+  int32_t index = 0;
+  *pToken = tStrGetToken(str, &index, false, 0, NULL);
+  return str + index;
+}
+
+// skip the tokens till the right parenthesis that matches the consumed left one, NULL if not found
+static char *tscSkipParenthesis(char *str) {
+  SSQLToken sToken = {0};
+
+  for (int32_t depth = 1; depth > 0;) {
+    str = tscNextToken(str, &sToken);
+    if (sToken.n == 0) {
+      return NULL;
+    }
+
+    if (sToken.type == TK_LP) {
+      depth++;
+    } else if (sToken.type == TK_RP) {
+      depth--;
+    }
+  }
+
+  return str;
+}
+
+static bool tscAddPrefetchTable(SSqlObj *pSql, SSQLToken *pToken, STableMetaInfo *pTableMetaInfo, SHashObj *pTables,
+                                char **tableIds, int32_t *numOfTables, int32_t *capacity) {
+  if (pToken->n == 0 || pToken->n >= TSDB_TABLE_NAME_LEN || validateTableName(pToken->z, pToken->n) != TSDB_CODE_SUCCESS) {
+    return false;
+  }
+
+  pTableMetaInfo->name[0] = 0;
+  if (tscSetTableId(pTableMetaInfo, pToken, pSql) != TSDB_CODE_SUCCESS) {
+    return false;
+  }
+
+  size_t len = strlen(pTableMetaInfo->name);
+  if (taosHashGet(pTables, pTableMetaInfo->name, len) != NULL) {
+    return true;
+  }
+
+  taosHashPut(pTables, pTableMetaInfo->name, len, numOfTables, sizeof(int32_t));
+
+  void *pTableMeta = taosCacheAcquireByName(tscCacheHandle, pTableMetaInfo->name);
+  if (pTableMeta != NULL) {
+    taosCacheRelease(tscCacheHandle, &pTableMeta, false);
+    return true;
+  }
+
+  if (*numOfTables >= *capacity) {
+    int32_t newCapacity = (*capacity == 0) ? 16 : (*capacity) * 2;
+    char *  tmp = realloc(*tableIds, (size_t)newCapacity * TSDB_TABLE_ID_LEN);
+    if (tmp == NULL) {
+      return false;
+    }
+
+    *tableIds = tmp;
+    *capacity = newCapacity;
+  }
+
+  strncpy(*tableIds + (*numOfTables) * TSDB_TABLE_ID_LEN, pTableMetaInfo->name, TSDB_TABLE_ID_LEN);
+  (*numOfTables)++;
+  return true;
+}
+
+/*
+ * Retrieve the meta of the tables in a multi-table insert statement that are not in cache by one request, instead of
+ * one request per table while parsing. The statement is scanned without being checked, the scan is given up once
+ * anything unexpected is met, and the errors are reported by the parser afterwards.
+ *
+ * The tables to be created by the "using" clause are still created one by one during parsing, since their tags are
+ * parsed against the meta of their super tables, which are retrieved here.
+ */
+static int32_t tscPrefetchTableMeta(SSqlObj *pSql, char *str) {
+  SHashObj *pTables = taosHashInit(128, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false);
+  if (pTables == NULL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  STableMetaInfo tableMetaInfo = {0};
+  SSQLToken      sToken = {0};
+  char *         tableIds = NULL;
+  int32_t        numOfTables = 0;
+  int32_t        capacity = 0;
+  bool           valid = true;
+
+  while (numOfTables < TSDB_MULTI_METERMETA_MAX_NUM) {
+    str = tscNextToken(str, &sToken);
+    if (sToken.n == 0) {
+      break;
+    }
+
+    if (!(valid = tscAddPrefetchTable(pSql, &sToken, &tableMetaInfo, pTables, &tableIds, &numOfTables, &capacity))) {
+      break;
+    }
+
+    str = tscNextToken(str, &sToken);
+    if (sToken.type == TK_LP) {  // column list before the using clause
+      if ((str = tscSkipParenthesis(str)) == NULL) {
+        valid = false;
+        break;
+      }
+
+      str = tscNextToken(str, &sToken);
+    }
+
+    if (sToken.type == TK_USING) {
+      str = tscNextToken(str, &sToken);
+      if (!(valid = tscAddPrefetchTable(pSql, &sToken, &tableMetaInfo, pTables, &tableIds, &numOfTables, &capacity))) {
+        break;
+      }
+
+      str = tscNextToken(str, &sToken);
+      if (sToken.type == TK_LP && (str = tscSkipParenthesis(str)) != NULL) {  // the tag names
+        str = tscNextToken(str, &sToken);
+      }
+
+      if (str == NULL || sToken.type != TK_TAGS) {
+        valid = false;
+        break;
+      }
+
+      str = tscNextToken(str, &sToken);
+      if (sToken.type != TK_LP || (str = tscSkipParenthesis(str)) == NULL) {
+        valid = false;
+        break;
+      }
+
+      str = tscNextToken(str, &sToken);
+      if (sToken.type == TK_LP) {  // column list after the using clause
+        if ((str = tscSkipParenthesis(str)) == NULL) {
+          valid = false;
+          break;
+        }
+
+        str = tscNextToken(str, &sToken);
+      }
+    }
+
+    if (sToken.type == TK_VALUES) {
+      int32_t numOfRows = 0;
+      while (1) {
+        char *next = tscNextToken(str, &sToken);
+        if (sToken.type != TK_LP) {
+          break;
+        }
+
+        if ((str = tscSkipParenthesis(next)) == NULL) {
+          break;
+        }
+
+        numOfRows++;
+      }
+
+      if (str == NULL || numOfRows == 0) {
+        valid = false;
+        break;
+      }
+    } else if (sToken.type == TK_FILE) {
+      str = tscNextToken(str, &sToken);
+    } else {
+      valid = false;
+      break;
+    }
+  }
+
+  taosHashCleanup(pTables);
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  if (valid && numOfTables > 1) {
+    tscTrace("%p prefetch the meta of %d tables for insert", pSql, numOfTables);
+    code = tscGetMultiTableMeta(pSql, tableIds, numOfTables);
+  }
+
+  tfree(tableIds);
+  return code;
+}
+
 /**
  * usage: insert into table1 values() () table2 values()()
  *
@@ -1046,6 +1227,15 @@ int doParseInsertSql(SSqlObj *pSql, char *str) {
       code = TSDB_CODE_CLI_OUT_OF_MEMORY;
       goto _error_clean;
     }
+
+    // the parse is resumed from the start of the statement once the meta is retrieved
+    pCmd->curSql = str;
+    if ((code = tscPrefetchTableMeta(pSql, str)) == TSDB_CODE_ACTION_IN_PROGRESS) {
+      return code;
+    }
+
+    pCmd->curSql = NULL;
+    code = TSDB_CODE_SUCCESS;
   } else {
     assert((NULL != pCmd->curSql) && (NULL != pCmd->pTableList));
     str = pCmd->curSql;
@@ -1351,11 +1541,23 @@ int tsParseSql(SSqlObj *pSql, bool initialParse) {
       return ret;
     }
     
+    if (initialParse && (tscGetQueryFromStmt(pSql, &ret) || tscGetQueryFromSqlCache(pSql, &ret))) {
+      return ret;
+    }
+
+    int64_t parseStart = taosGetTimestampUs();
+
     SSqlInfo SQLInfo = {0};
     tSQLParse(&SQLInfo, pSql->sqlstr);
 
     ret = tscToSQLCmd(pSql, &SQLInfo);
     SQLInfoDestroy(&SQLInfo);
+
+    if (ret == TSDB_CODE_SUCCESS && pSql->pStmt != NULL) {
+      tscKeepStmtTemplate(pSql, parseStart);
+    } else if (ret == TSDB_CODE_SUCCESS) {
+      tscPutQueryIntoSqlCache(pSql, parseStart);
+    }
   }
 
   /*
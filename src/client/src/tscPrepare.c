@@ -20,9 +20,9 @@
 #include "taosmsg.h"
 #include "tstrbuild.h"
 #include "tscLog.h"
+#include "tscSqlCache.h"
 
 int tsParseInsertSql(SSqlObj *pSql);
-int taos_query_imp(STscObj* pObj, SSqlObj* pSql);
 
 ////////////////////////////////////////////////////////////////////////////////
 // functions for normal statement preparation
@@ -40,6 +40,7 @@ typedef struct SNormalStmt {
   char* sql;
   SNormalStmtPart* parts;
   tVariant*        params;
+  SSqlTemplate*    pTemplate;  // query of a select statement, into which the params are bound without parsing
 } SNormalStmt;
 
 //typedef struct SInsertStmt {
@@ -150,7 +151,7 @@ static int normalStmtBindParam(STscStmt* stmt, TAOS_BIND* bind) {
 
 static int normalStmtPrepare(STscStmt* stmt) {
   SNormalStmt* normal = &stmt->normal;
-  char* sql = stmt->pSql->sqlstr;
+  char* sql = normal->sql;
   uint32_t i = 0, start = 0;
 
   while (sql[i] != 0) {
@@ -158,7 +159,6 @@ static int normalStmtPrepare(STscStmt* stmt) {
     token.n = tSQLGetToken(sql + i, &token.type);
 
     if (token.type == TK_QUESTION) {
-      sql[i] = 0;
       if (i > start) {
         int code = normalStmtAddPart(normal, false, sql + start, i - start);
         if (code != TSDB_CODE_SUCCESS) {
@@ -223,6 +223,7 @@ static char* normalStmtBuildSql(STscStmt* stmt) {
     case TSDB_DATA_TYPE_SMALLINT:
     case TSDB_DATA_TYPE_INT:
     case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
       taosStringBuilderAppendInteger(&sb, var->i64Key);
       break;
 
@@ -257,6 +258,78 @@ static char* normalStmtBuildSql(STscStmt* stmt) {
   return taosStringBuilderGetResult(&sb, NULL);
 }
 
+static void waitForStmtRsp(void *param, TAOS_RES *tres, int code) {
+  SSqlObj *pSql = (SSqlObj *)param;
+
+  if (code < 0) {
+    pSql->res.code = code;
+  }
+
+  sem_post(&pSql->rspSem);
+}
+
+static SSqlObj* stmtCreateSqlObj(STscObj* pObj) {
+  SSqlObj* pSql = calloc(1, sizeof(SSqlObj));
+  if (pSql == NULL) {
+    return NULL;
+  }
+
+  tsem_init(&pSql->rspSem, 0, 0);
+  pSql->signature = pSql;
+  pSql->pTscObj = pObj;
+  return pSql;
+}
+
+/*
+ * The sql string with the bound values is parsed in the first execution of a select statement, and the query is
+ * kept as the template of the statement, so the later executions bind the new values into the query directly.
+ */
+static int normalStmtExecute(STscStmt* stmt) {
+  char* sql = normalStmtBuildSql(stmt);
+  if (sql == NULL) {
+    return TSDB_CODE_CLI_OUT_OF_MEMORY;
+  }
+
+  // the result of the last execution is not used by the app
+  if (stmt->pSql != NULL && stmt->pSql->sqlstr != NULL) {
+    stmt->pSql->pStmt = NULL;
+    taos_free_result(stmt->pSql);
+    stmt->pSql = NULL;
+  }
+
+  if (stmt->pSql == NULL && (stmt->pSql = stmtCreateSqlObj(stmt->taos)) == NULL) {
+    free(sql);
+    return TSDB_CODE_CLI_OUT_OF_MEMORY;
+  }
+
+  SSqlObj* pSql = stmt->pSql;
+  pSql->pStmt = stmt;
+
+  doAsyncQuery(stmt->taos, pSql, waitForStmtRsp, pSql, sql, strlen(sql));
+  free(sql);
+
+  sem_wait(&pSql->rspSem);
+  return pSql->res.code;
+}
+
+bool tscGetQueryFromStmt(SSqlObj* pSql, int32_t* code) {
+  STscStmt* stmt = (STscStmt*)pSql->pStmt;
+  if (stmt == NULL || stmt->normal.pTemplate == NULL) {
+    return false;
+  }
+
+  return tscGetQueryFromStmtTemplate(pSql, stmt->normal.pTemplate, stmt->normal.params, code);
+}
+
+void tscKeepStmtTemplate(SSqlObj* pSql, int64_t parseStart) {
+  STscStmt*    stmt = (STscStmt*)pSql->pStmt;
+  SNormalStmt* normal = &stmt->normal;
+
+  // the template is replaced once the sql string is parsed again, e.g., the table meta is changed
+  tscDestroySqlTemplate(normal->pTemplate);
+  normal->pTemplate = tscCreateStmtTemplate(pSql, normal->sql, normal->params, normal->numParams, parseStart);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // functions for insertion statement preparation
 
@@ -479,7 +552,7 @@ TAOS_STMT* taos_stmt_init(TAOS* taos) {
     return NULL;
   }
 
-  SSqlObj* pSql = calloc(1, sizeof(SSqlObj));
+  SSqlObj* pSql = stmtCreateSqlObj(pObj);
   if (pSql == NULL) {
     free(pStmt);
     terrno = TSDB_CODE_CLI_OUT_OF_MEMORY;
@@ -487,10 +560,7 @@ TAOS_STMT* taos_stmt_init(TAOS* taos) {
     return NULL;
   }
 
-  tsem_init(&pSql->rspSem, 0, 0);
-  pSql->signature = pSql;
-  pSql->pTscObj = pObj;
-
+  pStmt->taos = pObj;
   pStmt->pSql = pSql;
   return pStmt;
 }
@@ -509,12 +579,13 @@ int taos_stmt_prepare(TAOS_STMT* stmt, const char* sql, unsigned long length) {
   sqlstr[length] = 0;
   strtolower(sqlstr, sqlstr);
 
-  pStmt->pSql->sqlstr = sqlstr;
   if (tscIsInsertData(sqlstr)) {
+    pStmt->pSql->sqlstr = sqlstr;
     pStmt->isInsert = true;
     return insertStmtPrepare(pStmt);
   }
 
+  pStmt->normal.sql = sqlstr;
   pStmt->isInsert = false;
   return normalStmtPrepare(pStmt);
 }
@@ -531,9 +602,18 @@ int taos_stmt_close(TAOS_STMT* stmt) {
     }
     free(normal->parts);
     free(normal->sql);
+    tscDestroySqlTemplate(normal->pTemplate);
+
+    if (pStmt->pSql != NULL && pStmt->pSql->sqlstr != NULL) {
+      pStmt->pSql->pStmt = NULL;
+      taos_free_result(pStmt->pSql);
+      pStmt->pSql = NULL;
+    }
   }
 
-  tscFreeSqlObj(pStmt->pSql);
+  if (pStmt->pSql != NULL) {
+    tscFreeSqlObj(pStmt->pSql);
+  }
   free(pStmt);
   return TSDB_CODE_SUCCESS;
 }
@@ -568,14 +648,7 @@ int taos_stmt_execute(TAOS_STMT* stmt) {
   if (pStmt->isInsert) {
     ret = insertStmtExecute(pStmt);
   } else {
-    char* sql = normalStmtBuildSql(pStmt);
-    if (sql == NULL) {
-      ret = TSDB_CODE_CLI_OUT_OF_MEMORY;
-    } else {
-      tfree(pStmt->pSql->sqlstr);
-      pStmt->pSql->sqlstr = sql;
-      ret = taos_query_imp(pStmt->taos, pStmt->pSql);
-    }
+    ret = normalStmtExecute(pStmt);
   }
   return ret;
 }
@@ -592,7 +665,8 @@ TAOS_RES *taos_stmt_use_result(TAOS_STMT* stmt) {
     return NULL;
   }
 
-  TAOS_RES* result = pStmt->pSql;
+  SSqlObj* result = pStmt->pSql;
+  result->pStmt = NULL;
   pStmt->pSql = NULL;
   return result;
 }
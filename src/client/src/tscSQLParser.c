@@ -41,6 +41,9 @@
 #define COLUMN_INDEX_VALIDE(index) (((index).tableIndex >= 0) && ((index).columnIndex >= TSDB_TBNAME_COLUMN_INDEX))
 #define TBNAME_LIST_SEP ","
 
+// the tokens of the sql functions in expressions
+#define IS_FUNCTION_OPTR(optr) ((optr) >= TK_COUNT && (optr) <= TK_VARIANCE)
+
 typedef struct SColumnList {
   int32_t      num;
   SColumnIndex ids[TSDB_MAX_COLUMNS];
@@ -76,6 +79,7 @@ static void setColumnOffsetValueInResultset(SQueryInfo* pQueryInfo);
 static int32_t parseGroupbyClause(SQueryInfo* pQueryInfo, tVariantList* pList, SSqlCmd* pCmd);
 
 static int32_t parseIntervalClause(SQueryInfo* pQueryInfo, SQuerySQL* pQuerySql);
+static int32_t parseWindowClause(SQueryInfo* pQueryInfo, SQuerySQL* pQuerySql);
 static int32_t parseSlidingClause(SQueryInfo* pQueryInfo, SQuerySQL* pQuerySql);
 
 static int32_t addProjectionExprAndResultField(SQueryInfo* pQueryInfo, tSQLExprItem* pItem);
@@ -686,6 +690,153 @@ int32_t parseSlidingClause(SQueryInfo* pQueryInfo, SQuerySQL* pQuerySql) {
   return TSDB_CODE_SUCCESS;
 }
 
+/*
+ * session(ts, gap): the adjacent rows belong to one window if the time gap between them is no larger than gap
+ * state_window(col): the adjacent rows belong to one window if they have the same value of the column
+ */
+int32_t parseWindowClause(SQueryInfo* pQueryInfo, SQuerySQL* pQuerySql) {
+  const char* msg1 = "invalid window clause";
+  const char* msg2 = "window clause is not compatible with interval or join query";
+  const char* msg3 = "session window only applies to the primary timestamp column";
+  const char* msg4 = "invalid session gap";
+  const char* msg5 = "state window only applies to the integer or bool column";
+  const char* msg6 = "state window on super table requires group by tbname";
+  const char* msg7 = "window clause is not compatible with group by normal column";
+  const char* msg8 = "function is not compatible with window clause";
+
+  SWindowClauseVal* pWindow = &pQuerySql->window;
+  if (pWindow->name.n == 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  bool isSession = (pWindow->name.n == 7 && strncasecmp(pWindow->name.z, "session", 7) == 0);
+  bool isState = (pWindow->name.n == 12 && strncasecmp(pWindow->name.z, "state_window", 12) == 0);
+  if ((!isSession && !isState) || (isSession && pWindow->gap.n == 0) || (isState && pWindow->gap.n != 0)) {
+    return invalidSqlErrMsg(pQueryInfo->msg, msg1);
+  }
+
+  if (pQueryInfo->intervalTime > 0 || pQueryInfo->numOfTables > 1) {
+    return invalidSqlErrMsg(pQueryInfo->msg, msg2);
+  }
+
+  if (isTopBottomQuery(pQueryInfo)) {
+    return invalidSqlErrMsg(pQueryInfo->msg, msg8);
+  }
+
+  // select last_row(c1)/count(tag1) from table_name session(ts, 10s)
+  size_t size = tscSqlExprNumOfExprs(pQueryInfo);
+  for (int32_t i = 0; i < size; ++i) {
+    SSqlExpr* pExpr = tscSqlExprGet(pQueryInfo, i);
+    if (pExpr->functionId == TSDB_FUNC_LAST_ROW ||
+        (pExpr->functionId == TSDB_FUNC_COUNT && TSDB_COL_IS_TAG(pExpr->colInfo.flag))) {
+      return invalidSqlErrMsg(pQueryInfo->msg, msg8);
+    }
+  }
+
+  STableMetaInfo* pTableMetaInfo = tscGetMetaInfo(pQueryInfo, 0);
+  STableComInfo   tinfo = tscGetTableInfo(pTableMetaInfo->pTableMeta);
+
+  bool groupbyTbname = false;
+  for (int32_t i = 0; i < pQueryInfo->groupbyExpr.numOfGroupCols; ++i) {
+    SColIndex* pColIndex = taosArrayGet(pQueryInfo->groupbyExpr.columnInfo, i);
+    if (!TSDB_COL_IS_TAG(pColIndex->flag)) {
+      return invalidSqlErrMsg(pQueryInfo->msg, msg7);
+    }
+
+    if (pColIndex->colIndex == TSDB_TBNAME_COLUMN_INDEX) {
+      groupbyTbname = true;
+    }
+  }
+
+  SColumnIndex index = COLUMN_INDEX_INITIALIZER;
+  if (getColumnIndexByName(&pWindow->col, pQueryInfo, &index) != TSDB_CODE_SUCCESS) {
+    return invalidSqlErrMsg(pQueryInfo->msg, msg1);
+  }
+
+  if (isSession) {
+    if (index.columnIndex != PRIMARYKEY_TIMESTAMP_COL_INDEX) {
+      return invalidSqlErrMsg(pQueryInfo->msg, msg3);
+    }
+
+    if (getTimestampInUsFromStr(pWindow->gap.z, pWindow->gap.n, &pQueryInfo->sessionGap) != TSDB_CODE_SUCCESS) {
+      return invalidSqlErrMsg(pQueryInfo->msg, msg4);
+    }
+
+    if (tinfo.precision == TSDB_TIME_PRECISION_MILLI) {
+      pQueryInfo->sessionGap /= 1000;
+    }
+
+    if (pQueryInfo->sessionGap <= 0) {
+      return invalidSqlErrMsg(pQueryInfo->msg, msg4);
+    }
+
+    pQueryInfo->windowType = TSDB_WINDOW_SESSION;
+  } else {
+    if (index.columnIndex == PRIMARYKEY_TIMESTAMP_COL_INDEX || index.columnIndex == TSDB_TBNAME_COLUMN_INDEX ||
+        index.columnIndex >= tscGetNumOfColumns(pTableMetaInfo->pTableMeta)) {
+      return invalidSqlErrMsg(pQueryInfo->msg, msg5);
+    }
+
+    SSchema* pSchema = tscGetTableColumnSchema(pTableMetaInfo->pTableMeta, index.columnIndex);
+    if (pSchema->type < TSDB_DATA_TYPE_BOOL || pSchema->type > TSDB_DATA_TYPE_BIGINT) {
+      return invalidSqlErrMsg(pQueryInfo->msg, msg5);
+    }
+
+    // the windows of different tables are not comparable, since the state is not ordered by time across tables
+    if (UTIL_TABLE_IS_SUPER_TABLE(pTableMetaInfo) && !groupbyTbname) {
+      return invalidSqlErrMsg(pQueryInfo->msg, msg6);
+    }
+
+    tscColumnListInsert(pQueryInfo->colList, &index);
+    pQueryInfo->windowType = TSDB_WINDOW_STATE;
+    pQueryInfo->stateColId = pSchema->colId;
+  }
+
+  if (tscQueryTags(pQueryInfo)) {
+    return invalidSqlErrMsg(pQueryInfo->msg, msg1);
+  }
+
+  // the start of each window is the first column of the result, the same as the interval query
+  SColumnIndex tsIndex = {0, PRIMARYKEY_TIMESTAMP_COL_INDEX};
+  SSqlExpr*    pExpr = tscSqlExprInsert(pQueryInfo, 0, TSDB_FUNC_TS, &tsIndex, TSDB_DATA_TYPE_TIMESTAMP, TSDB_KEYSIZE,
+                                     TSDB_KEYSIZE, false);
+
+  SColumnList ids = getColumnList(1, 0, PRIMARYKEY_TIMESTAMP_COL_INDEX);
+  return insertResultField(pQueryInfo, 0, &ids, TSDB_KEYSIZE, TSDB_DATA_TYPE_TIMESTAMP, aAggs[TSDB_FUNC_TS].aName,
+                           pExpr);
+}
+
+/*
+ * The session windows of different tables, or vnodes, are merged if they are not farther than the gap apart, which
+ * requires the end of each window. It is the max value of spread(ts), appended as the last but invisible column.
+ */
+static int32_t doAddSessionEndColumn(SQueryInfo* pQueryInfo) {
+  SColumnIndex index = {0, PRIMARYKEY_TIMESTAMP_COL_INDEX};
+  SSchema*     pSchema = tscGetTableColumnSchema(tscGetMetaInfo(pQueryInfo, 0)->pTableMeta, index.columnIndex);
+
+  int16_t type = 0, bytes = 0, inter = 0;
+  if (getResultDataInfo(pSchema->type, pSchema->bytes, TSDB_FUNC_SPREAD, 0, &type, &bytes, &inter, 0, false) !=
+      TSDB_CODE_SUCCESS) {
+    return TSDB_CODE_INVALID_SQL;
+  }
+
+  // the functions of the super table query have been transferred, so is this one, see tscTansformSQLFuncForSTableQuery
+  int16_t interType = 0, interBytes = 0;
+  getResultDataInfo(pSchema->type, pSchema->bytes, TSDB_FUNC_SPREAD, 0, &interType, &interBytes, &inter, 0, true);
+
+  size_t    size = tscSqlExprNumOfExprs(pQueryInfo);
+  SSqlExpr* pExpr = tscSqlExprAppend(pQueryInfo, TSDB_FUNC_SPREAD, &index, TSDB_DATA_TYPE_BINARY, interBytes, inter,
+                                     false);
+  tscFieldInfoUpdateOffsetForInterResult(pQueryInfo);
+
+  SColumnList ids = getColumnList(1, 0, PRIMARYKEY_TIMESTAMP_COL_INDEX);
+  insertResultField(pQueryInfo, size, &ids, bytes, type, aAggs[TSDB_FUNC_SPREAD].aName, pExpr);
+
+  SFieldSupInfo* pInfo = tscFieldInfoGetSupp(&pQueryInfo->fieldsInfo, size);
+  pInfo->visible = false;
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t tscSetTableId(STableMetaInfo* pTableMetaInfo, SSQLToken* pzTableName, SSqlObj* pSql) {
   const char* msg = "name too long";
 
@@ -1565,6 +1716,7 @@ int32_t addExprAndResultField(SQueryInfo* pQueryInfo, int32_t colIndex, tSQLExpr
     case TK_MAX:
     case TK_DIFF:
     case TK_STDDEV:
+    case TK_VARIANCE:
     case TK_LEASTSQUARES: {
       // 1. valid the number of parameters
       if (pItem->pNode->pParam == NULL || (optr != TK_LEASTSQUARES && pItem->pNode->pParam->nExpr != 1) ||
@@ -2113,6 +2265,9 @@ int32_t changeFunctionID(int32_t optr, int16_t* functionId) {
     case TK_STDDEV:
       *functionId = TSDB_FUNC_STDDEV;
       break;
+    case TK_VARIANCE:
+      *functionId = TSDB_FUNC_VARIANCE;
+      break;
     case TK_PERCENTILE:
       *functionId = TSDB_FUNC_PERCT;
       break;
@@ -2300,7 +2455,7 @@ int32_t tscTansformSQLFuncForSTableQuery(SQueryInfo* pQueryInfo) {
     
     if ((functionId >= TSDB_FUNC_SUM && functionId <= TSDB_FUNC_TWA) ||
         (functionId >= TSDB_FUNC_FIRST_DST && functionId <= TSDB_FUNC_LAST_DST) ||
-        (functionId >= TSDB_FUNC_RATE && functionId <= TSDB_FUNC_AVG_IRATE)) {
+        (functionId >= TSDB_FUNC_RATE && functionId <= TSDB_FUNC_AVG_IRATE) || functionId == TSDB_FUNC_VARIANCE) {
       if (getResultDataInfo(pSrcSchema->type, pSrcSchema->bytes, functionId, pExpr->param[0].i64Key, &type, &bytes,
                             &intermediateBytes, 0, true) != TSDB_CODE_SUCCESS) {
         return TSDB_CODE_INVALID_SQL;
@@ -2705,7 +2860,7 @@ static int32_t tSQLExprNodeToString(tSQLExpr* pExpr, char** str) {
   } else if (pExpr->nSQLOptr >= TK_BOOL && pExpr->nSQLOptr <= TK_STRING) {  // value
     *str += tVariantToString(&pExpr->val, *str);
 
-  } else if (pExpr->nSQLOptr >= TK_COUNT && pExpr->nSQLOptr <= TK_AVG_IRATE) {
+  } else if (IS_FUNCTION_OPTR(pExpr->nSQLOptr)) {
     /*
      * arithmetic expression of aggregation, such as count(ts) + count(ts) *2
      */
@@ -3100,7 +3255,7 @@ static int32_t validateSQLExpr(tSQLExpr* pExpr, SQueryInfo* pQueryInfo, SColumnL
     pList->ids[pList->num++] = index;
   } else if (pExpr->nSQLOptr == TK_FLOAT && (isnan(pExpr->val.dKey) || isinf(pExpr->val.dKey))) {
     return TSDB_CODE_INVALID_SQL;
-  } else if (pExpr->nSQLOptr >= TK_COUNT && pExpr->nSQLOptr <= TK_AVG_IRATE) {
+  } else if (IS_FUNCTION_OPTR(pExpr->nSQLOptr)) {
     if (*type == NON_ARITHMEIC_EXPR) {
       *type = AGG_ARIGHTMEIC;
     } else if (*type == NORMAL_ARITHMETIC) {
@@ -3167,8 +3322,8 @@ static bool isValidExpr(tSQLExpr* pLeft, tSQLExpr* pRight, int32_t optr) {
    *
    * However, columnA < 4+12 is valid
    */
-  if ((pLeft->nSQLOptr >= TK_COUNT && pLeft->nSQLOptr <= TK_AVG_IRATE) ||
-      (pRight->nSQLOptr >= TK_COUNT && pRight->nSQLOptr <= TK_AVG_IRATE) ||
+  if (IS_FUNCTION_OPTR(pLeft->nSQLOptr) ||
+      IS_FUNCTION_OPTR(pRight->nSQLOptr) ||
       (pLeft->nSQLOptr >= TK_BOOL && pLeft->nSQLOptr <= TK_BINARY && pRight->nSQLOptr >= TK_BOOL &&
        pRight->nSQLOptr <= TK_BINARY)) {
     return false;
@@ -3968,6 +4123,39 @@ int32_t getTimeRange(STimeWindow* win, tSQLExpr* pRight, int32_t optr, int16_t t
   return TSDB_CODE_SUCCESS;
 }
 
+/*
+ * Get the time range of a condition on the primary timestamp column without parsing the whole sql, the value of
+ * the condition is a literal value, now, or now with an offset, e.g., now - 1h.
+ */
+int32_t tscGetTimeRangeFromTokens(STimeWindow* win, SSQLToken* pValue, int32_t numOfTokens, int32_t optr,
+                                  int16_t timePrecision) {
+  tSQLExpr* pRight = NULL;
+
+  if (pValue[0].type == TK_NOW) {
+    pRight = tSQLExprIdValueCreate(NULL, TK_NOW);
+
+    if (numOfTokens == 3) {
+      if ((pValue[1].type != TK_PLUS && pValue[1].type != TK_MINUS) || pValue[2].type != TK_VARIABLE) {
+        tSQLExprDestroy(pRight);
+        return TSDB_CODE_INVALID_SQL;
+      }
+
+      SSQLToken offset = pValue[2];
+      pRight = tSQLExprCreate(pRight, tSQLExprIdValueCreate(&offset, TK_VARIABLE), pValue[1].type);
+    }
+  } else if (numOfTokens == 1 &&
+             (pValue[0].type == TK_INTEGER || pValue[0].type == TK_FLOAT || pValue[0].type == TK_STRING)) {
+    SSQLToken token = pValue[0];
+    pRight = tSQLExprIdValueCreate(&token, token.type);
+  } else {
+    return TSDB_CODE_INVALID_SQL;
+  }
+
+  int32_t ret = getTimeRange(win, pRight, optr, timePrecision);
+  tSQLExprDestroy(pRight);
+  return ret;
+}
+
 // todo error !!!!
 int32_t tsRewriteFieldNameIfNecessary(SQueryInfo* pQueryInfo) {
   const char rep[] = {'(', ')', '*', ',', '.', '/', '\\', '+', '-', '%', ' '};
@@ -4419,18 +4607,32 @@ int32_t setAlterTableInfo(SSqlObj* pSql, struct SSqlInfo* pInfo) {
       return invalidSqlErrMsg(pQueryInfo->msg, msg12);
     }
 
+    // the value is in the same layout as the tag data of the create table msg, a var string for binary and nchar
     SSchema* pTagsSchema = tscGetTableColumnSchema(pTableMetaInfo->pTableMeta, columnIndex.columnIndex);
-    if (tVariantDump(&pVarList->a[1].pVar, pAlterSQL->tagData.data /*pCmd->payload*/, pTagsSchema->type) !=
-        TSDB_CODE_SUCCESS) {
-      return invalidSqlErrMsg(pQueryInfo->msg, msg13);
+    tVariant* pTagVal = &pVarList->a[1].pVar;
+    char*     tagVal = pAlterSQL->tagData.data;
+    int32_t   ret = TSDB_CODE_SUCCESS;
+
+    if (pTagsSchema->type == TSDB_DATA_TYPE_BINARY || pTagsSchema->type == TSDB_DATA_TYPE_NCHAR) {
+      // validate the length of binary
+      if (pTagVal->nLen + VARSTR_HEADER_SIZE > pTagsSchema->bytes) {
+        return invalidSqlErrMsg(pQueryInfo->msg, msg14);
+      }
+
+      ret = tVariantDump(pTagVal, varDataVal(tagVal), pTagsSchema->type);
+      if (pTagVal->nType == TSDB_DATA_TYPE_NULL) {
+        varDataSetLen(tagVal, (pTagsSchema->type == TSDB_DATA_TYPE_BINARY) ? sizeof(uint8_t) : sizeof(uint32_t));
+      } else {
+        varDataSetLen(tagVal, pTagVal->nLen);
+      }
+    } else {
+      ret = tVariantDump(pTagVal, tagVal, pTagsSchema->type);
     }
-    pAlterSQL->tagData.dataLen = pTagsSchema->bytes;
 
-    // validate the length of binary
-    if ((pTagsSchema->type == TSDB_DATA_TYPE_BINARY || pTagsSchema->type == TSDB_DATA_TYPE_NCHAR) &&
-        pVarList->a[1].pVar.nLen > pTagsSchema->bytes) {
-      return invalidSqlErrMsg(pQueryInfo->msg, msg14);
+    if (ret != TSDB_CODE_SUCCESS) {
+      return invalidSqlErrMsg(pQueryInfo->msg, msg13);
     }
+    pAlterSQL->tagData.dataLen = pTagsSchema->bytes;
 
     char name1[128] = {0};
     strncpy(name1, pTagName->pz, pTagName->nLen);
@@ -4735,8 +4937,8 @@ int32_t parseLimitClause(SQueryInfo* pQueryInfo, int32_t clauseIndex, SQuerySQL*
     }
 
     // No tables included. No results generated. Query results are empty.
-    if (pTableMetaInfo->vgroupList->numOfVgroups == 0) {
-      tscTrace("%p no table in super table, no output result", pSql);
+    if (tscPruneVgroupsByTagCond(pSql, pQueryInfo, pTableMetaInfo) == 0) {
+      tscTrace("%p no table in super table qualified for the query, no output result", pSql);
       pQueryInfo->command = TSDB_SQL_RETRIEVE_EMPTY_RESULT;
       return TSDB_CODE_SUCCESS;
     }
@@ -5615,6 +5817,7 @@ int32_t doCheckForStream(SSqlObj* pSql, SSqlInfo* pInfo) {
   const char* msg4 = "fill option not supported in stream computing";
   const char* msg5 = "sql too long";  // todo ADD support
   const char* msg6 = "from missing in subclause";
+  const char* msg7 = "window clause not supported in stream computing";
   
   SSqlCmd*    pCmd = &pSql->cmd;
   SQueryInfo* pQueryInfo = tscGetQueryInfoDetail(pCmd, 0);
@@ -5631,6 +5834,10 @@ int32_t doCheckForStream(SSqlObj* pSql, SSqlInfo* pInfo) {
     return invalidSqlErrMsg(tscGetErrorMsgPayload(pCmd), msg1);
   }
   
+  if (pQuerySql->window.name.n != 0) {
+    return invalidSqlErrMsg(tscGetErrorMsgPayload(pCmd), msg7);
+  }
+
   tVariantList* pSrcMeterName = pInfo->pCreateTableInfo->pSelect->from;
   if (pSrcMeterName == NULL || pSrcMeterName->nExpr == 0) {
     return invalidSqlErrMsg(tscGetErrorMsgPayload(pCmd), msg6);
@@ -5725,6 +5932,7 @@ int32_t doCheckForQuery(SSqlObj* pSql, SQuerySQL* pQuerySql, int32_t index) {
   const char* msg7 = "illegal number of tables in from clause";
   const char* msg8 = "too many columns in selection clause";
   const char* msg9 = "TWA query requires both the start and end time";
+  const char* msg10 = "window query only supports the ascending order";
 
   int32_t code = TSDB_CODE_SUCCESS;
 
@@ -5826,11 +6034,26 @@ int32_t doCheckForQuery(SSqlObj* pSql, SQuerySQL* pQuerySql, int32_t index) {
     }
   }
 
+  // set session or state window
+  if (parseWindowClause(pQueryInfo, pQuerySql) != TSDB_CODE_SUCCESS) {
+    return TSDB_CODE_INVALID_SQL;
+  } else {
+    if ((pQueryInfo->windowType != TSDB_WINDOW_NONE) &&
+        (validateFunctionsInIntervalOrGroupbyQuery(pQueryInfo) != TSDB_CODE_SUCCESS)) {
+      return TSDB_CODE_INVALID_SQL;
+    }
+  }
+
   // set order by info
   if (parseOrderbyClause(pQueryInfo, pQuerySql, tscGetTableSchema(pTableMetaInfo->pTableMeta)) != TSDB_CODE_SUCCESS) {
     return TSDB_CODE_INVALID_SQL;
   }
 
+  // the windows are built by scanning the data in the ascending order
+  if (pQueryInfo->windowType != TSDB_WINDOW_NONE && pQueryInfo->order.order == TSDB_ORDER_DESC) {
+    return invalidSqlErrMsg(tscGetErrorMsgPayload(pCmd), msg10);
+  }
+
   // set where info
   STableComInfo tinfo = tscGetTableInfo(pTableMetaInfo->pTableMeta);
   
@@ -5882,6 +6105,11 @@ int32_t doCheckForQuery(SSqlObj* pSql, SQuerySQL* pQuerySql, int32_t index) {
     return code;
   }
 
+  if (isSTable && pQueryInfo->windowType == TSDB_WINDOW_SESSION &&
+      (code = doAddSessionEndColumn(pQueryInfo)) != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
   setColumnOffsetValueInResultset(pQueryInfo);
 
   for (int32_t i = 0; i < pQueryInfo->numOfTables; ++i) {
@@ -5940,7 +6168,7 @@ int32_t exprTreeFromSqlExpr(tExprNode **pExpr, const tSQLExpr* pSqlExpr, SArray*
       
       tVariantAssign((*pExpr)->pVal, &pSqlExpr->val);
       return TSDB_CODE_SUCCESS;
-    } else if (pSqlExpr->nSQLOptr >= TK_COUNT && pSqlExpr->nSQLOptr <= TK_AVG_IRATE) {
+    } else if (IS_FUNCTION_OPTR(pSqlExpr->nSQLOptr)) {
       // arithmetic expression on the results of aggregation functions
       *pExpr = calloc(1, sizeof(tExprNode));
       (*pExpr)->nodeType = TSQL_NODE_COL;
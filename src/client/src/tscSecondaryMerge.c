@@ -55,6 +55,16 @@ int32_t treeComparator(const void *pLeft, const void *pRight, void *param) {
   }
 }
 
+static uint64_t getLocalDataSourceKey(SLocalReducer *pReducer, SLocalDataSource *pDataSrc) {
+  return tColDataGetOrderKey(pReducer->pDesc, pDataSrc->pMemBuffer->numOfElemsPerPage, pDataSrc->rowIdx,
+                             pDataSrc->filePage.data, pReducer->groupOrderType);
+}
+
+// the index of the source of the next row
+static FORCE_INLINE int32_t getWinnerDataSource(SLocalReducer *pReducer) {
+  return (pReducer->pMergeTree != NULL) ? pReducer->pMergeTree->winner : pReducer->pLoserTree->pNode[0].index;
+}
+
 static void tscInitSqlContext(SSqlCmd *pCmd, SLocalReducer *pReducer, tOrderDescriptor *pDesc) {
   /*
    * the fields and offset attributes in pCmd and pModel may be different due to
@@ -271,17 +281,34 @@ void tscCreateLocalReducer(tExtMemBuffer **pMemBuffer, int32_t numOfBuffer, tOrd
 
   pReducer->numOfBuffer = idx;
 
-  SCompareParam *param = malloc(sizeof(SCompareParam));
-  param->pLocalData = pReducer->pLocalDataSrc;
-  param->pDesc = pReducer->pDesc;
-  param->num = pReducer->pLocalDataSrc[0]->pMemBuffer->numOfElemsPerPage;
   SQueryInfo *pQueryInfo = tscGetQueryInfoDetail(pCmd, pCmd->clauseIndex);
 
-  param->groupOrderType = pQueryInfo->groupbyExpr.orderType;
+  pReducer->groupOrderType = pQueryInfo->groupbyExpr.orderType;
 
-  pRes->code = tLoserTreeCreate(&pReducer->pLoserTree, pReducer->numOfBuffer, param, treeComparator);
-  if (pReducer->pLoserTree == NULL || pRes->code != 0) {
-    return;
+  if (tOrderDescHasIntegerKey(pReducer->pDesc)) {
+    // the sources are merged by the keys of the order column without calling the comparator on each node
+    pReducer->pMergeTree = tMergeTreeCreate(pReducer->numOfBuffer);
+    if (pReducer->pMergeTree == NULL) {
+      pRes->code = TSDB_CODE_CLI_OUT_OF_MEMORY;
+      return;
+    }
+
+    for (int32_t i = 0; i < pReducer->numOfBuffer; ++i) {
+      tMergeTreeSetKey(pReducer->pMergeTree, i, getLocalDataSourceKey(pReducer, pReducer->pLocalDataSrc[i]));
+    }
+
+    tMergeTreeBuild(pReducer->pMergeTree);
+  } else {
+    SCompareParam *param = malloc(sizeof(SCompareParam));
+    param->pLocalData = pReducer->pLocalDataSrc;
+    param->pDesc = pReducer->pDesc;
+    param->num = pReducer->pLocalDataSrc[0]->pMemBuffer->numOfElemsPerPage;
+    param->groupOrderType = pReducer->groupOrderType;
+
+    pRes->code = tLoserTreeCreate(&pReducer->pLoserTree, pReducer->numOfBuffer, param, treeComparator);
+    if (pReducer->pLoserTree == NULL || pRes->code != 0) {
+      return;
+    }
   }
 
   // the input data format follows the old format, but output in a new format.
@@ -299,6 +326,13 @@ void tscCreateLocalReducer(tExtMemBuffer **pMemBuffer, int32_t numOfBuffer, tOrd
   pReducer->hasPrevRow = false;
   pReducer->hasUnprocessedRow = false;
 
+  // the end of session windows is the last column, see doAddSessionEndColumn
+  pReducer->sessionEndCol = -1;
+  if (pQueryInfo->windowType == TSDB_WINDOW_SESSION) {
+    pReducer->sessionEndCol = tscSqlExprNumOfExprs(pQueryInfo) - 1;
+    assert(tscSqlExprGet(pQueryInfo, pReducer->sessionEndCol)->functionId == TSDB_FUNC_SPREAD);
+  }
+
   pReducer->prevRowOfInput = (char *)calloc(1, pReducer->rowSize);
 
   // used to keep the latest input row
@@ -390,7 +424,7 @@ static int32_t tscFlushTmpBufferImpl(tExtMemBuffer *pMemoryBuf, tOrderDescriptor
 
   // sort before flush to disk, the data must be consecutively put on tFilePage.
   if (pDesc->orderIdx.numOfCols > 0) {
-    tColDataQSort(pDesc, pPage->num, 0, pPage->num - 1, pPage->data, orderType);
+    tColDataSort(pDesc, pPage->num, 0, pPage->num - 1, pPage->data, orderType);
   }
 
 #ifdef _DEBUG_VIEW
@@ -526,6 +560,8 @@ void tscDestroyLocalReducer(SSqlObj *pSql) {
       tfree(pLocalReducer->pLoserTree);
     }
 
+    tfree(pLocalReducer->pMergeTree);
+
     tfree(pLocalReducer->pFinalRes);
     tfree(pLocalReducer->discardData);
 
@@ -554,7 +590,8 @@ static int32_t createOrderDescriptor(tOrderDescriptor **pOrderDesc, SSqlCmd *pCm
   }
 
   // primary timestamp column is involved in final result
-  if (pQueryInfo->intervalTime != 0 || tscOrderedProjectionQueryOnSTable(pQueryInfo, 0)) {
+  bool isWindowQuery = (pQueryInfo->intervalTime != 0 || pQueryInfo->windowType != TSDB_WINDOW_NONE);
+  if (isWindowQuery || tscOrderedProjectionQueryOnSTable(pQueryInfo, 0)) {
     numOfGroupByCols++;
   }
 
@@ -566,12 +603,16 @@ static int32_t createOrderDescriptor(tOrderDescriptor **pOrderDesc, SSqlCmd *pCm
   if (numOfGroupByCols > 0) {
     int32_t startCols = pQueryInfo->fieldsInfo.numOfOutput - pQueryInfo->groupbyExpr.numOfGroupCols;
 
-    // tags value locate at the last columns
+    // tags value locate at the last columns, except the end of session windows
+    if (pQueryInfo->windowType == TSDB_WINDOW_SESSION) {
+      startCols -= 1;
+    }
+
     for (int32_t i = 0; i < pQueryInfo->groupbyExpr.numOfGroupCols; ++i) {
       orderIdx[i] = startCols++;
     }
 
-    if (pQueryInfo->intervalTime != 0) {
+    if (isWindowQuery) {
       // the first column is the timestamp, handles queries like "interval(10m) group by tags"
       orderIdx[numOfGroupByCols - 1] = PRIMARYKEY_TIMESTAMP_COL_INDEX;
     }
@@ -612,11 +653,11 @@ bool isSameGroup(SSqlCmd *pCmd, SLocalReducer *pReducer, char *pPrev, tFilePage
   }
 
   if (pOrderDesc->orderIdx.pData[numOfCols - 1] == PRIMARYKEY_TIMESTAMP_COL_INDEX) {  //<= 0
-    // super table interval query
-    assert(pQueryInfo->intervalTime > 0);
+    // super table interval or window query
+    assert(pQueryInfo->intervalTime > 0 || pQueryInfo->windowType != TSDB_WINDOW_NONE);
     pOrderDesc->orderIdx.numOfCols -= 1;
   } else {  // simple group by query
-    assert(pQueryInfo->intervalTime == 0);
+    assert(pQueryInfo->intervalTime == 0 && pQueryInfo->windowType == TSDB_WINDOW_NONE);
   }
 
   // only one row exists
@@ -672,8 +713,16 @@ int32_t tscLocalReducerEnvCreate(SSqlObj *pSql, tExtMemBuffer ***pMemBuffer, tOr
   pModel = createColumnModel(pSchema, size, capacity);
 
   size_t numOfSubs = pTableMetaInfo->vgroupList->numOfVgroups;
+
+  // the partial results in memory are limited to the amount of the sub-queries running at the same time, the rest are
+  // flushed to disk
+  int32_t inMemSize = nBufferSizes;
+  if (tsMaxConcurrentSubqueries > 0 && numOfSubs > tsMaxConcurrentSubqueries) {
+    inMemSize = MAX(DEFAULT_PAGE_SIZE, (int64_t)nBufferSizes * tsMaxConcurrentSubqueries / numOfSubs);
+  }
+
   for (int32_t i = 0; i < numOfSubs; ++i) {
-    (*pMemBuffer)[i] = createExtMemBuffer(nBufferSizes, rlen, pModel);
+    (*pMemBuffer)[i] = createExtMemBuffer(inMemSize, rlen, pModel);
     (*pMemBuffer)[i]->flushModel = MULTIPLE_APPEND_MODEL;
   }
 
@@ -786,6 +835,16 @@ void adjustLoserTreeFromNewData(SLocalReducer *pLocalReducer, SLocalDataSource *
     loadNewDataFromDiskFor(pLocalReducer, pOneInterDataSrc, &needToAdjust);
   }
 
+  if (pLocalReducer->pMergeTree != NULL) {
+    if (pOneInterDataSrc->rowIdx == -1) {
+      tMergeTreeExhaust(pLocalReducer->pMergeTree);
+    } else {
+      tMergeTreeAdvance(pLocalReducer->pMergeTree, getLocalDataSourceKey(pLocalReducer, pOneInterDataSrc));
+    }
+
+    return;
+  }
+
   /*
    * adjust loser tree otherwise, according to new candidate data
    * if the loser tree is rebuild completed, we do not need to adjust
@@ -1030,6 +1089,17 @@ static void savePreviousRow(SLocalReducer *pLocalReducer, tFilePage *tmpBuffer)
     memcpy(pLocalReducer->prevRowOfInput + offset, tmpBuffer->data + offset, pSchema->bytes);
   }
 
+  // the merged session window ends at the last end of the windows in it
+  if (pLocalReducer->sessionEndCol >= 0) {
+    SSpreadInfo *pInfo =
+        (SSpreadInfo *)(tmpBuffer->data + getColumnModelOffset(pColumnModel, pLocalReducer->sessionEndCol));
+    int64_t end = (int64_t)pInfo->max;
+
+    if (!pLocalReducer->hasPrevRow || end > pLocalReducer->sessionEnd) {
+      pLocalReducer->sessionEnd = end;
+    }
+  }
+
   tmpBuffer->num = 0;
   pLocalReducer->hasPrevRow = true;
 }
@@ -1065,6 +1135,11 @@ static void doExecuteSecondaryMerge(SSqlCmd *pCmd, SLocalReducer *pLocalReducer,
       continue;
     }
 
+    // the merged session window starts at the start of its first window
+    if (functionId == TSDB_FUNC_TS && !needInit && pQueryInfo->windowType == TSDB_WINDOW_SESSION) {
+      continue;
+    }
+
     aAggs[functionId].distSecondaryMergeFunc(&pLocalReducer->pCtx[j]);
   }
 }
@@ -1179,6 +1254,19 @@ bool needToMerge(SQueryInfo *pQueryInfo, SLocalReducer *pLocalReducer, tFilePage
 
   if (functionId == TSDB_FUNC_PRJ || functionId == TSDB_FUNC_ARITHM) {  // column projection query
     ret = 1;                                                            // disable merge procedure
+  } else if (pLocalReducer->sessionEndCol >= 0) {
+    // the session windows of the same group are merged if the gap between them is no larger than the session gap
+    tOrderDescriptor *pDesc = pLocalReducer->pDesc;
+    assert(pDesc->orderIdx.pData[pDesc->orderIdx.numOfCols - 1] == PRIMARYKEY_TIMESTAMP_COL_INDEX);
+
+    pDesc->orderIdx.numOfCols -= 1;
+    ret = compare_a(pDesc, 1, 0, pLocalReducer->prevRowOfInput, 1, 0, tmpBuffer->data);
+    pDesc->orderIdx.numOfCols += 1;
+
+    int64_t skey = *(int64_t *)(tmpBuffer->data + getColumnModelOffset(pDesc->pColumnModel, 0));
+    if (ret == 0 && skey - pLocalReducer->sessionEnd > pQueryInfo->sessionGap) {
+      ret = 1;
+    }
   } else {
     tOrderDescriptor *pDesc = pLocalReducer->pDesc;
     if (pDesc->orderIdx.numOfCols > 0) {
@@ -1461,14 +1549,15 @@ int32_t tscDoLocalMerge(SSqlObj *pSql) {
       break;
     }
 
+    int32_t winner = getWinnerDataSource(pLocalReducer);
+
 #ifdef _DEBUG_VIEW
-    printf("chosen data in pTree[0] = %d\n", pTree->pNode[0].index);
+    printf("chosen data in pTree[0] = %d\n", winner);
 #endif
-    assert((pTree->pNode[0].index < pLocalReducer->numOfBuffer) && (pTree->pNode[0].index >= 0) &&
-           tmpBuffer->num == 0);
+    assert((winner < pLocalReducer->numOfBuffer) && (winner >= 0) && tmpBuffer->num == 0);
 
     // chosen from loser tree
-    SLocalDataSource *pOneDataSrc = pLocalReducer->pLocalDataSrc[pTree->pNode[0].index];
+    SLocalDataSource *pOneDataSrc = pLocalReducer->pLocalDataSrc[winner];
 
     tColModelAppend(pModel, tmpBuffer, pOneDataSrc->filePage.data, pOneDataSrc->rowIdx, 1,
                     pOneDataSrc->pMemBuffer->pColumnModel->capacity);
@@ -28,6 +28,9 @@
 #include "tutil.h"
 #include "tscLog.h"
 #include "qsqltype.h"
+#include "qast.h"
+#include "exception.h"
+#include "ttagbloom.h"
 
 #define TSC_MGMT_VNODE 999
 
@@ -368,6 +371,7 @@ int doProcessSql(SSqlObj *pSql) {
       pCmd->command == TSDB_SQL_CONNECT ||
       pCmd->command == TSDB_SQL_HB ||
       pCmd->command == TSDB_SQL_META ||
+      pCmd->command == TSDB_SQL_MULTI_META ||
       pCmd->command == TSDB_SQL_STABLEVGROUP) {
     pRes->code = tscBuildMsg[pCmd->command](pSql, NULL);
   }
@@ -658,6 +662,9 @@ int tscBuildQueryMsg(SSqlObj *pSql, SSqlInfo *pInfo) {
   pQueryMsg->intervalTime   = htobe64(pQueryInfo->intervalTime);
   pQueryMsg->slidingTime    = htobe64(pQueryInfo->slidingTime);
   pQueryMsg->slidingTimeUnit = pQueryInfo->slidingTimeUnit;
+  pQueryMsg->windowType     = pQueryInfo->windowType;
+  pQueryMsg->sessionGap     = htobe64(pQueryInfo->sessionGap);
+  pQueryMsg->stateColId     = htons(pQueryInfo->stateColId);
   pQueryMsg->numOfGroupCols = htons(pQueryInfo->groupbyExpr.numOfGroupCols);
   pQueryMsg->numOfTags      = htonl(numOfTags);
   pQueryMsg->tagNameRelType = htons(pQueryInfo->tagCond.relType);
@@ -1285,9 +1292,10 @@ int tscBuildAlterTableMsg(SSqlObj *pSql, SSqlInfo *pInfo) {
   strcpy(pAlterTableMsg->tableId, pTableMetaInfo->name);
   pAlterTableMsg->type = htons(pAlterInfo->type);
 
-  pAlterTableMsg->numOfCols = htons(tscNumOfFields(pQueryInfo));
+  int32_t numOfCols = tscNumOfFields(pQueryInfo);
+  pAlterTableMsg->numOfCols = htons(numOfCols);
   SSchema *pSchema = pAlterTableMsg->schema;
-  for (int i = 0; i < pAlterTableMsg->numOfCols; ++i) {
+  for (int i = 0; i < numOfCols; ++i) {
     TAOS_FIELD *pField = tscFieldInfoGetField(&pQueryInfo->fieldsInfo, i);
 
     pSchema->type = pField->type;
@@ -1511,45 +1519,26 @@ int tscBuildTableMetaMsg(SSqlObj *pSql, SSqlInfo *pInfo) {
 
 /**
  *  multi table meta req pkg format:
- *  | SMgmtHead | SCMMultiTableInfoMsg | tableId0 | tableId1 | tableId2 | ......
- *      no used         4B
+ *  | SCMMultiTableInfoMsg | tableId0 | tableId1 | tableId2 | ......
+ *          4B
+ *
+ *  the table ids, each of which takes TSDB_TABLE_ID_LEN bytes, are put into the payload by the caller
  **/
 int tscBuildMultiMeterMetaMsg(SSqlObj *pSql, SSqlInfo *pInfo) {
-#if 0
   SSqlCmd *pCmd = &pSql->cmd;
 
-  // copy payload content to temp buff
-  char *tmpData = 0;
-  if (pCmd->payloadLen > 0) {
-    tmpData = calloc(1, pCmd->payloadLen + 1);
-    if (NULL == tmpData) return -1;
-    memcpy(tmpData, pCmd->payload, pCmd->payloadLen);
-  }
-
-  // fill head info
-  SMgmtHead *pMgmt = (SMgmtHead *)(pCmd->payload + tsRpcHeadSize);
-  memset(pMgmt->db, 0, TSDB_TABLE_ID_LEN);  // server don't need the db
-
-  SCMMultiTableInfoMsg *pInfoMsg = (SCMMultiTableInfoMsg *)(pCmd->payload + tsRpcHeadSize + sizeof(SMgmtHead));
+  SCMMultiTableInfoMsg *pInfoMsg = (SCMMultiTableInfoMsg *)pCmd->payload;
   pInfoMsg->numOfTables = htonl((int32_t)pCmd->count);
 
-  if (pCmd->payloadLen > 0) {
-    memcpy(pInfoMsg->tableIds, tmpData, pCmd->payloadLen);
-  }
-
-  tfree(tmpData);
-
-  pCmd->payloadLen += sizeof(SMgmtHead) + sizeof(SCMMultiTableInfoMsg);
+  pCmd->payloadLen = sizeof(SCMMultiTableInfoMsg) + pCmd->count * TSDB_TABLE_ID_LEN;
   pCmd->msgType = TSDB_MSG_TYPE_CM_TABLES_META;
 
-  assert(pCmd->payloadLen + minMsgSize() <= pCmd->allocSize);
+  assert(pCmd->payloadLen <= pCmd->allocSize);
 
   tscTrace("%p build load multi-metermeta msg completed, numOfTables:%d, msg size:%d", pSql, pCmd->count,
            pCmd->payloadLen);
 
-  return pCmd->payloadLen;
-#endif
-  return 0;  
+  return TSDB_CODE_SUCCESS;
 }
 
 //static UNUSED_FUNC int32_t tscEstimateMetricMetaMsgSize(SSqlCmd *pCmd) {
@@ -1735,8 +1724,11 @@ int tscBuildSTableVgroupMsg(SSqlObj *pSql, SSqlInfo *pInfo) {
   
   for(int32_t i = 0; i < pQueryInfo->numOfTables; ++i) {
     STableMetaInfo *pTableMetaInfo = tscGetTableMetaInfoFromCmd(pCmd, pCmd->clauseIndex, i);
-    strncpy(pMsg, pTableMetaInfo->name, TSDB_TABLE_ID_LEN);
-    pMsg += TSDB_TABLE_ID_LEN;
+    SCMSTableVgroupInfo *pTable = (SCMSTableVgroupInfo *)pMsg;
+
+    strncpy(pTable->tableId, pTableMetaInfo->name, TSDB_TABLE_ID_LEN);
+    pTable->version = htobe64((pTableMetaInfo->vgroupList != NULL) ? pTableMetaInfo->vgroupListVersion : 0);
+    pMsg += sizeof(SCMSTableVgroupInfo);
   }
 
   pCmd->msgType = TSDB_MSG_TYPE_CM_STABLE_VGROUP;
@@ -1799,9 +1791,7 @@ int tscBuildHeartBeatMsg(SSqlObj *pSql, SSqlInfo *pInfo) {
   return TSDB_CODE_SUCCESS;
 }
 
-int tscProcessTableMetaRsp(SSqlObj *pSql) {
-  STableMetaMsg *pMetaMsg = (STableMetaMsg *)pSql->res.pRsp;
-
+static int32_t tscDecodeTableMetaMsg(STableMetaMsg *pMetaMsg) {
   pMetaMsg->sid = htonl(pMetaMsg->sid);
   pMetaMsg->sversion = htons(pMetaMsg->sversion);
   
@@ -1841,6 +1831,17 @@ int tscProcessTableMetaRsp(SSqlObj *pSql) {
     pSchema++;
   }
 
+  return TSDB_CODE_SUCCESS;
+}
+
+int tscProcessTableMetaRsp(SSqlObj *pSql) {
+  STableMetaMsg *pMetaMsg = (STableMetaMsg *)pSql->res.pRsp;
+
+  int32_t code = tscDecodeTableMetaMsg(pMetaMsg);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
   size_t size = 0;
   STableMeta* pTableMeta = tscCreateTableMetaFromMsg(pMetaMsg, &size);
 
@@ -1875,113 +1876,225 @@ int tscProcessTableMetaRsp(SSqlObj *pSql) {
 
 /**
  *  multi table meta rsp pkg format:
- *  | STaosRsp | ieType | SCMMultiTableInfoMsg | SMeterMeta0 | SSchema0 | SMeterMeta1 | SSchema1 | SMeterMeta2 | SSchema2
- *  |...... 1B        1B            4B
+ *  | SMultiTableMeta | STableMetaMsg0 | SSchema0 | STableMetaMsg1 | SSchema1 | ...
+ *
+ *  the tables that do not exist are not in the response, and the table meta received are only put into cache
  **/
 int tscProcessMultiMeterMetaRsp(SSqlObj *pSql) {
-#if 0
-  char *rsp = pSql->res.pRsp;
+  SMultiTableMeta *pMultiMeta = (SMultiTableMeta *)pSql->res.pRsp;
+  int32_t          numOfTables = htonl(pMultiMeta->numOfTables);
+  int32_t          contLen = htonl(pMultiMeta->contLen);
 
-  ieType = *rsp;
-  if (ieType != TSDB_IE_TYPE_META) {
-    tscError("invalid ie type:%d", ieType);
-    pSql->res.code = TSDB_CODE_INVALID_IE;
-    pSql->res.numOfTotal = 0;
-    return TSDB_CODE_OTHERS;
+  if (contLen > pSql->res.rspLen) {
+    tscError("%p invalid multi-metermeta rsp, contLen:%d rspLen:%d", pSql, contLen, pSql->res.rspLen);
+    return TSDB_CODE_INVALID_VALUE;
   }
 
-  rsp++;
+  char *  pMsg = (char *)pMultiMeta + sizeof(SMultiTableMeta);
+  int32_t i = 0;
+  for (; i < numOfTables && pMsg < (char *)pMultiMeta + contLen; ++i) {
+    STableMetaMsg *pMetaMsg = (STableMetaMsg *)pMsg;
 
-  SCMMultiTableInfoMsg *pInfo = (SCMMultiTableInfoMsg *)rsp;
-  totalNum = htonl(pInfo->numOfTables);
-  rsp += sizeof(SCMMultiTableInfoMsg);
+    int32_t code = tscDecodeTableMetaMsg(pMetaMsg);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
 
-  for (i = 0; i < totalNum; i++) {
-    SMultiTableMeta *pMultiMeta = (SMultiTableMeta *)rsp;
-    STableMeta *     pMeta = pMultiMeta->metas;
+    size_t      size = 0;
+    STableMeta *pTableMeta = tscCreateTableMetaFromMsg(pMetaMsg, &size);
 
-    pMeta->sid = htonl(pMeta->sid);
-    pMeta->sversion = htons(pMeta->sversion);
-    pMeta->vgId = htonl(pMeta->vgId);
-    pMeta->uid = htobe64(pMeta->uid);
+    void *pCached = taosCachePut(tscCacheHandle, pMetaMsg->tableId, pTableMeta, size, tsTableMetaKeepTimer);
+    taosCacheRelease(tscCacheHandle, &pCached, false);
+    free(pTableMeta);
 
-    if (pMeta->sid <= 0 || pMeta->vgId < 0) {
-      tscError("invalid meter vgId:%d, sid%d", pMeta->vgId, pMeta->sid);
-      pSql->res.code = TSDB_CODE_INVALID_VALUE;
-      pSql->res.numOfTotal = i;
-      return TSDB_CODE_OTHERS;
-    }
+    pMsg += pMetaMsg->contLen;
+  }
 
-    //    pMeta->numOfColumns = htons(pMeta->numOfColumns);
-    //
-    //    if (pMeta->numOfTags > TSDB_MAX_TAGS || pMeta->numOfTags < 0) {
-    //      tscError("invalid tag value count:%d", pMeta->numOfTags);
-    //      pSql->res.code = TSDB_CODE_INVALID_VALUE;
-    //      pSql->res.numOfTotal = i;
-    //      return TSDB_CODE_OTHERS;
-    //    }
-    //
-    //    if (pMeta->numOfTags > TSDB_MAX_TAGS || pMeta->numOfTags < 0) {
-    //      tscError("invalid numOfTags:%d", pMeta->numOfTags);
-    //      pSql->res.code = TSDB_CODE_INVALID_VALUE;
-    //      pSql->res.numOfTotal = i;
-    //      return TSDB_CODE_OTHERS;
-    //    }
-    //
-    //    if (pMeta->numOfColumns > TSDB_MAX_COLUMNS || pMeta->numOfColumns < 0) {
-    //      tscError("invalid numOfColumns:%d", pMeta->numOfColumns);
-    //      pSql->res.code = TSDB_CODE_INVALID_VALUE;
-    //      pSql->res.numOfTotal = i;
-    //      return TSDB_CODE_OTHERS;
-    //    }
-    //
-    //    for (int j = 0; j < TSDB_REPLICA_MAX_NUM; ++j) {
-    //      pMeta->vpeerDesc[j].vnode = htonl(pMeta->vpeerDesc[j].vnode);
-    //    }
-    //
-    //    pMeta->rowSize = 0;
-    //    rsp += sizeof(SMultiTableMeta);
-    //    pSchema = (SSchema *)rsp;
-    //
-    //    int32_t numOfTotalCols = pMeta->numOfColumns + pMeta->numOfTags;
-    //    for (int j = 0; j < numOfTotalCols; ++j) {
-    //      pSchema->bytes = htons(pSchema->bytes);
-    //      pSchema->colId = htons(pSchema->colId);
-    //
-    //      // ignore the tags length
-    //      if (j < pMeta->numOfColumns) {
-    //        pMeta->rowSize += pSchema->bytes;
-    //      }
-    //      pSchema++;
-    //    }
-    //
-    //    rsp += numOfTotalCols * sizeof(SSchema);
-    //
-    //    int32_t  tagLen = 0;
-    //    SSchema *pTagsSchema = tscGetTableTagSchema(pMeta);
-    //
-    //    if (pMeta->tableType == TSDB_CHILD_TABLE) {
-    //      for (int32_t j = 0; j < pMeta->numOfTags; ++j) {
-    //        tagLen += pTagsSchema[j].bytes;
-    //      }
-    //    }
-    //
-    //    rsp += tagLen;
-    //    int32_t size = (int32_t)(rsp - ((char *)pMeta));  // Consistent with STableMeta in cache
-    //
-    //    pMeta->index = 0;
-    //    (void)taosCachePut(tscCacheHandle, pMeta->tableId, (char *)pMeta, size, tsTableMetaKeepTimer);
-    //  }
-  }
-  
-  pSql->res.code = TSDB_CODE_SUCCESS;
   pSql->res.numOfTotal = i;
   tscTrace("%p load multi-metermeta resp complete num:%d", pSql, pSql->res.numOfTotal);
-#endif
-  
+
   return TSDB_CODE_SUCCESS;
 }
 
+/*
+ * The vgroup list of super table is cached with the version given by mnode, and presented to mnode in the following
+ * queries, so the list is not sent again if it is not changed.
+ */
+typedef struct SVgroupListCache {
+  int64_t version;
+  char    vgroupList[];  // SVgroupsInfo, followed by the STagSummaryMsg of the vgroups
+} SVgroupListCache;
+
+static size_t tscGetTagSummarySize(STagSummaryMsg *pSummary, int32_t numOfVgroups) {
+  return sizeof(STagSummaryMsg) + pSummary->numOfTags * sizeof(int16_t) + numOfVgroups * TSDB_TAG_BLOOM_SIZE;
+}
+
+static void tscGetVgroupListCacheKey(const char *name, char *key) {
+  snprintf(key, TSDB_TABLE_ID_LEN + 16, "%s:vgroups", name);
+}
+
+static void tscPutVgroupListIntoCache(const char *name, SVgroupsInfo *pVgroupList, STagSummaryMsg *pSummary,
+                                      int64_t version) {
+  char   key[TSDB_TABLE_ID_LEN + 16];
+  size_t listSize = sizeof(SVgroupsInfo) + sizeof(SCMVgroupInfo) * pVgroupList->numOfVgroups;
+  size_t summarySize = tscGetTagSummarySize(pSummary, pVgroupList->numOfVgroups);
+
+  SVgroupListCache *pCache = malloc(sizeof(SVgroupListCache) + listSize + summarySize);
+  if (pCache == NULL) return;
+
+  pCache->version = version;
+  memcpy(pCache->vgroupList, pVgroupList, listSize);
+  memcpy(pCache->vgroupList + listSize, pSummary, summarySize);
+
+  tscGetVgroupListCacheKey(name, key);
+  void *pCached = taosCachePut(tscCacheHandle, key, pCache, sizeof(SVgroupListCache) + listSize + summarySize,
+                               tsTableMetaKeepTimer);
+  taosCacheRelease(tscCacheHandle, &pCached, false);
+  free(pCache);
+}
+
+// copy the cached vgroup list into pTableMetaInfo, return false if not cached
+static bool tscGetVgroupListFromCache(STableMetaInfo *pTableMetaInfo) {
+  char key[TSDB_TABLE_ID_LEN + 16];
+  tscGetVgroupListCacheKey(pTableMetaInfo->name, key);
+
+  SVgroupListCache *pCache = taosCacheAcquireByName(tscCacheHandle, key);
+  if (pCache == NULL) {
+    return false;
+  }
+
+  SVgroupsInfo *pVgroupList = (SVgroupsInfo *)pCache->vgroupList;
+  size_t        size = sizeof(SVgroupsInfo) + sizeof(SCMVgroupInfo) * pVgroupList->numOfVgroups;
+
+  tfree(pTableMetaInfo->vgroupList);
+  pTableMetaInfo->vgroupList = malloc(size);
+  if (pTableMetaInfo->vgroupList != NULL) {
+    memcpy(pTableMetaInfo->vgroupList, pVgroupList, size);
+    pTableMetaInfo->vgroupListVersion = pCache->version;
+  }
+
+  taosCacheRelease(tscCacheHandle, (void **)&pCache, false);
+  return pTableMetaInfo->vgroupList != NULL;
+}
+
+static bool isSummarizedTag(STagSummaryMsg *pSummary, int16_t colId) {
+  for (int32_t i = 0; i < pSummary->numOfTags; ++i) {
+    if (pSummary->colIds[i] == colId) return true;
+  }
+
+  return false;
+}
+
+// false if none of the child tables in the vgroup, whose tag values are summarized by the bloom filter, can match
+static bool tscTagCondMayMatch(tExprNode *pExpr, STagSummaryMsg *pSummary, const uint8_t *bloom) {
+  if (pExpr == NULL || pExpr->nodeType != TSQL_NODE_EXPR) {
+    return true;
+  }
+
+  uint8_t optr = pExpr->_node.optr;
+  if (optr == TSDB_RELATION_AND) {
+    return tscTagCondMayMatch(pExpr->_node.pLeft, pSummary, bloom) &&
+           tscTagCondMayMatch(pExpr->_node.pRight, pSummary, bloom);
+  } else if (optr == TSDB_RELATION_OR) {
+    return tscTagCondMayMatch(pExpr->_node.pLeft, pSummary, bloom) ||
+           tscTagCondMayMatch(pExpr->_node.pRight, pSummary, bloom);
+  }
+
+  tExprNode *pLeft = pExpr->_node.pLeft;
+  tExprNode *pRight = pExpr->_node.pRight;
+  if (optr != TSDB_RELATION_EQUAL || pLeft->nodeType != TSQL_NODE_COL || pRight->nodeType != TSQL_NODE_VALUE) {
+    return true;
+  }
+
+  SSchema *pSchema = pLeft->pSchema;
+  if (!tTagValueHashable(pSchema->type) || !isSummarizedTag(pSummary, pSchema->colId)) {
+    return true;
+  }
+
+  // the value is converted to the type of the tag in the same way as vnode does before comparison
+  tVariant *pVal = pRight->pVal;
+  if (pSchema->type == TSDB_DATA_TYPE_BINARY && pVal->nType != TSDB_DATA_TYPE_BINARY) {
+    return true;
+  }
+
+  char *val = calloc(1, pSchema->bytes + pVal->nLen + VARSTR_HEADER_SIZE);
+  if (val == NULL) {
+    return true;
+  }
+
+  bool mayMatch = true;
+  if (pSchema->type == TSDB_DATA_TYPE_BINARY) {
+    if (tVariantDump(pVal, varDataVal(val), pSchema->type) == 0 && pVal->nLen + VARSTR_HEADER_SIZE <= pSchema->bytes) {
+      varDataSetLen(val, pVal->nLen);
+      mayMatch = tTagBloomTest(bloom, tTagValueHash(pSchema->colId, pSchema->type, val));
+    }
+  } else if (tVariantDump(pVal, val, pSchema->type) == 0) {
+    mayMatch = tTagBloomTest(bloom, tTagValueHash(pSchema->colId, pSchema->type, val));
+  }
+
+  free(val);
+  return mayMatch;
+}
+
+int32_t tscPruneVgroupsByTagCond(SSqlObj *pSql, SQueryInfo *pQueryInfo, STableMetaInfo *pTableMetaInfo) {
+  SVgroupsInfo *pVgroupList = pTableMetaInfo->vgroupList;
+  STagCond *    pTagCond = &pQueryInfo->tagCond;
+
+  // the vgroup list of streams and subscriptions is kept for the following queries
+  if (pSql->pStream != NULL || pSql->pSubscription != NULL || QUERY_IS_JOIN_QUERY(pQueryInfo->type)) {
+    return pVgroupList->numOfVgroups;
+  }
+
+  SCond *pCond = tsGetSTableQueryCond(pTagCond, pTableMetaInfo->pTableMeta->uid);
+  if (pCond == NULL || pCond->len == 0 || (pTagCond->tbnameCond.cond != NULL && pTagCond->relType != TSDB_RELATION_AND)) {
+    return pVgroupList->numOfVgroups;
+  }
+
+  char key[TSDB_TABLE_ID_LEN + 16];
+  tscGetVgroupListCacheKey(pTableMetaInfo->name, key);
+
+  SVgroupListCache *pCache = taosCacheAcquireByName(tscCacheHandle, key);
+  if (pCache == NULL) {
+    return pVgroupList->numOfVgroups;
+  }
+
+  // the bloom filters are in the same order as the cached list of the same version
+  SVgroupsInfo *  pCachedList = (SVgroupsInfo *)pCache->vgroupList;
+  STagSummaryMsg *pSummary = (STagSummaryMsg *)&pCachedList->vgroups[pCachedList->numOfVgroups];
+  uint8_t *       blooms = (uint8_t *)&pSummary->colIds[pSummary->numOfTags];
+
+  if (pCache->version != pTableMetaInfo->vgroupListVersion || pCachedList->numOfVgroups != pVgroupList->numOfVgroups ||
+      pSummary->numOfTags == 0) {
+    taosCacheRelease(tscCacheHandle, (void **)&pCache, false);
+    return pVgroupList->numOfVgroups;
+  }
+
+  tExprNode *pExpr = NULL;
+  TRY(32) {
+    pExpr = exprTreeFromBinary(pCond->cond, pCond->len);
+  } CATCH(code) {
+    UNUSED(code);
+    pExpr = NULL;
+  } END_TRY
+
+  int32_t numOfVgroups = 0;
+  for (int32_t i = 0; i < pVgroupList->numOfVgroups; ++i) {
+    if (pExpr == NULL || pVgroupList->vgroups[i].vgId != pCachedList->vgroups[i].vgId ||
+        tscTagCondMayMatch(pExpr, pSummary, blooms + i * TSDB_TAG_BLOOM_SIZE)) {
+      pVgroupList->vgroups[numOfVgroups++] = pVgroupList->vgroups[i];
+    }
+  }
+
+  tscTrace("%p %d of %d vgroups of %s may hold the tables qualified for the tag condition", pSql, numOfVgroups,
+           pVgroupList->numOfVgroups, pTableMetaInfo->name);
+
+  pVgroupList->numOfVgroups = numOfVgroups;
+
+  tExprTreeDestroy(&pExpr, NULL);
+  taosCacheRelease(tscCacheHandle, (void **)&pCache, false);
+  return numOfVgroups;
+}
+
 int tscProcessSTableVgroupRsp(SSqlObj *pSql) {
 #if 0
   void **      metricMetaList = NULL;
@@ -2101,29 +2214,64 @@ _error_clean:
   SSqlObj* parent = pSql->param;
   assert(parent != NULL);
   
-  SSqlCmd* pCmd = &parent->cmd;
+  SSqlCmd*    pCmd = &parent->cmd;
+  SQueryInfo* pQueryInfo = tscGetQueryInfoDetail(&pSql->cmd, 0);
   for(int32_t i = 0; i < pStableVgroup->numOfTables; ++i) {
     STableMetaInfo *pInfo = tscGetTableMetaInfoFromCmd(pCmd, pCmd->clauseIndex, i);
-    SVgroupsInfo *  pVgroupInfo = (SVgroupsInfo *)pMsg;
+    STableMetaInfo *pCachedInfo = tscGetMetaInfo(pQueryInfo, i);
+
+    int64_t version = htobe64(*(int64_t *)pMsg);
+    pMsg += sizeof(int64_t);
+
+    SVgroupsInfo *pVgroupInfo = (SVgroupsInfo *)pMsg;
     pVgroupInfo->numOfVgroups = htonl(pVgroupInfo->numOfVgroups);
 
-    size_t size = sizeof(SCMVgroupInfo) * pVgroupInfo->numOfVgroups + sizeof(SVgroupsInfo);
-    pInfo->vgroupList = calloc(1, size);
-    assert(pInfo->vgroupList != NULL);
+    tfree(pInfo->vgroupList);
+
+    if (pVgroupInfo->numOfVgroups == TSDB_VGROUP_LIST_UNCHANGED) {
+      if (pCachedInfo->vgroupList == NULL) {
+        tscError("%p vgroup list of %s is not cached", pSql, pInfo->name);
+        return TSDB_CODE_INVALID_VALUE;
+      }
 
-    memcpy(pInfo->vgroupList, pVgroupInfo, size);
-    for (int32_t j = 0; j < pInfo->vgroupList->numOfVgroups; ++j) {
-      SCMVgroupInfo *pVgroups = &pInfo->vgroupList->vgroups[j];
+      size_t size = sizeof(SCMVgroupInfo) * pCachedInfo->vgroupList->numOfVgroups + sizeof(SVgroupsInfo);
+      pInfo->vgroupList = malloc(size);
+      assert(pInfo->vgroupList != NULL);
 
-      pVgroups->vgId = htonl(pVgroups->vgId);
-      assert(pVgroups->numOfIps >= 1);
+      memcpy(pInfo->vgroupList, pCachedInfo->vgroupList, size);
+      pMsg += sizeof(SVgroupsInfo);
+    } else {
+      size_t size = sizeof(SCMVgroupInfo) * pVgroupInfo->numOfVgroups + sizeof(SVgroupsInfo);
+      pInfo->vgroupList = calloc(1, size);
+      assert(pInfo->vgroupList != NULL);
 
-      for (int32_t k = 0; k < pVgroups->numOfIps; ++k) {
-        pVgroups->ipAddr[k].port = htons(pVgroups->ipAddr[k].port);
+      memcpy(pInfo->vgroupList, pVgroupInfo, size);
+      for (int32_t j = 0; j < pInfo->vgroupList->numOfVgroups; ++j) {
+        SCMVgroupInfo *pVgroups = &pInfo->vgroupList->vgroups[j];
+
+        pVgroups->vgId = htonl(pVgroups->vgId);
+        assert(pVgroups->numOfIps >= 1);
+
+        for (int32_t k = 0; k < pVgroups->numOfIps; ++k) {
+          pVgroups->ipAddr[k].port = htons(pVgroups->ipAddr[k].port);
+        }
       }
 
       pMsg += size;
+
+      STagSummaryMsg *pSummary = (STagSummaryMsg *)pMsg;
+      pSummary->numOfTags = htons(pSummary->numOfTags);
+      for (int32_t j = 0; j < pSummary->numOfTags; ++j) {
+        pSummary->colIds[j] = htons(pSummary->colIds[j]);
+      }
+
+      pMsg += tscGetTagSummarySize(pSummary, pInfo->vgroupList->numOfVgroups);
+      tscPutVgroupListIntoCache(pInfo->name, pInfo->vgroupList, pSummary, version);
     }
+
+    pInfo->vgroupListVersion = version;
+    tscTrace("%p vgroup list of %s, numOfVgroups:%d version:%" PRIx64 " unchanged:%d", pSql, pInfo->name,
+             pInfo->vgroupList->numOfVgroups, version, pVgroupInfo->numOfVgroups == TSDB_VGROUP_LIST_UNCHANGED);
   }
   
   return pSql->res.code;
@@ -2428,6 +2576,46 @@ int32_t tscGetTableMeta(SSqlObj *pSql, STableMetaInfo *pTableMetaInfo) {
   return getTableMetaFromMgmt(pSql, pTableMetaInfo);
 }
 
+void tscMultiTableMetaCallBack(void *param, TAOS_RES *res, int code);
+
+int32_t tscGetMultiTableMeta(SSqlObj *pSql, const char *tableIds, int32_t numOfTables) {
+  SSqlObj *pNew = calloc(1, sizeof(SSqlObj));
+  if (NULL == pNew) {
+    tscError("%p malloc failed for new sqlobj to get multi table meta", pSql);
+    return TSDB_CODE_CLI_OUT_OF_MEMORY;
+  }
+
+  pNew->pTscObj = pSql->pTscObj;
+  pNew->signature = pNew;
+  pNew->cmd.command = TSDB_SQL_MULTI_META;
+
+  tscAddSubqueryInfo(&pNew->cmd);
+
+  SQueryInfo *pNewQueryInfo = NULL;
+  tscGetQueryInfoDetailSafely(&pNew->cmd, 0, &pNewQueryInfo);
+
+  STableMetaInfo *pNewMeterMetaInfo = tscAddEmptyMetaInfo(pNewQueryInfo);
+  strncpy(pNewMeterMetaInfo->name, tableIds, tListLen(pNewMeterMetaInfo->name));
+
+  int32_t size = sizeof(SCMMultiTableInfoMsg) + numOfTables * TSDB_TABLE_ID_LEN;
+  if (TSDB_CODE_SUCCESS != tscAllocPayload(&pNew->cmd, size)) {
+    tscError("%p malloc failed for payload to get multi table meta", pSql);
+    tscFreeSqlObj(pNew);
+    return TSDB_CODE_CLI_OUT_OF_MEMORY;
+  }
+
+  memcpy(pNew->cmd.payload + sizeof(SCMMultiTableInfoMsg), tableIds, numOfTables * TSDB_TABLE_ID_LEN);
+  pNew->cmd.count = numOfTables;
+  tscTrace("%p new pSqlObj:%p to get multi table meta, numOfTables:%d", pSql, pNew, numOfTables);
+
+  pNew->fp = tscMultiTableMetaCallBack;
+  pNew->param = pSql;
+
+  // the callback is invoked even if it is failed to send the request
+  tscProcessSql(pNew);
+  return TSDB_CODE_ACTION_IN_PROGRESS;
+}
+
 int tscGetMeterMetaEx(SSqlObj *pSql, STableMetaInfo *pTableMetaInfo, bool createIfNotExists) {
   pSql->cmd.autoCreated = createIfNotExists;
   return tscGetTableMeta(pSql, pTableMetaInfo);
@@ -2521,7 +2709,8 @@ int tscGetSTableVgroupInfo(SSqlObj *pSql, int32_t clauseIndex) {
   for (int32_t i = 0; i < pQueryInfo->numOfTables; ++i) {
     STableMetaInfo *pMInfo = tscGetMetaInfo(pQueryInfo, i);
     STableMeta *pTableMeta = taosCacheAcquireByData(tscCacheHandle, pMInfo->pTableMeta);
-    tscAddTableMetaInfo(pNewQueryInfo, pMInfo->name, pTableMeta, NULL, pMInfo->tagColList);
+    STableMetaInfo *pNewInfo = tscAddTableMetaInfo(pNewQueryInfo, pMInfo->name, pTableMeta, NULL, pMInfo->tagColList);
+    tscGetVgroupListFromCache(pNewInfo);
   }
 
   if ((code = tscAllocPayload(&pNew->cmd, TSDB_DEFAULT_PAYLOAD_SIZE)) != TSDB_CODE_SUCCESS) {
@@ -443,7 +443,7 @@ TAOS_ROW taos_fetch_row(TAOS_RES *res) {
   SSqlCmd *pCmd = &pSql->cmd;
   SSqlRes *pRes = &pSql->res;
   
-  if (pRes->qhandle == 0 ||
+  if ((pRes->qhandle == 0 && !tscSetVnodeExhausted(pSql)) ||
       pCmd->command == TSDB_SQL_RETRIEVE_EMPTY_RESULT ||
       pCmd->command == TSDB_SQL_INSERT) {
     return NULL;
@@ -843,69 +843,60 @@ static int tscParseTblNameList(SSqlObj *pSql, const char *tblNameList, int32_t t
 
   STableMetaInfo *pTableMetaInfo = tscAddEmptyMetaInfo(pQueryInfo);
 
-  if ((code = tscAllocPayload(pCmd, tblListLen + 16)) != TSDB_CODE_SUCCESS) {
+  int32_t numOfTables = 1;
+  for (int32_t i = 0; i < tblListLen; ++i) {
+    if (str[i] == ',') numOfTables++;
+  }
+
+  // the table ids are kept after the SCMMultiTableInfoMsg, each of which takes TSDB_TABLE_ID_LEN bytes
+  int32_t size = sizeof(SCMMultiTableInfoMsg) + numOfTables * TSDB_TABLE_ID_LEN;
+  if ((code = tscAllocPayload(pCmd, MAX(size, TSDB_DEFAULT_PAYLOAD_SIZE))) != TSDB_CODE_SUCCESS) {
     return code;
   }
 
-  char *nextStr;
+  if (numOfTables > TSDB_MULTI_METERMETA_MAX_NUM) {
+    sprintf(pCmd->payload, "tables over the max number");
+    return TSDB_CODE_INVALID_TABLE_ID;
+  }
+
+  char *pMsg = pCmd->payload + sizeof(SCMMultiTableInfoMsg);
   char  tblName[TSDB_TABLE_ID_LEN];
-  int   payloadLen = 0;
-  char *pMsg = pCmd->payload;
-  while (1) {
-    nextStr = strchr(str, ',');
-    if (nextStr == NULL) {
-      break;
+
+  while (str != NULL) {
+    char *  nextStr = strchr(str, ',');
+    int32_t len = (nextStr == NULL) ? (int32_t)strlen(str) : (int32_t)(nextStr - str);
+    if (len >= TSDB_TABLE_ID_LEN) {
+      sprintf(pCmd->payload, "table name is invalid");
+      return TSDB_CODE_INVALID_TABLE_ID;
     }
 
-    memcpy(tblName, str, nextStr - str);
-    int32_t len = nextStr - str;
+    memcpy(tblName, str, len);
     tblName[len] = '\0';
 
-    str = nextStr + 1;
+    str = (nextStr == NULL) ? NULL : nextStr + 1;
 
     strtrim(tblName);
     len = (uint32_t)strlen(tblName);
+    if (len == 0) continue;
 
     SSQLToken sToken = {.n = len, .type = TK_ID, .z = tblName};
     tSQLGetToken(tblName, &sToken.type);
 
     // Check if the table name available or not
     if (tscValidateName(&sToken) != TSDB_CODE_SUCCESS) {
-      code = TSDB_CODE_INVALID_TABLE_ID;
       sprintf(pCmd->payload, "table name is invalid");
-      return code;
+      return TSDB_CODE_INVALID_TABLE_ID;
     }
 
     if ((code = tscSetTableId(pTableMetaInfo, &sToken, pSql)) != TSDB_CODE_SUCCESS) {
       return code;
     }
 
-    if (++pCmd->count > TSDB_MULTI_METERMETA_MAX_NUM) {
-      code = TSDB_CODE_INVALID_TABLE_ID;
-      sprintf(pCmd->payload, "tables over the max number");
-      return code;
-    }
-
-    if (payloadLen + strlen(pTableMetaInfo->name) + 128 >= pCmd->allocSize) {
-      char *pNewMem = realloc(pCmd->payload, pCmd->allocSize + tblListLen);
-      if (pNewMem == NULL) {
-        code = TSDB_CODE_CLI_OUT_OF_MEMORY;
-        sprintf(pCmd->payload, "failed to allocate memory");
-        return code;
-      }
-
-      pCmd->payload = pNewMem;
-      pCmd->allocSize = pCmd->allocSize + tblListLen;
-      pMsg = pCmd->payload;
-    }
-
-    payloadLen += sprintf(pMsg + payloadLen, "%s,", pTableMetaInfo->name);
+    strncpy(pMsg + pCmd->count * TSDB_TABLE_ID_LEN, pTableMetaInfo->name, TSDB_TABLE_ID_LEN);
+    pCmd->count++;
   }
 
-  *(pMsg + payloadLen) = '\0';
-  pCmd->payloadLen = payloadLen + 1;
-
-  return TSDB_CODE_SUCCESS;
+  return (pCmd->count > 0) ? TSDB_CODE_SUCCESS : TSDB_CODE_INVALID_TABLE_ID;
 }
 
 int taos_load_table_info(TAOS *taos, const char *tableNameList) {
@@ -925,7 +916,8 @@ int taos_load_table_info(TAOS *taos, const char *tableNameList) {
 
   pRes->code = 0;
 
-  assert(pSql->fp == NULL);
+  pSql->fp = waitForQueryRsp;
+  pSql->param = taos;
   tscTrace("%p tableNameList: %s pObj:%p", pSql, tableNameList, pObj);
 
   int32_t tblListLen = strlen(tableNameList);
@@ -943,7 +935,7 @@ int taos_load_table_info(TAOS *taos, const char *tableNameList) {
   }
 
   strtolower(str, tableNameList);
-  pRes->code = (uint8_t)tscParseTblNameList(pSql, str, tblListLen);
+  pRes->code = tscParseTblNameList(pSql, str, tblListLen);
 
   /*
    * set the qhandle to 0 before return in order to erase the qhandle value assigned in the previous successful query.
@@ -958,6 +950,7 @@ int taos_load_table_info(TAOS *taos, const char *tableNameList) {
   }
 
   tscDoQuery(pSql);
+  sem_wait(&pSql->rspSem);
 
   tscTrace("%p load multi metermeta result:%d %s pObj:%p", pSql, pRes->code, taos_errstr(taos), pObj);
   if (pRes->code != TSDB_CODE_SUCCESS) {
@@ -0,0 +1,811 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "os.h"
+#include "tcache.h"
+#include "tglobal.h"
+#include "tschemautil.h"
+#include "tscLog.h"
+#include "tscSqlCache.h"
+#include "tscUtil.h"
+#include "tsclient.h"
+#include "ttime.h"
+#include "ttokendef.h"
+
+#define TSC_SQL_CACHE_MAX_PARAMS 16
+#define TSC_SQL_PARAM_MAX_TOKENS 3
+
+/*
+ * a param is the value of a comparison between a column and the value, e.g., ts > now - 1h, or v = 'abc', the
+ * value is a literal value, now, or now with an offset.
+ *
+ * In a prepared statement, the value may be a placeholder '?' as well, which also appears after limit or offset
+ * without a column.
+ */
+typedef struct SSqlParam {
+  SSQLToken col;
+  int32_t   optr;
+  int32_t   numOfTokens;
+  SSQLToken value[TSC_SQL_PARAM_MAX_TOKENS];
+  int16_t   index;     // index of the bound value of a placeholder, -1 for a literal value
+  int16_t   colIndex;  // index of the column filtered by the bound value
+} SSqlParam;
+
+typedef struct SNormalizedSql {
+  char *    key;
+  bool      orCond;  // the conditions are not simply joined by and
+  int32_t   numOfParams;
+  SSqlParam params[TSC_SQL_CACHE_MAX_PARAMS];
+} SNormalizedSql;
+
+struct SSqlTemplate {
+  SQueryInfo *pQueryInfo;  // validated query without the table meta info
+  char        tableId[TSDB_TABLE_ID_LEN];
+  SArray *    tagColList;
+  uint64_t    uid;         // the template is discarded once the meta of the table is changed
+  int16_t     sversion;
+  int16_t     numOfColumns;
+  uint8_t     numOfTags;
+  SSchema *   schema;      // columns and tags of the table, which are renamed, dropped or added without new sversion
+  uint8_t     precision;
+  uint32_t    timeParams;  // bitmap of the params on the primary timestamp column, which decide the time range
+  char *      values;      // values of the other params, which must be identical to reuse the cached template
+  char *      sql;         // sql string of the prepared statement, which the tokens of the params refer to
+  SNormalizedSql *pNorm;   // params of the prepared statement
+};
+
+static SCacheObj *tscSqlCache = NULL;
+
+static void tscFreeSqlTemplate(void *data) {
+  SSqlTemplate *pTemplate = data;
+
+  tscQueryInfoDestroy(pTemplate->pQueryInfo);
+  tscColumnListDestroy(pTemplate->tagColList);
+  tfree(pTemplate->schema);
+  tfree(pTemplate->values);
+  tfree(pTemplate->sql);
+
+  if (pTemplate->pNorm != NULL) {
+    free(pTemplate->pNorm->key);
+    tfree(pTemplate->pNorm);
+  }
+}
+
+void tscInitSqlCache() {
+  if (tsSqlCacheKeepTimer <= 0 || tscSqlCache != NULL) {
+    return;
+  }
+
+  tscSqlCache = taosCacheInitWithCb(tscTmr, 2, tscFreeSqlTemplate);
+  if (tscSqlCache == NULL) {
+    tscError("failed to init the sql cache");
+  }
+}
+
+void tscCleanupSqlCache() {
+  if (tscSqlCache != NULL) {
+    taosCacheCleanup(tscSqlCache);
+    tscSqlCache = NULL;
+  }
+}
+
+static bool isComparisonOptr(uint32_t type) {
+  return type == TK_LT || type == TK_LE || type == TK_GT || type == TK_GE || type == TK_EQ || type == TK_NE;
+}
+
+static bool isArithmeticOptr(uint32_t type) {
+  return type == TK_PLUS || type == TK_MINUS || type == TK_STAR || type == TK_DIVIDE || type == TK_REM ||
+         type == TK_CONCAT;
+}
+
+// number of tokens of the param value starting from tokens[index], 0 if it is not a param value
+static int32_t getParamValueLen(SSQLToken *tokens, int32_t index, int32_t numOfTokens) {
+  int32_t len = 0;
+
+  switch (tokens[index].type) {
+    case TK_INTEGER:
+    case TK_FLOAT:
+    case TK_STRING:
+    case TK_BOOL:
+    case TK_QUESTION:
+      len = 1;
+      break;
+    case TK_NOW:
+      len = (index + 2 < numOfTokens && (tokens[index + 1].type == TK_PLUS || tokens[index + 1].type == TK_MINUS) &&
+             tokens[index + 2].type == TK_VARIABLE) ? 3 : 1;
+      break;
+    default:
+      return 0;
+  }
+
+  // the value is a part of an arithmetic expression
+  if (index + len < numOfTokens && isArithmeticOptr(tokens[index + len].type)) {
+    return 0;
+  }
+
+  return len;
+}
+
+static int32_t tscNormalizeSql(const char *sql, const char *db, bool placeholders, SNormalizedSql *pNorm) {
+  size_t len = strlen(sql);
+
+  SSQLToken *tokens = malloc((len + 1) * sizeof(SSQLToken));
+  if (tokens == NULL) {
+    return TSDB_CODE_CLI_OUT_OF_MEMORY;
+  }
+
+  int32_t numOfTokens = 0;
+  for (int32_t i = 0; sql[i] != 0;) {
+    SSQLToken t = {0};
+    t.n = tSQLGetToken((char *)&sql[i], &t.type);
+    t.z = (char *)&sql[i];
+    i += t.n;
+
+    if (t.type == TK_SPACE || t.type == TK_COMMENT) {
+      continue;
+    } else if (t.type == TK_SEMI) {
+      break;
+    } else if (t.type == TK_ILLEGAL || (t.type == TK_QUESTION && !placeholders)) {
+      free(tokens);
+      return TSDB_CODE_INVALID_SQL;
+    }
+
+    tokens[numOfTokens++] = t;
+  }
+
+  // each token is followed by a space at most
+  pNorm->key = malloc(strlen(db) + 2 * len + 2);
+  if (pNorm->key == NULL) {
+    free(tokens);
+    return TSDB_CODE_CLI_OUT_OF_MEMORY;
+  }
+
+  char *  p = pNorm->key + sprintf(pNorm->key, "%s\n", db);
+  int16_t numOfPlaceholders = 0;
+
+  pNorm->numOfParams = 0;
+  pNorm->orCond = false;
+
+  for (int32_t i = 0; i < numOfTokens; ++i) {
+    int32_t valueLen = 0;
+    if (i >= 2 && tokens[i - 2].type == TK_ID && isComparisonOptr(tokens[i - 1].type) &&
+        pNorm->numOfParams < TSC_SQL_CACHE_MAX_PARAMS) {
+      valueLen = getParamValueLen(tokens, i, numOfTokens);
+    }
+
+    if (valueLen == 0 && tokens[i].type == TK_QUESTION) {
+      // the placeholder of limit or offset, or the one that can not be bound without parsing
+      if (i == 0 || pNorm->numOfParams >= TSC_SQL_CACHE_MAX_PARAMS) {
+        free(tokens);
+        tfree(pNorm->key);
+        return TSDB_CODE_INVALID_SQL;
+      }
+
+      SSqlParam *pParam = &pNorm->params[pNorm->numOfParams++];
+      memset(&pParam->col, 0, sizeof(SSQLToken));
+      pParam->optr = tokens[i - 1].type;
+      pParam->numOfTokens = 1;
+      pParam->value[0] = tokens[i];
+      pParam->index = numOfPlaceholders++;
+      pParam->colIndex = -1;
+
+      *p++ = '?';
+    } else if (valueLen > 0) {
+      SSqlParam *pParam = &pNorm->params[pNorm->numOfParams++];
+      pParam->col = tokens[i - 2];
+      pParam->optr = tokens[i - 1].type;
+      pParam->numOfTokens = valueLen;
+      memcpy(pParam->value, &tokens[i], valueLen * sizeof(SSQLToken));
+      pParam->index = (tokens[i].type == TK_QUESTION) ? numOfPlaceholders++ : -1;
+      pParam->colIndex = -1;
+
+      *p++ = '?';
+      i += valueLen - 1;
+    } else {
+      pNorm->orCond |= (tokens[i].type == TK_OR);
+      memcpy(p, tokens[i].z, tokens[i].n);
+      p += tokens[i].n;
+    }
+
+    *p++ = ' ';
+  }
+
+  *p = 0;
+  free(tokens);
+  return TSDB_CODE_SUCCESS;
+}
+
+static char *tscGetParamValues(SNormalizedSql *pNorm, uint32_t timeParams) {
+  size_t len = 1;
+  for (int32_t i = 0; i < pNorm->numOfParams; ++i) {
+    len += pNorm->params[i].value[0].n + 1;
+  }
+
+  char *values = malloc(len);
+  if (values == NULL) {
+    return NULL;
+  }
+
+  char *p = values;
+  for (int32_t i = 0; i < pNorm->numOfParams; ++i) {
+    if ((timeParams & (1u << i)) == 0) {
+      SSQLToken *pValue = &pNorm->params[i].value[0];  // the value of other params is a single token
+      memcpy(p, pValue->z, pValue->n);
+      p += pValue->n;
+      *p++ = '\n';
+    }
+  }
+
+  *p = 0;
+  return values;
+}
+
+// the bound value is converted to the token of a literal value, as if it is in the sql string
+static int32_t tscGetTimeRangeOfBoundValue(STimeWindow *win, tVariant *pVar, int32_t optr, int16_t precision) {
+  char      buf[64] = {0};
+  SSQLToken token = {.z = buf};
+
+  switch (pVar->nType) {
+    case TSDB_DATA_TYPE_TINYINT:
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      token.n = sprintf(buf, "%" PRId64, pVar->i64Key);
+      token.type = TK_INTEGER;
+      break;
+    case TSDB_DATA_TYPE_BINARY:
+      if (pVar->nLen + 2 >= sizeof(buf) || strchr(pVar->pz, '\'') != NULL) {
+        return TSDB_CODE_INVALID_VALUE;
+      }
+      token.n = sprintf(buf, "'%s'", pVar->pz);
+      token.type = TK_STRING;
+      break;
+    default:
+      return TSDB_CODE_INVALID_VALUE;
+  }
+
+  return tscGetTimeRangeFromTokens(win, &token, 1, optr, precision);
+}
+
+static int32_t tscGetWindowOfParams(SNormalizedSql *pNorm, uint32_t timeParams, tVariant *bound, int16_t precision,
+                                    STimeWindow *win) {
+  *win = TSWINDOW_INITIALIZER;
+
+  for (int32_t i = 0; i < pNorm->numOfParams; ++i) {
+    if ((timeParams & (1u << i)) == 0) {
+      continue;
+    }
+
+    SSqlParam * pParam = &pNorm->params[i];
+    STimeWindow w = TSWINDOW_INITIALIZER;
+
+    int32_t code = (pParam->index < 0)
+                       ? tscGetTimeRangeFromTokens(&w, pParam->value, pParam->numOfTokens, pParam->optr, precision)
+                       : tscGetTimeRangeOfBoundValue(&w, &bound[pParam->index], pParam->optr, precision);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+
+    if (win->skey < w.skey) win->skey = w.skey;
+    if (win->ekey > w.ekey) win->ekey = w.ekey;
+  }
+
+  // the time range is in microsecond
+  if (precision == TSDB_TIME_PRECISION_MILLI) {
+    win->skey = win->skey / 1000;
+    win->ekey = win->ekey / 1000;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static bool isTemplateQuery(SQueryInfo *pQueryInfo) {
+  if (pQueryInfo->command != TSDB_SQL_SELECT || pQueryInfo->numOfTables != 1 ||
+      QUERY_IS_JOIN_QUERY(pQueryInfo->type) || pQueryInfo->tsBuf != NULL || tscIsPointInterpQuery(pQueryInfo)) {
+    return false;
+  }
+
+  if (tscGetMetaInfo(pQueryInfo, 0)->pTableMeta == NULL) {
+    return false;
+  }
+
+  for (int32_t i = 0; i < pQueryInfo->fieldsInfo.numOfOutput; ++i) {
+    if (tscFieldInfoGetSupp(&pQueryInfo->fieldsInfo, i)->pArithExprInfo != NULL) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// validate the new time range as it is done in parsing the sql string
+static bool isValidTimeRange(SQueryInfo *pQueryInfo, STimeWindow *win, int16_t precision) {
+  if (win->skey > win->ekey) {
+    return false;
+  }
+
+  if (tscIsTWAQuery(pQueryInfo) && (win->skey == 0 || win->ekey == INT64_MAX ||
+                                    (win->ekey == INT64_MAX / 1000 && precision == TSDB_TIME_PRECISION_MILLI))) {
+    return false;
+  }
+
+  if (pQueryInfo->fillType != TSDB_FILL_NONE && pQueryInfo->intervalTime > 0) {
+    int64_t timeRange = labs(win->skey - win->ekey);
+    if (timeRange == 0 || (timeRange / pQueryInfo->intervalTime) > MAX_RETRIEVE_ROWS_IN_INTERVAL_QUERY) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool isSameSchema(SSchema *pSchema1, SSchema *pSchema2, int32_t numOfCols) {
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    if (pSchema1[i].type != pSchema2[i].type || pSchema1[i].colId != pSchema2[i].colId ||
+        pSchema1[i].bytes != pSchema2[i].bytes || strcmp(pSchema1[i].name, pSchema2[i].name) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// the table meta is released by the caller if the template is not used
+static STableMeta *tscAcquireTemplateMeta(SSqlObj *pSql, SSqlTemplate *pTemplate) {
+  STableMeta *pTableMeta = taosCacheAcquireByName(tscCacheHandle, pTemplate->tableId);
+  if (pTableMeta == NULL) {
+    return NULL;
+  }
+
+  STableComInfo tinfo = tscGetTableInfo(pTableMeta);
+  if (pTableMeta->uid != pTemplate->uid || pTableMeta->sversion != pTemplate->sversion ||
+      tinfo.numOfColumns != pTemplate->numOfColumns || tinfo.numOfTags != pTemplate->numOfTags ||
+      !isSameSchema(tscGetTableSchema(pTableMeta), pTemplate->schema, tinfo.numOfColumns + tinfo.numOfTags)) {
+    tscTrace("%p table meta of %s is changed, the sql template is not used", pSql, pTemplate->tableId);
+    taosCacheRelease(tscCacheHandle, (void **)&pTableMeta, false);
+    return NULL;
+  }
+
+  return pTableMeta;
+}
+
+static SColumn *tscGetFilteredColumn(SQueryInfo *pQueryInfo, int16_t colIndex) {
+  size_t numOfCols = taosArrayGetSize(pQueryInfo->colList);
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumn *pCol = taosArrayGetP(pQueryInfo->colList, i);
+    if (pCol->colIndex.tableIndex == 0 && pCol->colIndex.columnIndex == colIndex) {
+      return pCol;
+    }
+  }
+
+  return NULL;
+}
+
+/*
+ * Convert the bound values of limit, offset and the filters of the normal columns in the same way as the parser,
+ * before the query is built from the template. The params on the primary timestamp column are not included.
+ */
+static int32_t tscGetBoundValues(SSqlTemplate *pTemplate, STableMeta *pTableMeta, tVariant *params, int64_t *bound) {
+  SNormalizedSql *pNorm = pTemplate->pNorm;
+
+  for (int32_t i = 0; i < pNorm->numOfParams; ++i) {
+    SSqlParam *pParam = &pNorm->params[i];
+    if (pParam->index < 0 || (pTemplate->timeParams & (1u << i)) != 0) {
+      continue;
+    }
+
+    tVariant *pVar = &params[pParam->index];
+    if (pVar->nType == TSDB_DATA_TYPE_NULL) {
+      return TSDB_CODE_INVALID_VALUE;
+    }
+
+    if (pParam->optr == TK_LIMIT || pParam->optr == TK_OFFSET) {
+      if (pVar->nType < TSDB_DATA_TYPE_TINYINT || pVar->nType > TSDB_DATA_TYPE_BIGINT) {
+        return TSDB_CODE_INVALID_VALUE;
+      }
+
+      // limit 0 is handled by the parser, no query is sent
+      if ((pParam->optr == TK_LIMIT && pVar->i64Key <= 0) || (pParam->optr == TK_OFFSET && pVar->i64Key < 0)) {
+        return TSDB_CODE_INVALID_VALUE;
+      }
+
+      bound[i] = pVar->i64Key;
+      continue;
+    }
+
+    int16_t type = tscGetTableColumnSchema(pTableMeta, pParam->colIndex)->type;
+    type = (type >= TSDB_DATA_TYPE_TINYINT && type <= TSDB_DATA_TYPE_BIGINT) ? TSDB_DATA_TYPE_BIGINT
+                                                                                 : TSDB_DATA_TYPE_DOUBLE;
+    if (tVariantDump(pVar, (char *)&bound[i], type) != 0) {
+      return TSDB_CODE_INVALID_VALUE;
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static void tscSetBoundValues(SQueryInfo *pQueryInfo, SSqlTemplate *pTemplate, int64_t *bound) {
+  SNormalizedSql *pNorm = pTemplate->pNorm;
+
+  for (int32_t i = 0; i < pNorm->numOfParams; ++i) {
+    SSqlParam *pParam = &pNorm->params[i];
+    if (pParam->index < 0 || (pTemplate->timeParams & (1u << i)) != 0) {
+      continue;
+    }
+
+    if (pParam->optr == TK_LIMIT) {
+      pQueryInfo->limit.limit = bound[i];
+      pQueryInfo->clauseLimit = bound[i];
+    } else if (pParam->optr == TK_OFFSET) {
+      pQueryInfo->limit.offset = bound[i];
+    } else {
+      SColumnFilterInfo *pFilter = &tscGetFilteredColumn(pQueryInfo, pParam->colIndex)->filterInfo[0];
+      if (pParam->optr == TK_LT || pParam->optr == TK_LE) {
+        memcpy(&pFilter->upperBndi, &bound[i], sizeof(int64_t));
+      } else {  // TK_GT, TK_GE, TK_EQ, TK_NE are based on the lower bound
+        memcpy(&pFilter->lowerBndi, &bound[i], sizeof(int64_t));
+      }
+    }
+  }
+}
+
+static int32_t tscQueryFromTemplate(SSqlObj *pSql, SSqlTemplate *pTemplate, STableMeta *pTableMeta, STimeWindow *win,
+                                    int64_t *bound) {
+  SSqlCmd *   pCmd = &pSql->cmd;
+  SQueryInfo *pQueryInfo = NULL;
+
+  int32_t code = tscGetQueryInfoDetailSafely(pCmd, 0, &pQueryInfo);
+  if (code != TSDB_CODE_SUCCESS) {
+    taosCacheRelease(tscCacheHandle, (void **)&pTableMeta, false);
+    return code;
+  }
+
+  tscQueryInfoCopy(pQueryInfo, pTemplate->pQueryInfo);
+  pQueryInfo->window = *win;
+
+  if (bound != NULL) {
+    tscSetBoundValues(pQueryInfo, pTemplate, bound);
+  }
+
+  STableMetaInfo *pTableMetaInfo =
+      tscAddTableMetaInfo(pQueryInfo, pTemplate->tableId, pTableMeta, NULL, pTemplate->tagColList);
+  pCmd->command = pQueryInfo->command;
+
+  tscTrace("%p query is built from the sql template, qrange:%" PRId64 "-%" PRId64, pSql, win->skey, win->ekey);
+
+  if (UTIL_TABLE_IS_SUPER_TABLE(pTableMetaInfo)) {
+    // the query is launched in tscTableMetaCallBack once the vgroup list is retrieved
+    pCmd->parseFinished = 1;
+    return tscGetSTableVgroupInfo(pSql, 0);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static bool tscBuildQueryFromTemplate(SSqlObj *pSql, SSqlTemplate *pTemplate, SNormalizedSql *pNorm,
+                                      int32_t *code) {
+  char *values = tscGetParamValues(pNorm, pTemplate->timeParams);
+  if (values == NULL) {
+    return false;
+  }
+
+  bool same = (strcmp(values, pTemplate->values) == 0);
+  free(values);
+
+  STimeWindow win = {0};
+  if (!same ||
+      tscGetWindowOfParams(pNorm, pTemplate->timeParams, NULL, pTemplate->precision, &win) != TSDB_CODE_SUCCESS) {
+    return false;
+  }
+
+  if (pTemplate->timeParams == 0) {
+    win = pTemplate->pQueryInfo->window;
+  }
+
+  if (!isValidTimeRange(pTemplate->pQueryInfo, &win, pTemplate->precision)) {
+    return false;
+  }
+
+  STableMeta *pTableMeta = tscAcquireTemplateMeta(pSql, pTemplate);
+  if (pTableMeta == NULL) {
+    return false;
+  }
+
+  *code = tscQueryFromTemplate(pSql, pTemplate, pTableMeta, &win, NULL);
+  return true;
+}
+
+bool tscGetQueryFromSqlCache(SSqlObj *pSql, int32_t *code) {
+  if (tscSqlCache == NULL || pSql->pStream != NULL || pSql->pStmt != NULL) {
+    return false;
+  }
+
+  SNormalizedSql norm = {0};
+  if (tscNormalizeSql(pSql->sqlstr, pSql->pTscObj->db, false, &norm) != TSDB_CODE_SUCCESS) {
+    return false;
+  }
+
+  SSqlTemplate *pTemplate = taosCacheAcquireByName(tscSqlCache, norm.key);
+  free(norm.key);
+
+  if (pTemplate == NULL) {
+    return false;
+  }
+
+  bool found = tscBuildQueryFromTemplate(pSql, pTemplate, &norm, code);
+  taosCacheRelease(tscSqlCache, (void **)&pTemplate, false);
+  return found;
+}
+
+static bool isPrimaryTimestampParam(SSqlParam *pParam, SSchema *pSchema) {
+  return pParam->col.n == strlen(pSchema[0].name) && strncasecmp(pParam->col.z, pSchema[0].name, pParam->col.n) == 0;
+}
+
+/*
+ * the time range of the template must be exactly the one of the parsed query, except the difference of now between
+ * parsing the sql string and here
+ */
+static bool isSameTimeRange(SSqlObj *pSql, SQueryInfo *pQueryInfo, SSqlTemplate *pTemplate, tVariant *bound,
+                            bool useNow, int64_t parseStart) {
+  STimeWindow win = {0};
+  if (tscGetWindowOfParams(pTemplate->pNorm, pTemplate->timeParams, bound, pTemplate->precision, &win) !=
+      TSDB_CODE_SUCCESS) {
+    return false;
+  }
+
+  if (pTemplate->timeParams == 0) {
+    win = pQueryInfo->window;
+  }
+
+  int64_t tolerance = 0;
+  if (useNow) {
+    tolerance = taosGetTimestampUs() - parseStart;
+    tolerance = (pTemplate->precision == TSDB_TIME_PRECISION_MILLI) ? tolerance / 1000 + 1 : tolerance;
+  }
+
+  if (pQueryInfo->window.skey > win.skey || win.skey - pQueryInfo->window.skey > tolerance ||
+      pQueryInfo->window.ekey > win.ekey || win.ekey - pQueryInfo->window.ekey > tolerance) {
+    tscTrace("%p time range of the sql template differs from the parsed one", pSql);
+    return false;
+  }
+
+  return true;
+}
+
+// the query info is copied into the template, which is freed by tscFreeSqlTemplate on failure
+static bool tscSetTemplateQuery(SSqlTemplate *pTemplate, SQueryInfo *pQueryInfo) {
+  STableMetaInfo *pTableMetaInfo = tscGetMetaInfo(pQueryInfo, 0);
+  STableMeta *    pTableMeta = pTableMetaInfo->pTableMeta;
+  STableComInfo   tinfo = tscGetTableInfo(pTableMeta);
+
+  pTemplate->pQueryInfo = calloc(1, sizeof(SQueryInfo));
+  pTemplate->tagColList = taosArrayInit(4, POINTER_BYTES);
+  pTemplate->schema = malloc(sizeof(SSchema) * (tinfo.numOfColumns + tinfo.numOfTags));
+  if (pTemplate->pQueryInfo == NULL || pTemplate->tagColList == NULL || pTemplate->schema == NULL) {
+    tfree(pTemplate->pQueryInfo);
+    return false;
+  }
+
+  tscInitQueryInfo(pTemplate->pQueryInfo);
+  tscQueryInfoCopy(pTemplate->pQueryInfo, pQueryInfo);
+  tscColumnListCopy(pTemplate->tagColList, pTableMetaInfo->tagColList, -1);
+
+  strncpy(pTemplate->tableId, pTableMetaInfo->name, TSDB_TABLE_ID_LEN);
+  pTemplate->uid = pTableMeta->uid;
+  pTemplate->sversion = pTableMeta->sversion;
+  pTemplate->numOfColumns = tinfo.numOfColumns;
+  pTemplate->numOfTags = tinfo.numOfTags;
+  pTemplate->precision = tinfo.precision;
+  memcpy(pTemplate->schema, tscGetTableSchema(pTableMeta), sizeof(SSchema) * (tinfo.numOfColumns + tinfo.numOfTags));
+  return true;
+}
+
+void tscPutQueryIntoSqlCache(SSqlObj *pSql, int64_t parseStart) {
+  SSqlCmd *pCmd = &pSql->cmd;
+  if (tscSqlCache == NULL || pSql->pStream != NULL || pCmd->command != TSDB_SQL_SELECT || pCmd->numOfClause != 1) {
+    return;
+  }
+
+  SQueryInfo *pQueryInfo = tscGetQueryInfoDetail(pCmd, 0);
+  if (!isTemplateQuery(pQueryInfo)) {
+    return;
+  }
+
+  SNormalizedSql norm = {0};
+  if (tscNormalizeSql(pSql->sqlstr, pSql->pTscObj->db, false, &norm) != TSDB_CODE_SUCCESS) {
+    return;
+  }
+
+  STableMeta * pTableMeta = tscGetMetaInfo(pQueryInfo, 0)->pTableMeta;
+  SSchema *    pSchema = tscGetTableSchema(pTableMeta);
+  SSqlTemplate tpl = {.pNorm = &norm, .precision = tscGetTableInfo(pTableMeta).precision};
+  bool         useNow = false;
+
+  for (int32_t i = 0; i < norm.numOfParams; ++i) {
+    SSqlParam *pParam = &norm.params[i];
+    if (!isPrimaryTimestampParam(pParam, pSchema)) {
+      if (pParam->numOfTokens > 1 || pParam->value[0].type == TK_NOW) {
+        free(norm.key);
+        return;
+      }
+
+      continue;
+    }
+
+    if (pParam->optr == TK_NE) {
+      free(norm.key);
+      return;
+    }
+
+    tpl.timeParams |= (1u << i);
+    useNow |= (pParam->value[0].type == TK_NOW);
+  }
+
+  bool valid = isSameTimeRange(pSql, pQueryInfo, &tpl, NULL, useNow, parseStart);
+  tpl.pNorm = NULL;
+
+  if (!valid) {
+    free(norm.key);
+    return;
+  }
+
+  tpl.values = tscGetParamValues(&norm, tpl.timeParams);
+  if (tpl.values == NULL || !tscSetTemplateQuery(&tpl, pQueryInfo)) {
+    tscFreeSqlTemplate(&tpl);
+    free(norm.key);
+    return;
+  }
+
+  void *p = taosCachePut(tscSqlCache, norm.key, &tpl, sizeof(SSqlTemplate), tsSqlCacheKeepTimer);
+  if (p == NULL) {
+    tscFreeSqlTemplate(&tpl);
+  } else {
+    tscTrace("%p sql template is cached, params:%d, time params:0x%x", pSql, norm.numOfParams, tpl.timeParams);
+    taosCacheRelease(tscSqlCache, &p, false);
+  }
+
+  free(norm.key);
+}
+
+SSqlTemplate *tscCreateStmtTemplate(SSqlObj *pSql, const char *sql, tVariant *params, int32_t numOfParams,
+                                    int64_t parseStart) {
+  SSqlCmd *pCmd = &pSql->cmd;
+  if (pCmd->command != TSDB_SQL_SELECT || pCmd->numOfClause != 1) {
+    return NULL;
+  }
+
+  SQueryInfo *pQueryInfo = tscGetQueryInfoDetail(pCmd, 0);
+  if (!isTemplateQuery(pQueryInfo)) {
+    return NULL;
+  }
+
+  SSqlTemplate *pTemplate = calloc(1, sizeof(SSqlTemplate));
+  if (pTemplate == NULL) {
+    return NULL;
+  }
+
+  pTemplate->sql = strdup(sql);
+  pTemplate->pNorm = calloc(1, sizeof(SNormalizedSql));
+  if (pTemplate->sql == NULL || pTemplate->pNorm == NULL ||
+      tscNormalizeSql(pTemplate->sql, "", true, pTemplate->pNorm) != TSDB_CODE_SUCCESS ||
+      pTemplate->pNorm->orCond) {
+    tscDestroySqlTemplate(pTemplate);
+    return NULL;
+  }
+
+  STableMetaInfo *pTableMetaInfo = tscGetMetaInfo(pQueryInfo, 0);
+  STableMeta *    pTableMeta = pTableMetaInfo->pTableMeta;
+  STableComInfo   tinfo = tscGetTableInfo(pTableMeta);
+  SSchema *       pSchema = tscGetTableSchema(pTableMeta);
+  SNormalizedSql *pNorm = pTemplate->pNorm;
+
+  bool    useNow = false;
+  bool    valid = true;
+  int32_t numOfPlaceholders = 0;
+
+  pTemplate->precision = tinfo.precision;
+
+  for (int32_t i = 0; i < pNorm->numOfParams && valid; ++i) {
+    SSqlParam *pParam = &pNorm->params[i];
+    bool       bound = (pParam->index >= 0);
+    numOfPlaceholders += bound;
+
+    if (isPrimaryTimestampParam(pParam, pSchema)) {
+      if (pParam->optr == TK_NE) {
+        valid = false;
+      }
+
+      pTemplate->timeParams |= (1u << i);
+      useNow |= (pParam->value[0].type == TK_NOW);
+      continue;
+    }
+
+    if (!bound) {
+      valid = (pParam->numOfTokens == 1 && pParam->value[0].type != TK_NOW);
+      continue;
+    }
+
+    // limit and offset of the query on a super table are adjusted by the parser
+    if (pParam->col.n == 0) {
+      valid = (pParam->optr == TK_LIMIT || pParam->optr == TK_OFFSET) && !UTIL_TABLE_IS_SUPER_TABLE(pTableMetaInfo);
+      continue;
+    }
+
+    // only the numeric normal column with a single filter can be bound
+    for (int16_t j = 1; j < tinfo.numOfColumns; ++j) {
+      if (pParam->col.n == strlen(pSchema[j].name) && strncasecmp(pParam->col.z, pSchema[j].name, pParam->col.n) == 0) {
+        pParam->colIndex = j;
+        break;
+      }
+    }
+
+    if (pParam->colIndex < 0 || pSchema[pParam->colIndex].type < TSDB_DATA_TYPE_TINYINT ||
+        pSchema[pParam->colIndex].type > TSDB_DATA_TYPE_DOUBLE) {
+      valid = false;
+      continue;
+    }
+
+    SColumn *pCol = tscGetFilteredColumn(pQueryInfo, pParam->colIndex);
+    valid = (pCol != NULL && pCol->numOfFilters == 1);
+  }
+
+  if (!valid || numOfPlaceholders != numOfParams || !isSameTimeRange(pSql, pQueryInfo, pTemplate, params, useNow, parseStart) ||
+      !tscSetTemplateQuery(pTemplate, pQueryInfo)) {
+    tscDestroySqlTemplate(pTemplate);
+    return NULL;
+  }
+
+  tscTrace("%p sql template of the prepared statement is built, params:%d, time params:0x%x", pSql, numOfParams,
+           pTemplate->timeParams);
+  return pTemplate;
+}
+
+bool tscGetQueryFromStmtTemplate(SSqlObj *pSql, SSqlTemplate *pTemplate, tVariant *params, int32_t *code) {
+  STimeWindow win = {0};
+  if (tscGetWindowOfParams(pTemplate->pNorm, pTemplate->timeParams, params, pTemplate->precision, &win) !=
+      TSDB_CODE_SUCCESS) {
+    return false;
+  }
+
+  if (pTemplate->timeParams == 0) {
+    win = pTemplate->pQueryInfo->window;
+  }
+
+  if (!isValidTimeRange(pTemplate->pQueryInfo, &win, pTemplate->precision)) {
+    return false;
+  }
+
+  STableMeta *pTableMeta = tscAcquireTemplateMeta(pSql, pTemplate);
+  if (pTableMeta == NULL) {
+    return false;
+  }
+
+  int64_t bound[TSC_SQL_CACHE_MAX_PARAMS] = {0};
+  if (tscGetBoundValues(pTemplate, pTableMeta, params, bound) != TSDB_CODE_SUCCESS) {
+    taosCacheRelease(tscCacheHandle, (void **)&pTableMeta, false);
+    return false;
+  }
+
+  *code = tscQueryFromTemplate(pSql, pTemplate, pTableMeta, &win, bound);
+  return true;
+}
+
+void tscDestroySqlTemplate(SSqlTemplate *pTemplate) {
+  if (pTemplate != NULL) {
+    tscFreeSqlTemplate(pTemplate);
+    free(pTemplate);
+  }
+}
@@ -517,22 +517,28 @@ TAOS_STREAM *taos_open_stream(TAOS *taos, const char *sqlstr, void (*fp)(void *p
     return NULL;
   }
   
-  pRes->code = tscToSQLCmd(pSql, &SQLInfo);
-  SQLInfoDestroy(&SQLInfo);
-
-  if (pRes->code != TSDB_CODE_SUCCESS) {
-    setErrorInfo(pObj, pRes->code, pCmd->payload);
+  SSqlStream *pStream = (SSqlStream *)calloc(1, sizeof(SSqlStream));
+  if (pStream == NULL) {
+    setErrorInfo(pObj, TSDB_CODE_CLI_OUT_OF_MEMORY, NULL);
+    SQLInfoDestroy(&SQLInfo);
 
     tscError("%p open stream failed, sql:%s, reason:%s, code:%d", pSql, sqlstr, pCmd->payload, pRes->code);
     tscFreeSqlObj(pSql);
     return NULL;
   }
 
-  SSqlStream *pStream = (SSqlStream *)calloc(1, sizeof(SSqlStream));
-  if (pStream == NULL) {
-    setErrorInfo(pObj, TSDB_CODE_CLI_OUT_OF_MEMORY, NULL);
+  // the stream is set before parsing, so that the vgroup list kept for the following queries is not pruned
+  pSql->pStream = pStream;
+
+  pRes->code = tscToSQLCmd(pSql, &SQLInfo);
+  SQLInfoDestroy(&SQLInfo);
+
+  if (pRes->code != TSDB_CODE_SUCCESS) {
+    setErrorInfo(pObj, pRes->code, pCmd->payload);
 
     tscError("%p open stream failed, sql:%s, reason:%s, code:%d", pSql, sqlstr, pCmd->payload, pRes->code);
+    free(pStream);
+    pSql->pStream = NULL;
     tscFreeSqlObj(pSql);
     return NULL;
   }
@@ -550,7 +556,6 @@ TAOS_STREAM *taos_open_stream(TAOS *taos, const char *sqlstr, void (*fp)(void *p
   pStream->ctime = taosGetTimestamp(pStream->precision);
   pStream->etime = pQueryInfo->window.ekey;
 
-  pSql->pStream = pStream;
   tscAddIntoStreamList(pStream);
 
   tscSetSlidingWindowInfo(pSql, pStream);
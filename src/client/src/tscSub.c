@@ -123,6 +123,20 @@ static SSub* tscCreateSubscription(STscObj* pObj, const char* topic, const char*
     CLEANUP_PUSH_FREE(true, pSql->sqlstr);
     strtolower(pSql->sqlstr, pSql->sqlstr);
 
+    // the subscription is set before parsing, so that the vgroup list kept for the following queries is not pruned
+    pSub = calloc_throw(1, sizeof(SSub));
+    CLEANUP_PUSH_FREE(true, pSub);
+    pSql->pSubscription = pSub;
+    pSub->pSql = pSql;
+    pSub->signature = pSub;
+    strncpy(pSub->topic, topic, sizeof(pSub->topic));
+    pSub->topic[sizeof(pSub->topic) - 1] = 0;
+    pSub->progress = taosArrayInit(32, sizeof(SSubscriptionProgress));
+    if (pSub->progress == NULL) {
+      THROW(TSDB_CODE_CLI_OUT_OF_MEMORY);
+    }
+    CLEANUP_PUSH_VOID_PTR(true, taosArrayDestroy, pSub->progress);
+
     code = tsParseSql(pSql, false);
     if (code == TSDB_CODE_ACTION_IN_PROGRESS) {
       // wait for the callback function to post the semaphore
@@ -139,18 +153,6 @@ static SSub* tscCreateSubscription(STscObj* pObj, const char* topic, const char*
       THROW( -1 );  // TODO
     }
 
-    pSub = calloc_throw(1, sizeof(SSub));
-    CLEANUP_PUSH_FREE(true, pSub);
-    pSql->pSubscription = pSub;
-    pSub->pSql = pSql;
-    pSub->signature = pSub;
-    strncpy(pSub->topic, topic, sizeof(pSub->topic));
-    pSub->topic[sizeof(pSub->topic) - 1] = 0;
-    pSub->progress = taosArrayInit(32, sizeof(SSubscriptionProgress));
-    if (pSub->progress == NULL) {
-      THROW(TSDB_CODE_CLI_OUT_OF_MEMORY);
-    }
-
     CLEANUP_EXECUTE();
 
   } CATCH( code ) {
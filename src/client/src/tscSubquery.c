@@ -20,8 +20,12 @@
 #include "os.h"
 #include "qtsbuf.h"
 #include "tscLog.h"
+#include "tscWriteBuffer.h"
 #include "tsclient.h"
 
+// size of the local buffer of a sub-query of super table query, allocated once the sub-query is launched
+#define TSC_SUBQUERY_BUFFER_SIZE (1u << 16)
+
 typedef struct SInsertSupporter {
   SSubqueryState* pState;
   SSqlObj*  pSql;
@@ -1008,6 +1012,8 @@ static void tscRetrieveDataRes(void *param, TAOS_RES *tres, int code);
 
 static SSqlObj *tscCreateSqlObjForSubquery(SSqlObj *pSql, SRetrieveSupport *trsupport, SSqlObj *prevSqlObj);
 
+static void tscLaunchSubquery(SSqlObj *pSql, int32_t index);
+
 // todo merge with callback
 int32_t tscLaunchJoinSubquery(SSqlObj *pSql, int16_t tableIndex, SJoinSupporter *pSupporter) {
   SSqlCmd *   pCmd = &pSql->cmd;
@@ -1220,15 +1226,13 @@ int32_t tscHandleMasterSTableQuery(SSqlObj *pSql) {
   
   pRes->qhandle = 1;  // hack the qhandle check
   
-  const uint32_t nBufferSize = (1u << 16);  // 64KB
-  
   SQueryInfo *    pQueryInfo = tscGetQueryInfoDetail(pCmd, pCmd->clauseIndex);
   STableMetaInfo *pTableMetaInfo = tscGetMetaInfo(pQueryInfo, 0);
   
   pSql->numOfSubs = pTableMetaInfo->vgroupList->numOfVgroups;
   assert(pSql->numOfSubs > 0);
   
-  int32_t ret = tscLocalReducerEnvCreate(pSql, &pMemoryBuf, &pDesc, &pModel, nBufferSize);
+  int32_t ret = tscLocalReducerEnvCreate(pSql, &pMemoryBuf, &pDesc, &pModel, TSC_SUBQUERY_BUFFER_SIZE);
   if (ret != 0) {
     pRes->code = TSDB_CODE_CLI_OUT_OF_MEMORY;
     tscQueueAsyncRes(pSql);
@@ -1253,14 +1257,6 @@ int32_t tscHandleMasterSTableQuery(SSqlObj *pSql) {
     trs->pExtMemBuffer = pMemoryBuf;
     trs->pOrderDescriptor = pDesc;
     trs->pState = pState;
-    
-    trs->localBuffer = (tFilePage *)calloc(1, nBufferSize + sizeof(tFilePage));
-    if (trs->localBuffer == NULL) {
-      tscError("%p failed to malloc buffer for local buffer, orderOfSub:%d, reason:%s", pSql, i, strerror(errno));
-      tfree(trs);
-      break;
-    }
-    
     trs->subqueryIndex = i;
     trs->pParentSqlObj = pSql;
     trs->pFinalColModel = pModel;
@@ -1275,7 +1271,6 @@ int32_t tscHandleMasterSTableQuery(SSqlObj *pSql) {
     SSqlObj *pNew = tscCreateSqlObjForSubquery(pSql, trs, NULL);
     if (pNew == NULL) {
       tscError("%p failed to malloc buffer for subObj, orderOfSub:%d, reason:%s", pSql, i, strerror(errno));
-      tfree(trs->localBuffer);
       tfree(trs);
       break;
     }
@@ -1304,17 +1299,72 @@ int32_t tscHandleMasterSTableQuery(SSqlObj *pSql) {
     return pRes->code;
   }
   
-  for(int32_t j = 0; j < pSql->numOfSubs; ++j) {
-    SSqlObj* pSub = pSql->pSubs[j];
-    SRetrieveSupport* pSupport = pSub->param;
-    
-    tscTrace("%p sub:%p launch subquery, orderOfSub:%d.", pSql, pSub, pSupport->subqueryIndex);
-    tscProcessSql(pSub);
+  // the others are queued, and launched one by one once any launched subquery completes
+  int32_t numOfLaunch = pSql->numOfSubs;
+  if (tsMaxConcurrentSubqueries > 0 && numOfLaunch > tsMaxConcurrentSubqueries) {
+    numOfLaunch = tsMaxConcurrentSubqueries;
+    tscTrace("%p %d subqueries are launched, %d queued", pSql, numOfLaunch, pSql->numOfSubs - numOfLaunch);
+  }
+  
+  pState->numOfLaunched = numOfLaunch;
+  for(int32_t j = 0; j < numOfLaunch; ++j) {
+    tscLaunchSubquery(pSql, j);
   }
   
   return TSDB_CODE_SUCCESS;
 }
 
+static void tscLaunchSubquery(SSqlObj *pSql, int32_t index) {
+  SSqlObj*          pSub = pSql->pSubs[index];
+  SRetrieveSupport* pSupport = pSub->param;
+  
+  pSupport->localBuffer = (tFilePage *)calloc(1, TSC_SUBQUERY_BUFFER_SIZE + sizeof(tFilePage));
+  if (pSupport->localBuffer == NULL) {
+    tscError("%p sub:%p failed to malloc buffer for local buffer, orderOfSub:%d, reason:%s", pSql, pSub, index,
+             strerror(errno));
+    
+    atomic_val_compare_exchange_32(&pSupport->pState->code, TSDB_CODE_SUCCESS, TSDB_CODE_CLI_OUT_OF_MEMORY);
+    tscRetrieveDataRes(pSupport, pSub, TSDB_CODE_CLI_OUT_OF_MEMORY);
+    return;
+  }
+  
+  tscTrace("%p sub:%p launch subquery, orderOfSub:%d.", pSql, pSub, pSupport->subqueryIndex);
+  tscProcessSql(pSub);
+}
+
+/*
+ * Launch the next queued subquery when a subquery completes. It must be called before the completed subquery is counted
+ * in pState->numOfCompleted, otherwise pState may be released by the other subqueries during the call.
+ *
+ * If the query has been cancelled or failed, all the queued subqueries are released without being sent to vnodes.
+ */
+static void tscLaunchNextSubquery(SSqlObj *pSql, SSubqueryState *pState) {
+  int32_t numOfTotal = pState->numOfTotal;
+  if (atomic_load_32(&pState->numOfLaunched) >= numOfTotal) {
+    return;
+  }
+  
+  if (pState->code == TSDB_CODE_SUCCESS && pSql->res.code == TSDB_CODE_SUCCESS) {
+    int32_t next = atomic_fetch_add_32(&pState->numOfLaunched, 1);
+    if (next < numOfTotal) {
+      tscLaunchSubquery(pSql, next);
+    }
+    
+    return;
+  }
+  
+  // take all the queued ones at once, so that they are not released recursively
+  int32_t first = atomic_fetch_add_32(&pState->numOfLaunched, numOfTotal);
+  if (first < numOfTotal) {
+    tscTrace("%p query cancelled or failed, %d queued subqueries are released", pSql, numOfTotal - first);
+  }
+  
+  for (int32_t i = first; i < numOfTotal; ++i) {
+    SSqlObj *pSub = pSql->pSubs[i];
+    tscRetrieveDataRes(pSub->param, pSub, TSDB_CODE_QUERY_CANCELLED);
+  }
+}
+
 static void tscFreeSubSqlObj(SRetrieveSupport *trsupport, SSqlObj *pSql) {
   tscTrace("%p start to free subquery result", pSql);
   
@@ -1346,7 +1396,7 @@ static void tscAbortFurtherRetryRetrieval(SRetrieveSupport *trsupport, TAOS_RES
   tscError("sub:%p failed to flush data to disk:reason:%s", tres, strerror(errno));
 #endif
   
-  trsupport->pState->code = -errCode;
+  trsupport->pState->code = errCode;
   trsupport->numOfRetry = MAX_NUM_OF_SUBQUERY_RETRY;
   
   pthread_mutex_unlock(&trsupport->queryMutex);
@@ -1415,6 +1465,8 @@ void tscHandleSubqueryError(SRetrieveSupport *trsupport, SSqlObj *pSql, int numO
     }
   }
   
+  tscLaunchNextSubquery(pPObj, pState);
+  
   int32_t numOfTotal = pState->numOfTotal;
   
   int32_t finished = atomic_add_fetch_32(&pState->numOfCompleted, 1);
@@ -1487,6 +1539,8 @@ static void tscAllDataRetrievedFromDnode(SRetrieveSupport *trsupport, SSqlObj* p
     return tscAbortFurtherRetryRetrieval(trsupport, pSql, TSDB_CODE_CLI_NO_DISKSPACE);
   }
   
+  tscLaunchNextSubquery(pPObj, pState);
+  
   // keep this value local variable, since the pState variable may be released by other threads, if atomic_add opertion
   // increases the finished value up to pState->numOfTotal value, which means all subqueries are completed.
   // In this case, the comparsion between finished value and released pState->numOfTotal is not safe.
@@ -1783,6 +1837,11 @@ int32_t tscHandleMultivnodeInsert(SSqlObj *pSql) {
                pDataBlocks->nSize, code);
     }
     
+    if (code == TSDB_CODE_SUCCESS && tscPutIntoWriteBuffer(pSub)) {
+      tscTrace("%p sub:%p put into write buffer, orderOfSub:%d", pSql, pSub, j);
+      continue;
+    }
+
     tscTrace("%p sub:%p launch sub insert, orderOfSub:%d", pSql, pSub, j);
     tscProcessSql(pSub);
   }
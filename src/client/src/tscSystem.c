@@ -23,7 +23,9 @@
 #include "tutil.h"
 #include "tsched.h"
 #include "tscLog.h"
+#include "tscSqlCache.h"
 #include "tscUtil.h"
+#include "tscWriteBuffer.h"
 #include "tsclient.h"
 #include "tglobal.h"
 #include "tconfig.h"
@@ -150,12 +152,18 @@ void taos_init_imp() {
     tscCacheHandle = taosCacheInit(tscTmr, refreshTime);
   }
 
+  tscInitSqlCache();
+  tscInitWriteBuffer();
+
   tscTrace("client is initialized successfully");
 }
 
 void taos_init() { pthread_once(&tscinit, taos_init_imp); }
 
 void taos_cleanup() {
+  tscCleanupWriteBuffer();
+  tscCleanupSqlCache();
+
   if (tscCacheHandle != NULL) {
     taosCacheCleanup(tscCacheHandle);
   }
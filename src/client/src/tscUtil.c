@@ -1478,7 +1478,8 @@ bool tscShouldBeFreed(SSqlObj* pSql) {
   }
 
   STscObj* pTscObj = pSql->pTscObj;
-  if (pSql->pStream != NULL || pTscObj->pHb == pSql || pTscObj->pSql == pSql || pSql->pSubscription != NULL) {
+  if (pSql->pStream != NULL || pTscObj->pHb == pSql || pTscObj->pSql == pSql || pSql->pSubscription != NULL ||
+      pSql->pStmt != NULL) {
     return false;
   }
 
@@ -1619,6 +1620,83 @@ static void freeQueryInfoImpl(SQueryInfo* pQueryInfo) {
   tfree(pQueryInfo->fillVal);
 }
 
+/*
+ * Deep copy the query info of a single table query, except the table meta info and the pointer to the message
+ * buffer, which belong to the sql object of dst.
+ */
+void tscQueryInfoCopy(SQueryInfo* dst, const SQueryInfo* src) {
+  dst->command = src->command;
+  dst->type = src->type;
+  dst->slidingTimeUnit = src->slidingTimeUnit;
+  dst->window = src->window;
+  dst->intervalTime = src->intervalTime;
+  dst->slidingTime = src->slidingTime;
+  dst->windowType = src->windowType;
+  dst->sessionGap = src->sessionGap;
+  dst->stateColId = src->stateColId;
+  dst->limit = src->limit;
+  dst->slimit = src->slimit;
+  dst->order = src->order;
+  dst->fillType = src->fillType;
+  dst->clauseLimit = src->clauseLimit;
+  dst->prjOffset = src->prjOffset;
+
+  dst->groupbyExpr = src->groupbyExpr;
+  if (src->groupbyExpr.columnInfo != NULL) {
+    dst->groupbyExpr.columnInfo = taosArrayClone(src->groupbyExpr.columnInfo);
+  }
+
+  tscTagCondCopy(&dst->tagCond, &src->tagCond);
+  tscColumnListCopy(dst->colList, src->colList, -1);
+
+  size_t numOfExprs = taosArrayGetSize(src->exprList);
+  for (int32_t i = 0; i < numOfExprs; ++i) {
+    SSqlExpr* pExpr = taosArrayGetP(src->exprList, i);
+    SSqlExpr* p1 = calloc(1, sizeof(SSqlExpr));
+    *p1 = *pExpr;
+
+    for (int32_t j = 0; j < pExpr->numOfParams; ++j) {
+      tVariantAssign(&p1->param[j], &pExpr->param[j]);
+    }
+
+    taosArrayPush(dst->exprList, &p1);
+  }
+
+  // the fields refer to the sql expressions of dst by the same index
+  tscFieldInfoCopy(&dst->fieldsInfo, &src->fieldsInfo);
+  for (int32_t i = 0; i < dst->fieldsInfo.numOfOutput; ++i) {
+    SFieldSupInfo* pInfo = tscFieldInfoGetSupp(&dst->fieldsInfo, i);
+    if (pInfo->pSqlExpr == NULL) {
+      continue;
+    }
+
+    SSqlExpr* pExpr = pInfo->pSqlExpr;
+    pInfo->pSqlExpr = NULL;
+
+    for (int32_t j = 0; j < numOfExprs; ++j) {
+      if (taosArrayGetP(src->exprList, j) == pExpr) {
+        pInfo->pSqlExpr = taosArrayGetP(dst->exprList, j);
+        break;
+      }
+    }
+  }
+
+  if (src->fillVal != NULL) {
+    dst->fillVal = malloc(src->fieldsInfo.numOfOutput * sizeof(int64_t));
+    memcpy(dst->fillVal, src->fillVal, src->fieldsInfo.numOfOutput * sizeof(int64_t));
+  }
+}
+
+void tscQueryInfoDestroy(SQueryInfo* pQueryInfo) {
+  if (pQueryInfo == NULL) {
+    return;
+  }
+
+  freeQueryInfoImpl(pQueryInfo);
+  clearAllTableMetaInfo(pQueryInfo, (const char*)pQueryInfo, false);
+  free(pQueryInfo);
+}
+
 void tscClearSubqueryInfo(SSqlCmd* pCmd) {
   for (int32_t i = 0; i < pCmd->numOfClause; ++i) {
     SQueryInfo* pQueryInfo = tscGetQueryInfoDetail(pCmd, i);
@@ -1761,6 +1839,9 @@ SSqlObj* createSubqueryObj(SSqlObj* pSql, int16_t tableIndex, void (*fp)(), void
   pNewQueryInfo->slidingTimeUnit = pQueryInfo->slidingTimeUnit;
   pNewQueryInfo->intervalTime = pQueryInfo->intervalTime;
   pNewQueryInfo->slidingTime  = pQueryInfo->slidingTime;
+  pNewQueryInfo->windowType   = pQueryInfo->windowType;
+  pNewQueryInfo->sessionGap   = pQueryInfo->sessionGap;
+  pNewQueryInfo->stateColId   = pQueryInfo->stateColId;
   pNewQueryInfo->type   = pQueryInfo->type;
   pNewQueryInfo->window = pQueryInfo->window;
   pNewQueryInfo->limit  = pQueryInfo->limit;
@@ -2020,6 +2101,31 @@ bool hasMoreVnodesToTry(SSqlObj* pSql) {
          (!tscHasReachLimitation(pQueryInfo, pRes)) && (pTableMetaInfo->vgroupIndex < numOfVgroups - 1);
 }
 
+/**
+ *  The vnode returns no query handle if none of its tables is qualified for the tag condition. For the multi-vnode
+ *  super table projection query, the vnode is exhausted then, and the query goes on with the next vnode if exists.
+ */
+bool tscSetVnodeExhausted(SSqlObj* pSql) {
+  SSqlCmd* pCmd = &pSql->cmd;
+  SSqlRes* pRes = &pSql->res;
+  if (pRes->qhandle != 0 || pRes->code != TSDB_CODE_SUCCESS ||
+      (pCmd->command != TSDB_SQL_SELECT && pCmd->command != TSDB_SQL_FETCH)) {
+    return false;
+  }
+
+  SQueryInfo*     pQueryInfo = tscGetQueryInfoDetail(pCmd, pCmd->clauseIndex);
+  STableMetaInfo* pTableMetaInfo = tscGetMetaInfo(pQueryInfo, 0);
+  if (pTableMetaInfo == NULL || pTableMetaInfo->vgroupList == NULL || QUERY_IS_JOIN_QUERY(pQueryInfo->type) ||
+      !tscNonOrderedProjectionQueryOnSTable(pQueryInfo, 0)) {
+    return false;
+  }
+
+  pCmd->command = TSDB_SQL_FETCH;
+  pRes->completed = true;
+  pRes->numOfRows = 0;
+  return true;
+}
+
 void tscTryQueryNextVnode(SSqlObj* pSql, __async_cb_func_t fp) {
   SSqlCmd* pCmd = &pSql->cmd;
   SSqlRes* pRes = &pSql->res;
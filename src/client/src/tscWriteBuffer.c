@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "os.h"
+#include "hash.h"
+#include "tglobal.h"
+#include "tscLog.h"
+#include "tscUtil.h"
+#include "tscWriteBuffer.h"
+#include "tsclient.h"
+#include "ttime.h"
+#include "tutil.h"
+
+typedef struct SWriteWaiter {
+  SSqlObj *pSql;
+  int32_t  numOfRows;
+} SWriteWaiter;
+
+struct SWriteSlot;
+
+// the inserts to be sent in one submit message, their submit blocks are kept in their own payload
+typedef struct SWriteBatch {
+  struct SWriteSlot * pSlot;
+  struct SWriteBatch *next;
+  int32_t             size;  // total size of the submit blocks
+  int32_t             numOfBlocks;
+  int64_t             stime;     // time in ms when the first insert is put into the batch
+  SArray *            pWaiters;  // SWriteWaiter
+} SWriteBatch;
+
+/*
+ * The inserts of a user to a vgroup. Only one submit message is in flight, since the messages sent at the same time
+ * may be written in any order, the batches behind it are sent one by one in the order of their inserts.
+ */
+typedef struct SWriteSlot {
+  bool         inflight;  // a submit message is being sent
+  SWriteBatch *pHead;     // the batches waiting for the message in flight, the inserts are put into the last one
+  SWriteBatch *pTail;
+} SWriteSlot;
+
+typedef struct SWriteBuffer {
+  pthread_mutex_t mutex;
+  SHashObj *      pSlots;  // key: user and vgId, value: SWriteSlot*
+} SWriteBuffer;
+
+static SWriteBuffer *tscWriteBuffer = NULL;
+
+static void tscFreeWriteBatch(SWriteBatch *pBatch) {
+  taosArrayDestroy(pBatch->pWaiters);
+  free(pBatch);
+}
+
+void tscInitWriteBuffer() {
+  if (tsWriteBuffer == 0 || tscWriteBuffer != NULL) {
+    return;
+  }
+
+  SWriteBuffer *pBuffer = calloc(1, sizeof(SWriteBuffer));
+  if (pBuffer == NULL) {
+    tscError("failed to init the write buffer");
+    return;
+  }
+
+  pBuffer->pSlots = taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false);
+  if (pBuffer->pSlots == NULL) {
+    tscError("failed to init the write buffer");
+    free(pBuffer);
+    return;
+  }
+
+  pthread_mutex_init(&pBuffer->mutex, NULL);
+  tscWriteBuffer = pBuffer;
+
+  tscTrace("write buffer is initialized, size:%d", tsWriteBufferSize);
+}
+
+void tscCleanupWriteBuffer() {
+  SWriteBuffer *pBuffer = tscWriteBuffer;
+  if (pBuffer == NULL) {
+    return;
+  }
+
+  tscWriteBuffer = NULL;
+
+  pthread_mutex_lock(&pBuffer->mutex);
+
+  SHashMutableIterator *pIter = taosHashCreateIter(pBuffer->pSlots);
+  while (taosHashIterNext(pIter)) {
+    SWriteSlot *pSlot = *(SWriteSlot **)taosHashIterGet(pIter);
+    while (pSlot->pHead != NULL) {
+      SWriteBatch *pBatch = pSlot->pHead;
+      pSlot->pHead = pBatch->next;
+      tscFreeWriteBatch(pBatch);
+    }
+
+    free(pSlot);
+  }
+
+  taosHashDestroyIter(pIter);
+  taosHashCleanup(pBuffer->pSlots);
+
+  pthread_mutex_unlock(&pBuffer->mutex);
+  pthread_mutex_destroy(&pBuffer->mutex);
+  free(pBuffer);
+}
+
+static int32_t tscGetNumOfRowsInSubmit(const char *pBlocks, int32_t numOfBlocks) {
+  int32_t numOfRows = 0;
+
+  for (int32_t i = 0; i < numOfBlocks; ++i) {
+    const SSubmitBlk *pBlk = (const SSubmitBlk *)pBlocks;
+
+    numOfRows += (int16_t)htons(pBlk->numOfRows);
+    pBlocks += sizeof(SSubmitBlk) + htonl(pBlk->len);
+  }
+
+  return numOfRows;
+}
+
+static SWriteBatch *tscNewWriteBatch(SWriteSlot *pSlot) {
+  SWriteBatch *pBatch = calloc(1, sizeof(SWriteBatch));
+  if (pBatch == NULL) {
+    return NULL;
+  }
+
+  pBatch->pWaiters = taosArrayInit(4, sizeof(SWriteWaiter));
+  if (pBatch->pWaiters == NULL) {
+    free(pBatch);
+    return NULL;
+  }
+
+  pBatch->pSlot = pSlot;
+  pBatch->stime = taosGetTimestampMs();
+  return pBatch;
+}
+
+// take the first batch out of the slot to be sent, if no message is in flight. The caller must hold the mutex
+static SWriteBatch *tscTakeWriteBatch(SWriteSlot *pSlot) {
+  SWriteBatch *pBatch = pSlot->pHead;
+  if (pSlot->inflight || pBatch == NULL) {
+    return NULL;
+  }
+
+  pSlot->pHead = pBatch->next;
+  if (pSlot->pHead == NULL) {
+    pSlot->pTail = NULL;
+  }
+
+  pBatch->next = NULL;
+  pSlot->inflight = true;
+  return pBatch;
+}
+
+static void tscSendWriteBatch(SWriteBatch *pBatch);
+
+// the submit message in flight is written or failed, the next batch is sent
+static void tscReleaseWriteSlot(SWriteSlot *pSlot) {
+  SWriteBuffer *pBuffer = tscWriteBuffer;
+  if (pBuffer == NULL) {  // the buffer has been cleaned up
+    return;
+  }
+
+  pthread_mutex_lock(&pBuffer->mutex);
+  pSlot->inflight = false;
+  SWriteBatch *pNext = tscTakeWriteBatch(pSlot);
+  pthread_mutex_unlock(&pBuffer->mutex);
+
+  if (pNext != NULL) {
+    tscSendWriteBatch(pNext);
+  }
+}
+
+/*
+ * The coalesced submit message fails, its inserts are sent one by one ahead of the other batches, so that the error of
+ * each insert is reported to its own caller, and they are still written in order.
+ */
+static void tscSplitWriteBatch(SWriteBatch *pBatch) {
+  SWriteBuffer *pBuffer = tscWriteBuffer;
+  SWriteSlot *  pSlot = pBatch->pSlot;
+  size_t        numOfWaiters = taosArrayGetSize(pBatch->pWaiters);
+
+  if (pBuffer != NULL) {
+    pthread_mutex_lock(&pBuffer->mutex);
+
+    for (int32_t i = (int32_t)numOfWaiters - 1; i >= 0; --i) {
+      SWriteWaiter *pWaiter = taosArrayGet(pBatch->pWaiters, i);
+      SWriteBatch * pSingle = tscNewWriteBatch(pSlot);
+      if (pSingle == NULL) {
+        break;
+      }
+
+      SSqlCmd *pCmd = &pWaiter->pSql->cmd;
+      taosArrayPush(pSingle->pWaiters, pWaiter);
+      pSingle->size = pCmd->payloadLen + tsRpcHeadSize - tsInsertHeadSize;
+      pSingle->numOfBlocks = pCmd->numOfTablesInSubmit;
+
+      pSingle->next = pSlot->pHead;
+      pSlot->pHead = pSingle;
+      if (pSlot->pTail == NULL) {
+        pSlot->pTail = pSingle;
+      }
+
+      taosArrayRemove(pBatch->pWaiters, i);
+    }
+
+    pthread_mutex_unlock(&pBuffer->mutex);
+  }
+
+  // the ones failed to be put back are sent by themselves
+  numOfWaiters = taosArrayGetSize(pBatch->pWaiters);
+  for (int32_t i = 0; i < numOfWaiters; ++i) {
+    tscProcessSql(((SWriteWaiter *)taosArrayGet(pBatch->pWaiters, i))->pSql);
+  }
+
+  tscReleaseWriteSlot(pSlot);
+  tscFreeWriteBatch(pBatch);
+}
+
+static void tscWriteBatchCallback(void *param, TAOS_RES *tres, int code) {
+  SWriteBatch *pBatch = param;
+  size_t       numOfWaiters = taosArrayGetSize(pBatch->pWaiters);
+
+  if (code < 0 && numOfWaiters > 1) {
+    tscWarn("%p coalesced submit of %d inserts failed, code:%s, send them one by one", tres, (int32_t)numOfWaiters,
+            tstrerror(code));
+    tscSplitWriteBatch(pBatch);
+    return;
+  }
+
+  // the insert is sent by its own object, which renews the meta of the table if necessary, and reports the error
+  if (code < 0) {
+    SWriteSlot *pSlot = pBatch->pSlot;
+    tscProcessSql(((SWriteWaiter *)taosArrayGet(pBatch->pWaiters, 0))->pSql);
+    tscReleaseWriteSlot(pSlot);
+    tscFreeWriteBatch(pBatch);
+    return;
+  }
+
+  // the affected rows are reported to the inserts in order, in case some of the rows are not written
+  int32_t affectedRows = code;
+
+  for (int32_t i = 0; i < numOfWaiters; ++i) {
+    SWriteWaiter *pWaiter = taosArrayGet(pBatch->pWaiters, i);
+    SSqlObj *     pSql = pWaiter->pSql;
+
+    int32_t numOfRows = MIN(pWaiter->numOfRows, affectedRows);
+    affectedRows -= numOfRows;
+
+    pSql->res.code = TSDB_CODE_SUCCESS;
+    pSql->res.numOfRows = numOfRows;
+
+    bool shouldFree = tscShouldBeFreed(pSql);
+    (*pSql->fp)(pSql->param, pSql, numOfRows);
+
+    if (shouldFree) {
+      tscFreeSqlObj(pSql);
+    }
+  }
+
+  tscReleaseWriteSlot(pBatch->pSlot);
+  tscFreeWriteBatch(pBatch);
+}
+
+static void tscSendWriteBatch(SWriteBatch *pBatch) {
+  size_t        numOfWaiters = taosArrayGetSize(pBatch->pWaiters);
+  SWriteWaiter *pFirst = taosArrayGet(pBatch->pWaiters, 0);
+
+  // the submit message is sent by a new object, so that the slot is released once it is written
+  SSqlObj *pNew = createSubqueryObj(pFirst->pSql, 0, tscWriteBatchCallback, pBatch, TSDB_SQL_INSERT, NULL);
+  if (pNew == NULL) {
+    tscWriteBatchCallback(pBatch, NULL, TSDB_CODE_CLI_OUT_OF_MEMORY);
+    return;
+  }
+
+  // in case of the error in sending the message, which is reported by tscProcessAsyncRes
+  pNew->fetchFp = pNew->fp;
+
+  SSqlCmd *pCmd = &pNew->cmd;
+  if (tscAllocPayload(pCmd, tsInsertHeadSize + pBatch->size + 100) != TSDB_CODE_SUCCESS) {
+    tscFreeSqlObj(pNew);
+    tscWriteBatchCallback(pBatch, NULL, TSDB_CODE_CLI_OUT_OF_MEMORY);
+    return;
+  }
+
+  char *p = pCmd->payload + tsInsertHeadSize;
+  for (int32_t i = 0; i < numOfWaiters; ++i) {
+    SSqlCmd *pWaiterCmd = &((SWriteWaiter *)taosArrayGet(pBatch->pWaiters, i))->pSql->cmd;
+    int32_t  len = pWaiterCmd->payloadLen + tsRpcHeadSize - tsInsertHeadSize;
+
+    memcpy(p, pWaiterCmd->payload + tsInsertHeadSize, len);
+    p += len;
+  }
+
+  pCmd->payloadLen = tsInsertHeadSize + pBatch->size - tsRpcHeadSize;
+  pCmd->numOfTablesInSubmit = pBatch->numOfBlocks;
+
+  tscTrace("%p coalesced submit of %d inserts, blocks:%d size:%d, waited:%" PRId64 "ms", pNew, (int32_t)numOfWaiters,
+           pBatch->numOfBlocks, pBatch->size, taosGetTimestampMs() - pBatch->stime);
+  tscProcessSql(pNew);
+}
+
+bool tscPutIntoWriteBuffer(SSqlObj *pSql) {
+  SWriteBuffer *pBuffer = tscWriteBuffer;
+  if (pBuffer == NULL) {
+    return false;
+  }
+
+  SSqlCmd *pCmd = &pSql->cmd;
+  int32_t  len = pCmd->payloadLen + tsRpcHeadSize - tsInsertHeadSize;
+
+  STableMetaInfo *pTableMetaInfo = tscGetTableMetaInfoFromCmd(pCmd, pCmd->clauseIndex, 0);
+
+  char    key[TSDB_USER_LEN + 16];
+  int32_t keyLen = snprintf(key, tListLen(key), "%s.%d", pSql->pTscObj->user,
+                            pTableMetaInfo->pTableMeta->vgroupInfo.vgId);
+
+  SWriteWaiter waiter = {.pSql = pSql};
+  waiter.numOfRows = tscGetNumOfRowsInSubmit(pCmd->payload + tsInsertHeadSize, pCmd->numOfTablesInSubmit);
+
+  pthread_mutex_lock(&pBuffer->mutex);
+
+  SWriteSlot *pSlot = NULL;
+
+  SWriteSlot **ppSlot = taosHashGet(pBuffer->pSlots, key, keyLen);
+  if (ppSlot != NULL) {
+    pSlot = *ppSlot;
+  } else {
+    pSlot = calloc(1, sizeof(SWriteSlot));
+    if (pSlot == NULL || taosHashPut(pBuffer->pSlots, key, keyLen, &pSlot, POINTER_BYTES) != 0) {
+      pthread_mutex_unlock(&pBuffer->mutex);
+      tfree(pSlot);
+      return false;
+    }
+  }
+
+  // an insert larger than tsWriteBufferSize is sent in a message by itself, but still in order
+  SWriteBatch *pBatch = pSlot->pTail;
+  if (pBatch == NULL || pBatch->size + len > tsWriteBufferSize) {
+    pBatch = tscNewWriteBatch(pSlot);
+    if (pBatch == NULL) {
+      pthread_mutex_unlock(&pBuffer->mutex);
+      return false;
+    }
+
+    if (pSlot->pTail != NULL) {
+      pSlot->pTail->next = pBatch;
+    } else {
+      pSlot->pHead = pBatch;
+    }
+    pSlot->pTail = pBatch;
+  }
+
+  taosArrayPush(pBatch->pWaiters, &waiter);
+  pBatch->size += len;
+  pBatch->numOfBlocks += pCmd->numOfTablesInSubmit;
+
+  // the insert waits only if a submit message to the vgroup is in flight
+  SWriteBatch *pReady = tscTakeWriteBatch(pSlot);
+
+  pthread_mutex_unlock(&pBuffer->mutex);
+
+  if (pReady != NULL) {
+    tscSendWriteBatch(pReady);
+  }
+
+  return true;
+}
@@ -214,8 +214,10 @@ SDataCols *tdDupDataCols(SDataCols *pCols, bool keepData);
 void       tdFreeDataCols(SDataCols *pCols);
 void       tdAppendDataRowToDataCol(SDataRow row, SDataCols *pCols);
 void       tdPopDataColsPoints(SDataCols *pCols, int pointsToPop); //!!!!
-int        tdMergeDataCols(SDataCols *target, SDataCols *src, int rowsToMerge);
-void       tdMergeTwoDataCols(SDataCols *target, SDataCols *src1, int *iter1, SDataCols *src2, int *iter2, int tRows);
+// For the rows with the same key, the one from src wins if update is true, otherwise the one in target is kept
+int        tdMergeDataCols(SDataCols *target, SDataCols *src, int rowsToMerge, bool update);
+void       tdMergeTwoDataCols(SDataCols *target, SDataCols *src1, int *iter1, SDataCols *src2, int *iter2, int tRows,
+                              bool update);
 
 #ifdef __cplusplus
 }
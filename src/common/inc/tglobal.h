@@ -64,9 +64,13 @@ extern int32_t tsShellActivityTimer;
 extern int32_t tsVnodePeerHBTimer;
 extern int32_t tsMgmtPeerHBTimer;
 extern int32_t tsTableMetaKeepTimer;
+extern int32_t tsQueryCacheKeepTimer;
+extern int32_t tsQueryCacheSize;
+extern int32_t tsSqlCacheKeepTimer;
 
 extern float    tsNumOfThreadsPerCore;
 extern float    tsRatioOfQueryThreads;
+extern int32_t  tsNumOfMnodeReadThreads;
 extern char     tsPublicIp[];
 extern char     tsPrivateIp[];
 extern int16_t  tsNumOfVnodesPerCore;
@@ -83,8 +87,15 @@ extern int32_t tsMaxRowsInFileBlock;
 extern int16_t tsCommitTime;  // seconds
 extern int32_t tsTimePrecision;
 extern int16_t tsCompression;
+extern int32_t tsZstdLevel;
+extern float   tsBloomFilterFpp;
+extern int16_t tsCodecPolicy;
+extern char    tsRollupInterval[];
+extern int16_t tsSubBlocksToMerge;
+extern int32_t tsSharedScanBlocks;
 extern int16_t tsWAL;
 extern int32_t tsReplications;
+extern int16_t tsUpdate;
 
 extern int16_t tsAffectedRowsMod;
 extern int32_t tsNumOfMPeers;
@@ -110,6 +121,9 @@ extern int32_t tsRestRowLimit;
 extern int32_t tsMaxSQLStringLen;
 extern int32_t tsCompressMsgSize;
 extern int32_t tsMaxNumOfOrderedResults;
+extern int32_t tsMaxConcurrentSubqueries;
+extern int32_t tsWriteBuffer;
+extern int32_t tsWriteBufferSize;
 
 extern char tsSocketType[4];
 
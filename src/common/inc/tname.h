@@ -14,6 +14,17 @@ typedef struct SDataStatis {
   int16_t numOfNull;
 } SDataStatis;
 
+// pre-aggregated statistics of the time windows of a data block, the statistics of the numOfCols columns of window i
+// start from statis[i * numOfCols]
+typedef struct SDataRollup {
+  int64_t      interval;
+  int32_t      numOfWindows;
+  int32_t      numOfCols;
+  TSKEY       *skey;
+  int32_t     *numOfRows;
+  SDataStatis *statis;
+} SDataRollup;
+
 typedef struct SColumnInfoData {
   SColumnInfo info;
   void* pData;    // the corresponding block data in memory
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TDENGINE_TTAGBLOOM_H
+#define TDENGINE_TTAGBLOOM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "os.h"
+#include "taosmsg.h"
+
+/*
+ * Hash of the tag values summarized in the bloom filters of the vgroups of super tables, it is calculated by mnode for
+ * the tags of the created child tables, and by client for the values in the tag conditions of queries.
+ *
+ * Only the types whose values are equal if and only if their bytes are equal are summarized. The values of float and
+ * double are not, so as timestamp and nchar, since the value in condition is converted according to the timezone and
+ * the charset of the vnode.
+ */
+bool tTagValueHashable(int8_t type);
+
+/**
+ * @param colId
+ * @param type
+ * @param val    the value in the layout of tag data, i.e., a var string for binary
+ */
+uint32_t tTagValueHash(int16_t colId, int8_t type, const char *val);
+
+/**
+ * @return true if any bit of the filter is changed
+ */
+bool tTagBloomAdd(uint8_t *bloom, uint32_t hash);
+
+bool tTagBloomTest(const uint8_t *bloom, uint32_t hash);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // TDENGINE_TTAGBLOOM_H
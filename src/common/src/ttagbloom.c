@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "os.h"
+#include "taosdef.h"
+#include "hashfunc.h"
+#include "tutil.h"
+#include "ttagbloom.h"
+
+#define TAG_BLOOM_BITS   (TSDB_TAG_BLOOM_SIZE * 8)
+#define TAG_BLOOM_HASHES 3
+
+bool tTagValueHashable(int8_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_BINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+uint32_t tTagValueHash(int16_t colId, int8_t type, const char *val) {
+  uint32_t hash = 0;
+
+  if (type == TSDB_DATA_TYPE_BINARY) {
+    // binary values are compared by strncmp, the bytes after '\0' do not make a difference
+    int32_t len = varDataLen(val);
+    hash = MurmurHash3_32(varDataVal(val), strnlen(varDataVal(val), len)) ^ ((uint32_t)len * 0x85EBCA6Bu);
+  } else {
+    hash = MurmurHash3_32(val, tDataTypeDesc[type].nSize);
+  }
+
+  return hash ^ ((uint32_t)colId * 0x9E3779B1u);
+}
+
+// the positions of the bits are derived from the hash by double hashing
+static FORCE_INLINE uint32_t tagBloomBit(uint32_t hash, int32_t i) {
+  uint32_t h2 = (hash >> 17) | (hash << 15);
+  return (hash + i * h2) % TAG_BLOOM_BITS;
+}
+
+bool tTagBloomAdd(uint8_t *bloom, uint32_t hash) {
+  bool changed = false;
+
+  for (int32_t i = 0; i < TAG_BLOOM_HASHES; ++i) {
+    uint32_t bit = tagBloomBit(hash, i);
+    uint8_t  mask = (uint8_t)(1u << (bit & 7));
+
+    if ((bloom[bit >> 3] & mask) == 0) {
+      bloom[bit >> 3] |= mask;
+      changed = true;
+    }
+  }
+
+  return changed;
+}
+
+bool tTagBloomTest(const uint8_t *bloom, uint32_t hash) {
+  for (int32_t i = 0; i < TAG_BLOOM_HASHES; ++i) {
+    uint32_t bit = tagBloomBit(hash, i);
+    if ((bloom[bit >> 3] & (1u << (bit & 7))) == 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
@@ -17,6 +17,7 @@
 #include "taosdef.h"
 #include "ttokendef.h"
 #include "tscompression.h"
+#include "hashfunc.h"
 
 const int32_t TYPE_BYTES[11] = {
     -1,                      // TSDB_DATA_TYPE_NULL
@@ -273,44 +274,128 @@ static void getStatics_d(const TSKEY *primaryKey, const void *pData, int32_t num
 #endif
 }
 
-static void getStatics_bin(const TSKEY *primaryKey, const void *pData, int32_t numOfRow, int64_t *min, int64_t *max,
-                         int64_t *sum, int16_t *minIndex, int16_t *maxIndex, int16_t *numOfNull) {
-  const char* data = pData;
-  ASSERT(numOfRow <= INT16_MAX);
-  
-  for (int32_t i = 0; i < numOfRow; ++i) {
-    if (isNull((const char*) varDataVal(data), TSDB_DATA_TYPE_BINARY)) {
-      (*numOfNull) += 1;
+#define VARSTR_DISTINCT_BITS 1024
+
+/*
+ * Binary values are ordered by their bytes, and nchar values by their code points. The prefix of nchar value is kept
+ * in big endian, so that the prefixes of both types are ordered in the same way as the values by using memcmp.
+ */
+static int32_t compareVarData(const char *val1, int32_t len1, const char *val2, int32_t len2, int32_t type) {
+  if (type == TSDB_DATA_TYPE_NCHAR) {
+    int32_t n = MIN(len1, len2) / TSDB_NCHAR_SIZE;
+    for (int32_t i = 0; i < n; ++i) {
+      uint32_t c1 = 0, c2 = 0;
+      memcpy(&c1, val1 + i * TSDB_NCHAR_SIZE, TSDB_NCHAR_SIZE);
+      memcpy(&c2, val2 + i * TSDB_NCHAR_SIZE, TSDB_NCHAR_SIZE);
+      if (c1 != c2) {
+        return (c1 < c2) ? -1 : 1;
+      }
+    }
+  } else {
+    int32_t ret = memcmp(val1, val2, MIN(len1, len2));
+    if (ret != 0) {
+      return ret;
     }
-    
-    data += varDataLen(data);
   }
-  
-  *sum = 0;
-  *max = 0;
-  *min = 0;
-  *minIndex = 0;
-  *maxIndex = 0;
+
+  return (len1 == len2) ? 0 : ((len1 < len2) ? -1 : 1);
 }
 
-static void getStatics_nchr(const TSKEY *primaryKey, const void *pData, int32_t numOfRow, int64_t *min, int64_t *max,
-                           int64_t *sum, int16_t *minIndex, int16_t *maxIndex, int16_t *numOfNull) {
-  const char* data = pData;
-  ASSERT(numOfRow <= INT16_MAX);
-  
-  for (int32_t i = 0; i < numOfRow; ++i) {
-    if (isNull((const char*) varDataVal(data), TSDB_DATA_TYPE_NCHAR)) {
-      (*numOfNull) += 1;
+int32_t tGetVarDataPrefix(const char *val, int32_t len, int32_t type, char *prefix) {
+  memset(prefix, 0, VARSTR_PREFIX_BYTES);
+
+  if (type == TSDB_DATA_TYPE_NCHAR) {
+    int32_t n = MIN(len, (int32_t)VARSTR_PREFIX_BYTES) / TSDB_NCHAR_SIZE;
+    for (int32_t i = 0; i < n; ++i) {
+      uint32_t c = 0;
+      memcpy(&c, val + i * TSDB_NCHAR_SIZE, TSDB_NCHAR_SIZE);
+
+      prefix[i * TSDB_NCHAR_SIZE]     = (char)(c >> 24);
+      prefix[i * TSDB_NCHAR_SIZE + 1] = (char)(c >> 16);
+      prefix[i * TSDB_NCHAR_SIZE + 2] = (char)(c >> 8);
+      prefix[i * TSDB_NCHAR_SIZE + 3] = (char)c;
     }
-    
-    data += varDataLen(data);
+
+    return n * TSDB_NCHAR_SIZE;
   }
-  
+
+  int32_t n = MIN(len, (int32_t)VARSTR_PREFIX_BYTES);
+  memcpy(prefix, val, n);
+  return n;
+}
+
+static void getStatics_var(const void *pData, int32_t numOfRow, int32_t type, int64_t *min, int64_t *max, int64_t *sum,
+                           int16_t *minIndex, int16_t *maxIndex, int16_t *numOfNull) {
+  const char *data = pData;
+  const char *minVal = NULL;
+  const char *maxVal = NULL;
+  int32_t     numOfVal = 0;
+
+  // linear counting on a small bitmap to estimate the number of distinct values
+  uint8_t bitmap[VARSTR_DISTINCT_BITS / 8] = {0};
+
+  ASSERT(numOfRow <= INT16_MAX);
+
   *sum = 0;
   *max = 0;
   *min = 0;
   *minIndex = 0;
   *maxIndex = 0;
+
+  for (int32_t i = 0; i < numOfRow; ++i, data += varDataTLen(data)) {
+    if (isNull(data, type)) {
+      (*numOfNull) += 1;
+      continue;
+    }
+
+    int32_t len = varDataLen(data);
+    if (minVal == NULL || compareVarData(varDataVal(data), len, varDataVal(minVal), varDataLen(minVal), type) < 0) {
+      minVal = data;
+      *minIndex = i;
+    }
+
+    if (maxVal == NULL || compareVarData(varDataVal(data), len, varDataVal(maxVal), varDataLen(maxVal), type) > 0) {
+      maxVal = data;
+      *maxIndex = i;
+    }
+
+    uint32_t bit = MurmurHash3_32(varDataVal(data), len) % VARSTR_DISTINCT_BITS;
+    bitmap[bit >> 3] |= (uint8_t)(1u << (bit & 0x7));
+    numOfVal++;
+  }
+
+  if (numOfVal == 0) {
+    return;
+  }
+
+  tGetVarDataPrefix(varDataVal(minVal), varDataLen(minVal), type, (char *)min);
+  tGetVarDataPrefix(varDataVal(maxVal), varDataLen(maxVal), type, (char *)max);
+
+  int32_t numOfZero = 0;
+  for (int32_t i = 0; i < VARSTR_DISTINCT_BITS; ++i) {
+    if ((bitmap[i >> 3] & (1u << (i & 0x7))) == 0) {
+      numOfZero++;
+    }
+  }
+
+  // a saturated bitmap tells nothing more than that almost all values are distinct
+  int64_t distinct = numOfVal;
+  if (numOfZero > 0) {
+    distinct = (int64_t)(VARSTR_DISTINCT_BITS * log((double)VARSTR_DISTINCT_BITS / numOfZero) + 0.5);
+  }
+
+  // a non-zero sum denotes that the statistics of this block are available
+  *sum = MAX((int64_t)1, MIN(distinct, (int64_t)numOfVal));
+}
+
+static void getStatics_bin(const TSKEY *primaryKey, const void *pData, int32_t numOfRow, int64_t *min, int64_t *max,
+                         int64_t *sum, int16_t *minIndex, int16_t *maxIndex, int16_t *numOfNull) {
+  getStatics_var(pData, numOfRow, TSDB_DATA_TYPE_BINARY, min, max, sum, minIndex, maxIndex, numOfNull);
+}
+
+static void getStatics_nchr(const TSKEY *primaryKey, const void *pData, int32_t numOfRow, int64_t *min, int64_t *max,
+                           int64_t *sum, int16_t *minIndex, int16_t *maxIndex, int16_t *numOfNull) {
+  getStatics_var(pData, numOfRow, TSDB_DATA_TYPE_NCHAR, min, max, sum, minIndex, maxIndex, numOfNull);
 }
 
 tDataTypeDescriptor tDataTypeDesc[11] = {
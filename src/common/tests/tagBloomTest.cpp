@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "taos.h"
+#include "taosdef.h"
+#include "taosmsg.h"
+#include "tutil.h"
+#include "ttagbloom.h"
+
+namespace {
+const int16_t TAG_COL_ID = 2;
+const int32_t BINARY_BYTES = 32 + VARSTR_HEADER_SIZE;
+
+// the tag value in the layout of tag data, padded to the bytes of the tag
+std::vector<char> makeValue(int8_t type, int64_t v) {
+  std::vector<char> val(BINARY_BYTES, 0);
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      *(int8_t*)&val[0] = (int8_t)v;
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      *(int16_t*)&val[0] = (int16_t)v;
+      break;
+    case TSDB_DATA_TYPE_INT:
+      *(int32_t*)&val[0] = (int32_t)v;
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+      *(int64_t*)&val[0] = v;
+      break;
+    case TSDB_DATA_TYPE_BINARY:
+      varDataSetLen(&val[0], sprintf((char*)varDataVal(&val[0]), "tag%" PRId64, v));
+      break;
+  }
+
+  return val;
+}
+
+uint32_t hashOf(int8_t type, int64_t v) { return tTagValueHash(TAG_COL_ID, type, &makeValue(type, v)[0]); }
+}  // namespace
+
+TEST(testCase, tag_bloom_hashable_test) {
+  int8_t hashable[] = {TSDB_DATA_TYPE_BOOL, TSDB_DATA_TYPE_TINYINT, TSDB_DATA_TYPE_SMALLINT, TSDB_DATA_TYPE_INT,
+                       TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_BINARY};
+  int8_t others[] = {TSDB_DATA_TYPE_FLOAT, TSDB_DATA_TYPE_DOUBLE, TSDB_DATA_TYPE_TIMESTAMP, TSDB_DATA_TYPE_NCHAR};
+
+  for (int32_t i = 0; i < tListLen(hashable); ++i) {
+    ASSERT_TRUE(tTagValueHashable(hashable[i]));
+  }
+  for (int32_t i = 0; i < tListLen(others); ++i) {
+    ASSERT_FALSE(tTagValueHashable(others[i]));
+  }
+}
+
+// every value added is found in the filter, even when the filter is full of other values
+TEST(testCase, tag_bloom_no_false_negative_test) {
+  int8_t  types[] = {TSDB_DATA_TYPE_TINYINT, TSDB_DATA_TYPE_SMALLINT, TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BIGINT,
+                     TSDB_DATA_TYPE_BINARY};
+  int64_t numOfValues[] = {50, 1000, 10000};
+
+  for (int32_t t = 0; t < tListLen(types); ++t) {
+    for (int32_t n = 0; n < tListLen(numOfValues); ++n) {
+      uint8_t bloom[TSDB_TAG_BLOOM_SIZE] = {0};
+      int64_t num = (types[t] == TSDB_DATA_TYPE_TINYINT) ? std::min(numOfValues[n], (int64_t)256) : numOfValues[n];
+
+      for (int64_t v = 0; v < num; ++v) {
+        tTagBloomAdd(bloom, hashOf(types[t], v * 7919 - 128));
+      }
+      for (int64_t v = 0; v < num; ++v) {
+        ASSERT_TRUE(tTagBloomTest(bloom, hashOf(types[t], v * 7919 - 128))) << "type:" << (int)types[t] << " v:" << v;
+      }
+    }
+  }
+}
+
+// the filter of a vgroup with a few hundred tables rarely matches a value not added
+TEST(testCase, tag_bloom_false_positive_test) {
+  uint8_t bloom[TSDB_TAG_BLOOM_SIZE] = {0};
+  for (int64_t v = 0; v < 200; ++v) {
+    tTagBloomAdd(bloom, hashOf(TSDB_DATA_TYPE_INT, v));
+  }
+
+  int32_t falsePositives = 0;
+  for (int64_t v = 200; v < 20200; ++v) {
+    if (tTagBloomTest(bloom, hashOf(TSDB_DATA_TYPE_INT, v))) falsePositives++;
+  }
+
+  ASSERT_LT(falsePositives, 20000 * 5 / 100);
+}
+
+TEST(testCase, tag_bloom_add_test) {
+  uint8_t  bloom[TSDB_TAG_BLOOM_SIZE] = {0};
+  uint32_t hash = hashOf(TSDB_DATA_TYPE_BIGINT, 12345);
+
+  ASSERT_FALSE(tTagBloomTest(bloom, hash));
+  ASSERT_TRUE(tTagBloomAdd(bloom, hash));
+  ASSERT_FALSE(tTagBloomAdd(bloom, hash));
+  ASSERT_TRUE(tTagBloomTest(bloom, hash));
+}
+
+// binary values are compared by their lengths and then by strncmp in vnode, so the bytes after '\0' and in the rest
+// of the tag make no difference, while the length does
+TEST(testCase, tag_bloom_binary_value_test) {
+  std::vector<char> val1 = makeValue(TSDB_DATA_TYPE_BINARY, 1);
+  std::vector<char> val2 = val1;
+  val2[BINARY_BYTES - 1] = 'x';
+  ASSERT_EQ(tTagValueHash(TAG_COL_ID, TSDB_DATA_TYPE_BINARY, &val1[0]),
+            tTagValueHash(TAG_COL_ID, TSDB_DATA_TYPE_BINARY, &val2[0]));
+
+  std::vector<char> val3 = val1;
+  varDataSetLen(&val3[0], varDataLen(&val1[0]) + 2);
+  val3[VARSTR_HEADER_SIZE + varDataLen(&val1[0]) + 1] = 'x';
+  std::vector<char> val4 = val3;
+  val4[VARSTR_HEADER_SIZE + varDataLen(&val1[0]) + 1] = 'y';
+  ASSERT_EQ(tTagValueHash(TAG_COL_ID, TSDB_DATA_TYPE_BINARY, &val3[0]),
+            tTagValueHash(TAG_COL_ID, TSDB_DATA_TYPE_BINARY, &val4[0]));
+  ASSERT_NE(tTagValueHash(TAG_COL_ID, TSDB_DATA_TYPE_BINARY, &val1[0]),
+            tTagValueHash(TAG_COL_ID, TSDB_DATA_TYPE_BINARY, &val3[0]));
+
+  // a prefix of the value is a different one
+  std::vector<char> val5 = val1;
+  varDataSetLen(&val5[0], varDataLen(&val1[0]) - 1);
+  val5[VARSTR_HEADER_SIZE + varDataLen(&val5[0])] = 0;
+  ASSERT_NE(tTagValueHash(TAG_COL_ID, TSDB_DATA_TYPE_BINARY, &val1[0]),
+            tTagValueHash(TAG_COL_ID, TSDB_DATA_TYPE_BINARY, &val5[0]));
+}
+
+// the same value of different tags is summarized as different values
+TEST(testCase, tag_bloom_col_id_test) {
+  std::vector<char> val = makeValue(TSDB_DATA_TYPE_INT, 42);
+  uint8_t           bloom[TSDB_TAG_BLOOM_SIZE] = {0};
+
+  tTagBloomAdd(bloom, tTagValueHash(1, TSDB_DATA_TYPE_INT, &val[0]));
+  ASSERT_TRUE(tTagBloomTest(bloom, tTagValueHash(1, TSDB_DATA_TYPE_INT, &val[0])));
+  ASSERT_NE(tTagValueHash(1, TSDB_DATA_TYPE_INT, &val[0]), tTagValueHash(2, TSDB_DATA_TYPE_INT, &val[0]));
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "taos.h"
+#include "taosdef.h"
+#include "tutil.h"
+
+namespace {
+// the values of a block of binary/nchar column, one after another in the layout of var data
+class SVarDataBlock {
+ public:
+  explicit SVarDataBlock(int8_t type) : type(type), numOfRows(0) {}
+
+  void append(const std::string& val) {
+    char buf[128 + VARSTR_HEADER_SIZE] = {0};
+    if (type == TSDB_DATA_TYPE_BINARY) {
+      memcpy(varDataVal(buf), val.c_str(), val.size());
+      varDataSetLen(buf, val.size());
+    } else {
+      // every char of the value is a code point
+      for (size_t i = 0; i < val.size(); ++i) {
+        uint32_t c = (uint8_t)val[i];
+        memcpy(varDataVal(buf) + i * TSDB_NCHAR_SIZE, &c, TSDB_NCHAR_SIZE);
+      }
+      varDataSetLen(buf, val.size() * TSDB_NCHAR_SIZE);
+    }
+
+    appendVarData(buf);
+  }
+
+  // the code points of the value in nchar
+  void appendCodePoints(const std::vector<uint32_t>& codes) {
+    char buf[128 + VARSTR_HEADER_SIZE] = {0};
+    for (size_t i = 0; i < codes.size(); ++i) {
+      memcpy(varDataVal(buf) + i * TSDB_NCHAR_SIZE, &codes[i], TSDB_NCHAR_SIZE);
+    }
+    varDataSetLen(buf, codes.size() * TSDB_NCHAR_SIZE);
+    appendVarData(buf);
+  }
+
+  void appendNull() {
+    char buf[sizeof(int32_t) + VARSTR_HEADER_SIZE] = {0};
+    setVardataNull(buf, type);
+    appendVarData(buf);
+  }
+
+  void getStatis(int64_t* min, int64_t* max, int64_t* sum, int16_t* minIndex, int16_t* maxIndex, int16_t* numOfNull) {
+    *numOfNull = 0;
+    tDataTypeDesc[type].getStatisFunc(NULL, &data[0], numOfRows, min, max, sum, minIndex, maxIndex, numOfNull);
+  }
+
+  int64_t prefixOf(const char* val, int32_t len) {
+    int64_t prefix = 0;
+    tGetVarDataPrefix(val, len, type, (char*)&prefix);
+    return prefix;
+  }
+
+  int8_t type;
+  int32_t numOfRows;
+
+ private:
+  void appendVarData(const char* buf) {
+    data.insert(data.end(), buf, buf + varDataTLen(buf));
+    numOfRows++;
+  }
+
+  std::vector<char> data;
+};
+}  // namespace
+
+// the nulls are counted, and the smallest and the largest values are found among the others
+TEST(testCase, var_data_statis_min_max_test) {
+  int8_t types[] = {TSDB_DATA_TYPE_BINARY, TSDB_DATA_TYPE_NCHAR};
+
+  for (int32_t t = 0; t < tListLen(types); ++t) {
+    SVarDataBlock block(types[t]);
+    block.appendNull();
+    block.append("beijing");
+    block.append("shanghai");
+    block.appendNull();
+    block.append("abc");
+    block.append("abcd");
+    block.append("shanghai-pudong");
+    block.appendNull();
+
+    int64_t min = 0, max = 0, sum = 0;
+    int16_t minIndex = 0, maxIndex = 0, numOfNull = 0;
+    block.getStatis(&min, &max, &sum, &minIndex, &maxIndex, &numOfNull);
+
+    ASSERT_EQ(numOfNull, 3);
+    ASSERT_EQ(minIndex, 4);
+    ASSERT_EQ(maxIndex, 6);
+    ASSERT_EQ(sum, 5);
+
+    // only the leading bytes are kept, and the prefixes are in the same order as the values
+    SVarDataBlock values(types[t]);
+    values.append("abc");
+    values.append("shanghai-pudong");
+    int64_t minPrefix = 0, maxPrefix = 0;
+    int16_t n = 0;
+    int64_t s = 0;
+    values.getStatis(&minPrefix, &maxPrefix, &s, &minIndex, &maxIndex, &n);
+    ASSERT_EQ(min, minPrefix);
+    ASSERT_EQ(max, maxPrefix);
+    ASSERT_LT(memcmp(&min, &max, VARSTR_PREFIX_BYTES), 0);
+  }
+}
+
+// the prefix of nchar value keeps the code points in big endian, so the prefixes are ordered by memcmp
+TEST(testCase, var_data_statis_nchar_order_test) {
+  SVarDataBlock block(TSDB_DATA_TYPE_NCHAR);
+  block.appendCodePoints({0x100});
+  block.appendCodePoints({0xff, 0x41});
+  block.appendCodePoints({0x4e2d, 0x6587});
+
+  int64_t min = 0, max = 0, sum = 0;
+  int16_t minIndex = 0, maxIndex = 0, numOfNull = 0;
+  block.getStatis(&min, &max, &sum, &minIndex, &maxIndex, &numOfNull);
+
+  ASSERT_EQ(numOfNull, 0);
+  ASSERT_EQ(minIndex, 1);
+  ASSERT_EQ(maxIndex, 2);
+
+  uint32_t codes[] = {0xff, 0x41};
+  int64_t  prefix = block.prefixOf((char*)codes, sizeof(codes));
+  ASSERT_EQ(min, prefix);
+  ASSERT_EQ(((uint8_t*)&prefix)[3], 0xff);
+  ASSERT_EQ(((uint8_t*)&prefix)[7], 0x41);
+  ASSERT_LT(memcmp(&min, &max, VARSTR_PREFIX_BYTES), 0);
+
+  // a prefix of the value is no larger than the value
+  uint32_t code = 0xff;
+  int64_t  shorter = block.prefixOf((char*)&code, sizeof(code));
+  ASSERT_LE(memcmp(&shorter, &min, VARSTR_PREFIX_BYTES), 0);
+}
+
+// the sum keeps an estimation of the number of distinct values, and it is 0 only if all the values are NULL
+TEST(testCase, var_data_statis_distinct_test) {
+  int32_t numOfDistinct[] = {1, 10, 100, 500};
+
+  for (int32_t d = 0; d < tListLen(numOfDistinct); ++d) {
+    SVarDataBlock block(TSDB_DATA_TYPE_BINARY);
+    for (int32_t i = 0; i < 2000; ++i) {
+      block.append("device-" + std::to_string(i % numOfDistinct[d]));
+    }
+
+    int64_t min = 0, max = 0, sum = 0;
+    int16_t minIndex = 0, maxIndex = 0, numOfNull = 0;
+    block.getStatis(&min, &max, &sum, &minIndex, &maxIndex, &numOfNull);
+
+    ASSERT_EQ(numOfNull, 0);
+    ASSERT_GE(sum, 1);
+    ASSERT_LE(std::abs(sum - numOfDistinct[d]), numOfDistinct[d] / 10) << "distinct:" << numOfDistinct[d];
+  }
+
+  SVarDataBlock nulls(TSDB_DATA_TYPE_NCHAR);
+  for (int32_t i = 0; i < 10; ++i) {
+    nulls.appendNull();
+  }
+
+  int64_t min = 0, max = 0, sum = 0;
+  int16_t minIndex = 0, maxIndex = 0, numOfNull = 0;
+  nulls.getStatis(&min, &max, &sum, &minIndex, &maxIndex, &numOfNull);
+  ASSERT_EQ(numOfNull, 10);
+  ASSERT_EQ(sum, 0);
+}
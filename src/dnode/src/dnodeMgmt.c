@@ -52,6 +52,12 @@ static void    *tsDnodeTmr = NULL;
 static void    *tsStatusTimer = NULL;
 static uint32_t tsRebootTime;
 
+// status msg carries only the vnodes changed since the last one, and the load of all vnodes is reported
+// every DNODE_FULL_STATUS_TIMES msgs, or once the last msg is not acknowledged or mnode asks for it
+#define DNODE_FULL_STATUS_TIMES 10
+static uint32_t tsStatusSeq = 0;
+static bool     tsFullStatusRequired = true;
+
 static SRpcIpSet     tsMnodeIpSet  = {0};
 static SDMMnodeInfos tsMnodeInfos = {0};
 static SDMDnodeCfg   tsDnodeCfg = {0};
@@ -314,6 +320,11 @@ static void dnodeProcessStatusRsp(SRpcMsg *pMsg) {
     pVgAcccess[i].vgId = htonl(pVgAcccess[i].vgId);
   }
   
+  tsFullStatusRequired = (pStatusRsp->fullReportRequired != 0);
+  if (tsFullStatusRequired) {
+    dTrace("mnode requires the load of all vnodes in next status msg");
+  }
+
   dnodeProcessModuleStatus(pCfg->moduleStatus);
   dnodeUpdateDnodeCfg(pCfg);
   dnodeUpdateMnodeInfos(pMnodes);
@@ -497,8 +508,14 @@ static void dnodeSendStatusMsg(void *handle, void *tmrId) {
   pStatus->numOfCores       = htons((uint16_t) tsNumOfCores);
   pStatus->diskAvailable    = tsAvailDataDirGB;
   pStatus->alternativeRole  = (uint8_t) tsAlternativeRole;
-  
-  vnodeBuildStatusMsg(pStatus);
+
+  // deltas are based on this msg from now on, it is reset to false after this msg is acknowledged
+  tsStatusSeq++;
+  pStatus->fullReport       = (tsFullStatusRequired || tsStatusSeq % DNODE_FULL_STATUS_TIMES == 1) ? 1 : 0;
+  pStatus->statusSeq        = htonl(tsStatusSeq);
+  tsFullStatusRequired      = true;
+
+  vnodeBuildStatusMsg(pStatus, pStatus->fullReport);
   contLen = sizeof(SDMStatusMsg) + pStatus->openVnodes * sizeof(SVnodeLoad);
   pStatus->openVnodes = htons(pStatus->openVnodes);
   
@@ -53,6 +53,10 @@ typedef struct tstr {
 #define varDataLenByData(v) (*(VarDataLenT *)(((char*)(v)) - VARSTR_HEADER_SIZE))
 #define varDataSetLen(v, _len) (((VarDataLenT *)(v))[0] = (VarDataLenT) (_len))
 
+// For binary and nchar columns, the min/max of the block statistics keep the leading VARSTR_PREFIX_BYTES bytes of the
+// smallest/largest value in the block, and the sum keeps an estimation of the number of distinct values in it.
+#define VARSTR_PREFIX_BYTES sizeof(int64_t)
+
 // this data type is internally used only in 'in' query to hold the values
 #define TSDB_DATA_TYPE_ARRAY      (TSDB_DATA_TYPE_NCHAR + 1)
 
@@ -157,6 +161,8 @@ extern tDataTypeDescriptor tDataTypeDesc[11];
 bool isValidDataType(int32_t type, int32_t length);
 bool isNull(const char *val, int32_t type);
 
+int32_t tGetVarDataPrefix(const char *val, int32_t len, int32_t type, char *prefix);
+
 void setVardataNull(char* val, int32_t type);
 void setNull(char *val, int32_t type, int32_t bytes);
 void setNullN(char *val, int32_t type, int32_t bytes, int32_t numOfElems);
@@ -289,9 +295,13 @@ void tsDataSwap(void *pLeft, void *pRight, int32_t type, int32_t size);
 #define TSDB_DEFAULT_PRECISION          TSDB_PRECISION_MILLI
 
 #define TSDB_MIN_COMP_LEVEL             0
-#define TSDB_MAX_COMP_LEVEL             2
+#define TSDB_MAX_COMP_LEVEL             3
 #define TSDB_DEFAULT_COMP_LEVEL         2
 
+#define TSDB_MIN_DB_UPDATE              0
+#define TSDB_MAX_DB_UPDATE              1
+#define TSDB_DEFAULT_DB_UPDATE          0
+
 #define TSDB_MIN_WAL_LEVEL             0
 #define TSDB_MAX_WAL_LEVEL             2
 #define TSDB_DEFAULT_WAL_LEVEL         2
@@ -154,6 +154,10 @@ enum _mgmt_table {
 #define TSDB_FILL_LINEAR    3
 #define TSDB_FILL_PREV      4
 
+#define TSDB_WINDOW_NONE    0  // no window, or windows of fixed intervals
+#define TSDB_WINDOW_SESSION 1
+#define TSDB_WINDOW_STATE   2
+
 #define TSDB_ALTER_USER_PASSWD 0x1
 #define TSDB_ALTER_USER_PRIVILEGES 0x2
 
@@ -433,6 +437,9 @@ typedef struct {
   int64_t     intervalOffset;   // start offset for interval query
   int64_t     slidingTime;      // value for sliding window
   char        slidingTimeUnit;  // time interval type, for revisement of interval(1d)
+  int8_t      windowType;       // session or state window query
+  int64_t     sessionGap;       // max time gap between the adjacent rows of a session window
+  int16_t     stateColId;       // rows are in one state window until the value of this column changes
   uint16_t    tagCondLen;       // tag length in current query
   int16_t     numOfGroupCols;   // num of group by columns
   int16_t     orderByIdx;
@@ -552,13 +559,17 @@ typedef struct {
   uint16_t   numOfCores;
   float      diskAvailable;  // GB
   uint8_t    alternativeRole;
-  uint8_t    reserve[15];
+  uint8_t    fullReport;        // 1: load of all vnodes, 0: only the vnodes changed since the last status msg
+  uint32_t   statusSeq;         // increased by one for each status msg, starts from 1 after reboot
+  uint8_t    reserve[10];
   SVnodeLoad load[];
 } SDMStatusMsg;
 
 typedef struct {
   SDMMnodeInfos    mnodes;
   SDMDnodeCfg      dnodeCfg;
+  uint8_t          fullReportRequired;  // deltas can not be applied by mnode, load of all vnodes is required
+  uint8_t          reserve[7];
   SDMVgroupAccess  vgAccess[];
 } SDMStatusRsp;
 
@@ -581,7 +592,8 @@ typedef struct {
   int8_t   replications;
   int8_t   wals;
   int8_t   quorum;
-  int8_t   reserved[16];
+  int8_t   update;
+  int8_t   reserved[15];
 } SMDVnodeCfg;
 
 typedef struct {
@@ -605,10 +617,22 @@ typedef struct {
   char    tableIds[];
 } SCMMultiTableInfoMsg;
 
+/*
+ * The request is followed by numOfTables SCMSTableVgroupInfo, and the response by a version and an SVgroupsInfo for
+ * each table. numOfVgroups of the SVgroupsInfo is TSDB_VGROUP_LIST_UNCHANGED and no vgroup follows if the vgroup list
+ * cached by client is still valid.
+ */
 typedef struct SCMSTableVgroupMsg {
   int32_t numOfTables;
 } SCMSTableVgroupMsg, SCMSTableVgroupRspMsg;
 
+#define TSDB_VGROUP_LIST_UNCHANGED -1
+
+typedef struct {
+  char    tableId[TSDB_TABLE_ID_LEN];
+  int64_t version;  // version of the vgroup list cached by client, 0 if not cached
+} SCMSTableVgroupInfo;
+
 typedef struct {
   int32_t   vgId;
   int8_t    numOfIps;
@@ -620,6 +644,19 @@ typedef struct {
   SCMVgroupInfo vgroups[];
 } SVgroupsInfo;
 
+/*
+ * Summary of the tag values of a super table, follows a changed SVgroupsInfo in the response of the vgroup list. It
+ * lists the tags whose values of all child tables are summarized, and is followed by a bloom filter of
+ * TSDB_TAG_BLOOM_SIZE bytes for each vgroup, in the order of SVgroupsInfo. A vgroup is not queried if the value of a
+ * listed tag in the equality condition is not in its filter.
+ */
+#define TSDB_TAG_BLOOM_SIZE 256
+
+typedef struct {
+  int16_t numOfTags;
+  int16_t colIds[];
+} STagSummaryMsg;
+
 //typedef struct {
 //  int32_t numOfTables;
 //  int32_t join;
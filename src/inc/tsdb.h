@@ -60,6 +60,7 @@ typedef struct {
   int32_t commitTime;
   int8_t  precision;
   int8_t  compression;
+  int8_t  update;               // rows with an existing timestamp replace the old ones instead of being dropped
 } STsdbCfg;
 
 void      tsdbSetDefaultCfg(STsdbCfg *pCfg);
@@ -111,14 +112,35 @@ int   tsdbDropTable(TsdbRepoT *pRepo, STableId tableId);
 int   tsdbAlterTable(TsdbRepoT *repo, STableCfg *pCfg);
 TSKEY tsdbGetTableLastKey(TsdbRepoT *repo, uint64_t uid);
 
+/**
+ * Get the data version of a table, which only changes when rows no later than the last key of the table are
+ * inserted. So the data in a time range is unchanged as long as the data version is the same and the range does not
+ * go beyond the last key of the table.
+ *
+ * @return the data version, -1 if the table does not exist
+ */
+int64_t tsdbGetTableDataVersion(TsdbRepoT *repo, uint64_t uid);
+
 uint32_t tsdbGetFileInfo(TsdbRepoT *repo, char *name, uint32_t *index, int32_t *size);
 
+// block statistics of a repository
+typedef struct {
+  int64_t numOfBlocks;         // data blocks of the tables written by the last commit
+  int64_t numOfSubBlocks;      // sub-blocks of these data blocks
+  int64_t numOfLastBlocks;     // data blocks of these tables kept in .last files
+  int64_t numOfMergedBlocks;   // data blocks and sub-blocks consolidated by commits since the repository is opened
+  int64_t numOfBlocksRead;     // data blocks read by queries
+  int64_t numOfFragmentsRead;  // data blocks and sub-blocks read for them, the read amplification is the ratio
+  int64_t numOfBlocksShared;   // data blocks taken from the ones loaded by other concurrent queries instead of read
+} STsdbStat;
+
 // the TSDB repository info
 typedef struct STsdbRepoInfo {
-  STsdbCfg tsdbCfg;
-  int64_t  version;            // version of the repository
-  int64_t  tsdbTotalDataSize;  // the original inserted data size
-  int64_t  tsdbTotalDiskSize;  // the total disk size taken by this TSDB repository
+  STsdbCfg  tsdbCfg;
+  int64_t   version;            // version of the repository
+  int64_t   tsdbTotalDataSize;  // the original inserted data size
+  int64_t   tsdbTotalDiskSize;  // the total disk size taken by this TSDB repository
+  STsdbStat stat;
   // TODO: Other informations to add
 } STsdbRepoInfo;
 STsdbRepoInfo *tsdbGetStatus(TsdbRepoT *pRepo);
@@ -224,6 +246,30 @@ SDataBlockInfo tsdbRetrieveDataBlockInfo(TsdbQueryHandleT *pQueryHandle);
  */
 int32_t tsdbRetrieveDataBlockStatisInfo(TsdbQueryHandleT *pQueryHandle, SDataStatis **pBlockStatis);
 
+/**
+ * Get the pre-aggregated windows of the current data block from the rollup kept at commit time.
+ *
+ * The coarsest rollup tier that the query windows consist of is used. The windows cover all rows of the block and
+ * the statistics of each window follow the columns of the query handle.
+ *
+ * @param interval the interval of the query windows
+ * @param origin   the start key of any query window
+ * @return NULL for blocks in cache, blocks with sub-blocks and blocks without a proper rollup tier
+ */
+SDataRollup *tsdbRetrieveDataBlockRollup(TsdbQueryHandleT *pQueryHandle, int64_t interval, int64_t origin);
+
+/**
+ * Check the bloom filter of a column in the current data block for an equality lookup.
+ *
+ * Always true for the blocks in cache or the blocks without bloom filter.
+ *
+ * @param colId the column id
+ * @param val   the value to check, integer values are given as int64_t
+ * @param len   the length of val in bytes
+ * @return false if the value definitely does not exist in the column of current data block
+ */
+bool tsdbBlockMayContainValue(TsdbQueryHandleT *pQueryHandle, int16_t colId, const char *val, int32_t len);
+
 /**
  *
  * The query condition with primary timestamp is passed to iterator during its constructor function,
@@ -28,6 +28,7 @@ struct SDbObj;
 struct SAcctObj;
 struct SUserObj;
 struct SMnodeObj;
+struct SChildTableObj;
 
 typedef struct SDnodeObj {
   int32_t    dnodeId;
@@ -54,6 +55,7 @@ typedef struct SDnodeObj {
   int16_t    cpuAvgUsage;      // calc from sys.cpu
   int16_t    memoryAvgUsage;   // calc from sys.mem
   int16_t    bandwidthUsage;   // calc from sys.band
+  uint32_t   statusSeq;        // seq of the last status msg applied, 0 if no full report is applied yet
 } SDnodeObj;
 
 typedef struct SMnodeObj {
@@ -70,6 +72,19 @@ typedef struct {
   int8_t type;
 } STableObj;
 
+typedef struct STagValueHash {
+  int16_t  colId;
+  int16_t  reserved;
+  uint32_t hash;
+} STagValueHash;
+
+typedef struct SSuperTableVgroup {
+  int32_t vgId;
+  int32_t numOfTables;   // child tables of the super table in the vgroup
+  int32_t numOfDropped;  // dropped child tables whose tag values are still in the bloom filter
+  uint8_t bloom[TSDB_TAG_BLOOM_SIZE];
+} SSuperTableVgroup;
+
 typedef struct SSuperTableObj {
   STableObj  info;
   uint64_t   uid;
@@ -84,10 +99,16 @@ typedef struct SSuperTableObj {
   int32_t    numOfTables;
   int16_t    nextColId;
   SSchema *  schema;
-  void *     vgHash;
+  void *     vgHash;           // SSuperTableVgroup of the vgroups holding child tables, keyed by vgId
+  void *     tagValueCount;    // number of child tables whose value of a tag is summarized, keyed by colId
+  struct SChildTableObj *pHead;  // list of the child tables
+  int32_t    vgListLen;
+  int64_t    vgVersion;      // changed once a vgroup is added into or removed from vgHash
+  int64_t    vgListVersion;  // version of vgList
+  char *     vgList;         // SVgroupsInfo of vgHash in network byte order, built on the query of clients
 } SSuperTableObj;
 
-typedef struct {
+typedef struct SChildTableObj {
   STableObj  info;
   uint64_t   uid;
   int64_t    createdTime;
@@ -103,7 +124,10 @@ typedef struct {
   int32_t    refCount;
   char*      sql;          //used by normal table
   SSchema*   schema;       //used by normal table
+  int32_t    numOfTagHashes;
+  STagValueHash *tagHashes;  // hash of the summarized tag values, used by child table
   SSuperTableObj *superTable;
+  struct SChildTableObj *prev, *next;  // in the child table list of the super table
 } SChildTableObj;
 
 typedef struct {
@@ -150,7 +174,8 @@ typedef struct {
   int8_t  compression;
   int8_t  walLevel;
   int8_t  replications;
-  int8_t  reserved[16];
+  int8_t  update;
+  int8_t  reserved[15];
 } SDbCfg;
 
 typedef struct SDbObj {
@@ -228,6 +253,8 @@ typedef struct {
   int32_t  numOfReads;
   int16_t  offset[TSDB_MAX_COLUMNS];
   int16_t  bytes[TSDB_MAX_COLUMNS];
+  int32_t  vgId;  // position of show tables, the vgroup and the index in its table list
+  int32_t  sid;
   void *   signature;
   uint16_t payloadLen;
   char     payload[];
@@ -74,6 +74,10 @@ void *  sdbOpenTable(SSdbTableDesc *desc);
 void    sdbCloseTable(void *handle);
 bool    sdbIsMaster();
 bool    sdbIsServing();
+void    sdbReadLock();
+void    sdbReadUnLock();
+void    sdbWriteLock();
+void    sdbWriteUnLock();
 void    sdbUpdateMnodeRoles();
 
 int32_t sdbInsertRow(SSdbOper *pOper);
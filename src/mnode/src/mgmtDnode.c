@@ -321,19 +321,36 @@ void mgmtProcessDnodeStatusMsg(SRpcMsg *rpcMsg) {
     //mTrace("dnode:%d, status received, access times %d", pDnode->dnodeId, pDnode->lastAccess);
   }
  
-  int32_t openVnodes = htons(pStatus->openVnodes);
+  // a delta is applied only if it follows the last applied status msg, otherwise some changes may be missed, e.g.
+  // the msgs are sent to another mnode before, so the load of all vnodes is asked for
+  int32_t  openVnodes = htons(pStatus->openVnodes);
+  uint32_t statusSeq = htonl(pStatus->statusSeq);
+  bool     fullReportRequired = false;
+  if (pStatus->fullReport || (pDnode->statusSeq != 0 && statusSeq == pDnode->statusSeq + 1)) {
+    pDnode->statusSeq = statusSeq;
+  } else {
+    mTrace("dnode:%d, status seq:%u not follows the last applied one:%u, ask for the load of all vnodes",
+           pDnode->dnodeId, statusSeq, pDnode->statusSeq);
+    pDnode->statusSeq = 0;
+    fullReportRequired = true;
+    openVnodes = 0;
+  }
+
   for (int32_t j = 0; j < openVnodes; ++j) {
     SVnodeLoad *pVload = &pStatus->load[j];
     pVload->vgId = htonl(pVload->vgId);
     pVload->cfgVersion = htonl(pVload->cfgVersion);
 
+    // the vnodes not matching mnode are reported again in the next msg, so the msgs to fix them are resent until
+    // they are fixed, even if their loads are not changed
     SVgObj *pVgroup = mgmtGetVgroup(pVload->vgId);
     if (pVgroup == NULL) {
       SRpcIpSet ipSet = mgmtGetIpSetFromIp(pDnode->dnodeEp);
       mPrint("dnode:%d, vgId:%d not exist in mnode, drop it", pDnode->dnodeId, pVload->vgId);
       mgmtSendDropVnodeMsg(pVload->vgId, &ipSet, NULL);
+      fullReportRequired = true;
     } else {
-      mgmtUpdateVgroupStatus(pVgroup, pDnode, pVload);
+      if (!mgmtUpdateVgroupStatus(pVgroup, pDnode, pVload)) fullReportRequired = true;
       mgmtDecVgroupRef(pVgroup);
     }
   }
@@ -359,6 +376,7 @@ void mgmtProcessDnodeStatusMsg(SRpcMsg *rpcMsg) {
   pRsp->dnodeCfg.dnodeId = htonl(pDnode->dnodeId);
   pRsp->dnodeCfg.moduleStatus = htonl((int32_t)pDnode->isMgmt);
   pRsp->dnodeCfg.numOfVnodes = 0;
+  pRsp->fullReportRequired = fullReportRequired ? 1 : 0;
   
   contLen = sizeof(SDMStatusRsp);
 
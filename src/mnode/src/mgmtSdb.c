@@ -75,6 +75,8 @@ typedef struct {
   int32_t    numOfTables;
   SSdbTable *tableList[SDB_TABLE_MAX];
   pthread_mutex_t mutex;
+  pthread_mutex_t gate;    // queues the readers behind a waiting writer, so writes are not starved
+  pthread_rwlock_t rwLock; // shared by the read only requests, exclusive while the hash and the actions change
 } SSdbObject;
 
 typedef struct {
@@ -85,6 +87,9 @@ typedef struct {
 static SSdbObject tsSdbObj = {0};
 static int sdbWrite(void *param, void *data, int type);
 
+// actions may change other rows, e.g. dropping a super table drops its child tables, so the write lock is reentrant
+static threadlocal int32_t tsSdbWriteDepth = 0;
+
 int32_t sdbGetId(void *handle) {
   return ((SSdbTable *)handle)->autoIndex;
 }
@@ -97,6 +102,30 @@ uint64_t sdbGetVersion() {
   return tsSdbObj.version;
 }
 
+void sdbReadLock() {
+  if (tsSdbWriteDepth > 0) return;
+  pthread_mutex_lock(&tsSdbObj.gate);
+  pthread_rwlock_rdlock(&tsSdbObj.rwLock);
+  pthread_mutex_unlock(&tsSdbObj.gate);
+}
+
+void sdbReadUnLock() {
+  if (tsSdbWriteDepth > 0) return;
+  pthread_rwlock_unlock(&tsSdbObj.rwLock);
+}
+
+void sdbWriteLock() {
+  if (tsSdbWriteDepth++ > 0) return;
+  pthread_mutex_lock(&tsSdbObj.gate);
+  pthread_rwlock_wrlock(&tsSdbObj.rwLock);
+  pthread_mutex_unlock(&tsSdbObj.gate);
+}
+
+void sdbWriteUnLock() {
+  if (--tsSdbWriteDepth > 0) return;
+  pthread_rwlock_unlock(&tsSdbObj.rwLock);
+}
+
 bool sdbIsMaster() { 
   return tsSdbObj.role == TAOS_SYNC_ROLE_MASTER; 
 }
@@ -316,6 +345,8 @@ void sdbUpdateSync() {
 
 int32_t sdbInit() {
   pthread_mutex_init(&tsSdbObj.mutex, NULL);
+  pthread_mutex_init(&tsSdbObj.gate, NULL);
+  pthread_rwlock_init(&tsSdbObj.rwLock, NULL);
   sem_init(&tsSdbObj.sem, 0, 0);
 
   if (sdbInitWal() != 0) {
@@ -351,6 +382,8 @@ void sdbCleanUp() {
   
   sem_destroy(&tsSdbObj.sem);
   pthread_mutex_destroy(&tsSdbObj.mutex);
+  pthread_mutex_destroy(&tsSdbObj.gate);
+  pthread_rwlock_destroy(&tsSdbObj.rwLock);
 }
 
 void sdbIncRef(void *handle, void *pObj) {
@@ -428,6 +461,7 @@ static int32_t sdbInsertHash(SSdbTable *pTable, SSdbOper *pOper) {
   rowMeta.rowSize = pOper->rowSize;
   rowMeta.row = pOper->pObj;
 
+  sdbWriteLock();
   pthread_mutex_lock(&pTable->mutex);
 
   void *  key = sdbGetObjKey(pTable, pOper->pObj);
@@ -454,10 +488,12 @@ static int32_t sdbInsertHash(SSdbTable *pTable, SSdbOper *pOper) {
            sdbGetKeyStrFromObj(pTable, pOper->pObj), pOper->rowSize, pTable->numOfRows, sdbGetVersion());
 
   (*pTable->insertFp)(pOper);
+  sdbWriteUnLock();
   return TSDB_CODE_SUCCESS;
 }
 
 static int32_t sdbDeleteHash(SSdbTable *pTable, SSdbOper *pOper) {
+  sdbWriteLock();
   (*pTable->deleteFp)(pOper);
   
   pthread_mutex_lock(&pTable->mutex);
@@ -480,6 +516,7 @@ static int32_t sdbDeleteHash(SSdbTable *pTable, SSdbOper *pOper) {
   int8_t *updateEnd = pOper->pObj + pTable->refCountPos - 1;
   *updateEnd = 1;
   sdbDecRef(pTable, pOper->pObj);
+  sdbWriteUnLock();
 
   return TSDB_CODE_SUCCESS;
 }
@@ -488,7 +525,9 @@ static int32_t sdbUpdateHash(SSdbTable *pTable, SSdbOper *pOper) {
   sdbTrace("table:%s, update record:%s in hash, numOfRows:%d version:%" PRIu64, pTable->tableName,
            sdbGetKeyStrFromObj(pTable, pOper->pObj), pTable->numOfRows, sdbGetVersion());
 
+  sdbWriteLock();
   (*pTable->updateFp)(pOper);
+  sdbWriteUnLock();
   return TSDB_CODE_SUCCESS;
 }
 
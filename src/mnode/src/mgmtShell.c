@@ -52,6 +52,7 @@ static void mgmtFreeShowObj(void *data);
 
 void *tsMgmtTmr;
 static void *tsMgmtTranQhandle = NULL;
+static void *tsMgmtReadQhandle = NULL;
 static void (*tsMgmtProcessShellMsgFp[TSDB_MSG_TYPE_MAX])(SQueuedMsg *) = {0};
 static void *tsQhandleCache = NULL;
 static SShowMetaFp     tsMgmtShowMetaFp[TSDB_MGMT_TABLE_MAX]     = {0};
@@ -66,6 +67,11 @@ int32_t mgmtInitShell() {
   
   tsMgmtTmr = taosTmrInit((tsMaxShellConns) * 3, 200, 3600000, "MND");
   tsMgmtTranQhandle = taosInitScheduler(tsMaxShellConns, 1, "mnodeT");
+
+  int32_t numOfReadThreads = tsNumOfMnodeReadThreads;
+  if (numOfReadThreads <= 0) numOfReadThreads = tsNumOfCores * tsNumOfThreadsPerCore / 2;
+  if (numOfReadThreads < 1) numOfReadThreads = 1;
+  tsMgmtReadQhandle = taosInitScheduler(tsMaxShellConns, numOfReadThreads, "mnodeR");
   tsQhandleCache = taosCacheInitWithCb(tsMgmtTmr, 10, mgmtFreeShowObj);
 
   return 0;
@@ -86,6 +92,11 @@ void mgmtCleanUpShell() {
     taosCleanUpScheduler(tsMgmtTranQhandle);
     tsMgmtTranQhandle = NULL;
   }
+
+  if (tsMgmtReadQhandle != NULL) {
+    taosCleanUpScheduler(tsMgmtReadQhandle);
+    tsMgmtReadQhandle = NULL;
+  }
 }
 
 void mgmtAddShellMsgHandle(uint8_t showType, void (*fp)(SQueuedMsg *queuedMsg)) {
@@ -113,6 +124,25 @@ void mgmtAddToShellQueue(SQueuedMsg *queuedMsg) {
   taosScheduleTask(tsMgmtTranQhandle, &schedMsg);
 }
 
+/*
+ * read only requests are served by a pool of threads, they share the read lock of sdb, so a table meta request never
+ * waits for the requests queued in the transaction queue, but only for the row being changed
+ */
+static void mgmtProcessReadRequest(SSchedMsg *sched) {
+  SQueuedMsg *queuedMsg = sched->msg;
+  sdbReadLock();
+  (*tsMgmtProcessShellMsgFp[queuedMsg->msgType])(queuedMsg);
+  sdbReadUnLock();
+  mgmtFreeQueuedMsg(queuedMsg);
+}
+
+static void mgmtAddToReadQueue(SQueuedMsg *queuedMsg) {
+  SSchedMsg schedMsg;
+  schedMsg.msg = queuedMsg;
+  schedMsg.fp  = mgmtProcessReadRequest;
+  taosScheduleTask(tsMgmtReadQhandle, &schedMsg);
+}
+
 static void mgmtDoDealyedAddToShellQueue(void *param, void *tmrId) {
   mgmtAddToShellQueue(param);
 }
@@ -166,8 +196,7 @@ void mgmtProcessMsgFromShell(SRpcMsg *rpcMsg) {
   }
   
   if (mgmtCheckMsgReadOnly(pMsg)) {
-    (*tsMgmtProcessShellMsgFp[rpcMsg->msgType])(pMsg);
-    mgmtFreeQueuedMsg(pMsg);
+    mgmtAddToReadQueue(pMsg);
   } else {
     if (!pMsg->pUser->writeAuth) {
       mgmtSendSimpleResp(pMsg->thandle, TSDB_CODE_NO_RIGHTS);
@@ -448,7 +477,7 @@ static bool mgmtCheckMsgReadOnly(SQueuedMsg *pMsg) {
 
   if (pMsg->msgType == TSDB_MSG_TYPE_CM_STABLE_VGROUP || pMsg->msgType == TSDB_MSG_TYPE_CM_RETRIEVE    ||
       pMsg->msgType == TSDB_MSG_TYPE_CM_SHOW          || pMsg->msgType == TSDB_MSG_TYPE_CM_TABLES_META ||
-      pMsg->msgType == TSDB_MSG_TYPE_CM_CONNECT) {
+      pMsg->msgType == TSDB_MSG_TYPE_CM_CONNECT       || pMsg->msgType == TSDB_MSG_TYPE_CM_HEARTBEAT) {
     return true;
   }
 
@@ -41,17 +41,20 @@
 #include "mgmtVgroup.h"
 #include "tcompare.h"
 #include "tdataformat.h"
+#include "ttagbloom.h"
 
 static void *  tsChildTableSdb;
 static void *  tsSuperTableSdb;
 static int32_t tsChildTableUpdateSize;
 static int32_t tsSuperTableUpdateSize;
+static pthread_mutex_t tsSuperTableVgListMutex;
 static void *  mgmtGetChildTable(char *tableId);
 static void *  mgmtGetSuperTable(char *tableId);
 static void *  mgmtGetSuperTableByUid(uint64_t uid);
 static void    mgmtDropAllChildTablesInStable(SSuperTableObj *pStable);
 static void    mgmtAddTableIntoStable(SSuperTableObj *pStable, SChildTableObj *pCtable);
 static void    mgmtRemoveTableFromStable(SSuperTableObj *pStable, SChildTableObj *pCtable);
+static bool    mgmtAddTagHashesIntoBloom(SSuperTableObj *pStable, SChildTableObj *pCtable);
 
 static int32_t mgmtGetShowTableMeta(STableMetaMsg *pMeta, SShowObj *pShow, void *pConn);
 static int32_t mgmtRetrieveShowTables(SShowObj *pShow, char *data, int32_t rows, void *pConn);
@@ -87,6 +90,7 @@ static void mgmtDestroyChildTable(SChildTableObj *pTable) {
   tfree(pTable->info.tableId);
   tfree(pTable->schema);
   tfree(pTable->sql);
+  tfree(pTable->tagHashes);
   tfree(pTable);
 }
 
@@ -184,12 +188,24 @@ static int32_t mgmtChildTableActionUpdate(SSdbOper *pOper) {
     void *oldTableId = pTable->info.tableId;
     void *oldSql = pTable->sql;
     void *oldSchema = pTable->schema;
-    memcpy(pTable, pNew, pOper->rowSize);
+    void *oldTagHashes = pTable->tagHashes;
+    SSuperTableObj *pStable = pTable->superTable;
+    // only the fields written into sdb are replaced, the links to the super table and the list are kept
+    pTable->info.tableId = pNew->info.tableId;
+    memcpy((char *)pTable + sizeof(char *), (char *)pNew + sizeof(char *), tsChildTableUpdateSize);
     pTable->sql = pNew->sql;
     pTable->schema = pNew->schema;
+    pTable->numOfTagHashes = pNew->numOfTagHashes;
+    pTable->tagHashes = pNew->tagHashes;
+
+    // the tag values set are replayed after the table is added into the super table
+    if (pStable != NULL && mgmtAddTagHashesIntoBloom(pStable, pTable)) {
+      pStable->vgVersion = mgmtNewVgListVersion();
+    }
     free(pNew);
     free(oldSql);
     free(oldSchema);
+    free(oldTagHashes);
     free(oldTableId);
   }
   mgmtDecTableRef(pTable);
@@ -220,6 +236,10 @@ static int32_t mgmtChildTableActionEncode(SSdbOper *pOper) {
       memcpy(pOper->rowData + len, pTable->sql, pTable->sqlLen);
       len += pTable->sqlLen;
     }
+  } else if (pTable->numOfTagHashes > 0) {
+    int32_t hashSize = pTable->numOfTagHashes * sizeof(STagValueHash);
+    memcpy(pOper->rowData + len, pTable->tagHashes, hashSize);
+    len += hashSize;
   }
 
   pOper->rowSize = len;
@@ -258,6 +278,17 @@ static int32_t mgmtChildTableActionDecode(SSdbOper *pOper) {
       }
       memcpy(pTable->sql, pOper->rowData + len, pTable->sqlLen);
     }
+  } else {
+    // the hashes of tag values are absent in the rows written by the early versions
+    pTable->numOfTagHashes = (pOper->rowSize - len) / sizeof(STagValueHash);
+    if (pTable->numOfTagHashes > 0) {
+      pTable->tagHashes = malloc(pTable->numOfTagHashes * sizeof(STagValueHash));
+      if (pTable->tagHashes == NULL) {
+        mgmtDestroyChildTable(pTable);
+        return TSDB_CODE_SERV_OUT_OF_MEMORY;
+      }
+      memcpy(pTable->tagHashes, pOper->rowData + len, pTable->numOfTagHashes * sizeof(STagValueHash));
+    }
   }
 
   pOper->pObj = pTable;
@@ -367,28 +398,152 @@ static void mgmtCleanUpChildTables() {
   sdbCloseTable(tsChildTableSdb);
 }
 
+// hash the values of the tags in the tag data of the create msg, in the layout of the tag schema of the super table
+static void mgmtSetChildTableTagHashes(SChildTableObj *pCtable, SSuperTableObj *pStable, STagData *pTagData) {
+  SSchema *pTagSchema = pStable->schema + pStable->numOfColumns;
+  int32_t  tagDataLen = 0;
+  int32_t  numOfHashes = 0;
+
+  for (int32_t i = 0; i < pStable->numOfTags; ++i) {
+    tagDataLen += pTagSchema[i].bytes;
+    if (tTagValueHashable(pTagSchema[i].type)) numOfHashes++;
+  }
+
+  // the tag data is built by client according to a different tag schema, the values are not summarized
+  if (tagDataLen != (int32_t)ntohl(pTagData->dataLen) || numOfHashes == 0) {
+    return;
+  }
+
+  pCtable->tagHashes = calloc(numOfHashes, sizeof(STagValueHash));
+  if (pCtable->tagHashes == NULL) {
+    return;
+  }
+
+  char *val = pTagData->data;
+  for (int32_t i = 0; i < pStable->numOfTags; ++i) {
+    if (tTagValueHashable(pTagSchema[i].type)) {
+      STagValueHash *pHash = &pCtable->tagHashes[pCtable->numOfTagHashes++];
+      pHash->colId = pTagSchema[i].colId;
+      pHash->hash = tTagValueHash(pTagSchema[i].colId, pTagSchema[i].type, val);
+    }
+    val += pTagSchema[i].bytes;
+  }
+}
+
+static void mgmtRebuildVgroupTagBloom(SSuperTableObj *pStable, SSuperTableVgroup *pVgroup) {
+  memset(pVgroup->bloom, 0, sizeof(pVgroup->bloom));
+  pVgroup->numOfDropped = 0;
+
+  for (SChildTableObj *pCtable = pStable->pHead; pCtable != NULL; pCtable = pCtable->next) {
+    if (pCtable->vgId != pVgroup->vgId) continue;
+    for (int32_t i = 0; i < pCtable->numOfTagHashes; ++i) {
+      tTagBloomAdd(pVgroup->bloom, pCtable->tagHashes[i].hash);
+    }
+  }
+
+  mTrace("stable:%s, tag bloom filter of vgId:%d is rebuilt, numOfTables:%d", pStable->info.tableId, pVgroup->vgId,
+         pVgroup->numOfTables);
+}
+
+// true if any value of the table is newly summarized in the bloom filter of its vgroup
+static bool mgmtAddTagHashesIntoBloom(SSuperTableObj *pStable, SChildTableObj *pCtable) {
+  if (pStable->vgHash == NULL) return false;
+
+  SSuperTableVgroup *pVgroup = taosHashGet(pStable->vgHash, (char *)&pCtable->vgId, sizeof(pCtable->vgId));
+  if (pVgroup == NULL) return false;
+
+  bool changed = false;
+  for (int32_t i = 0; i < pCtable->numOfTagHashes; ++i) {
+    changed |= tTagBloomAdd(pVgroup->bloom, pCtable->tagHashes[i].hash);
+  }
+
+  return changed;
+}
+
+static void mgmtUpdateTagValueCount(SSuperTableObj *pStable, SChildTableObj *pCtable, int32_t delta) {
+  if (pStable->tagValueCount == NULL) {
+    pStable->tagValueCount = taosHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_SMALLINT), false);
+    if (pStable->tagValueCount == NULL) return;
+  }
+
+  for (int32_t i = 0; i < pCtable->numOfTagHashes; ++i) {
+    int16_t  colId = pCtable->tagHashes[i].colId;
+    int32_t *pCount = taosHashGet(pStable->tagValueCount, (char *)&colId, sizeof(colId));
+    if (pCount != NULL) {
+      *pCount += delta;
+    } else {
+      taosHashPut(pStable->tagValueCount, (char *)&colId, sizeof(colId), &delta, sizeof(delta));
+    }
+  }
+}
+
 static void mgmtAddTableIntoStable(SSuperTableObj *pStable, SChildTableObj *pCtable) {
   pStable->numOfTables++;
 
+  pCtable->prev = NULL;
+  pCtable->next = pStable->pHead;
+  if (pStable->pHead != NULL) pStable->pHead->prev = pCtable;
+  pStable->pHead = pCtable;
+
+  mgmtUpdateTagValueCount(pStable, pCtable, 1);
+
   if (pStable->vgHash == NULL) {
     pStable->vgHash = taosHashInit(32, taosGetDefaultHashFunction(TSDB_DATA_TYPE_INT), false);
+    if (pStable->vgHash == NULL) return;
   }
 
-  if (pStable->vgHash != NULL) {
-    taosHashPut(pStable->vgHash, (char *)&pCtable->vgId, sizeof(pCtable->vgId), &pCtable->vgId, sizeof(pCtable->vgId));
+  SSuperTableVgroup *pVgroup = taosHashGet(pStable->vgHash, (char *)&pCtable->vgId, sizeof(pCtable->vgId));
+  if (pVgroup == NULL) {
+    SSuperTableVgroup vgroup = {.vgId = pCtable->vgId};
+    taosHashPut(pStable->vgHash, (char *)&pCtable->vgId, sizeof(pCtable->vgId), &vgroup, sizeof(vgroup));
+    pStable->vgVersion = mgmtNewVgListVersion();
+
+    pVgroup = taosHashGet(pStable->vgHash, (char *)&pCtable->vgId, sizeof(pCtable->vgId));
+    if (pVgroup == NULL) return;
+  }
+
+  pVgroup->numOfTables++;
+
+  // the filters are sent along with the vgroup list, so the list is changed once a new value is summarized, or a
+  // table without the summarized values makes the filters incomplete
+  bool changed = mgmtAddTagHashesIntoBloom(pStable, pCtable);
+  if (changed || pCtable->numOfTagHashes == 0) {
+    pStable->vgVersion = mgmtNewVgListVersion();
   }
 }
 
 static void mgmtRemoveTableFromStable(SSuperTableObj *pStable, SChildTableObj *pCtable) {
   pStable->numOfTables--;
 
+  if (pCtable->prev != NULL) pCtable->prev->next = pCtable->next;
+  if (pCtable->next != NULL) pCtable->next->prev = pCtable->prev;
+  if (pStable->pHead == pCtable) pStable->pHead = pCtable->next;
+  pCtable->prev = NULL;
+  pCtable->next = NULL;
+
+  mgmtUpdateTagValueCount(pStable, pCtable, -1);
+
   if (pStable->vgHash == NULL) return;
 
   SVgObj *pVgroup = mgmtGetVgroup(pCtable->vgId);
   if (pVgroup == NULL) {
     taosHashRemove(pStable->vgHash, (char *)&pCtable->vgId, sizeof(pCtable->vgId));
+    pStable->vgVersion = mgmtNewVgListVersion();
+    return;
   }
   mgmtDecVgroupRef(pVgroup);
+
+  // the values of the dropped tables are left in the bloom filter until they outnumber the remaining ones
+  SSuperTableVgroup *pStableVgroup = taosHashGet(pStable->vgHash, (char *)&pCtable->vgId, sizeof(pCtable->vgId));
+  if (pStableVgroup != NULL) {
+    pStableVgroup->numOfTables--;
+    pStableVgroup->numOfDropped++;
+
+    if (pStableVgroup->numOfDropped > pStableVgroup->numOfTables) {
+      mgmtRebuildVgroupTagBloom(pStable, pStableVgroup);
+      pStable->vgVersion = mgmtNewVgListVersion();
+    }
+  }
 }
 
 static void mgmtDestroySuperTable(SSuperTableObj *pStable) {
@@ -396,6 +551,11 @@ static void mgmtDestroySuperTable(SSuperTableObj *pStable) {
     taosHashCleanup(pStable->vgHash);
     pStable->vgHash = NULL;
   }
+  if (pStable->tagValueCount != NULL) {
+    taosHashCleanup(pStable->tagValueCount);
+    pStable->tagValueCount = NULL;
+  }
+  tfree(pStable->vgList);
   tfree(pStable->info.tableId);
   tfree(pStable->schema);
   tfree(pStable);
@@ -408,6 +568,8 @@ static int32_t mgmtSuperTableActionDestroy(SSdbOper *pOper) {
 
 static int32_t mgmtSuperTableActionInsert(SSdbOper *pOper) {
   SSuperTableObj *pStable = pOper->pObj;
+  pStable->vgVersion = mgmtNewVgListVersion();
+
   SDbObj *pDb = mgmtGetDbByTableId(pStable->info.tableId);
   if (pDb != NULL) {
     mgmtAddSuperTableIntoDb(pDb);
@@ -435,8 +597,14 @@ static int32_t mgmtSuperTableActionUpdate(SSdbOper *pOper) {
   if (pTable != pNew) {
     void *oldTableId = pTable->info.tableId;
     void *oldSchema = pTable->schema;
-    memcpy(pTable, pNew, pOper->rowSize);
+    void *oldVgList = pTable->vgList;
+    // only the fields written into sdb are replaced, the child tables and the vgroups are kept
+    pTable->info.tableId = pNew->info.tableId;
+    memcpy((char *)pTable + sizeof(char *), (char *)pNew + sizeof(char *), tsSuperTableUpdateSize);
     pTable->schema = pNew->schema;
+    pTable->vgList = NULL;
+    pTable->vgVersion = mgmtNewVgListVersion();
+    free(oldVgList);
     free(pNew->vgHash);
     free(pNew);
     free(oldTableId);
@@ -526,12 +694,15 @@ static int32_t mgmtInitSuperTables() {
     return -1;
   }
 
+  pthread_mutex_init(&tsSuperTableVgListMutex, NULL);
+
   mTrace("table:stables is created");
   return 0;
 }
 
 static void mgmtCleanUpSuperTables() {
   sdbCloseTable(tsSuperTableSdb);
+  pthread_mutex_destroy(&tsSuperTableVgListMutex);
 }
 
 int32_t mgmtInitTables() {
@@ -817,8 +988,8 @@ static void mgmtProcessDropSuperTableMsg(SQueuedMsg *pMsg) {
   if (pStable->numOfTables != 0) {
     SHashMutableIterator *pIter = taosHashCreateIter(pStable->vgHash);
     while (taosHashIterNext(pIter)) {
-      int32_t *pVgId = taosHashIterGet(pIter);
-      SVgObj *pVgroup = mgmtGetVgroup(*pVgId);
+      SSuperTableVgroup *pStableVgroup = taosHashIterGet(pIter);
+      SVgObj *pVgroup = mgmtGetVgroup(pStableVgroup->vgId);
       if (pVgroup == NULL) break;
 
       SMDDropSTableMsg *pDrop = rpcMallocCont(sizeof(SMDDropSTableMsg));
@@ -1206,7 +1377,9 @@ void mgmtDropAllSuperTables(SDbObj *pDropDb) {
     pIter = mgmtGetNextSuperTable(pIter, &pTable);
     if (pTable == NULL) break;
 
-    if (strncmp(pDropDb->name, pTable->info.tableId, dbNameLen) == 0) {
+    // the name of another db may begin with the name of the dropped db
+    if (strncmp(pDropDb->name, pTable->info.tableId, dbNameLen) == 0 &&
+        strncmp(pTable->info.tableId + dbNameLen, TS_PATH_DELIMITER, strlen(TS_PATH_DELIMITER)) == 0) {
       SSdbOper oper = {
         .type = SDB_OPER_LOCAL,
         .table = tsSuperTableSdb,
@@ -1239,9 +1412,8 @@ static int32_t mgmtSetSchemaFromSuperTable(SSchema *pSchema, SSuperTableObj *pTa
   return (pTable->numOfColumns + pTable->numOfTags) * sizeof(SSchema);
 }
 
-static void mgmtGetSuperTableMeta(SQueuedMsg *pMsg) {
+static void mgmtDoGetSuperTableMeta(SQueuedMsg *pMsg, STableMetaMsg *pMeta) {
   SSuperTableObj *pTable = (SSuperTableObj *)pMsg->pTable;
-  STableMetaMsg *pMeta   = rpcMallocCont(sizeof(STableMetaMsg) + sizeof(SSchema) * (TSDB_MAX_TAGS + TSDB_MAX_COLUMNS + 16));
   pMeta->uid          = htobe64(pTable->uid);
   pMeta->sversion     = htons(pTable->sversion);
   pMeta->tversion     = htons(pTable->tversion);
@@ -1252,6 +1424,18 @@ static void mgmtGetSuperTableMeta(SQueuedMsg *pMsg) {
   pMeta->contLen      = sizeof(STableMetaMsg) + mgmtSetSchemaFromSuperTable(pMeta->schema, pTable);
   strncpy(pMeta->tableId, pTable->info.tableId, TSDB_TABLE_ID_LEN);
 
+  mTrace("stable:%s, uid:%" PRIu64 " table meta is retrieved", pTable->info.tableId, pTable->uid);
+}
+
+static void mgmtGetSuperTableMeta(SQueuedMsg *pMsg) {
+  STableMetaMsg *pMeta = rpcMallocCont(sizeof(STableMetaMsg) + sizeof(SSchema) * (TSDB_MAX_TAGS + TSDB_MAX_COLUMNS + 16));
+  if (pMeta == NULL) {
+    mgmtSendSimpleResp(pMsg->thandle, TSDB_CODE_SERV_OUT_OF_MEMORY);
+    return;
+  }
+
+  mgmtDoGetSuperTableMeta(pMsg, pMeta);
+
   SRpcMsg rpcRsp = {
     .handle = pMsg->thandle, 
     .pCont = pMeta, 
@@ -1259,44 +1443,64 @@ static void mgmtGetSuperTableMeta(SQueuedMsg *pMsg) {
   };
   pMeta->contLen = htons(pMeta->contLen);
   rpcSendResponse(&rpcRsp);
+}
 
-  mTrace("stable:%s, uid:%" PRIu64 " table meta is retrieved", pTable->info.tableId, pTable->uid);
+/*
+ * Both versions are taken from the same sequence, so the larger one increases once either of them changes, and it is
+ * never given again, even after restart.
+ */
+static int64_t mgmtGetSuperTableVgListVersion(SSuperTableObj *pStable) {
+  return MAX(mgmtGetVgroupsVersion(), pStable->vgVersion);
 }
 
-static void mgmtProcessSuperTableVgroupMsg(SQueuedMsg *pMsg) {
-  SCMSTableVgroupMsg *pInfo = pMsg->pCont;
-  int32_t numOfTable = htonl(pInfo->numOfTables);
+// tags whose values of all child tables are summarized in the bloom filters
+static int32_t mgmtGetSummarizedTags(SSuperTableObj *pStable, int16_t *colIds) {
+  SSchema *pTagSchema = pStable->schema + pStable->numOfColumns;
+  int32_t  numOfTags = 0;
 
-  // reserve space
-  int32_t contLen = sizeof(SCMSTableVgroupRspMsg) + 32 * sizeof(SCMVgroupInfo) + sizeof(SVgroupsInfo); 
-  for (int32_t i = 0; i < numOfTable; ++i) {
-    char *stableName = (char*)pInfo + sizeof(SCMSTableVgroupMsg) + (TSDB_TABLE_ID_LEN) * i;
-    SSuperTableObj *pTable = mgmtGetSuperTable(stableName);
-    if (pTable->vgHash != NULL) {
-      contLen += (taosHashGetSize(pTable->vgHash) * sizeof(SCMVgroupInfo) + sizeof(SVgroupsInfo));
+  for (int32_t i = 0; i < pStable->numOfTags; ++i) {
+    int32_t *pCount = NULL;
+    if (pStable->tagValueCount != NULL) {
+      pCount = taosHashGet(pStable->tagValueCount, (char *)&pTagSchema[i].colId, sizeof(pTagSchema[i].colId));
+    }
+
+    if (pStable->numOfTables == 0 || (pCount != NULL && *pCount == pStable->numOfTables)) {
+      colIds[numOfTags++] = pTagSchema[i].colId;
     }
-    mgmtDecTableRef(pTable);
   }
 
-  SCMSTableVgroupRspMsg *pRsp = rpcMallocCont(contLen);
-  if (pRsp == NULL) {
-    mgmtSendSimpleResp(pMsg->thandle, TSDB_CODE_SERV_OUT_OF_MEMORY);
-    return;
+  return numOfTags;
+}
+
+// serialize the vgroups of the super table, unless the one built before is still valid
+static int32_t mgmtBuildSuperTableVgList(SSuperTableObj *pStable, int64_t version) {
+  if (pStable->vgList != NULL && pStable->vgListVersion == version) {
+    return TSDB_CODE_SUCCESS;
   }
 
-  pRsp->numOfTables = htonl(numOfTable);
-  char* msg = (char*) pRsp + sizeof(SCMSTableVgroupRspMsg);
+  int16_t colIds[TSDB_MAX_TAGS];
+  int32_t numOfTags = mgmtGetSummarizedTags(pStable, colIds);
 
-  for (int32_t i = 0; i < numOfTable; ++i) {
-    char *stableName = (char*)pInfo + sizeof(SCMSTableVgroupMsg) + (TSDB_TABLE_ID_LEN) * i;
-    SSuperTableObj *pTable = mgmtGetSuperTable(stableName);
-    SVgroupsInfo *pVgroupInfo = (SVgroupsInfo *)msg;
+  // the tag summary follows the vgroups, and the bloom filters follow the column ids of the summarized tags
+  int32_t       numOfVgroups = (pStable->vgHash == NULL) ? 0 : (int32_t)taosHashGetSize(pStable->vgHash);
+  int32_t       summarySize = sizeof(STagSummaryMsg) + numOfTags * sizeof(int16_t) + numOfVgroups * TSDB_TAG_BLOOM_SIZE;
+  SVgroupsInfo *pVgroupInfo = calloc(1, sizeof(SVgroupsInfo) + numOfVgroups * sizeof(SCMVgroupInfo) + summarySize);
+  if (pVgroupInfo == NULL) {
+    return TSDB_CODE_SERV_OUT_OF_MEMORY;
+  }
 
-    SHashMutableIterator *pIter = taosHashCreateIter(pTable->vgHash);
-    int32_t vgSize = 0;
-    while (taosHashIterNext(pIter)) {
-      int32_t *pVgId = taosHashIterGet(pIter);
-      SVgObj * pVgroup = mgmtGetVgroup(*pVgId);
+  uint8_t *blooms = malloc(numOfVgroups * TSDB_TAG_BLOOM_SIZE + 1);
+  if (blooms == NULL) {
+    free(pVgroupInfo);
+    return TSDB_CODE_SERV_OUT_OF_MEMORY;
+  }
+
+  int32_t vgSize = 0;
+  if (pStable->vgHash != NULL) {
+    SHashMutableIterator *pIter = taosHashCreateIter(pStable->vgHash);
+    while (taosHashIterNext(pIter) && vgSize < numOfVgroups) {
+      SSuperTableVgroup *pStableVgroup = taosHashIterGet(pIter);
+      SVgObj *           pVgroup = mgmtGetVgroup(pStableVgroup->vgId);
       if (pVgroup == NULL) continue;
 
       pVgroupInfo->vgroups[vgSize].vgId = htonl(pVgroup->vgId);
@@ -1310,18 +1514,108 @@ static void mgmtProcessSuperTableVgroupMsg(SQueuedMsg *pMsg) {
         pVgroupInfo->vgroups[vgSize].numOfIps++;
       }
 
+      memcpy(blooms + vgSize * TSDB_TAG_BLOOM_SIZE, pStableVgroup->bloom, TSDB_TAG_BLOOM_SIZE);
       vgSize++;
       mgmtDecVgroupRef(pVgroup);
     }
 
     taosHashDestroyIter(pIter);
+  }
+
+  pVgroupInfo->numOfVgroups = htonl(vgSize);
+
+  STagSummaryMsg *pSummary = (STagSummaryMsg *)&pVgroupInfo->vgroups[vgSize];
+  pSummary->numOfTags = htons(numOfTags);
+  for (int32_t i = 0; i < numOfTags; ++i) {
+    pSummary->colIds[i] = htons(colIds[i]);
+  }
+  memcpy(&pSummary->colIds[numOfTags], blooms, vgSize * TSDB_TAG_BLOOM_SIZE);
+  free(blooms);
+
+  tfree(pStable->vgList);
+  pStable->vgList = (char *)pVgroupInfo;
+  pStable->vgListLen = sizeof(SVgroupsInfo) + vgSize * sizeof(SCMVgroupInfo) + sizeof(STagSummaryMsg) +
+                       numOfTags * sizeof(int16_t) + vgSize * TSDB_TAG_BLOOM_SIZE;
+  pStable->vgListVersion = version;
+
+  mTrace("stable:%s, vgroup list is built, numOfVgroups:%d summarizedTags:%d version:%" PRIx64,
+         pStable->info.tableId, vgSize, numOfTags, version);
+  return TSDB_CODE_SUCCESS;
+}
+
+/*
+ * The vgroup list of a super table is kept serialized until the vgroups of the super table change, so it is copied
+ * into the response directly, and only the version is returned if the list cached by client is still valid.
+ */
+static void mgmtProcessSuperTableVgroupMsg(SQueuedMsg *pMsg) {
+  SCMSTableVgroupMsg * pInfo = pMsg->pCont;
+  SCMSTableVgroupInfo *pTables = (SCMSTableVgroupInfo *)((char *)pInfo + sizeof(SCMSTableVgroupMsg));
+  int32_t              numOfTable = htonl(pInfo->numOfTables);
+  int32_t              code = TSDB_CODE_SUCCESS;
+
+  if (numOfTable <= 0 ||
+      pMsg->contLen < (int32_t)(sizeof(SCMSTableVgroupMsg) + numOfTable * sizeof(SCMSTableVgroupInfo))) {
+    mgmtSendSimpleResp(pMsg->thandle, TSDB_CODE_INVALID_MSG_LEN);
+    return;
+  }
+
+  pthread_mutex_lock(&tsSuperTableVgListMutex);
+
+  int32_t contLen = sizeof(SCMSTableVgroupRspMsg);
+  for (int32_t i = 0; i < numOfTable; ++i) {
+    SSuperTableObj *pTable = mgmtGetSuperTable(pTables[i].tableId);
+    if (pTable == NULL) {
+      code = TSDB_CODE_INVALID_TABLE_ID;
+      break;
+    }
+
+    int64_t version = mgmtGetSuperTableVgListVersion(pTable);
+    if (version == (int64_t)htobe64(pTables[i].version)) {
+      contLen += sizeof(int64_t) + sizeof(SVgroupsInfo);
+    } else if ((code = mgmtBuildSuperTableVgList(pTable, version)) == TSDB_CODE_SUCCESS) {
+      contLen += sizeof(int64_t) + pTable->vgListLen;
+    }
 
-    pVgroupInfo->numOfVgroups = htonl(vgSize);
+    mgmtDecTableRef(pTable);
+    if (code != TSDB_CODE_SUCCESS) break;
+  }
 
-    // one table is done, try the next table
-    msg += sizeof(SVgroupsInfo) + vgSize * sizeof(SCMVgroupInfo);
+  SCMSTableVgroupRspMsg *pRsp = NULL;
+  if (code == TSDB_CODE_SUCCESS) {
+    pRsp = rpcMallocCont(contLen);
+    if (pRsp == NULL) code = TSDB_CODE_SERV_OUT_OF_MEMORY;
+  }
+
+  if (code != TSDB_CODE_SUCCESS) {
+    pthread_mutex_unlock(&tsSuperTableVgListMutex);
+    mgmtSendSimpleResp(pMsg->thandle, code);
+    return;
   }
 
+  pRsp->numOfTables = htonl(numOfTable);
+  char *msg = (char *)pRsp + sizeof(SCMSTableVgroupRspMsg);
+
+  // the tables do not change while the read lock of sdb is held, and the lists are protected by the mutex
+  for (int32_t i = 0; i < numOfTable; ++i) {
+    SSuperTableObj *pTable = mgmtGetSuperTable(pTables[i].tableId);
+    int64_t         version = mgmtGetSuperTableVgListVersion(pTable);
+
+    *(int64_t *)msg = htobe64(version);
+    msg += sizeof(int64_t);
+
+    if (version == (int64_t)htobe64(pTables[i].version)) {
+      ((SVgroupsInfo *)msg)->numOfVgroups = htonl(TSDB_VGROUP_LIST_UNCHANGED);
+      msg += sizeof(SVgroupsInfo);
+    } else {
+      memcpy(msg, pTable->vgList, pTable->vgListLen);
+      msg += pTable->vgListLen;
+    }
+
+    mgmtDecTableRef(pTable);
+  }
+
+  pthread_mutex_unlock(&tsSuperTableVgListMutex);
+
   SRpcMsg rpcRsp = {0};
   rpcRsp.handle = pMsg->thandle;
   rpcRsp.pCont = pRsp;
@@ -1434,6 +1728,7 @@ static SChildTableObj* mgmtDoCreateChildTable(SCMCreateTableMsg *pCreate, SVgObj
     pTable->uid  = (((uint64_t)pTable->vgId) << 40) + ((((uint64_t)pTable->sid) & ((1ul << 24) - 1ul)) << 16) +
                   (sdbGetVersion() & ((1ul << 16) - 1ul));
     pTable->superTable = pSuperTable;
+    mgmtSetChildTableTagHashes(pTable, pSuperTable, pTagData);
   } else {
     pTable->uid          = (((uint64_t) pTable->createdTime) << 16) + (sdbGetVersion() & ((1ul << 16) - 1ul));
     pTable->sversion     = 0;
@@ -1477,6 +1772,7 @@ static SChildTableObj* mgmtDoCreateChildTable(SCMCreateTableMsg *pCreate, SVgObj
   desc.table = tsChildTableSdb;
   
   if (sdbInsertRow(&desc) != TSDB_CODE_SUCCESS) {
+    tfree(pTable->tagHashes);
     free(pTable);
     mError("table:%s, update sdb error", pCreate->tableId);
     terrno = TSDB_CODE_SDB_ERROR;
@@ -1588,8 +1884,140 @@ static void mgmtProcessDropChildTableMsg(SQueuedMsg *pMsg) {
   dnodeSendMsgToDnode(&ipSet, &rpcMsg);
 }
 
-static int32_t mgmtModifyChildTableTagValue(SChildTableObj *pTable, char *tagName, char *nContent) {
-  return TSDB_CODE_OPS_NOT_SUPPORT;
+// the tag value of the child table in vnode is updated by a create table msg carrying only the tag to update
+static void *mgmtBuildAlterChildTableTagMsg(SChildTableObj *pTable, int32_t tag, char *tagVal) {
+  SSuperTableObj *pStable = pTable->superTable;
+  SSchema *       pTagSchema = pStable->schema + pStable->numOfColumns + tag;
+  int32_t         totalCols = pStable->numOfColumns + 1;
+  int32_t         contLen = sizeof(SMDCreateTableMsg) + totalCols * sizeof(SSchema) + pTagSchema->bytes;
+
+  SMDCreateTableMsg *pAlter = rpcMallocCont(contLen);
+  if (pAlter == NULL) {
+    terrno = TSDB_CODE_SERV_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  mgmtExtractTableName(pTable->info.tableId, pAlter->tableId);
+  mgmtExtractTableName(pStable->info.tableId, pAlter->superTableId);
+  pAlter->contLen       = htonl(contLen);
+  pAlter->vgId          = htonl(pTable->vgId);
+  pAlter->tableType     = pTable->info.type;
+  pAlter->createdTime   = htobe64(pTable->createdTime);
+  pAlter->sid           = htonl(pTable->sid);
+  pAlter->sqlDataLen    = 0;
+  pAlter->uid           = htobe64(pTable->uid);
+  pAlter->numOfColumns  = htons(pStable->numOfColumns);
+  pAlter->numOfTags     = htons(1);
+  pAlter->sversion      = htonl(pStable->sversion);
+  pAlter->tversion      = htonl(pStable->tversion);
+  pAlter->tagDataLen    = htonl(pTagSchema->bytes);
+  pAlter->superTableUid = htobe64(pStable->uid);
+
+  SSchema *pSchema = (SSchema *) pAlter->data;
+  memcpy(pSchema, pStable->schema, pStable->numOfColumns * sizeof(SSchema));
+  memcpy(pSchema + pStable->numOfColumns, pTagSchema, sizeof(SSchema));
+  for (int32_t col = 0; col < totalCols; ++col) {
+    pSchema[col].bytes = htons(pSchema[col].bytes);
+    pSchema[col].colId = htons(pSchema[col].colId);
+  }
+
+  memcpy(pAlter->data + totalCols * sizeof(SSchema), tagVal, pTagSchema->bytes);
+  return pAlter;
+}
+
+// the new value is summarized in the tag bloom filter before it is set in vnode, so the vgroup is not skipped by the
+// queries on it, and the hash of the table is updated after, since the filter is rebuilt from the hashes
+static int32_t mgmtModifyChildTableTagValue(SQueuedMsg *pMsg, SChildTableObj *pTable, char *tagName, char *tagVal,
+                                            int32_t tagValLen) {
+  if (pTable->info.type != TSDB_CHILD_TABLE) {
+    mError("table:%s, set tag value, not a child table", pTable->info.tableId);
+    return TSDB_CODE_INVALID_TABLE_TYPE;
+  }
+
+  SSuperTableObj *pStable = pTable->superTable;
+  int32_t         tag = mgmtFindSuperTableTagIndex(pStable, tagName);
+  if (tag < 0) {
+    mError("table:%s, set tag value, tag:%s not exist", pTable->info.tableId, tagName);
+    return TSDB_CODE_TAG_NOT_EXIST;
+  }
+
+  SSchema *pTagSchema = pStable->schema + pStable->numOfColumns + tag;
+  if (tagValLen != pTagSchema->bytes) {
+    mError("table:%s, set tag value, tag:%s bytes:%d, value length:%d", pTable->info.tableId, tagName,
+           pTagSchema->bytes, tagValLen);
+    return TSDB_CODE_INVALID_VALUE;
+  }
+
+  if (pMsg->pVgroup == NULL) pMsg->pVgroup = mgmtGetVgroup(pTable->vgId);
+  if (pMsg->pVgroup == NULL) {
+    mError("table:%s, set tag value, vgroup not exist", pTable->info.tableId);
+    return TSDB_CODE_INVALID_VGROUP_ID;
+  }
+
+  SMDCreateTableMsg *pAlter = mgmtBuildAlterChildTableTagMsg(pTable, tag, tagVal);
+  if (pAlter == NULL) {
+    return terrno;
+  }
+
+  if (tTagValueHashable(pTagSchema->type) && pStable->vgHash != NULL) {
+    uint32_t           hash = tTagValueHash(pTagSchema->colId, pTagSchema->type, tagVal);
+    SSuperTableVgroup *pVgroup = taosHashGet(pStable->vgHash, (char *)&pTable->vgId, sizeof(pTable->vgId));
+    if (pVgroup != NULL && tTagBloomAdd(pVgroup->bloom, hash)) {
+      pStable->vgVersion = mgmtNewVgListVersion();
+    }
+  }
+
+  SRpcIpSet ipSet = mgmtGetIpSetFromVgroup(pMsg->pVgroup);
+
+  mPrint("table:%s, send alter ctable msg to set tag:%s", pTable->info.tableId, tagName);
+  SQueuedMsg *newMsg = mgmtCloneQueuedMsg(pMsg);
+  newMsg->ahandle = pTable;
+  newMsg->pTable = pMsg->pTable;
+  pMsg->pTable = NULL;
+  SRpcMsg rpcMsg = {
+    .handle  = newMsg,
+    .pCont   = pAlter,
+    .contLen = ntohl(pAlter->contLen),
+    .code    = 0,
+    .msgType = TSDB_MSG_TYPE_MD_ALTER_TABLE
+  };
+
+  dnodeSendMsgToDnode(&ipSet, &rpcMsg);
+  return TSDB_CODE_ACTION_IN_PROGRESS;
+}
+
+static int32_t mgmtUpdateChildTableTagHash(SChildTableObj *pTable, char *tagName, char *tagVal) {
+  SSuperTableObj *pStable = pTable->superTable;
+  int32_t         tag = mgmtFindSuperTableTagIndex(pStable, tagName);
+  if (tag < 0) return TSDB_CODE_TAG_NOT_EXIST;
+
+  SSchema *pTagSchema = pStable->schema + pStable->numOfColumns + tag;
+  bool     changed = false;
+  for (int32_t i = 0; i < pTable->numOfTagHashes; ++i) {
+    if (pTable->tagHashes[i].colId == pTagSchema->colId) {
+      pTable->tagHashes[i].hash = tTagValueHash(pTagSchema->colId, pTagSchema->type, tagVal);
+      changed = true;
+    }
+  }
+
+  if (!changed) return TSDB_CODE_SUCCESS;
+
+  // the filter may be rebuilt from the old hash while the value is being set in vnode
+  if (mgmtAddTagHashesIntoBloom(pStable, pTable)) {
+    pStable->vgVersion = mgmtNewVgListVersion();
+  }
+
+  SSdbOper oper = {
+    .type = SDB_OPER_GLOBAL,
+    .table = tsChildTableSdb,
+    .pObj = pTable
+  };
+
+  if (sdbUpdateRow(&oper) != TSDB_CODE_SUCCESS) {
+    return TSDB_CODE_SDB_ERROR;
+  }
+
+  return TSDB_CODE_SUCCESS;
 }
 
 static int32_t mgmtFindNormalTableColumnIndex(SChildTableObj *pTable, char *colName) {
@@ -1787,89 +2215,80 @@ static void mgmtGetChildTableMeta(SQueuedMsg *pMsg) {
   rpcSendResponse(&rpcRsp);
 }
 
-void mgmtDropAllChildTablesInVgroups(SVgObj *pVgroup) {
-  void *  pIter = NULL;
+static int32_t mgmtDropChildTablesInVgroup(SVgObj *pVgroup) {
   int32_t numOfTables = 0;
-  SChildTableObj *pTable = NULL;
-
-  mPrint("vgId:%d, all child tables will be dropped from sdb", pVgroup->vgId);
+  int32_t maxTables = taosIdPoolMaxSize(pVgroup->idPool);
 
-  while (1) {
-    pIter = mgmtGetNextChildTable(pIter, &pTable);
-    if (pTable == NULL) break;
+  for (int32_t sid = 1; sid <= maxTables && pVgroup->numOfTables > 0; ++sid) {
+    SChildTableObj *pTable = pVgroup->tableList[sid - 1];
+    if (pTable == NULL) continue;
 
-    if (pTable->vgId == pVgroup->vgId) {
-      SSdbOper oper = {
-        .type = SDB_OPER_LOCAL,
-        .table = tsChildTableSdb,
-        .pObj = pTable,
-      };
-      sdbDeleteRow(&oper);
-      numOfTables++;
-    }
-    mgmtDecTableRef(pTable);
+    SSdbOper oper = {
+      .type = SDB_OPER_LOCAL,
+      .table = tsChildTableSdb,
+      .pObj = pTable,
+    };
+    sdbDeleteRow(&oper);
+    numOfTables++;
   }
 
-  sdbFreeIter(pIter);
+  return numOfTables;
+}
+
+void mgmtDropAllChildTablesInVgroups(SVgObj *pVgroup) {
+  mPrint("vgId:%d, all child tables will be dropped from sdb", pVgroup->vgId);
+
+  int32_t numOfTables = mgmtDropChildTablesInVgroup(pVgroup);
 
-  mPrint("vgId:%d, all child tables is dropped from sdb", pVgroup->vgId);
+  mPrint("vgId:%d, all child tables:%d is dropped from sdb", pVgroup->vgId, numOfTables);
 }
 
 void mgmtDropAllChildTables(SDbObj *pDropDb) {
-  void *  pIter = NULL;
   int32_t numOfTables = 0;
-  int32_t dbNameLen = strlen(pDropDb->name);
-  SChildTableObj *pTable = NULL;
+  int32_t numOfVgroups = 0;
 
   mPrint("db:%s, all child tables will be dropped from sdb", pDropDb->name);
 
-  while (1) {
-    pIter = mgmtGetNextChildTable(pIter, &pTable);
-    if (pTable == NULL) break;
+  // removing tables moves the vgroup to the head of the list, so take a snapshot of the list first
+  SVgObj **pVgroups = calloc(pDropDb->numOfVgroups + 1, sizeof(SVgObj *));
+  if (pVgroups == NULL) {
+    mError("db:%s, failed to drop child tables, no enough memory", pDropDb->name);
+    return;
+  }
 
-    if (strncmp(pDropDb->name, pTable->info.tableId, dbNameLen) == 0) {
-      SSdbOper oper = {
-        .type = SDB_OPER_LOCAL,
-        .table = tsChildTableSdb,
-        .pObj = pTable,
-      };
-      sdbDeleteRow(&oper);
-      numOfTables++;
-    }
-    mgmtDecTableRef(pTable);
+  for (SVgObj *pVgroup = pDropDb->pHead; pVgroup != NULL && numOfVgroups <= pDropDb->numOfVgroups; pVgroup = pVgroup->next) {
+    pVgroups[numOfVgroups++] = pVgroup;
   }
 
-  sdbFreeIter(pIter);
+  for (int32_t i = 0; i < numOfVgroups; ++i) {
+    numOfTables += mgmtDropChildTablesInVgroup(pVgroups[i]);
+  }
+
+  free(pVgroups);
 
   mPrint("db:%s, all child tables:%d is dropped from sdb", pDropDb->name, numOfTables);
 }
 
 static void mgmtDropAllChildTablesInStable(SSuperTableObj *pStable) {
-  void *  pIter = NULL;
   int32_t numOfTables = 0;
-  SChildTableObj *pTable = NULL;
 
-  mPrint("stable:%s, all child tables will dropped from sdb", pStable->info.tableId, numOfTables);
+  mPrint("stable:%s, all child tables will dropped from sdb", pStable->info.tableId);
 
-  while (1) {
-    pIter = mgmtGetNextChildTable(pIter, &pTable);
-    if (pTable == NULL) break;
+  SChildTableObj *pTable = pStable->pHead;
+  while (pTable != NULL) {
+    SChildTableObj *pNext = pTable->next;  // the table is removed from the list when it is deleted
 
-    if (pTable->superTable == pStable) {
-      SSdbOper oper = {
-        .type = SDB_OPER_LOCAL,
-        .table = tsChildTableSdb,
-        .pObj = pTable,
-      };
-      sdbDeleteRow(&oper);
-      numOfTables++;
-    }
+    SSdbOper oper = {
+      .type = SDB_OPER_LOCAL,
+      .table = tsChildTableSdb,
+      .pObj = pTable,
+    };
+    sdbDeleteRow(&oper);
+    numOfTables++;
 
-    mgmtDecTableRef(pTable);
+    pTable = pNext;
   }
 
-  sdbFreeIter(pIter);
-
   mPrint("stable:%s, all child tables:%d is dropped from sdb", pStable->info.tableId, numOfTables);
 }
 
@@ -2015,11 +2434,35 @@ static void mgmtProcessCreateChildTableRsp(SRpcMsg *rpcMsg) {
   }
 }
 
-// not implemented yet
 static void mgmtProcessAlterTableRsp(SRpcMsg *rpcMsg) {
-  mTrace("alter table rsp received, handle:%p code:%s", rpcMsg->handle, tstrerror(rpcMsg->code));
+  if (rpcMsg->handle == NULL) return;
+
+  SQueuedMsg *queueMsg = rpcMsg->handle;
+  queueMsg->received++;
+
+  SChildTableObj *pTable = queueMsg->ahandle;
+  mPrint("table:%s, alter table rsp received, thandle:%p result:%s", pTable->info.tableId, queueMsg->thandle,
+         tstrerror(rpcMsg->code));
+
+  int32_t code = rpcMsg->code;
+  if (code != TSDB_CODE_SUCCESS) {
+    mError("table:%s, failed to alter in dnode, reason:%s", pTable->info.tableId, tstrerror(code));
+  } else {
+    // the alter msg is kept in host order since it is processed
+    SCMAlterTableMsg *pAlter = queueMsg->pCont;
+    sdbWriteLock();
+    code = mgmtUpdateChildTableTagHash(pTable, pAlter->schema[0].name, (char *)(pAlter->schema + pAlter->numOfCols));
+    sdbWriteUnLock();
+  }
+
+  mgmtSendSimpleResp(queueMsg->thandle, code);
+  mgmtFreeQueuedMsg(queueMsg);
 }
 
+/*
+ * The table ids are kept one after another in the request, each of which takes TSDB_TABLE_ID_LEN bytes. The table
+ * meta of the tables that do not exist are skipped in the response, and they are created by the client one by one.
+ */
 static void mgmtProcessMultiTableMetaMsg(SQueuedMsg *pMsg) {
   SCMMultiTableInfoMsg *pInfo = pMsg->pCont;
   pInfo->numOfTables = htonl(pInfo->numOfTables);
@@ -2035,45 +2478,59 @@ static void mgmtProcessMultiTableMetaMsg(SQueuedMsg *pMsg) {
   pMultiMeta->numOfTables = 0;
 
   for (int32_t t = 0; t < pInfo->numOfTables; ++t) {
-    char * tableId = (char *)(pInfo->tableIds + t * TSDB_TABLE_ID_LEN + 1);
-    SChildTableObj *pTable = mgmtGetChildTable(tableId);
-    if (pTable == NULL) continue;
-
-    if (pMsg->pDb == NULL) pMsg->pDb = mgmtGetDbByTableId(tableId);
-    if (pMsg->pDb == NULL) {
-      mgmtDecTableRef(pTable);
-      continue;
-    }
-
-    int availLen = totalMallocLen - pMultiMeta->contLen;
+    int32_t availLen = totalMallocLen - pMultiMeta->contLen;
     if (availLen <= sizeof(STableMetaMsg) + sizeof(SSchema) * (TSDB_MAX_TAGS + TSDB_MAX_COLUMNS + 16)) {
       totalMallocLen *= 2;
-      pMultiMeta = rpcReallocCont(pMultiMeta, totalMallocLen);
-      if (pMultiMeta == NULL) {
+      SMultiTableMeta *pNew = rpcReallocCont(pMultiMeta, totalMallocLen);
+      if (pNew == NULL) {
+        rpcFreeCont(pMultiMeta);
         mgmtSendSimpleResp(pMsg->thandle, TSDB_CODE_SERV_OUT_OF_MEMORY);
-        mgmtDecTableRef(pTable);
         return;
-      } else {
-        t--;
-        mgmtDecTableRef(pTable);
-        continue;
       }
+      pMultiMeta = pNew;
     }
 
-    STableMetaMsg *pMeta = (STableMetaMsg *)(pMultiMeta->metas + pMultiMeta->contLen);
-    int32_t code = mgmtDoGetChildTableMeta(pMsg, pMeta);
-    if (code == TSDB_CODE_SUCCESS) {
-      pMultiMeta->numOfTables ++;
-      pMultiMeta->contLen += pMeta->contLen;
+    // the table, db and vgroup of the previous table are released before getting the next one
+    if (pMsg->pTable != NULL) mgmtDecTableRef(pMsg->pTable);
+    if (pMsg->pDb != NULL) mgmtDecDbRef(pMsg->pDb);
+    if (pMsg->pVgroup != NULL) mgmtDecVgroupRef(pMsg->pVgroup);
+    pMsg->pTable = NULL;
+    pMsg->pDb = NULL;
+    pMsg->pVgroup = NULL;
+
+    char tableId[TSDB_TABLE_ID_LEN + 1] = {0};
+    strncpy(tableId, pInfo->tableIds + t * TSDB_TABLE_ID_LEN, TSDB_TABLE_ID_LEN);
+
+    pMsg->pDb = mgmtGetDbByTableId(tableId);
+    if (pMsg->pDb == NULL || pMsg->pDb->status != TSDB_DB_STATUS_READY) continue;
+
+    pMsg->pTable = mgmtGetTable(tableId);
+    if (pMsg->pTable == NULL) continue;
+
+    STableMetaMsg *pMeta = (STableMetaMsg *)((char *)pMultiMeta + pMultiMeta->contLen);
+    memset(pMeta, 0, sizeof(STableMetaMsg));
+    if (pMsg->pTable->type == TSDB_SUPER_TABLE) {
+      mgmtDoGetSuperTableMeta(pMsg, pMeta);
+    } else if (mgmtDoGetChildTableMeta(pMsg, pMeta) != TSDB_CODE_SUCCESS) {
+      continue;
     }
 
-    mgmtDecTableRef(pTable);
+    // the layout of each table meta is the same as the response of a single table
+    int32_t contLen = pMeta->contLen;
+    pMeta->contLen = htons(pMeta->contLen);
+    pMultiMeta->contLen += contLen;
+    pMultiMeta->numOfTables++;
   }
 
+  mTrace("multi table meta msg is received from thandle:%p, tables:%d, retrieved:%d", pMsg->thandle,
+         pInfo->numOfTables, pMultiMeta->numOfTables);
+
   SRpcMsg rpcRsp = {0};
   rpcRsp.handle = pMsg->thandle;
   rpcRsp.pCont = pMultiMeta;
   rpcRsp.contLen = pMultiMeta->contLen;
+  pMultiMeta->numOfTables = htonl(pMultiMeta->numOfTables);
+  pMultiMeta->contLen = htonl(pMultiMeta->contLen);
   rpcSendResponse(&rpcRsp);
 }
 
@@ -2131,6 +2588,18 @@ static void mgmtVacuumResult(char *data, int32_t numOfCols, int32_t rows, int32_
   }
 }
 
+// Get the vgroup of the db with the smallest vgId not less than vgId. The vgroup list is reordered when tables are
+// created or dropped, so it can not be used as the position of show tables directly.
+static SVgObj *mgmtGetNextVgroupOfDb(SDbObj *pDb, int32_t vgId) {
+  SVgObj *pNext = NULL;
+  for (SVgObj *pVgroup = pDb->pHead; pVgroup != NULL; pVgroup = pVgroup->next) {
+    if ((int32_t)pVgroup->vgId >= vgId && (pNext == NULL || pVgroup->vgId < pNext->vgId)) {
+      pNext = pVgroup;
+    }
+  }
+  return pNext;
+}
+
 static int32_t mgmtRetrieveShowTables(SShowObj *pShow, char *data, int32_t rows, void *pConn) {
   SDbObj *pDb = mgmtGetDb(pShow->db);
   if (pDb == NULL) return 0;
@@ -2139,63 +2608,67 @@ static int32_t mgmtRetrieveShowTables(SShowObj *pShow, char *data, int32_t rows,
   SChildTableObj *pTable = NULL;
   SPatternCompareInfo info = PATTERN_COMPARE_INFO_INITIALIZER;
 
-  char prefix[64] = {0};
-  strcpy(prefix, pDb->name);
-  strcat(prefix, TS_PATH_DELIMITER);
-  int32_t prefixLen = strlen(prefix);
-
+  // only the vgroups of the db are visited, the tables are read in the order of vgId and sid
   while (numOfRows < rows) {
-    pShow->pIter = mgmtGetNextChildTable(pShow->pIter, &pTable);
-    if (pTable == NULL) break;
+    SVgObj *pVgroup = mgmtGetNextVgroupOfDb(pDb, pShow->vgId);
+    if (pVgroup == NULL) break;
 
-    // not belong to current db
-    if (strncmp(pTable->info.tableId, prefix, prefixLen)) {
-      mgmtDecTableRef(pTable);
-      continue;
+    if ((int32_t)pVgroup->vgId != pShow->vgId) {
+      pShow->vgId = pVgroup->vgId;
+      pShow->sid = 0;
     }
 
-    char tableName[TSDB_TABLE_NAME_LEN + 1] = {0};
-    
-    // pattern compare for table name
-    mgmtExtractTableName(pTable->info.tableId, tableName);
+    int32_t maxTables = taosIdPoolMaxSize(pVgroup->idPool);
+    for (; pShow->sid < maxTables && numOfRows < rows; pShow->sid++) {
+      pTable = pVgroup->tableList[pShow->sid];
+      if (pTable == NULL) continue;
 
-    if (pShow->payloadLen > 0 && patternMatch(pShow->payload, tableName, TSDB_TABLE_NAME_LEN, &info) != TSDB_PATTERN_MATCH) {
-      mgmtDecTableRef(pTable);
-      continue;
-    }
+      char tableName[TSDB_TABLE_NAME_LEN + 1] = {0};
+      
+      // pattern compare for table name
+      mgmtExtractTableName(pTable->info.tableId, tableName);
 
-    int32_t cols = 0;
+      if (pShow->payloadLen > 0 && patternMatch(pShow->payload, tableName, TSDB_TABLE_NAME_LEN, &info) != TSDB_PATTERN_MATCH) {
+        continue;
+      }
 
-    char *pWrite = data + pShow->offset[cols] * rows + pShow->bytes[cols] * numOfRows;
+      int32_t cols = 0;
 
-    STR_WITH_MAXSIZE_TO_VARSTR(pWrite, tableName, TSDB_TABLE_NAME_LEN);
-    cols++;
+      char *pWrite = data + pShow->offset[cols] * rows + pShow->bytes[cols] * numOfRows;
 
-    pWrite = data + pShow->offset[cols] * rows + pShow->bytes[cols] * numOfRows;
-    *(int64_t *) pWrite = pTable->createdTime;
-    cols++;
+      STR_WITH_MAXSIZE_TO_VARSTR(pWrite, tableName, TSDB_TABLE_NAME_LEN);
+      cols++;
 
-    pWrite = data + pShow->offset[cols] * rows + pShow->bytes[cols] * numOfRows;
-    if (pTable->info.type == TSDB_CHILD_TABLE) {
-      *(int16_t *)pWrite = pTable->superTable->numOfColumns;
-    } else {
-      *(int16_t *)pWrite = pTable->numOfColumns;
-    }
+      pWrite = data + pShow->offset[cols] * rows + pShow->bytes[cols] * numOfRows;
+      *(int64_t *) pWrite = pTable->createdTime;
+      cols++;
 
-    cols++;
+      pWrite = data + pShow->offset[cols] * rows + pShow->bytes[cols] * numOfRows;
+      if (pTable->info.type == TSDB_CHILD_TABLE) {
+        *(int16_t *)pWrite = pTable->superTable->numOfColumns;
+      } else {
+        *(int16_t *)pWrite = pTable->numOfColumns;
+      }
 
-    pWrite = data + pShow->offset[cols] * rows + pShow->bytes[cols] * numOfRows;
-    
-    memset(tableName, 0, tListLen(tableName));
-    if (pTable->info.type == TSDB_CHILD_TABLE) {
-      mgmtExtractTableName(pTable->superTable->info.tableId, tableName);
-      STR_WITH_MAXSIZE_TO_VARSTR(pWrite, tableName, TSDB_TABLE_NAME_LEN);
+      cols++;
+
+      pWrite = data + pShow->offset[cols] * rows + pShow->bytes[cols] * numOfRows;
+      
+      memset(tableName, 0, tListLen(tableName));
+      if (pTable->info.type == TSDB_CHILD_TABLE) {
+        mgmtExtractTableName(pTable->superTable->info.tableId, tableName);
+        STR_WITH_MAXSIZE_TO_VARSTR(pWrite, tableName, TSDB_TABLE_NAME_LEN);
+      }
+      
+      cols++;
+
+      numOfRows++;
     }
-    
-    cols++;
 
-    numOfRows++;
-    mgmtDecTableRef(pTable);
+    if (pShow->sid >= maxTables) {
+      pShow->vgId++;
+      pShow->sid = 0;
+    }
   }
 
   pShow->numOfReads += numOfRows;
@@ -2245,7 +2718,9 @@ static void mgmtProcessAlterTableMsg(SQueuedMsg *pMsg) {
     pAlter->schema[i].bytes = htons(pAlter->schema[i].bytes);
   }
 
+  // the schema and tags are changed in place, the read only requests serializing them are kept out by the write lock
   int32_t code = TSDB_CODE_OPS_NOT_SUPPORT;
+  sdbWriteLock();
   if (pMsg->pTable->type == TSDB_SUPER_TABLE) {
     SSuperTableObj *pTable = (SSuperTableObj *)pMsg->pTable;
     mTrace("table:%s, start to alter stable", pAlter->tableId);
@@ -2266,7 +2741,7 @@ static void mgmtProcessAlterTableMsg(SQueuedMsg *pMsg) {
     SChildTableObj *pTable = (SChildTableObj *)pMsg->pTable;
     if (pAlter->type == TSDB_ALTER_TABLE_UPDATE_TAG_VAL) {
       char *tagVal = (char*)(pAlter->schema + pAlter->numOfCols);
-      code = mgmtModifyChildTableTagValue(pTable, pAlter->schema[0].name, tagVal);
+      code = mgmtModifyChildTableTagValue(pMsg, pTable, pAlter->schema[0].name, tagVal, pAlter->tagValLen);
     } else if (pAlter->type == TSDB_ALTER_TABLE_ADD_COLUMN) {
       code = mgmtAddNormalTableColumn(pMsg->pDb, pTable, pAlter->schema, 1);
     } else if (pAlter->type == TSDB_ALTER_TABLE_DROP_COLUMN) {
@@ -2274,6 +2749,10 @@ static void mgmtProcessAlterTableMsg(SQueuedMsg *pMsg) {
     } else {
     }
   }
+  sdbWriteUnLock();
 
-  mgmtSendSimpleResp(pMsg->thandle, code);
+  // the response is sent once the tag value is set in vnode
+  if (code != TSDB_CODE_ACTION_IN_PROGRESS) {
+    mgmtSendSimpleResp(pMsg->thandle, code);
+  }
 }
@@ -38,6 +38,8 @@
 
 static void   *tsVgroupSdb = NULL;
 static int32_t tsVgUpdateSize = 0;
+static int64_t tsVgVersionSeq = 0;    // source of the versions of vgroup lists, never reused even after restart
+static int64_t tsVgroupsVersion = 0;  // changed once a vgroup is created, dropped or updated
 
 static int32_t mgmtGetVgroupMeta(STableMetaMsg *pMeta, SShowObj *pShow, void *pConn);
 static int32_t mgmtRetrieveVgroups(SShowObj *pShow, char *data, int32_t rows, void *pConn);
@@ -97,6 +99,7 @@ static int32_t mgmtVgroupActionInsert(SSdbOper *pOper) {
   }
 
   mgmtAddVgroupIntoDb(pVgroup);
+  atomic_store_64(&tsVgroupsVersion, mgmtNewVgListVersion());
 
   return TSDB_CODE_SUCCESS;
 }
@@ -118,6 +121,7 @@ static int32_t mgmtVgroupActionDelete(SSdbOper *pOper) {
     mgmtDecDnodeRef(pDnode);
   }
 
+  atomic_store_64(&tsVgroupsVersion, mgmtNewVgListVersion());
   return TSDB_CODE_SUCCESS;
 }
 
@@ -161,6 +165,7 @@ static int32_t mgmtVgroupActionUpdate(SSdbOper *pOper) {
   }
 
   mgmtVgroupUpdateIdPool(pVgroup);
+  atomic_store_64(&tsVgroupsVersion, mgmtNewVgListVersion());
 
   mgmtDecVgroupRef(pVgroup);
 
@@ -198,6 +203,11 @@ int32_t mgmtInitVgroups() {
   SVgObj tObj;
   tsVgUpdateSize = (int8_t *)tObj.updateEnd - (int8_t *)&tObj;
 
+  // the versions are seeded by the time in microseconds, so they are larger than the ones given before restart, and
+  // the vgroups cached by clients are revalidated
+  tsVgVersionSeq = taosGetTimestampUs();
+  tsVgroupsVersion = tsVgVersionSeq;
+
   SSdbTableDesc tableDesc = {
     .tableId      = SDB_TABLE_VGROUP,
     .tableName    = "vgroups",
@@ -243,6 +253,14 @@ SVgObj *mgmtGetVgroup(int32_t vgId) {
   return (SVgObj *)sdbGetRow(tsVgroupSdb, &vgId);
 }
 
+int64_t mgmtGetVgroupsVersion() {
+  return atomic_load_64(&tsVgroupsVersion);
+}
+
+int64_t mgmtNewVgListVersion() {
+  return atomic_add_fetch_64(&tsVgVersionSeq, 1);
+}
+
 void mgmtUpdateVgroup(SVgObj *pVgroup) {
   SSdbOper oper = {
     .type = SDB_OPER_GLOBAL,
@@ -254,7 +272,9 @@ void mgmtUpdateVgroup(SVgObj *pVgroup) {
   mgmtSendCreateVgroupMsg(pVgroup, NULL);
 }
 
-void mgmtUpdateVgroupStatus(SVgObj *pVgroup, SDnodeObj *pDnode, SVnodeLoad *pVload) {
+// return false if the vnode does not match the vgroup, a msg is sent to fix it and the vnode is checked once again
+// in the next status msg
+bool mgmtUpdateVgroupStatus(SVgObj *pVgroup, SDnodeObj *pDnode, SVnodeLoad *pVload) {
   bool dnodeExist = false;
   for (int32_t i = 0; i < pVgroup->numOfVnodes; ++i) {
     SVnodeGid *pVgid = &pVgroup->vnodeGid[i];
@@ -272,7 +292,7 @@ void mgmtUpdateVgroupStatus(SVgObj *pVgroup, SDnodeObj *pDnode, SVnodeLoad *pVlo
     SRpcIpSet ipSet = mgmtGetIpSetFromIp(pDnode->dnodeEp);
     mError("vgId:%d, dnode:%d not exist in mnode, drop it", pVload->vgId, pDnode->dnodeId);
     mgmtSendDropVnodeMsg(pVload->vgId, &ipSet, NULL);
-    return;
+    return false;
   }
 
   if (pVload->role == TAOS_SYNC_ROLE_MASTER) {
@@ -286,7 +306,10 @@ void mgmtUpdateVgroupStatus(SVgObj *pVgroup, SDnodeObj *pDnode, SVnodeLoad *pVlo
            pDnode->dnodeId, pVload->vgId, pVload->cfgVersion, pVload->replica, pVgroup->pDb->cfgVersion,
            pVgroup->numOfVnodes);
     mgmtSendCreateVgroupMsg(pVgroup, NULL);
+    return false;
   }
+
+  return true;
 }
 
 SVgObj *mgmtGetAvailableVgroup(SDbObj *pDb) {
@@ -558,6 +581,7 @@ SMDCreateVnodeMsg *mgmtBuildCreateVnodeMsg(SVgObj *pVgroup) {
   pCfg->replications        = (int8_t) pVgroup->numOfVnodes;
   pCfg->wals                = 3;
   pCfg->quorum              = 1;
+  pCfg->update              = pDb->cfg.update;
   
   SMDVnodeDesc *pNodes = pVnode->nodes;
   for (int32_t j = 0; j < pVgroup->numOfVnodes; ++j) {
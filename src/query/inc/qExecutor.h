@@ -18,6 +18,7 @@
 #include "os.h"
 
 #include "hash.h"
+#include "qcache.h"
 #include "qfill.h"
 #include "qresultBuf.h"
 #include "qsqlparser.h"
@@ -81,6 +82,7 @@ typedef struct SWindowResInfo {
   int64_t        startTime;  // start time of the first time window for sliding query
   int64_t        prevSKey;   // previous (not completed) sliding window start key
   int64_t        threshold;  // threshold to pausing query and return closed results.
+  int64_t        prevState;  // value of the state column of the previous row, for state window query
 } SWindowResInfo;
 
 typedef struct SColumnFilterElem {
@@ -127,6 +129,9 @@ typedef struct SQuery {
   int64_t           intervalTime;
   int64_t           slidingTime;      // sliding time for sliding window query
   char              slidingTimeUnit;  // interval data type, used for daytime revise
+  int8_t            windowType;       // session or state window query
+  int64_t           sessionGap;       // max time gap between the adjacent rows of a session window
+  int16_t           stateColId;       // rows are in one state window until the value of this column changes
   int8_t            precision;
   int16_t           numOfOutput;
   int16_t           fillType;
@@ -163,6 +168,8 @@ typedef struct SQueryRuntimeEnv {
   void*              pQueryHandle;
   void*              pSecQueryHandle; // another thread for
   SDiskbasedResultBuf* pResultBuf;  // query result buffer based on blocked-wised disk file
+  bool               useRollup;  // interval query that can be answered by the rollups of data blocks
+  SDataRollup*       pRollup;    // pre-aggregated windows of current data block, NULL if the block data is loaded
 } SQueryRuntimeEnv;
 
 typedef struct SQInfo {
@@ -181,6 +188,7 @@ typedef struct SQInfo {
   int32_t          groupIndex;
   int32_t          offset;            // offset in group result set of subgroup, todo refactor
   SArray*          arrTableIdInfo;
+  SQueryCacheInfo  cacheInfo;         // cached result of the same query
   
   T_REF_DECLARE()
   /*
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TDENGINE_QCACHE_H
+#define TDENGINE_QCACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "os.h"
+#include "taosdef.h"
+#include "taosmsg.h"
+#include "tsdb.h"
+
+/*
+ * Finalized results of the repeated queries (dashboards refreshing the same panels) are kept in a cache of
+ * the vnodes, keyed by the normalized query and the set of queried tables, but not the time range of the query.
+ *
+ * A cached result is valid as long as the data version of every queried table is unchanged, since rows appended
+ * after the last key of a table can not change the results of the windows that end before that key. So a query
+ * with exactly the same time range is answered by the cached result directly, and an interval query whose range
+ * ends at "now" reuses the windows of the cached result, and only computes the windows at the tail.
+ *
+ * The cache is bounded by tsQueryCacheSize, the results kept earliest are evicted first.
+ */
+#define QUERY_CACHE_KEY_LEN 36
+
+typedef struct SQueryCacheTable {
+  uint64_t uid;
+  int64_t  version;  // data version of the table
+  TSKEY    lastKey;
+} SQueryCacheTable;
+
+typedef struct SQueryCacheInfo {
+  char              key[QUERY_CACHE_KEY_LEN];  // empty if the result of the query is not cached
+  STimeWindow       window;                    // time range of the query before it is executed
+  int32_t           numOfTables;
+  SQueryCacheTable *pTables;                   // snapshot of the queried tables before the query is executed
+  void *            pEntry;                    // cached result that is reused, NULL if not found or invalid
+  bool              exact;                     // the whole result is served by pEntry, no need to execute the query
+  STimeWindow       reuse;                     // time range of the windows served by pEntry if not exact
+} SQueryCacheInfo;
+
+struct SQInfo;
+
+void qCacheBuildKey(SQueryTableMsg *pQueryMsg, SExprInfo *pExprs, SColIndex *pGroupColIndex,
+                    SColumnInfo *pTagCols, char *tagCond, char *tbnameCond, STableGroupInfo *pGroupInfo, int32_t vgId,
+                    char *key);
+
+/**
+ * Snapshot the queried tables, and find the cached result that is still valid for the query.
+ *
+ * @param pQInfo
+ * @param key          key built by qCacheBuildKey
+ * @param reusePrefix  the windows of a cached result with a different time range can be reused
+ */
+void qCacheLookup(struct SQInfo *pQInfo, const char *key, bool reusePrefix);
+
+/**
+ * Find the cached result that is valid for the snapshot of the queried tables kept in the cache info of the query.
+ */
+void qCacheFind(struct SQInfo *pQInfo, const char *key, bool reusePrefix);
+
+/**
+ * Copy the cached result of an exact hit to the output buffer of the query.
+ */
+void qCacheCopyResult(struct SQInfo *pQInfo);
+
+/**
+ * Replace the windows computed in the reused time range by the ones of the cached result.
+ */
+void qCacheMergeResult(struct SQInfo *pQInfo);
+
+/**
+ * Keep the result of the query in cache, the whole result must be in the output buffer.
+ */
+void qCachePut(struct SQInfo *pQInfo);
+
+void qCacheRelease(struct SQInfo *pQInfo);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // TDENGINE_QCACHE_H
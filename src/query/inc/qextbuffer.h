@@ -229,6 +229,20 @@ typedef int (*__col_compar_fn_t)(tOrderDescriptor *, int32_t numOfRows, int32_t
 
 void tColDataQSort(tOrderDescriptor *, int32_t numOfRows, int32_t start, int32_t end, char *data, int32_t orderType);
 
+/*
+ * sort the rows in [start, end] by radix sort if all the order columns are of integer types, including timestamp and
+ * bool, or by tColDataQSort otherwise. Unlike tColDataQSort, the rows of the same order keep their relative order.
+ */
+void tColDataSort(tOrderDescriptor *, int32_t numOfRows, int32_t start, int32_t end, char *data, int32_t orderType);
+
+/*
+ * the rows ordered by a single integer or timestamp column are compared by the unsigned keys of tColDataGetOrderKey,
+ * of which the order is the same as compare_a (or compare_d if orderType is TSDB_ORDER_DESC)
+ */
+bool tOrderDescHasIntegerKey(tOrderDescriptor *);
+
+uint64_t tColDataGetOrderKey(tOrderDescriptor *, int32_t numOfRows, int32_t rowIdx, char *data, int32_t orderType);
+
 int32_t compare_sa(tOrderDescriptor *, int32_t numOfRows, int32_t idx1, int32_t idx2, char *data);
 
 int32_t compare_sd(tOrderDescriptor *, int32_t numOfRows, int32_t idx1, int32_t idx2, char *data);
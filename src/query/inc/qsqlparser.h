@@ -49,6 +49,13 @@ typedef struct SLimitVal {
   int64_t offset;
 } SLimitVal;
 
+// session(col, gap) or state_window(col) clause, the name is empty if the query has no such clause
+typedef struct SWindowClauseVal {
+  SSQLToken name;
+  SSQLToken col;
+  SSQLToken gap;
+} SWindowClauseVal;
+
 typedef struct SOrderVal {
   uint32_t order;
   int32_t orderColId;
@@ -72,6 +79,7 @@ typedef struct SQuerySQL {
   tVariantList *       pGroupby;     // groupby clause, only for tags[optional]
   tVariantList *       pSortOrder;   // orderby [optional]
   SSQLToken            interval;     // interval [optional]
+  SWindowClauseVal     window;       // session or state window [optional]
   SSQLToken            sliding;      // sliding window [optional]
   SLimitVal            limit;        // limit offset [optional]
   SLimitVal            slimit;       // group limit offset [optional]
@@ -257,7 +265,8 @@ void tSQLExprListDestroy(tSQLExprList *pList);
 
 SQuerySQL *tSetQuerySQLElems(SSQLToken *pSelectToken, tSQLExprList *pSelection, tVariantList *pFrom, tSQLExpr *pWhere,
                              tVariantList *pGroupby, tVariantList *pSortOrder, SSQLToken *pInterval,
-                             SSQLToken *pSliding, tVariantList *pFill, SLimitVal *pLimit, SLimitVal *pGLimit);
+                             SWindowClauseVal *pWindow, SSQLToken *pSliding, tVariantList *pFill, SLimitVal *pLimit,
+                             SLimitVal *pGLimit);
 
 SCreateTableSQL *tSetCreateSQLElems(tFieldList *pCols, tFieldList *pTags, SSQLToken *pMetricName,
                                     tVariantList *pTagVals, SQuerySQL *pSelect, int32_t type);
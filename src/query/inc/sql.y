@@ -353,8 +353,8 @@ tagitem(A) ::= PLUS(X) FLOAT(Y).  {
 //////////////////////// The SELECT statement /////////////////////////////////
 %type select {SQuerySQL*}
 %destructor select {doDestroyQuerySql($$);}
-select(A) ::= SELECT(T) selcollist(W) from(X) where_opt(Y) interval_opt(K) fill_opt(F) sliding_opt(S) groupby_opt(P) orderby_opt(Z) having_opt(N) slimit_opt(G) limit_opt(L). {
-  A = tSetQuerySQLElems(&T, W, X, Y, P, Z, &K, &S, F, &L, &G);
+select(A) ::= SELECT(T) selcollist(W) from(X) where_opt(Y) interval_opt(K) window_opt(H) fill_opt(F) sliding_opt(S) groupby_opt(P) orderby_opt(Z) having_opt(N) slimit_opt(G) limit_opt(L). {
+  A = tSetQuerySQLElems(&T, W, X, Y, P, Z, &K, &H, &S, F, &L, &G);
 }
 
 %type union {SSubclauseInfo*}
@@ -372,7 +372,7 @@ cmd ::= union(X). { setSQLInfo(pInfo, X, NULL, TSDB_SQL_SELECT); }
 // select server_version(), select client_version(),
 // select server_state();
 select(A) ::= SELECT(T) selcollist(W). {
-  A = tSetQuerySQLElems(&T, W, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+  A = tSetQuerySQLElems(&T, W, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
 
 // selcollist is a list of expressions that are to become the return
@@ -419,6 +419,12 @@ tmvar(A) ::= VARIABLE(X).   {A = X;}
 interval_opt(N) ::= INTERVAL LP tmvar(E) RP.    {N = E;     }
 interval_opt(N) ::= .                           {N.n = 0; N.z = NULL; N.type = 0;   }
 
+// session(ts, gap) and state_window(col), the name is not a keyword and it is checked during the query validation
+%type window_opt {SWindowClauseVal}
+window_opt(N) ::= ID(F) LP ids(V) COMMA tmvar(Y) RP. {N.name = F; N.col = V; N.gap = Y;   }
+window_opt(N) ::= ID(F) LP ids(V) RP.           {N.name = F; N.col = V; N.gap.n = 0; N.gap.z = NULL; N.gap.type = 0;}
+window_opt(N) ::= .                             {memset(&N, 0, sizeof(N));}
+
 %type fill_opt {tVariantList*}
 %destructor fill_opt {tVariantListDestroy($$);}
 fill_opt(N) ::= .                               {N = 0;     }
@@ -655,5 +661,5 @@ cmd ::= KILL QUERY IPTOKEN(X) COLON(Z) INTEGER(Y) COLON(K) INTEGER(F).        {X
   DELIMITERS DESC DETACH EACH END EXPLAIN FAIL FOR GLOB IGNORE IMMEDIATE INITIALLY INSTEAD
   LIKE MATCH KEY OF OFFSET RAISE REPLACE RESTRICT ROW STATEMENT TRIGGER VIEW ALL
   COUNT SUM AVG MIN MAX FIRST LAST TOP BOTTOM STDDEV PERCENTILE APERCENTILE LEASTSQUARES HISTOGRAM DIFF
-  SPREAD TWA INTERP LAST_ROW RATE IRATE SUM_RATE SUM_IRATE AVG_RATE AVG_IRATE TBID NOW IPTOKEN SEMI NONE PREV LINEAR IMPORT
+  SPREAD TWA INTERP LAST_ROW RATE IRATE SUM_RATE SUM_IRATE AVG_RATE AVG_IRATE VARIANCE TBID NOW IPTOKEN SEMI NONE PREV LINEAR IMPORT
   METRIC TBNAME JOIN METRICS STABLE NULL INSERT INTO VALUES.
@@ -69,6 +69,7 @@ extern "C" {
 #define TSDB_FUNC_AVG_IRATE    33
 
 #define TSDB_FUNC_TID_TAG      34
+#define TSDB_FUNC_VARIANCE     35
 
 #define TSDB_FUNCSTATE_SO           0x1u    // single output
 #define TSDB_FUNCSTATE_MO           0x2u    // dynamic number of output, not multinumber of output e.g., TOP/BOTTOM
@@ -241,6 +242,7 @@ enum {
   BLK_DATA_NO_NEEDED = 0x0,
   BLK_DATA_FILEDS_NEEDED = 0x1,
   BLK_DATA_ALL_NEEDED = 0x3,
+  BLK_DATA_DISCARD = 0x4,  // no data in this block satisfies the filters according to its statistics
 };
 
 #define SET_DATA_BLOCK_NOT_LOADED(x) ((x) &= (~BLK_BLOCK_LOADED));
@@ -263,6 +265,13 @@ typedef struct STwaInfo {
   };
 } STwaInfo;
 
+// the max of spread(ts) is the end of the session window, which is used to merge the windows of super table queries
+typedef struct SSpreadInfo {
+  double min;
+  double max;
+  int8_t hasResult;
+} SSpreadInfo;
+
 /* global sql function array */
 extern struct SQLAggFuncElem aAggs[];
 
@@ -25,7 +25,8 @@
 #include "queryLog.h"
 #include "taosmsg.h"
 #include "tdataformat.h"
-#include "tlosertree.h"
+#include "tglobal.h"
+#include "tmergetree.h"
 #include "tscUtil.h"  // todo move the function to common module
 #include "tscompression.h"
 #include "ttime.h"
@@ -102,6 +103,12 @@ static void setQueryStatus(SQuery *pQuery, int8_t status);
 
 static bool isIntervalQuery(SQuery *pQuery) { return pQuery->intervalTime > 0; }
 
+// the session and state windows are not of fixed length, they are built while scanning data in the ascending order
+static bool isSessionOrStateWindowQuery(SQuery *pQuery) { return pQuery->windowType != TSDB_WINDOW_NONE; }
+
+// the results of each time window, either of fixed intervals or not, are kept in the window results
+static bool isTimeWindowQuery(SQuery *pQuery) { return isIntervalQuery(pQuery) || isSessionOrStateWindowQuery(pQuery); }
+
 // todo move to utility
 static int32_t mergeIntoGroupResultImpl(SQInfo *pQInfo, SArray *group);
 
@@ -927,6 +934,211 @@ static char *getDataBlock(SQueryRuntimeEnv *pRuntimeEnv, SArithmeticSupport *sas
   return dataBlock;
 }
 
+static SColumnInfo *getStateColumnInfo(SQuery *pQuery) {
+  for (int32_t i = 0; i < pQuery->numOfCols; ++i) {
+    if (pQuery->colList[i].colId == pQuery->stateColId) {
+      return &pQuery->colList[i];
+    }
+  }
+
+  return NULL;
+}
+
+static int64_t getStateValue(char *pData, int16_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      return *(int8_t *)pData;
+    case TSDB_DATA_TYPE_SMALLINT:
+      return *(int16_t *)pData;
+    case TSDB_DATA_TYPE_INT:
+      return *(int32_t *)pData;
+    default:
+      return *(int64_t *)pData;
+  }
+}
+
+// the windows are built by the master scan in the ascending order of the start key, search the one covers the key
+static int32_t getSessionOrStateWindowSlot(SWindowResInfo *pWindowResInfo, TSKEY key) {
+  int32_t start = 0;
+  int32_t end = pWindowResInfo->size - 1;
+
+  while (start <= end) {
+    int32_t        mid = start + (end - start) / 2;
+    SWindowResult *pResult = &pWindowResInfo->pResult[mid];
+
+    if (pResult->window.ekey < key) {
+      start = mid + 1;
+    } else if (pResult->window.skey > key) {
+      end = mid - 1;
+    } else {
+      return mid;
+    }
+  }
+
+  return -1;
+}
+
+/*
+ * Set the output buffer of the session or state window that the row at offset belongs to, and return the number of
+ * rows from offset on, in the scan order and no more than maxRows, that belong to the same window. If the row belongs
+ * to no window, e.g., the value of the state column is null, 0 is returned.
+ *
+ * In the master scan, a new window starts if the row is farther than the session gap from the end of current window,
+ * or the state value changes. The windows are closed once a new window starts, and the following scans only look up
+ * the windows built by the master scan.
+ */
+static int32_t setSessionOrStateWindow(SQueryRuntimeEnv *pRuntimeEnv, SWindowResInfo *pWindowResInfo,
+                                       SDataBlockInfo *pDataBlockInfo, SArray *pDataBlock, int32_t offset,
+                                       int32_t maxRows, STimeWindow *pWin) {
+  SQuery *pQuery = pRuntimeEnv->pQuery;
+  TSKEY * tsCol = (TSKEY *)((SColumnInfoData *)taosArrayGet(pDataBlock, 0))->pData;
+  int32_t step = GET_FORWARD_DIRECTION_FACTOR(pQuery->order.order);
+
+  char *  pState = NULL;
+  int16_t type = 0;
+  int16_t bytes = 0;
+
+  if (pQuery->windowType == TSDB_WINDOW_STATE) {
+    SColumnInfo *pColInfo = getStateColumnInfo(pQuery);
+    assert(pColInfo != NULL);
+
+    type = pColInfo->type;
+    bytes = pColInfo->bytes;
+    pState = getDataBlockImpl(pDataBlock, pQuery->stateColId);
+
+    if (pState == NULL || isNull(pState + bytes * offset, type)) {
+      return 0;
+    }
+  }
+
+  int32_t num = 1;
+
+  if (IS_MASTER_SCAN(pRuntimeEnv)) {
+    assert(QUERY_IS_ASC_QUERY(pQuery));
+
+    TSKEY   ts = tsCol[offset];
+    int64_t state = (pState != NULL) ? getStateValue(pState + bytes * offset, type) : 0;
+
+    STimeWindow win = {.skey = ts, .ekey = ts};
+    if (pWindowResInfo->curIndex >= 0) {
+      int32_t        slot = curTimeWindow(pWindowResInfo);
+      SWindowResult *pResult = getWindowResult(pWindowResInfo, slot);
+
+      bool sameWindow = (pState == NULL) ? (ts - pResult->window.ekey <= pQuery->sessionGap)
+                                         : (state == pWindowResInfo->prevState);
+      if (sameWindow) {
+        win.skey = pResult->window.skey;
+      } else {
+        closeTimeWindow(pWindowResInfo, slot);
+      }
+    }
+
+    for (int32_t j = offset + step; num < maxRows; j += step, ++num) {
+      if (pState == NULL) {
+        if (tsCol[j] - tsCol[j - step] > pQuery->sessionGap) {
+          break;
+        }
+      } else if (isNull(pState + bytes * j, type) || getStateValue(pState + bytes * j, type) != state) {
+        break;
+      }
+    }
+
+    win.ekey = tsCol[offset + (num - 1) * step];
+    pWindowResInfo->prevState = state;
+    *pWin = win;
+  } else {
+    int32_t slot = getSessionOrStateWindowSlot(pWindowResInfo, tsCol[offset]);
+    if (slot < 0) {
+      return 0;
+    }
+
+    *pWin = getWindowResult(pWindowResInfo, slot)->window;
+
+    for (int32_t j = offset + step; num < maxRows; j += step, ++num) {
+      if (tsCol[j] < pWin->skey || tsCol[j] > pWin->ekey || (pState != NULL && isNull(pState + bytes * j, type))) {
+        break;
+      }
+    }
+  }
+
+  if (setWindowOutputBufByKey(pRuntimeEnv, pWindowResInfo, pDataBlockInfo->tid, pWin) != TSDB_CODE_SUCCESS) {
+    return 0;
+  }
+
+  return num;
+}
+
+static SDataStatis *getRollupColStatis(SDataRollup *pRollup, int32_t window, int32_t colId) {
+  SDataStatis *pStatis = pRollup->statis + window * pRollup->numOfCols;
+
+  for (int32_t i = 0; i < pRollup->numOfCols; ++i) {
+    if (pStatis[i].colId == colId) {
+      return &pStatis[i];
+    }
+  }
+
+  return NULL;
+}
+
+/*
+ * apply the functions on the pre-aggregated windows of the data block instead of the block data, each window of
+ * the rollup falls in one time window of the query.
+ */
+static void rollupApplyFunctions(SQueryRuntimeEnv *pRuntimeEnv, SDataBlockInfo *pDataBlockInfo,
+                                 SWindowResInfo *pWindowResInfo) {
+  SQLFunctionCtx *pCtx = pRuntimeEnv->pCtx;
+  SQuery *        pQuery = pRuntimeEnv->pQuery;
+  SDataRollup *   pRollup = pRuntimeEnv->pRollup;
+
+  int32_t index = pWindowResInfo->curIndex;
+  int32_t step = GET_FORWARD_DIRECTION_FACTOR(pQuery->order.order);
+  int32_t start = QUERY_IS_ASC_QUERY(pQuery) ? 0 : pRollup->numOfWindows - 1;
+
+  for (int32_t i = start; i >= 0 && i < pRollup->numOfWindows; i += step) {
+    STimeWindow win = getActiveTimeWindow(pWindowResInfo, pRollup->skey[i], pQuery);
+    if (setWindowOutputBufByKey(pRuntimeEnv, pWindowResInfo, pDataBlockInfo->tid, &win) != TSDB_CODE_SUCCESS) {
+      break;
+    }
+
+    SWindowStatus *pStatus = getTimeWindowResStatus(pWindowResInfo, curTimeWindow(pWindowResInfo));
+    if (!IS_MASTER_SCAN(pRuntimeEnv) && !pStatus->closed) {
+      continue;
+    }
+
+    for (int32_t k = 0; k < pQuery->numOfOutput; ++k) {
+      int32_t      functionId = pQuery->pSelectExpr[k].base.functionId;
+      SDataStatis *pStatis = getRollupColStatis(pRollup, i, pQuery->pSelectExpr[k].base.colInfo.colId);
+
+      pCtx[k].nStartQueryTimestamp = win.skey;
+      pCtx[k].size = pRollup->numOfRows[i];
+      pCtx[k].startOffset = 0;
+      pCtx[k].aInputElemBuf = NULL;
+      pCtx[k].ptsList = NULL;
+      pCtx[k].preAggVals.isSet = (pStatis != NULL);
+
+      if (pStatis != NULL) {
+        pCtx[k].preAggVals.statis = *pStatis;
+        pCtx[k].hasNull = (pStatis->numOfNull > 0);
+
+        // all data are NULL in current window
+        if (functionId != TSDB_FUNC_TS && functionId != TSDB_FUNC_TAG && pStatis->numOfNull >= pCtx[k].size) {
+          continue;
+        }
+      }
+
+      if (functionNeedToExecute(pRuntimeEnv, &pCtx[k], functionId)) {
+        aAggs[functionId].xFunction(&pCtx[k]);
+      }
+    }
+  }
+
+  pWindowResInfo->curIndex = index;
+
+  TSKEY lastKey = QUERY_IS_ASC_QUERY(pQuery) ? pDataBlockInfo->window.ekey : pDataBlockInfo->window.skey;
+  pQuery->current->lastKey = lastKey + step;
+}
+
 /**
  *
  * @param pRuntimeEnv
@@ -943,6 +1155,11 @@ static void blockwiseApplyFunctions(SQueryRuntimeEnv *pRuntimeEnv, SDataStatis *
   SQLFunctionCtx *pCtx = pRuntimeEnv->pCtx;
   SQuery *        pQuery = pRuntimeEnv->pQuery;
 
+  if (pDataBlock == NULL && pRuntimeEnv->pRollup != NULL) {
+    rollupApplyFunctions(pRuntimeEnv, pDataBlockInfo, pWindowResInfo);
+    return;
+  }
+
   SColumnInfoData *pColInfo = NULL;
   
   TSKEY *primaryKeyCol = NULL;
@@ -1005,6 +1222,25 @@ static void blockwiseApplyFunctions(SQueryRuntimeEnv *pRuntimeEnv, SDataStatis *
     }
 
     pWindowResInfo->curIndex = index;
+  } else if (isSessionOrStateWindowQuery(pQuery)) {
+    int32_t pos = pQuery->pos;
+    int32_t remain = QUERY_IS_ASC_QUERY(pQuery) ? pDataBlockInfo->rows - pos : pos + 1;
+
+    // apply the functions on each run of rows that belong to the same window
+    while (remain > 0) {
+      STimeWindow win = TSWINDOW_INITIALIZER;
+      int32_t     num = setSessionOrStateWindow(pRuntimeEnv, pWindowResInfo, pDataBlockInfo, pDataBlock, pos, remain,
+                                            &win);
+      if (num > 0) {
+        SWindowStatus *pStatus = getTimeWindowResStatus(pWindowResInfo, curTimeWindow(pWindowResInfo));
+        doBlockwiseApplyFunctions(pRuntimeEnv, pStatus, &win, pos, num, primaryKeyCol, pDataBlockInfo->rows);
+      } else {
+        num = 1;
+      }
+
+      pos += num * step;
+      remain -= num;
+    }
   } else {
     /*
      * the sqlfunctionCtx parameters should be set done before all functions are invoked,
@@ -1226,8 +1462,13 @@ static void rowwiseApplyFunctions(SQueryRuntimeEnv *pRuntimeEnv, SDataStatis *pS
       continue;
     }
 
-    // interval window query
-    if (isIntervalQuery(pQuery)) {
+    if (isSessionOrStateWindowQuery(pQuery)) {
+      STimeWindow win = TSWINDOW_INITIALIZER;
+      if (setSessionOrStateWindow(pRuntimeEnv, pWindowResInfo, pDataBlockInfo, pDataBlock, offset, 1, &win) > 0) {
+        SWindowStatus *pStatus = getTimeWindowResStatus(pWindowResInfo, curTimeWindow(pWindowResInfo));
+        doRowwiseApplyFunctions(pRuntimeEnv, pStatus, &win, offset);
+      }
+    } else if (isIntervalQuery(pQuery)) {  // interval window query
       // decide the time window according to the primary timestamp
       int64_t     ts = primaryKeyCol[offset];
       STimeWindow win = getActiveTimeWindow(pWindowResInfo, ts, pQuery);
@@ -1332,6 +1573,9 @@ static int32_t tableApplyFunctionsOnBlock(SQueryRuntimeEnv *pRuntimeEnv, SDataBl
   
   if (isIntervalQuery(pQuery)) {
     numOfRes = doCheckQueryCompleted(pRuntimeEnv, lastKey, pWindowResInfo);
+  } else if (isSessionOrStateWindowQuery(pQuery)) {
+    // the last window may be extended by the next block, all windows are closed after the scan
+    numOfRes = pWindowResInfo->size;
   } else {
     numOfRes = getNumOfResult(pRuntimeEnv);
 
@@ -1605,7 +1849,7 @@ static bool isQueryKilled(SQInfo *pQInfo) {
 static void setQueryKilled(SQInfo *pQInfo) { pQInfo->code = TSDB_CODE_QUERY_CANCELLED; }
 
 static bool isFixedOutputQuery(SQuery *pQuery) {
-  if (pQuery->intervalTime != 0) {
+  if (isTimeWindowQuery(pQuery)) {
     return false;
   }
 
@@ -1706,6 +1950,73 @@ static bool onlyQueryTags(SQuery* pQuery) {
   return true;
 }
 
+/*
+ * Only the results of aggregate queries are kept in cache, the subscriptions (the start key of a table differs from
+ * the query window), join queries and tag queries are excluded.
+ */
+static bool isQueryCacheable(SQInfo *pQInfo, SQueryTableMsg *pQueryMsg, SArray *pTableIdList) {
+  SQuery *pQuery = pQInfo->runtimeEnv.pQuery;
+
+  if (tsQueryCacheKeepTimer <= 0 || Q_STATUS_EQUAL(pQuery->status, QUERY_COMPLETED)) {
+    return false;
+  }
+
+  if (pQInfo->runtimeEnv.pTSBuf != NULL || isTSCompQuery(pQuery) || onlyQueryTags(pQuery) ||
+      isGroupbyNormalCol(pQuery->pGroupbyExpr) || isSessionOrStateWindowQuery(pQuery) ||
+      (!isIntervalQuery(pQuery) && !isFixedOutputQuery(pQuery))) {
+    return false;
+  }
+
+  size_t num = taosArrayGetSize(pTableIdList);
+  for (int32_t i = 0; i < num; ++i) {
+    STableIdInfo *pTableId = taosArrayGet(pTableIdList, i);
+    if (pTableId->key != pQueryMsg->window.skey) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * The windows of a cached result can be reused by the interval query on a table with a different time range, if
+ * each window only depends on the rows in it, and all windows are returned in one round.
+ */
+static bool canReuseCachedWindows(SQInfo *pQInfo) {
+  SQuery *pQuery = pQInfo->runtimeEnv.pQuery;
+
+  if (pQInfo->runtimeEnv.stableQuery || !isIntervalQuery(pQuery) || !QUERY_IS_ASC_QUERY(pQuery) ||
+      pQuery->window.skey > pQuery->window.ekey) {
+    return false;
+  }
+
+  if (pQuery->slidingTime != pQuery->intervalTime || pQuery->fillType != TSDB_FILL_NONE || pQuery->limit.limit > 0 ||
+      pQuery->limit.offset > 0) {
+    return false;
+  }
+
+  int64_t numOfWindows = pQuery->window.ekey / pQuery->intervalTime - pQuery->window.skey / pQuery->intervalTime + 1;
+  if (numOfWindows >= pQuery->rec.threshold) {
+    return false;
+  }
+
+  if (pQuery->pSelectExpr[0].base.functionId != TSDB_FUNC_TS) {
+    return false;
+  }
+
+  for (int32_t i = 1; i < pQuery->numOfOutput; ++i) {
+    int32_t functionId = pQuery->pSelectExpr[i].base.functionId;
+    if (functionId != TSDB_FUNC_COUNT && functionId != TSDB_FUNC_SUM && functionId != TSDB_FUNC_AVG &&
+        functionId != TSDB_FUNC_MIN && functionId != TSDB_FUNC_MAX && functionId != TSDB_FUNC_FIRST &&
+        functionId != TSDB_FUNC_LAST && functionId != TSDB_FUNC_SPREAD && functionId != TSDB_FUNC_STDDEV &&
+        functionId != TSDB_FUNC_VARIANCE) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 void getAlignQueryTimeWindow(SQuery *pQuery, int64_t key, int64_t keyFirst, int64_t keyLast, int64_t *realSkey,
@@ -1856,6 +2167,11 @@ static void changeExecuteScanOrder(SQuery *pQuery, bool metricQuery) {
   char msg[] = "QInfo:%p scan order changed for %s query, old:%d, new:%d, qrange exchanged, old qrange:%" PRId64
                "-%" PRId64 ", new qrange:%" PRId64 "-%" PRId64;
 
+  // the session and state windows are built in the ascending order
+  if (isSessionOrStateWindowQuery(pQuery)) {
+    return;
+  }
+
   // todo handle the case the the order irrelevant query type mixed up with order critical query type
   // descending order query for last_row query
   if (isFirstLastRowQuery(pQuery)) {
@@ -2146,7 +2462,7 @@ static int32_t getInitialPageNum(SQInfo *pQInfo) {
 
   if (isGroupbyNormalCol(pQuery->pGroupbyExpr)) {
     num = 128;
-  } else if (isIntervalQuery(pQuery)) {  // time window query, allocate one page for each table
+  } else if (isTimeWindowQuery(pQuery)) {  // time window query, allocate one page for each table
     size_t s = pQInfo->groupInfo.numOfTables;
     num = MAX(s, INITIAL_RESULT_ROWS_VALUE);
   } else {    // for super table query, one page for each subset
@@ -2223,12 +2539,86 @@ UNUSED_FUNC void vnodeDecMeterRefcnt(SQInfo *pQInfo) {
 #endif
 }
 
-static bool needToLoadDataBlock(SQuery *pQuery, SDataStatis *pDataStatis, SQLFunctionCtx *pCtx,
-                                int32_t numOfTotalPoints) {
+/*
+ * The min/max of a binary/nchar column only keep the leading bytes of the value, so only the equal filter can be
+ * checked against them. A sum of zero means the statistics are not available for this block.
+ */
+static bool varDataFilterByPrefix(SColumnFilterElem *pFilterElem, int16_t type, SDataStatis *pStatis) {
+  SColumnFilterInfo *pFilterInfo = &pFilterElem->filterInfo;
+  if (pStatis->sum == 0 || pFilterInfo->lowerRelOptr != TSDB_RELATION_EQUAL ||
+      pFilterInfo->upperRelOptr != TSDB_RELATION_INVALID) {
+    return true;
+  }
+
+  char    prefix[VARSTR_PREFIX_BYTES];
+  int32_t len = tGetVarDataPrefix((char *)pFilterInfo->pz, (int32_t)pFilterInfo->len, type, prefix);
+
+  return memcmp(prefix, &pStatis->min, len) >= 0 && memcmp(prefix, &pStatis->max, len) <= 0;
+}
+
+/*
+ * Check the equal filter against the bloom filter of the column in current data block, if there is one.
+ */
+static bool filterByBloomFilter(void *pQueryHandle, SColumnFilterElem *pFilterElem, int16_t colId, int16_t type) {
+  SColumnFilterInfo *pFilterInfo = &pFilterElem->filterInfo;
+  if (pFilterInfo->lowerRelOptr != TSDB_RELATION_EQUAL || pFilterInfo->upperRelOptr != TSDB_RELATION_INVALID) {
+    return true;
+  }
+
+  if (type == TSDB_DATA_TYPE_BINARY || type == TSDB_DATA_TYPE_NCHAR) {
+    return tsdbBlockMayContainValue(pQueryHandle, colId, (char *)pFilterInfo->pz, (int32_t)pFilterInfo->len);
+  } else if (type >= TSDB_DATA_TYPE_TINYINT && type <= TSDB_DATA_TYPE_BIGINT) {
+    return tsdbBlockMayContainValue(pQueryHandle, colId, (char *)&pFilterInfo->lowerBndi, sizeof(int64_t));
+  }
+
+  return true;
+}
+
+static bool needToLoadDataBlock(SQuery *pQuery, void *pQueryHandle, SDataStatis *pDataStatis, SQLFunctionCtx *pCtx,
+                                int32_t numOfCols, int32_t numOfTotalPoints) {
   if (pDataStatis == NULL) {
     return true;
   }
 
+  for (int32_t k = 0; k < pQuery->numOfFilterCols; ++k) {
+    SSingleColumnFilterInfo *pFilterInfo = &pQuery->pFilterInfo[k];
+
+    SDataStatis *pColStatis = NULL;
+    for (int32_t i = 0; i < numOfCols; ++i) {
+      if (pDataStatis[i].colId == pFilterInfo->info.colId) {
+        pColStatis = &pDataStatis[i];
+        break;
+      }
+    }
+
+    if (pColStatis == NULL) {
+      continue;
+    }
+
+    // NULL value never satisfies the filter
+    if (pColStatis->numOfNull == numOfTotalPoints) {
+      return false;
+    }
+
+    int16_t type = pFilterInfo->info.type;
+    int16_t colId = pFilterInfo->info.colId;
+    bool    isVarType = (type == TSDB_DATA_TYPE_BINARY || type == TSDB_DATA_TYPE_NCHAR);
+
+    bool qualified = false;
+    for (int32_t i = 0; i < pFilterInfo->numOfFilters; ++i) {
+      SColumnFilterElem *pFilterElem = &pFilterInfo->pFilters[i];
+      if ((!isVarType || varDataFilterByPrefix(pFilterElem, type, pColStatis)) &&
+          filterByBloomFilter(pQueryHandle, pFilterElem, colId, type)) {
+        qualified = true;
+        break;
+      }
+    }
+
+    if (!qualified) {
+      return false;
+    }
+  }
+
 #if 0
   for (int32_t k = 0; k < pQuery->numOfFilterCols; ++k) {
     SSingleColumnFilterInfo *pFilterInfo = &pQuery->pFilterInfo[k];
@@ -2288,11 +2678,22 @@ static void getNextTimeWindow(SQuery *pQuery, STimeWindow *pTimeWindow) {
   pTimeWindow->ekey = pTimeWindow->skey + (pQuery->intervalTime - 1);
 }
 
-SArray *loadDataBlockOnDemand(SQueryRuntimeEnv *pRuntimeEnv, void* pQueryHandle, SDataBlockInfo* pBlockInfo, SDataStatis **pStatis) {
+int32_t loadDataBlockOnDemand(SQueryRuntimeEnv *pRuntimeEnv, void* pQueryHandle, SDataBlockInfo* pBlockInfo,
+                              SDataStatis **pStatis, SArray** pDataBlock) {
   SQuery *pQuery = pRuntimeEnv->pQuery;
 
   uint32_t r = 0;
-  SArray * pDataBlock = NULL;
+  *pDataBlock = NULL;
+  pRuntimeEnv->pRollup = NULL;
+
+  // the windows of this block are served by the cached result of the same query
+  SQueryCacheInfo *pCache = &((SQInfo *)GET_QINFO_ADDR(pRuntimeEnv))->cacheInfo;
+  if (pCache->pEntry != NULL && pBlockInfo->window.skey >= pCache->reuse.skey &&
+      pBlockInfo->window.ekey <= pCache->reuse.ekey) {
+    qTrace("QInfo:%p data block discarded by query cache, brange:%" PRId64 "-%" PRId64 ", rows:%d",
+           GET_QINFO_ADDR(pRuntimeEnv), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
+    return BLK_DATA_DISCARD;
+  }
 
   if (pQuery->numOfFilterCols > 0) {
     r = BLK_DATA_ALL_NEEDED;
@@ -2303,7 +2704,7 @@ SArray *loadDataBlockOnDemand(SQueryRuntimeEnv *pRuntimeEnv, void* pQueryHandle,
       r |= aAggs[functionId].dataReqFunc(&pRuntimeEnv->pCtx[i], pQuery->window.skey, pQuery->window.ekey, colId);
     }
 
-    if (pRuntimeEnv->pTSBuf > 0 || isIntervalQuery(pQuery)) {
+    if (pRuntimeEnv->pTSBuf > 0 || isTimeWindowQuery(pQuery)) {
       r |= BLK_DATA_ALL_NEEDED;
     }
   }
@@ -2317,7 +2718,7 @@ SArray *loadDataBlockOnDemand(SQueryRuntimeEnv *pRuntimeEnv, void* pQueryHandle,
     }
 
     if (*pStatis == NULL) {
-      pDataBlock = tsdbRetrieveDataBlock(pQueryHandle, NULL);
+      *pDataBlock = tsdbRetrieveDataBlock(pQueryHandle, NULL);
     }
   } else {
     assert(r == BLK_DATA_ALL_NEEDED);
@@ -2328,19 +2729,37 @@ SArray *loadDataBlockOnDemand(SQueryRuntimeEnv *pRuntimeEnv, void* pQueryHandle,
     /*
      * if this block is completed included in the query range, do more filter operation
      * filter the data block according to the value filter condition.
-     * no need to load the data block, continue for next block
+     * no need to load the data block, continue for next block.
+     * the rows of a block must be checked one by one in case of join query
      */
-    if (!needToLoadDataBlock(pQuery, *pStatis, pRuntimeEnv->pCtx, pBlockInfo->rows)) {
-#if defined(_DEBUG_VIEW)
-      qTrace("QInfo:%p block discarded by per-filter", GET_QINFO_ADDR(pRuntimeEnv));
-#endif
-      //        return DISK_DATA_DISCARDED;
+    if (pRuntimeEnv->pTSBuf == NULL &&
+        !needToLoadDataBlock(pQuery, pQueryHandle, *pStatis, pRuntimeEnv->pCtx, pBlockInfo->numOfCols,
+                             pBlockInfo->rows)) {
+      qTrace("QInfo:%p data block discarded by pre-filter, brange:%" PRId64 "-%" PRId64 ", rows:%d",
+             GET_QINFO_ADDR(pRuntimeEnv), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
+      return BLK_DATA_DISCARD;
+    }
+
+    // the windows of the block are pre-aggregated when the whole block is in the query range
+    TSKEY skey = MIN(pQuery->window.skey, pQuery->window.ekey);
+    TSKEY ekey = MAX(pQuery->window.skey, pQuery->window.ekey);
+    if (pRuntimeEnv->useRollup && pBlockInfo->window.skey >= skey && pBlockInfo->window.ekey <= ekey) {
+      int64_t origin = taosGetIntervalStartTimestamp(pBlockInfo->window.skey, pQuery->slidingTime,
+                                                     pQuery->slidingTimeUnit, pQuery->precision);
+
+      pRuntimeEnv->pRollup = tsdbRetrieveDataBlockRollup(pQueryHandle, pQuery->intervalTime, origin);
+      if (pRuntimeEnv->pRollup != NULL) {
+        qTrace("QInfo:%p data block rollup used, brange:%" PRId64 "-%" PRId64 ", rows:%d, windows:%d",
+               GET_QINFO_ADDR(pRuntimeEnv), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows,
+               pRuntimeEnv->pRollup->numOfWindows);
+        return r;
+      }
     }
 
-    pDataBlock = tsdbRetrieveDataBlock(pQueryHandle, NULL);
+    *pDataBlock = tsdbRetrieveDataBlock(pQueryHandle, NULL);
   }
 
-  return pDataBlock;
+  return r;
 }
 
 int32_t binarySearchForKey(char *pValue, int num, TSKEY key, int order) {
@@ -2448,7 +2867,7 @@ static int64_t doScanAllDataBlocks(SQueryRuntimeEnv *pRuntimeEnv) {
     }
 
     // in case of prj/diff query, ensure the output buffer is sufficient to accommodate the results of current block
-    if (!isIntervalQuery(pQuery) && !isGroupbyNormalCol(pQuery->pGroupbyExpr) && !isFixedOutputQuery(pQuery)) {
+    if (!isTimeWindowQuery(pQuery) && !isGroupbyNormalCol(pQuery->pGroupbyExpr) && !isFixedOutputQuery(pQuery)) {
       SResultRec *pRec = &pQuery->rec;
 
       if (pQuery->rec.capacity - pQuery->rec.rows < blockInfo.rows) {
@@ -2484,7 +2903,13 @@ static int64_t doScanAllDataBlocks(SQueryRuntimeEnv *pRuntimeEnv) {
     SDataStatis *pStatis = NULL;
     pQuery->pos = QUERY_IS_ASC_QUERY(pQuery) ? 0 : blockInfo.rows - 1;
     
-    SArray *pDataBlock = loadDataBlockOnDemand(pRuntimeEnv, pQueryHandle, &blockInfo, &pStatis);
+    SArray *pDataBlock = NULL;
+    if (loadDataBlockOnDemand(pRuntimeEnv, pQueryHandle, &blockInfo, &pStatis, &pDataBlock) == BLK_DATA_DISCARD) {
+      TSKEY lastKey = QUERY_IS_ASC_QUERY(pQuery) ? blockInfo.window.ekey : blockInfo.window.skey;
+      pTableQueryInfo->lastKey = lastKey + GET_FORWARD_DIRECTION_FACTOR(pQuery->order.order);
+      continue;
+    }
+
     int32_t numOfRes = tableApplyFunctionsOnBlock(pRuntimeEnv, &blockInfo, pStatis, binarySearchForKey, pDataBlock);
 
     qTrace("QInfo:%p check data block, brange:%" PRId64 "-%" PRId64 ", numOfRows:%d, numOfRes:%d, lastKey:%"PRId64, GET_QINFO_ADDR(pRuntimeEnv),
@@ -2607,6 +3032,11 @@ static void doMerge(SQueryRuntimeEnv *pRuntimeEnv, int64_t timestamp, SWindowRes
       continue;
     }
 
+    // the merged session window starts at the start of its first window
+    if (functionId == TSDB_FUNC_TS && mergeFlag && pQuery->windowType == TSDB_WINDOW_SESSION) {
+      continue;
+    }
+
     aAggs[functionId].distMergeFunc(&pCtx[i]);
   }
 }
@@ -2718,49 +3148,12 @@ void UNUSED_FUNC displayInterResult(tFilePage **pdata, SQueryRuntimeEnv* pRuntim
   }
 }
 
-typedef struct SCompSupporter {
-  STableQueryInfo **pTableQueryInfo;
-  int32_t *         position;
-  SQInfo *          pQInfo;
-} SCompSupporter;
-
-int32_t tableResultComparFn(const void *pLeft, const void *pRight, void *param) {
-  int32_t left = *(int32_t *)pLeft;
-  int32_t right = *(int32_t *)pRight;
-
-  SCompSupporter *  supporter = (SCompSupporter *)param;
-  SQueryRuntimeEnv *pRuntimeEnv = &supporter->pQInfo->runtimeEnv;
-
-  int32_t leftPos = supporter->position[left];
-  int32_t rightPos = supporter->position[right];
+// the window results of each table are in the ascending order of the start timestamp
+static uint64_t getWindowResMergeKey(SQueryRuntimeEnv *pRuntimeEnv, STableQueryInfo *pTableQueryInfo, int32_t pos) {
+  SWindowResult *pWindowRes = getWindowResult(&pTableQueryInfo->windowResInfo, pos);
 
-  /* left source is exhausted */
-  if (leftPos == -1) {
-    return 1;
-  }
-
-  /* right source is exhausted*/
-  if (rightPos == -1) {
-    return -1;
-  }
-
-  SWindowResInfo *pWindowResInfo1 = &supporter->pTableQueryInfo[left]->windowResInfo;
-  SWindowResult * pWindowRes1 = getWindowResult(pWindowResInfo1, leftPos);
-
-  char *b1 = getPosInResultPage(pRuntimeEnv, PRIMARYKEY_TIMESTAMP_COL_INDEX, pWindowRes1);
-  TSKEY leftTimestamp = GET_INT64_VAL(b1);
-
-  SWindowResInfo *pWindowResInfo2 = &supporter->pTableQueryInfo[right]->windowResInfo;
-  SWindowResult * pWindowRes2 = getWindowResult(pWindowResInfo2, rightPos);
-
-  char *b2 = getPosInResultPage(pRuntimeEnv, PRIMARYKEY_TIMESTAMP_COL_INDEX, pWindowRes2);
-  TSKEY rightTimestamp = GET_INT64_VAL(b2);
-
-  if (leftTimestamp == rightTimestamp) {
-    return 0;
-  }
-
-  return leftTimestamp > rightTimestamp ? 1 : -1;
+  char *b = getPosInResultPage(pRuntimeEnv, PRIMARYKEY_TIMESTAMP_COL_INDEX, pWindowRes);
+  return MERGE_TREE_KEY(GET_INT64_VAL(b), TSDB_ORDER_ASC);
 }
 
 int32_t mergeIntoGroupResult(SQInfo *pQInfo) {
@@ -2901,23 +3294,32 @@ int32_t mergeIntoGroupResultImpl(SQInfo *pQInfo, SArray *pGroup) {
     return 0;
   }
 
-  SCompSupporter cs = {pTableList, posList, pQInfo};
+  SMergeTree *pTree = tMergeTreeCreate(numOfTables);
+  if (pTree == NULL) {
+    tfree(posList);
+    tfree(pTableList);
+    return -1;
+  }
+
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    tMergeTreeSetKey(pTree, i, getWindowResMergeKey(pRuntimeEnv, pTableList[i], 0));
+  }
 
-  SLoserTreeInfo *pTree = NULL;
-  tLoserTreeCreate(&pTree, numOfTables, &cs, tableResultComparFn);
+  tMergeTreeBuild(pTree);
 
   SResultInfo *pResultInfo = calloc(pQuery->numOfOutput, sizeof(SResultInfo));
   setWindowResultInfo(pResultInfo, pQuery, pRuntimeEnv->stableQuery);
   resetMergeResultBuf(pQuery, pRuntimeEnv->pCtx, pResultInfo);
 
   int64_t lastTimestamp = -1;
+  int64_t lastEnd = -1;  // end of the last merged session window
   int64_t startt = taosGetTimestampMs();
 
   while (1) {
-    int32_t pos = pTree->pNode[0].index;
+    int32_t pos = pTree->winner;
 
     SWindowResInfo *pWindowResInfo = &pTableList[pos]->windowResInfo;
-    SWindowResult * pWindowRes = getWindowResult(pWindowResInfo, cs.position[pos]);
+    SWindowResult * pWindowRes = getWindowResult(pWindowResInfo, posList[pos]);
 
     char *b = getPosInResultPage(pRuntimeEnv, PRIMARYKEY_TIMESTAMP_COL_INDEX, pWindowRes);
     TSKEY ts = GET_INT64_VAL(b);
@@ -2925,19 +3327,27 @@ int32_t mergeIntoGroupResultImpl(SQInfo *pQInfo, SArray *pGroup) {
     assert(ts == pWindowRes->window.skey);
     int64_t num = getNumOfResultWindowRes(pRuntimeEnv, pWindowRes);
     if (num <= 0) {
-      cs.position[pos] += 1;
+      posList[pos] += 1;
 
-      if (cs.position[pos] >= pWindowResInfo->size) {
-        cs.position[pos] = -1;
+      if (posList[pos] >= pWindowResInfo->size) {
+        posList[pos] = -1;
+        tMergeTreeExhaust(pTree);
 
         // all input sources are exhausted
         if (--numOfTables == 0) {
           break;
         }
+
+        continue;
       }
     } else {
-      if (ts == lastTimestamp) {  // merge with the last one
+      // the session windows of different tables are merged if the gap between them is no larger than the session gap
+      bool merge = (ts == lastTimestamp) || (pQuery->windowType == TSDB_WINDOW_SESSION && lastTimestamp != -1 &&
+                                             ts - lastEnd <= pQuery->sessionGap);
+
+      if (merge) {  // merge with the last one
         doMerge(pRuntimeEnv, ts, pWindowRes, true);
+        lastEnd = MAX(lastEnd, pWindowRes->window.ekey);
       } else {  // copy data to disk buffer
         if (buffer[0]->num == pQuery->rec.capacity) {
           if (flushFromResultBuf(pQInfo) != TSDB_CODE_SUCCESS) {
@@ -2949,22 +3359,26 @@ int32_t mergeIntoGroupResultImpl(SQInfo *pQInfo, SArray *pGroup) {
 
         doMerge(pRuntimeEnv, ts, pWindowRes, false);
         buffer[0]->num += 1;
+        lastEnd = pWindowRes->window.ekey;
       }
 
       lastTimestamp = ts;
 
-      cs.position[pos] += 1;
-      if (cs.position[pos] >= pWindowResInfo->size) {
-        cs.position[pos] = -1;
+      posList[pos] += 1;
+      if (posList[pos] >= pWindowResInfo->size) {
+        posList[pos] = -1;
+        tMergeTreeExhaust(pTree);
 
         // all input sources are exhausted
         if (--numOfTables == 0) {
           break;
         }
+
+        continue;
       }
     }
 
-    tLoserTreeAdjust(pTree, pos + pTree->numOfEntries);
+    tMergeTreeAdvance(pTree, getWindowResMergeKey(pRuntimeEnv, pTableList[pos], posList[pos]));
   }
 
   if (buffer[0]->num != 0) {  // there are data in buffer
@@ -3106,7 +3520,7 @@ void disableFuncInReverseScan(SQInfo *pQInfo) {
 
   // group by normal columns and interval query on normal table
   SWindowResInfo *pWindowResInfo = &pRuntimeEnv->windowResInfo;
-  if (isGroupbyNormalCol(pQuery->pGroupbyExpr) || isIntervalQuery(pQuery)) {
+  if (isGroupbyNormalCol(pQuery->pGroupbyExpr) || isTimeWindowQuery(pQuery)) {
     disableFuncInReverseScanImpl(pQInfo, pWindowResInfo, order);
   } else {  // for simple result of table query,
     for (int32_t j = 0; j < pQuery->numOfOutput; ++j) {  // todo refactor
@@ -3277,9 +3691,12 @@ bool needScanDataBlocksAgain(SQueryRuntimeEnv *pRuntimeEnv) {
   SQuery *pQuery = pRuntimeEnv->pQuery;
 
   bool toContinue = false;
-  if (isGroupbyNormalCol(pQuery->pGroupbyExpr) || isIntervalQuery(pQuery)) {
+  if (isGroupbyNormalCol(pQuery->pGroupbyExpr) || isTimeWindowQuery(pQuery)) {
     // for each group result, call the finalize function for each column
     SWindowResInfo *pWindowResInfo = &pRuntimeEnv->windowResInfo;
+    if (isSessionOrStateWindowQuery(pQuery)) {
+      closeAllTimeWindow(pWindowResInfo);
+    }
 
     for (int32_t i = 0; i < pWindowResInfo->size; ++i) {
       SWindowResult *pResult = getWindowResult(pWindowResInfo, i);
@@ -3468,10 +3885,10 @@ void scanAllDataBlocks(SQueryRuntimeEnv *pRuntimeEnv, TSKEY start) {
 void finalizeQueryResult(SQueryRuntimeEnv *pRuntimeEnv) {
   SQuery *pQuery = pRuntimeEnv->pQuery;
 
-  if (isGroupbyNormalCol(pQuery->pGroupbyExpr) || isIntervalQuery(pQuery)) {
+  if (isGroupbyNormalCol(pQuery->pGroupbyExpr) || isTimeWindowQuery(pQuery)) {
     // for each group result, call the finalize function for each column
     SWindowResInfo *pWindowResInfo = &pRuntimeEnv->windowResInfo;
-    if (isGroupbyNormalCol(pQuery->pGroupbyExpr)) {
+    if (isGroupbyNormalCol(pQuery->pGroupbyExpr) || isSessionOrStateWindowQuery(pQuery)) {
       closeAllTimeWindow(pWindowResInfo);
     }
 
@@ -3712,7 +4129,7 @@ static int32_t getNumOfSubset(SQInfo *pQInfo) {
   SQuery *pQuery = pQInfo->runtimeEnv.pQuery;
 
   int32_t totalSubset = 0;
-  if (isGroupbyNormalCol(pQuery->pGroupbyExpr) || (isIntervalQuery(pQuery))) {
+  if (isGroupbyNormalCol(pQuery->pGroupbyExpr) || (isTimeWindowQuery(pQuery))) {
     totalSubset = numOfClosedTimeWindow(&pQInfo->runtimeEnv.windowResInfo);
   } else {
     totalSubset = taosArrayGetSize(pQInfo->groupInfo.pGroupList);
@@ -3810,7 +4227,7 @@ static void updateWindowResNumOfRes(SQueryRuntimeEnv *pRuntimeEnv, STableQueryIn
   SQuery *pQuery = pRuntimeEnv->pQuery;
 
   // update the number of result for each, only update the number of rows for the corresponding window result.
-  if (pQuery->intervalTime == 0) {
+  if (!isTimeWindowQuery(pQuery)) {
     int32_t g = pTableQueryInfo->groupIdx;
     assert(pRuntimeEnv->windowResInfo.size > 0);
 
@@ -4204,7 +4621,7 @@ static void setupQueryHandle(void* tsdb, SQInfo* pQInfo, bool isSTableQuery) {
     return;
   }
 
-  if (isSTableQuery && (!isIntervalQuery(pQuery)) && (!isFixedOutputQuery(pQuery))) {
+  if (isSTableQuery && (!isTimeWindowQuery(pQuery)) && (!isFixedOutputQuery(pQuery))) {
     return;
   }
 
@@ -4218,7 +4635,7 @@ static void setupQueryHandle(void* tsdb, SQInfo* pQInfo, bool isSTableQuery) {
   if (!isSTableQuery
     && (pQInfo->groupInfo.numOfTables == 1)
     && (cond.order == TSDB_ORDER_ASC) 
-    && (!isIntervalQuery(pQuery))
+    && (!isTimeWindowQuery(pQuery))
     && (!isGroupbyNormalCol(pQuery->pGroupbyExpr))
     && (!isFixedOutputQuery(pQuery))
   ) {
@@ -4256,6 +4673,55 @@ static SFillColInfo* taosCreateFillColInfo(SQuery* pQuery) {
   return pFillCol;
 }
 
+/*
+ * the interval query of functions that only need the pre-aggregated values of each window can be answered by the
+ * rollups of data blocks
+ */
+static bool canUseRollup(SQueryRuntimeEnv *pRuntimeEnv) {
+  SQuery *pQuery = pRuntimeEnv->pQuery;
+
+  if (!isIntervalQuery(pQuery) || pQuery->slidingTime != pQuery->intervalTime || pQuery->numOfFilterCols > 0 ||
+      pRuntimeEnv->pTSBuf != NULL || isGroupbyNormalCol(pQuery->pGroupbyExpr)) {
+    return false;
+  }
+
+  for (int32_t i = 0; i < pQuery->numOfOutput; ++i) {
+    SSqlFuncMsg *pFuncMsg = &pQuery->pSelectExpr[i].base;
+    int32_t      functionId = pFuncMsg->functionId;
+    int16_t      type = pRuntimeEnv->pCtx[i].inputType;
+
+    if (functionId == TSDB_FUNC_TS || functionId == TSDB_FUNC_TAG) {
+      continue;
+    }
+
+    if (TSDB_COL_IS_TAG(pFuncMsg->colInfo.flag)) {
+      return false;
+    }
+
+    if (functionId == TSDB_FUNC_COUNT ||
+        (functionId == TSDB_FUNC_SPREAD && pFuncMsg->colInfo.colId == PRIMARYKEY_TIMESTAMP_COL_INDEX)) {
+      continue;
+    }
+
+    if (functionId != TSDB_FUNC_SUM && functionId != TSDB_FUNC_AVG && functionId != TSDB_FUNC_MIN &&
+        functionId != TSDB_FUNC_MAX && functionId != TSDB_FUNC_SPREAD) {
+      return false;
+    }
+
+    // the timestamp of min/max value is not kept in rollups
+    if ((functionId == TSDB_FUNC_MIN || functionId == TSDB_FUNC_MAX) && pRuntimeEnv->pCtx[i].tagInfo.numOfTagCols > 0) {
+      return false;
+    }
+
+    if (pFuncMsg->colInfo.colId == PRIMARYKEY_TIMESTAMP_COL_INDEX || type < TSDB_DATA_TYPE_TINYINT ||
+        type > TSDB_DATA_TYPE_DOUBLE) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 int32_t doInitQInfo(SQInfo *pQInfo, void *param, void *tsdb, int32_t vgId, bool isSTableQuery) {
   SQueryRuntimeEnv *pRuntimeEnv = &pQInfo->runtimeEnv;
 
@@ -4286,6 +4752,7 @@ int32_t doInitQInfo(SQInfo *pQInfo, void *param, void *tsdb, int32_t vgId, bool
   }
 
   pRuntimeEnv->numOfRowsPerPage = getNumOfRowsInResultPage(pQuery, isSTableQuery);
+  pRuntimeEnv->useRollup = canUseRollup(pRuntimeEnv);
 
   if (isSTableQuery) {
     int32_t rows = getInitialPageNum(pQInfo);
@@ -4294,7 +4761,7 @@ int32_t doInitQInfo(SQInfo *pQInfo, void *param, void *tsdb, int32_t vgId, bool
       return code;
     }
 
-    if (pQuery->intervalTime == 0) {
+    if (!isTimeWindowQuery(pQuery)) {
       int16_t type = TSDB_DATA_TYPE_NULL;
 
       if (isGroupbyNormalCol(pQuery->pGroupbyExpr)) {  // group by columns not tags;
@@ -4306,7 +4773,7 @@ int32_t doInitQInfo(SQInfo *pQInfo, void *param, void *tsdb, int32_t vgId, bool
       initWindowResInfo(&pRuntimeEnv->windowResInfo, pRuntimeEnv, 512, 4096, type);
     }
 
-  } else if (isGroupbyNormalCol(pQuery->pGroupbyExpr) || isIntervalQuery(pQuery)) {
+  } else if (isGroupbyNormalCol(pQuery->pGroupbyExpr) || isTimeWindowQuery(pQuery)) {
     int32_t rows = getInitialPageNum(pQInfo);
     code = createDiskbasedResultBuffer(&pRuntimeEnv->pResultBuf, rows, pQuery->rowSize, pQInfo);
     if (code != TSDB_CODE_SUCCESS) {
@@ -4426,14 +4893,21 @@ static int64_t queryOnDataBlocks(SQInfo *pQInfo) {
 
     SDataStatis *pStatis = NULL;
     
-    SArray *pDataBlock = loadDataBlockOnDemand(pRuntimeEnv, pQueryHandle, &blockInfo, &pStatis);
+    SArray *pDataBlock = NULL;
+    if (loadDataBlockOnDemand(pRuntimeEnv, pQueryHandle, &blockInfo, &pStatis, &pDataBlock) == BLK_DATA_DISCARD) {
+      TSKEY lastKey = QUERY_IS_ASC_QUERY(pQuery) ? blockInfo.window.ekey : blockInfo.window.skey;
+      pTableQueryInfo->lastKey = lastKey + GET_FORWARD_DIRECTION_FACTOR(pQuery->order.order);
+      continue;
+    }
 
-    if (!isIntervalQuery(pQuery)) {
+    if (!isTimeWindowQuery(pQuery)) {
       int32_t step = QUERY_IS_ASC_QUERY(pQuery)? 1:-1;
       setExecutionContext(pQInfo, &pTableQueryInfo->id, pTableQueryInfo->groupIdx, blockInfo.window.ekey + step);
-    } else {  // interval query
-      TSKEY nextKey = blockInfo.window.skey;
-      setIntervalQueryRange(pQInfo, nextKey);
+    } else {  // interval, session or state window query
+      if (isIntervalQuery(pQuery)) {
+        setIntervalQueryRange(pQInfo, blockInfo.window.skey);
+      }
+
       int32_t ret = setAdditionalInfo(pQInfo, &pTableQueryInfo->id, pTableQueryInfo);
 
       if (ret != TSDB_CODE_SUCCESS) {
@@ -4759,7 +5233,7 @@ static void doRestoreContext(SQInfo *pQInfo) {
 static void doCloseAllTimeWindowAfterScan(SQInfo *pQInfo) {
   SQuery *pQuery = pQInfo->runtimeEnv.pQuery;
 
-  if (isIntervalQuery(pQuery)) {
+  if (isTimeWindowQuery(pQuery)) {
     size_t numOfGroup = taosArrayGetSize(pQInfo->groupInfo.pGroupList);
     for (int32_t i = 0; i < numOfGroup; ++i) {
       SArray *group = taosArrayGetP(pQInfo->groupInfo.pGroupList, i);
@@ -4784,7 +5258,7 @@ static void multiTableQueryProcess(SQInfo *pQInfo) {
      * if the groupIndex > 0, the query process must be completed yet, we only need to
      * copy the data into output buffer
      */
-    if (isIntervalQuery(pQuery)) {
+    if (isTimeWindowQuery(pQuery)) {
       copyResToQueryResultBuf(pQInfo, pQuery);
 
 #ifdef _DEBUG_VIEW
@@ -4836,7 +5310,7 @@ static void multiTableQueryProcess(SQInfo *pQInfo) {
     return;
   }
 
-  if (isIntervalQuery(pQuery) || isSumAvgRateQuery(pQuery)) {
+  if (isTimeWindowQuery(pQuery) || isSumAvgRateQuery(pQuery)) {
     if (mergeIntoGroupResult(pQInfo) == TSDB_CODE_SUCCESS) {
       copyResToQueryResultBuf(pQInfo, pQuery);
 
@@ -4959,8 +5433,8 @@ static void tableIntervalProcessImpl(SQueryRuntimeEnv *pRuntimeEnv, TSKEY start)
 
     // here we can ignore the records in case of no interpolation
     // todo handle offset, in case of top/bottom interval query
-    if ((pQuery->numOfFilterCols > 0 || pRuntimeEnv->pTSBuf != NULL) && pQuery->limit.offset > 0 &&
-        pQuery->fillType == TSDB_FILL_NONE) {
+    if ((pQuery->numOfFilterCols > 0 || pRuntimeEnv->pTSBuf != NULL || isSessionOrStateWindowQuery(pQuery)) &&
+        pQuery->limit.offset > 0 && pQuery->fillType == TSDB_FILL_NONE) {
       // maxOutput <= 0, means current query does not generate any results
       int32_t numOfClosed = numOfClosedTimeWindow(&pRuntimeEnv->windowResInfo);
 
@@ -4985,9 +5459,15 @@ static void tableIntervalProcess(SQInfo *pQInfo, STableQueryInfo* pTableInfo) {
   int32_t numOfInterpo = 0;
   TSKEY newStartKey = TSKEY_INITIAL_VAL;
   
-  // skip blocks without load the actual data block from file if no filter condition present
-  skipTimeInterval(pRuntimeEnv, &newStartKey);
-  if (pQuery->limit.offset > 0 && pQuery->numOfFilterCols == 0 && pRuntimeEnv->pFillInfo == NULL) {
+  // skip blocks without load the actual data block from file if no filter condition present, the number of session or
+  // state windows is unknown until the data are scanned, so the offset is applied to the results
+  if (isSessionOrStateWindowQuery(pQuery)) {
+    newStartKey = pQuery->current->lastKey;
+  } else {
+    skipTimeInterval(pRuntimeEnv, &newStartKey);
+  }
+
+  if (!isSessionOrStateWindowQuery(pQuery) && pQuery->limit.offset > 0 && pQuery->numOfFilterCols == 0 && pRuntimeEnv->pFillInfo == NULL) {
     setQueryStatus(pQuery, QUERY_COMPLETED);
     return;
   }
@@ -4995,7 +5475,7 @@ static void tableIntervalProcess(SQInfo *pQInfo, STableQueryInfo* pTableInfo) {
   while (1) {
     tableIntervalProcessImpl(pRuntimeEnv, newStartKey);
 
-    if (isIntervalQuery(pQuery)) {
+    if (isTimeWindowQuery(pQuery)) {
       pQInfo->groupIndex = 0;  // always start from 0
       pQuery->rec.rows = 0;
       copyFromWindowResToSData(pQInfo, pRuntimeEnv->windowResInfo.pResult);
@@ -5061,7 +5541,7 @@ static void tableQueryImpl(SQInfo *pQInfo) {
   if (Q_STATUS_EQUAL(pQuery->status, QUERY_COMPLETED)) {
     // continue to get push data from the group result
     if (isGroupbyNormalCol(pQuery->pGroupbyExpr) ||
-        ((isIntervalQuery(pQuery) && pQuery->rec.total < pQuery->limit.limit))) {
+        ((isTimeWindowQuery(pQuery) && pQuery->rec.total < pQuery->limit.limit))) {
       // todo limit the output for interval query?
       pQuery->rec.rows = 0;
       pQInfo->groupIndex = 0;  // always start from 0
@@ -5093,7 +5573,7 @@ static void tableQueryImpl(SQInfo *pQInfo) {
   SGroupItem* item = taosArrayGet(g, 0);
   
   // group by normal column, sliding window query, interval query are handled by interval query processor
-  if (isIntervalQuery(pQuery) || isGroupbyNormalCol(pQuery->pGroupbyExpr)) {  // interval (down sampling operation)
+  if (isTimeWindowQuery(pQuery) || isGroupbyNormalCol(pQuery->pGroupbyExpr)) {  // interval (down sampling operation)
     tableIntervalProcess(pQInfo, item->info);
   } else if (isFixedOutputQuery(pQuery)) {
     tableFixedOutputProcess(pQInfo, item->info);
@@ -5121,7 +5601,7 @@ static void stableQueryImpl(SQInfo *pQInfo) {
 
   int64_t st = taosGetTimestampUs();
 
-  if (isIntervalQuery(pQuery) ||
+  if (isTimeWindowQuery(pQuery) ||
       (isFixedOutputQuery(pQuery) && (!isPointInterpoQuery(pQuery)) && !isGroupbyNormalCol(pQuery->pGroupbyExpr))) {
     multiTableQueryProcess(pQInfo);
   } else {
@@ -5247,6 +5727,8 @@ static int32_t convertQueryMsg(SQueryTableMsg *pQueryMsg, SArray **pTableIdList,
   pQueryMsg->window.ekey = htobe64(pQueryMsg->window.ekey);
   pQueryMsg->intervalTime = htobe64(pQueryMsg->intervalTime);
   pQueryMsg->slidingTime = htobe64(pQueryMsg->slidingTime);
+  pQueryMsg->sessionGap = htobe64(pQueryMsg->sessionGap);
+  pQueryMsg->stateColId = htons(pQueryMsg->stateColId);
   pQueryMsg->limit = htobe64(pQueryMsg->limit);
   pQueryMsg->offset = htobe64(pQueryMsg->offset);
 
@@ -5298,7 +5780,7 @@ static int32_t convertQueryMsg(SQueryTableMsg *pQueryMsg, SArray **pTableIdList,
       if (pColFilter->filterstr) {
         pColFilter->len = htobe64(pFilterMsg->len);
 
-        pColFilter->pz = (int64_t) calloc(1, pColFilter->len);
+        pColFilter->pz = (int64_t) calloc(1, pColFilter->len + 1);
         memcpy((void *)pColFilter->pz, pMsg, pColFilter->len);
         pMsg += (pColFilter->len + 1);
       } else {
@@ -5702,6 +6184,9 @@ static SQInfo *createQInfoImpl(SQueryTableMsg *pQueryMsg, SArray* pTableIdList,
   pQuery->intervalTime    = pQueryMsg->intervalTime;
   pQuery->slidingTime     = pQueryMsg->slidingTime;
   pQuery->slidingTimeUnit = pQueryMsg->slidingTimeUnit;
+  pQuery->windowType      = pQueryMsg->windowType;
+  pQuery->sessionGap      = pQueryMsg->sessionGap;
+  pQuery->stateColId      = pQueryMsg->stateColId;
   pQuery->fillType     = pQueryMsg->fillType;
   pQuery->numOfTags       = pQueryMsg->numOfTags;
 
@@ -5898,6 +6383,8 @@ static void freeQInfo(SQInfo *pQInfo) {
   setQueryKilled(pQInfo);
 
   qTrace("QInfo:%p start to free QInfo", pQInfo);
+  qCacheRelease(pQInfo);
+
   for (int32_t col = 0; col < pQuery->numOfOutput; ++col) {
     tfree(pQuery->sdata[col]);
   }
@@ -6034,6 +6521,11 @@ static int32_t doDumpQueryResult(SQInfo *pQInfo, char *data) {
     qTrace("QInfo:%p results limitation reached, limitation:%"PRId64, pQInfo, pQuery->limit.limit);
     setQueryStatus(pQuery, QUERY_OVER);
   }
+
+  // the whole result is returned in one round
+  if (Q_STATUS_EQUAL(pQuery->status, QUERY_OVER) && pQuery->rec.total == pQuery->rec.rows && !isQueryKilled(pQInfo)) {
+    qCachePut(pQInfo);
+  }
   
   return TSDB_CODE_SUCCESS;
 
@@ -6135,6 +6627,12 @@ int32_t qCreateQueryInfo(void *tsdb, int32_t vgId, SQueryTableMsg *pQueryMsg, qi
   }
 
   code = initQInfo(pQueryMsg, tsdb, vgId, *pQInfo, isSTableQuery);
+  if (code == TSDB_CODE_SUCCESS && isQueryCacheable(*pQInfo, pQueryMsg, pTableIdList)) {
+    char key[QUERY_CACHE_KEY_LEN] = {0};
+    qCacheBuildKey(pQueryMsg, pExprs, pGroupColIndex, pTagColumnInfo, tagCond, tbnameCond,
+                   &((SQInfo *)(*pQInfo))->tableIdGroupInfo, vgId, key);
+    qCacheLookup(*pQInfo, key, canReuseCachedWindows(*pQInfo));
+  }
 
 _over:
   tfree(tagCond);
@@ -6166,12 +6664,17 @@ void qTableQuery(qinfo_t qinfo) {
 
   qTrace("QInfo:%p query task is launched", pQInfo);
   
-  if (onlyQueryTags(pQInfo->runtimeEnv.pQuery)) {
+  SQuery *pQuery = pQInfo->runtimeEnv.pQuery;
+  if (pQInfo->cacheInfo.exact) {
+    qCacheCopyResult(pQInfo);
+    setQueryStatus(pQuery, QUERY_OVER);
+  } else if (onlyQueryTags(pQuery)) {
     buildTagQueryResult(pQInfo);   // todo support the limit/offset
   } else if (pQInfo->runtimeEnv.stableQuery) {
     stableQueryImpl(pQInfo);
   } else {
     tableQueryImpl(pQInfo);
+    qCacheMergeResult(pQInfo);
   }
   
   sem_post(&pQInfo->dataReady);
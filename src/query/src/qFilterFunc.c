@@ -196,7 +196,8 @@ bool equal_nchar(SColumnFilterElem *pFilter, char *minval, char *maxval) {
     return false;
   }
 
-  return wcsncmp((wchar_t *)pFilter->filterInfo.pz, varDataVal(minval), varDataLen(minval)/TSDB_NCHAR_SIZE) == 0;
+  // the chars of value follow the 2-byte header, so they are not aligned as wchar_t for wcsncmp
+  return memcmp((char *)pFilter->filterInfo.pz, varDataVal(minval), varDataLen(minval)) == 0;
 }
 
 ////////////////////////////////////////////////////////////////
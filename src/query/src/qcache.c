@@ -0,0 +1,538 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "os.h"
+#include "qcache.h"
+#include "qExecutor.h"
+#include "qfill.h"
+#include "queryLog.h"
+#include "hash.h"
+#include "tcache.h"
+#include "tglobal.h"
+#include "tmd5.h"
+#include "ttime.h"
+#include "ttimer.h"
+
+typedef struct SQueryCacheEntry {
+  STimeWindow window;       // time range of the query
+  int64_t     offset;       // remained offset after the query is executed
+  int32_t     numOfRows;
+  int32_t     rowSize;
+  int32_t     numOfTables;
+  char        data[];       // SQueryCacheTable array of the snapshot, then the result of each column in turn
+} SQueryCacheEntry;
+
+#define GET_CACHE_ENTRY_TABLES(_e) ((SQueryCacheTable *)(_e)->data)
+#define GET_CACHE_ENTRY_RESULT(_e) ((_e)->data + sizeof(SQueryCacheTable) * (_e)->numOfTables)
+
+#define MD5_UPDATE_FIELD(_ctx, _f) MD5Update((_ctx), (uint8_t *)&(_f), sizeof(_f))
+
+/*
+ * The entries are recorded in the order they are put, the earliest ones are evicted once the size of the cache is
+ * over tsQueryCacheSize. All of them are kept for the same duration, so they also expire in this order.
+ */
+typedef struct SQueryCacheRecord {
+  struct SQueryCacheRecord *prev;
+  struct SQueryCacheRecord *next;
+  int64_t                   expiredTime;
+  int64_t                   size;
+  char                      key[QUERY_CACHE_KEY_LEN];
+} SQueryCacheRecord;
+
+typedef struct SQueryCacheRecords {
+  pthread_mutex_t    mutex;
+  SHashObj *         pHash;  // key -> SQueryCacheRecord *
+  SQueryCacheRecord *pHead;
+  SQueryCacheRecord *pTail;
+  int64_t            totalSize;
+} SQueryCacheRecords;
+
+static SCacheObj *        tsQueryCache = NULL;
+static void *             tsQueryCacheTmr = NULL;
+static SQueryCacheRecords tsQueryCacheRecords = {0};
+static pthread_once_t     queryCacheModuleInit = PTHREAD_ONCE_INIT;
+
+static void queryCacheInitImpl() {
+  tsQueryCacheTmr = taosTmrInit(100, 200, 60000, "QCH");
+  if (tsQueryCacheTmr == NULL) {
+    qError("failed to init timer of the query result cache");
+    return;
+  }
+
+  pthread_mutex_init(&tsQueryCacheRecords.mutex, NULL);
+  tsQueryCacheRecords.pHash = taosHashInit(1024, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false);
+  if (tsQueryCacheRecords.pHash == NULL) {
+    qError("failed to init the records of the query result cache");
+    return;
+  }
+
+  tsQueryCache = taosCacheInit(tsQueryCacheTmr, 10);
+  if (tsQueryCache == NULL) {
+    qError("failed to init the query result cache");
+  }
+}
+
+static void unlinkCacheRecord(SQueryCacheRecords *pRecords, SQueryCacheRecord *pRecord) {
+  if (pRecord->prev != NULL) {
+    pRecord->prev->next = pRecord->next;
+  } else {
+    pRecords->pHead = pRecord->next;
+  }
+
+  if (pRecord->next != NULL) {
+    pRecord->next->prev = pRecord->prev;
+  } else {
+    pRecords->pTail = pRecord->prev;
+  }
+
+  taosHashRemove(pRecords->pHash, pRecord->key, strlen(pRecord->key));
+  pRecords->totalSize -= pRecord->size;
+  free(pRecord);
+}
+
+/*
+ * Make room for an entry of the given size, the expired entries are only dropped from the records since they are
+ * removed by the refresh of the cache, the others are removed once they are not referenced by the queries.
+ */
+static bool reserveCacheSpace(SQueryCacheRecords *pRecords, const char *key, int64_t size) {
+  int64_t maxSize = (int64_t)tsQueryCacheSize * 1024 * 1024;
+  if (size > maxSize) {
+    return false;
+  }
+
+  SQueryCacheRecord **p = taosHashGet(pRecords->pHash, key, strlen(key));
+  if (p != NULL) {  // the entry of the key is replaced
+    unlinkCacheRecord(pRecords, *p);
+  }
+
+  int64_t now = taosGetTimestampMs();
+  while (pRecords->pHead != NULL && pRecords->pHead->expiredTime <= now) {
+    unlinkCacheRecord(pRecords, pRecords->pHead);
+  }
+
+  while (pRecords->pHead != NULL && pRecords->totalSize + size > maxSize) {
+    SQueryCacheRecord *pRecord = pRecords->pHead;
+
+    void *pEntry = taosCacheAcquireByName(tsQueryCache, pRecord->key);
+    if (pEntry != NULL) {
+      taosCacheRelease(tsQueryCache, &pEntry, true);
+    }
+
+    qTrace("query cache key:%s evicted, size:%" PRId64 ", total:%" PRId64, pRecord->key, pRecord->size,
+           pRecords->totalSize);
+    unlinkCacheRecord(pRecords, pRecord);
+  }
+
+  return true;
+}
+
+static void addCacheRecord(SQueryCacheRecords *pRecords, const char *key, int64_t size) {
+  SQueryCacheRecord *pRecord = calloc(1, sizeof(SQueryCacheRecord));
+  if (pRecord == NULL) {
+    return;
+  }
+
+  strncpy(pRecord->key, key, QUERY_CACHE_KEY_LEN - 1);
+  pRecord->size = size;
+  pRecord->expiredTime = taosGetTimestampMs() + (int64_t)tsQueryCacheKeepTimer * 1000;
+
+  pRecord->prev = pRecords->pTail;
+  if (pRecords->pTail != NULL) {
+    pRecords->pTail->next = pRecord;
+  } else {
+    pRecords->pHead = pRecord;
+  }
+  pRecords->pTail = pRecord;
+
+  taosHashPut(pRecords->pHash, pRecord->key, strlen(pRecord->key), &pRecord, sizeof(pRecord));
+  pRecords->totalSize += size;
+}
+
+static void hashColumnFilters(MD5_CTX *ctx, SColumnInfo *pCol) {
+  for (int32_t f = 0; f < pCol->numOfFilters; ++f) {
+    SColumnFilterInfo *pFilter = &pCol->filters[f];
+    MD5_UPDATE_FIELD(ctx, pFilter->lowerRelOptr);
+    MD5_UPDATE_FIELD(ctx, pFilter->upperRelOptr);
+    MD5_UPDATE_FIELD(ctx, pFilter->filterstr);
+
+    if (pFilter->filterstr) {
+      MD5_UPDATE_FIELD(ctx, pFilter->len);
+      MD5Update(ctx, (uint8_t *)pFilter->pz, (unsigned int)pFilter->len);
+    } else {
+      MD5_UPDATE_FIELD(ctx, pFilter->lowerBndi);
+      MD5_UPDATE_FIELD(ctx, pFilter->upperBndi);
+    }
+  }
+}
+
+static void hashFuncMsg(MD5_CTX *ctx, SSqlFuncMsg *pExprMsg) {
+  MD5_UPDATE_FIELD(ctx, pExprMsg->functionId);
+  MD5_UPDATE_FIELD(ctx, pExprMsg->colInfo.colId);
+  MD5_UPDATE_FIELD(ctx, pExprMsg->colInfo.colIndex);
+  MD5_UPDATE_FIELD(ctx, pExprMsg->colInfo.flag);
+  MD5_UPDATE_FIELD(ctx, pExprMsg->numOfParams);
+
+  for (int32_t j = 0; j < pExprMsg->numOfParams; ++j) {
+    MD5_UPDATE_FIELD(ctx, pExprMsg->arg[j].argType);
+    MD5_UPDATE_FIELD(ctx, pExprMsg->arg[j].argBytes);
+
+    if (pExprMsg->arg[j].argType == TSDB_DATA_TYPE_BINARY) {
+      MD5Update(ctx, (uint8_t *)pExprMsg->arg[j].argValue.pz, pExprMsg->arg[j].argBytes);
+    } else {
+      MD5_UPDATE_FIELD(ctx, pExprMsg->arg[j].argValue.i64);
+    }
+  }
+}
+
+/*
+ * The key consists of everything in the query message except the time window, and the tables in each group that
+ * are resolved from the tag condition, so a new table of the super table leads to a different key.
+ */
+void qCacheBuildKey(SQueryTableMsg *pQueryMsg, SExprInfo *pExprs, SColIndex *pGroupColIndex,
+                    SColumnInfo *pTagCols, char *tagCond, char *tbnameCond, STableGroupInfo *pGroupInfo, int32_t vgId,
+                    char *key) {
+  MD5_CTX ctx;
+  MD5Init(&ctx);
+
+  MD5_UPDATE_FIELD(&ctx, vgId);
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->queryType);
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->order);
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->orderColId);
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->intervalTime);
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->slidingTime);
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->slidingTimeUnit);
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->limit);
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->offset);
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->orderByIdx);
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->orderType);
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->tagNameRelType);
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->fillType);
+
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->numOfCols);
+  for (int32_t i = 0; i < pQueryMsg->numOfCols; ++i) {
+    SColumnInfo *pCol = &pQueryMsg->colList[i];
+    MD5_UPDATE_FIELD(&ctx, pCol->colId);
+    MD5_UPDATE_FIELD(&ctx, pCol->type);
+    MD5_UPDATE_FIELD(&ctx, pCol->bytes);
+    MD5_UPDATE_FIELD(&ctx, pCol->numOfFilters);
+    hashColumnFilters(&ctx, pCol);
+  }
+
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->numOfOutput);
+  for (int32_t i = 0; i < pQueryMsg->numOfOutput; ++i) {
+    hashFuncMsg(&ctx, &pExprs[i].base);
+  }
+
+  if (pQueryMsg->fillType != TSDB_FILL_NONE) {
+    MD5Update(&ctx, (uint8_t *)pQueryMsg->fillVal, sizeof(int64_t) * pQueryMsg->numOfOutput);
+  }
+
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->numOfGroupCols);
+  for (int32_t i = 0; i < pQueryMsg->numOfGroupCols; ++i) {
+    MD5_UPDATE_FIELD(&ctx, pGroupColIndex[i].colId);
+    MD5_UPDATE_FIELD(&ctx, pGroupColIndex[i].colIndex);
+    MD5_UPDATE_FIELD(&ctx, pGroupColIndex[i].flag);
+  }
+
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->numOfTags);
+  for (int32_t i = 0; i < pQueryMsg->numOfTags; ++i) {
+    MD5_UPDATE_FIELD(&ctx, pTagCols[i].colId);
+    MD5_UPDATE_FIELD(&ctx, pTagCols[i].type);
+    MD5_UPDATE_FIELD(&ctx, pTagCols[i].bytes);
+  }
+
+  MD5_UPDATE_FIELD(&ctx, pQueryMsg->tagCondLen);
+  if (tagCond != NULL) {
+    MD5Update(&ctx, (uint8_t *)tagCond, pQueryMsg->tagCondLen);
+  }
+
+  if (tbnameCond != NULL) {
+    MD5Update(&ctx, (uint8_t *)tbnameCond, (unsigned int)strlen(tbnameCond));
+  }
+
+  size_t numOfGroups = taosArrayGetSize(pGroupInfo->pGroupList);
+  for (int32_t i = 0; i < numOfGroups; ++i) {
+    SArray *pa = taosArrayGetP(pGroupInfo->pGroupList, i);
+    int32_t num = (int32_t)taosArrayGetSize(pa);
+    MD5_UPDATE_FIELD(&ctx, num);
+
+    for (int32_t j = 0; j < num; ++j) {
+      STableId *id = taosArrayGet(pa, j);
+      MD5_UPDATE_FIELD(&ctx, id->uid);
+      MD5_UPDATE_FIELD(&ctx, id->tid);
+    }
+  }
+
+  MD5Final(&ctx);
+  for (int32_t i = 0; i < tListLen(ctx.digest); ++i) {
+    sprintf(key + i * 2, "%02x", ctx.digest[i]);
+  }
+}
+
+/*
+ * Rows no later than the returned key are unchanged since the entry is kept in cache, INT64_MIN if the entry is not
+ * valid any more, INT64_MAX if none of the tables is changed.
+ */
+static TSKEY getEntryValidKey(SQueryCacheInfo *pCache, SQueryCacheEntry *pEntry) {
+  if (pEntry->numOfTables != pCache->numOfTables) {
+    return INT64_MIN;
+  }
+
+  TSKEY             validKey = INT64_MAX;
+  SQueryCacheTable *pTables = GET_CACHE_ENTRY_TABLES(pEntry);
+
+  for (int32_t i = 0; i < pCache->numOfTables; ++i) {
+    SQueryCacheTable *pOld = &pTables[i];
+    SQueryCacheTable *pNew = &pCache->pTables[i];
+
+    if (pOld->uid != pNew->uid || pOld->version != pNew->version) {
+      return INT64_MIN;
+    }
+
+    if (pOld->lastKey != pNew->lastKey && pOld->lastKey < validKey) {
+      validKey = pOld->lastKey;
+    }
+  }
+
+  return validKey;
+}
+
+/*
+ * Only the whole windows in the time range that are no later than the valid key are reused, the first and last
+ * window of the cached result may only cover part of the window.
+ */
+static bool getReusedWindows(SQuery *pQuery, SQueryCacheEntry *pEntry, TSKEY validKey, STimeWindow *pReuse) {
+  TSKEY skey = MAX(pEntry->window.skey, pQuery->window.skey);
+  TSKEY ekey = MIN(MIN(pEntry->window.ekey, pQuery->window.ekey), validKey);
+  if (pEntry->window.skey > pEntry->window.ekey || skey > ekey) {
+    return false;
+  }
+
+  int64_t interval = pQuery->intervalTime;
+
+  TSKEY start = taosGetIntervalStartTimestamp(skey, interval, pQuery->slidingTimeUnit, pQuery->precision);
+  if (start < skey) {
+    start += interval;
+  }
+
+  TSKEY end = taosGetIntervalStartTimestamp(ekey, interval, pQuery->slidingTimeUnit, pQuery->precision);
+  if (ekey - end < interval - 1) {
+    end -= interval;
+  }
+
+  if (start > end) {
+    return false;
+  }
+
+  pReuse->skey = start;
+  pReuse->ekey = end + interval - 1;
+  return true;
+}
+
+void qCacheLookup(SQInfo *pQInfo, const char *key, bool reusePrefix) {
+  SQueryCacheInfo *pCache = &pQInfo->cacheInfo;
+
+  pthread_once(&queryCacheModuleInit, queryCacheInitImpl);
+  if (tsQueryCache == NULL) {
+    return;
+  }
+
+  pCache->numOfTables = (int32_t)pQInfo->tableIdGroupInfo.numOfTables;
+  pCache->pTables = calloc(pCache->numOfTables, sizeof(SQueryCacheTable));
+  if (pCache->pTables == NULL) {
+    return;
+  }
+
+  int32_t index = 0;
+  size_t  numOfGroups = taosArrayGetSize(pQInfo->tableIdGroupInfo.pGroupList);
+  for (int32_t i = 0; i < numOfGroups; ++i) {
+    SArray *pa = taosArrayGetP(pQInfo->tableIdGroupInfo.pGroupList, i);
+    size_t  num = taosArrayGetSize(pa);
+
+    for (int32_t j = 0; j < num && index < pCache->numOfTables; ++j, ++index) {
+      STableId *        id = taosArrayGet(pa, j);
+      SQueryCacheTable *pTable = &pCache->pTables[index];
+
+      pTable->uid = id->uid;
+      pTable->version = tsdbGetTableDataVersion(pQInfo->tsdb, id->uid);
+      pTable->lastKey = tsdbGetTableLastKey(pQInfo->tsdb, id->uid);
+      if (pTable->version < 0) {  // dropped during the query
+        return;
+      }
+    }
+  }
+
+  qCacheFind(pQInfo, key, reusePrefix);
+}
+
+void qCacheFind(SQInfo *pQInfo, const char *key, bool reusePrefix) {
+  SQueryCacheInfo *pCache = &pQInfo->cacheInfo;
+  SQuery *         pQuery = pQInfo->runtimeEnv.pQuery;
+
+  pthread_once(&queryCacheModuleInit, queryCacheInitImpl);
+  if (tsQueryCache == NULL || pCache->pTables == NULL) {
+    return;
+  }
+
+  strncpy(pCache->key, key, QUERY_CACHE_KEY_LEN - 1);
+  pCache->window = pQuery->window;
+
+  SQueryCacheEntry *pEntry = taosCacheAcquireByName(tsQueryCache, key);
+  if (pEntry == NULL) {
+    qTrace("QInfo:%p query cache key:%s not found", pQInfo, key);
+    return;
+  }
+
+  TSKEY validKey = getEntryValidKey(pCache, pEntry);
+  if (validKey == INT64_MIN || pEntry->rowSize != pQuery->rowSize || pEntry->numOfRows > pQuery->rec.capacity) {
+    qTrace("QInfo:%p query cache key:%s is out of date", pQInfo, key);
+    taosCacheRelease(tsQueryCache, (void **)&pEntry, false);
+    return;
+  }
+
+  TSKEY ekey = MAX(pQuery->window.skey, pQuery->window.ekey);
+  if (pEntry->window.skey == pQuery->window.skey && pEntry->window.ekey == pQuery->window.ekey && validKey >= ekey) {
+    pCache->pEntry = pEntry;
+    pCache->exact = true;
+    qTrace("QInfo:%p query cache key:%s hit, rows:%d", pQInfo, key, pEntry->numOfRows);
+  } else if (reusePrefix && getReusedWindows(pQuery, pEntry, validKey, &pCache->reuse)) {
+    pCache->pEntry = pEntry;
+    qTrace("QInfo:%p query cache key:%s windows in %" PRId64 "-%" PRId64 " reused", pQInfo, key, pCache->reuse.skey,
+           pCache->reuse.ekey);
+  } else {
+    taosCacheRelease(tsQueryCache, (void **)&pEntry, false);
+  }
+}
+
+void qCacheCopyResult(SQInfo *pQInfo) {
+  SQueryCacheEntry *pEntry = pQInfo->cacheInfo.pEntry;
+  SQuery *          pQuery = pQInfo->runtimeEnv.pQuery;
+
+  char *src = GET_CACHE_ENTRY_RESULT(pEntry);
+  for (int32_t col = 0; col < pQuery->numOfOutput; ++col) {
+    int32_t bytes = pQuery->pSelectExpr[col].bytes;
+
+    memcpy(pQuery->sdata[col]->data, src, bytes * pEntry->numOfRows);
+    src += bytes * pEntry->numOfRows;
+  }
+
+  pQuery->rec.rows = pEntry->numOfRows;
+  pQuery->limit.offset = pEntry->offset;
+}
+
+static int32_t lowerBoundOfKey(TSKEY *keys, int32_t numOfRows, TSKEY key) {
+  int32_t i = 0;
+  while (i < numOfRows && keys[i] < key) {
+    i++;
+  }
+
+  return i;
+}
+
+void qCacheMergeResult(SQInfo *pQInfo) {
+  SQueryCacheInfo * pCache = &pQInfo->cacheInfo;
+  SQueryCacheEntry *pEntry = pCache->pEntry;
+  SQuery *          pQuery = pQInfo->runtimeEnv.pQuery;
+
+  if (pEntry == NULL || pCache->exact || pQuery->rec.total > 0) {
+    return;
+  }
+
+  // the first column is the start key of each window
+  char *  src = GET_CACHE_ENTRY_RESULT(pEntry);
+  int32_t start = lowerBoundOfKey((TSKEY *)src, pEntry->numOfRows, pCache->reuse.skey);
+  int32_t numOfReused = lowerBoundOfKey((TSKEY *)src, pEntry->numOfRows, pCache->reuse.ekey + 1) - start;
+
+  // the windows computed in the reused range are incomplete, since the blocks in this range are skipped
+  TSKEY * keys = (TSKEY *)pQuery->sdata[0]->data;
+  int32_t head = lowerBoundOfKey(keys, (int32_t)pQuery->rec.rows, pCache->reuse.skey);
+  int32_t tail = lowerBoundOfKey(keys, (int32_t)pQuery->rec.rows, pCache->reuse.ekey + 1);
+  int32_t numOfTail = (int32_t)pQuery->rec.rows - tail;
+
+  assert(head + numOfReused + numOfTail <= pQuery->rec.capacity);
+
+  for (int32_t col = 0; col < pQuery->numOfOutput; ++col) {
+    int32_t bytes = pQuery->pSelectExpr[col].bytes;
+    char *  dst = pQuery->sdata[col]->data;
+
+    memmove(dst + (head + numOfReused) * bytes, dst + tail * bytes, numOfTail * bytes);
+    memcpy(dst + head * bytes, src + start * bytes, numOfReused * bytes);
+    src += bytes * pEntry->numOfRows;
+  }
+
+  qTrace("QInfo:%p %d windows from query cache, %d computed windows before and %d after", pQInfo, numOfReused, head,
+         numOfTail);
+  pQuery->rec.rows = head + numOfReused + numOfTail;
+}
+
+void qCachePut(SQInfo *pQInfo) {
+  SQueryCacheInfo *pCache = &pQInfo->cacheInfo;
+  SQuery *         pQuery = pQInfo->runtimeEnv.pQuery;
+
+  if (pCache->key[0] == 0 || pCache->exact) {
+    return;
+  }
+
+  int32_t numOfRows = (int32_t)pQuery->rec.rows;
+  size_t  size = sizeof(SQueryCacheEntry) + sizeof(SQueryCacheTable) * pCache->numOfTables +
+                 (size_t)pQuery->rowSize * numOfRows;
+
+  SQueryCacheEntry *pEntry = malloc(size);
+  if (pEntry == NULL) {
+    return;
+  }
+
+  pEntry->window = pCache->window;
+  pEntry->offset = pQuery->limit.offset;
+  pEntry->numOfRows = numOfRows;
+  pEntry->rowSize = pQuery->rowSize;
+  pEntry->numOfTables = pCache->numOfTables;
+  memcpy(GET_CACHE_ENTRY_TABLES(pEntry), pCache->pTables, sizeof(SQueryCacheTable) * pCache->numOfTables);
+
+  char *dst = GET_CACHE_ENTRY_RESULT(pEntry);
+  for (int32_t col = 0; col < pQuery->numOfOutput; ++col) {
+    int32_t bytes = pQuery->pSelectExpr[col].bytes;
+
+    memcpy(dst, pQuery->sdata[col]->data, bytes * numOfRows);
+    dst += bytes * numOfRows;
+  }
+
+  SQueryCacheRecords *pRecords = &tsQueryCacheRecords;
+  pthread_mutex_lock(&pRecords->mutex);
+
+  if (reserveCacheSpace(pRecords, pCache->key, (int64_t)size)) {
+    void *p = taosCachePut(tsQueryCache, pCache->key, pEntry, size, tsQueryCacheKeepTimer);
+    if (p != NULL) {
+      addCacheRecord(pRecords, pCache->key, (int64_t)size);
+      qTrace("QInfo:%p query result kept in cache, key:%s rows:%d", pQInfo, pCache->key, numOfRows);
+      taosCacheRelease(tsQueryCache, &p, false);
+    }
+  } else {
+    qTrace("QInfo:%p query result is too large to be cached, key:%s size:%zu", pQInfo, pCache->key, size);
+  }
+
+  pthread_mutex_unlock(&pRecords->mutex);
+  free(pEntry);
+}
+
+void qCacheRelease(SQInfo *pQInfo) {
+  SQueryCacheInfo *pCache = &pQInfo->cacheInfo;
+
+  if (pCache->pEntry != NULL) {
+    taosCacheRelease(tsQueryCache, &pCache->pEntry, false);
+  }
+
+  tfree(pCache->pTables);
+}
@@ -745,6 +745,233 @@ void tColDataQSort(tOrderDescriptor *pDescriptor, int32_t numOfRows, int32_t sta
   }
 }
 
+/*
+ * The rows are sorted by LSD radix sort if all the order columns are of integer types, including timestamp and bool.
+ * The value of each order column is mapped to an unsigned key of the same order, and the (key, row index) pairs are
+ * sorted stably from the last order column to the first one. The rows are moved only once, after all the pairs are
+ * sorted, instead of being swapped column by column for each comparison.
+ */
+#define RADIX_SORT_MIN_ROWS 64
+#define RADIX_SORT_BITS     8
+#define RADIX_SORT_BUCKETS  (1 << RADIX_SORT_BITS)
+#define RADIX_SORT_PASSES   (sizeof(uint64_t) * 8 / RADIX_SORT_BITS)
+
+typedef struct SSortPair {
+  uint64_t key;
+  int32_t  index;
+} SSortPair;
+
+static bool isRadixSortColumn(int32_t type) {
+  return type == TSDB_DATA_TYPE_BOOL || type == TSDB_DATA_TYPE_TINYINT || type == TSDB_DATA_TYPE_SMALLINT ||
+         type == TSDB_DATA_TYPE_INT || type == TSDB_DATA_TYPE_BIGINT || type == TSDB_DATA_TYPE_TIMESTAMP;
+}
+
+// the same order as compare_a/compare_d: only the first timestamp column follows tsOrder, the others are ascending
+static bool isDescOrderColumn(tOrderDescriptor *pDescriptor, int32_t colIdx, int32_t orderType) {
+  if (pDescriptor->pColumnModel->pFields[colIdx].field.type == TSDB_DATA_TYPE_TIMESTAMP) {
+    return colIdx == 0 && pDescriptor->tsOrder == TSDB_ORDER_DESC;
+  }
+
+  return orderType == TSDB_ORDER_DESC;
+}
+
+// flip the sign bit so that the signed values keep their order as unsigned keys, and all bits for the desc order
+#define SET_RADIX_SORT_KEYS(_pairs, _num, _col, _type, _mask)                \
+  do {                                                                        \
+    for (int32_t _i = 0; _i < (_num); ++_i) {                                 \
+      int64_t _v = ((_type *)(_col))[(_pairs)[_i].index];                     \
+      (_pairs)[_i].key = ((uint64_t)_v ^ (1ULL << 63u)) ^ (_mask);            \
+    }                                                                         \
+  } while (0)
+
+static void setRadixSortKeys(SSortPair *pairs, int32_t num, char *col, int32_t type, uint64_t mask) {
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      SET_RADIX_SORT_KEYS(pairs, num, col, int8_t, mask);
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      SET_RADIX_SORT_KEYS(pairs, num, col, int16_t, mask);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      SET_RADIX_SORT_KEYS(pairs, num, col, int32_t, mask);
+      break;
+    default:
+      SET_RADIX_SORT_KEYS(pairs, num, col, int64_t, mask);
+      break;
+  }
+}
+
+/*
+ * The histograms of all the digits are built in one scan, and the digits that are the same for all keys, e.g., the
+ * high bytes of the timestamps in a short time range, are skipped. The sorted pairs are in either pairs or buf.
+ */
+static SSortPair *radixSortPairs(SSortPair *pairs, SSortPair *buf, int32_t num) {
+  int32_t(*hist)[RADIX_SORT_BUCKETS] = calloc(RADIX_SORT_PASSES, sizeof(int32_t) * RADIX_SORT_BUCKETS);
+  if (hist == NULL) {
+    return NULL;
+  }
+
+  for (int32_t i = 0; i < num; ++i) {
+    uint64_t key = pairs[i].key;
+    for (int32_t d = 0; d < RADIX_SORT_PASSES; ++d) {
+      hist[d][(key >> (d * RADIX_SORT_BITS)) & (RADIX_SORT_BUCKETS - 1)] += 1;
+    }
+  }
+
+  SSortPair *src = pairs;
+  SSortPair *dst = buf;
+
+  for (int32_t d = 0; d < RADIX_SORT_PASSES; ++d) {
+    int32_t shift = d * RADIX_SORT_BITS;
+    if (hist[d][(src[0].key >> shift) & (RADIX_SORT_BUCKETS - 1)] == num) {
+      continue;
+    }
+
+    int32_t offset = 0;
+    for (int32_t j = 0; j < RADIX_SORT_BUCKETS; ++j) {
+      int32_t c = hist[d][j];
+      hist[d][j] = offset;
+      offset += c;
+    }
+
+    for (int32_t i = 0; i < num; ++i) {
+      dst[hist[d][(src[i].key >> shift) & (RADIX_SORT_BUCKETS - 1)]++] = src[i];
+    }
+
+    SSortPair *t = src;
+    src = dst;
+    dst = t;
+  }
+
+  free(hist);
+  return src;
+}
+
+// move the rows in [start, start + num) of each column to the sorted positions
+static void permuteColumnData(SColumnModel *pModel, int32_t numOfRows, int32_t start, char *data, SSortPair *pairs,
+                              int32_t num, char *buf) {
+  for (int32_t i = 0; i < pModel->numOfCols; ++i) {
+    int16_t bytes = pModel->pFields[i].field.bytes;
+    char *  col = COLMODEL_GET_VAL(data, pModel, numOfRows, 0, i);
+
+    switch (bytes) {
+      case sizeof(int8_t):
+        for (int32_t j = 0; j < num; ++j) ((int8_t *)buf)[j] = ((int8_t *)col)[pairs[j].index];
+        break;
+      case sizeof(int16_t):
+        for (int32_t j = 0; j < num; ++j) ((int16_t *)buf)[j] = ((int16_t *)col)[pairs[j].index];
+        break;
+      case sizeof(int32_t):
+        for (int32_t j = 0; j < num; ++j) ((int32_t *)buf)[j] = ((int32_t *)col)[pairs[j].index];
+        break;
+      case sizeof(int64_t):
+        for (int32_t j = 0; j < num; ++j) ((int64_t *)buf)[j] = ((int64_t *)col)[pairs[j].index];
+        break;
+      default:
+        for (int32_t j = 0; j < num; ++j) {
+          memcpy(buf + j * bytes, col + pairs[j].index * bytes, bytes);
+        }
+    }
+
+    memcpy(col + start * bytes, buf, num * bytes);
+  }
+}
+
+static bool tColDataRadixSort(tOrderDescriptor *pDescriptor, int32_t numOfRows, int32_t start, int32_t end, char *data,
+                              int32_t orderType) {
+  SColumnModel *pModel = pDescriptor->pColumnModel;
+
+  for (int32_t i = 0; i < pDescriptor->orderIdx.numOfCols; ++i) {
+    if (!isRadixSortColumn(pModel->pFields[pDescriptor->orderIdx.pData[i]].field.type)) {
+      return false;
+    }
+  }
+
+  int16_t maxBytes = 0;
+  for (int32_t i = 0; i < pModel->numOfCols; ++i) {
+    maxBytes = MAX(maxBytes, pModel->pFields[i].field.bytes);
+  }
+
+  int32_t    num = end - start + 1;
+  SSortPair *pairs = malloc(sizeof(SSortPair) * num * 2);
+  char *     buf = malloc((size_t)maxBytes * num);
+  if (pairs == NULL || buf == NULL) {
+    tfree(pairs);
+    tfree(buf);
+    return false;
+  }
+
+  SSortPair *sorted = pairs;
+  for (int32_t i = 0; i < num; ++i) {
+    sorted[i].index = start + i;
+  }
+
+  for (int32_t i = pDescriptor->orderIdx.numOfCols - 1; i >= 0; --i) {
+    int32_t  colIdx = pDescriptor->orderIdx.pData[i];
+    uint64_t mask = isDescOrderColumn(pDescriptor, colIdx, orderType) ? UINT64_MAX : 0;
+
+    setRadixSortKeys(sorted, num, COLMODEL_GET_VAL(data, pModel, numOfRows, 0, colIdx),
+                     pModel->pFields[colIdx].field.type, mask);
+
+    sorted = radixSortPairs(sorted, (sorted == pairs) ? pairs + num : pairs, num);
+    if (sorted == NULL) {
+      free(pairs);
+      free(buf);
+      return false;
+    }
+  }
+
+  permuteColumnData(pModel, numOfRows, start, data, sorted, num, buf);
+
+  free(pairs);
+  free(buf);
+  return true;
+}
+
+void tColDataSort(tOrderDescriptor *pDescriptor, int32_t numOfRows, int32_t start, int32_t end, char *data,
+                  int32_t orderType) {
+  if (end - start + 1 >= RADIX_SORT_MIN_ROWS &&
+      tColDataRadixSort(pDescriptor, numOfRows, start, end, data, orderType)) {
+    return;
+  }
+
+  tColDataQSort(pDescriptor, numOfRows, start, end, data, orderType);
+}
+
+bool tOrderDescHasIntegerKey(tOrderDescriptor *pDescriptor) {
+  return pDescriptor->orderIdx.numOfCols == 1 &&
+         isRadixSortColumn(pDescriptor->pColumnModel->pFields[pDescriptor->orderIdx.pData[0]].field.type);
+}
+
+uint64_t tColDataGetOrderKey(tOrderDescriptor *pDescriptor, int32_t numOfRows, int32_t rowIdx, char *data,
+                             int32_t orderType) {
+  SColumnModel *pModel = pDescriptor->pColumnModel;
+  int32_t       colIdx = pDescriptor->orderIdx.pData[0];
+
+  char *  p = COLMODEL_GET_VAL(data, pModel, numOfRows, rowIdx, colIdx);
+  int64_t v = 0;
+
+  switch (pModel->pFields[colIdx].field.type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      v = *(int8_t *)p;
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      v = *(int16_t *)p;
+      break;
+    case TSDB_DATA_TYPE_INT:
+      v = *(int32_t *)p;
+      break;
+    default:
+      v = *(int64_t *)p;
+      break;
+  }
+
+  uint64_t mask = isDescOrderColumn(pDescriptor, colIdx, orderType) ? UINT64_MAX : 0;
+  return ((uint64_t)v ^ (1ULL << 63u)) ^ mask;
+}
+
 /*
  * deep copy of sschema
  */
@@ -59,6 +59,16 @@ int32_t tSQLParse(SSqlInfo *pSQLInfo, const char *pStr) {
         pSQLInfo->valid = false;
         goto abort_parse;
       }
+
+      // the tokens out of the grammar, see tstoken.h
+      case TK_HEX:
+      case TK_OCT:
+      case TK_BIN:
+      case TK_FILE: {
+        snprintf(pSQLInfo->pzErrMsg, tListLen(pSQLInfo->pzErrMsg), "unsupported token: \"%s\"", t0.z);
+        pSQLInfo->valid = false;
+        goto abort_parse;
+      }
       default:
         Parse(pParser, t0.type, t0, pSQLInfo);
         if (pSQLInfo->valid == false) {
@@ -510,7 +520,8 @@ void tSQLSetColumnType(TAOS_FIELD *pField, SSQLToken *type) {
  */
 SQuerySQL *tSetQuerySQLElems(SSQLToken *pSelectToken, tSQLExprList *pSelection, tVariantList *pFrom, tSQLExpr *pWhere,
                              tVariantList *pGroupby, tVariantList *pSortOrder, SSQLToken *pInterval,
-                             SSQLToken *pSliding, tVariantList *pFill, SLimitVal *pLimit, SLimitVal *pGLimit) {
+                             SWindowClauseVal *pWindow, SSQLToken *pSliding, tVariantList *pFill, SLimitVal *pLimit,
+                             SLimitVal *pGLimit) {
   assert(pSelection != NULL);
 
   SQuerySQL *pQuery = calloc(1, sizeof(SQuerySQL));
@@ -535,6 +546,10 @@ SQuerySQL *tSetQuerySQLElems(SSQLToken *pSelectToken, tSQLExprList *pSelection,
     pQuery->interval = *pInterval;
   }
 
+  if (pWindow != NULL) {
+    pQuery->window = *pWindow;
+  }
+
   if (pSliding != NULL) {
     pQuery->sliding = *pSliding;
   }
@@ -25,7 +25,7 @@
 // All the keywords of the SQL language are stored in a hash table
 typedef struct SKeyword {
   const char* name;  // The keyword name
-  uint8_t     type;  // type
+  uint16_t    type;  // type
   uint8_t     len;   // length
 } SKeyword;
 
@@ -236,6 +236,7 @@ static SKeyword keywordTable[] = {
     {"SUM_IRATE",    TK_SUM_IRATE},
     {"AVG_RATE",     TK_AVG_RATE},
     {"AVG_IRATE",    TK_AVG_IRATE},
+    {"VARIANCE",     TK_VARIANCE},
 };
 
 static const char isIdChar[] = {
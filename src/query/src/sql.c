@@ -97,26 +97,27 @@
 #endif
 /************* Begin control #defines *****************************************/
 #define YYCODETYPE unsigned short int
-#define YYNOCODE 270
+#define YYNOCODE 272
 #define YYACTIONTYPE unsigned short int
 #define ParseTOKENTYPE SSQLToken
 typedef union {
   int yyinit;
   ParseTOKENTYPE yy0;
-  int yy150;
-  SQuerySQL* yy190;
-  SCreateAcctSQL yy219;
-  tSQLExprList* yy260;
-  SSubclauseInfo* yy263;
-  int64_t yy279;
-  SLimitVal yy284;
-  tVariantList* yy322;
-  TAOS_FIELD yy325;
-  tFieldList* yy369;
-  SCreateDBInfo yy374;
-  SCreateTableSQL* yy408;
-  tSQLExpr* yy500;
-  tVariant yy518;
+  SSubclauseInfo* yy25;
+  tSQLExpr* yy66;
+  SCreateAcctSQL yy73;
+  int yy82;
+  SQuerySQL* yy150;
+  SCreateDBInfo yy158;
+  TAOS_FIELD yy181;
+  SLimitVal yy188;
+  tSQLExprList* yy224;
+  int64_t yy271;
+  tVariant yy312;
+  SCreateTableSQL* yy374;
+  tFieldList* yy449;
+  SWindowClauseVal yy458;
+  tVariantList* yy494;
 } YYMINORTYPE;
 #ifndef YYSTACKDEPTH
 #define YYSTACKDEPTH 100
@@ -126,17 +127,17 @@ typedef union {
 #define ParseARG_FETCH SSqlInfo* pInfo = yypParser->pInfo
 #define ParseARG_STORE yypParser->pInfo = pInfo
 #define YYFALLBACK 1
-#define YYNSTATE             247
-#define YYNRULE              220
-#define YYNTOKEN             205
-#define YY_MAX_SHIFT         246
-#define YY_MIN_SHIFTREDUCE   403
-#define YY_MAX_SHIFTREDUCE   622
-#define YY_ERROR_ACTION      623
-#define YY_ACCEPT_ACTION     624
-#define YY_NO_ACTION         625
-#define YY_MIN_REDUCE        626
-#define YY_MAX_REDUCE        845
+#define YYNSTATE             253
+#define YYNRULE              223
+#define YYNTOKEN             206
+#define YY_MAX_SHIFT         252
+#define YY_MIN_SHIFTREDUCE   411
+#define YY_MAX_SHIFTREDUCE   633
+#define YY_ERROR_ACTION      634
+#define YY_ACCEPT_ACTION     635
+#define YY_NO_ACTION         636
+#define YY_MIN_REDUCE        637
+#define YY_MAX_REDUCE        859
 /************* End control #defines *******************************************/
 
 /* Define the yytestcase() macro to be a no-op if is not already defined
@@ -202,217 +203,219 @@ typedef union {
 **  yy_default[]       Default action for each state.
 **
 *********** Begin parsing tables **********************************************/
-#define YY_ACTTAB_COUNT (547)
+#define YY_ACTTAB_COUNT (550)
 static const YYACTIONTYPE yy_action[] = {
- /*     0 */   724,  444,  723,   11,  722,  134,  624,  246,  725,  445,
- /*    10 */   727,  726,  764,   41,   43,   21,   35,   36,  153,  244,
- /*    20 */   135,   29,  135,  444,  203,   39,   37,   40,   38,  158,
- /*    30 */   833,  445,  832,   34,   33,  139,  135,   32,   31,   30,
- /*    40 */    41,   43,  753,   35,   36,  157,  833,  166,   29,  739,
- /*    50 */   103,  203,   39,   37,   40,   38,  188,   21,  103,   99,
- /*    60 */    34,   33,  761,  155,   32,   31,   30,  404,  405,  406,
- /*    70 */   407,  408,  409,  410,  411,  412,  413,  414,  415,  245,
- /*    80 */   444,  742,   41,   43,  103,   35,   36,  103,  445,  168,
- /*    90 */    29,  738,   21,  203,   39,   37,   40,   38,   32,   31,
- /*   100 */    30,   56,   34,   33,  753,  787,   32,   31,   30,   43,
- /*   110 */   191,   35,   36,  788,  829,  198,   29,   21,  154,  203,
- /*   120 */    39,   37,   40,   38,  167,  578,  739,    8,   34,   33,
- /*   130 */    61,  113,   32,   31,   30,  665,   35,   36,  126,   59,
- /*   140 */   200,   29,   58,   17,  203,   39,   37,   40,   38,  221,
- /*   150 */    26,  739,  169,   34,   33,  220,  219,   32,   31,   30,
- /*   160 */    16,  239,  214,  238,  213,  212,  211,  237,  210,  236,
- /*   170 */   235,  209,  720,  828,  709,  710,  711,  712,  713,  714,
- /*   180 */   715,  716,  717,  718,  719,  162,  591,  234,   76,  582,
- /*   190 */   165,  585,  240,  588,  234,  162,  591,   98,  827,  582,
- /*   200 */   225,  585,   60,  588,   26,  162,  591,   12,  742,  582,
- /*   210 */   742,  585,  674,  588,   27,  126,   21,  159,  160,   34,
- /*   220 */    33,  202,  842,   32,   31,   30,  148,  159,  160,  740,
- /*   230 */   536,  539,   88,   87,  142,   18,  666,  159,  160,  126,
- /*   240 */   147,  559,  560,   39,   37,   40,   38,   50,  226,  550,
- /*   250 */   739,   34,   33,   46,  507,   32,   31,   30,  523,  531,
- /*   260 */    17,  520,  151,  521,   51,  522,  190,   26,   16,  239,
- /*   270 */   152,  238,  243,  242,   95,  237,  551,  236,  235,  177,
- /*   280 */    14,   42,  223,  222,  580,  741,  185,  187,  182,  170,
- /*   290 */   171,   42,  590,  584,  150,  587,   74,   78,   83,   86,
- /*   300 */    77,   42,  590,  161,  608,  592,   80,  589,   13,   13,
- /*   310 */   140,  583,  590,  586,  513,   47,  141,  589,   46,  798,
- /*   320 */   581,  116,  117,   68,   64,   67,  143,  589,  130,  128,
- /*   330 */    91,   90,   89,  512,   48,  207,  527,   22,  528,   22,
- /*   340 */   144,    3,   73,   72,   10,    9,  145,  525,  146,  526,
- /*   350 */    85,   84,  137,  797,  133,  138,  136,  163,  794,  524,
- /*   360 */   793,  164,  763,  733,  224,  100,  755,  780,  779,  114,
- /*   370 */    26,  115,  112,  676,  208,  131,   24,  217,  673,  218,
- /*   380 */   841,   70,  840,  838,  118,  694,   25,   93,   23,  132,
- /*   390 */   663,   79,  189,  546,  661,  192,   81,   82,  659,  658,
- /*   400 */   172,  127,  656,  196,  655,  654,  653,  652,  644,  129,
- /*   410 */   650,  648,  646,   52,  752,  767,   49,   44,  768,  781,
- /*   420 */   201,  199,  197,  195,  193,   28,  216,   75,  227,  228,
- /*   430 */   229,  230,  205,  232,  231,   53,  233,  241,  622,  149,
- /*   440 */   173,   62,   65,  174,  176,  175,  621,  178,  179,  180,
- /*   450 */   181,  657,  121,  120,  695,  125,  119,  122,  123,   92,
- /*   460 */   124,  651,    1,  106,  104,  737,   94,  105,  620,  109,
- /*   470 */   107,  108,  110,  111,    2,  184,  613,  183,  186,  190,
- /*   480 */   533,   55,  547,  156,  101,   57,  552,  194,  102,    5,
- /*   490 */     6,   63,  484,  593,    4,   19,   20,   15,  204,    7,
- /*   500 */   206,  481,  479,  478,  477,  475,  448,  215,   66,   45,
- /*   510 */    22,  509,  508,   69,  506,   54,  469,  467,  459,  465,
- /*   520 */   461,  463,  457,  455,   71,  483,  482,  480,  476,  474,
- /*   530 */    46,  446,  419,  417,  626,  625,  625,  625,  625,  625,
- /*   540 */    96,  625,  625,  625,  625,  625,   97,
+ /*     0 */   735,  452,  734,   11,  733,  775,  635,  252,  736,  453,
+ /*    10 */   738,  737,  138,   41,   43,   21,   35,   36,  156,  250,
+ /*    20 */   138,   29,  846,  452,  209,   39,   37,   40,   38,  162,
+ /*    30 */   847,  453,  105,   34,   33,  105,  138,   32,   31,   30,
+ /*    40 */    41,   43,  764,   35,   36,  161,  847,  170,   29,  750,
+ /*    50 */   452,  209,   39,   37,   40,   38,  772,  192,  453,  105,
+ /*    60 */    34,   33,  159,  169,   32,   31,   30,  412,  413,  414,
+ /*    70 */   415,  416,  417,  418,  419,  420,  421,  422,  423,  251,
+ /*    80 */   753,  753,   41,   43,  105,   35,   36,  246,  801,  172,
+ /*    90 */    29,   60,   21,  209,   39,   37,   40,   38,   32,   31,
+ /*   100 */    30,   56,   34,   33,  137,  753,   32,   31,   30,   43,
+ /*   110 */   231,   35,   36,  544,  515,  802,   29,  204,   18,  209,
+ /*   120 */    39,   37,   40,   38,  171,  589,  750,    8,   34,   33,
+ /*   130 */    62,  116,   32,   31,   30,  764,   35,   36,  206,  751,
+ /*   140 */    59,   29,  229,  228,  209,   39,   37,   40,   38,  595,
+ /*   150 */   157,  598,  173,   34,   33,  226,  225,   32,   31,   30,
+ /*   160 */    16,  245,  220,  244,  219,  218,  217,  243,  216,  242,
+ /*   170 */   241,  215,  731,  142,  720,  721,  722,  723,  724,  725,
+ /*   180 */   726,  727,  728,  729,  730,  166,  602,   17,   21,  593,
+ /*   190 */   594,  596,  597,  599,   26,  166,  602,  676,   77,  593,
+ /*   200 */   129,  596,  100,  599,  240,  166,  602,   12,  558,  593,
+ /*   210 */   561,  596,  103,  599,   46,   21,   61,  163,  164,   34,
+ /*   220 */    33,  208,  749,   32,   31,   30,  151,  163,  164,   27,
+ /*   230 */   591,  547,   89,   88,  145,  570,  571,  163,  164,  240,
+ /*   240 */   150,  181,   21,   39,   37,   40,   38,  227,  189,  750,
+ /*   250 */   186,   34,   33,  843,  195,   32,   31,   30,  531,  685,
+ /*   260 */    17,  528,  129,  529,  842,  530,  592,   26,   16,  245,
+ /*   270 */   677,  244,   99,  129,  232,  243,  750,  242,  241,   26,
+ /*   280 */   165,   42,  249,  248,   96,  841,  539,  191,  154,  174,
+ /*   290 */   175,   42,  601,  194,  153,  155,   75,   79,   84,   87,
+ /*   300 */    78,   42,  601,   50,  562,  619,   81,  600,   14,   13,
+ /*   310 */   603,  535,  601,  536,   13,   47,  856,  600,    3,  143,
+ /*   320 */    51,  119,  120,   69,   65,   68,  144,  600,  133,  131,
+ /*   330 */    92,   91,   90,  521,   48,  520,  213,   46,  146,   22,
+ /*   340 */    22,   74,   73,   10,    9,  533,  147,  534,   86,   85,
+ /*   350 */   752,  148,  149,  140,  136,  812,  141,  139,  811,  532,
+ /*   360 */   744,  774,  167,  808,  807,  168,  101,  230,  158,  794,
+ /*   370 */   793,  766,  117,   26,  118,  687,  115,  214,  134,   24,
+ /*   380 */   223,  684,  224,  855,   71,  193,  854,  852,  121,  705,
+ /*   390 */    25,   23,  135,   94,  554,  196,  198,  674,  202,   80,
+ /*   400 */   672,   82,   83,  670,  763,  669,  176,  130,  667,  666,
+ /*   410 */   665,   52,  664,  663,   49,  655,  106,   44,  132,  661,
+ /*   420 */   659,  657,  207,  205,  203,  201,  778,  199,  779,  197,
+ /*   430 */   795,   28,  222,   76,  233,  234,  235,  236,  237,  238,
+ /*   440 */   239,  247,  211,  633,  177,   53,  178,  179,  180,  632,
+ /*   450 */   182,   63,  152,  183,   66,  184,  185,  631,  668,  187,
+ /*   460 */    93,  188,  124,  128,  662,  706,  122,  123,  125,  126,
+ /*   470 */   748,  127,   95,  190,  114,  107,  110,  108,  109,  111,
+ /*   480 */   112,    1,  113,    2,  624,  194,  541,   55,  102,   57,
+ /*   490 */   555,  557,   58,  160,  563,    5,  200,  104,  492,   64,
+ /*   500 */   489,    4,    6,   19,   20,  604,   15,  210,    7,  212,
+ /*   510 */   487,  486,  485,  483,  221,  456,   45,   67,   22,  517,
+ /*   520 */   516,  514,   70,  477,  475,   54,  467,  473,  469,  471,
+ /*   530 */   465,  463,  491,   72,  490,  488,  484,  482,   46,  454,
+ /*   540 */   427,   97,  425,  637,  636,  636,  636,  636,  636,   98,
 };
 static const YYCODETYPE yy_lookahead[] = {
- /*     0 */   225,    1,  227,  258,  229,  258,  206,  207,  233,    9,
- /*    10 */   235,  236,  209,   13,   14,  209,   16,   17,  208,  209,
- /*    20 */   258,   21,  258,    1,   24,   25,   26,   27,   28,  267,
- /*    30 */   268,    9,  268,   33,   34,  258,  258,   37,   38,   39,
- /*    40 */    13,   14,  242,   16,   17,  267,  268,  241,   21,  243,
- /*    50 */   209,   24,   25,   26,   27,   28,  256,  209,  209,  209,
- /*    60 */    33,   34,  259,  226,   37,   38,   39,   45,   46,   47,
+ /*     0 */   226,    1,  228,  260,  230,  210,  207,  208,  234,    9,
+ /*    10 */   236,  237,  260,   13,   14,  210,   16,   17,  209,  210,
+ /*    20 */   260,   21,  270,    1,   24,   25,   26,   27,   28,  269,
+ /*    30 */   270,    9,  210,   33,   34,  210,  260,   37,   38,   39,
+ /*    40 */    13,   14,  243,   16,   17,  269,  270,  242,   21,  244,
+ /*    50 */     1,   24,   25,   26,   27,   28,  261,  258,    9,  210,
+ /*    60 */    33,   34,  227,  227,   37,   38,   39,   45,   46,   47,
  /*    70 */    48,   49,   50,   51,   52,   53,   54,   55,   56,   57,
- /*    80 */     1,  244,   13,   14,  209,   16,   17,  209,    9,   63,
- /*    90 */    21,  243,  209,   24,   25,   26,   27,   28,   37,   38,
- /*   100 */    39,  101,   33,   34,  242,  264,   37,   38,   39,   14,
- /*   110 */   260,   16,   17,  264,  258,  266,   21,  209,  256,   24,
- /*   120 */    25,   26,   27,   28,  241,   98,  243,   97,   33,   34,
- /*   130 */   100,  101,   37,   38,   39,  213,   16,   17,  216,  264,
- /*   140 */   262,   21,  264,   97,   24,   25,   26,   27,   28,  241,
- /*   150 */   104,  243,  126,   33,   34,  129,  130,   37,   38,   39,
+ /*    80 */   245,  245,   13,   14,  210,   16,   17,  227,  266,   63,
+ /*    90 */    21,  266,  210,   24,   25,   26,   27,   28,   37,   38,
+ /*   100 */    39,  101,   33,   34,  260,  245,   37,   38,   39,   14,
+ /*   110 */   210,   16,   17,  102,    5,  266,   21,  268,  107,   24,
+ /*   120 */    25,   26,   27,   28,  242,   98,  244,   97,   33,   34,
+ /*   130 */   100,  101,   37,   38,   39,  243,   16,   17,  264,  239,
+ /*   140 */   266,   21,   33,   34,   24,   25,   26,   27,   28,    5,
+ /*   150 */   258,    7,  126,   33,   34,  129,  130,   37,   38,   39,
  /*   160 */    85,   86,   87,   88,   89,   90,   91,   92,   93,   94,
- /*   170 */    95,   96,  225,  258,  227,  228,  229,  230,  231,  232,
- /*   180 */   233,  234,  235,  236,  237,    1,    2,   78,   72,    5,
- /*   190 */   226,    7,  226,    9,   78,    1,    2,   97,  258,    5,
- /*   200 */   209,    7,  245,    9,  104,    1,    2,   44,  244,    5,
- /*   210 */   244,    7,  213,    9,  257,  216,  209,   33,   34,   33,
- /*   220 */    34,   37,  244,   37,   38,   39,   63,   33,   34,  238,
- /*   230 */   102,   37,   69,   70,   71,  107,  213,   33,   34,  216,
- /*   240 */    77,  114,  115,   25,   26,   27,   28,  102,  241,   98,
- /*   250 */   243,   33,   34,  102,    5,   37,   38,   39,    2,   98,
- /*   260 */    97,    5,  258,    7,  119,    9,  105,  104,   85,   86,
- /*   270 */   258,   88,   60,   61,   62,   92,   98,   94,   95,  125,
- /*   280 */   102,   97,   33,   34,    1,  244,  132,  124,  134,   33,
- /*   290 */    34,   97,  108,    5,  131,    7,   64,   65,   66,   67,
- /*   300 */    68,   97,  108,   59,   98,   98,   74,  123,  102,  102,
- /*   310 */   258,    5,  108,    7,   98,  102,  258,  123,  102,  239,
- /*   320 */    37,   64,   65,   66,   67,   68,  258,  123,   64,   65,
- /*   330 */    66,   67,   68,   98,  121,   98,    5,  102,    7,  102,
- /*   340 */   258,   97,  127,  128,  127,  128,  258,    5,  258,    7,
- /*   350 */    72,   73,  258,  239,  258,  258,  258,  239,  239,  103,
- /*   360 */   239,  239,  209,  240,  239,  209,  242,  265,  265,  209,
- /*   370 */   104,  209,  246,  209,  209,  209,  209,  209,  209,  209,
- /*   380 */   209,  209,  209,  209,  209,  209,  209,   59,  209,  209,
- /*   390 */   209,  209,  242,  108,  209,  261,  209,  209,  209,  209,
- /*   400 */   209,  209,  209,  261,  209,  209,  209,  209,  209,  209,
- /*   410 */   209,  209,  209,  118,  255,  210,  120,  117,  210,  210,
- /*   420 */   112,  116,  111,  110,  109,  122,   75,   84,   83,   49,
- /*   430 */    80,   82,  210,   81,   53,  210,   79,   75,    5,  210,
- /*   440 */   133,  214,  214,    5,   58,  133,    5,  133,    5,  133,
- /*   450 */    58,  210,  218,  222,  224,  217,  223,  221,  219,  211,
- /*   460 */   220,  210,  215,  252,  254,  242,  211,  253,    5,  249,
- /*   470 */   251,  250,  248,  247,  212,   58,   87,  133,  125,  105,
- /*   480 */    98,  106,   98,    1,   97,  102,   98,   97,   97,  113,
- /*   490 */   113,   72,    9,   98,   97,  102,  102,   97,   99,   97,
- /*   500 */    99,    5,    5,    5,    5,    5,   76,   15,   72,   16,
- /*   510 */   102,    5,    5,  128,   98,   97,    5,    5,    5,    5,
- /*   520 */     5,    5,    5,    5,  128,    5,    5,    5,    5,    5,
- /*   530 */   102,   76,   59,   58,    0,  269,  269,  269,  269,  269,
- /*   540 */    21,  269,  269,  269,  269,  269,   21,  269,  269,  269,
- /*   550 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   560 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   570 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   580 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   590 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   600 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   610 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   620 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   630 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   640 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   650 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   660 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   670 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   680 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   690 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   700 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   710 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   720 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   730 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   740 */   269,  269,  269,  269,  269,  269,  269,  269,  269,  269,
- /*   750 */   269,  269,
+ /*   170 */    95,   96,  226,  260,  228,  229,  230,  231,  232,  233,
+ /*   180 */   234,  235,  236,  237,  238,    1,    2,   97,  210,    5,
+ /*   190 */     5,    7,    7,    9,  104,    1,    2,  214,   72,    5,
+ /*   200 */   217,    7,  210,    9,   78,    1,    2,   44,   98,    5,
+ /*   210 */    98,    7,  102,    9,  102,  210,  246,   33,   34,   33,
+ /*   220 */    34,   37,  244,   37,   38,   39,   63,   33,   34,  259,
+ /*   230 */     1,   37,   69,   70,   71,  114,  115,   33,   34,   78,
+ /*   240 */    77,  125,  210,   25,   26,   27,   28,  242,  132,  244,
+ /*   250 */   134,   33,   34,  260,  262,   37,   38,   39,    2,  214,
+ /*   260 */    97,    5,  217,    7,  260,    9,   37,  104,   85,   86,
+ /*   270 */   214,   88,   97,  217,  242,   92,  244,   94,   95,  104,
+ /*   280 */    59,   97,   60,   61,   62,  260,   98,  124,  260,   33,
+ /*   290 */    34,   97,  108,  105,  131,  260,   64,   65,   66,   67,
+ /*   300 */    68,   97,  108,  102,   98,   98,   74,  123,  102,  102,
+ /*   310 */    98,    5,  108,    7,  102,  102,  245,  123,   97,  260,
+ /*   320 */   119,   64,   65,   66,   67,   68,  260,  123,   64,   65,
+ /*   330 */    66,   67,   68,   98,  121,   98,   98,  102,  260,  102,
+ /*   340 */   102,  127,  128,  127,  128,    5,  260,    7,   72,   73,
+ /*   350 */   245,  260,  260,  260,  260,  240,  260,  260,  240,  103,
+ /*   360 */   241,  210,  240,  240,  240,  240,  210,  240,  210,  267,
+ /*   370 */   267,  243,  210,  104,  210,  210,  247,  210,  210,  210,
+ /*   380 */   210,  210,  210,  210,  210,  243,  210,  210,  210,  210,
+ /*   390 */   210,  210,  210,   59,  108,  263,  263,  210,  263,  210,
+ /*   400 */   210,  210,  210,  210,  257,  210,  210,  210,  210,  210,
+ /*   410 */   210,  118,  210,  210,  120,  210,  256,  117,  210,  210,
+ /*   420 */   210,  210,  112,  116,  111,  110,  211,    1,  211,  109,
+ /*   430 */   211,  122,   75,   84,   83,   49,   80,   82,   53,   81,
+ /*   440 */    79,   75,  211,    5,  133,  211,    5,  133,   58,    5,
+ /*   450 */   133,  215,  211,    5,  215,  133,   58,    5,  211,  133,
+ /*   460 */   212,   58,  219,  218,  211,  225,  224,  223,  222,  220,
+ /*   470 */   243,  221,  212,  125,  248,  255,  252,  254,  253,  251,
+ /*   480 */   250,  216,  249,  213,   87,  105,   98,  106,   97,  102,
+ /*   490 */    98,   98,   97,    1,   98,  113,   97,   97,    9,   72,
+ /*   500 */     5,   97,  113,  102,  102,   98,   97,   99,   97,   99,
+ /*   510 */     5,    5,    5,    5,   15,   76,   16,   72,  102,    5,
+ /*   520 */     5,   98,  128,    5,    5,   97,    5,    5,    5,    5,
+ /*   530 */     5,    5,    5,  128,    5,    5,    5,    5,  102,   76,
+ /*   540 */    59,   21,   58,    0,  271,  271,  271,  271,  271,   21,
+ /*   550 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   560 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   570 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   580 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   590 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   600 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   610 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   620 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   630 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   640 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   650 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   660 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   670 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   680 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   690 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   700 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   710 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   720 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   730 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   740 */   271,  271,  271,  271,  271,  271,  271,  271,  271,  271,
+ /*   750 */   271,  271,  271,  271,  271,  271,
 };
-#define YY_SHIFT_COUNT    (246)
+#define YY_SHIFT_COUNT    (252)
 #define YY_SHIFT_MIN      (0)
-#define YY_SHIFT_MAX      (534)
+#define YY_SHIFT_MAX      (543)
 static const unsigned short int yy_shift_ofst[] = {
- /*     0 */   163,   75,  183,  184,  204,   79,   79,   79,   79,   79,
- /*    10 */    79,    0,   22,  204,  256,  256,  256,   46,   79,   79,
- /*    20 */    79,   79,   79,  116,  109,  109,  547,  194,  204,  204,
+ /*     0 */   163,   75,  183,  184,  204,   49,   49,   49,   49,   49,
+ /*    10 */    49,    0,   22,  204,  256,  256,  256,   90,   49,   49,
+ /*    20 */    49,   49,   49,  126,  161,  161,  550,  194,  204,  204,
  /*    30 */   204,  204,  204,  204,  204,  204,  204,  204,  204,  204,
- /*    40 */   204,  204,  204,  204,  204,  256,  256,  249,  249,  249,
- /*    50 */   249,  249,  249,   30,  249,  100,   79,   79,  127,  127,
- /*    60 */   128,   79,   79,   79,   79,   79,   79,   79,   79,   79,
- /*    70 */    79,   79,   79,   79,   79,   79,   79,   79,   79,   79,
- /*    80 */    79,   79,   79,   79,   79,   79,   79,   79,   79,   79,
- /*    90 */    79,   79,   79,   79,   79,   79,   79,   79,  266,  328,
- /*   100 */   328,  285,  285,  328,  295,  296,  300,  308,  305,  311,
- /*   110 */   313,  315,  303,  266,  328,  328,  351,  351,  328,  343,
- /*   120 */   345,  380,  350,  349,  381,  352,  357,  328,  362,  328,
- /*   130 */   362,  547,  547,   27,   69,   69,   69,   95,  120,  218,
- /*   140 */   218,  218,  232,  186,  186,  186,  186,  257,  264,   26,
- /*   150 */   154,   61,   61,  212,  161,  151,  178,  206,  207,  288,
- /*   160 */   306,  283,  244,  213,  145,  216,  235,  237,  215,  217,
- /*   170 */   331,  342,  278,  433,  307,  438,  312,  386,  441,  314,
- /*   180 */   443,  316,  392,  463,  344,  417,  389,  353,  374,  382,
- /*   190 */   375,  383,  384,  387,  482,  390,  388,  391,  393,  376,
- /*   200 */   394,  377,  395,  397,  400,  399,  402,  401,  419,  483,
- /*   210 */   496,  497,  498,  499,  500,  430,  492,  436,  493,  385,
- /*   220 */   396,  408,  506,  507,  416,  418,  408,  511,  512,  513,
- /*   230 */   514,  515,  516,  517,  518,  520,  521,  522,  523,  524,
- /*   240 */   428,  455,  519,  525,  473,  475,  534,
+ /*    40 */   204,  204,  204,  204,  204,  256,  256,  109,  109,  109,
+ /*    50 */   109,  109,  109,   30,  109,  175,   49,   49,   49,  121,
+ /*    60 */   121,   11,   49,   49,   49,   49,   49,   49,   49,   49,
+ /*    70 */    49,   49,   49,   49,   49,   49,   49,   49,   49,   49,
+ /*    80 */    49,   49,   49,   49,   49,   49,   49,   49,   49,   49,
+ /*    90 */    49,   49,   49,   49,   49,   49,   49,   49,   49,  269,
+ /*   100 */   334,  334,  286,  286,  286,  334,  293,  294,  300,  310,
+ /*   110 */   307,  313,  315,  426,  320,  309,  269,  334,  334,  357,
+ /*   120 */   357,  334,  349,  351,  386,  356,  355,  385,  358,  361,
+ /*   130 */   334,  366,  334,  366,  550,  550,   27,   69,   69,   69,
+ /*   140 */    95,  120,  218,  218,  218,  232,  186,  186,  186,  186,
+ /*   150 */   257,  264,   26,  116,   61,   61,  222,  188,  110,  112,
+ /*   160 */   206,  207,  212,  144,  185,  229,  221,  213,  201,  235,
+ /*   170 */   237,  238,  214,  216,  306,  340,  276,  438,  311,  441,
+ /*   180 */   314,  390,  444,  317,  448,  322,  398,  452,  326,  403,
+ /*   190 */   397,  348,  380,  388,  381,  387,  392,  391,  393,  395,
+ /*   200 */   492,  399,  396,  400,  401,  382,  402,  389,  407,  404,
+ /*   210 */   409,  408,  411,  410,  427,  489,  495,  505,  506,  507,
+ /*   220 */   508,  439,  499,  445,  500,  394,  405,  416,  514,  515,
+ /*   230 */   423,  428,  416,  518,  519,  521,  522,  523,  524,  525,
+ /*   240 */   526,  527,  529,  530,  531,  532,  436,  463,  520,  528,
+ /*   250 */   481,  484,  543,
 };
-#define YY_REDUCE_COUNT (132)
-#define YY_REDUCE_MIN   (-255)
-#define YY_REDUCE_MAX   (262)
+#define YY_REDUCE_COUNT (135)
+#define YY_REDUCE_MIN   (-257)
+#define YY_REDUCE_MAX   (270)
 static const short yy_reduce_ofst[] = {
- /*     0 */  -200,  -53, -225, -238, -222, -151, -122, -194, -117,  -92,
- /*    10 */     7, -197, -190, -236, -163,  -36,  -34, -138, -150, -159,
- /*    20 */  -125,   -9, -152,  -78,   -1,   23,  -43, -255, -253, -223,
- /*    30 */  -144,  -85,  -60,    4,   12,   52,   58,   68,   82,   88,
- /*    40 */    90,   94,   96,   97,   98,  -22,   41,   80,  114,  118,
- /*    50 */   119,  121,  122,  123,  125,  124,  153,  156,  102,  103,
- /*    60 */   126,  160,  162,  164,  165,  166,  167,  168,  169,  170,
- /*    70 */   171,  172,  173,  174,  175,  176,  177,  179,  180,  181,
- /*    80 */   182,  185,  187,  188,  189,  190,  191,  192,  193,  195,
- /*    90 */   196,  197,  198,  199,  200,  201,  202,  203,  150,  205,
- /*   100 */   208,  134,  142,  209,  159,  210,  214,  211,  219,  221,
- /*   110 */   220,  224,  226,  223,  222,  225,  227,  228,  229,  230,
- /*   120 */   233,  231,  234,  236,  239,  240,  238,  241,  248,  251,
- /*   130 */   255,  247,  262,
+ /*     0 */  -201,  -54, -226, -240, -224, -151, -126, -195, -118,    5,
+ /*    10 */    32, -205, -191, -248, -165, -164, -140, -108,   -8, -178,
+ /*    20 */  -175, -100,  -22,  -17,   45,   56,  -30, -257, -156,  -87,
+ /*    30 */    -7,    4,   25,   28,   35,   59,   66,   78,   86,   91,
+ /*    40 */    92,   93,   94,   96,   97,   71,  105,  115,  118,  122,
+ /*    50 */   123,  124,  125,  119,  127,  128,  151,  156,  158,  102,
+ /*    60 */   103,  129,  162,  164,  165,  167,  168,  169,  170,  171,
+ /*    70 */   172,  173,  174,  176,  177,  178,  179,  180,  181,  182,
+ /*    80 */   187,  189,  190,  191,  192,  193,  195,  196,  197,  198,
+ /*    90 */   199,  200,  202,  203,  205,  208,  209,  210,  211,  142,
+ /*   100 */   215,  217,  132,  133,  135,  219,  147,  160,  220,  223,
+ /*   110 */   225,  224,  228,  230,  233,  226,  227,  231,  234,  236,
+ /*   120 */   239,  241,  240,  242,  244,  243,  246,  249,  250,  245,
+ /*   130 */   247,  248,  253,  260,  265,  270,
 };
 static const YYACTIONTYPE yy_default[] = {
- /*     0 */   623,  675,  664,  835,  835,  623,  623,  623,  623,  623,
- /*    10 */   623,  765,  641,  835,  623,  623,  623,  623,  623,  623,
- /*    20 */   623,  623,  623,  677,  677,  677,  760,  623,  623,  623,
- /*    30 */   623,  623,  623,  623,  623,  623,  623,  623,  623,  623,
- /*    40 */   623,  623,  623,  623,  623,  623,  623,  623,  623,  623,
- /*    50 */   623,  623,  623,  623,  623,  623,  623,  623,  784,  784,
- /*    60 */   758,  623,  623,  623,  623,  623,  623,  623,  623,  623,
- /*    70 */   623,  623,  623,  623,  623,  623,  623,  623,  623,  662,
- /*    80 */   623,  660,  623,  623,  623,  623,  623,  623,  623,  623,
- /*    90 */   623,  623,  623,  623,  623,  649,  623,  623,  623,  643,
- /*   100 */   643,  623,  623,  643,  791,  795,  789,  777,  785,  776,
- /*   110 */   772,  771,  799,  623,  643,  643,  672,  672,  643,  693,
- /*   120 */   691,  689,  681,  687,  683,  685,  679,  643,  670,  643,
- /*   130 */   670,  708,  721,  623,  800,  834,  790,  818,  817,  830,
- /*   140 */   824,  823,  623,  822,  821,  820,  819,  623,  623,  623,
- /*   150 */   623,  826,  825,  623,  623,  623,  623,  623,  623,  623,
- /*   160 */   623,  623,  802,  796,  792,  623,  623,  623,  623,  623,
- /*   170 */   623,  623,  623,  623,  623,  623,  623,  623,  623,  623,
- /*   180 */   623,  623,  623,  623,  623,  623,  623,  623,  757,  623,
- /*   190 */   623,  766,  623,  623,  623,  623,  623,  623,  786,  623,
- /*   200 */   778,  623,  623,  623,  623,  623,  623,  734,  623,  623,
- /*   210 */   623,  623,  623,  623,  623,  623,  623,  623,  623,  623,
- /*   220 */   623,  839,  623,  623,  623,  728,  837,  623,  623,  623,
- /*   230 */   623,  623,  623,  623,  623,  623,  623,  623,  623,  623,
- /*   240 */   696,  623,  647,  645,  623,  639,  623,
+ /*     0 */   634,  686,  675,  849,  849,  634,  634,  634,  634,  634,
+ /*    10 */   634,  776,  652,  849,  634,  634,  634,  634,  634,  634,
+ /*    20 */   634,  634,  634,  688,  688,  688,  771,  634,  634,  634,
+ /*    30 */   634,  634,  634,  634,  634,  634,  634,  634,  634,  634,
+ /*    40 */   634,  634,  634,  634,  634,  634,  634,  634,  634,  634,
+ /*    50 */   634,  634,  634,  634,  634,  634,  634,  634,  634,  798,
+ /*    60 */   798,  769,  634,  634,  634,  634,  634,  634,  634,  634,
+ /*    70 */   634,  634,  634,  634,  634,  634,  634,  634,  634,  634,
+ /*    80 */   673,  634,  671,  634,  634,  634,  634,  634,  634,  634,
+ /*    90 */   634,  634,  634,  634,  634,  634,  660,  634,  634,  634,
+ /*   100 */   654,  654,  634,  634,  634,  654,  805,  809,  803,  791,
+ /*   110 */   799,  790,  786,  785,  782,  813,  634,  654,  654,  683,
+ /*   120 */   683,  654,  704,  702,  700,  692,  698,  694,  696,  690,
+ /*   130 */   654,  681,  654,  681,  719,  732,  634,  814,  848,  804,
+ /*   140 */   832,  831,  844,  838,  837,  634,  836,  835,  834,  833,
+ /*   150 */   634,  634,  634,  634,  840,  839,  634,  634,  634,  634,
+ /*   160 */   634,  634,  634,  634,  634,  634,  816,  810,  806,  634,
+ /*   170 */   634,  634,  634,  634,  634,  634,  634,  634,  634,  634,
+ /*   180 */   634,  634,  634,  634,  634,  634,  634,  634,  634,  634,
+ /*   190 */   634,  634,  768,  634,  634,  777,  634,  634,  634,  634,
+ /*   200 */   634,  634,  634,  634,  800,  634,  792,  634,  634,  634,
+ /*   210 */   634,  634,  634,  745,  634,  634,  634,  634,  634,  634,
+ /*   220 */   634,  634,  634,  634,  634,  634,  634,  853,  634,  634,
+ /*   230 */   634,  739,  851,  634,  634,  634,  634,  634,  634,  634,
+ /*   240 */   634,  634,  634,  634,  634,  634,  707,  634,  658,  656,
+ /*   250 */   634,  650,  634,
 };
 /********** End of lemon-generated parsing tables *****************************/
 
@@ -623,6 +626,7 @@ static const YYCODETYPE yyFallback[] = {
     1,  /*  SUM_IRATE => ID */
     1,  /*   AVG_RATE => ID */
     1,  /*  AVG_IRATE => ID */
+    1,  /*   VARIANCE => ID */
     1,  /*       TBID => ID */
     1,  /*       SEMI => ID */
     1,  /*       NONE => ID */
@@ -914,84 +918,86 @@ static const char *const yyTokenName[] = {
   /*  188 */ "SUM_IRATE",
   /*  189 */ "AVG_RATE",
   /*  190 */ "AVG_IRATE",
-  /*  191 */ "TBID",
-  /*  192 */ "SEMI",
-  /*  193 */ "NONE",
-  /*  194 */ "PREV",
-  /*  195 */ "LINEAR",
-  /*  196 */ "IMPORT",
-  /*  197 */ "METRIC",
-  /*  198 */ "TBNAME",
-  /*  199 */ "JOIN",
-  /*  200 */ "METRICS",
-  /*  201 */ "STABLE",
-  /*  202 */ "INSERT",
-  /*  203 */ "INTO",
-  /*  204 */ "VALUES",
-  /*  205 */ "error",
-  /*  206 */ "program",
-  /*  207 */ "cmd",
-  /*  208 */ "dbPrefix",
-  /*  209 */ "ids",
-  /*  210 */ "cpxName",
-  /*  211 */ "ifexists",
-  /*  212 */ "alter_db_optr",
-  /*  213 */ "acct_optr",
-  /*  214 */ "ifnotexists",
-  /*  215 */ "db_optr",
-  /*  216 */ "pps",
-  /*  217 */ "tseries",
-  /*  218 */ "dbs",
-  /*  219 */ "streams",
-  /*  220 */ "storage",
-  /*  221 */ "qtime",
-  /*  222 */ "users",
-  /*  223 */ "conns",
-  /*  224 */ "state",
-  /*  225 */ "keep",
-  /*  226 */ "tagitemlist",
-  /*  227 */ "tables",
-  /*  228 */ "cache",
-  /*  229 */ "replica",
-  /*  230 */ "days",
-  /*  231 */ "minrows",
-  /*  232 */ "maxrows",
-  /*  233 */ "blocks",
-  /*  234 */ "ctime",
-  /*  235 */ "wal",
-  /*  236 */ "comp",
-  /*  237 */ "prec",
-  /*  238 */ "typename",
-  /*  239 */ "signed",
-  /*  240 */ "create_table_args",
-  /*  241 */ "columnlist",
-  /*  242 */ "select",
-  /*  243 */ "column",
-  /*  244 */ "tagitem",
-  /*  245 */ "selcollist",
-  /*  246 */ "from",
-  /*  247 */ "where_opt",
-  /*  248 */ "interval_opt",
-  /*  249 */ "fill_opt",
-  /*  250 */ "sliding_opt",
-  /*  251 */ "groupby_opt",
-  /*  252 */ "orderby_opt",
-  /*  253 */ "having_opt",
-  /*  254 */ "slimit_opt",
-  /*  255 */ "limit_opt",
-  /*  256 */ "union",
-  /*  257 */ "sclp",
-  /*  258 */ "expr",
-  /*  259 */ "as",
-  /*  260 */ "tablelist",
-  /*  261 */ "tmvar",
-  /*  262 */ "sortlist",
-  /*  263 */ "sortitem",
-  /*  264 */ "item",
-  /*  265 */ "sortorder",
-  /*  266 */ "grouplist",
-  /*  267 */ "exprlist",
-  /*  268 */ "expritem",
+  /*  191 */ "VARIANCE",
+  /*  192 */ "TBID",
+  /*  193 */ "SEMI",
+  /*  194 */ "NONE",
+  /*  195 */ "PREV",
+  /*  196 */ "LINEAR",
+  /*  197 */ "IMPORT",
+  /*  198 */ "METRIC",
+  /*  199 */ "TBNAME",
+  /*  200 */ "JOIN",
+  /*  201 */ "METRICS",
+  /*  202 */ "STABLE",
+  /*  203 */ "INSERT",
+  /*  204 */ "INTO",
+  /*  205 */ "VALUES",
+  /*  206 */ "error",
+  /*  207 */ "program",
+  /*  208 */ "cmd",
+  /*  209 */ "dbPrefix",
+  /*  210 */ "ids",
+  /*  211 */ "cpxName",
+  /*  212 */ "ifexists",
+  /*  213 */ "alter_db_optr",
+  /*  214 */ "acct_optr",
+  /*  215 */ "ifnotexists",
+  /*  216 */ "db_optr",
+  /*  217 */ "pps",
+  /*  218 */ "tseries",
+  /*  219 */ "dbs",
+  /*  220 */ "streams",
+  /*  221 */ "storage",
+  /*  222 */ "qtime",
+  /*  223 */ "users",
+  /*  224 */ "conns",
+  /*  225 */ "state",
+  /*  226 */ "keep",
+  /*  227 */ "tagitemlist",
+  /*  228 */ "tables",
+  /*  229 */ "cache",
+  /*  230 */ "replica",
+  /*  231 */ "days",
+  /*  232 */ "minrows",
+  /*  233 */ "maxrows",
+  /*  234 */ "blocks",
+  /*  235 */ "ctime",
+  /*  236 */ "wal",
+  /*  237 */ "comp",
+  /*  238 */ "prec",
+  /*  239 */ "typename",
+  /*  240 */ "signed",
+  /*  241 */ "create_table_args",
+  /*  242 */ "columnlist",
+  /*  243 */ "select",
+  /*  244 */ "column",
+  /*  245 */ "tagitem",
+  /*  246 */ "selcollist",
+  /*  247 */ "from",
+  /*  248 */ "where_opt",
+  /*  249 */ "interval_opt",
+  /*  250 */ "window_opt",
+  /*  251 */ "fill_opt",
+  /*  252 */ "sliding_opt",
+  /*  253 */ "groupby_opt",
+  /*  254 */ "orderby_opt",
+  /*  255 */ "having_opt",
+  /*  256 */ "slimit_opt",
+  /*  257 */ "limit_opt",
+  /*  258 */ "union",
+  /*  259 */ "sclp",
+  /*  260 */ "expr",
+  /*  261 */ "as",
+  /*  262 */ "tablelist",
+  /*  263 */ "tmvar",
+  /*  264 */ "sortlist",
+  /*  265 */ "sortitem",
+  /*  266 */ "item",
+  /*  267 */ "sortorder",
+  /*  268 */ "grouplist",
+  /*  269 */ "exprlist",
+  /*  270 */ "expritem",
 };
 #endif /* defined(YYCOVERAGE) || !defined(NDEBUG) */
 
@@ -1125,7 +1131,7 @@ static const char *const yyRuleName[] = {
  /* 123 */ "tagitem ::= MINUS FLOAT",
  /* 124 */ "tagitem ::= PLUS INTEGER",
  /* 125 */ "tagitem ::= PLUS FLOAT",
- /* 126 */ "select ::= SELECT selcollist from where_opt interval_opt fill_opt sliding_opt groupby_opt orderby_opt having_opt slimit_opt limit_opt",
+ /* 126 */ "select ::= SELECT selcollist from where_opt interval_opt window_opt fill_opt sliding_opt groupby_opt orderby_opt having_opt slimit_opt limit_opt",
  /* 127 */ "union ::= select",
  /* 128 */ "union ::= LP union RP",
  /* 129 */ "union ::= union UNION ALL select",
@@ -1145,80 +1151,83 @@ static const char *const yyRuleName[] = {
  /* 143 */ "tmvar ::= VARIABLE",
  /* 144 */ "interval_opt ::= INTERVAL LP tmvar RP",
  /* 145 */ "interval_opt ::=",
- /* 146 */ "fill_opt ::=",
- /* 147 */ "fill_opt ::= FILL LP ID COMMA tagitemlist RP",
- /* 148 */ "fill_opt ::= FILL LP ID RP",
- /* 149 */ "sliding_opt ::= SLIDING LP tmvar RP",
- /* 150 */ "sliding_opt ::=",
- /* 151 */ "orderby_opt ::=",
- /* 152 */ "orderby_opt ::= ORDER BY sortlist",
- /* 153 */ "sortlist ::= sortlist COMMA item sortorder",
- /* 154 */ "sortlist ::= item sortorder",
- /* 155 */ "item ::= ids cpxName",
- /* 156 */ "sortorder ::= ASC",
- /* 157 */ "sortorder ::= DESC",
- /* 158 */ "sortorder ::=",
- /* 159 */ "groupby_opt ::=",
- /* 160 */ "groupby_opt ::= GROUP BY grouplist",
- /* 161 */ "grouplist ::= grouplist COMMA item",
- /* 162 */ "grouplist ::= item",
- /* 163 */ "having_opt ::=",
- /* 164 */ "having_opt ::= HAVING expr",
- /* 165 */ "limit_opt ::=",
- /* 166 */ "limit_opt ::= LIMIT signed",
- /* 167 */ "limit_opt ::= LIMIT signed OFFSET signed",
- /* 168 */ "limit_opt ::= LIMIT signed COMMA signed",
- /* 169 */ "slimit_opt ::=",
- /* 170 */ "slimit_opt ::= SLIMIT signed",
- /* 171 */ "slimit_opt ::= SLIMIT signed SOFFSET signed",
- /* 172 */ "slimit_opt ::= SLIMIT signed COMMA signed",
- /* 173 */ "where_opt ::=",
- /* 174 */ "where_opt ::= WHERE expr",
- /* 175 */ "expr ::= LP expr RP",
- /* 176 */ "expr ::= ID",
- /* 177 */ "expr ::= ID DOT ID",
- /* 178 */ "expr ::= ID DOT STAR",
- /* 179 */ "expr ::= INTEGER",
- /* 180 */ "expr ::= MINUS INTEGER",
- /* 181 */ "expr ::= PLUS INTEGER",
- /* 182 */ "expr ::= FLOAT",
- /* 183 */ "expr ::= MINUS FLOAT",
- /* 184 */ "expr ::= PLUS FLOAT",
- /* 185 */ "expr ::= STRING",
- /* 186 */ "expr ::= NOW",
- /* 187 */ "expr ::= VARIABLE",
- /* 188 */ "expr ::= BOOL",
- /* 189 */ "expr ::= ID LP exprlist RP",
- /* 190 */ "expr ::= ID LP STAR RP",
- /* 191 */ "expr ::= expr AND expr",
- /* 192 */ "expr ::= expr OR expr",
- /* 193 */ "expr ::= expr LT expr",
- /* 194 */ "expr ::= expr GT expr",
- /* 195 */ "expr ::= expr LE expr",
- /* 196 */ "expr ::= expr GE expr",
- /* 197 */ "expr ::= expr NE expr",
- /* 198 */ "expr ::= expr EQ expr",
- /* 199 */ "expr ::= expr PLUS expr",
- /* 200 */ "expr ::= expr MINUS expr",
- /* 201 */ "expr ::= expr STAR expr",
- /* 202 */ "expr ::= expr SLASH expr",
- /* 203 */ "expr ::= expr REM expr",
- /* 204 */ "expr ::= expr LIKE expr",
- /* 205 */ "expr ::= expr IN LP exprlist RP",
- /* 206 */ "exprlist ::= exprlist COMMA expritem",
- /* 207 */ "exprlist ::= expritem",
- /* 208 */ "expritem ::= expr",
- /* 209 */ "expritem ::=",
- /* 210 */ "cmd ::= RESET QUERY CACHE",
- /* 211 */ "cmd ::= ALTER TABLE ids cpxName ADD COLUMN columnlist",
- /* 212 */ "cmd ::= ALTER TABLE ids cpxName DROP COLUMN ids",
- /* 213 */ "cmd ::= ALTER TABLE ids cpxName ADD TAG columnlist",
- /* 214 */ "cmd ::= ALTER TABLE ids cpxName DROP TAG ids",
- /* 215 */ "cmd ::= ALTER TABLE ids cpxName CHANGE TAG ids ids",
- /* 216 */ "cmd ::= ALTER TABLE ids cpxName SET TAG ids EQ tagitem",
- /* 217 */ "cmd ::= KILL CONNECTION IPTOKEN COLON INTEGER",
- /* 218 */ "cmd ::= KILL STREAM IPTOKEN COLON INTEGER COLON INTEGER",
- /* 219 */ "cmd ::= KILL QUERY IPTOKEN COLON INTEGER COLON INTEGER",
+ /* 146 */ "window_opt ::= ID LP ids COMMA tmvar RP",
+ /* 147 */ "window_opt ::= ID LP ids RP",
+ /* 148 */ "window_opt ::=",
+ /* 149 */ "fill_opt ::=",
+ /* 150 */ "fill_opt ::= FILL LP ID COMMA tagitemlist RP",
+ /* 151 */ "fill_opt ::= FILL LP ID RP",
+ /* 152 */ "sliding_opt ::= SLIDING LP tmvar RP",
+ /* 153 */ "sliding_opt ::=",
+ /* 154 */ "orderby_opt ::=",
+ /* 155 */ "orderby_opt ::= ORDER BY sortlist",
+ /* 156 */ "sortlist ::= sortlist COMMA item sortorder",
+ /* 157 */ "sortlist ::= item sortorder",
+ /* 158 */ "item ::= ids cpxName",
+ /* 159 */ "sortorder ::= ASC",
+ /* 160 */ "sortorder ::= DESC",
+ /* 161 */ "sortorder ::=",
+ /* 162 */ "groupby_opt ::=",
+ /* 163 */ "groupby_opt ::= GROUP BY grouplist",
+ /* 164 */ "grouplist ::= grouplist COMMA item",
+ /* 165 */ "grouplist ::= item",
+ /* 166 */ "having_opt ::=",
+ /* 167 */ "having_opt ::= HAVING expr",
+ /* 168 */ "limit_opt ::=",
+ /* 169 */ "limit_opt ::= LIMIT signed",
+ /* 170 */ "limit_opt ::= LIMIT signed OFFSET signed",
+ /* 171 */ "limit_opt ::= LIMIT signed COMMA signed",
+ /* 172 */ "slimit_opt ::=",
+ /* 173 */ "slimit_opt ::= SLIMIT signed",
+ /* 174 */ "slimit_opt ::= SLIMIT signed SOFFSET signed",
+ /* 175 */ "slimit_opt ::= SLIMIT signed COMMA signed",
+ /* 176 */ "where_opt ::=",
+ /* 177 */ "where_opt ::= WHERE expr",
+ /* 178 */ "expr ::= LP expr RP",
+ /* 179 */ "expr ::= ID",
+ /* 180 */ "expr ::= ID DOT ID",
+ /* 181 */ "expr ::= ID DOT STAR",
+ /* 182 */ "expr ::= INTEGER",
+ /* 183 */ "expr ::= MINUS INTEGER",
+ /* 184 */ "expr ::= PLUS INTEGER",
+ /* 185 */ "expr ::= FLOAT",
+ /* 186 */ "expr ::= MINUS FLOAT",
+ /* 187 */ "expr ::= PLUS FLOAT",
+ /* 188 */ "expr ::= STRING",
+ /* 189 */ "expr ::= NOW",
+ /* 190 */ "expr ::= VARIABLE",
+ /* 191 */ "expr ::= BOOL",
+ /* 192 */ "expr ::= ID LP exprlist RP",
+ /* 193 */ "expr ::= ID LP STAR RP",
+ /* 194 */ "expr ::= expr AND expr",
+ /* 195 */ "expr ::= expr OR expr",
+ /* 196 */ "expr ::= expr LT expr",
+ /* 197 */ "expr ::= expr GT expr",
+ /* 198 */ "expr ::= expr LE expr",
+ /* 199 */ "expr ::= expr GE expr",
+ /* 200 */ "expr ::= expr NE expr",
+ /* 201 */ "expr ::= expr EQ expr",
+ /* 202 */ "expr ::= expr PLUS expr",
+ /* 203 */ "expr ::= expr MINUS expr",
+ /* 204 */ "expr ::= expr STAR expr",
+ /* 205 */ "expr ::= expr SLASH expr",
+ /* 206 */ "expr ::= expr REM expr",
+ /* 207 */ "expr ::= expr LIKE expr",
+ /* 208 */ "expr ::= expr IN LP exprlist RP",
+ /* 209 */ "exprlist ::= exprlist COMMA expritem",
+ /* 210 */ "exprlist ::= expritem",
+ /* 211 */ "expritem ::= expr",
+ /* 212 */ "expritem ::=",
+ /* 213 */ "cmd ::= RESET QUERY CACHE",
+ /* 214 */ "cmd ::= ALTER TABLE ids cpxName ADD COLUMN columnlist",
+ /* 215 */ "cmd ::= ALTER TABLE ids cpxName DROP COLUMN ids",
+ /* 216 */ "cmd ::= ALTER TABLE ids cpxName ADD TAG columnlist",
+ /* 217 */ "cmd ::= ALTER TABLE ids cpxName DROP TAG ids",
+ /* 218 */ "cmd ::= ALTER TABLE ids cpxName CHANGE TAG ids ids",
+ /* 219 */ "cmd ::= ALTER TABLE ids cpxName SET TAG ids EQ tagitem",
+ /* 220 */ "cmd ::= KILL CONNECTION IPTOKEN COLON INTEGER",
+ /* 221 */ "cmd ::= KILL STREAM IPTOKEN COLON INTEGER COLON INTEGER",
+ /* 222 */ "cmd ::= KILL QUERY IPTOKEN COLON INTEGER COLON INTEGER",
 };
 #endif /* NDEBUG */
 
@@ -1339,50 +1348,50 @@ static void yy_destructor(
     ** inside the C code.
     */
 /********* Begin destructor definitions ***************************************/
-    case 225: /* keep */
-    case 226: /* tagitemlist */
-    case 249: /* fill_opt */
-    case 251: /* groupby_opt */
-    case 252: /* orderby_opt */
-    case 262: /* sortlist */
-    case 266: /* grouplist */
+    case 226: /* keep */
+    case 227: /* tagitemlist */
+    case 251: /* fill_opt */
+    case 253: /* groupby_opt */
+    case 254: /* orderby_opt */
+    case 264: /* sortlist */
+    case 268: /* grouplist */
 {
-tVariantListDestroy((yypminor->yy322));
+tVariantListDestroy((yypminor->yy494));
 }
       break;
-    case 241: /* columnlist */
+    case 242: /* columnlist */
 {
-tFieldListDestroy((yypminor->yy369));
+tFieldListDestroy((yypminor->yy449));
 }
       break;
-    case 242: /* select */
+    case 243: /* select */
 {
-doDestroyQuerySql((yypminor->yy190));
+doDestroyQuerySql((yypminor->yy150));
 }
       break;
-    case 245: /* selcollist */
-    case 257: /* sclp */
-    case 267: /* exprlist */
+    case 246: /* selcollist */
+    case 259: /* sclp */
+    case 269: /* exprlist */
 {
-tSQLExprListDestroy((yypminor->yy260));
+tSQLExprListDestroy((yypminor->yy224));
 }
       break;
-    case 247: /* where_opt */
-    case 253: /* having_opt */
-    case 258: /* expr */
-    case 268: /* expritem */
+    case 248: /* where_opt */
+    case 255: /* having_opt */
+    case 260: /* expr */
+    case 270: /* expritem */
 {
-tSQLExprDestroy((yypminor->yy500));
+tSQLExprDestroy((yypminor->yy66));
 }
       break;
-    case 256: /* union */
+    case 258: /* union */
 {
-destroyAllSelectClause((yypminor->yy263));
+destroyAllSelectClause((yypminor->yy25));
 }
       break;
-    case 263: /* sortitem */
+    case 265: /* sortitem */
 {
-tVariantDestroy(&(yypminor->yy518));
+tVariantDestroy(&(yypminor->yy312));
 }
       break;
 /********* End destructor definitions *****************************************/
@@ -1676,226 +1685,229 @@ static const struct {
   YYCODETYPE lhs;       /* Symbol on the left-hand side of the rule */
   signed char nrhs;     /* Negative of the number of RHS symbols in the rule */
 } yyRuleInfo[] = {
-  {  206,   -1 }, /* (0) program ::= cmd */
-  {  207,   -2 }, /* (1) cmd ::= SHOW DATABASES */
-  {  207,   -2 }, /* (2) cmd ::= SHOW MNODES */
-  {  207,   -2 }, /* (3) cmd ::= SHOW DNODES */
-  {  207,   -2 }, /* (4) cmd ::= SHOW ACCOUNTS */
-  {  207,   -2 }, /* (5) cmd ::= SHOW USERS */
-  {  207,   -2 }, /* (6) cmd ::= SHOW MODULES */
-  {  207,   -2 }, /* (7) cmd ::= SHOW QUERIES */
-  {  207,   -2 }, /* (8) cmd ::= SHOW CONNECTIONS */
-  {  207,   -2 }, /* (9) cmd ::= SHOW STREAMS */
-  {  207,   -2 }, /* (10) cmd ::= SHOW CONFIGS */
-  {  207,   -2 }, /* (11) cmd ::= SHOW SCORES */
-  {  207,   -2 }, /* (12) cmd ::= SHOW GRANTS */
-  {  207,   -2 }, /* (13) cmd ::= SHOW VNODES */
-  {  207,   -3 }, /* (14) cmd ::= SHOW VNODES IPTOKEN */
-  {  208,    0 }, /* (15) dbPrefix ::= */
-  {  208,   -2 }, /* (16) dbPrefix ::= ids DOT */
-  {  210,    0 }, /* (17) cpxName ::= */
-  {  210,   -2 }, /* (18) cpxName ::= DOT ids */
-  {  207,   -3 }, /* (19) cmd ::= SHOW dbPrefix TABLES */
-  {  207,   -5 }, /* (20) cmd ::= SHOW dbPrefix TABLES LIKE ids */
-  {  207,   -3 }, /* (21) cmd ::= SHOW dbPrefix STABLES */
-  {  207,   -5 }, /* (22) cmd ::= SHOW dbPrefix STABLES LIKE ids */
-  {  207,   -3 }, /* (23) cmd ::= SHOW dbPrefix VGROUPS */
-  {  207,   -4 }, /* (24) cmd ::= SHOW dbPrefix VGROUPS ids */
-  {  207,   -5 }, /* (25) cmd ::= DROP TABLE ifexists ids cpxName */
-  {  207,   -4 }, /* (26) cmd ::= DROP DATABASE ifexists ids */
-  {  207,   -3 }, /* (27) cmd ::= DROP DNODE ids */
-  {  207,   -3 }, /* (28) cmd ::= DROP USER ids */
-  {  207,   -3 }, /* (29) cmd ::= DROP ACCOUNT ids */
-  {  207,   -2 }, /* (30) cmd ::= USE ids */
-  {  207,   -3 }, /* (31) cmd ::= DESCRIBE ids cpxName */
-  {  207,   -5 }, /* (32) cmd ::= ALTER USER ids PASS ids */
-  {  207,   -5 }, /* (33) cmd ::= ALTER USER ids PRIVILEGE ids */
-  {  207,   -4 }, /* (34) cmd ::= ALTER DNODE ids ids */
-  {  207,   -5 }, /* (35) cmd ::= ALTER DNODE ids ids ids */
-  {  207,   -3 }, /* (36) cmd ::= ALTER LOCAL ids */
-  {  207,   -4 }, /* (37) cmd ::= ALTER LOCAL ids ids */
-  {  207,   -4 }, /* (38) cmd ::= ALTER DATABASE ids alter_db_optr */
-  {  207,   -4 }, /* (39) cmd ::= ALTER ACCOUNT ids acct_optr */
-  {  207,   -6 }, /* (40) cmd ::= ALTER ACCOUNT ids PASS ids acct_optr */
-  {  209,   -1 }, /* (41) ids ::= ID */
-  {  209,   -1 }, /* (42) ids ::= STRING */
-  {  211,   -2 }, /* (43) ifexists ::= IF EXISTS */
-  {  211,    0 }, /* (44) ifexists ::= */
-  {  214,   -3 }, /* (45) ifnotexists ::= IF NOT EXISTS */
-  {  214,    0 }, /* (46) ifnotexists ::= */
-  {  207,   -3 }, /* (47) cmd ::= CREATE DNODE ids */
-  {  207,   -6 }, /* (48) cmd ::= CREATE ACCOUNT ids PASS ids acct_optr */
-  {  207,   -5 }, /* (49) cmd ::= CREATE DATABASE ifnotexists ids db_optr */
-  {  207,   -5 }, /* (50) cmd ::= CREATE USER ids PASS ids */
-  {  216,    0 }, /* (51) pps ::= */
-  {  216,   -2 }, /* (52) pps ::= PPS INTEGER */
-  {  217,    0 }, /* (53) tseries ::= */
-  {  217,   -2 }, /* (54) tseries ::= TSERIES INTEGER */
-  {  218,    0 }, /* (55) dbs ::= */
-  {  218,   -2 }, /* (56) dbs ::= DBS INTEGER */
-  {  219,    0 }, /* (57) streams ::= */
-  {  219,   -2 }, /* (58) streams ::= STREAMS INTEGER */
-  {  220,    0 }, /* (59) storage ::= */
-  {  220,   -2 }, /* (60) storage ::= STORAGE INTEGER */
-  {  221,    0 }, /* (61) qtime ::= */
-  {  221,   -2 }, /* (62) qtime ::= QTIME INTEGER */
-  {  222,    0 }, /* (63) users ::= */
-  {  222,   -2 }, /* (64) users ::= USERS INTEGER */
-  {  223,    0 }, /* (65) conns ::= */
-  {  223,   -2 }, /* (66) conns ::= CONNS INTEGER */
-  {  224,    0 }, /* (67) state ::= */
-  {  224,   -2 }, /* (68) state ::= STATE ids */
-  {  213,   -9 }, /* (69) acct_optr ::= pps tseries storage streams qtime dbs users conns state */
-  {  225,   -2 }, /* (70) keep ::= KEEP tagitemlist */
-  {  227,   -2 }, /* (71) tables ::= MAXTABLES INTEGER */
-  {  228,   -2 }, /* (72) cache ::= CACHE INTEGER */
-  {  229,   -2 }, /* (73) replica ::= REPLICA INTEGER */
-  {  230,   -2 }, /* (74) days ::= DAYS INTEGER */
-  {  231,   -2 }, /* (75) minrows ::= MINROWS INTEGER */
-  {  232,   -2 }, /* (76) maxrows ::= MAXROWS INTEGER */
-  {  233,   -2 }, /* (77) blocks ::= BLOCKS INTEGER */
-  {  234,   -2 }, /* (78) ctime ::= CTIME INTEGER */
-  {  235,   -2 }, /* (79) wal ::= WAL INTEGER */
-  {  236,   -2 }, /* (80) comp ::= COMP INTEGER */
-  {  237,   -2 }, /* (81) prec ::= PRECISION STRING */
-  {  215,    0 }, /* (82) db_optr ::= */
-  {  215,   -2 }, /* (83) db_optr ::= db_optr tables */
-  {  215,   -2 }, /* (84) db_optr ::= db_optr cache */
-  {  215,   -2 }, /* (85) db_optr ::= db_optr replica */
-  {  215,   -2 }, /* (86) db_optr ::= db_optr days */
-  {  215,   -2 }, /* (87) db_optr ::= db_optr minrows */
-  {  215,   -2 }, /* (88) db_optr ::= db_optr maxrows */
-  {  215,   -2 }, /* (89) db_optr ::= db_optr blocks */
-  {  215,   -2 }, /* (90) db_optr ::= db_optr ctime */
-  {  215,   -2 }, /* (91) db_optr ::= db_optr wal */
-  {  215,   -2 }, /* (92) db_optr ::= db_optr comp */
-  {  215,   -2 }, /* (93) db_optr ::= db_optr prec */
-  {  215,   -2 }, /* (94) db_optr ::= db_optr keep */
-  {  212,    0 }, /* (95) alter_db_optr ::= */
-  {  212,   -2 }, /* (96) alter_db_optr ::= alter_db_optr replica */
-  {  212,   -2 }, /* (97) alter_db_optr ::= alter_db_optr tables */
-  {  212,   -2 }, /* (98) alter_db_optr ::= alter_db_optr keep */
-  {  212,   -2 }, /* (99) alter_db_optr ::= alter_db_optr blocks */
-  {  212,   -2 }, /* (100) alter_db_optr ::= alter_db_optr comp */
-  {  212,   -2 }, /* (101) alter_db_optr ::= alter_db_optr wal */
-  {  238,   -1 }, /* (102) typename ::= ids */
-  {  238,   -4 }, /* (103) typename ::= ids LP signed RP */
-  {  239,   -1 }, /* (104) signed ::= INTEGER */
-  {  239,   -2 }, /* (105) signed ::= PLUS INTEGER */
-  {  239,   -2 }, /* (106) signed ::= MINUS INTEGER */
-  {  207,   -6 }, /* (107) cmd ::= CREATE TABLE ifnotexists ids cpxName create_table_args */
-  {  240,   -3 }, /* (108) create_table_args ::= LP columnlist RP */
-  {  240,   -7 }, /* (109) create_table_args ::= LP columnlist RP TAGS LP columnlist RP */
-  {  240,   -7 }, /* (110) create_table_args ::= USING ids cpxName TAGS LP tagitemlist RP */
-  {  240,   -2 }, /* (111) create_table_args ::= AS select */
-  {  241,   -3 }, /* (112) columnlist ::= columnlist COMMA column */
-  {  241,   -1 }, /* (113) columnlist ::= column */
-  {  243,   -2 }, /* (114) column ::= ids typename */
-  {  226,   -3 }, /* (115) tagitemlist ::= tagitemlist COMMA tagitem */
-  {  226,   -1 }, /* (116) tagitemlist ::= tagitem */
-  {  244,   -1 }, /* (117) tagitem ::= INTEGER */
-  {  244,   -1 }, /* (118) tagitem ::= FLOAT */
-  {  244,   -1 }, /* (119) tagitem ::= STRING */
-  {  244,   -1 }, /* (120) tagitem ::= BOOL */
-  {  244,   -1 }, /* (121) tagitem ::= NULL */
-  {  244,   -2 }, /* (122) tagitem ::= MINUS INTEGER */
-  {  244,   -2 }, /* (123) tagitem ::= MINUS FLOAT */
-  {  244,   -2 }, /* (124) tagitem ::= PLUS INTEGER */
-  {  244,   -2 }, /* (125) tagitem ::= PLUS FLOAT */
-  {  242,  -12 }, /* (126) select ::= SELECT selcollist from where_opt interval_opt fill_opt sliding_opt groupby_opt orderby_opt having_opt slimit_opt limit_opt */
-  {  256,   -1 }, /* (127) union ::= select */
-  {  256,   -3 }, /* (128) union ::= LP union RP */
-  {  256,   -4 }, /* (129) union ::= union UNION ALL select */
-  {  256,   -6 }, /* (130) union ::= union UNION ALL LP select RP */
-  {  207,   -1 }, /* (131) cmd ::= union */
-  {  242,   -2 }, /* (132) select ::= SELECT selcollist */
-  {  257,   -2 }, /* (133) sclp ::= selcollist COMMA */
-  {  257,    0 }, /* (134) sclp ::= */
-  {  245,   -3 }, /* (135) selcollist ::= sclp expr as */
-  {  245,   -2 }, /* (136) selcollist ::= sclp STAR */
-  {  259,   -2 }, /* (137) as ::= AS ids */
-  {  259,   -1 }, /* (138) as ::= ids */
-  {  259,    0 }, /* (139) as ::= */
-  {  246,   -2 }, /* (140) from ::= FROM tablelist */
-  {  260,   -2 }, /* (141) tablelist ::= ids cpxName */
-  {  260,   -4 }, /* (142) tablelist ::= tablelist COMMA ids cpxName */
-  {  261,   -1 }, /* (143) tmvar ::= VARIABLE */
-  {  248,   -4 }, /* (144) interval_opt ::= INTERVAL LP tmvar RP */
-  {  248,    0 }, /* (145) interval_opt ::= */
-  {  249,    0 }, /* (146) fill_opt ::= */
-  {  249,   -6 }, /* (147) fill_opt ::= FILL LP ID COMMA tagitemlist RP */
-  {  249,   -4 }, /* (148) fill_opt ::= FILL LP ID RP */
-  {  250,   -4 }, /* (149) sliding_opt ::= SLIDING LP tmvar RP */
-  {  250,    0 }, /* (150) sliding_opt ::= */
-  {  252,    0 }, /* (151) orderby_opt ::= */
-  {  252,   -3 }, /* (152) orderby_opt ::= ORDER BY sortlist */
-  {  262,   -4 }, /* (153) sortlist ::= sortlist COMMA item sortorder */
-  {  262,   -2 }, /* (154) sortlist ::= item sortorder */
-  {  264,   -2 }, /* (155) item ::= ids cpxName */
-  {  265,   -1 }, /* (156) sortorder ::= ASC */
-  {  265,   -1 }, /* (157) sortorder ::= DESC */
-  {  265,    0 }, /* (158) sortorder ::= */
-  {  251,    0 }, /* (159) groupby_opt ::= */
-  {  251,   -3 }, /* (160) groupby_opt ::= GROUP BY grouplist */
-  {  266,   -3 }, /* (161) grouplist ::= grouplist COMMA item */
-  {  266,   -1 }, /* (162) grouplist ::= item */
-  {  253,    0 }, /* (163) having_opt ::= */
-  {  253,   -2 }, /* (164) having_opt ::= HAVING expr */
-  {  255,    0 }, /* (165) limit_opt ::= */
-  {  255,   -2 }, /* (166) limit_opt ::= LIMIT signed */
-  {  255,   -4 }, /* (167) limit_opt ::= LIMIT signed OFFSET signed */
-  {  255,   -4 }, /* (168) limit_opt ::= LIMIT signed COMMA signed */
-  {  254,    0 }, /* (169) slimit_opt ::= */
-  {  254,   -2 }, /* (170) slimit_opt ::= SLIMIT signed */
-  {  254,   -4 }, /* (171) slimit_opt ::= SLIMIT signed SOFFSET signed */
-  {  254,   -4 }, /* (172) slimit_opt ::= SLIMIT signed COMMA signed */
-  {  247,    0 }, /* (173) where_opt ::= */
-  {  247,   -2 }, /* (174) where_opt ::= WHERE expr */
-  {  258,   -3 }, /* (175) expr ::= LP expr RP */
-  {  258,   -1 }, /* (176) expr ::= ID */
-  {  258,   -3 }, /* (177) expr ::= ID DOT ID */
-  {  258,   -3 }, /* (178) expr ::= ID DOT STAR */
-  {  258,   -1 }, /* (179) expr ::= INTEGER */
-  {  258,   -2 }, /* (180) expr ::= MINUS INTEGER */
-  {  258,   -2 }, /* (181) expr ::= PLUS INTEGER */
-  {  258,   -1 }, /* (182) expr ::= FLOAT */
-  {  258,   -2 }, /* (183) expr ::= MINUS FLOAT */
-  {  258,   -2 }, /* (184) expr ::= PLUS FLOAT */
-  {  258,   -1 }, /* (185) expr ::= STRING */
-  {  258,   -1 }, /* (186) expr ::= NOW */
-  {  258,   -1 }, /* (187) expr ::= VARIABLE */
-  {  258,   -1 }, /* (188) expr ::= BOOL */
-  {  258,   -4 }, /* (189) expr ::= ID LP exprlist RP */
-  {  258,   -4 }, /* (190) expr ::= ID LP STAR RP */
-  {  258,   -3 }, /* (191) expr ::= expr AND expr */
-  {  258,   -3 }, /* (192) expr ::= expr OR expr */
-  {  258,   -3 }, /* (193) expr ::= expr LT expr */
-  {  258,   -3 }, /* (194) expr ::= expr GT expr */
-  {  258,   -3 }, /* (195) expr ::= expr LE expr */
-  {  258,   -3 }, /* (196) expr ::= expr GE expr */
-  {  258,   -3 }, /* (197) expr ::= expr NE expr */
-  {  258,   -3 }, /* (198) expr ::= expr EQ expr */
-  {  258,   -3 }, /* (199) expr ::= expr PLUS expr */
-  {  258,   -3 }, /* (200) expr ::= expr MINUS expr */
-  {  258,   -3 }, /* (201) expr ::= expr STAR expr */
-  {  258,   -3 }, /* (202) expr ::= expr SLASH expr */
-  {  258,   -3 }, /* (203) expr ::= expr REM expr */
-  {  258,   -3 }, /* (204) expr ::= expr LIKE expr */
-  {  258,   -5 }, /* (205) expr ::= expr IN LP exprlist RP */
-  {  267,   -3 }, /* (206) exprlist ::= exprlist COMMA expritem */
-  {  267,   -1 }, /* (207) exprlist ::= expritem */
-  {  268,   -1 }, /* (208) expritem ::= expr */
-  {  268,    0 }, /* (209) expritem ::= */
-  {  207,   -3 }, /* (210) cmd ::= RESET QUERY CACHE */
-  {  207,   -7 }, /* (211) cmd ::= ALTER TABLE ids cpxName ADD COLUMN columnlist */
-  {  207,   -7 }, /* (212) cmd ::= ALTER TABLE ids cpxName DROP COLUMN ids */
-  {  207,   -7 }, /* (213) cmd ::= ALTER TABLE ids cpxName ADD TAG columnlist */
-  {  207,   -7 }, /* (214) cmd ::= ALTER TABLE ids cpxName DROP TAG ids */
-  {  207,   -8 }, /* (215) cmd ::= ALTER TABLE ids cpxName CHANGE TAG ids ids */
-  {  207,   -9 }, /* (216) cmd ::= ALTER TABLE ids cpxName SET TAG ids EQ tagitem */
-  {  207,   -5 }, /* (217) cmd ::= KILL CONNECTION IPTOKEN COLON INTEGER */
-  {  207,   -7 }, /* (218) cmd ::= KILL STREAM IPTOKEN COLON INTEGER COLON INTEGER */
-  {  207,   -7 }, /* (219) cmd ::= KILL QUERY IPTOKEN COLON INTEGER COLON INTEGER */
+  {  207,   -1 }, /* (0) program ::= cmd */
+  {  208,   -2 }, /* (1) cmd ::= SHOW DATABASES */
+  {  208,   -2 }, /* (2) cmd ::= SHOW MNODES */
+  {  208,   -2 }, /* (3) cmd ::= SHOW DNODES */
+  {  208,   -2 }, /* (4) cmd ::= SHOW ACCOUNTS */
+  {  208,   -2 }, /* (5) cmd ::= SHOW USERS */
+  {  208,   -2 }, /* (6) cmd ::= SHOW MODULES */
+  {  208,   -2 }, /* (7) cmd ::= SHOW QUERIES */
+  {  208,   -2 }, /* (8) cmd ::= SHOW CONNECTIONS */
+  {  208,   -2 }, /* (9) cmd ::= SHOW STREAMS */
+  {  208,   -2 }, /* (10) cmd ::= SHOW CONFIGS */
+  {  208,   -2 }, /* (11) cmd ::= SHOW SCORES */
+  {  208,   -2 }, /* (12) cmd ::= SHOW GRANTS */
+  {  208,   -2 }, /* (13) cmd ::= SHOW VNODES */
+  {  208,   -3 }, /* (14) cmd ::= SHOW VNODES IPTOKEN */
+  {  209,    0 }, /* (15) dbPrefix ::= */
+  {  209,   -2 }, /* (16) dbPrefix ::= ids DOT */
+  {  211,    0 }, /* (17) cpxName ::= */
+  {  211,   -2 }, /* (18) cpxName ::= DOT ids */
+  {  208,   -3 }, /* (19) cmd ::= SHOW dbPrefix TABLES */
+  {  208,   -5 }, /* (20) cmd ::= SHOW dbPrefix TABLES LIKE ids */
+  {  208,   -3 }, /* (21) cmd ::= SHOW dbPrefix STABLES */
+  {  208,   -5 }, /* (22) cmd ::= SHOW dbPrefix STABLES LIKE ids */
+  {  208,   -3 }, /* (23) cmd ::= SHOW dbPrefix VGROUPS */
+  {  208,   -4 }, /* (24) cmd ::= SHOW dbPrefix VGROUPS ids */
+  {  208,   -5 }, /* (25) cmd ::= DROP TABLE ifexists ids cpxName */
+  {  208,   -4 }, /* (26) cmd ::= DROP DATABASE ifexists ids */
+  {  208,   -3 }, /* (27) cmd ::= DROP DNODE ids */
+  {  208,   -3 }, /* (28) cmd ::= DROP USER ids */
+  {  208,   -3 }, /* (29) cmd ::= DROP ACCOUNT ids */
+  {  208,   -2 }, /* (30) cmd ::= USE ids */
+  {  208,   -3 }, /* (31) cmd ::= DESCRIBE ids cpxName */
+  {  208,   -5 }, /* (32) cmd ::= ALTER USER ids PASS ids */
+  {  208,   -5 }, /* (33) cmd ::= ALTER USER ids PRIVILEGE ids */
+  {  208,   -4 }, /* (34) cmd ::= ALTER DNODE ids ids */
+  {  208,   -5 }, /* (35) cmd ::= ALTER DNODE ids ids ids */
+  {  208,   -3 }, /* (36) cmd ::= ALTER LOCAL ids */
+  {  208,   -4 }, /* (37) cmd ::= ALTER LOCAL ids ids */
+  {  208,   -4 }, /* (38) cmd ::= ALTER DATABASE ids alter_db_optr */
+  {  208,   -4 }, /* (39) cmd ::= ALTER ACCOUNT ids acct_optr */
+  {  208,   -6 }, /* (40) cmd ::= ALTER ACCOUNT ids PASS ids acct_optr */
+  {  210,   -1 }, /* (41) ids ::= ID */
+  {  210,   -1 }, /* (42) ids ::= STRING */
+  {  212,   -2 }, /* (43) ifexists ::= IF EXISTS */
+  {  212,    0 }, /* (44) ifexists ::= */
+  {  215,   -3 }, /* (45) ifnotexists ::= IF NOT EXISTS */
+  {  215,    0 }, /* (46) ifnotexists ::= */
+  {  208,   -3 }, /* (47) cmd ::= CREATE DNODE ids */
+  {  208,   -6 }, /* (48) cmd ::= CREATE ACCOUNT ids PASS ids acct_optr */
+  {  208,   -5 }, /* (49) cmd ::= CREATE DATABASE ifnotexists ids db_optr */
+  {  208,   -5 }, /* (50) cmd ::= CREATE USER ids PASS ids */
+  {  217,    0 }, /* (51) pps ::= */
+  {  217,   -2 }, /* (52) pps ::= PPS INTEGER */
+  {  218,    0 }, /* (53) tseries ::= */
+  {  218,   -2 }, /* (54) tseries ::= TSERIES INTEGER */
+  {  219,    0 }, /* (55) dbs ::= */
+  {  219,   -2 }, /* (56) dbs ::= DBS INTEGER */
+  {  220,    0 }, /* (57) streams ::= */
+  {  220,   -2 }, /* (58) streams ::= STREAMS INTEGER */
+  {  221,    0 }, /* (59) storage ::= */
+  {  221,   -2 }, /* (60) storage ::= STORAGE INTEGER */
+  {  222,    0 }, /* (61) qtime ::= */
+  {  222,   -2 }, /* (62) qtime ::= QTIME INTEGER */
+  {  223,    0 }, /* (63) users ::= */
+  {  223,   -2 }, /* (64) users ::= USERS INTEGER */
+  {  224,    0 }, /* (65) conns ::= */
+  {  224,   -2 }, /* (66) conns ::= CONNS INTEGER */
+  {  225,    0 }, /* (67) state ::= */
+  {  225,   -2 }, /* (68) state ::= STATE ids */
+  {  214,   -9 }, /* (69) acct_optr ::= pps tseries storage streams qtime dbs users conns state */
+  {  226,   -2 }, /* (70) keep ::= KEEP tagitemlist */
+  {  228,   -2 }, /* (71) tables ::= MAXTABLES INTEGER */
+  {  229,   -2 }, /* (72) cache ::= CACHE INTEGER */
+  {  230,   -2 }, /* (73) replica ::= REPLICA INTEGER */
+  {  231,   -2 }, /* (74) days ::= DAYS INTEGER */
+  {  232,   -2 }, /* (75) minrows ::= MINROWS INTEGER */
+  {  233,   -2 }, /* (76) maxrows ::= MAXROWS INTEGER */
+  {  234,   -2 }, /* (77) blocks ::= BLOCKS INTEGER */
+  {  235,   -2 }, /* (78) ctime ::= CTIME INTEGER */
+  {  236,   -2 }, /* (79) wal ::= WAL INTEGER */
+  {  237,   -2 }, /* (80) comp ::= COMP INTEGER */
+  {  238,   -2 }, /* (81) prec ::= PRECISION STRING */
+  {  216,    0 }, /* (82) db_optr ::= */
+  {  216,   -2 }, /* (83) db_optr ::= db_optr tables */
+  {  216,   -2 }, /* (84) db_optr ::= db_optr cache */
+  {  216,   -2 }, /* (85) db_optr ::= db_optr replica */
+  {  216,   -2 }, /* (86) db_optr ::= db_optr days */
+  {  216,   -2 }, /* (87) db_optr ::= db_optr minrows */
+  {  216,   -2 }, /* (88) db_optr ::= db_optr maxrows */
+  {  216,   -2 }, /* (89) db_optr ::= db_optr blocks */
+  {  216,   -2 }, /* (90) db_optr ::= db_optr ctime */
+  {  216,   -2 }, /* (91) db_optr ::= db_optr wal */
+  {  216,   -2 }, /* (92) db_optr ::= db_optr comp */
+  {  216,   -2 }, /* (93) db_optr ::= db_optr prec */
+  {  216,   -2 }, /* (94) db_optr ::= db_optr keep */
+  {  213,    0 }, /* (95) alter_db_optr ::= */
+  {  213,   -2 }, /* (96) alter_db_optr ::= alter_db_optr replica */
+  {  213,   -2 }, /* (97) alter_db_optr ::= alter_db_optr tables */
+  {  213,   -2 }, /* (98) alter_db_optr ::= alter_db_optr keep */
+  {  213,   -2 }, /* (99) alter_db_optr ::= alter_db_optr blocks */
+  {  213,   -2 }, /* (100) alter_db_optr ::= alter_db_optr comp */
+  {  213,   -2 }, /* (101) alter_db_optr ::= alter_db_optr wal */
+  {  239,   -1 }, /* (102) typename ::= ids */
+  {  239,   -4 }, /* (103) typename ::= ids LP signed RP */
+  {  240,   -1 }, /* (104) signed ::= INTEGER */
+  {  240,   -2 }, /* (105) signed ::= PLUS INTEGER */
+  {  240,   -2 }, /* (106) signed ::= MINUS INTEGER */
+  {  208,   -6 }, /* (107) cmd ::= CREATE TABLE ifnotexists ids cpxName create_table_args */
+  {  241,   -3 }, /* (108) create_table_args ::= LP columnlist RP */
+  {  241,   -7 }, /* (109) create_table_args ::= LP columnlist RP TAGS LP columnlist RP */
+  {  241,   -7 }, /* (110) create_table_args ::= USING ids cpxName TAGS LP tagitemlist RP */
+  {  241,   -2 }, /* (111) create_table_args ::= AS select */
+  {  242,   -3 }, /* (112) columnlist ::= columnlist COMMA column */
+  {  242,   -1 }, /* (113) columnlist ::= column */
+  {  244,   -2 }, /* (114) column ::= ids typename */
+  {  227,   -3 }, /* (115) tagitemlist ::= tagitemlist COMMA tagitem */
+  {  227,   -1 }, /* (116) tagitemlist ::= tagitem */
+  {  245,   -1 }, /* (117) tagitem ::= INTEGER */
+  {  245,   -1 }, /* (118) tagitem ::= FLOAT */
+  {  245,   -1 }, /* (119) tagitem ::= STRING */
+  {  245,   -1 }, /* (120) tagitem ::= BOOL */
+  {  245,   -1 }, /* (121) tagitem ::= NULL */
+  {  245,   -2 }, /* (122) tagitem ::= MINUS INTEGER */
+  {  245,   -2 }, /* (123) tagitem ::= MINUS FLOAT */
+  {  245,   -2 }, /* (124) tagitem ::= PLUS INTEGER */
+  {  245,   -2 }, /* (125) tagitem ::= PLUS FLOAT */
+  {  243,  -13 }, /* (126) select ::= SELECT selcollist from where_opt interval_opt window_opt fill_opt sliding_opt groupby_opt orderby_opt having_opt slimit_opt limit_opt */
+  {  258,   -1 }, /* (127) union ::= select */
+  {  258,   -3 }, /* (128) union ::= LP union RP */
+  {  258,   -4 }, /* (129) union ::= union UNION ALL select */
+  {  258,   -6 }, /* (130) union ::= union UNION ALL LP select RP */
+  {  208,   -1 }, /* (131) cmd ::= union */
+  {  243,   -2 }, /* (132) select ::= SELECT selcollist */
+  {  259,   -2 }, /* (133) sclp ::= selcollist COMMA */
+  {  259,    0 }, /* (134) sclp ::= */
+  {  246,   -3 }, /* (135) selcollist ::= sclp expr as */
+  {  246,   -2 }, /* (136) selcollist ::= sclp STAR */
+  {  261,   -2 }, /* (137) as ::= AS ids */
+  {  261,   -1 }, /* (138) as ::= ids */
+  {  261,    0 }, /* (139) as ::= */
+  {  247,   -2 }, /* (140) from ::= FROM tablelist */
+  {  262,   -2 }, /* (141) tablelist ::= ids cpxName */
+  {  262,   -4 }, /* (142) tablelist ::= tablelist COMMA ids cpxName */
+  {  263,   -1 }, /* (143) tmvar ::= VARIABLE */
+  {  249,   -4 }, /* (144) interval_opt ::= INTERVAL LP tmvar RP */
+  {  249,    0 }, /* (145) interval_opt ::= */
+  {  250,   -6 }, /* (146) window_opt ::= ID LP ids COMMA tmvar RP */
+  {  250,   -4 }, /* (147) window_opt ::= ID LP ids RP */
+  {  250,    0 }, /* (148) window_opt ::= */
+  {  251,    0 }, /* (149) fill_opt ::= */
+  {  251,   -6 }, /* (150) fill_opt ::= FILL LP ID COMMA tagitemlist RP */
+  {  251,   -4 }, /* (151) fill_opt ::= FILL LP ID RP */
+  {  252,   -4 }, /* (152) sliding_opt ::= SLIDING LP tmvar RP */
+  {  252,    0 }, /* (153) sliding_opt ::= */
+  {  254,    0 }, /* (154) orderby_opt ::= */
+  {  254,   -3 }, /* (155) orderby_opt ::= ORDER BY sortlist */
+  {  264,   -4 }, /* (156) sortlist ::= sortlist COMMA item sortorder */
+  {  264,   -2 }, /* (157) sortlist ::= item sortorder */
+  {  266,   -2 }, /* (158) item ::= ids cpxName */
+  {  267,   -1 }, /* (159) sortorder ::= ASC */
+  {  267,   -1 }, /* (160) sortorder ::= DESC */
+  {  267,    0 }, /* (161) sortorder ::= */
+  {  253,    0 }, /* (162) groupby_opt ::= */
+  {  253,   -3 }, /* (163) groupby_opt ::= GROUP BY grouplist */
+  {  268,   -3 }, /* (164) grouplist ::= grouplist COMMA item */
+  {  268,   -1 }, /* (165) grouplist ::= item */
+  {  255,    0 }, /* (166) having_opt ::= */
+  {  255,   -2 }, /* (167) having_opt ::= HAVING expr */
+  {  257,    0 }, /* (168) limit_opt ::= */
+  {  257,   -2 }, /* (169) limit_opt ::= LIMIT signed */
+  {  257,   -4 }, /* (170) limit_opt ::= LIMIT signed OFFSET signed */
+  {  257,   -4 }, /* (171) limit_opt ::= LIMIT signed COMMA signed */
+  {  256,    0 }, /* (172) slimit_opt ::= */
+  {  256,   -2 }, /* (173) slimit_opt ::= SLIMIT signed */
+  {  256,   -4 }, /* (174) slimit_opt ::= SLIMIT signed SOFFSET signed */
+  {  256,   -4 }, /* (175) slimit_opt ::= SLIMIT signed COMMA signed */
+  {  248,    0 }, /* (176) where_opt ::= */
+  {  248,   -2 }, /* (177) where_opt ::= WHERE expr */
+  {  260,   -3 }, /* (178) expr ::= LP expr RP */
+  {  260,   -1 }, /* (179) expr ::= ID */
+  {  260,   -3 }, /* (180) expr ::= ID DOT ID */
+  {  260,   -3 }, /* (181) expr ::= ID DOT STAR */
+  {  260,   -1 }, /* (182) expr ::= INTEGER */
+  {  260,   -2 }, /* (183) expr ::= MINUS INTEGER */
+  {  260,   -2 }, /* (184) expr ::= PLUS INTEGER */
+  {  260,   -1 }, /* (185) expr ::= FLOAT */
+  {  260,   -2 }, /* (186) expr ::= MINUS FLOAT */
+  {  260,   -2 }, /* (187) expr ::= PLUS FLOAT */
+  {  260,   -1 }, /* (188) expr ::= STRING */
+  {  260,   -1 }, /* (189) expr ::= NOW */
+  {  260,   -1 }, /* (190) expr ::= VARIABLE */
+  {  260,   -1 }, /* (191) expr ::= BOOL */
+  {  260,   -4 }, /* (192) expr ::= ID LP exprlist RP */
+  {  260,   -4 }, /* (193) expr ::= ID LP STAR RP */
+  {  260,   -3 }, /* (194) expr ::= expr AND expr */
+  {  260,   -3 }, /* (195) expr ::= expr OR expr */
+  {  260,   -3 }, /* (196) expr ::= expr LT expr */
+  {  260,   -3 }, /* (197) expr ::= expr GT expr */
+  {  260,   -3 }, /* (198) expr ::= expr LE expr */
+  {  260,   -3 }, /* (199) expr ::= expr GE expr */
+  {  260,   -3 }, /* (200) expr ::= expr NE expr */
+  {  260,   -3 }, /* (201) expr ::= expr EQ expr */
+  {  260,   -3 }, /* (202) expr ::= expr PLUS expr */
+  {  260,   -3 }, /* (203) expr ::= expr MINUS expr */
+  {  260,   -3 }, /* (204) expr ::= expr STAR expr */
+  {  260,   -3 }, /* (205) expr ::= expr SLASH expr */
+  {  260,   -3 }, /* (206) expr ::= expr REM expr */
+  {  260,   -3 }, /* (207) expr ::= expr LIKE expr */
+  {  260,   -5 }, /* (208) expr ::= expr IN LP exprlist RP */
+  {  269,   -3 }, /* (209) exprlist ::= exprlist COMMA expritem */
+  {  269,   -1 }, /* (210) exprlist ::= expritem */
+  {  270,   -1 }, /* (211) expritem ::= expr */
+  {  270,    0 }, /* (212) expritem ::= */
+  {  208,   -3 }, /* (213) cmd ::= RESET QUERY CACHE */
+  {  208,   -7 }, /* (214) cmd ::= ALTER TABLE ids cpxName ADD COLUMN columnlist */
+  {  208,   -7 }, /* (215) cmd ::= ALTER TABLE ids cpxName DROP COLUMN ids */
+  {  208,   -7 }, /* (216) cmd ::= ALTER TABLE ids cpxName ADD TAG columnlist */
+  {  208,   -7 }, /* (217) cmd ::= ALTER TABLE ids cpxName DROP TAG ids */
+  {  208,   -8 }, /* (218) cmd ::= ALTER TABLE ids cpxName CHANGE TAG ids ids */
+  {  208,   -9 }, /* (219) cmd ::= ALTER TABLE ids cpxName SET TAG ids EQ tagitem */
+  {  208,   -5 }, /* (220) cmd ::= KILL CONNECTION IPTOKEN COLON INTEGER */
+  {  208,   -7 }, /* (221) cmd ::= KILL STREAM IPTOKEN COLON INTEGER COLON INTEGER */
+  {  208,   -7 }, /* (222) cmd ::= KILL QUERY IPTOKEN COLON INTEGER COLON INTEGER */
 };
 
 static void yy_accept(yyParser*);  /* Forward Declaration */
@@ -2115,13 +2127,13 @@ static void yy_reduce(
 { setDCLSQLElems(pInfo, TSDB_SQL_CFG_LOCAL, 2, &yymsp[-1].minor.yy0, &yymsp[0].minor.yy0);          }
         break;
       case 38: /* cmd ::= ALTER DATABASE ids alter_db_optr */
-{ SSQLToken t = {0};  setCreateDBSQL(pInfo, TSDB_SQL_ALTER_DB, &yymsp[-1].minor.yy0, &yymsp[0].minor.yy374, &t);}
+{ SSQLToken t = {0};  setCreateDBSQL(pInfo, TSDB_SQL_ALTER_DB, &yymsp[-1].minor.yy0, &yymsp[0].minor.yy158, &t);}
         break;
       case 39: /* cmd ::= ALTER ACCOUNT ids acct_optr */
-{ setCreateAcctSQL(pInfo, TSDB_SQL_ALTER_ACCT, &yymsp[-1].minor.yy0, NULL, &yymsp[0].minor.yy219);}
+{ setCreateAcctSQL(pInfo, TSDB_SQL_ALTER_ACCT, &yymsp[-1].minor.yy0, NULL, &yymsp[0].minor.yy73);}
         break;
       case 40: /* cmd ::= ALTER ACCOUNT ids PASS ids acct_optr */
-{ setCreateAcctSQL(pInfo, TSDB_SQL_ALTER_ACCT, &yymsp[-3].minor.yy0, &yymsp[-1].minor.yy0, &yymsp[0].minor.yy219);}
+{ setCreateAcctSQL(pInfo, TSDB_SQL_ALTER_ACCT, &yymsp[-3].minor.yy0, &yymsp[-1].minor.yy0, &yymsp[0].minor.yy73);}
         break;
       case 41: /* ids ::= ID */
       case 42: /* ids ::= STRING */ yytestcase(yyruleno==42);
@@ -2142,10 +2154,10 @@ static void yy_reduce(
 { setDCLSQLElems(pInfo, TSDB_SQL_CREATE_DNODE, 1, &yymsp[0].minor.yy0);}
         break;
       case 48: /* cmd ::= CREATE ACCOUNT ids PASS ids acct_optr */
-{ setCreateAcctSQL(pInfo, TSDB_SQL_CREATE_ACCT, &yymsp[-3].minor.yy0, &yymsp[-1].minor.yy0, &yymsp[0].minor.yy219);}
+{ setCreateAcctSQL(pInfo, TSDB_SQL_CREATE_ACCT, &yymsp[-3].minor.yy0, &yymsp[-1].minor.yy0, &yymsp[0].minor.yy73);}
         break;
       case 49: /* cmd ::= CREATE DATABASE ifnotexists ids db_optr */
-{ setCreateDBSQL(pInfo, TSDB_SQL_CREATE_DB, &yymsp[-1].minor.yy0, &yymsp[0].minor.yy374, &yymsp[-2].minor.yy0);}
+{ setCreateDBSQL(pInfo, TSDB_SQL_CREATE_DB, &yymsp[-1].minor.yy0, &yymsp[0].minor.yy158, &yymsp[-2].minor.yy0);}
         break;
       case 50: /* cmd ::= CREATE USER ids PASS ids */
 { setCreateUserSQL(pInfo, &yymsp[-2].minor.yy0, &yymsp[0].minor.yy0);}
@@ -2174,20 +2186,20 @@ static void yy_reduce(
         break;
       case 69: /* acct_optr ::= pps tseries storage streams qtime dbs users conns state */
 {
-    yylhsminor.yy219.maxUsers   = (yymsp[-2].minor.yy0.n>0)?atoi(yymsp[-2].minor.yy0.z):-1;
-    yylhsminor.yy219.maxDbs     = (yymsp[-3].minor.yy0.n>0)?atoi(yymsp[-3].minor.yy0.z):-1;
-    yylhsminor.yy219.maxTimeSeries = (yymsp[-7].minor.yy0.n>0)?atoi(yymsp[-7].minor.yy0.z):-1;
-    yylhsminor.yy219.maxStreams = (yymsp[-5].minor.yy0.n>0)?atoi(yymsp[-5].minor.yy0.z):-1;
-    yylhsminor.yy219.maxPointsPerSecond     = (yymsp[-8].minor.yy0.n>0)?atoi(yymsp[-8].minor.yy0.z):-1;
-    yylhsminor.yy219.maxStorage = (yymsp[-6].minor.yy0.n>0)?strtoll(yymsp[-6].minor.yy0.z, NULL, 10):-1;
-    yylhsminor.yy219.maxQueryTime   = (yymsp[-4].minor.yy0.n>0)?strtoll(yymsp[-4].minor.yy0.z, NULL, 10):-1;
-    yylhsminor.yy219.maxConnections   = (yymsp[-1].minor.yy0.n>0)?atoi(yymsp[-1].minor.yy0.z):-1;
-    yylhsminor.yy219.stat    = yymsp[0].minor.yy0;
+    yylhsminor.yy73.maxUsers   = (yymsp[-2].minor.yy0.n>0)?atoi(yymsp[-2].minor.yy0.z):-1;
+    yylhsminor.yy73.maxDbs     = (yymsp[-3].minor.yy0.n>0)?atoi(yymsp[-3].minor.yy0.z):-1;
+    yylhsminor.yy73.maxTimeSeries = (yymsp[-7].minor.yy0.n>0)?atoi(yymsp[-7].minor.yy0.z):-1;
+    yylhsminor.yy73.maxStreams = (yymsp[-5].minor.yy0.n>0)?atoi(yymsp[-5].minor.yy0.z):-1;
+    yylhsminor.yy73.maxPointsPerSecond     = (yymsp[-8].minor.yy0.n>0)?atoi(yymsp[-8].minor.yy0.z):-1;
+    yylhsminor.yy73.maxStorage = (yymsp[-6].minor.yy0.n>0)?strtoll(yymsp[-6].minor.yy0.z, NULL, 10):-1;
+    yylhsminor.yy73.maxQueryTime   = (yymsp[-4].minor.yy0.n>0)?strtoll(yymsp[-4].minor.yy0.z, NULL, 10):-1;
+    yylhsminor.yy73.maxConnections   = (yymsp[-1].minor.yy0.n>0)?atoi(yymsp[-1].minor.yy0.z):-1;
+    yylhsminor.yy73.stat    = yymsp[0].minor.yy0;
 }
-  yymsp[-8].minor.yy219 = yylhsminor.yy219;
+  yymsp[-8].minor.yy73 = yylhsminor.yy73;
         break;
       case 70: /* keep ::= KEEP tagitemlist */
-{ yymsp[-1].minor.yy322 = yymsp[0].minor.yy322; }
+{ yymsp[-1].minor.yy494 = yymsp[0].minor.yy494; }
         break;
       case 71: /* tables ::= MAXTABLES INTEGER */
       case 72: /* cache ::= CACHE INTEGER */ yytestcase(yyruleno==72);
@@ -2203,85 +2215,85 @@ static void yy_reduce(
 { yymsp[-1].minor.yy0 = yymsp[0].minor.yy0; }
         break;
       case 82: /* db_optr ::= */
-{setDefaultCreateDbOption(&yymsp[1].minor.yy374);}
+{setDefaultCreateDbOption(&yymsp[1].minor.yy158);}
         break;
       case 83: /* db_optr ::= db_optr tables */
       case 97: /* alter_db_optr ::= alter_db_optr tables */ yytestcase(yyruleno==97);
-{ yylhsminor.yy374 = yymsp[-1].minor.yy374; yylhsminor.yy374.maxTablesPerVnode = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
-  yymsp[-1].minor.yy374 = yylhsminor.yy374;
+{ yylhsminor.yy158 = yymsp[-1].minor.yy158; yylhsminor.yy158.maxTablesPerVnode = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
+  yymsp[-1].minor.yy158 = yylhsminor.yy158;
         break;
       case 84: /* db_optr ::= db_optr cache */
-{ yylhsminor.yy374 = yymsp[-1].minor.yy374; yylhsminor.yy374.cacheBlockSize = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
-  yymsp[-1].minor.yy374 = yylhsminor.yy374;
+{ yylhsminor.yy158 = yymsp[-1].minor.yy158; yylhsminor.yy158.cacheBlockSize = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
+  yymsp[-1].minor.yy158 = yylhsminor.yy158;
         break;
       case 85: /* db_optr ::= db_optr replica */
       case 96: /* alter_db_optr ::= alter_db_optr replica */ yytestcase(yyruleno==96);
-{ yylhsminor.yy374 = yymsp[-1].minor.yy374; yylhsminor.yy374.replica = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
-  yymsp[-1].minor.yy374 = yylhsminor.yy374;
+{ yylhsminor.yy158 = yymsp[-1].minor.yy158; yylhsminor.yy158.replica = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
+  yymsp[-1].minor.yy158 = yylhsminor.yy158;
         break;
       case 86: /* db_optr ::= db_optr days */
-{ yylhsminor.yy374 = yymsp[-1].minor.yy374; yylhsminor.yy374.daysPerFile = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
-  yymsp[-1].minor.yy374 = yylhsminor.yy374;
+{ yylhsminor.yy158 = yymsp[-1].minor.yy158; yylhsminor.yy158.daysPerFile = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
+  yymsp[-1].minor.yy158 = yylhsminor.yy158;
         break;
       case 87: /* db_optr ::= db_optr minrows */
-{ yylhsminor.yy374 = yymsp[-1].minor.yy374; yylhsminor.yy374.minRowsPerBlock = strtod(yymsp[0].minor.yy0.z, NULL); }
-  yymsp[-1].minor.yy374 = yylhsminor.yy374;
+{ yylhsminor.yy158 = yymsp[-1].minor.yy158; yylhsminor.yy158.minRowsPerBlock = strtod(yymsp[0].minor.yy0.z, NULL); }
+  yymsp[-1].minor.yy158 = yylhsminor.yy158;
         break;
       case 88: /* db_optr ::= db_optr maxrows */
-{ yylhsminor.yy374 = yymsp[-1].minor.yy374; yylhsminor.yy374.maxRowsPerBlock = strtod(yymsp[0].minor.yy0.z, NULL); }
-  yymsp[-1].minor.yy374 = yylhsminor.yy374;
+{ yylhsminor.yy158 = yymsp[-1].minor.yy158; yylhsminor.yy158.maxRowsPerBlock = strtod(yymsp[0].minor.yy0.z, NULL); }
+  yymsp[-1].minor.yy158 = yylhsminor.yy158;
         break;
       case 89: /* db_optr ::= db_optr blocks */
       case 99: /* alter_db_optr ::= alter_db_optr blocks */ yytestcase(yyruleno==99);
-{ yylhsminor.yy374 = yymsp[-1].minor.yy374; yylhsminor.yy374.numOfBlocks = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
-  yymsp[-1].minor.yy374 = yylhsminor.yy374;
+{ yylhsminor.yy158 = yymsp[-1].minor.yy158; yylhsminor.yy158.numOfBlocks = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
+  yymsp[-1].minor.yy158 = yylhsminor.yy158;
         break;
       case 90: /* db_optr ::= db_optr ctime */
-{ yylhsminor.yy374 = yymsp[-1].minor.yy374; yylhsminor.yy374.commitTime = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
-  yymsp[-1].minor.yy374 = yylhsminor.yy374;
+{ yylhsminor.yy158 = yymsp[-1].minor.yy158; yylhsminor.yy158.commitTime = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
+  yymsp[-1].minor.yy158 = yylhsminor.yy158;
         break;
       case 91: /* db_optr ::= db_optr wal */
       case 101: /* alter_db_optr ::= alter_db_optr wal */ yytestcase(yyruleno==101);
-{ yylhsminor.yy374 = yymsp[-1].minor.yy374; yylhsminor.yy374.walLevel = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
-  yymsp[-1].minor.yy374 = yylhsminor.yy374;
+{ yylhsminor.yy158 = yymsp[-1].minor.yy158; yylhsminor.yy158.walLevel = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
+  yymsp[-1].minor.yy158 = yylhsminor.yy158;
         break;
       case 92: /* db_optr ::= db_optr comp */
       case 100: /* alter_db_optr ::= alter_db_optr comp */ yytestcase(yyruleno==100);
-{ yylhsminor.yy374 = yymsp[-1].minor.yy374; yylhsminor.yy374.compressionLevel = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
-  yymsp[-1].minor.yy374 = yylhsminor.yy374;
+{ yylhsminor.yy158 = yymsp[-1].minor.yy158; yylhsminor.yy158.compressionLevel = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
+  yymsp[-1].minor.yy158 = yylhsminor.yy158;
         break;
       case 93: /* db_optr ::= db_optr prec */
-{ yylhsminor.yy374 = yymsp[-1].minor.yy374; yylhsminor.yy374.precision = yymsp[0].minor.yy0; }
-  yymsp[-1].minor.yy374 = yylhsminor.yy374;
+{ yylhsminor.yy158 = yymsp[-1].minor.yy158; yylhsminor.yy158.precision = yymsp[0].minor.yy0; }
+  yymsp[-1].minor.yy158 = yylhsminor.yy158;
         break;
       case 94: /* db_optr ::= db_optr keep */
       case 98: /* alter_db_optr ::= alter_db_optr keep */ yytestcase(yyruleno==98);
-{ yylhsminor.yy374 = yymsp[-1].minor.yy374; yylhsminor.yy374.keep = yymsp[0].minor.yy322; }
-  yymsp[-1].minor.yy374 = yylhsminor.yy374;
+{ yylhsminor.yy158 = yymsp[-1].minor.yy158; yylhsminor.yy158.keep = yymsp[0].minor.yy494; }
+  yymsp[-1].minor.yy158 = yylhsminor.yy158;
         break;
       case 95: /* alter_db_optr ::= */
-{ setDefaultCreateDbOption(&yymsp[1].minor.yy374);}
+{ setDefaultCreateDbOption(&yymsp[1].minor.yy158);}
         break;
       case 102: /* typename ::= ids */
-{ tSQLSetColumnType (&yylhsminor.yy325, &yymsp[0].minor.yy0); }
-  yymsp[0].minor.yy325 = yylhsminor.yy325;
+{ tSQLSetColumnType (&yylhsminor.yy181, &yymsp[0].minor.yy0); }
+  yymsp[0].minor.yy181 = yylhsminor.yy181;
         break;
       case 103: /* typename ::= ids LP signed RP */
 {
-    yymsp[-3].minor.yy0.type = -yymsp[-1].minor.yy279;          // negative value of name length
-    tSQLSetColumnType(&yylhsminor.yy325, &yymsp[-3].minor.yy0);
+    yymsp[-3].minor.yy0.type = -yymsp[-1].minor.yy271;          // negative value of name length
+    tSQLSetColumnType(&yylhsminor.yy181, &yymsp[-3].minor.yy0);
 }
-  yymsp[-3].minor.yy325 = yylhsminor.yy325;
+  yymsp[-3].minor.yy181 = yylhsminor.yy181;
         break;
       case 104: /* signed ::= INTEGER */
-{ yylhsminor.yy279 = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
-  yymsp[0].minor.yy279 = yylhsminor.yy279;
+{ yylhsminor.yy271 = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
+  yymsp[0].minor.yy271 = yylhsminor.yy271;
         break;
       case 105: /* signed ::= PLUS INTEGER */
-{ yymsp[-1].minor.yy279 = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
+{ yymsp[-1].minor.yy271 = strtol(yymsp[0].minor.yy0.z, NULL, 10); }
         break;
       case 106: /* signed ::= MINUS INTEGER */
-{ yymsp[-1].minor.yy279 = -strtol(yymsp[0].minor.yy0.z, NULL, 10);}
+{ yymsp[-1].minor.yy271 = -strtol(yymsp[0].minor.yy0.z, NULL, 10);}
         break;
       case 107: /* cmd ::= CREATE TABLE ifnotexists ids cpxName create_table_args */
 {
@@ -2291,61 +2303,61 @@ static void yy_reduce(
         break;
       case 108: /* create_table_args ::= LP columnlist RP */
 {
-    yymsp[-2].minor.yy408 = tSetCreateSQLElems(yymsp[-1].minor.yy369, NULL, NULL, NULL, NULL, TSQL_CREATE_TABLE);
-    setSQLInfo(pInfo, yymsp[-2].minor.yy408, NULL, TSDB_SQL_CREATE_TABLE);
+    yymsp[-2].minor.yy374 = tSetCreateSQLElems(yymsp[-1].minor.yy449, NULL, NULL, NULL, NULL, TSQL_CREATE_TABLE);
+    setSQLInfo(pInfo, yymsp[-2].minor.yy374, NULL, TSDB_SQL_CREATE_TABLE);
 }
         break;
       case 109: /* create_table_args ::= LP columnlist RP TAGS LP columnlist RP */
 {
-    yymsp[-6].minor.yy408 = tSetCreateSQLElems(yymsp[-5].minor.yy369, yymsp[-1].minor.yy369, NULL, NULL, NULL, TSQL_CREATE_STABLE);
-    setSQLInfo(pInfo, yymsp[-6].minor.yy408, NULL, TSDB_SQL_CREATE_TABLE);
+    yymsp[-6].minor.yy374 = tSetCreateSQLElems(yymsp[-5].minor.yy449, yymsp[-1].minor.yy449, NULL, NULL, NULL, TSQL_CREATE_STABLE);
+    setSQLInfo(pInfo, yymsp[-6].minor.yy374, NULL, TSDB_SQL_CREATE_TABLE);
 }
         break;
       case 110: /* create_table_args ::= USING ids cpxName TAGS LP tagitemlist RP */
 {
     yymsp[-5].minor.yy0.n += yymsp[-4].minor.yy0.n;
-    yymsp[-6].minor.yy408 = tSetCreateSQLElems(NULL, NULL, &yymsp[-5].minor.yy0, yymsp[-1].minor.yy322, NULL, TSQL_CREATE_TABLE_FROM_STABLE);
-    setSQLInfo(pInfo, yymsp[-6].minor.yy408, NULL, TSDB_SQL_CREATE_TABLE);
+    yymsp[-6].minor.yy374 = tSetCreateSQLElems(NULL, NULL, &yymsp[-5].minor.yy0, yymsp[-1].minor.yy494, NULL, TSQL_CREATE_TABLE_FROM_STABLE);
+    setSQLInfo(pInfo, yymsp[-6].minor.yy374, NULL, TSDB_SQL_CREATE_TABLE);
 }
         break;
       case 111: /* create_table_args ::= AS select */
 {
-    yymsp[-1].minor.yy408 = tSetCreateSQLElems(NULL, NULL, NULL, NULL, yymsp[0].minor.yy190, TSQL_CREATE_STREAM);
-    setSQLInfo(pInfo, yymsp[-1].minor.yy408, NULL, TSDB_SQL_CREATE_TABLE);
+    yymsp[-1].minor.yy374 = tSetCreateSQLElems(NULL, NULL, NULL, NULL, yymsp[0].minor.yy150, TSQL_CREATE_STREAM);
+    setSQLInfo(pInfo, yymsp[-1].minor.yy374, NULL, TSDB_SQL_CREATE_TABLE);
 }
         break;
       case 112: /* columnlist ::= columnlist COMMA column */
-{yylhsminor.yy369 = tFieldListAppend(yymsp[-2].minor.yy369, &yymsp[0].minor.yy325);   }
-  yymsp[-2].minor.yy369 = yylhsminor.yy369;
+{yylhsminor.yy449 = tFieldListAppend(yymsp[-2].minor.yy449, &yymsp[0].minor.yy181);   }
+  yymsp[-2].minor.yy449 = yylhsminor.yy449;
         break;
       case 113: /* columnlist ::= column */
-{yylhsminor.yy369 = tFieldListAppend(NULL, &yymsp[0].minor.yy325);}
-  yymsp[0].minor.yy369 = yylhsminor.yy369;
+{yylhsminor.yy449 = tFieldListAppend(NULL, &yymsp[0].minor.yy181);}
+  yymsp[0].minor.yy449 = yylhsminor.yy449;
         break;
       case 114: /* column ::= ids typename */
 {
-    tSQLSetColumnInfo(&yylhsminor.yy325, &yymsp[-1].minor.yy0, &yymsp[0].minor.yy325);
+    tSQLSetColumnInfo(&yylhsminor.yy181, &yymsp[-1].minor.yy0, &yymsp[0].minor.yy181);
 }
-  yymsp[-1].minor.yy325 = yylhsminor.yy325;
+  yymsp[-1].minor.yy181 = yylhsminor.yy181;
         break;
       case 115: /* tagitemlist ::= tagitemlist COMMA tagitem */
-{ yylhsminor.yy322 = tVariantListAppend(yymsp[-2].minor.yy322, &yymsp[0].minor.yy518, -1);    }
-  yymsp[-2].minor.yy322 = yylhsminor.yy322;
+{ yylhsminor.yy494 = tVariantListAppend(yymsp[-2].minor.yy494, &yymsp[0].minor.yy312, -1);    }
+  yymsp[-2].minor.yy494 = yylhsminor.yy494;
         break;
       case 116: /* tagitemlist ::= tagitem */
-{ yylhsminor.yy322 = tVariantListAppend(NULL, &yymsp[0].minor.yy518, -1); }
-  yymsp[0].minor.yy322 = yylhsminor.yy322;
+{ yylhsminor.yy494 = tVariantListAppend(NULL, &yymsp[0].minor.yy312, -1); }
+  yymsp[0].minor.yy494 = yylhsminor.yy494;
         break;
       case 117: /* tagitem ::= INTEGER */
       case 118: /* tagitem ::= FLOAT */ yytestcase(yyruleno==118);
       case 119: /* tagitem ::= STRING */ yytestcase(yyruleno==119);
       case 120: /* tagitem ::= BOOL */ yytestcase(yyruleno==120);
-{toTSDBType(yymsp[0].minor.yy0.type); tVariantCreate(&yylhsminor.yy518, &yymsp[0].minor.yy0); }
-  yymsp[0].minor.yy518 = yylhsminor.yy518;
+{toTSDBType(yymsp[0].minor.yy0.type); tVariantCreate(&yylhsminor.yy312, &yymsp[0].minor.yy0); }
+  yymsp[0].minor.yy312 = yylhsminor.yy312;
         break;
       case 121: /* tagitem ::= NULL */
-{ yymsp[0].minor.yy0.type = 0; tVariantCreate(&yylhsminor.yy518, &yymsp[0].minor.yy0); }
-  yymsp[0].minor.yy518 = yylhsminor.yy518;
+{ yymsp[0].minor.yy0.type = 0; tVariantCreate(&yylhsminor.yy312, &yymsp[0].minor.yy0); }
+  yymsp[0].minor.yy312 = yylhsminor.yy312;
         break;
       case 122: /* tagitem ::= MINUS INTEGER */
       case 123: /* tagitem ::= MINUS FLOAT */ yytestcase(yyruleno==123);
@@ -2355,59 +2367,59 @@ static void yy_reduce(
     yymsp[-1].minor.yy0.n += yymsp[0].minor.yy0.n;
     yymsp[-1].minor.yy0.type = yymsp[0].minor.yy0.type;
     toTSDBType(yymsp[-1].minor.yy0.type);
-    tVariantCreate(&yylhsminor.yy518, &yymsp[-1].minor.yy0);
+    tVariantCreate(&yylhsminor.yy312, &yymsp[-1].minor.yy0);
 }
-  yymsp[-1].minor.yy518 = yylhsminor.yy518;
+  yymsp[-1].minor.yy312 = yylhsminor.yy312;
         break;
-      case 126: /* select ::= SELECT selcollist from where_opt interval_opt fill_opt sliding_opt groupby_opt orderby_opt having_opt slimit_opt limit_opt */
+      case 126: /* select ::= SELECT selcollist from where_opt interval_opt window_opt fill_opt sliding_opt groupby_opt orderby_opt having_opt slimit_opt limit_opt */
 {
-  yylhsminor.yy190 = tSetQuerySQLElems(&yymsp[-11].minor.yy0, yymsp[-10].minor.yy260, yymsp[-9].minor.yy322, yymsp[-8].minor.yy500, yymsp[-4].minor.yy322, yymsp[-3].minor.yy322, &yymsp[-7].minor.yy0, &yymsp[-5].minor.yy0, yymsp[-6].minor.yy322, &yymsp[0].minor.yy284, &yymsp[-1].minor.yy284);
+  yylhsminor.yy150 = tSetQuerySQLElems(&yymsp[-12].minor.yy0, yymsp[-11].minor.yy224, yymsp[-10].minor.yy494, yymsp[-9].minor.yy66, yymsp[-4].minor.yy494, yymsp[-3].minor.yy494, &yymsp[-8].minor.yy0, &yymsp[-7].minor.yy458, &yymsp[-5].minor.yy0, yymsp[-6].minor.yy494, &yymsp[0].minor.yy188, &yymsp[-1].minor.yy188);
 }
-  yymsp[-11].minor.yy190 = yylhsminor.yy190;
+  yymsp[-12].minor.yy150 = yylhsminor.yy150;
         break;
       case 127: /* union ::= select */
-{ yylhsminor.yy263 = setSubclause(NULL, yymsp[0].minor.yy190); }
-  yymsp[0].minor.yy263 = yylhsminor.yy263;
+{ yylhsminor.yy25 = setSubclause(NULL, yymsp[0].minor.yy150); }
+  yymsp[0].minor.yy25 = yylhsminor.yy25;
         break;
       case 128: /* union ::= LP union RP */
-{ yymsp[-2].minor.yy263 = yymsp[-1].minor.yy263; }
+{ yymsp[-2].minor.yy25 = yymsp[-1].minor.yy25; }
         break;
       case 129: /* union ::= union UNION ALL select */
-{ yylhsminor.yy263 = appendSelectClause(yymsp[-3].minor.yy263, yymsp[0].minor.yy190); }
-  yymsp[-3].minor.yy263 = yylhsminor.yy263;
+{ yylhsminor.yy25 = appendSelectClause(yymsp[-3].minor.yy25, yymsp[0].minor.yy150); }
+  yymsp[-3].minor.yy25 = yylhsminor.yy25;
         break;
       case 130: /* union ::= union UNION ALL LP select RP */
-{ yylhsminor.yy263 = appendSelectClause(yymsp[-5].minor.yy263, yymsp[-1].minor.yy190); }
-  yymsp[-5].minor.yy263 = yylhsminor.yy263;
+{ yylhsminor.yy25 = appendSelectClause(yymsp[-5].minor.yy25, yymsp[-1].minor.yy150); }
+  yymsp[-5].minor.yy25 = yylhsminor.yy25;
         break;
       case 131: /* cmd ::= union */
-{ setSQLInfo(pInfo, yymsp[0].minor.yy263, NULL, TSDB_SQL_SELECT); }
+{ setSQLInfo(pInfo, yymsp[0].minor.yy25, NULL, TSDB_SQL_SELECT); }
         break;
       case 132: /* select ::= SELECT selcollist */
 {
-  yylhsminor.yy190 = tSetQuerySQLElems(&yymsp[-1].minor.yy0, yymsp[0].minor.yy260, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+  yylhsminor.yy150 = tSetQuerySQLElems(&yymsp[-1].minor.yy0, yymsp[0].minor.yy224, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
-  yymsp[-1].minor.yy190 = yylhsminor.yy190;
+  yymsp[-1].minor.yy150 = yylhsminor.yy150;
         break;
       case 133: /* sclp ::= selcollist COMMA */
-{yylhsminor.yy260 = yymsp[-1].minor.yy260;}
-  yymsp[-1].minor.yy260 = yylhsminor.yy260;
+{yylhsminor.yy224 = yymsp[-1].minor.yy224;}
+  yymsp[-1].minor.yy224 = yylhsminor.yy224;
         break;
       case 134: /* sclp ::= */
-{yymsp[1].minor.yy260 = 0;}
+{yymsp[1].minor.yy224 = 0;}
         break;
       case 135: /* selcollist ::= sclp expr as */
 {
-   yylhsminor.yy260 = tSQLExprListAppend(yymsp[-2].minor.yy260, yymsp[-1].minor.yy500, yymsp[0].minor.yy0.n?&yymsp[0].minor.yy0:0);
+   yylhsminor.yy224 = tSQLExprListAppend(yymsp[-2].minor.yy224, yymsp[-1].minor.yy66, yymsp[0].minor.yy0.n?&yymsp[0].minor.yy0:0);
 }
-  yymsp[-2].minor.yy260 = yylhsminor.yy260;
+  yymsp[-2].minor.yy224 = yylhsminor.yy224;
         break;
       case 136: /* selcollist ::= sclp STAR */
 {
    tSQLExpr *pNode = tSQLExprIdValueCreate(NULL, TK_ALL);
-   yylhsminor.yy260 = tSQLExprListAppend(yymsp[-1].minor.yy260, pNode, 0);
+   yylhsminor.yy224 = tSQLExprListAppend(yymsp[-1].minor.yy224, pNode, 0);
 }
-  yymsp[-1].minor.yy260 = yylhsminor.yy260;
+  yymsp[-1].minor.yy224 = yylhsminor.yy224;
         break;
       case 137: /* as ::= AS ids */
 { yymsp[-1].minor.yy0 = yymsp[0].minor.yy0;    }
@@ -2420,266 +2432,277 @@ static void yy_reduce(
 { yymsp[1].minor.yy0.n = 0;  }
         break;
       case 140: /* from ::= FROM tablelist */
-{yymsp[-1].minor.yy322 = yymsp[0].minor.yy322;}
+{yymsp[-1].minor.yy494 = yymsp[0].minor.yy494;}
         break;
       case 141: /* tablelist ::= ids cpxName */
-{ toTSDBType(yymsp[-1].minor.yy0.type); yymsp[-1].minor.yy0.n += yymsp[0].minor.yy0.n; yylhsminor.yy322 = tVariantListAppendToken(NULL, &yymsp[-1].minor.yy0, -1);}
-  yymsp[-1].minor.yy322 = yylhsminor.yy322;
+{ toTSDBType(yymsp[-1].minor.yy0.type); yymsp[-1].minor.yy0.n += yymsp[0].minor.yy0.n; yylhsminor.yy494 = tVariantListAppendToken(NULL, &yymsp[-1].minor.yy0, -1);}
+  yymsp[-1].minor.yy494 = yylhsminor.yy494;
         break;
       case 142: /* tablelist ::= tablelist COMMA ids cpxName */
-{ toTSDBType(yymsp[-1].minor.yy0.type); yymsp[-1].minor.yy0.n += yymsp[0].minor.yy0.n; yylhsminor.yy322 = tVariantListAppendToken(yymsp[-3].minor.yy322, &yymsp[-1].minor.yy0, -1);   }
-  yymsp[-3].minor.yy322 = yylhsminor.yy322;
+{ toTSDBType(yymsp[-1].minor.yy0.type); yymsp[-1].minor.yy0.n += yymsp[0].minor.yy0.n; yylhsminor.yy494 = tVariantListAppendToken(yymsp[-3].minor.yy494, &yymsp[-1].minor.yy0, -1);   }
+  yymsp[-3].minor.yy494 = yylhsminor.yy494;
         break;
       case 143: /* tmvar ::= VARIABLE */
 {yylhsminor.yy0 = yymsp[0].minor.yy0;}
   yymsp[0].minor.yy0 = yylhsminor.yy0;
         break;
       case 144: /* interval_opt ::= INTERVAL LP tmvar RP */
-      case 149: /* sliding_opt ::= SLIDING LP tmvar RP */ yytestcase(yyruleno==149);
+      case 152: /* sliding_opt ::= SLIDING LP tmvar RP */ yytestcase(yyruleno==152);
 {yymsp[-3].minor.yy0 = yymsp[-1].minor.yy0;     }
         break;
       case 145: /* interval_opt ::= */
-      case 150: /* sliding_opt ::= */ yytestcase(yyruleno==150);
+      case 153: /* sliding_opt ::= */ yytestcase(yyruleno==153);
 {yymsp[1].minor.yy0.n = 0; yymsp[1].minor.yy0.z = NULL; yymsp[1].minor.yy0.type = 0;   }
         break;
-      case 146: /* fill_opt ::= */
-{yymsp[1].minor.yy322 = 0;     }
+      case 146: /* window_opt ::= ID LP ids COMMA tmvar RP */
+{yylhsminor.yy458.name = yymsp[-5].minor.yy0; yylhsminor.yy458.col = yymsp[-3].minor.yy0; yylhsminor.yy458.gap = yymsp[-1].minor.yy0;   }
+  yymsp[-5].minor.yy458 = yylhsminor.yy458;
         break;
-      case 147: /* fill_opt ::= FILL LP ID COMMA tagitemlist RP */
+      case 147: /* window_opt ::= ID LP ids RP */
+{yylhsminor.yy458.name = yymsp[-3].minor.yy0; yylhsminor.yy458.col = yymsp[-1].minor.yy0; yylhsminor.yy458.gap.n = 0; yylhsminor.yy458.gap.z = NULL; yylhsminor.yy458.gap.type = 0;}
+  yymsp[-3].minor.yy458 = yylhsminor.yy458;
+        break;
+      case 148: /* window_opt ::= */
+{memset(&yymsp[1].minor.yy458, 0, sizeof(yymsp[1].minor.yy458));}
+        break;
+      case 149: /* fill_opt ::= */
+{yymsp[1].minor.yy494 = 0;     }
+        break;
+      case 150: /* fill_opt ::= FILL LP ID COMMA tagitemlist RP */
 {
     tVariant A = {0};
     toTSDBType(yymsp[-3].minor.yy0.type);
     tVariantCreate(&A, &yymsp[-3].minor.yy0);
 
-    tVariantListInsert(yymsp[-1].minor.yy322, &A, -1, 0);
-    yymsp[-5].minor.yy322 = yymsp[-1].minor.yy322;
+    tVariantListInsert(yymsp[-1].minor.yy494, &A, -1, 0);
+    yymsp[-5].minor.yy494 = yymsp[-1].minor.yy494;
 }
         break;
-      case 148: /* fill_opt ::= FILL LP ID RP */
+      case 151: /* fill_opt ::= FILL LP ID RP */
 {
     toTSDBType(yymsp[-1].minor.yy0.type);
-    yymsp[-3].minor.yy322 = tVariantListAppendToken(NULL, &yymsp[-1].minor.yy0, -1);
+    yymsp[-3].minor.yy494 = tVariantListAppendToken(NULL, &yymsp[-1].minor.yy0, -1);
 }
         break;
-      case 151: /* orderby_opt ::= */
-      case 159: /* groupby_opt ::= */ yytestcase(yyruleno==159);
-{yymsp[1].minor.yy322 = 0;}
+      case 154: /* orderby_opt ::= */
+      case 162: /* groupby_opt ::= */ yytestcase(yyruleno==162);
+{yymsp[1].minor.yy494 = 0;}
         break;
-      case 152: /* orderby_opt ::= ORDER BY sortlist */
-      case 160: /* groupby_opt ::= GROUP BY grouplist */ yytestcase(yyruleno==160);
-{yymsp[-2].minor.yy322 = yymsp[0].minor.yy322;}
+      case 155: /* orderby_opt ::= ORDER BY sortlist */
+      case 163: /* groupby_opt ::= GROUP BY grouplist */ yytestcase(yyruleno==163);
+{yymsp[-2].minor.yy494 = yymsp[0].minor.yy494;}
         break;
-      case 153: /* sortlist ::= sortlist COMMA item sortorder */
+      case 156: /* sortlist ::= sortlist COMMA item sortorder */
 {
-    yylhsminor.yy322 = tVariantListAppend(yymsp[-3].minor.yy322, &yymsp[-1].minor.yy518, yymsp[0].minor.yy150);
+    yylhsminor.yy494 = tVariantListAppend(yymsp[-3].minor.yy494, &yymsp[-1].minor.yy312, yymsp[0].minor.yy82);
 }
-  yymsp[-3].minor.yy322 = yylhsminor.yy322;
+  yymsp[-3].minor.yy494 = yylhsminor.yy494;
         break;
-      case 154: /* sortlist ::= item sortorder */
+      case 157: /* sortlist ::= item sortorder */
 {
-  yylhsminor.yy322 = tVariantListAppend(NULL, &yymsp[-1].minor.yy518, yymsp[0].minor.yy150);
+  yylhsminor.yy494 = tVariantListAppend(NULL, &yymsp[-1].minor.yy312, yymsp[0].minor.yy82);
 }
-  yymsp[-1].minor.yy322 = yylhsminor.yy322;
+  yymsp[-1].minor.yy494 = yylhsminor.yy494;
         break;
-      case 155: /* item ::= ids cpxName */
+      case 158: /* item ::= ids cpxName */
 {
   toTSDBType(yymsp[-1].minor.yy0.type);
   yymsp[-1].minor.yy0.n += yymsp[0].minor.yy0.n;
 
-  tVariantCreate(&yylhsminor.yy518, &yymsp[-1].minor.yy0);
+  tVariantCreate(&yylhsminor.yy312, &yymsp[-1].minor.yy0);
 }
-  yymsp[-1].minor.yy518 = yylhsminor.yy518;
+  yymsp[-1].minor.yy312 = yylhsminor.yy312;
         break;
-      case 156: /* sortorder ::= ASC */
-{yymsp[0].minor.yy150 = TSDB_ORDER_ASC; }
+      case 159: /* sortorder ::= ASC */
+{yymsp[0].minor.yy82 = TSDB_ORDER_ASC; }
         break;
-      case 157: /* sortorder ::= DESC */
-{yymsp[0].minor.yy150 = TSDB_ORDER_DESC;}
+      case 160: /* sortorder ::= DESC */
+{yymsp[0].minor.yy82 = TSDB_ORDER_DESC;}
         break;
-      case 158: /* sortorder ::= */
-{yymsp[1].minor.yy150 = TSDB_ORDER_ASC;}
+      case 161: /* sortorder ::= */
+{yymsp[1].minor.yy82 = TSDB_ORDER_ASC;}
         break;
-      case 161: /* grouplist ::= grouplist COMMA item */
+      case 164: /* grouplist ::= grouplist COMMA item */
 {
-  yylhsminor.yy322 = tVariantListAppend(yymsp[-2].minor.yy322, &yymsp[0].minor.yy518, -1);
+  yylhsminor.yy494 = tVariantListAppend(yymsp[-2].minor.yy494, &yymsp[0].minor.yy312, -1);
 }
-  yymsp[-2].minor.yy322 = yylhsminor.yy322;
+  yymsp[-2].minor.yy494 = yylhsminor.yy494;
         break;
-      case 162: /* grouplist ::= item */
+      case 165: /* grouplist ::= item */
 {
-  yylhsminor.yy322 = tVariantListAppend(NULL, &yymsp[0].minor.yy518, -1);
+  yylhsminor.yy494 = tVariantListAppend(NULL, &yymsp[0].minor.yy312, -1);
 }
-  yymsp[0].minor.yy322 = yylhsminor.yy322;
+  yymsp[0].minor.yy494 = yylhsminor.yy494;
         break;
-      case 163: /* having_opt ::= */
-      case 173: /* where_opt ::= */ yytestcase(yyruleno==173);
-      case 209: /* expritem ::= */ yytestcase(yyruleno==209);
-{yymsp[1].minor.yy500 = 0;}
+      case 166: /* having_opt ::= */
+      case 176: /* where_opt ::= */ yytestcase(yyruleno==176);
+      case 212: /* expritem ::= */ yytestcase(yyruleno==212);
+{yymsp[1].minor.yy66 = 0;}
         break;
-      case 164: /* having_opt ::= HAVING expr */
-      case 174: /* where_opt ::= WHERE expr */ yytestcase(yyruleno==174);
-{yymsp[-1].minor.yy500 = yymsp[0].minor.yy500;}
+      case 167: /* having_opt ::= HAVING expr */
+      case 177: /* where_opt ::= WHERE expr */ yytestcase(yyruleno==177);
+{yymsp[-1].minor.yy66 = yymsp[0].minor.yy66;}
         break;
-      case 165: /* limit_opt ::= */
-      case 169: /* slimit_opt ::= */ yytestcase(yyruleno==169);
-{yymsp[1].minor.yy284.limit = -1; yymsp[1].minor.yy284.offset = 0;}
+      case 168: /* limit_opt ::= */
+      case 172: /* slimit_opt ::= */ yytestcase(yyruleno==172);
+{yymsp[1].minor.yy188.limit = -1; yymsp[1].minor.yy188.offset = 0;}
         break;
-      case 166: /* limit_opt ::= LIMIT signed */
-      case 170: /* slimit_opt ::= SLIMIT signed */ yytestcase(yyruleno==170);
-{yymsp[-1].minor.yy284.limit = yymsp[0].minor.yy279;  yymsp[-1].minor.yy284.offset = 0;}
+      case 169: /* limit_opt ::= LIMIT signed */
+      case 173: /* slimit_opt ::= SLIMIT signed */ yytestcase(yyruleno==173);
+{yymsp[-1].minor.yy188.limit = yymsp[0].minor.yy271;  yymsp[-1].minor.yy188.offset = 0;}
         break;
-      case 167: /* limit_opt ::= LIMIT signed OFFSET signed */
-      case 171: /* slimit_opt ::= SLIMIT signed SOFFSET signed */ yytestcase(yyruleno==171);
-{yymsp[-3].minor.yy284.limit = yymsp[-2].minor.yy279;  yymsp[-3].minor.yy284.offset = yymsp[0].minor.yy279;}
+      case 170: /* limit_opt ::= LIMIT signed OFFSET signed */
+      case 174: /* slimit_opt ::= SLIMIT signed SOFFSET signed */ yytestcase(yyruleno==174);
+{yymsp[-3].minor.yy188.limit = yymsp[-2].minor.yy271;  yymsp[-3].minor.yy188.offset = yymsp[0].minor.yy271;}
         break;
-      case 168: /* limit_opt ::= LIMIT signed COMMA signed */
-      case 172: /* slimit_opt ::= SLIMIT signed COMMA signed */ yytestcase(yyruleno==172);
-{yymsp[-3].minor.yy284.limit = yymsp[0].minor.yy279;  yymsp[-3].minor.yy284.offset = yymsp[-2].minor.yy279;}
+      case 171: /* limit_opt ::= LIMIT signed COMMA signed */
+      case 175: /* slimit_opt ::= SLIMIT signed COMMA signed */ yytestcase(yyruleno==175);
+{yymsp[-3].minor.yy188.limit = yymsp[0].minor.yy271;  yymsp[-3].minor.yy188.offset = yymsp[-2].minor.yy271;}
         break;
-      case 175: /* expr ::= LP expr RP */
-{yymsp[-2].minor.yy500 = yymsp[-1].minor.yy500; }
+      case 178: /* expr ::= LP expr RP */
+{yymsp[-2].minor.yy66 = yymsp[-1].minor.yy66; }
         break;
-      case 176: /* expr ::= ID */
-{yylhsminor.yy500 = tSQLExprIdValueCreate(&yymsp[0].minor.yy0, TK_ID);}
-  yymsp[0].minor.yy500 = yylhsminor.yy500;
+      case 179: /* expr ::= ID */
+{yylhsminor.yy66 = tSQLExprIdValueCreate(&yymsp[0].minor.yy0, TK_ID);}
+  yymsp[0].minor.yy66 = yylhsminor.yy66;
         break;
-      case 177: /* expr ::= ID DOT ID */
-{yymsp[-2].minor.yy0.n += (1+yymsp[0].minor.yy0.n); yylhsminor.yy500 = tSQLExprIdValueCreate(&yymsp[-2].minor.yy0, TK_ID);}
-  yymsp[-2].minor.yy500 = yylhsminor.yy500;
+      case 180: /* expr ::= ID DOT ID */
+{yymsp[-2].minor.yy0.n += (1+yymsp[0].minor.yy0.n); yylhsminor.yy66 = tSQLExprIdValueCreate(&yymsp[-2].minor.yy0, TK_ID);}
+  yymsp[-2].minor.yy66 = yylhsminor.yy66;
         break;
-      case 178: /* expr ::= ID DOT STAR */
-{yymsp[-2].minor.yy0.n += (1+yymsp[0].minor.yy0.n); yylhsminor.yy500 = tSQLExprIdValueCreate(&yymsp[-2].minor.yy0, TK_ALL);}
-  yymsp[-2].minor.yy500 = yylhsminor.yy500;
+      case 181: /* expr ::= ID DOT STAR */
+{yymsp[-2].minor.yy0.n += (1+yymsp[0].minor.yy0.n); yylhsminor.yy66 = tSQLExprIdValueCreate(&yymsp[-2].minor.yy0, TK_ALL);}
+  yymsp[-2].minor.yy66 = yylhsminor.yy66;
         break;
-      case 179: /* expr ::= INTEGER */
-{yylhsminor.yy500 = tSQLExprIdValueCreate(&yymsp[0].minor.yy0, TK_INTEGER);}
-  yymsp[0].minor.yy500 = yylhsminor.yy500;
+      case 182: /* expr ::= INTEGER */
+{yylhsminor.yy66 = tSQLExprIdValueCreate(&yymsp[0].minor.yy0, TK_INTEGER);}
+  yymsp[0].minor.yy66 = yylhsminor.yy66;
         break;
-      case 180: /* expr ::= MINUS INTEGER */
-      case 181: /* expr ::= PLUS INTEGER */ yytestcase(yyruleno==181);
-{yymsp[-1].minor.yy0.n += yymsp[0].minor.yy0.n; yymsp[-1].minor.yy0.type = TK_INTEGER; yylhsminor.yy500 = tSQLExprIdValueCreate(&yymsp[-1].minor.yy0, TK_INTEGER);}
-  yymsp[-1].minor.yy500 = yylhsminor.yy500;
+      case 183: /* expr ::= MINUS INTEGER */
+      case 184: /* expr ::= PLUS INTEGER */ yytestcase(yyruleno==184);
+{yymsp[-1].minor.yy0.n += yymsp[0].minor.yy0.n; yymsp[-1].minor.yy0.type = TK_INTEGER; yylhsminor.yy66 = tSQLExprIdValueCreate(&yymsp[-1].minor.yy0, TK_INTEGER);}
+  yymsp[-1].minor.yy66 = yylhsminor.yy66;
         break;
-      case 182: /* expr ::= FLOAT */
-{yylhsminor.yy500 = tSQLExprIdValueCreate(&yymsp[0].minor.yy0, TK_FLOAT);}
-  yymsp[0].minor.yy500 = yylhsminor.yy500;
+      case 185: /* expr ::= FLOAT */
+{yylhsminor.yy66 = tSQLExprIdValueCreate(&yymsp[0].minor.yy0, TK_FLOAT);}
+  yymsp[0].minor.yy66 = yylhsminor.yy66;
         break;
-      case 183: /* expr ::= MINUS FLOAT */
-      case 184: /* expr ::= PLUS FLOAT */ yytestcase(yyruleno==184);
-{yymsp[-1].minor.yy0.n += yymsp[0].minor.yy0.n; yymsp[-1].minor.yy0.type = TK_FLOAT; yylhsminor.yy500 = tSQLExprIdValueCreate(&yymsp[-1].minor.yy0, TK_FLOAT);}
-  yymsp[-1].minor.yy500 = yylhsminor.yy500;
+      case 186: /* expr ::= MINUS FLOAT */
+      case 187: /* expr ::= PLUS FLOAT */ yytestcase(yyruleno==187);
+{yymsp[-1].minor.yy0.n += yymsp[0].minor.yy0.n; yymsp[-1].minor.yy0.type = TK_FLOAT; yylhsminor.yy66 = tSQLExprIdValueCreate(&yymsp[-1].minor.yy0, TK_FLOAT);}
+  yymsp[-1].minor.yy66 = yylhsminor.yy66;
         break;
-      case 185: /* expr ::= STRING */
-{yylhsminor.yy500 = tSQLExprIdValueCreate(&yymsp[0].minor.yy0, TK_STRING);}
-  yymsp[0].minor.yy500 = yylhsminor.yy500;
+      case 188: /* expr ::= STRING */
+{yylhsminor.yy66 = tSQLExprIdValueCreate(&yymsp[0].minor.yy0, TK_STRING);}
+  yymsp[0].minor.yy66 = yylhsminor.yy66;
         break;
-      case 186: /* expr ::= NOW */
-{yylhsminor.yy500 = tSQLExprIdValueCreate(&yymsp[0].minor.yy0, TK_NOW); }
-  yymsp[0].minor.yy500 = yylhsminor.yy500;
+      case 189: /* expr ::= NOW */
+{yylhsminor.yy66 = tSQLExprIdValueCreate(&yymsp[0].minor.yy0, TK_NOW); }
+  yymsp[0].minor.yy66 = yylhsminor.yy66;
         break;
-      case 187: /* expr ::= VARIABLE */
-{yylhsminor.yy500 = tSQLExprIdValueCreate(&yymsp[0].minor.yy0, TK_VARIABLE);}
-  yymsp[0].minor.yy500 = yylhsminor.yy500;
+      case 190: /* expr ::= VARIABLE */
+{yylhsminor.yy66 = tSQLExprIdValueCreate(&yymsp[0].minor.yy0, TK_VARIABLE);}
+  yymsp[0].minor.yy66 = yylhsminor.yy66;
         break;
-      case 188: /* expr ::= BOOL */
-{yylhsminor.yy500 = tSQLExprIdValueCreate(&yymsp[0].minor.yy0, TK_BOOL);}
-  yymsp[0].minor.yy500 = yylhsminor.yy500;
+      case 191: /* expr ::= BOOL */
+{yylhsminor.yy66 = tSQLExprIdValueCreate(&yymsp[0].minor.yy0, TK_BOOL);}
+  yymsp[0].minor.yy66 = yylhsminor.yy66;
         break;
-      case 189: /* expr ::= ID LP exprlist RP */
+      case 192: /* expr ::= ID LP exprlist RP */
 {
-  yylhsminor.yy500 = tSQLExprCreateFunction(yymsp[-1].minor.yy260, &yymsp[-3].minor.yy0, &yymsp[0].minor.yy0, yymsp[-3].minor.yy0.type);
+  yylhsminor.yy66 = tSQLExprCreateFunction(yymsp[-1].minor.yy224, &yymsp[-3].minor.yy0, &yymsp[0].minor.yy0, yymsp[-3].minor.yy0.type);
 }
-  yymsp[-3].minor.yy500 = yylhsminor.yy500;
+  yymsp[-3].minor.yy66 = yylhsminor.yy66;
         break;
-      case 190: /* expr ::= ID LP STAR RP */
+      case 193: /* expr ::= ID LP STAR RP */
 {
-  yylhsminor.yy500 = tSQLExprCreateFunction(NULL, &yymsp[-3].minor.yy0, &yymsp[0].minor.yy0, yymsp[-3].minor.yy0.type);
+  yylhsminor.yy66 = tSQLExprCreateFunction(NULL, &yymsp[-3].minor.yy0, &yymsp[0].minor.yy0, yymsp[-3].minor.yy0.type);
 }
-  yymsp[-3].minor.yy500 = yylhsminor.yy500;
+  yymsp[-3].minor.yy66 = yylhsminor.yy66;
         break;
-      case 191: /* expr ::= expr AND expr */
-{yylhsminor.yy500 = tSQLExprCreate(yymsp[-2].minor.yy500, yymsp[0].minor.yy500, TK_AND);}
-  yymsp[-2].minor.yy500 = yylhsminor.yy500;
+      case 194: /* expr ::= expr AND expr */
+{yylhsminor.yy66 = tSQLExprCreate(yymsp[-2].minor.yy66, yymsp[0].minor.yy66, TK_AND);}
+  yymsp[-2].minor.yy66 = yylhsminor.yy66;
         break;
-      case 192: /* expr ::= expr OR expr */
-{yylhsminor.yy500 = tSQLExprCreate(yymsp[-2].minor.yy500, yymsp[0].minor.yy500, TK_OR); }
-  yymsp[-2].minor.yy500 = yylhsminor.yy500;
+      case 195: /* expr ::= expr OR expr */
+{yylhsminor.yy66 = tSQLExprCreate(yymsp[-2].minor.yy66, yymsp[0].minor.yy66, TK_OR); }
+  yymsp[-2].minor.yy66 = yylhsminor.yy66;
         break;
-      case 193: /* expr ::= expr LT expr */
-{yylhsminor.yy500 = tSQLExprCreate(yymsp[-2].minor.yy500, yymsp[0].minor.yy500, TK_LT);}
-  yymsp[-2].minor.yy500 = yylhsminor.yy500;
+      case 196: /* expr ::= expr LT expr */
+{yylhsminor.yy66 = tSQLExprCreate(yymsp[-2].minor.yy66, yymsp[0].minor.yy66, TK_LT);}
+  yymsp[-2].minor.yy66 = yylhsminor.yy66;
         break;
-      case 194: /* expr ::= expr GT expr */
-{yylhsminor.yy500 = tSQLExprCreate(yymsp[-2].minor.yy500, yymsp[0].minor.yy500, TK_GT);}
-  yymsp[-2].minor.yy500 = yylhsminor.yy500;
+      case 197: /* expr ::= expr GT expr */
+{yylhsminor.yy66 = tSQLExprCreate(yymsp[-2].minor.yy66, yymsp[0].minor.yy66, TK_GT);}
+  yymsp[-2].minor.yy66 = yylhsminor.yy66;
         break;
-      case 195: /* expr ::= expr LE expr */
-{yylhsminor.yy500 = tSQLExprCreate(yymsp[-2].minor.yy500, yymsp[0].minor.yy500, TK_LE);}
-  yymsp[-2].minor.yy500 = yylhsminor.yy500;
+      case 198: /* expr ::= expr LE expr */
+{yylhsminor.yy66 = tSQLExprCreate(yymsp[-2].minor.yy66, yymsp[0].minor.yy66, TK_LE);}
+  yymsp[-2].minor.yy66 = yylhsminor.yy66;
         break;
-      case 196: /* expr ::= expr GE expr */
-{yylhsminor.yy500 = tSQLExprCreate(yymsp[-2].minor.yy500, yymsp[0].minor.yy500, TK_GE);}
-  yymsp[-2].minor.yy500 = yylhsminor.yy500;
+      case 199: /* expr ::= expr GE expr */
+{yylhsminor.yy66 = tSQLExprCreate(yymsp[-2].minor.yy66, yymsp[0].minor.yy66, TK_GE);}
+  yymsp[-2].minor.yy66 = yylhsminor.yy66;
         break;
-      case 197: /* expr ::= expr NE expr */
-{yylhsminor.yy500 = tSQLExprCreate(yymsp[-2].minor.yy500, yymsp[0].minor.yy500, TK_NE);}
-  yymsp[-2].minor.yy500 = yylhsminor.yy500;
+      case 200: /* expr ::= expr NE expr */
+{yylhsminor.yy66 = tSQLExprCreate(yymsp[-2].minor.yy66, yymsp[0].minor.yy66, TK_NE);}
+  yymsp[-2].minor.yy66 = yylhsminor.yy66;
         break;
-      case 198: /* expr ::= expr EQ expr */
-{yylhsminor.yy500 = tSQLExprCreate(yymsp[-2].minor.yy500, yymsp[0].minor.yy500, TK_EQ);}
-  yymsp[-2].minor.yy500 = yylhsminor.yy500;
+      case 201: /* expr ::= expr EQ expr */
+{yylhsminor.yy66 = tSQLExprCreate(yymsp[-2].minor.yy66, yymsp[0].minor.yy66, TK_EQ);}
+  yymsp[-2].minor.yy66 = yylhsminor.yy66;
         break;
-      case 199: /* expr ::= expr PLUS expr */
-{yylhsminor.yy500 = tSQLExprCreate(yymsp[-2].minor.yy500, yymsp[0].minor.yy500, TK_PLUS);  }
-  yymsp[-2].minor.yy500 = yylhsminor.yy500;
+      case 202: /* expr ::= expr PLUS expr */
+{yylhsminor.yy66 = tSQLExprCreate(yymsp[-2].minor.yy66, yymsp[0].minor.yy66, TK_PLUS);  }
+  yymsp[-2].minor.yy66 = yylhsminor.yy66;
         break;
-      case 200: /* expr ::= expr MINUS expr */
-{yylhsminor.yy500 = tSQLExprCreate(yymsp[-2].minor.yy500, yymsp[0].minor.yy500, TK_MINUS); }
-  yymsp[-2].minor.yy500 = yylhsminor.yy500;
+      case 203: /* expr ::= expr MINUS expr */
+{yylhsminor.yy66 = tSQLExprCreate(yymsp[-2].minor.yy66, yymsp[0].minor.yy66, TK_MINUS); }
+  yymsp[-2].minor.yy66 = yylhsminor.yy66;
         break;
-      case 201: /* expr ::= expr STAR expr */
-{yylhsminor.yy500 = tSQLExprCreate(yymsp[-2].minor.yy500, yymsp[0].minor.yy500, TK_STAR);  }
-  yymsp[-2].minor.yy500 = yylhsminor.yy500;
+      case 204: /* expr ::= expr STAR expr */
+{yylhsminor.yy66 = tSQLExprCreate(yymsp[-2].minor.yy66, yymsp[0].minor.yy66, TK_STAR);  }
+  yymsp[-2].minor.yy66 = yylhsminor.yy66;
         break;
-      case 202: /* expr ::= expr SLASH expr */
-{yylhsminor.yy500 = tSQLExprCreate(yymsp[-2].minor.yy500, yymsp[0].minor.yy500, TK_DIVIDE);}
-  yymsp[-2].minor.yy500 = yylhsminor.yy500;
+      case 205: /* expr ::= expr SLASH expr */
+{yylhsminor.yy66 = tSQLExprCreate(yymsp[-2].minor.yy66, yymsp[0].minor.yy66, TK_DIVIDE);}
+  yymsp[-2].minor.yy66 = yylhsminor.yy66;
         break;
-      case 203: /* expr ::= expr REM expr */
-{yylhsminor.yy500 = tSQLExprCreate(yymsp[-2].minor.yy500, yymsp[0].minor.yy500, TK_REM);   }
-  yymsp[-2].minor.yy500 = yylhsminor.yy500;
+      case 206: /* expr ::= expr REM expr */
+{yylhsminor.yy66 = tSQLExprCreate(yymsp[-2].minor.yy66, yymsp[0].minor.yy66, TK_REM);   }
+  yymsp[-2].minor.yy66 = yylhsminor.yy66;
         break;
-      case 204: /* expr ::= expr LIKE expr */
-{yylhsminor.yy500 = tSQLExprCreate(yymsp[-2].minor.yy500, yymsp[0].minor.yy500, TK_LIKE);  }
-  yymsp[-2].minor.yy500 = yylhsminor.yy500;
+      case 207: /* expr ::= expr LIKE expr */
+{yylhsminor.yy66 = tSQLExprCreate(yymsp[-2].minor.yy66, yymsp[0].minor.yy66, TK_LIKE);  }
+  yymsp[-2].minor.yy66 = yylhsminor.yy66;
         break;
-      case 205: /* expr ::= expr IN LP exprlist RP */
-{yylhsminor.yy500 = tSQLExprCreate(yymsp[-4].minor.yy500, (tSQLExpr*)yymsp[-1].minor.yy260, TK_IN); }
-  yymsp[-4].minor.yy500 = yylhsminor.yy500;
+      case 208: /* expr ::= expr IN LP exprlist RP */
+{yylhsminor.yy66 = tSQLExprCreate(yymsp[-4].minor.yy66, (tSQLExpr*)yymsp[-1].minor.yy224, TK_IN); }
+  yymsp[-4].minor.yy66 = yylhsminor.yy66;
         break;
-      case 206: /* exprlist ::= exprlist COMMA expritem */
-{yylhsminor.yy260 = tSQLExprListAppend(yymsp[-2].minor.yy260,yymsp[0].minor.yy500,0);}
-  yymsp[-2].minor.yy260 = yylhsminor.yy260;
+      case 209: /* exprlist ::= exprlist COMMA expritem */
+{yylhsminor.yy224 = tSQLExprListAppend(yymsp[-2].minor.yy224,yymsp[0].minor.yy66,0);}
+  yymsp[-2].minor.yy224 = yylhsminor.yy224;
         break;
-      case 207: /* exprlist ::= expritem */
-{yylhsminor.yy260 = tSQLExprListAppend(0,yymsp[0].minor.yy500,0);}
-  yymsp[0].minor.yy260 = yylhsminor.yy260;
+      case 210: /* exprlist ::= expritem */
+{yylhsminor.yy224 = tSQLExprListAppend(0,yymsp[0].minor.yy66,0);}
+  yymsp[0].minor.yy224 = yylhsminor.yy224;
         break;
-      case 208: /* expritem ::= expr */
-{yylhsminor.yy500 = yymsp[0].minor.yy500;}
-  yymsp[0].minor.yy500 = yylhsminor.yy500;
+      case 211: /* expritem ::= expr */
+{yylhsminor.yy66 = yymsp[0].minor.yy66;}
+  yymsp[0].minor.yy66 = yylhsminor.yy66;
         break;
-      case 210: /* cmd ::= RESET QUERY CACHE */
+      case 213: /* cmd ::= RESET QUERY CACHE */
 { setDCLSQLElems(pInfo, TSDB_SQL_RESET_CACHE, 0);}
         break;
-      case 211: /* cmd ::= ALTER TABLE ids cpxName ADD COLUMN columnlist */
+      case 214: /* cmd ::= ALTER TABLE ids cpxName ADD COLUMN columnlist */
 {
     yymsp[-4].minor.yy0.n += yymsp[-3].minor.yy0.n;
-    SAlterTableSQL* pAlterTable = tAlterTableSQLElems(&yymsp[-4].minor.yy0, yymsp[0].minor.yy369, NULL, TSDB_ALTER_TABLE_ADD_COLUMN);
+    SAlterTableSQL* pAlterTable = tAlterTableSQLElems(&yymsp[-4].minor.yy0, yymsp[0].minor.yy449, NULL, TSDB_ALTER_TABLE_ADD_COLUMN);
     setSQLInfo(pInfo, pAlterTable, NULL, TSDB_SQL_ALTER_TABLE);
 }
         break;
-      case 212: /* cmd ::= ALTER TABLE ids cpxName DROP COLUMN ids */
+      case 215: /* cmd ::= ALTER TABLE ids cpxName DROP COLUMN ids */
 {
     yymsp[-4].minor.yy0.n += yymsp[-3].minor.yy0.n;
 
@@ -2690,14 +2713,14 @@ static void yy_reduce(
     setSQLInfo(pInfo, pAlterTable, NULL, TSDB_SQL_ALTER_TABLE);
 }
         break;
-      case 213: /* cmd ::= ALTER TABLE ids cpxName ADD TAG columnlist */
+      case 216: /* cmd ::= ALTER TABLE ids cpxName ADD TAG columnlist */
 {
     yymsp[-4].minor.yy0.n += yymsp[-3].minor.yy0.n;
-    SAlterTableSQL* pAlterTable = tAlterTableSQLElems(&yymsp[-4].minor.yy0, yymsp[0].minor.yy369, NULL, TSDB_ALTER_TABLE_ADD_TAG_COLUMN);
+    SAlterTableSQL* pAlterTable = tAlterTableSQLElems(&yymsp[-4].minor.yy0, yymsp[0].minor.yy449, NULL, TSDB_ALTER_TABLE_ADD_TAG_COLUMN);
     setSQLInfo(pInfo, pAlterTable, NULL, TSDB_SQL_ALTER_TABLE);
 }
         break;
-      case 214: /* cmd ::= ALTER TABLE ids cpxName DROP TAG ids */
+      case 217: /* cmd ::= ALTER TABLE ids cpxName DROP TAG ids */
 {
     yymsp[-4].minor.yy0.n += yymsp[-3].minor.yy0.n;
 
@@ -2708,7 +2731,7 @@ static void yy_reduce(
     setSQLInfo(pInfo, pAlterTable, NULL, TSDB_SQL_ALTER_TABLE);
 }
         break;
-      case 215: /* cmd ::= ALTER TABLE ids cpxName CHANGE TAG ids ids */
+      case 218: /* cmd ::= ALTER TABLE ids cpxName CHANGE TAG ids ids */
 {
     yymsp[-5].minor.yy0.n += yymsp[-4].minor.yy0.n;
 
@@ -2722,25 +2745,25 @@ static void yy_reduce(
     setSQLInfo(pInfo, pAlterTable, NULL, TSDB_SQL_ALTER_TABLE);
 }
         break;
-      case 216: /* cmd ::= ALTER TABLE ids cpxName SET TAG ids EQ tagitem */
+      case 219: /* cmd ::= ALTER TABLE ids cpxName SET TAG ids EQ tagitem */
 {
     yymsp[-6].minor.yy0.n += yymsp[-5].minor.yy0.n;
 
     toTSDBType(yymsp[-2].minor.yy0.type);
     tVariantList* A = tVariantListAppendToken(NULL, &yymsp[-2].minor.yy0, -1);
-    A = tVariantListAppend(A, &yymsp[0].minor.yy518, -1);
+    A = tVariantListAppend(A, &yymsp[0].minor.yy312, -1);
 
     SAlterTableSQL* pAlterTable = tAlterTableSQLElems(&yymsp[-6].minor.yy0, NULL, A, TSDB_ALTER_TABLE_UPDATE_TAG_VAL);
     setSQLInfo(pInfo, pAlterTable, NULL, TSDB_SQL_ALTER_TABLE);
 }
         break;
-      case 217: /* cmd ::= KILL CONNECTION IPTOKEN COLON INTEGER */
+      case 220: /* cmd ::= KILL CONNECTION IPTOKEN COLON INTEGER */
 {yymsp[-2].minor.yy0.n += (yymsp[-1].minor.yy0.n + yymsp[0].minor.yy0.n); setKillSQL(pInfo, TSDB_SQL_KILL_CONNECTION, &yymsp[-2].minor.yy0);}
         break;
-      case 218: /* cmd ::= KILL STREAM IPTOKEN COLON INTEGER COLON INTEGER */
+      case 221: /* cmd ::= KILL STREAM IPTOKEN COLON INTEGER COLON INTEGER */
 {yymsp[-4].minor.yy0.n += (yymsp[-3].minor.yy0.n + yymsp[-2].minor.yy0.n + yymsp[-1].minor.yy0.n + yymsp[0].minor.yy0.n); setKillSQL(pInfo, TSDB_SQL_KILL_STREAM, &yymsp[-4].minor.yy0);}
         break;
-      case 219: /* cmd ::= KILL QUERY IPTOKEN COLON INTEGER COLON INTEGER */
+      case 222: /* cmd ::= KILL QUERY IPTOKEN COLON INTEGER COLON INTEGER */
 {yymsp[-4].minor.yy0.n += (yymsp[-3].minor.yy0.n + yymsp[-2].minor.yy0.n + yymsp[-1].minor.yy0.n + yymsp[0].minor.yy0.n); setKillSQL(pInfo, TSDB_SQL_KILL_QUERY, &yymsp[-4].minor.yy0);}
         break;
       default:
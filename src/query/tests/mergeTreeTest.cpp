@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "taos.h"
+#include "taosdef.h"
+#include "tlosertree.h"
+#include "tmergetree.h"
+#include "ttime.h"
+
+namespace {
+typedef std::vector<std::vector<int64_t> > SSources;
+
+// each source is in the ascending order, or descending if order is TSDB_ORDER_DESC, and some of them are empty
+SSources generateSources(int32_t numOfSources, int32_t maxRows, int32_t range, int32_t order) {
+  SSources sources(numOfSources);
+
+  srand(numOfSources);
+  for (int32_t i = 0; i < numOfSources; ++i) {
+    int32_t num = (i % 7 == 3) ? 0 : rand() % maxRows + 1;
+    for (int32_t j = 0; j < num; ++j) {
+      sources[i].push_back((int64_t)(rand() % range) - range / 2);
+    }
+
+    std::sort(sources[i].begin(), sources[i].end());
+    if (order == TSDB_ORDER_DESC) {
+      std::reverse(sources[i].begin(), sources[i].end());
+    }
+  }
+
+  return sources;
+}
+
+struct SMergedRow {
+  int64_t v;
+  int32_t source;
+  int32_t pos;
+};
+
+// the rows of the same value are in the order of source, and the rows of one source keep their order
+std::vector<SMergedRow> sortAll(const SSources& sources, int32_t order) {
+  std::vector<SMergedRow> rows;
+  for (int32_t i = 0; i < (int32_t)sources.size(); ++i) {
+    for (int32_t j = 0; j < (int32_t)sources[i].size(); ++j) {
+      rows.push_back({sources[i][j], i, j});
+    }
+  }
+
+  std::sort(rows.begin(), rows.end(), [order](const SMergedRow& a, const SMergedRow& b) {
+    if (a.v != b.v) {
+      return (order == TSDB_ORDER_ASC) ? a.v < b.v : a.v > b.v;
+    }
+
+    return (a.source != b.source) ? a.source < b.source : a.pos < b.pos;
+  });
+
+  return rows;
+}
+
+// take the whole run of the winner before the other sources at once, as the block ordering of tsdb
+std::vector<SMergedRow> merge(const SSources& sources, int32_t order) {
+  int32_t     num = (int32_t)sources.size();
+  SMergeTree* pTree = tMergeTreeCreate(num);
+
+  std::vector<int32_t> pos(num, 0);
+  for (int32_t i = 0; i < num; ++i) {
+    if (!sources[i].empty()) {
+      tMergeTreeSetKey(pTree, i, MERGE_TREE_KEY(sources[i][0], order));
+    }
+  }
+
+  tMergeTreeBuild(pTree);
+
+  std::vector<SMergedRow> rows;
+  while (pTree->winner >= 0) {
+    int32_t                     w = pTree->winner;
+    const std::vector<int64_t>& src = sources[w];
+
+    do {
+      rows.push_back({src[pos[w]], w, pos[w]});
+      pos[w] += 1;
+    } while (pos[w] < (int32_t)src.size() && tMergeTreeBeforeBound(pTree, MERGE_TREE_KEY(src[pos[w]], order)));
+
+    if (pos[w] >= (int32_t)src.size()) {
+      tMergeTreeExhaust(pTree);
+    } else {
+      tMergeTreeAdvance(pTree, MERGE_TREE_KEY(src[pos[w]], order));
+    }
+  }
+
+  free(pTree);
+  return rows;
+}
+
+void mergeTest(int32_t numOfSources, int32_t maxRows, int32_t range, int32_t order) {
+  SSources sources = generateSources(numOfSources, maxRows, range, order);
+
+  std::vector<SMergedRow> expected = sortAll(sources, order);
+  std::vector<SMergedRow> rows = merge(sources, order);
+
+  ASSERT_EQ(rows.size(), expected.size());
+  for (size_t i = 0; i < rows.size(); ++i) {
+    ASSERT_EQ(rows[i].v, expected[i].v);
+    ASSERT_EQ(rows[i].source, expected[i].source);
+    ASSERT_EQ(rows[i].pos, expected[i].pos);
+  }
+}
+
+struct SLoserTreeParam {
+  const SSources*       sources;
+  std::vector<int32_t>* pos;
+};
+
+int32_t loserTreeCompar(const void* pLeft, const void* pRight, void* param) {
+  int32_t left = *(int32_t*)pLeft;
+  int32_t right = *(int32_t*)pRight;
+
+  SLoserTreeParam* p = (SLoserTreeParam*)param;
+  if ((*p->pos)[left] == -1) {
+    return 1;
+  } else if ((*p->pos)[right] == -1) {
+    return -1;
+  }
+
+  int64_t l = (*p->sources)[left][(*p->pos)[left]];
+  int64_t r = (*p->sources)[right][(*p->pos)[right]];
+  if (l == r) {
+    return 0;
+  }
+
+  return l < r ? -1 : 1;
+}
+
+int64_t benchmark(const SSources& sources, int64_t total, bool loserTree) {
+  int32_t num = (int32_t)sources.size();
+  int64_t sum = 0;
+
+  std::vector<int32_t> pos(num, 0);
+  int64_t              st = taosGetTimestampUs();
+
+  if (loserTree) {
+    SLoserTreeParam param = {&sources, &pos};
+    SLoserTreeInfo* pTree = NULL;
+    tLoserTreeCreate(&pTree, num, &param, loserTreeCompar);
+
+    for (int64_t i = 0; i < total; ++i) {
+      int32_t w = pTree->pNode[0].index;
+      sum += sources[w][pos[w]];
+
+      if (++pos[w] >= (int32_t)sources[w].size()) {
+        pos[w] = -1;
+      }
+
+      tLoserTreeAdjust(pTree, w + num);
+    }
+
+    free(pTree);
+  } else {
+    SMergeTree* pTree = tMergeTreeCreate(num);
+    for (int32_t i = 0; i < num; ++i) {
+      tMergeTreeSetKey(pTree, i, MERGE_TREE_KEY(sources[i][0], TSDB_ORDER_ASC));
+    }
+
+    tMergeTreeBuild(pTree);
+
+    for (int64_t i = 0; i < total; ++i) {
+      int32_t w = pTree->winner;
+      sum += sources[w][pos[w]];
+
+      if (++pos[w] >= (int32_t)sources[w].size()) {
+        tMergeTreeExhaust(pTree);
+      } else {
+        tMergeTreeAdvance(pTree, MERGE_TREE_KEY(sources[w][pos[w]], TSDB_ORDER_ASC));
+      }
+    }
+
+    free(pTree);
+  }
+
+  int64_t et = taosGetTimestampUs();
+  assert(sum != 0);
+
+  return et - st;
+}
+}  // namespace
+
+TEST(testCase, merge_tree_test) {
+  // one source, and a number of sources that is not a power of 2
+  mergeTest(1, 100, 1000, TSDB_ORDER_ASC);
+  mergeTest(2, 100, 1000, TSDB_ORDER_ASC);
+  mergeTest(13, 500, 1000000, TSDB_ORDER_ASC);
+  mergeTest(13, 500, 1000000, TSDB_ORDER_DESC);
+
+  // many duplicated values in different sources
+  mergeTest(100, 200, 50, TSDB_ORDER_ASC);
+  mergeTest(100, 200, 50, TSDB_ORDER_DESC);
+
+  // the sorted runs of sources, e.g., the blocks of tables in a file
+  mergeTest(513, 1000, 2000000000, TSDB_ORDER_ASC);
+}
+
+TEST(testCase, merge_tree_exhausted_test) {
+  // all sources are empty
+  SMergeTree* pTree = tMergeTreeCreate(5);
+  tMergeTreeBuild(pTree);
+  ASSERT_EQ(pTree->winner, -1);
+  free(pTree);
+
+  // the negative values are before the positive ones
+  pTree = tMergeTreeCreate(3);
+  tMergeTreeSetKey(pTree, 2, MERGE_TREE_KEY(-1, TSDB_ORDER_ASC));
+  tMergeTreeSetKey(pTree, 1, MERGE_TREE_KEY(INT64_MIN, TSDB_ORDER_ASC));
+  tMergeTreeBuild(pTree);
+
+  ASSERT_EQ(pTree->winner, 1);
+  ASSERT_TRUE(tMergeTreeBeforeBound(pTree, MERGE_TREE_KEY(-2, TSDB_ORDER_ASC)));
+  ASSERT_EQ(pTree->runnerUp, 2);
+  ASSERT_FALSE(tMergeTreeBeforeBound(pTree, MERGE_TREE_KEY(0, TSDB_ORDER_ASC)));
+
+  tMergeTreeAdvance(pTree, MERGE_TREE_KEY(INT64_MAX, TSDB_ORDER_ASC));
+  ASSERT_EQ(pTree->winner, 2);
+
+  tMergeTreeExhaust(pTree);
+  ASSERT_EQ(pTree->winner, 1);
+  ASSERT_TRUE(tMergeTreeBeforeBound(pTree, MERGE_TREE_KEY(INT64_MAX, TSDB_ORDER_ASC)));
+
+  tMergeTreeExhaust(pTree);
+  ASSERT_EQ(pTree->winner, -1);
+  free(pTree);
+}
+
+// a timing comparison, not run by default
+// run it by: queryTest --gtest_also_run_disabled_tests --gtest_filter=*merge_tree_benchmark
+TEST(testCase, DISABLED_merge_tree_benchmark) {
+  int32_t numOfSources[] = {16, 256, 1024};
+
+  for (size_t i = 0; i < sizeof(numOfSources) / sizeof(numOfSources[0]); ++i) {
+    SSources sources = generateSources(numOfSources[i], 4000, 2000000000, TSDB_ORDER_ASC);
+
+    int64_t total = 0;
+    for (size_t j = 0; j < sources.size(); ++j) {
+      if (sources[j].empty()) {  // the benchmark needs no empty source
+        sources[j].push_back(0);
+      }
+
+      total += sources[j].size();
+    }
+
+    int64_t l = benchmark(sources, total, true);
+    int64_t m = benchmark(sources, total, false);
+    printf("sources:%-6d rows:%-10" PRId64 " loser tree:%-8" PRId64 " us, merge tree:%-8" PRId64 " us\n",
+           numOfSources[i], total, l, m);
+  }
+}
@@ -0,0 +1,301 @@
+#include <gtest/gtest.h>
+#include <cassert>
+#include <iostream>
+
+#include "taos.h"
+#include "tsdb.h"
+
+extern "C" {
+#include "qExecutor.h"
+#include "qcache.h"
+#include "tglobal.h"
+}
+
+namespace {
+const int64_t INTERVAL = 10;
+const int32_t CAPACITY = 4096;
+const int32_t NUM_OF_OUTPUT = 2;
+
+// an interval query of one table, the output columns are the start key of each window and a value of bigint
+struct SCacheTestQuery {
+  SQInfo     qinfo;
+  SQuery     query;
+  SExprInfo  exprs[NUM_OF_OUTPUT];
+  tFilePage* sdata[NUM_OF_OUTPUT];
+};
+
+SCacheTestQuery* createQuery(TSKEY skey, TSKEY ekey, int32_t capacity = CAPACITY) {
+  SCacheTestQuery* p = (SCacheTestQuery*)calloc(1, sizeof(SCacheTestQuery));
+
+  SQuery* pQuery = &p->query;
+  pQuery->window.skey = skey;
+  pQuery->window.ekey = ekey;
+  pQuery->intervalTime = INTERVAL;
+  pQuery->slidingTime = INTERVAL;
+  pQuery->slidingTimeUnit = 'a';
+  pQuery->precision = TSDB_TIME_PRECISION_MILLI;
+  pQuery->numOfOutput = NUM_OF_OUTPUT;
+  pQuery->pSelectExpr = p->exprs;
+  pQuery->sdata = p->sdata;
+  pQuery->rec.capacity = capacity;
+
+  for (int32_t i = 0; i < NUM_OF_OUTPUT; ++i) {
+    p->exprs[i].bytes = sizeof(int64_t);
+    p->exprs[i].type = (i == 0) ? TSDB_DATA_TYPE_TIMESTAMP : TSDB_DATA_TYPE_BIGINT;
+    p->sdata[i] = (tFilePage*)calloc(1, sizeof(tFilePage) + sizeof(int64_t) * capacity);
+    pQuery->rowSize += sizeof(int64_t);
+  }
+
+  p->qinfo.runtimeEnv.pQuery = pQuery;
+  return p;
+}
+
+void destroyQuery(SCacheTestQuery* p) {
+  qCacheRelease(&p->qinfo);
+  for (int32_t i = 0; i < NUM_OF_OUTPUT; ++i) {
+    free(p->sdata[i]);
+  }
+  free(p);
+}
+
+// the snapshot of the queried table, it is taken from tsdb in qCacheLookup
+void setTable(SCacheTestQuery* p, uint64_t uid, int64_t version, TSKEY lastKey) {
+  SQueryCacheInfo* pCache = &p->qinfo.cacheInfo;
+  pCache->numOfTables = 1;
+  pCache->pTables = (SQueryCacheTable*)calloc(1, sizeof(SQueryCacheTable));
+  pCache->pTables[0].uid = uid;
+  pCache->pTables[0].version = version;
+  pCache->pTables[0].lastKey = lastKey;
+}
+
+// one row for each window in [skey, ekey], the value is the start key plus base
+void setResult(SCacheTestQuery* p, TSKEY skey, TSKEY ekey, int64_t base) {
+  SQuery* pQuery = &p->query;
+  int64_t* keys = (int64_t*)pQuery->sdata[0]->data;
+  int64_t* vals = (int64_t*)pQuery->sdata[1]->data;
+
+  int32_t rows = 0;
+  for (TSKEY k = skey; k <= ekey; k += INTERVAL, ++rows) {
+    keys[rows] = k;
+    vals[rows] = k + base;
+  }
+
+  pQuery->rec.rows = rows;
+}
+
+void putResult(const char* key, TSKEY skey, TSKEY ekey, int64_t version, TSKEY lastKey, int64_t base) {
+  TSKEY   start = skey - skey % INTERVAL;
+  int32_t rows = (int32_t)((ekey - start) / INTERVAL + 1);
+
+  SCacheTestQuery* p = createQuery(skey, ekey, (rows > CAPACITY) ? rows : CAPACITY);
+  setTable(p, 1, version, lastKey);
+  qCacheFind(&p->qinfo, key, false);
+  ASSERT_TRUE(p->qinfo.cacheInfo.pEntry == NULL);
+
+  setResult(p, start, ekey, base);
+
+  // the first window only covers part of the window, its result differs from the one of the whole window
+  if (start < skey) {
+    ((int64_t*)p->query.sdata[1]->data)[0] = -1;
+  }
+
+  qCachePut(&p->qinfo);
+  destroyQuery(p);
+}
+
+void checkRows(SCacheTestQuery* p, TSKEY skey, TSKEY ekey, int64_t base) {
+  SQuery* pQuery = &p->query;
+  int64_t* keys = (int64_t*)pQuery->sdata[0]->data;
+  int64_t* vals = (int64_t*)pQuery->sdata[1]->data;
+
+  int32_t rows = 0;
+  for (TSKEY k = skey; k <= ekey; k += INTERVAL, ++rows) {
+    ASSERT_EQ(keys[rows], k);
+    ASSERT_EQ(vals[rows], k + base);
+  }
+
+  ASSERT_EQ(pQuery->rec.rows, rows);
+}
+}  // namespace
+
+class QueryCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    keepTimer = tsQueryCacheKeepTimer;
+    cacheSize = tsQueryCacheSize;
+    tsQueryCacheKeepTimer = 3600;
+    tsQueryCacheSize = 64;
+  }
+
+  void TearDown() override {
+    tsQueryCacheKeepTimer = keepTimer;
+    tsQueryCacheSize = cacheSize;
+  }
+
+  int32_t keepTimer;
+  int32_t cacheSize;
+};
+
+TEST_F(QueryCacheTest, exactHit) {
+  putResult("qcache-test-hit", 0, 99, 1, 99, 1000);
+
+  SCacheTestQuery* p = createQuery(0, 99);
+  setTable(p, 1, 1, 99);
+  qCacheFind(&p->qinfo, "qcache-test-hit", true);
+  ASSERT_TRUE(p->qinfo.cacheInfo.pEntry != NULL);
+  ASSERT_TRUE(p->qinfo.cacheInfo.exact);
+
+  qCacheCopyResult(&p->qinfo);
+  checkRows(p, 0, 90, 1000);
+  destroyQuery(p);
+
+  // rows appended after the time range of the query do not change the result
+  p = createQuery(0, 99);
+  setTable(p, 1, 1, 150);
+  qCacheFind(&p->qinfo, "qcache-test-hit", true);
+  ASSERT_TRUE(p->qinfo.cacheInfo.exact);
+  destroyQuery(p);
+
+  // a different time range is not an exact hit
+  p = createQuery(0, 89);
+  setTable(p, 1, 1, 99);
+  qCacheFind(&p->qinfo, "qcache-test-hit", false);
+  ASSERT_TRUE(p->qinfo.cacheInfo.pEntry == NULL);
+  destroyQuery(p);
+}
+
+TEST_F(QueryCacheTest, invalidation) {
+  putResult("qcache-test-invalid", 0, 99, 1, 99, 1000);
+
+  // rows no later than the last key are inserted, or the tags are updated
+  SCacheTestQuery* p = createQuery(0, 99);
+  setTable(p, 1, 2, 99);
+  qCacheFind(&p->qinfo, "qcache-test-invalid", true);
+  ASSERT_TRUE(p->qinfo.cacheInfo.pEntry == NULL);
+  ASSERT_FALSE(p->qinfo.cacheInfo.exact);
+  destroyQuery(p);
+
+  // the table is dropped and created again
+  p = createQuery(0, 99);
+  setTable(p, 2, 1, 99);
+  qCacheFind(&p->qinfo, "qcache-test-invalid", true);
+  ASSERT_TRUE(p->qinfo.cacheInfo.pEntry == NULL);
+  destroyQuery(p);
+
+  // rows are appended within the time range of the query, the last key was 50 when the result is cached
+  putResult("qcache-test-invalid-tail", 0, 99, 1, 50, 1000);
+  p = createQuery(0, 99);
+  setTable(p, 1, 1, 120);
+  qCacheFind(&p->qinfo, "qcache-test-invalid-tail", false);
+  ASSERT_TRUE(p->qinfo.cacheInfo.pEntry == NULL);
+  destroyQuery(p);
+
+  // the result does not fit in the output buffer
+  p = createQuery(0, 99, 5);
+  setTable(p, 1, 1, 99);
+  qCacheFind(&p->qinfo, "qcache-test-invalid", false);
+  ASSERT_TRUE(p->qinfo.cacheInfo.pEntry == NULL);
+  destroyQuery(p);
+}
+
+TEST_F(QueryCacheTest, prefixSplice) {
+  // the first window of the cached result only covers part of the window, rows are appended after 99 since then
+  putResult("qcache-test-prefix", 5, 99, 1, 99, 1000);
+
+  SCacheTestQuery* p = createQuery(0, 149);
+  setTable(p, 1, 1, 149);
+  qCacheFind(&p->qinfo, "qcache-test-prefix", true);
+  ASSERT_TRUE(p->qinfo.cacheInfo.pEntry != NULL);
+  ASSERT_FALSE(p->qinfo.cacheInfo.exact);
+  ASSERT_EQ(p->qinfo.cacheInfo.reuse.skey, 10);
+  ASSERT_EQ(p->qinfo.cacheInfo.reuse.ekey, 99);
+
+  // the windows computed in the reused range are incomplete, since the blocks are skipped
+  setResult(p, 0, 140, 1000);
+  int64_t* vals = (int64_t*)p->query.sdata[1]->data;
+  for (int32_t i = 1; i < 10; ++i) {
+    vals[i] = -1;
+  }
+
+  qCacheMergeResult(&p->qinfo);
+  checkRows(p, 0, 140, 1000);
+  destroyQuery(p);
+
+  // windows are missing in the computed result of the reused range
+  p = createQuery(0, 149);
+  setTable(p, 1, 1, 149);
+  qCacheFind(&p->qinfo, "qcache-test-prefix", true);
+  ASSERT_TRUE(p->qinfo.cacheInfo.pEntry != NULL);
+
+  int64_t* keys = (int64_t*)p->query.sdata[0]->data;
+  vals = (int64_t*)p->query.sdata[1]->data;
+  keys[0] = 0;
+  vals[0] = 1000;
+  int32_t rows = 1;
+  for (TSKEY k = 100; k <= 140; k += INTERVAL, ++rows) {
+    keys[rows] = k;
+    vals[rows] = k + 1000;
+  }
+  p->query.rec.rows = rows;
+
+  qCacheMergeResult(&p->qinfo);
+  checkRows(p, 0, 140, 1000);
+  destroyQuery(p);
+
+  // the windows are not reused without the permission of the query
+  p = createQuery(0, 149);
+  setTable(p, 1, 1, 149);
+  qCacheFind(&p->qinfo, "qcache-test-prefix", false);
+  ASSERT_TRUE(p->qinfo.cacheInfo.pEntry == NULL);
+  destroyQuery(p);
+
+  // the rows in the reused range are changed
+  p = createQuery(0, 149);
+  setTable(p, 1, 2, 149);
+  qCacheFind(&p->qinfo, "qcache-test-prefix", true);
+  ASSERT_TRUE(p->qinfo.cacheInfo.pEntry == NULL);
+  destroyQuery(p);
+}
+
+TEST_F(QueryCacheTest, eviction) {
+  tsQueryCacheSize = 1;
+
+  // each result takes 16 bytes for one window, about 640KB for 40000 windows
+  const TSKEY ekey = 40000 * INTERVAL - 1;
+  SCacheTestQuery* p = NULL;
+
+  for (int32_t i = 0; i < 2; ++i) {
+    const char* key = (i == 0) ? "qcache-test-evict-0" : "qcache-test-evict-1";
+    p = createQuery(0, ekey, 40000);
+    setTable(p, 1, 1, ekey);
+    qCacheFind(&p->qinfo, key, false);
+    setResult(p, 0, ekey, i);
+    qCachePut(&p->qinfo);
+    destroyQuery(p);
+  }
+
+  // the result kept earliest is evicted
+  p = createQuery(0, ekey, 40000);
+  setTable(p, 1, 1, ekey);
+  qCacheFind(&p->qinfo, "qcache-test-evict-0", false);
+  ASSERT_TRUE(p->qinfo.cacheInfo.pEntry == NULL);
+  destroyQuery(p);
+
+  p = createQuery(0, ekey, 40000);
+  setTable(p, 1, 1, ekey);
+  qCacheFind(&p->qinfo, "qcache-test-evict-1", false);
+  ASSERT_TRUE(p->qinfo.cacheInfo.exact);
+  qCacheCopyResult(&p->qinfo);
+  checkRows(p, 0, ekey, 1);
+  destroyQuery(p);
+
+  // a result larger than the cache is not kept
+  const TSKEY largeEKey = 80000 * INTERVAL - 1;
+  putResult("qcache-test-evict-large", 0, largeEKey, 1, largeEKey, 0);
+
+  p = createQuery(0, largeEKey, 80000);
+  setTable(p, 1, 1, largeEKey);
+  qCacheFind(&p->qinfo, "qcache-test-evict-large", false);
+  ASSERT_TRUE(p->qinfo.cacheInfo.pEntry == NULL);
+  destroyQuery(p);
+}
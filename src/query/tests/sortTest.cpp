@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "qextbuffer.h"
+#include "taos.h"
+#include "tsdb.h"
+#include "ttime.h"
+
+namespace {
+// the rows of the model: ts, v, d, g, name. v is the original row id of each row, and d is v * 0.5
+const int32_t TS_COL = 0;
+const int32_t V_COL = 1;
+const int32_t D_COL = 2;
+const int32_t G_COL = 3;
+const int32_t NAME_COL = 4;
+
+SColumnModel* createModel(int32_t capacity, int32_t gType) {
+  SSchema fields[5] = {
+      {TSDB_DATA_TYPE_TIMESTAMP, "ts", 0, sizeof(int64_t)},
+      {TSDB_DATA_TYPE_INT, "v", 1, sizeof(int32_t)},
+      {TSDB_DATA_TYPE_DOUBLE, "d", 2, sizeof(double)},
+      {(uint8_t)gType, "g", 3, (int16_t)tDataTypeDesc[gType].nSize},
+      {TSDB_DATA_TYPE_BINARY, "name", 4, 18},
+  };
+
+  return createColumnModel(fields, 5, capacity);
+}
+
+char* getVal(SColumnModel* pModel, char* data, int32_t numOfRows, int32_t row, int32_t col) {
+  return data + pModel->pFields[col].offset * numOfRows + row * pModel->pFields[col].field.bytes;
+}
+
+int64_t getIntVal(SColumnModel* pModel, char* data, int32_t numOfRows, int32_t row, int32_t col) {
+  char* p = getVal(pModel, data, numOfRows, row, col);
+  switch (pModel->pFields[col].field.type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      return *(int8_t*)p;
+    case TSDB_DATA_TYPE_SMALLINT:
+      return *(int16_t*)p;
+    case TSDB_DATA_TYPE_INT:
+      return *(int32_t*)p;
+    default:
+      return *(int64_t*)p;
+  }
+}
+
+// the timestamps are in numOfRuns ascending runs, as the results of different vnodes, or random if numOfRuns is 0
+std::vector<char> generateData(SColumnModel* pModel, int32_t numOfRows, int32_t numOfRuns, int32_t numOfGroups) {
+  std::vector<char> data((size_t)pModel->rowSize * numOfRows);
+  char*             p = &data[0];
+
+  srand(1);
+  int32_t gType = pModel->pFields[G_COL].field.type;
+
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    int64_t ts = 1500000000000L + ((numOfRuns > 0) ? (i % (numOfRows / numOfRuns)) * 1000L : rand() % numOfRows * 1000L);
+    *(int64_t*)getVal(pModel, p, numOfRows, i, TS_COL) = ts;
+    *(int32_t*)getVal(pModel, p, numOfRows, i, V_COL) = i;
+    *(double*)getVal(pModel, p, numOfRows, i, D_COL) = i * 0.5;
+
+    int64_t g = rand() % numOfGroups - numOfGroups / 2;
+    char*   pg = getVal(pModel, p, numOfRows, i, G_COL);
+    switch (gType) {
+      case TSDB_DATA_TYPE_TINYINT:
+        *(int8_t*)pg = (int8_t)g;
+        break;
+      case TSDB_DATA_TYPE_SMALLINT:
+        *(int16_t*)pg = (int16_t)g;
+        break;
+      case TSDB_DATA_TYPE_INT:
+        *(int32_t*)pg = (int32_t)g;
+        break;
+      case TSDB_DATA_TYPE_BIGINT:
+        *(int64_t*)pg = g * 1000000000L;
+        break;
+    }
+
+    // some nulls in the group column
+    if (i % 97 == 0) {
+      setNull(pg, gType, tDataTypeDesc[gType].nSize);
+    }
+
+    char* name = getVal(pModel, p, numOfRows, i, NAME_COL);
+    varDataSetLen(name, sprintf((char*)varDataVal(name), "t%d", (int32_t)(g & 0xff)));
+  }
+
+  return data;
+}
+
+// the rows are sorted and intact, and the rows of the same order keep the original order if stable is required
+void checkSorted(tOrderDescriptor* pDesc, std::vector<char>& data, int32_t numOfRows, int32_t start, int32_t end,
+                 int32_t order, bool stable) {
+  SColumnModel*     pModel = pDesc->pColumnModel;
+  char*             p = &data[0];
+  std::vector<bool> found(numOfRows, false);
+
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    int32_t v = (int32_t)getIntVal(pModel, p, numOfRows, i, V_COL);
+    ASSERT_TRUE(v >= 0 && v < numOfRows && !found[v]);
+    ASSERT_EQ(*(double*)getVal(pModel, p, numOfRows, i, D_COL), v * 0.5);
+    found[v] = true;
+
+    // the rows out of the range are not touched
+    if (i < start || i > end) {
+      ASSERT_EQ(v, i);
+    }
+  }
+
+  for (int32_t i = start; i < end; ++i) {
+    int32_t ret = (order == TSDB_ORDER_ASC) ? compare_sa(pDesc, numOfRows, i, i + 1, p)
+                                            : compare_sd(pDesc, numOfRows, i, i + 1, p);
+    ASSERT_LE(ret, 0);
+
+    if (stable && ret == 0) {
+      ASSERT_LT(getIntVal(pModel, p, numOfRows, i, V_COL), getIntVal(pModel, p, numOfRows, i + 1, V_COL));
+    }
+  }
+}
+
+void sortTest(int32_t gType, std::vector<int32_t> orderCols, int32_t tsOrder, int32_t order, int32_t numOfRows,
+              int32_t numOfRuns) {
+  SColumnModel*     pModel = createModel(numOfRows, gType);
+  tOrderDescriptor* pDesc = tOrderDesCreate(&orderCols[0], (int32_t)orderCols.size(), pModel, tsOrder);
+
+  std::vector<char> data = generateData(pModel, numOfRows, numOfRuns, 50);
+  tColDataSort(pDesc, numOfRows, 0, numOfRows - 1, &data[0], order);
+
+  // only the radix sort is stable, which needs no less than 64 rows
+  bool stable = (numOfRows / 4 >= 64);
+  for (size_t i = 0; i < orderCols.size(); ++i) {
+    stable = stable && (pModel->pFields[orderCols[i]].field.type != TSDB_DATA_TYPE_BINARY);
+  }
+
+  checkSorted(pDesc, data, numOfRows, 0, numOfRows - 1, order, stable);
+
+  // sort part of the rows
+  data = generateData(pModel, numOfRows, numOfRuns, 50);
+  tColDataSort(pDesc, numOfRows, numOfRows / 4, numOfRows / 2, &data[0], order);
+  checkSorted(pDesc, data, numOfRows, numOfRows / 4, numOfRows / 2, order, stable);
+
+  tOrderDescDestroy(pDesc);
+}
+
+int64_t benchmark(int32_t gType, std::vector<int32_t> orderCols, int32_t numOfRows, int32_t numOfRuns, bool radix) {
+  SColumnModel*     pModel = createModel(numOfRows, gType);
+  tOrderDescriptor* pDesc = tOrderDesCreate(&orderCols[0], (int32_t)orderCols.size(), pModel, TSDB_ORDER_ASC);
+
+  std::vector<char> data = generateData(pModel, numOfRows, numOfRuns, 50);
+
+  int64_t st = taosGetTimestampUs();
+  if (radix) {
+    tColDataSort(pDesc, numOfRows, 0, numOfRows - 1, &data[0], TSDB_ORDER_ASC);
+  } else {
+    tColDataQSort(pDesc, numOfRows, 0, numOfRows - 1, &data[0], TSDB_ORDER_ASC);
+  }
+  int64_t et = taosGetTimestampUs();
+
+  tOrderDescDestroy(pDesc);
+  return et - st;
+}
+}  // namespace
+
+TEST(testCase, sort_integer_keys) {
+  int32_t types[] = {TSDB_DATA_TYPE_TINYINT, TSDB_DATA_TYPE_SMALLINT, TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BIGINT};
+
+  for (int32_t i = 0; i < 4; ++i) {
+    // order by ts, as the projection query
+    sortTest(types[i], {TS_COL}, TSDB_ORDER_ASC, TSDB_ORDER_ASC, 10000, 0);
+    sortTest(types[i], {TS_COL}, TSDB_ORDER_DESC, TSDB_ORDER_DESC, 10000, 4);
+
+    // group by a tag, and order by ts in each group, as the super table query
+    sortTest(types[i], {G_COL, TS_COL}, TSDB_ORDER_ASC, TSDB_ORDER_ASC, 10000, 8);
+    sortTest(types[i], {G_COL, TS_COL}, TSDB_ORDER_DESC, TSDB_ORDER_DESC, 10000, 8);
+    sortTest(types[i], {G_COL, TS_COL}, TSDB_ORDER_DESC, TSDB_ORDER_ASC, 10000, 0);
+
+    // the other integer columns follow the order type instead of the order of timestamp
+    sortTest(types[i], {G_COL, V_COL}, TSDB_ORDER_ASC, TSDB_ORDER_DESC, 10000, 0);
+  }
+
+  // too few rows for the radix sort
+  sortTest(TSDB_DATA_TYPE_INT, {G_COL, TS_COL}, TSDB_ORDER_ASC, TSDB_ORDER_ASC, 20, 0);
+}
+
+TEST(testCase, sort_other_keys) {
+  // the binary or double columns are sorted by the quick sort
+  sortTest(TSDB_DATA_TYPE_INT, {NAME_COL, TS_COL}, TSDB_ORDER_ASC, TSDB_ORDER_ASC, 10000, 8);
+  sortTest(TSDB_DATA_TYPE_INT, {D_COL}, TSDB_ORDER_ASC, TSDB_ORDER_DESC, 10000, 0);
+}
+
+// a timing comparison, not run by default
+// run it by: queryTest --gtest_also_run_disabled_tests --gtest_filter=*sort_benchmark
+TEST(testCase, DISABLED_sort_benchmark) {
+  struct {
+    const char*          name;
+    std::vector<int32_t> orderCols;
+    int32_t              numOfRuns;
+  } cases[] = {
+      {"ts, random", {TS_COL}, 0},
+      {"ts, 16 sorted runs", {TS_COL}, 16},
+      {"int tag + ts, 16 sorted runs", {G_COL, TS_COL}, 16},
+  };
+
+  int32_t sizes[] = {4096, 65536, 262144};
+
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+    for (size_t j = 0; j < sizeof(sizes) / sizeof(sizes[0]); ++j) {
+      int64_t q = benchmark(TSDB_DATA_TYPE_INT, cases[i].orderCols, sizes[j], cases[i].numOfRuns, false);
+      int64_t r = benchmark(TSDB_DATA_TYPE_INT, cases[i].orderCols, sizes[j], cases[i].numOfRuns, true);
+      printf("%-30s rows:%-8d quick sort:%-8" PRId64 " us, radix sort:%-8" PRId64 " us\n", cases[i].name, sizes[j], q,
+             r);
+    }
+  }
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "taos.h"
+#include "tsdb.h"
+#include "tsqlfunction.h"
+
+namespace {
+// the reference result, calculated in two scans with long double
+long double twoPassVariance(const std::vector<double>& data) {
+  long double sum = 0;
+  for (size_t i = 0; i < data.size(); ++i) {
+    sum += data[i];
+  }
+
+  long double avg = sum / data.size();
+  long double m2 = 0;
+  for (size_t i = 0; i < data.size(); ++i) {
+    m2 += (data[i] - avg) * (data[i] - avg);
+  }
+
+  return m2 / data.size();
+}
+
+struct SFuncRunner {
+  SQLFunctionCtx ctx;
+  SResultInfo    resInfo;
+  char           output[128];
+
+  SFuncRunner(int32_t functionId, bool superTable) {
+    memset(&ctx, 0, sizeof(ctx));
+    memset(&resInfo, 0, sizeof(resInfo));
+
+    int16_t type = 0, bytes = 0, inter = 0;
+    getResultDataInfo(TSDB_DATA_TYPE_DOUBLE, sizeof(double), functionId, 0, &type, &bytes, &inter, 0, superTable);
+
+    ctx.functionId = functionId;
+    ctx.inputType = TSDB_DATA_TYPE_DOUBLE;
+    ctx.inputBytes = sizeof(double);
+    ctx.outputType = type;
+    ctx.outputBytes = bytes;
+    ctx.aOutputBuf = output;
+    ctx.resultInfo = &resInfo;
+
+    setResultInfoBuf(&resInfo, inter, superTable);
+    aAggs[functionId].init(&ctx);
+  }
+
+  ~SFuncRunner() { free(resInfo.interResultBuf); }
+
+  // feed the data in blocks of the given size, or row by row if the size is 1
+  void feed(const std::vector<double>& data, size_t start, size_t end, size_t blockSize) {
+    for (size_t i = start; i < end; i += blockSize) {
+      ctx.aInputElemBuf = (void*)&data[i];
+      ctx.size = (int32_t)std::min(blockSize, end - i);
+
+      if (blockSize == 1) {
+        aAggs[ctx.functionId].xFunctionF(&ctx, 0);
+      } else {
+        aAggs[ctx.functionId].xFunction(&ctx);
+      }
+    }
+  }
+
+  double finalize() {
+    aAggs[ctx.functionId].xFinalize(&ctx);
+    return *(double*)output;
+  }
+};
+
+// the intermediate results of the vnodes are merged by the client, as the super table query does
+double mergedResult(int32_t functionId, const std::vector<double>& data, int32_t numOfVnodes) {
+  std::vector<char> inter;
+  int32_t           interBytes = 0;
+
+  size_t step = data.size() / numOfVnodes;
+  for (int32_t i = 0; i < numOfVnodes; ++i) {
+    SFuncRunner vnode(functionId, true);
+
+    size_t end = (i == numOfVnodes - 1) ? data.size() : (i + 1) * step;
+    vnode.feed(data, i * step, end, 1000);
+
+    interBytes = vnode.ctx.outputBytes;
+    inter.insert(inter.end(), vnode.output, vnode.output + interBytes);
+  }
+
+  SFuncRunner client(functionId, false);
+  client.ctx.inputType = TSDB_DATA_TYPE_BINARY;
+  client.ctx.inputBytes = interBytes;
+  client.ctx.currentStage = SECONDARY_STAGE_MERGE;
+  client.ctx.aInputElemBuf = &inter[0];
+  client.ctx.size = numOfVnodes;
+
+  aAggs[functionId].distSecondaryMergeFunc(&client.ctx);
+  return client.finalize();
+}
+
+std::vector<double> generateData(size_t num, double offset, double scale) {
+  std::vector<double> data(num);
+  srand(1);
+
+  for (size_t i = 0; i < num; ++i) {
+    data[i] = offset + scale * ((double)rand() / RAND_MAX - 0.5);
+  }
+
+  return data;
+}
+
+// the variance by the sum of squares, which is also calculated in one scan
+double sumOfSquaresVariance(const std::vector<double>& data) {
+  double sum = 0, sumOfSquares = 0;
+  for (size_t i = 0; i < data.size(); ++i) {
+    sum += data[i];
+    sumOfSquares += data[i] * data[i];
+  }
+
+  double avg = sum / data.size();
+  return sumOfSquares / data.size() - avg * avg;
+}
+
+void checkAccuracy(double offset, double scale) {
+  std::vector<double> data = generateData(100000, offset, scale);
+
+  // the values differ in the last 7 digits when the offset is large, so does the result of different orders of adding
+  double expected = (double)twoPassVariance(data);
+  double tolerance = expected * 1e-6;
+
+  size_t blockSizes[] = {1, 7, 4096, data.size()};
+  for (size_t i = 0; i < sizeof(blockSizes) / sizeof(blockSizes[0]); ++i) {
+    SFuncRunner variance(TSDB_FUNC_VARIANCE, false);
+    variance.feed(data, 0, data.size(), blockSizes[i]);
+    ASSERT_NEAR(variance.finalize(), expected, tolerance);
+
+    SFuncRunner stddev(TSDB_FUNC_STDDEV, false);
+    stddev.feed(data, 0, data.size(), blockSizes[i]);
+    ASSERT_NEAR(stddev.finalize(), sqrt(expected), sqrt(expected) * 1e-6);
+  }
+
+  ASSERT_NEAR(mergedResult(TSDB_FUNC_VARIANCE, data, 1), expected, tolerance);
+  ASSERT_NEAR(mergedResult(TSDB_FUNC_VARIANCE, data, 3), expected, tolerance);
+  ASSERT_NEAR(mergedResult(TSDB_FUNC_STDDEV, data, 16), sqrt(expected), sqrt(expected) * 1e-6);
+}
+}  // namespace
+
+TEST(testCase, stddev_accuracy) {
+  checkAccuracy(0, 100);
+
+  // the mean is much larger than the deviation, the result of the sum of squares has no valid digit left
+  checkAccuracy(1e9, 1);
+  checkAccuracy(-1e7, 0.01);
+
+  std::vector<double> data = generateData(100000, 1e9, 1);
+  double              expected = (double)twoPassVariance(data);
+  ASSERT_GT(fabs(sumOfSquaresVariance(data) - expected), expected);
+}
+
+TEST(testCase, stddev_null_and_empty) {
+  std::vector<double> data(100);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = (i % 2 == 0) ? (double)i : 0;
+    if (i % 2 != 0) {
+      setNull((char*)&data[i], TSDB_DATA_TYPE_DOUBLE, sizeof(double));
+    }
+  }
+
+  SFuncRunner runner(TSDB_FUNC_VARIANCE, false);
+  runner.ctx.hasNull = true;
+  runner.feed(data, 0, data.size(), 10);
+
+  // the even numbers in [0, 100)
+  std::vector<double> even;
+  for (int32_t i = 0; i < 100; i += 2) {
+    even.push_back(i);
+  }
+
+  ASSERT_NEAR(runner.finalize(), (double)twoPassVariance(even), 1e-9);
+
+  SFuncRunner empty(TSDB_FUNC_STDDEV, false);
+  empty.finalize();
+  ASSERT_TRUE(isNull(empty.output, TSDB_DATA_TYPE_DOUBLE));
+
+  // the vnodes without data do not change the merged result, only the last one of the 60 vnodes has data
+  ASSERT_NEAR(mergedResult(TSDB_FUNC_VARIANCE, even, 60), (double)twoPassVariance(even), 1e-9);
+}
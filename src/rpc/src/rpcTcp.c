@@ -61,7 +61,7 @@ typedef struct {
 } SServerObj;
 
 static void   *taosProcessTcpData(void *param);
-static SFdObj *taosMallocFdObj(SThreadObj *pThreadObj, int fd);
+static SFdObj *taosMallocFdObj(SThreadObj *pThreadObj, int fd, uint32_t ip, uint16_t port);
 static void    taosFreeFdObj(SFdObj *pFdObj);
 static void    taosReportBrokenLink(SFdObj *pFdObj);
 static void*   taosAcceptTcpConnection(void *arg);
@@ -220,12 +220,10 @@ static void* taosAcceptTcpConnection(void *arg) {
     // pick up the thread to handle this connection
     pThreadObj = pServerObj->pThreadObj + threadId;
 
-    SFdObj *pFdObj = taosMallocFdObj(pThreadObj, connFd);
+    SFdObj *pFdObj = taosMallocFdObj(pThreadObj, connFd, caddr.sin_addr.s_addr, caddr.sin_port);
     if (pFdObj) {
-      pFdObj->ip = caddr.sin_addr.s_addr;
-      pFdObj->port = caddr.sin_port;
       tTrace("%s new connection from %s:%hu, FD:%p, numOfFds:%d", pServerObj->label, 
-              inet_ntoa(caddr.sin_addr), pFdObj->port, pFdObj, pThreadObj->numOfFds);
+              inet_ntoa(caddr.sin_addr), caddr.sin_port, pFdObj, pThreadObj->numOfFds);
     } else {
       close(connFd);
       tError("%s failed to malloc FdObj(%s) for connection from:%s:%hu", pServerObj->label, strerror(errno),
@@ -294,12 +292,10 @@ void *taosOpenTcpClientConnection(void *shandle, void *thandle, uint32_t ip, uin
   int fd = taosOpenTcpClientSocket(ip, port, pThreadObj->ip);
   if (fd <= 0) return NULL;
 
-  SFdObj *pFdObj = taosMallocFdObj(pThreadObj, fd);
+  SFdObj *pFdObj = taosMallocFdObj(pThreadObj, fd, ip, port);
   
   if (pFdObj) {
     pFdObj->thandle = thandle;
-    pFdObj->port = port;
-    pFdObj->ip = ip;
     tTrace("%s %p, TCP connection to 0x%x:%hu is created, FD:%p numOfFds:%d", 
             pThreadObj->label, thandle, ip, port, pFdObj, pThreadObj->numOfFds);
   } else {
@@ -425,29 +421,37 @@ static void *taosProcessTcpData(void *param) {
   return NULL;
 }
 
-static SFdObj *taosMallocFdObj(SThreadObj *pThreadObj, int fd) {
+static SFdObj *taosMallocFdObj(SThreadObj *pThreadObj, int fd, uint32_t ip, uint16_t port) {
   struct epoll_event event;
 
   SFdObj *pFdObj = (SFdObj *)calloc(sizeof(SFdObj), 1);
   if (pFdObj == NULL) return NULL;
 
   pFdObj->fd = fd;
+  pFdObj->ip = ip;
+  pFdObj->port = port;
   pFdObj->pThreadObj = pThreadObj;
   pFdObj->signature = pFdObj;
 
+  // add into the FdObj list before the FD is polled, since the data may be processed or the link may be broken
+  // by the processing thread once it is in epoll
+  pthread_mutex_lock(&(pThreadObj->mutex));
+  pFdObj->next = pThreadObj->pHead;
+  if (pThreadObj->pHead) (pThreadObj->pHead)->prev = pFdObj;
+  pThreadObj->pHead = pFdObj;
+  pThreadObj->numOfFds++;
+
   event.events = EPOLLIN | EPOLLPRI | EPOLLWAKEUP;
   event.data.ptr = pFdObj;
   if (epoll_ctl(pThreadObj->pollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+    pThreadObj->pHead = pFdObj->next;
+    if (pFdObj->next) (pFdObj->next)->prev = NULL;
+    pThreadObj->numOfFds--;
+    pthread_mutex_unlock(&(pThreadObj->mutex));
     tfree(pFdObj);
     return NULL;
   }
 
-  // notify the data process, add into the FdObj list
-  pthread_mutex_lock(&(pThreadObj->mutex));
-  pFdObj->next = pThreadObj->pHead;
-  if (pThreadObj->pHead) (pThreadObj->pHead)->prev = pFdObj;
-  pThreadObj->pHead = pFdObj;
-  pThreadObj->numOfFds++;
   pthread_mutex_unlock(&(pThreadObj->mutex));
 
   return pFdObj;
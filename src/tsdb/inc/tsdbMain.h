@@ -93,6 +93,7 @@ typedef struct STable {
   void *         eventHandler;   // TODO
   void *         streamHandler;  // TODO
   TSKEY          lastKey;        // lastkey inserted in this table, initialized as 0, TODO: make a structure
+  int64_t        dataVersion;    // increased when rows no later than lastKey are inserted or the tags are updated
   struct STable *next;           // TODO: remove the next
   struct STable *prev;
   tstr *         name;           // NOTE: there a flexible string here
@@ -131,6 +132,7 @@ STsdbMeta *tsdbInitMeta(char *rootDir, int32_t maxTables);
 int32_t    tsdbFreeMeta(STsdbMeta *pMeta);
 STSchema * tsdbGetTableSchema(STsdbMeta *pMeta, STable *pTable);
 STSchema * tsdbGetTableTagSchema(STsdbMeta *pMeta, STable *pTable);
+int        tsdbUpdateTableTagValue(STsdbMeta *pMeta, STable *pTable, STSchema *pSchema, SDataRow row);
 
 // ---- Operation on STable
 #define TSDB_TABLE_ID(pTable) ((pTable)->tableId)
@@ -229,9 +231,18 @@ typedef struct {
 
 #define TSDB_IS_FILE_OPENED(f) ((f)->fd != -1)
 
+/*
+ * Besides the files, a file group keeps a summary of its data in memory: the key range and a bitmap of the tables
+ * having data blocks in it. Queries check the summary to skip the groups having nothing to return, without opening
+ * the files and loading the SCompIdx part of them.
+ */
 typedef struct {
-  int32_t fileId;
-  SFile   files[TSDB_FILE_TYPE_MAX];
+  int32_t  fileId;
+  SFile    files[TSDB_FILE_TYPE_MAX];
+  TSKEY    keyFirst;   // may be smaller than the first key of the data, but never larger
+  TSKEY    keyLast;
+  int32_t  maxTables;  // capacity of the bitmap, tables with larger tid are always taken as present
+  uint8_t *tables;
 } SFileGroup;
 
 // TSDB file handle
@@ -279,6 +290,9 @@ typedef struct {
   TSKEY    maxKey;
 } SCompIdx; /* sizeof(SCompIdx) = 28 */
 
+void tsdbUpdateFGroupSummary(SFileGroup *pGroup, SCompIdx *pCompIdx, int maxTables, TSKEY keyFirst);
+bool tsdbFGroupHasTable(SFileGroup *pGroup, int32_t tid);
+
 void *tsdbEncodeSCompIdx(void *buf, SCompIdx *pIdx);
 void *tsdbDecodeSCompIdx(void *buf, SCompIdx *pIdx);
 
@@ -326,19 +340,31 @@ typedef struct {
     }                                                                  \
   } while (0)
 
+// Codec of a column block. The default one is the compression algorithm of the column type, the others may be chosen
+// per block by the codec policy when they work better on the block.
+#define TSDB_COL_CODEC_DEFAULT 0
+#define TSDB_COL_CODEC_RAW 1
+#define TSDB_COL_CODEC_RLE 2
+#define TSDB_COL_CODEC_DICT 3
+
+#define TSDB_CODEC_POLICY_FIXED 0     // always use the default codec
+#define TSDB_CODEC_POLICY_SIZE 1      // choose the codec with the smallest output
+#define TSDB_CODEC_POLICY_BALANCED 2  // choose the codec by both output size and decode cost
+
 // TODO: take pre-calculation into account
 typedef struct {
   int16_t colId;  // Column ID
   int16_t len;    // Column length // TODO: int16_t is not enough
-  int32_t type : 8;
-  int32_t offset : 24;
+  uint32_t type : 4;
+  uint32_t codec : 4;  // TSDB_COL_CODEC_*, how the column data is encoded
+  int32_t  offset : 24;
   int64_t sum;
   int64_t max;
   int64_t min;
   int16_t maxIndex;
   int16_t minIndex;
   int16_t numOfNull;
-  char    padding[2];
+  int16_t bloomLen;  // Length of the bloom filter right after the column data, 0 if there is none
 } SCompCol;
 
 // TODO: Take recover into account
@@ -349,6 +375,44 @@ typedef struct {
   SCompCol cols[];
 } SCompData;
 
+/**
+ * The rollup of a data block keeps the pre-calculated statistics of each window of the rollup intervals (the tiers),
+ * right after the data (and the bloom filter) of the last column of the block, within the length of the block.
+ *
+ * | SRollupHead | SRollupTier | SRollupWindow * numOfWindows | SRollupCol * numOfWindows * numOfCols | ... | TSCKSUM |
+ *
+ * The statistics of a window follow the columns of SCompData. As a rollup is written together with the block, it is
+ * rebuilt whenever the block is rewritten, blocks with sub-blocks are not covered by their rollups.
+ */
+#define TSDB_MAX_ROLLUP_TIERS 4
+#define TSDB_ROLLUP_MIN_ROWS_PER_WINDOW 4  // tiers with fewer rows per window on average are not kept
+
+typedef struct {
+  int32_t delimiter;
+  int16_t numOfTiers;
+  int16_t numOfCols;
+} SRollupHead;
+
+typedef struct {
+  int64_t interval;
+  int32_t numOfWindows;
+  int32_t padding;
+} SRollupTier;
+
+typedef struct {
+  TSKEY   skey;  // start key of the window, a multiple of the interval
+  int32_t numOfRows;
+  int32_t padding;
+} SRollupWindow;
+
+typedef struct {
+  int64_t sum;
+  int64_t max;
+  int64_t min;
+  int16_t numOfNull;
+  int16_t padding[3];
+} SRollupCol;
+
 STsdbFileH *tsdbGetFile(TsdbRepoT *pRepo);
 
 int         tsdbCopyBlockDataInFile(SFile *pOutFile, SFile *pInFile, SCompInfo *pCompInfo, int idx, int isLast,
@@ -356,6 +420,38 @@ int         tsdbCopyBlockDataInFile(SFile *pOutFile, SFile *pInFile, SCompInfo *
 SFileGroup *tsdbSearchFGroup(STsdbFileH *pFileH, int fid);
 void tsdbGetKeyRangeOfFileId(int32_t daysPerFile, int8_t precision, int32_t fileId, TSKEY *minKey, TSKEY *maxKey);
 
+/*
+ * The blocks loaded by the file scans of concurrent queries. While more than one scan is attached, each block read
+ * and decompressed by a scan is kept in a ring of the recent blocks, and the other scans reading the same block take
+ * a copy of it instead of reading the file again. The dashboard queries over the same tables and time range read the
+ * blocks in the same order, so the ring only needs to cover the distance between the fastest and the slowest scan.
+ */
+typedef struct {
+  uint64_t uid;
+  int64_t  generation;      // the file generation when the file group is opened by the scan
+  int64_t  offset;          // the offset of the block in file, or of its sub-blocks in SCompInfo
+  int32_t  fid;
+  int32_t  numOfRows;
+  int8_t   last;
+  int8_t   numOfSubBlocks;
+} SSharedBlockKey;
+
+typedef struct {
+  SSharedBlockKey key;
+  int32_t         numOfRows;
+  int32_t         numOfCols;
+  SDataCol *      cols;  // columns loaded in ascending order of id, with the data of the rows only, NULL if empty
+} SSharedBlock;
+
+typedef struct {
+  pthread_mutex_t mutex;
+  int32_t         numOfScans;  // file scans attached
+  int32_t         capacity;
+  int32_t         next;        // the slot replaced by the next block
+  int64_t         generation;  // increased at the start and the end of each commit, odd when a commit is in progress
+  SSharedBlock *  blocks;
+} STsdbSharedScan;
+
 // TSDB repository definition
 typedef struct STsdbRepo {
   char *rootDir;
@@ -386,6 +482,9 @@ typedef struct STsdbRepo {
 
   int8_t state;
 
+  STsdbStat stat;
+
+  STsdbSharedScan sharedScan;
 } STsdbRepo;
 
 typedef struct {
@@ -425,6 +524,12 @@ typedef struct {
   int    minRowsPerFileBlock;
   int    maxRowsPerFileBlock;
   int8_t compress;
+  float  bloomFpp;  // false positive rate of the column bloom filters, 0 means no bloom filter
+  int8_t codecPolicy;  // TSDB_CODEC_POLICY_*
+  int8_t update;       // rows from the cache replace the rows in file with the same key
+  int8_t subBlocksToMerge;  // a block with this many sub-blocks is consolidated at commit, 0 to disable
+  int8_t  numOfRollups;
+  int64_t rollupIntervals[TSDB_MAX_ROLLUP_TIERS];  // in ascending order, in the precision of the repository
 } SHelperCfg;
 
 typedef struct {
@@ -498,12 +603,30 @@ int  tsdbCloseHelperFile(SRWHelper *pHelper, bool hasError);
 int  tsdbLoadCompIdx(SRWHelper *pHelper, void *target);
 int  tsdbLoadCompInfo(SRWHelper *pHelper, void *target);
 int  tsdbLoadCompData(SRWHelper *pHelper, SCompBlock *pCompBlock, void *target);
-int  tsdbLoadBlockDataCols(SRWHelper *pHelper, SDataCols *pDataCols, int blkIdx, int16_t *colIds, int numOfColIds);
+int  tsdbLoadBlockDataCols(SRWHelper *pHelper, SCompInfo *pCompInfo, SCompBlock *pCompBlock, int16_t *colIds,
+                           int numOfColIds);
 int  tsdbLoadBlockData(SRWHelper *pHelper, SCompBlock *pCompBlock, SDataCols *target);
 void tsdbGetDataStatis(SRWHelper *pHelper, SDataStatis *pStatis, int numOfCols);
+bool tsdbBloomMayContain(SRWHelper *pHelper, SCompBlock *pCompBlock, int16_t colId, const char *val, int32_t len);
+int  tsdbGetDataRollup(SRWHelper *pHelper, SCompBlock *pCompBlock, int64_t interval, int64_t origin,
+                       SDataStatis *pStatis, int numOfCols, SDataRollup *pRollup);
+void tsdbCountBlocks(SRWHelper *pHelper, STsdbStat *pStat);
+
+// --------- Shared scans of concurrent queries
+int     tsdbInitSharedScan(STsdbRepo *pRepo);
+void    tsdbDestroySharedScan(STsdbRepo *pRepo);
+void    tsdbAttachSharedScan(STsdbRepo *pRepo);
+void    tsdbDetachSharedScan(STsdbRepo *pRepo);
+void    tsdbInvalidateSharedScan(STsdbRepo *pRepo);
+int64_t tsdbGetSharedScanGeneration(STsdbRepo *pRepo);
+bool    tsdbLoadSharedBlock(STsdbRepo *pRepo, SSharedBlockKey *pKey, int16_t *colIds, int numOfColIds,
+                            SDataCols *target);
+void    tsdbPublishSharedBlock(STsdbRepo *pRepo, SSharedBlockKey *pKey, int16_t *colIds, int numOfColIds,
+                               SDataCols *pDataCols);
 
 // --------- For write operations
 int tsdbWriteDataBlock(SRWHelper *pHelper, SDataCols *pDataCols);
+int tsdbConsolidateBlocks(SRWHelper *pHelper, SDataCols *pDataCols);
 int tsdbMoveLastBlockIfNeccessary(SRWHelper *pHelper);
 int tsdbWriteCompInfo(SRWHelper *pHelper);
 int tsdbWriteCompIdx(SRWHelper *pHelper);
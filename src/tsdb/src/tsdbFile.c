@@ -37,7 +37,8 @@ const char *tsdbFileSuffix[] = {
 
 static int compFGroupKey(const void *key, const void *fgroup);
 static int compFGroup(const void *arg1, const void *arg2);
-static int tsdbOpenFGroup(STsdbFileH *pFileH, char *dataDir, int fid);
+static int tsdbOpenFGroup(STsdbFileH *pFileH, char *dataDir, int fid, int maxTables);
+static int tsdbInitFGroupSummary(SFileGroup *pGroup, int maxTables);
 
 STsdbFileH *tsdbInitFileH(char *dataDir, STsdbCfg *pCfg) {
   STsdbFileH *pFileH = (STsdbFileH *)calloc(1, sizeof(STsdbFileH));
@@ -64,7 +65,7 @@ STsdbFileH *tsdbInitFileH(char *dataDir, STsdbCfg *pCfg) {
     if (strncmp(dp->d_name, ".", 1) == 0 || strncmp(dp->d_name, "..", 1) == 0) continue;
     int fid = 0;
     sscanf(dp->d_name, "f%d", &fid);
-    if (tsdbOpenFGroup(pFileH, dataDir, fid) < 0) {
+    if (tsdbOpenFGroup(pFileH, dataDir, fid, pCfg->maxTables) < 0) {
       break;
       // TODO
     }
@@ -76,6 +77,9 @@ STsdbFileH *tsdbInitFileH(char *dataDir, STsdbCfg *pCfg) {
 
 void tsdbCloseFileH(STsdbFileH *pFileH) {
   if (pFileH) {
+    for (int i = 0; i < pFileH->numOfFGroups; i++) {
+      tfree(pFileH->fGroup[i].tables);
+    }
     tfree(pFileH->fGroup);
     free(pFileH);
   }
@@ -102,7 +106,7 @@ static int tsdbInitFile(char *dataDir, int fid, const char *suffix, SFile *pFile
   return 0;
 }
 
-static int tsdbOpenFGroup(STsdbFileH *pFileH, char *dataDir, int fid) {
+static int tsdbOpenFGroup(STsdbFileH *pFileH, char *dataDir, int fid, int maxTables) {
   if (tsdbSearchFGroup(pFileH, fid) != NULL) return 0;
 
   SFileGroup fGroup = {0};
@@ -111,6 +115,8 @@ static int tsdbOpenFGroup(STsdbFileH *pFileH, char *dataDir, int fid) {
   for (int type = TSDB_FILE_TYPE_HEAD; type < TSDB_FILE_TYPE_MAX; type++) {
     if (tsdbInitFile(dataDir, fid, tsdbFileSuffix[type], &fGroup.files[type]) < 0) return -1;
   }
+  // The summary is filled when the repository restores the info from the SCompIdx part of the files
+  if (tsdbInitFGroupSummary(&fGroup, maxTables) < 0) return -1;
   pFileH->fGroup[pFileH->numOfFGroups++] = fGroup;
   qsort((void *)(pFileH->fGroup), pFileH->numOfFGroups, sizeof(SFileGroup), compFGroup);
   return 0;
@@ -134,6 +140,7 @@ SFileGroup *tsdbCreateFGroup(STsdbFileH *pFileH, char *dataDir, int fid, int max
       if (tsdbCreateFile(dataDir, fid, tsdbFileSuffix[type], &(pFGroup->files[type])) < 0)
         goto _err;
     }
+    if (tsdbInitFGroupSummary(pFGroup, maxTables) < 0) goto _err;
 
     pFileH->fGroup[pFileH->numOfFGroups++] = fGroup;
     qsort((void *)(pFileH->fGroup), pFileH->numOfFGroups, sizeof(SFileGroup), compFGroup);
@@ -156,6 +163,7 @@ int tsdbRemoveFileGroup(STsdbFileH *pFileH, int fid) {
   for (int type = TSDB_FILE_TYPE_HEAD; type < TSDB_FILE_TYPE_MAX; type++) {
     remove(pGroup->files[type].fname);
   }
+  tfree(pGroup->tables);
 
   // Adjust the memory
   int filesBehind = pFileH->numOfFGroups - (((char *)pGroup - (char *)(pFileH->fGroup)) / sizeof(SFileGroup) + 1);
@@ -362,6 +370,38 @@ void tsdbGetKeyRangeOfFileId(int32_t daysPerFile, int8_t precision, int32_t file
   *maxKey = *minKey + daysPerFile * tsMsPerDay[precision] - 1;
 }
 
+static int tsdbInitFGroupSummary(SFileGroup *pGroup, int maxTables) {
+  pGroup->keyFirst = INT64_MAX;
+  pGroup->keyLast = INT64_MIN;
+  pGroup->maxTables = maxTables;
+  pGroup->tables = (uint8_t *)calloc((maxTables + 7) / 8, sizeof(uint8_t));
+  if (pGroup->tables == NULL) return -1;
+  return 0;
+}
+
+/**
+ * Add the tables having data blocks in pCompIdx to the summary of the file group. Bits are only set but never
+ * cleared, so the queries reading the summary at the same time never miss a table.
+ *
+ * @param keyFirst the smallest key written to the group, or the first key of the file id if it is unknown
+ */
+void tsdbUpdateFGroupSummary(SFileGroup *pGroup, SCompIdx *pCompIdx, int maxTables, TSKEY keyFirst) {
+  if (pGroup->keyFirst > keyFirst) pGroup->keyFirst = keyFirst;
+
+  for (int tid = 1; tid < maxTables && tid < pGroup->maxTables; tid++) {
+    SCompIdx *pIdx = pCompIdx + tid;
+    if (pIdx->offset == 0 || pIdx->numOfBlocks == 0) continue;
+
+    pGroup->tables[tid >> 3] |= (uint8_t)(1 << (tid & 7));
+    if (pGroup->keyLast < pIdx->maxKey) pGroup->keyLast = pIdx->maxKey;
+  }
+}
+
+bool tsdbFGroupHasTable(SFileGroup *pGroup, int32_t tid) {
+  if (tid >= pGroup->maxTables) return true;  // maxTables is enlarged after the group is opened
+  return (pGroup->tables[tid >> 3] & (1 << (tid & 7))) != 0;
+}
+
 SFileGroup *tsdbSearchFGroup(STsdbFileH *pFileH, int fid) {
   if (pFileH->numOfFGroups == 0 || fid < pFileH->fGroup[0].fileId || fid > pFileH->fGroup[pFileH->numOfFGroups - 1].fileId)
     return NULL;
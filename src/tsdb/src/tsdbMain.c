@@ -12,7 +12,7 @@
 #define TSDB_DEFAULT_PRECISION TSDB_PRECISION_MILLI  // default precision
 #define IS_VALID_PRECISION(precision) (((precision) >= TSDB_PRECISION_MILLI) && ((precision) <= TSDB_PRECISION_NANO))
 #define TSDB_DEFAULT_COMPRESSION TWO_STAGE_COMP
-#define IS_VALID_COMPRESSION(compression) (((compression) >= NO_COMPRESSION) && ((compression) <= TWO_STAGE_COMP))
+#define IS_VALID_COMPRESSION(compression) (((compression) >= NO_COMPRESSION) && ((compression) <= TWO_STAGE_COMP_ZSTD))
 #define TSDB_MIN_ID 0
 #define TSDB_MAX_ID INT_MAX
 
@@ -32,7 +32,7 @@ static int32_t tsdbRestoreCfg(STsdbRepo *pRepo, STsdbCfg *pCfg);
 static int32_t tsdbGetDataDirName(STsdbRepo *pRepo, char *fname);
 static void *  tsdbCommitData(void *arg);
 static int     tsdbCommitToFile(STsdbRepo *pRepo, int fid, SSkipListIterator **iters, SRWHelper *pHelper,
-                                SDataCols *pDataCols);
+                                SDataCols *pDataCols, STsdbStat *pStat);
 static TSKEY   tsdbNextIterKey(SSkipListIterator *pIter);
 static int     tsdbHasDataToCommit(SSkipListIterator **iters, int nIters, TSKEY minKey, TSKEY maxKey);
 static void    tsdbAlterCompression(STsdbRepo *pRepo, int8_t compression);
@@ -53,12 +53,15 @@ void tsdbSetDefaultCfg(STsdbCfg *pCfg) {
 
   pCfg->precision = -1;
   pCfg->tsdbId = 0;
+  pCfg->cacheBlockSize = -1;
+  pCfg->totalBlocks = -1;
   pCfg->maxTables = -1;
   pCfg->daysPerFile = -1;
   pCfg->minRowsPerFileBlock = -1;
   pCfg->maxRowsPerFileBlock = -1;
   pCfg->keep = -1;
   pCfg->compression = TWO_STAGE_COMP;
+  pCfg->update = 0;
 }
 
 /**
@@ -166,6 +169,12 @@ static int tsdbRestoreInfo(STsdbRepo *pRepo) {
   tsdbInitFileGroupIter(pFileH, &iter, TSDB_ORDER_ASC);
   while ((pFGroup = tsdbGetFileGroupNext(&iter)) != NULL) {
     if (tsdbSetAndOpenHelperFile(&rhelper, pFGroup) < 0) goto _err;
+
+    // The first key of the data is not in SCompIdx, take the first key of the file id instead
+    TSKEY minKey = 0, maxKey = 0;
+    tsdbGetKeyRangeOfFileId(pRepo->config.daysPerFile, pRepo->config.precision, pFGroup->fileId, &minKey, &maxKey);
+    tsdbUpdateFGroupSummary(pFGroup, rhelper.pCompIdx, pRepo->config.maxTables, minKey);
+
     for (int i = 1; i < pRepo->config.maxTables; i++) {
       STable *  pTable = pMeta->tables[i];
       if (pTable == NULL) continue;
@@ -202,11 +211,19 @@ TsdbRepoT *tsdbOpenRepo(char *tsdbDir, STsdbAppH *pAppH) {
 
   pRepo->rootDir = strdup(tsdbDir);
 
+  if (tsdbInitSharedScan(pRepo) < 0) {
+    tsdbDestroySharedScan(pRepo);
+    free(pRepo->rootDir);
+    free(pRepo);
+    return NULL;
+  }
+
   tsdbRestoreCfg(pRepo, &(pRepo->config));
   if (pAppH) pRepo->appH = *pAppH;
 
   pRepo->tsdbMeta = tsdbInitMeta(tsdbDir, pRepo->config.maxTables);
   if (pRepo->tsdbMeta == NULL) {
+    tsdbDestroySharedScan(pRepo);
     free(pRepo->rootDir);
     free(pRepo);
     return NULL;
@@ -215,6 +232,7 @@ TsdbRepoT *tsdbOpenRepo(char *tsdbDir, STsdbAppH *pAppH) {
   pRepo->tsdbCache = tsdbInitCache(pRepo->config.cacheBlockSize, pRepo->config.totalBlocks, (TsdbRepoT *)pRepo);
   if (pRepo->tsdbCache == NULL) {
     tsdbFreeMeta(pRepo->tsdbMeta);
+    tsdbDestroySharedScan(pRepo);
     free(pRepo->rootDir);
     free(pRepo);
     return NULL;
@@ -225,6 +243,7 @@ TsdbRepoT *tsdbOpenRepo(char *tsdbDir, STsdbAppH *pAppH) {
   if (pRepo->tsdbFileH == NULL) {
     tsdbFreeCache(pRepo->tsdbCache);
     tsdbFreeMeta(pRepo->tsdbMeta);
+    tsdbDestroySharedScan(pRepo);
     free(pRepo->rootDir);
     free(pRepo);
     return NULL;
@@ -235,6 +254,7 @@ TsdbRepoT *tsdbOpenRepo(char *tsdbDir, STsdbAppH *pAppH) {
     tsdbFreeCache(pRepo->tsdbCache);
     tsdbFreeMeta(pRepo->tsdbMeta);
     tsdbCloseFileH(pRepo->tsdbFileH);
+    tsdbDestroySharedScan(pRepo);
     free(pRepo->rootDir);
     free(pRepo);
     return NULL;
@@ -292,6 +312,7 @@ int32_t tsdbCloseRepo(TsdbRepoT *repo, int toCommit) {
   tsdbFreeMeta(pRepo->tsdbMeta);
 
   tsdbFreeCache(pRepo->tsdbCache);
+  tsdbDestroySharedScan(pRepo);
 
   tfree(pRepo->rootDir);
   tfree(pRepo);
@@ -396,13 +417,35 @@ int32_t tsdbUnLockRepo(TsdbRepoT *repo) {
  * @return a info struct handle on success, NULL for failure and the error number is set. The upper
  *         layers should free the info handle themselves or memory leak will occur
  */
-STsdbRepoInfo *tsdbGetStatus(TsdbRepoT *pRepo) {
-  // TODO
-  return NULL;
+STsdbRepoInfo *tsdbGetStatus(TsdbRepoT *repo) {
+  STsdbRepo *    pRepo = (STsdbRepo *)repo;
+  STsdbRepoInfo *pInfo = (STsdbRepoInfo *)calloc(1, sizeof(STsdbRepoInfo));
+  if (pInfo == NULL) return NULL;
+
+  pInfo->tsdbCfg = pRepo->config;
+  pInfo->stat = pRepo->stat;
+  pInfo->stat.numOfBlocksRead = atomic_load_64(&pRepo->stat.numOfBlocksRead);
+  pInfo->stat.numOfFragmentsRead = atomic_load_64(&pRepo->stat.numOfFragmentsRead);
+  pInfo->stat.numOfBlocksShared = atomic_load_64(&pRepo->stat.numOfBlocksShared);
+
+  return pInfo;
 }
 
-int tsdbAlterTable(TsdbRepoT *pRepo, STableCfg *pCfg) {
-  // TODO
+int tsdbAlterTable(TsdbRepoT *repo, STableCfg *pCfg) {
+  STsdbRepo *pRepo = (STsdbRepo *)repo;
+
+  STable *pTable = tsdbIsValidTableToInsert(pRepo->tsdbMeta, pCfg->tableId);
+  if (pTable == NULL) {
+    tsdbError("vgId:%d, failed to alter table since table not exists! tid:%d, uid:%" PRId64, pRepo->config.tsdbId,
+              pCfg->tableId.tid, pCfg->tableId.uid);
+    return TSDB_CODE_INVALID_TABLE_ID;
+  }
+
+  // only the tag values are altered here, the schemas of the tables are updated through the table config from mnode
+  if (pTable->type == TSDB_CHILD_TABLE && pCfg->tagSchema != NULL && pCfg->tagValues != NULL) {
+    return tsdbUpdateTableTagValue(pRepo->tsdbMeta, pTable, pCfg->tagSchema, pCfg->tagValues);
+  }
+
   return 0;
 }
 
@@ -415,6 +458,15 @@ TSKEY tsdbGetTableLastKey(TsdbRepoT *repo, uint64_t uid) {
   return TSDB_GET_TABLE_LAST_KEY(pTable);
 }
 
+int64_t tsdbGetTableDataVersion(TsdbRepoT *repo, uint64_t uid) {
+  STsdbRepo *pRepo = (STsdbRepo *)repo;
+
+  STable *pTable = tsdbGetTableByUid(pRepo->tsdbMeta, uid);
+  if (pTable == NULL) return -1;
+
+  return atomic_load_64(&pTable->dataVersion);
+}
+
 STableInfo *tsdbGetTableInfo(TsdbRepoT *pRepo, STableId tableId) {
   // TODO
   return NULL;
@@ -642,6 +694,12 @@ static int32_t tsdbCheckAndSetDefaultCfg(STsdbCfg *pCfg) {
     }
   }
 
+  // Check update
+  if (pCfg->update != 0 && pCfg->update != 1) {
+    tsdbError("vgId:%d: invalid update configuration! update:%d", pCfg->tsdbId, pCfg->update);
+    return -1;
+  }
+
   // Check tsdbId
   if (pCfg->tsdbId < 0) return -1;
 
@@ -776,9 +834,9 @@ static int32_t tsdbSetRepoEnv(STsdbRepo *pRepo) {
 
   tsdbTrace(
       "vgId:%d, set up tsdb environment succeed! cacheBlockSize:%d, totalBlocks:%d, maxTables:%d, daysPerFile:%d, keep:"
-      "%d, minRowsPerFileBlock:%d, maxRowsPerFileBlock:%d, precision:%d, compression:%d",
+      "%d, minRowsPerFileBlock:%d, maxRowsPerFileBlock:%d, precision:%d, compression:%d, update:%d",
       pRepo->config.tsdbId, pCfg->cacheBlockSize, pCfg->totalBlocks, pCfg->maxTables, pCfg->daysPerFile, pCfg->keep,
-      pCfg->minRowsPerFileBlock, pCfg->maxRowsPerFileBlock, pCfg->precision, pCfg->compression);
+      pCfg->minRowsPerFileBlock, pCfg->maxRowsPerFileBlock, pCfg->precision, pCfg->compression, pCfg->update);
   return 0;
 }
 
@@ -822,7 +880,9 @@ static int32_t tdInsertRowToTable(STsdbRepo *pRepo, SDataRow row, STable *pTable
   if (pTable->mem == NULL) {
     pTable->mem = (SMemTable *)calloc(1, sizeof(SMemTable));
     if (pTable->mem == NULL) return -1;
-    pTable->mem->pData = tSkipListCreate(5, TSDB_DATA_TYPE_TIMESTAMP, TYPE_BYTES[TSDB_DATA_TYPE_TIMESTAMP], 0, 0, 0, getTSTupleKey);
+    pTable->mem->pData = tSkipListCreate(5, TSDB_DATA_TYPE_TIMESTAMP, TYPE_BYTES[TSDB_DATA_TYPE_TIMESTAMP],
+                                         pRepo->config.update ? SL_UPDATE_DUP_KEY : SL_DISCARD_DUP_KEY, 0, 0,
+                                         getTSTupleKey);
     pTable->mem->keyFirst = INT64_MAX;
     pTable->mem->keyLast = 0;
   }
@@ -845,14 +905,20 @@ static int32_t tdInsertRowToTable(STsdbRepo *pRepo, SDataRow row, STable *pTable
   if (pTable->mem == NULL) {
     pTable->mem = (SMemTable *)calloc(1, sizeof(SMemTable));
     if (pTable->mem == NULL) return -1;
-    pTable->mem->pData = tSkipListCreate(5, TSDB_DATA_TYPE_TIMESTAMP, TYPE_BYTES[TSDB_DATA_TYPE_TIMESTAMP], 0, 0, 0, getTSTupleKey);
+    pTable->mem->pData = tSkipListCreate(5, TSDB_DATA_TYPE_TIMESTAMP, TYPE_BYTES[TSDB_DATA_TYPE_TIMESTAMP],
+                                         pRepo->config.update ? SL_UPDATE_DUP_KEY : SL_DISCARD_DUP_KEY, 0, 0,
+                                         getTSTupleKey);
     pTable->mem->keyFirst = INT64_MAX;
     pTable->mem->keyLast = 0;
   }
   tSkipListPut(pTable->mem->pData, pNode);
   if (key > pTable->mem->keyLast) pTable->mem->keyLast = key;
   if (key < pTable->mem->keyFirst) pTable->mem->keyFirst = key;
-  if (key > pTable->lastKey) pTable->lastKey = key;
+  if (key > pTable->lastKey) {
+    pTable->lastKey = key;
+  } else {
+    atomic_add_fetch_64(&pTable->dataVersion, 1);
+  }
   
   pTable->mem->numOfRows = tSkipListGetSize(pTable->mem->pData);
 
@@ -966,9 +1032,11 @@ static void *tsdbCommitData(void *arg) {
   STsdbCfg *  pCfg = &(pRepo->config);
   SDataCols * pDataCols = NULL;
   SRWHelper   whelper = {{0}};
+  STsdbStat   stat = {0};
   if (pCache->imem == NULL) return NULL;
 
   tsdbPrint("vgId: %d, starting to commit....", pRepo->config.tsdbId);
+  tsdbInvalidateSharedScan(pRepo);
 
   // Create the iterator to read from cache
   SSkipListIterator **iters = tsdbCreateTableIters(pMeta, pCfg->maxTables);
@@ -985,12 +1053,17 @@ static void *tsdbCommitData(void *arg) {
 
   // Loop to commit to each file
   for (int fid = sfid; fid <= efid; fid++) {
-    if (tsdbCommitToFile(pRepo, fid, iters, &whelper, pDataCols) < 0) {
+    if (tsdbCommitToFile(pRepo, fid, iters, &whelper, pDataCols, &stat) < 0) {
       ASSERT(false);
       goto _exit;
     }
   }
 
+  pRepo->stat.numOfBlocks = stat.numOfBlocks;
+  pRepo->stat.numOfSubBlocks = stat.numOfSubBlocks;
+  pRepo->stat.numOfLastBlocks = stat.numOfLastBlocks;
+  pRepo->stat.numOfMergedBlocks += stat.numOfMergedBlocks;
+
   // Do retention actions
   tsdbFitRetention(pRepo);
   if (pRepo->appH.notifyStatus) pRepo->appH.notifyStatus(pRepo->appH.appH, TSDB_STATUS_COMMIT_OVER);
@@ -999,6 +1072,7 @@ _exit:
   tdFreeDataCols(pDataCols);
   tsdbDestroyTableIters(iters, pCfg->maxTables);
   tsdbDestroyHelper(&whelper);
+  tsdbInvalidateSharedScan(pRepo);
 
   tsdbLockRepo(arg);
   tdListMove(pCache->imem->list, pCache->pool.memPool);
@@ -1019,14 +1093,15 @@ _exit:
   return NULL;
 }
 
-static int tsdbCommitToFile(STsdbRepo *pRepo, int fid, SSkipListIterator **iters, SRWHelper *pHelper, SDataCols *pDataCols) {
+static int tsdbCommitToFile(STsdbRepo *pRepo, int fid, SSkipListIterator **iters, SRWHelper *pHelper,
+                            SDataCols *pDataCols, STsdbStat *pStat) {
   char dataDir[128] = {0};
   STsdbMeta * pMeta = pRepo->tsdbMeta;
   STsdbFileH *pFileH = pRepo->tsdbFileH;
   STsdbCfg *  pCfg = &pRepo->config;
   SFileGroup *pGroup = NULL;
 
-  TSKEY minKey = 0, maxKey = 0;
+  TSKEY minKey = 0, maxKey = 0, keyFirst = INT64_MAX;
   tsdbGetKeyRangeOfFileId(pCfg->daysPerFile, pCfg->precision, fid, &minKey, &maxKey);
 
   // Check if there are data to commit to this file
@@ -1068,6 +1143,7 @@ static int tsdbCommitToFile(STsdbRepo *pRepo, int fid, SSkipListIterator **iters
 
       ASSERT(dataColsKeyFirst(pDataCols) >= minKey && dataColsKeyFirst(pDataCols) <= maxKey);
       ASSERT(dataColsKeyLast(pDataCols) >= minKey && dataColsKeyLast(pDataCols) <= maxKey);
+      if (keyFirst > dataColsKeyFirst(pDataCols)) keyFirst = dataColsKeyFirst(pDataCols);
 
       int rowsWritten = tsdbWriteDataBlock(pHelper, pDataCols);
       ASSERT(rowsWritten != 0);
@@ -1080,12 +1156,24 @@ static int tsdbCommitToFile(STsdbRepo *pRepo, int fid, SSkipListIterator **iters
 
     ASSERT(pDataCols->numOfRows == 0);
 
+    // Consolidate the fragments of the table just committed
+    if (nLoop > 0) {
+      int merged = tsdbConsolidateBlocks(pHelper, pDataCols);
+      if (merged < 0) {
+        tsdbError("vgId:%d, failed to consolidate blocks", pRepo->config.tsdbId);
+        goto _err;
+      }
+      pStat->numOfMergedBlocks += merged;
+    }
+
     // Move the last block to the new .l file if neccessary
     if (tsdbMoveLastBlockIfNeccessary(pHelper) < 0) {
       tsdbError("vgId:%d, failed to move last block", pRepo->config.tsdbId);
       goto _err;
     }
 
+    if (nLoop > 0) tsdbCountBlocks(pHelper, pStat);
+
     // Write the SCompBlock part
     if (tsdbWriteCompInfo(pHelper) < 0) {
       tsdbError("vgId:%d, failed to write compInfo part", pRepo->config.tsdbId);
@@ -1103,6 +1191,7 @@ static int tsdbCommitToFile(STsdbRepo *pRepo, int fid, SSkipListIterator **iters
   pGroup->files[TSDB_FILE_TYPE_HEAD] = pHelper->files.headF;
   pGroup->files[TSDB_FILE_TYPE_DATA] = pHelper->files.dataF;
   pGroup->files[TSDB_FILE_TYPE_LAST] = pHelper->files.lastF;
+  tsdbUpdateFGroupSummary(pGroup, pHelper->pCompIdx, pCfg->maxTables, keyFirst);
 
   return 0;
 
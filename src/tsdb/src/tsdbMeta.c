@@ -17,6 +17,7 @@ static int     tsdbAddTableIntoIndex(STsdbMeta *pMeta, STable *pTable);
 static int     tsdbRemoveTableFromIndex(STsdbMeta *pMeta, STable *pTable);
 static int     tsdbEstimateTableEncodeSize(STable *pTable);
 static int     tsdbRemoveTableFromMeta(STsdbMeta *pMeta, STable *pTable, bool rmFromIdx);
+static SDataRow tsdbNewTagRow(STSchema *pTagSchema, SDataRow row);
 
 /**
  * Encode a TSDB table object as a binary content
@@ -141,6 +142,12 @@ void tsdbOrgMeta(void *pHandle) {
   for (int i = 1; i < pMeta->maxTables; i++) {
     STable *pTable = pMeta->tables[i];
     if (pTable != NULL && pTable->type == TSDB_CHILD_TABLE) {
+      SDataRow row = tsdbNewTagRow(tsdbGetTableTagSchema(pMeta, pTable), pTable->tagVal);
+      if (row != NULL) {
+        tdFreeDataRow(pTable->tagVal);
+        pTable->tagVal = row;
+      }
+
       tsdbAddTableIntoIndex(pMeta, pTable);
     }
   }
@@ -264,6 +271,61 @@ int32_t tsdbGetTableTagVal(TsdbRepoT* repo, STableId* id, int32_t colId, int16_t
   return TSDB_CODE_SUCCESS;
 }
 
+/**
+ * Update the values of the tags of a child table
+ *
+ * @param pSchema the schema of the tags to update, the columns are matched by colId
+ * @param row the new values in the layout of pSchema
+ *
+ * @return 0 for success, or the error code
+ */
+int tsdbUpdateTableTagValue(STsdbMeta *pMeta, STable *pTable, STSchema *pSchema, SDataRow row) {
+  STSchema *pTagSchema = tsdbGetTableTagSchema(pMeta, pTable);
+  if (pTagSchema == NULL) return TSDB_CODE_INVALID_TABLE_ID;
+
+  SDataRow newRow = tdNewDataRowFromSchema(pTagSchema);
+  if (newRow == NULL) return TSDB_CODE_SERV_OUT_OF_MEMORY;
+
+  bool reindex = false;
+  for (int i = 0; i < schemaNCols(pTagSchema); i++) {
+    STColumn *pCol = schemaColAt(pTagSchema, i);
+    void *    value = tdGetRowDataOfCol(pTable->tagVal, pCol->type, TD_DATA_ROW_HEAD_SIZE + pCol->offset);
+
+    for (int j = 0; j < schemaNCols(pSchema); j++) {
+      STColumn *pNewCol = schemaColAt(pSchema, j);
+      if (pNewCol->colId != pCol->colId) continue;
+
+      if (pNewCol->type != pCol->type || pNewCol->bytes != pCol->bytes) {
+        tdFreeDataRow(newRow);
+        return TSDB_CODE_INVALID_VALUE;
+      }
+
+      value = tdGetRowDataOfCol(row, pNewCol->type, TD_DATA_ROW_HEAD_SIZE + pNewCol->offset);
+      if (i == DEFAULT_TAG_INDEX_COLUMN) reindex = true;
+    }
+
+    tdAppendColVal(newRow, value, pCol->type, pCol->bytes, pCol->offset);
+  }
+
+  // the row is allocated in the max size of the tag schema, it is overwritten in place since the queries may be
+  // reading it, and the table is put into the tag index again if the indexed tag is changed
+  if (reindex) tsdbRemoveTableFromIndex(pMeta, pTable);
+  dataRowCpy(pTable->tagVal, newRow);
+  if (reindex) tsdbAddTableIntoIndex(pMeta, pTable);
+  tdFreeDataRow(newRow);
+
+  // the results cached for the table are out of date
+  atomic_add_fetch_64(&pTable->dataVersion, 1);
+
+  int   bufLen = 0;
+  void *buf = tsdbEncodeTable(pTable, &bufLen);
+  tsdbDeleteMetaRecord(pMeta->mfh, pTable->tableId.uid);
+  tsdbInsertMetaRecord(pMeta->mfh, pTable->tableId.uid, buf, bufLen);
+  tsdbFreeEncode(buf);
+
+  return 0;
+}
+
 char* tsdbGetTableName(TsdbRepoT *repo, const STableId* id, int16_t* bytes) {
   STsdbMeta* pMeta = tsdbGetMeta(repo);
   STable* pTable = tsdbGetTableByUid(pMeta, id->uid);
@@ -353,7 +415,7 @@ int tsdbCreateTable(TsdbRepoT *repo, STableCfg *pCfg) {
   if (IS_CREATE_STABLE(pCfg)) { // TSDB_CHILD_TABLE
     table->type = TSDB_CHILD_TABLE;
     table->superUid = pCfg->superUid;
-    table->tagVal = tdDataRowDup(pCfg->tagValues);
+    table->tagVal = tsdbNewTagRow(super->tagSchema, pCfg->tagValues);
   } else { // TSDB_NORMAL_TABLE
     table->type = TSDB_NORMAL_TABLE;
     table->superUid = -1;
@@ -621,4 +683,18 @@ static int tsdbEstimateTableEncodeSize(STable *pTable) {
 char *getTSTupleKey(const void * data) {
   SDataRow row = (SDataRow)data;
   return POINTER_SHIFT(row, TD_DATA_ROW_HEAD_SIZE);
-}
\ No newline at end of file
+}
+
+// the tag values of a child table are kept in a row of the max size of the tag schema, so they can be updated in place
+static SDataRow tsdbNewTagRow(STSchema *pTagSchema, SDataRow row) {
+  int32_t size = dataRowLen(row);
+  if (pTagSchema != NULL && dataRowMaxBytesFromSchema(pTagSchema) > size) {
+    size = dataRowMaxBytesFromSchema(pTagSchema);
+  }
+
+  SDataRow trow = malloc(size);
+  if (trow == NULL) return NULL;
+
+  dataRowCpy(trow, row);
+  return trow;
+}
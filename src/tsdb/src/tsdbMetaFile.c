@@ -124,7 +124,7 @@ int32_t tsdbDeleteMetaRecord(SMetaFile *mfh, uint64_t uid) {
   // Remove record from file
 
   info.offset = -info.offset;
-  if (lseek(mfh->fd, -info.offset, SEEK_CUR) < 0) {
+  if (lseek(mfh->fd, -info.offset, SEEK_SET) < 0) {
     return -1;
   }
 
@@ -249,8 +249,6 @@ static int tsdbRestoreFromMetaFile(char *fname, SMetaFile *mfh) {
   while (1) {
     if (read(mfh->fd, (void *)(&info), sizeof(SRecordInfo)) == 0) break;
     if (info.offset < 0) {
-      mfh->size += (info.size + sizeof(SRecordInfo));
-      mfh->tombSize += (info.size + sizeof(SRecordInfo));
       lseek(mfh->fd, info.size, SEEK_CUR);
       mfh->size = mfh->size + sizeof(SRecordInfo) + info.size;
       mfh->tombSize = mfh->tombSize + sizeof(SRecordInfo) + info.size;
@@ -19,6 +19,17 @@
 #include "tscompression.h"
 #include "talgo.h"
 #include "tcoding.h"
+#include "hashfunc.h"
+#include "ttime.h"
+
+// Max gap in bytes between two required column extents to read them at once
+#define TSDB_COL_READ_MERGE_GAP 4096
+
+// A bloom filter is laid out as | numOfHashes (uint8_t) | bits | TSCKSUM |
+#define TSDB_BLOOM_MAX_BITS_PER_ROW 16
+#define TSDB_BLOOM_MIN_BYTES 8
+#define TSDB_BLOOM_MAX_HASHES 16
+#define TSDB_BLOOM_MAX_LEN(rows) (1 + TSDB_BLOOM_MAX_BITS_PER_ROW / 8 * (rows) + TSDB_BLOOM_MIN_BYTES + sizeof(TSCKSUM))
 
 // Local function definitions
 // static int  tsdbCheckHelperCfg(SHelperCfg *pCfg);
@@ -32,6 +43,7 @@ static int tsdbMergeDataWithBlock(SRWHelper *pHelper, int blkIdx, SDataCols *pDa
 static int tsdbInsertSuperBlock(SRWHelper *pHelper, SCompBlock *pCompBlock, int blkIdx);
 static int tsdbAddSubBlock(SRWHelper *pHelper, SCompBlock *pCompBlock, int blkIdx, int rowsAdded);
 static int tsdbUpdateSuperBlock(SRWHelper *pHelper, SCompBlock *pCompBlock, int blkIdx);
+static int tsdbRemoveSuperBlock(SRWHelper *pHelper, int blkIdx);
 static int tsdbGetRowsInRange(SDataCols *pDataCols, TSKEY minKey, TSKEY maxKey);
 static void tsdbResetHelperBlock(SRWHelper *pHelper);
 
@@ -106,6 +118,44 @@ static void tsdbDestroyHelperBlock(SRWHelper *pHelper) {
   tdFreeDataCols(pHelper->pDataCols[1]);
 }
 
+static int compareRollupInterval(const void *arg1, const void *arg2) {
+  int64_t interval1 = *(int64_t *)arg1;
+  int64_t interval2 = *(int64_t *)arg2;
+
+  if (interval1 == interval2) return 0;
+  return (interval1 < interval2) ? -1 : 1;
+}
+
+// Parse the rollup intervals (e.g. "1m,1h") of the configuration, invalid ones are ignored
+static void tsdbInitRollupIntervals(SRWHelper *pHelper, int8_t precision) {
+  char *token = tsRollupInterval;
+
+  pHelper->config.numOfRollups = 0;
+  while (*token != '\0' && pHelper->config.numOfRollups < TSDB_MAX_ROLLUP_TIERS) {
+    char   *end = strchr(token, ',');
+    int32_t len = (end == NULL) ? (int32_t)strlen(token) : (int32_t)(end - token);
+    int64_t interval = 0;
+
+    while (len > 0 && isspace((unsigned char)*token)) {
+      token++;
+      len--;
+    }
+    while (len > 0 && isspace((unsigned char)token[len - 1])) len--;
+
+    if (len > 0 && getTimestampInUsFromStr(token, len, &interval) == TSDB_CODE_SUCCESS) {
+      if (precision == TSDB_TIME_PRECISION_MILLI) interval /= 1000;
+      if (interval > 0) pHelper->config.rollupIntervals[pHelper->config.numOfRollups++] = interval;
+    } else {
+      tsdbWarn("invalid rollup interval %.*s is ignored", len, token);
+    }
+
+    if (end == NULL) break;
+    token = end + 1;
+  }
+
+  qsort(pHelper->config.rollupIntervals, pHelper->config.numOfRollups, sizeof(int64_t), compareRollupInterval);
+}
+
 static int tsdbInitHelper(SRWHelper *pHelper, STsdbRepo *pRepo, tsdb_rw_helper_t type) {
   if (pHelper == NULL || pRepo == NULL) return -1;
 
@@ -120,6 +170,11 @@ static int tsdbInitHelper(SRWHelper *pHelper, STsdbRepo *pRepo, tsdb_rw_helper_t
   pHelper->config.minRowsPerFileBlock = pRepo->config.minRowsPerFileBlock;
   pHelper->config.maxRowsPerFileBlock = pRepo->config.maxRowsPerFileBlock;
   pHelper->config.compress = pRepo->config.compression;
+  pHelper->config.update = pRepo->config.update;
+  pHelper->config.subBlocksToMerge = (int8_t)tsSubBlocksToMerge;
+  pHelper->config.bloomFpp = tsBloomFilterFpp;
+  pHelper->config.codecPolicy = (int8_t)tsCodecPolicy;
+  tsdbInitRollupIntervals(pHelper, pRepo->config.precision);
 
   pHelper->state = TSDB_HELPER_CLEAR_STATE;
 
@@ -132,9 +187,14 @@ static int tsdbInitHelper(SRWHelper *pHelper, STsdbRepo *pRepo, tsdb_rw_helper_t
   // Init block part
   if (tsdbInitHelperBlock(pHelper) < 0) goto _err;
 
+  size_t bloomSize = 0;
+  if (pHelper->config.bloomFpp > 0) {
+    bloomSize = TSDB_BLOOM_MAX_LEN(pHelper->config.maxRowsPerFileBlock) * pHelper->config.maxCols;
+  }
+
   pHelper->pBuffer =
       tmalloc(sizeof(SCompData) + (sizeof(SCompCol) + sizeof(TSCKSUM) + COMP_OVERFLOW_BYTES) * pHelper->config.maxCols +
-              pHelper->config.maxRowSize * pHelper->config.maxRowsPerFileBlock + sizeof(TSCKSUM));
+              pHelper->config.maxRowSize * pHelper->config.maxRowsPerFileBlock + sizeof(TSCKSUM) + bloomSize);
   if (pHelper->pBuffer == NULL) goto _err;
 
   return 0;
@@ -368,6 +428,83 @@ _err:
   return -1;
 }
 
+// The blocks in the new .l file can not be read back by the helper
+static bool tsdbCanLoadBlock(SRWHelper *pHelper, SCompBlock *pCompBlock) {
+  return !pCompBlock->last || pHelper->files.nLastF.fd <= 0 || pHelper->hasOldLastBlock;
+}
+
+/**
+ * Consolidate the fragments of the table set in the helper, which is committed just now. A block with at least
+ * config.subBlocksToMerge sub-blocks is rewritten as one block, and so is a run of adjacent blocks smaller than
+ * minRowsPerFileBlock, as long as the rows of the run fit in a block written by commit. The rows are merged in
+ * pDataCols, which must be empty and set to the schema of the table.
+ *
+ * @return: number of blocks and sub-blocks consolidated
+ *          -1 for failure
+ */
+int tsdbConsolidateBlocks(SRWHelper *pHelper, SDataCols *pDataCols) {
+  ASSERT(TSDB_HELPER_TYPE(pHelper) == TSDB_WRITE_HELPER);
+  ASSERT(pDataCols->numOfRows == 0);
+
+  SCompIdx * pIdx = pHelper->pCompIdx + pHelper->tableInfo.tid;
+  SCompBlock compBlock;
+  int        merged = 0;
+  int        maxRows = pHelper->config.maxRowsPerFileBlock * 4 / 5;
+
+  if (pHelper->config.subBlocksToMerge <= 0 || pIdx->numOfBlocks == 0) return 0;
+  if (tsdbLoadCompInfo(pHelper, NULL) < 0) goto _err;
+
+  for (int blkIdx = 0; blkIdx < pIdx->numOfBlocks; blkIdx++) {
+    if (!tsdbCanLoadBlock(pHelper, blockAtIdx(pHelper, blkIdx))) continue;
+
+    // numOfRows counts the rows with the same key in sub-blocks more than once, so the run never overflows
+    int end = blkIdx;
+    int rows = blockAtIdx(pHelper, blkIdx)->numOfRows;
+    if (rows < pHelper->config.minRowsPerFileBlock) {
+      while (end + 1 < pIdx->numOfBlocks) {
+        SCompBlock *pNext = blockAtIdx(pHelper, end + 1);
+        if (pNext->numOfRows >= pHelper->config.minRowsPerFileBlock || rows + pNext->numOfRows > maxRows ||
+            !tsdbCanLoadBlock(pHelper, pNext))
+          break;
+        rows += pNext->numOfRows;
+        end++;
+      }
+    }
+
+    int fragments = 0;
+    for (int i = blkIdx; i <= end; i++) fragments += blockAtIdx(pHelper, i)->numOfSubBlocks;
+    if (end == blkIdx && fragments < pHelper->config.subBlocksToMerge) continue;
+
+    tdResetDataCols(pDataCols);
+    for (int i = blkIdx; i <= end; i++) {
+      if (tsdbLoadBlockData(pHelper, blockAtIdx(pHelper, i), NULL) < 0) goto _err;
+      if (tdMergeDataCols(pDataCols, pHelper->pDataCols[0], pHelper->pDataCols[0]->numOfRows,
+                          pHelper->config.update) < 0)
+        goto _err;
+    }
+
+    // Only the last block of the table can stay in .last
+    bool   isLast = blockAtIdx(pHelper, end)->last && pDataCols->numOfRows < pHelper->config.minRowsPerFileBlock;
+    SFile *pFile = &(pHelper->files.dataF);
+    if (isLast) pFile = (pHelper->files.nLastF.fd > 0) ? &(pHelper->files.nLastF) : &(pHelper->files.lastF);
+
+    if (tsdbWriteBlockToFile(pHelper, pFile, pDataCols, pDataCols->numOfRows, &compBlock, isLast, true) < 0) goto _err;
+    if (blockAtIdx(pHelper, end)->last) pHelper->hasOldLastBlock = false;
+    if (tsdbUpdateSuperBlock(pHelper, &compBlock, blkIdx) < 0) goto _err;
+    for (int i = blkIdx + 1; i <= end; i++) {
+      if (tsdbRemoveSuperBlock(pHelper, blkIdx + 1) < 0) goto _err;
+    }
+
+    merged += fragments;
+  }
+
+  tdResetDataCols(pDataCols);
+  return merged;
+
+_err:
+  return -1;
+}
+
 int tsdbMoveLastBlockIfNeccessary(SRWHelper *pHelper) {
   ASSERT(TSDB_HELPER_TYPE(pHelper) == TSDB_WRITE_HELPER);
   SCompIdx *pIdx = pHelper->pCompIdx + pHelper->tableInfo.tid;
@@ -543,6 +680,119 @@ int tsdbLoadCompData(SRWHelper *pHelper, SCompBlock *pCompBlock, void *target) {
   return 0;
 }
 
+static bool tsdbBloomSupportType(int8_t type) {
+  return (type >= TSDB_DATA_TYPE_TINYINT && type <= TSDB_DATA_TYPE_BIGINT) || type == TSDB_DATA_TYPE_BINARY ||
+         type == TSDB_DATA_TYPE_NCHAR;
+}
+
+// Set (or test) the bits of a value with double hashing derived from a single hash value
+static bool tsdbBloomApply(uint8_t *bits, int32_t numOfBits, int numOfHashes, const char *val, int32_t len,
+                           bool set) {
+  uint32_t h = MurmurHash3_32(val, len);
+  uint32_t delta = (h >> 17) | (h << 15);
+
+  for (int i = 0; i < numOfHashes; i++) {
+    uint32_t pos = h % numOfBits;
+    if (set) {
+      bits[pos >> 3] |= (uint8_t)(1 << (pos & 0x7));
+    } else if ((bits[pos >> 3] & (1 << (pos & 0x7))) == 0) {
+      return false;
+    }
+    h += delta;
+  }
+
+  return true;
+}
+
+/**
+ * Build the bloom filter of the first rows of a column to target, integer values are added as int64_t.
+ *
+ * @param numOfVals: the (estimated) number of distinct non-NULL values
+ * @return the length of the bloom filter with checksum
+ */
+static int tsdbWriteBloomFilter(SDataCol *pDataCol, int rows, int numOfVals, float fpp, char *target) {
+  int numOfBits = (int)ceil(-numOfVals * log(fpp) / (M_LN2 * M_LN2));
+  numOfBits = MIN(numOfBits, TSDB_BLOOM_MAX_BITS_PER_ROW * rows);
+
+  int     len = MAX(TSDB_BLOOM_MIN_BYTES, (numOfBits + 7) / 8);
+  int     numOfHashes = (int)round((double)len * 8 / numOfVals * M_LN2);
+  uint8_t *bits = (uint8_t *)target + 1;
+
+  numOfHashes = MAX(1, MIN(numOfHashes, TSDB_BLOOM_MAX_HASHES));
+  *(uint8_t *)target = (uint8_t)numOfHashes;
+  memset(bits, 0, len);
+
+  for (int i = 0; i < rows; i++) {
+    int64_t val = 0;
+    if (pDataCol->type == TSDB_DATA_TYPE_BINARY || pDataCol->type == TSDB_DATA_TYPE_NCHAR) {
+      void *ptr = tdGetColDataOfRow(pDataCol, i);
+      if (isNull(ptr, pDataCol->type)) continue;
+      tsdbBloomApply(bits, len * 8, numOfHashes, varDataVal(ptr), varDataLen(ptr), true);
+      continue;
+    }
+
+    void *ptr = POINTER_SHIFT(pDataCol->pData, i * pDataCol->bytes);
+    if (isNull(ptr, pDataCol->type)) continue;
+    switch (pDataCol->type) {
+      case TSDB_DATA_TYPE_TINYINT:
+        val = *(int8_t *)ptr;
+        break;
+      case TSDB_DATA_TYPE_SMALLINT:
+        val = *(int16_t *)ptr;
+        break;
+      case TSDB_DATA_TYPE_INT:
+        val = *(int32_t *)ptr;
+        break;
+      default:
+        val = *(int64_t *)ptr;
+        break;
+    }
+    tsdbBloomApply(bits, len * 8, numOfHashes, (char *)&val, sizeof(val), true);
+  }
+
+  len += 1 + sizeof(TSCKSUM);
+  taosCalcChecksumAppend(0, (uint8_t *)target, len);
+
+  return len;
+}
+
+/**
+ * Check the bloom filter of a column in a block, the SCompData part of the block must be loaded to the helper.
+ * Integer values should be given as int64_t.
+ *
+ * @return false if the column in the block definitely has no such value
+ */
+bool tsdbBloomMayContain(SRWHelper *pHelper, SCompBlock *pCompBlock, int16_t colId, const char *val, int32_t len) {
+  ASSERT(pCompBlock->numOfSubBlocks <= 1);
+  SCompData *pCompData = pHelper->pCompData;
+
+  SCompCol *pCompCol = NULL;
+  for (int i = 0; i < pCompData->numOfCols; i++) {
+    if (pCompData->cols[i].colId == colId) {
+      pCompCol = &(pCompData->cols[i]);
+      break;
+    }
+  }
+
+  // All values of the column are NULL in this block
+  if (pCompCol == NULL) return false;
+  if (pCompCol->bloomLen <= 0) return true;
+
+  int     fd = (pCompBlock->last) ? pHelper->files.lastF.fd : pHelper->files.dataF.fd;
+  int32_t tsize = sizeof(SCompData) + sizeof(SCompCol) * pCompBlock->numOfCols + sizeof(TSCKSUM);
+
+  pHelper->compBuffer = trealloc(pHelper->compBuffer, pCompCol->bloomLen);
+  if (pHelper->compBuffer == NULL) return true;
+
+  uint8_t *pBloom = (uint8_t *)pHelper->compBuffer;
+  if (lseek(fd, pCompBlock->offset + tsize + pCompCol->offset + pCompCol->len, SEEK_SET) < 0) return true;
+  if (tread(fd, (void *)pBloom, pCompCol->bloomLen) < pCompCol->bloomLen) return true;
+  if (!taosCheckChecksumWhole(pBloom, pCompCol->bloomLen)) return true;
+
+  int32_t numOfBits = (pCompCol->bloomLen - 1 - sizeof(TSCKSUM)) * 8;
+  return tsdbBloomApply(pBloom + 1, numOfBits, pBloom[0], val, len, false);
+}
+
 void tsdbGetDataStatis(SRWHelper *pHelper, SDataStatis *pStatis, int numOfCols) {
   SCompData *pCompData = pHelper->pCompData;
 
@@ -571,73 +821,114 @@ void tsdbGetDataStatis(SRWHelper *pHelper, SDataStatis *pStatis, int numOfCols)
   }
 }
 
-static int comparColIdCompCol(const void *arg1, const void *arg2) {
-  return (*(int16_t *)arg1) - ((SCompCol *)arg2)->colId;
-}
-
-static int comparColIdDataCol(const void *arg1, const void *arg2) {
-  return (*(int16_t *)arg1) - ((SDataCol *)arg2)->colId;
+// Start key of the window of the interval which the key falls in
+static FORCE_INLINE TSKEY tsdbRollupWindowStart(TSKEY key, int64_t interval) {
+  return key - ((key % interval) + interval) % interval;
 }
 
-static int tsdbLoadSingleColumnData(int fd, SCompBlock *pCompBlock, SCompCol *pCompCol, void *buf) {
-  size_t tsize = sizeof(SCompData) + sizeof(SCompCol) * pCompBlock->numOfCols;
-  if (lseek(fd, pCompBlock->offset + tsize + pCompCol->offset, SEEK_SET) < 0) return -1;
-  if (tread(fd, buf, pCompCol->len) < pCompCol->len) return -1;
-
-  return 0;
-}
-
-static int tsdbLoadSingleBlockDataCols(SRWHelper *pHelper, SCompBlock *pCompBlock, int16_t *colIds, int numOfColIds,
-                                       SDataCols *pDataCols) {
-  if (tsdbLoadCompData(pHelper, pCompBlock, NULL) < 0) return -1;
-  int fd = (pCompBlock->last) ? pHelper->files.lastF.fd : pHelper->files.dataF.fd;
-
-  void *ptr = NULL;
-  for (int i = 0; i < numOfColIds; i++) {
-    int16_t colId = colIds[i];
-
-    ptr = bsearch((void *)&colId, (void *)pHelper->pCompData->cols, pHelper->pCompData->numOfCols, sizeof(SCompCol), comparColIdCompCol);
-    if (ptr == NULL) continue;
-    SCompCol *pCompCol = (SCompCol *)ptr;
-
-    ptr = bsearch((void *)&colId, (void *)(pDataCols->cols), pDataCols->numOfCols, sizeof(SDataCol), comparColIdDataCol);
-    ASSERT(ptr != NULL);
-    SDataCol *pDataCol = (SDataCol *)ptr;
+/**
+ * Get the statistics of the windows of the coarsest rollup tier the query windows consist of, the SCompData part of
+ * the block must be loaded to the helper.
+ *
+ * @param interval: the interval of the query windows
+ * @param origin: the start key of any query window
+ * @param pStatis: the columns to get, in the ascending order of colId
+ * @return 0 for success, -1 if there is no such a rollup tier in the block
+ */
+int tsdbGetDataRollup(SRWHelper *pHelper, SCompBlock *pCompBlock, int64_t interval, int64_t origin,
+                      SDataStatis *pStatis, int numOfCols, SDataRollup *pRollup) {
+  ASSERT(pCompBlock->numOfSubBlocks <= 1);
+  SCompData *pCompData = pHelper->pCompData;
+  SCompCol  *pLastCol = pCompData->cols + pCompData->numOfCols - 1;
 
-    pDataCol->len = pCompCol->len;
-    if (tsdbLoadSingleColumnData(fd, pCompBlock, pCompCol, pDataCol->pData) < 0) return -1;
+  // The rollup takes the rest of the block after the last column
+  int     fd = (pCompBlock->last) ? pHelper->files.lastF.fd : pHelper->files.dataF.fd;
+  int32_t tsize = sizeof(SCompData) + sizeof(SCompCol) * pCompBlock->numOfCols + sizeof(TSCKSUM);
+  int32_t start = tsize + pLastCol->offset + pLastCol->len + pLastCol->bloomLen;
+  int32_t len = pCompBlock->len - start;
+  if (len <= (int32_t)(sizeof(SRollupHead) + sizeof(TSCKSUM))) return -1;
+
+  pHelper->compBuffer = trealloc(pHelper->compBuffer, len);
+  if (pHelper->compBuffer == NULL) return -1;
+
+  char *pBuf = (char *)pHelper->compBuffer;
+  if (lseek(fd, pCompBlock->offset + start, SEEK_SET) < 0) return -1;
+  if (tread(fd, (void *)pBuf, len) < len) return -1;
+  if (!taosCheckChecksumWhole((uint8_t *)pBuf, len)) {
+    tsdbError("failed to check the checksum of the rollup of block at offset %" PRId64, (int64_t)pCompBlock->offset);
+    return -1;
   }
 
-  return 0;
-}
-
-// Load specific column data from file
-int tsdbLoadBlockDataCols(SRWHelper *pHelper, SDataCols *pDataCols, int blkIdx, int16_t *colIds, int numOfColIds) {
-  SCompBlock *pCompBlock = pHelper->pCompInfo->blocks + blkIdx;
+  SRollupHead *pHead = (SRollupHead *)pBuf;
+  if (pHead->delimiter != TSDB_FILE_DELIMITER || pHead->numOfCols != pCompData->numOfCols) return -1;
 
-  ASSERT(pCompBlock->numOfSubBlocks >= 1); // Must be super block
-
-  int numOfSubBlocks = pCompBlock->numOfSubBlocks;
-  SCompBlock *pStartBlock =
-      (numOfSubBlocks == 1) ? pCompBlock : (SCompBlock *)((char *)pHelper->pCompInfo->blocks + pCompBlock->offset);
-
-  if (tsdbLoadSingleBlockDataCols(pHelper, pStartBlock, colIds, numOfColIds, pDataCols) < 0) return -1;
-  for (int i = 1; i < numOfSubBlocks; i++) {
-    pStartBlock++;
-    if (tsdbLoadSingleBlockDataCols(pHelper, pStartBlock, colIds, numOfColIds, pHelper->pDataCols[1]) < 0) return -1;
-    tdMergeDataCols(pDataCols, pHelper->pDataCols[1], pHelper->pDataCols[1]->numOfRows);
+  SRollupTier *pTier = NULL;
+  char        *ptr = pBuf + sizeof(SRollupHead);
+  for (int i = 0; i < pHead->numOfTiers; i++) {
+    SRollupTier *pCur = (SRollupTier *)ptr;
+    if (interval % pCur->interval == 0 && tsdbRollupWindowStart(origin, pCur->interval) == origin) pTier = pCur;
+    ptr += sizeof(SRollupTier) + (sizeof(SRollupWindow) + sizeof(SRollupCol) * pHead->numOfCols) * pCur->numOfWindows;
+    if (ptr > pBuf + len - sizeof(TSCKSUM)) return -1;
+  }
+  if (pTier == NULL) return -1;
+
+  int32_t numOfWindows = pTier->numOfWindows;
+  void   *skey = realloc(pRollup->skey, sizeof(TSKEY) * numOfWindows);
+  if (skey != NULL) pRollup->skey = skey;
+  void *numOfRows = realloc(pRollup->numOfRows, sizeof(int32_t) * numOfWindows);
+  if (numOfRows != NULL) pRollup->numOfRows = numOfRows;
+  void *statis = realloc(pRollup->statis, sizeof(SDataStatis) * numOfWindows * numOfCols);
+  if (statis != NULL) pRollup->statis = statis;
+  if (skey == NULL || numOfRows == NULL || statis == NULL) return -1;
+
+  SRollupWindow *pWindows = (SRollupWindow *)((char *)pTier + sizeof(SRollupTier));
+  SRollupCol    *pCols = (SRollupCol *)(pWindows + numOfWindows);
+
+  pRollup->interval = pTier->interval;
+  pRollup->numOfWindows = numOfWindows;
+  pRollup->numOfCols = numOfCols;
+  for (int w = 0; w < numOfWindows; w++) {
+    SDataStatis *pWStatis = pRollup->statis + w * numOfCols;
+    SRollupCol  *pWCols = pCols + w * pHead->numOfCols;
+
+    pRollup->skey[w] = pWindows[w].skey;
+    pRollup->numOfRows[w] = pWindows[w].numOfRows;
+
+    for (int i = 0, j = 0; i < numOfCols;) {
+      memset(pWStatis + i, 0, sizeof(SDataStatis));
+      pWStatis[i].colId = pStatis[i].colId;
+
+      if (j >= pCompData->numOfCols || pStatis[i].colId < pCompData->cols[j].colId) {
+        // All values of the column are NULL in this block
+        pWStatis[i].numOfNull = pWindows[w].numOfRows;
+        i++;
+      } else if (pStatis[i].colId == pCompData->cols[j].colId) {
+        pWStatis[i].sum = pWCols[j].sum;
+        pWStatis[i].max = pWCols[j].max;
+        pWStatis[i].min = pWCols[j].min;
+        pWStatis[i].numOfNull = pWCols[j].numOfNull;
+        i++;
+        j++;
+      } else {
+        j++;
+      }
+    }
   }
 
   return 0;
 }
 
-static int tsdbCheckAndDecodeColumnData(SDataCol *pDataCol, char *content, int32_t len, int8_t comp, int numOfRows,
-                                        int maxPoints, char *buffer, int bufferSize) {
+static int tsdbCheckAndDecodeColumnData(SDataCol *pDataCol, char *content, int32_t len, int8_t comp, int8_t codec,
+                                        int numOfRows, int maxPoints, char *buffer, int bufferSize) {
   // Verify by checksum
   if (!taosCheckChecksumWhole((uint8_t *)content, len)) return -1;
 
   // Decode the data
-  if (comp) {
+  if (codec == TSDB_COL_CODEC_RLE) {
+    pDataCol->len = tsDecompressRLEImp(content, numOfRows, pDataCol->bytes, pDataCol->pData);
+  } else if (codec == TSDB_COL_CODEC_DICT) {
+    pDataCol->len = tsDecompressDictImp(content, numOfRows, pDataCol->bytes, pDataCol->pData);
+  } else if (comp && codec == TSDB_COL_CODEC_DEFAULT) {
     // // Need to decompress
     pDataCol->len = (*(tDataTypeDesc[pDataCol->type].decompFunc))(
         content, len - sizeof(TSCKSUM), numOfRows, pDataCol->pData, pDataCol->spaceSize, comp, buffer, bufferSize);
@@ -655,31 +946,103 @@ static int tsdbCheckAndDecodeColumnData(SDataCol *pDataCol, char *content, int32
   return 0;
 }
 
+// Read the column data part [start, end) of a block, which is relative to the end of the SCompData part
+static int tsdbLoadBlockDataPart(int fd, SCompBlock *pCompBlock, SCompData *pCompData, int32_t tsize, int32_t start,
+                                 int32_t end) {
+  if (lseek(fd, pCompBlock->offset + tsize + start, SEEK_SET) < 0) return -1;
+  if (tread(fd, (void *)((char *)pCompData + tsize + start), end - start) < end - start) return -1;
+  return 0;
+}
+
+/**
+ * Read the extents of the required columns only. Extents of columns stored next to each other (or separated by
+ * less than TSDB_COL_READ_MERGE_GAP bytes) are read at once.
+ */
+static int tsdbLoadBlockColsPart(int fd, SCompBlock *pCompBlock, SCompData *pCompData, int32_t tsize, int16_t *colIds,
+                                 int numOfColIds) {
+  int32_t start = -1;
+  int32_t end = -1;
+
+  int ccol = 0;
+  int icol = 0;
+  while (ccol < pCompData->numOfCols && icol < numOfColIds) {
+    SCompCol *pCompCol = &(pCompData->cols[ccol]);
+    if (pCompCol->colId == colIds[icol]) {
+      if (start >= 0 && pCompCol->offset - end > TSDB_COL_READ_MERGE_GAP) {
+        if (tsdbLoadBlockDataPart(fd, pCompBlock, pCompData, tsize, start, end) < 0) return -1;
+        start = -1;
+      }
+      if (start < 0) start = pCompCol->offset;
+      end = pCompCol->offset + pCompCol->len;
+      ccol++;
+      icol++;
+    } else if (pCompCol->colId < colIds[icol]) {
+      ccol++;
+    } else {
+      icol++;
+    }
+  }
+
+  if (start >= 0 && tsdbLoadBlockDataPart(fd, pCompBlock, pCompData, tsize, start, end) < 0) return -1;
+
+  return 0;
+}
+
 /**
  * Interface to read the data of a sub-block OR the data of a super-block of which (numOfSubBlocks == 1)
+ *
+ * If colIds is NULL, the whole block is read and all columns are decoded. Otherwise only the SCompData part and the
+ * columns in colIds (sorted by colId in ascending order) are read and decoded. Other columns are set to NULL if
+ * setNull is true (needed when sub-blocks are merged), or just reset.
  */
-static int tsdbLoadBlockDataImpl(SRWHelper *pHelper, SCompBlock *pCompBlock, SDataCols *pDataCols) {
+static int tsdbLoadBlockDataImpl(SRWHelper *pHelper, SCompBlock *pCompBlock, SDataCols *pDataCols, int16_t *colIds,
+                                 int numOfColIds, bool setNull) {
   ASSERT(pCompBlock->numOfSubBlocks <= 1);
 
-  ASSERT(tsizeof(pHelper->pBuffer) >= pCompBlock->len);
+  // Blocks may carry bloom filters written with another configuration
+  if (tsizeof(pHelper->pBuffer) < pCompBlock->len) {
+    pHelper->pBuffer = trealloc(pHelper->pBuffer, pCompBlock->len);
+    if (pHelper->pBuffer == NULL) goto _err;
+  }
 
   SCompData *pCompData = (SCompData *)pHelper->pBuffer;
+  int32_t    tsize = sizeof(SCompData) + sizeof(SCompCol) * pCompBlock->numOfCols + sizeof(TSCKSUM);
 
   int fd = (pCompBlock->last) ? pHelper->files.lastF.fd : pHelper->files.dataF.fd;
   if (lseek(fd, pCompBlock->offset, SEEK_SET) < 0) goto _err;
-  if (tread(fd, (void *)pCompData, pCompBlock->len) < pCompBlock->len) goto _err;
+  if (colIds == NULL) {
+    if (tread(fd, (void *)pCompData, pCompBlock->len) < pCompBlock->len) goto _err;
+  } else {
+    if (tread(fd, (void *)pCompData, tsize) < tsize) goto _err;
+  }
   ASSERT(pCompData->numOfCols == pCompBlock->numOfCols);
 
-  int32_t tsize = sizeof(SCompData) + sizeof(SCompCol) * pCompBlock->numOfCols + sizeof(TSCKSUM);
   if (!taosCheckChecksumWhole((uint8_t *)pCompData, tsize)) goto _err;
 
+  if (colIds != NULL && tsdbLoadBlockColsPart(fd, pCompBlock, pCompData, tsize, colIds, numOfColIds) < 0) goto _err;
+
   pDataCols->numOfRows = pCompBlock->numOfRows;
 
   // Recover the data
   int ccol = 0;
   int dcol = 0;
+  int icol = 0;
   while (dcol < pDataCols->numOfCols) {
     SDataCol *pDataCol = &(pDataCols->cols[dcol]);
+    if (colIds != NULL) {
+      while (icol < numOfColIds && colIds[icol] < pDataCol->colId) icol++;
+      if (icol >= numOfColIds || colIds[icol] != pDataCol->colId) {
+        // Column not required, it is not loaded from file
+        if (setNull) {
+          dataColSetNEleNull(pDataCol, pCompBlock->numOfRows, pDataCols->maxPoints);
+        } else {
+          dataColReset(pDataCol);
+        }
+        dcol++;
+        continue;
+      }
+    }
+
     if (ccol >= pCompData->numOfCols) {
       // Set current column as NULL and forward
       dataColSetNEleNull(pDataCol, pCompBlock->numOfRows, pDataCols->maxPoints);
@@ -690,7 +1053,7 @@ static int tsdbLoadBlockDataImpl(SRWHelper *pHelper, SCompBlock *pCompBlock, SDa
     SCompCol *pCompCol = &(pCompData->cols[ccol]);
 
     if (pCompCol->colId == pDataCol->colId) {
-      if (pCompBlock->algorithm == TWO_STAGE_COMP) {
+      if (IS_TWO_STAGE_COMP(pCompBlock->algorithm)) {
         int zsize = pDataCol->bytes * pCompBlock->numOfRows + COMP_OVERFLOW_BYTES;
         if (pCompCol->type == TSDB_DATA_TYPE_BINARY || pCompCol->type == TSDB_DATA_TYPE_NCHAR) {
           zsize += (sizeof(VarDataLenT) * pCompBlock->numOfRows);
@@ -699,8 +1062,8 @@ static int tsdbLoadBlockDataImpl(SRWHelper *pHelper, SCompBlock *pCompBlock, SDa
         if (pHelper->compBuffer == NULL) goto _err;
       }
       if (tsdbCheckAndDecodeColumnData(pDataCol, (char *)pCompData + tsize + pCompCol->offset, pCompCol->len,
-                                       pCompBlock->algorithm, pCompBlock->numOfRows, pDataCols->maxPoints,
-                                       pHelper->compBuffer, tsizeof(pHelper->compBuffer)) < 0)
+                                       pCompBlock->algorithm, pCompCol->codec, pCompBlock->numOfRows,
+                                       pDataCols->maxPoints, pHelper->compBuffer, tsizeof(pHelper->compBuffer)) < 0)
         goto _err;
       dcol++;
       ccol++;
@@ -719,30 +1082,57 @@ _err:
   return -1;
 }
 
-// Load the whole block data
-int tsdbLoadBlockData(SRWHelper *pHelper, SCompBlock *pCompBlock, SDataCols *target) {
-  // SCompBlock *pCompBlock = pHelper->pCompInfo->blocks + blkIdx;
-
+static int tsdbLoadBlockDataWithCols(SRWHelper *pHelper, SCompInfo *pCompInfo, SCompBlock *pCompBlock,
+                                     int16_t *colIds, int numOfColIds) {
   int numOfSubBlock = pCompBlock->numOfSubBlocks;
-  if (numOfSubBlock > 1) pCompBlock = (SCompBlock *)((char *)pHelper->pCompInfo + pCompBlock->offset);
+  if (numOfSubBlock > 1) pCompBlock = (SCompBlock *)((char *)pCompInfo + pCompBlock->offset);
+
+  // Columns not loaded must be valid for merge if there are sub-blocks
+  bool setNull = (numOfSubBlock > 1);
 
   tdResetDataCols(pHelper->pDataCols[0]);
-  if (tsdbLoadBlockDataImpl(pHelper, pCompBlock, pHelper->pDataCols[0]) < 0) goto _err;
+  if (tsdbLoadBlockDataImpl(pHelper, pCompBlock, pHelper->pDataCols[0], colIds, numOfColIds, setNull) < 0) goto _err;
   for (int i = 1; i < numOfSubBlock; i++) {
     tdResetDataCols(pHelper->pDataCols[1]);
     pCompBlock++;
-    if (tsdbLoadBlockDataImpl(pHelper, pCompBlock, pHelper->pDataCols[1]) < 0) goto _err;
-    if (tdMergeDataCols(pHelper->pDataCols[0], pHelper->pDataCols[1], pHelper->pDataCols[1]->numOfRows) < 0) goto _err;
+    if (tsdbLoadBlockDataImpl(pHelper, pCompBlock, pHelper->pDataCols[1], colIds, numOfColIds, setNull) < 0) goto _err;
+    if (tdMergeDataCols(pHelper->pDataCols[0], pHelper->pDataCols[1], pHelper->pDataCols[1]->numOfRows,
+                        pHelper->config.update) < 0)
+      goto _err;
   }
 
-  // if (target) TODO
-
   return 0;
 
 _err:
   return -1;
 }
 
+/**
+ * Load specific columns of a block from file to pHelper->pDataCols[0]
+ *
+ * @param pCompInfo: the SCompInfo the pCompBlock belongs to, sub-block offsets are relative to it. If NULL, the
+ *                   SCompInfo loaded in the helper is used.
+ * @param colIds:    column ids to load, must be sorted in ascending order
+ */
+int tsdbLoadBlockDataCols(SRWHelper *pHelper, SCompInfo *pCompInfo, SCompBlock *pCompBlock, int16_t *colIds,
+                          int numOfColIds) {
+  ASSERT(colIds != NULL && numOfColIds > 0);
+  if (pCompInfo == NULL) pCompInfo = pHelper->pCompInfo;
+
+  return tsdbLoadBlockDataWithCols(pHelper, pCompInfo, pCompBlock, colIds, numOfColIds);
+}
+
+// Load the whole block data
+int tsdbLoadBlockData(SRWHelper *pHelper, SCompBlock *pCompBlock, SDataCols *target) {
+  // SCompBlock *pCompBlock = pHelper->pCompInfo->blocks + blkIdx;
+
+  if (tsdbLoadBlockDataWithCols(pHelper, pHelper->pCompInfo, pCompBlock, NULL, 0) < 0) return -1;
+
+  // if (target) TODO
+
+  return 0;
+}
+
 static bool tsdbShouldCreateNewLast(SRWHelper *pHelper) {
   ASSERT(pHelper->files.lastF.fd > 0);
   struct stat st;
@@ -751,6 +1141,177 @@ static bool tsdbShouldCreateNewLast(SRWHelper *pHelper) {
   return false;
 }
 
+static bool tsdbCodecSupportType(int8_t type) {
+  return type != TSDB_DATA_TYPE_BINARY && type != TSDB_DATA_TYPE_NCHAR && type != TSDB_DATA_TYPE_NULL;
+}
+
+/**
+ * Try the other codecs on a column block already encoded by the default codec in tptr, and replace the data with the
+ * output of the codec scoring best by the codec policy. Only outputs no longer than the raw data are taken, so tptr
+ * always has enough space. Return the codec chosen.
+ *
+ * Score of a codec is its output size weighted by a static decode cost, as the cost of decoding is what a query pays
+ * for each block it reads. Decode costs are relative to a memcpy of the raw data.
+ */
+static int tsdbChooseColumnCodec(SRWHelper *pHelper, SDataCol *pDataCol, int rows, int32_t tlen, void *tptr,
+                                 int16_t *len) {
+  static const double codecDecodeCost[] = {0, 0, 0.1, 0.2};  // indexed by TSDB_COL_CODEC_*
+
+  double weight = (pHelper->config.codecPolicy == TSDB_CODEC_POLICY_BALANCED) ? 1.0 : 0.0;
+  double defaultCost = 0;
+  if (pHelper->config.compress == ONE_STAGE_COMP) {
+    defaultCost = 0.5;
+  } else if (pHelper->config.compress == TWO_STAGE_COMP) {
+    defaultCost = 1.0;
+  } else if (pHelper->config.compress == TWO_STAGE_COMP_ZSTD) {
+    defaultCost = 1.5;
+  }
+
+  int     codec = TSDB_COL_CODEC_DEFAULT;
+  int32_t codecLen = *len;
+  double  score = codecLen * (1 + weight * defaultCost);
+
+  int32_t bufSize = MAX(rows * (int32_t)(sizeof(uint16_t) + pDataCol->bytes),
+                        (int32_t)sizeof(uint16_t) + 256 * pDataCol->bytes + rows);
+  if (tsizeof(pHelper->compBuffer) < bufSize) {
+    pHelper->compBuffer = trealloc(pHelper->compBuffer, bufSize);
+    if (pHelper->compBuffer == NULL) return -1;
+  }
+
+  for (int tcodec = TSDB_COL_CODEC_RAW; tcodec <= TSDB_COL_CODEC_DICT; tcodec++) {
+    int32_t clen = 0;
+    switch (tcodec) {
+      case TSDB_COL_CODEC_RAW:
+        clen = tlen;
+        break;
+      case TSDB_COL_CODEC_RLE:
+        clen = tsCompressRLEImp(pDataCol->pData, rows, pDataCol->bytes, pHelper->compBuffer);
+        break;
+      default:
+        clen = tsCompressDictImp(pDataCol->pData, rows, pDataCol->bytes, pHelper->compBuffer);
+        break;
+    }
+    if (clen < 0 || clen > tlen) continue;
+
+    double tscore = clen * (1 + weight * codecDecodeCost[tcodec]);
+    if (tscore < score) {
+      score = tscore;
+      codec = tcodec;
+      codecLen = clen;
+      memcpy(tptr, (tcodec == TSDB_COL_CODEC_RAW) ? pDataCol->pData : pHelper->compBuffer, clen);
+    }
+  }
+
+  *len = (int16_t)codecLen;
+  return codec;
+}
+
+// Get the statistics of the columns of SCompData in the rows of a window
+static void tsdbRollupWindowColumns(SDataCols *pDataCols, SCompData *pCompData, int start, int rows,
+                                    SRollupCol *pCols) {
+  TSKEY *keys = (TSKEY *)(pDataCols->cols[0].pData);
+
+  for (int ncol = 0, tcol = 0; ncol < pDataCols->numOfCols && tcol < pCompData->numOfCols; ncol++) {
+    SDataCol   *pDataCol = pDataCols->cols + ncol;
+    SRollupCol *pCol = pCols + tcol;
+    if (pDataCol->colId != pCompData->cols[tcol].colId) continue;
+
+    memset(pCol, 0, sizeof(*pCol));
+    if (ncol == 0) {
+      pCol->min = keys[start];
+      pCol->max = keys[start + rows - 1];
+    } else if (pDataCol->type != TSDB_DATA_TYPE_BINARY && pDataCol->type != TSDB_DATA_TYPE_NCHAR &&
+               tDataTypeDesc[pDataCol->type].getStatisFunc) {
+      int16_t minIndex = 0, maxIndex = 0;
+      (*tDataTypeDesc[pDataCol->type].getStatisFunc)(keys + start,
+                                                     POINTER_SHIFT(pDataCol->pData, start * pDataCol->bytes), rows,
+                                                     &(pCol->min), &(pCol->max), &(pCol->sum), &minIndex, &maxIndex,
+                                                     &(pCol->numOfNull));
+    } else {
+      for (int i = start; i < start + rows; i++) {
+        if (isNull(tdGetColDataOfRow(pDataCol, i), pDataCol->type)) pCol->numOfNull++;
+      }
+    }
+    tcol++;
+  }
+}
+
+/**
+ * Build the rollup of the first rows of the block right after the column data, which ends at lsize of pBuffer.
+ * pHelper->pBuffer may be reallocated.
+ *
+ * @return the length of the rollup with checksum, 0 if no tier is kept and -1 for failure
+ */
+static int tsdbWriteRollup(SRWHelper *pHelper, SDataCols *pDataCols, int rows, int32_t lsize) {
+  SCompData *pCompData = (SCompData *)(pHelper->pBuffer);
+  TSKEY     *keys = (TSKEY *)(pDataCols->cols[0].pData);
+  int32_t    numOfWindows[TSDB_MAX_ROLLUP_TIERS] = {0};
+  int        numOfTiers = 0;
+  int32_t    len = sizeof(SRollupHead) + sizeof(TSCKSUM);
+
+  for (int i = 0; i < pHelper->config.numOfRollups; i++) {
+    int64_t interval = pHelper->config.rollupIntervals[i];
+    int32_t nw = 1;
+    for (int j = 1; j < rows; j++) {
+      if (tsdbRollupWindowStart(keys[j], interval) != tsdbRollupWindowStart(keys[j - 1], interval)) nw++;
+    }
+
+    // Too few rows in a window to be worth it
+    if (nw > rows / TSDB_ROLLUP_MIN_ROWS_PER_WINDOW) continue;
+
+    numOfWindows[i] = nw;
+    numOfTiers++;
+    len += sizeof(SRollupTier) + (sizeof(SRollupWindow) + sizeof(SRollupCol) * pCompData->numOfCols) * nw;
+  }
+
+  if (numOfTiers == 0) return 0;
+
+  if (tsizeof(pHelper->pBuffer) < lsize + len) {
+    pHelper->pBuffer = trealloc(pHelper->pBuffer, lsize + len);
+    if (pHelper->pBuffer == NULL) return -1;
+    pCompData = (SCompData *)(pHelper->pBuffer);
+  }
+
+  SRollupHead *pHead = (SRollupHead *)((char *)pCompData + lsize);
+  char        *ptr = (char *)pHead + sizeof(SRollupHead);
+
+  pHead->delimiter = TSDB_FILE_DELIMITER;
+  pHead->numOfTiers = numOfTiers;
+  pHead->numOfCols = pCompData->numOfCols;
+
+  for (int i = 0; i < pHelper->config.numOfRollups; i++) {
+    if (numOfWindows[i] == 0) continue;
+
+    int64_t        interval = pHelper->config.rollupIntervals[i];
+    SRollupTier   *pTier = (SRollupTier *)ptr;
+    SRollupWindow *pWindows = (SRollupWindow *)(ptr + sizeof(SRollupTier));
+    SRollupCol    *pCols = (SRollupCol *)(pWindows + numOfWindows[i]);
+
+    pTier->interval = interval;
+    pTier->numOfWindows = numOfWindows[i];
+    pTier->padding = 0;
+
+    for (int j = 1, start = 0, w = 0; j <= rows; j++) {
+      TSKEY skey = tsdbRollupWindowStart(keys[start], interval);
+      if (j < rows && tsdbRollupWindowStart(keys[j], interval) == skey) continue;
+
+      pWindows[w].skey = skey;
+      pWindows[w].numOfRows = j - start;
+      pWindows[w].padding = 0;
+      tsdbRollupWindowColumns(pDataCols, pCompData, start, j - start, pCols + w * pCompData->numOfCols);
+
+      start = j;
+      w++;
+    }
+
+    ptr = (char *)(pCols + numOfWindows[i] * pCompData->numOfCols);
+  }
+
+  taosCalcChecksumAppend(0, (uint8_t *)pHead, len);
+
+  return len;
+}
+
 static int tsdbWriteBlockToFile(SRWHelper *pHelper, SFile *pFile, SDataCols *pDataCols, int rowsToWrite, SCompBlock *pCompBlock,
                                 bool isLast, bool isSuperBlock) {
   ASSERT(rowsToWrite > 0 && rowsToWrite <= pDataCols->numOfRows &&
@@ -805,7 +1366,7 @@ static int tsdbWriteBlockToFile(SRWHelper *pHelper, SFile *pFile, SDataCols *pDa
     int32_t tlen = dataColGetNEleLen(pDataCol, rowsToWrite);
 
     if (pHelper->config.compress) {
-      if (pHelper->config.compress == TWO_STAGE_COMP) {
+      if (IS_TWO_STAGE_COMP(pHelper->config.compress)) {
         pHelper->compBuffer = trealloc(pHelper->compBuffer, tlen + COMP_OVERFLOW_BYTES);
         if (pHelper->compBuffer == NULL) goto _err;
       }
@@ -818,12 +1379,33 @@ static int tsdbWriteBlockToFile(SRWHelper *pHelper, SFile *pFile, SDataCols *pDa
       memcpy(tptr, pDataCol->pData, pCompCol->len);
     }
 
+    if (pHelper->config.codecPolicy != TSDB_CODEC_POLICY_FIXED && ncol != 0 &&
+        tsdbCodecSupportType(pDataCol->type)) {
+      int codec = tsdbChooseColumnCodec(pHelper, pDataCol, rowsToWrite, tlen, tptr, &(pCompCol->len));
+      if (codec < 0) goto _err;
+      pCompCol->codec = codec;
+    }
+
     // Add checksum
     pCompCol->len += sizeof(TSCKSUM);
     taosCalcChecksumAppend(0, (uint8_t *)tptr, pCompCol->len);
 
-    toffset += pCompCol->len;
-    lsize += pCompCol->len;
+    // The bloom filter is kept right after the column data
+    if (pHelper->config.bloomFpp > 0 && ncol != 0 && tsdbBloomSupportType(pDataCol->type)) {
+      int numOfVals = rowsToWrite - pCompCol->numOfNull;
+      if (pDataCol->type == TSDB_DATA_TYPE_BINARY || pDataCol->type == TSDB_DATA_TYPE_NCHAR) {
+        // sum of binary/nchar column is the estimated number of distinct values
+        numOfVals = (int)MIN((int64_t)numOfVals, pCompCol->sum);
+      }
+
+      if (numOfVals > 0) {
+        pCompCol->bloomLen = tsdbWriteBloomFilter(pDataCol, rowsToWrite, numOfVals, pHelper->config.bloomFpp,
+                                                  (char *)tptr + pCompCol->len);
+      }
+    }
+
+    toffset += pCompCol->len + pCompCol->bloomLen;
+    lsize += pCompCol->len + pCompCol->bloomLen;
     tcol++;
   }
 
@@ -831,6 +1413,14 @@ static int tsdbWriteBlockToFile(SRWHelper *pHelper, SFile *pFile, SDataCols *pDa
   pCompData->uid = pHelper->tableInfo.uid;
   pCompData->numOfCols = nColsNotAllNull;
 
+  // The rollup is kept at the end of the block
+  if (pHelper->config.numOfRollups > 0) {
+    int rlen = tsdbWriteRollup(pHelper, pDataCols, rowsToWrite, lsize);
+    if (rlen < 0) goto _err;
+    pCompData = (SCompData *)(pHelper->pBuffer);
+    lsize += rlen;
+  }
+
   taosCalcChecksumAppend(0, (uint8_t *)pCompData, tsize);
 
   // Write the whole block to file
@@ -894,7 +1484,7 @@ static int tsdbMergeDataWithBlock(SRWHelper *pHelper, int blkIdx, SDataCols *pDa
 
     rowsWritten = MIN((defaultRowsToWrite - blockAtIdx(pHelper, blkIdx)->numOfRows), pDataCols->numOfRows);
     if ((blockAtIdx(pHelper, blkIdx)->numOfSubBlocks < TSDB_MAX_SUBBLOCKS) &&
-        (blockAtIdx(pHelper, blkIdx)->numOfRows + rowsWritten < pHelper->config.minRowsPerFileBlock) && (pHelper->files.nLastF.fd) > 0) {
+        (blockAtIdx(pHelper, blkIdx)->numOfRows + rowsWritten < pHelper->config.minRowsPerFileBlock) && (pHelper->files.nLastF.fd) < 0) {
       if (tsdbWriteBlockToFile(pHelper, &(pHelper->files.lastF), pDataCols, rowsWritten, &compBlock, true, false) < 0)
         goto _err;
       if (tsdbAddSubBlock(pHelper, &compBlock, blkIdx, rowsWritten) < 0) goto _err;
@@ -903,7 +1493,7 @@ static int tsdbMergeDataWithBlock(SRWHelper *pHelper, int blkIdx, SDataCols *pDa
       if (tsdbLoadBlockData(pHelper, blockAtIdx(pHelper, blkIdx), NULL) < 0) goto _err;
       ASSERT(pHelper->pDataCols[0]->numOfRows == blockAtIdx(pHelper, blkIdx)->numOfRows);
       // Merge
-      if (tdMergeDataCols(pHelper->pDataCols[0], pDataCols, rowsWritten) < 0) goto _err;
+      if (tdMergeDataCols(pHelper->pDataCols[0], pDataCols, rowsWritten, pHelper->config.update) < 0) goto _err;
       // Write
       SFile *pWFile = NULL;
       bool isLast = false;
@@ -937,7 +1527,9 @@ static int tsdbMergeDataWithBlock(SRWHelper *pHelper, int blkIdx, SDataCols *pDa
 
     ASSERT(rows3 >= rows1);
 
-    if ((rows2 >= rows1) &&
+    // in the update mode, a row with the key of a row in the block replaces it, so the rows are merged with the
+    // block rather than added as a sub-block counted in its rows
+    if ((rows2 >= rows1) && !pHelper->config.update &&
         (( blockAtIdx(pHelper, blkIdx)->last) ||
          ((rows1 + blockAtIdx(pHelper, blkIdx)->numOfRows < pHelper->config.minRowsPerFileBlock) && (pHelper->files.nLastF.fd < 0)))) {
       rowsWritten = rows1;
@@ -966,7 +1558,8 @@ static int tsdbMergeDataWithBlock(SRWHelper *pHelper, int blkIdx, SDataCols *pDa
       // tdResetDataCols(pHelper->pDataCols[1]);
       while (true) {
         if (iter1 >= pHelper->pDataCols[0]->numOfRows && iter2 >= rows3) break;
-        tdMergeTwoDataCols(pHelper->pDataCols[1], pHelper->pDataCols[0], &iter1, pDataCols, &iter2, pHelper->config.maxRowsPerFileBlock * 4 / 5);
+        tdMergeTwoDataCols(pHelper->pDataCols[1], pHelper->pDataCols[0], &iter1, pDataCols, &iter2,
+                           pHelper->config.maxRowsPerFileBlock * 4 / 5, pHelper->config.update);
         ASSERT(pHelper->pDataCols[1]->numOfRows > 0);
         if (tsdbWriteBlockToFile(pHelper, &(pHelper->files.dataF), pHelper->pDataCols[1],
                                  pHelper->pDataCols[1]->numOfRows, &compBlock, false, true) < 0)
@@ -1217,6 +1810,61 @@ static int tsdbUpdateSuperBlock(SRWHelper *pHelper, SCompBlock *pCompBlock, int
   return 0;
 }
 
+static int tsdbRemoveSuperBlock(SRWHelper *pHelper, int blkIdx) {
+  SCompIdx *pIdx = pHelper->pCompIdx + pHelper->tableInfo.tid;
+
+  ASSERT(blkIdx >= 0 && blkIdx < pIdx->numOfBlocks);
+
+  SCompBlock *pSCompBlock = pHelper->pCompInfo->blocks + blkIdx;
+  int         numOfSubBlocks = pSCompBlock->numOfSubBlocks;
+
+  ASSERT(numOfSubBlocks >= 1);
+
+  // Delete the sub blocks it has
+  if (numOfSubBlocks > 1) {
+    size_t tsize = pIdx->len - (pSCompBlock->offset + pSCompBlock->len);
+    if (tsize > 0) {
+      memmove((void *)((char *)(pHelper->pCompInfo) + pSCompBlock->offset),
+              (void *)((char *)(pHelper->pCompInfo) + pSCompBlock->offset + pSCompBlock->len), tsize);
+    }
+
+    for (int i = blkIdx + 1; i < pIdx->numOfBlocks; i++) {
+      SCompBlock *pTCompBlock = &pHelper->pCompInfo->blocks[i];
+      if (pTCompBlock->numOfSubBlocks > 1) pTCompBlock->offset -= (sizeof(SCompBlock) * numOfSubBlocks);
+    }
+
+    pIdx->len -= (sizeof(SCompBlock) * numOfSubBlocks);
+  }
+
+  // Delete the super block, the sub-blocks of the others move ahead with it
+  size_t tsize = pIdx->len - (sizeof(SCompInfo) + sizeof(SCompBlock) * (blkIdx + 1));
+  memmove((void *)(pHelper->pCompInfo->blocks + blkIdx), (void *)(pHelper->pCompInfo->blocks + blkIdx + 1), tsize);
+
+  pIdx->numOfBlocks--;
+  pIdx->len -= sizeof(SCompBlock);
+  for (int i = 0; i < pIdx->numOfBlocks; i++) {
+    SCompBlock *pTCompBlock = &pHelper->pCompInfo->blocks[i];
+    if (pTCompBlock->numOfSubBlocks > 1) pTCompBlock->offset -= sizeof(SCompBlock);
+  }
+
+  ASSERT(pIdx->numOfBlocks > 0);
+  pIdx->maxKey = pHelper->pCompInfo->blocks[pIdx->numOfBlocks - 1].keyLast;
+  pIdx->hasLast = pHelper->pCompInfo->blocks[pIdx->numOfBlocks - 1].last;
+
+  return 0;
+}
+
+void tsdbCountBlocks(SRWHelper *pHelper, STsdbStat *pStat) {
+  SCompIdx *pIdx = pHelper->pCompIdx + pHelper->tableInfo.tid;
+
+  for (int i = 0; i < pIdx->numOfBlocks; i++) {
+    SCompBlock *pCompBlock = blockAtIdx(pHelper, i);
+    pStat->numOfBlocks++;
+    if (pCompBlock->numOfSubBlocks > 1) pStat->numOfSubBlocks += pCompBlock->numOfSubBlocks;
+    if (pCompBlock->last) pStat->numOfLastBlocks++;
+  }
+}
+
 // Get the number of rows in range [minKey, maxKey]
 static int tsdbGetRowsInRange(SDataCols *pDataCols, TSKEY minKey, TSKEY maxKey) {
   if (pDataCols->numOfRows == 0) return 0;
@@ -19,9 +19,9 @@
 #include "tutil.h"
 #include "tcompare.h"
 #include "exception.h"
+#include "tmergetree.h"
 
 #include "../../../query/inc/qast.h"  // todo move to common module
-#include "../../../query/inc/tlosertree.h"  // todo move to util module
 #include "tsdb.h"
 #include "tsdbMain.h"
 
@@ -97,6 +97,7 @@ typedef struct STsdbQueryHandle {
   STimeWindow    window;           // the primary query time window that applies to all queries
   SCompBlock*    pBlock;
   SDataStatis*   statis;           // query level statistics, only one table block statistics info exists at any time
+  SDataRollup    rollup;           // pre-aggregated windows of current data block
   int32_t        numOfBlocks;
   SArray*        pColumns;         // column list, SColumnInfoData array list
   bool           locateStart;
@@ -114,6 +115,14 @@ typedef struct STsdbQueryHandle {
   
   SDataBlockLoadInfo dataBlockLoadInfo; /* record current block load information */
   SLoadCompBlockInfo compBlockLoadInfo; /* record current compblock information in SQuery */
+
+  int32_t        bloomChecks;      // number of bloom filter checks, for debug purpose
+  int32_t        bloomSkips;       // number of bloom filter checks that the value is absent
+
+  bool           sharedScan;       // attached to the shared scan of the repository during the file stage
+  int64_t        fileGeneration;   // generation of the files opened, -1 if they may be rewritten by a commit
+  int32_t        numOfBlocksRead;  // number of data blocks read from file, for debug purpose
+  int32_t        numOfBlocksShared; // number of data blocks copied from the ones loaded by other queries
 } STsdbQueryHandle;
 
 static void changeQueryHandleForLastrowQuery(TsdbQueryHandleT pqHandle);
@@ -373,7 +382,15 @@ static int32_t getFileCompInfo(STsdbQueryHandle* pQueryHandle, int32_t* numOfBlo
   SFileGroup* fileGroup = pQueryHandle->pFileGroup;
   
   assert(fileGroup->files[TSDB_FILE_TYPE_HEAD].fname > 0);
+
+  // the blocks are shared only if no commit starts or ends while the files are opened
+  int64_t generation = tsdbGetSharedScanGeneration(pQueryHandle->pTsdb);
   tsdbSetAndOpenHelperFile(&pQueryHandle->rhelper, fileGroup);
+  if (tsdbGetSharedScanGeneration(pQueryHandle->pTsdb) == generation && generation % 2 == 0) {
+    pQueryHandle->fileGeneration = generation;
+  } else {
+    pQueryHandle->fileGeneration = -1;
+  }
 
   // load all the comp offset value for all tables in this file
   *numOfBlocks = 0;
@@ -478,12 +495,19 @@ static int32_t binarySearchForKey(char* pValue, int num, TSKEY key, int order);
 static int tsdbReadRowsFromCache(SSkipListIterator* pIter, STable* pTable, TSKEY maxKey, int maxRowsToRead, TSKEY* skey, TSKEY* ekey,
                                  STsdbQueryHandle* pQueryHandle);
 
+static int32_t colIdComparFn(const void* p1, const void* p2) {
+  int16_t left = *(int16_t*)p1;
+  int16_t right = *(int16_t*)p2;
+
+  if (left == right) {
+    return 0;
+  }
+
+  return (left < right)? -1:1;
+}
+
 static bool doLoadFileDataBlock(STsdbQueryHandle* pQueryHandle, SCompBlock* pBlock, STableCheckInfo* pCheckInfo) {
   STsdbRepo *pRepo = pQueryHandle->pTsdb;
-  SCompData* data = calloc(1, sizeof(SCompData) + sizeof(SCompCol) * pBlock->numOfCols);
-
-  data->numOfCols = pBlock->numOfCols;
-  data->uid = pCheckInfo->pTableObj->tableId.uid;
 
   bool    blockLoaded = false;
   SArray* sa = getDefaultLoadColumns(pQueryHandle, true);
@@ -493,21 +517,52 @@ static bool doLoadFileDataBlock(STsdbQueryHandle* pQueryHandle, SCompBlock* pBlo
     pCheckInfo->pDataCols = tdNewDataCols(pMeta->maxRowBytes, pMeta->maxCols, pRepo->config.maxRowsPerFileBlock);
   }
 
-  tdInitDataCols(pCheckInfo->pDataCols, tsdbGetTableSchema(tsdbGetMeta(pQueryHandle->pTsdb), pCheckInfo->pTableObj));
+  STSchema* pSchema = tsdbGetTableSchema(tsdbGetMeta(pQueryHandle->pTsdb), pCheckInfo->pTableObj);
+  tdInitDataCols(pCheckInfo->pDataCols, pSchema);
+  tdInitDataCols(pQueryHandle->rhelper.pDataCols[0], pSchema);
+  tdInitDataCols(pQueryHandle->rhelper.pDataCols[1], pSchema);
+
+  // only the required columns are read from file and decompressed, the column id list must be in ascending order
+  taosArraySort(sa, colIdComparFn);
+
+  int16_t* colIds = (int16_t*) sa->pData;
+  int32_t  numOfColIds = (int32_t) taosArrayGetSize(sa);
+
+  SSharedBlockKey key;
+  memset(&key, 0, sizeof(key));
+  key.uid = pCheckInfo->tableId.uid;
+  key.generation = pQueryHandle->sharedScan ? pQueryHandle->fileGeneration : -1;
+  key.offset = pBlock->offset;
+  key.fid = pQueryHandle->pFileGroup->fileId;
+  key.numOfRows = pBlock->numOfRows;
+  key.last = (int8_t) pBlock->last;
+  key.numOfSubBlocks = (int8_t) pBlock->numOfSubBlocks;
+
+  SDataCols* pDataCols = pQueryHandle->rhelper.pDataCols[0];
+  tdResetDataCols(pDataCols);
+
+  if (tsdbLoadSharedBlock(pRepo, &key, colIds, numOfColIds, pDataCols)) {
+    atomic_add_fetch_64(&pRepo->stat.numOfBlocksShared, 1);
+    pQueryHandle->numOfBlocksShared++;
+    blockLoaded = true;
+  } else if (tsdbLoadBlockDataCols(&(pQueryHandle->rhelper), pCheckInfo->pCompInfo, pBlock, colIds, numOfColIds) == 0) {
+    atomic_add_fetch_64(&pRepo->stat.numOfBlocksRead, 1);
+    atomic_add_fetch_64(&pRepo->stat.numOfFragmentsRead, pBlock->numOfSubBlocks);
+    pQueryHandle->numOfBlocksRead++;
+
+    tsdbPublishSharedBlock(pRepo, &key, colIds, numOfColIds, pDataCols);
+    blockLoaded = true;
+  }
 
-  if (tsdbLoadBlockData(&(pQueryHandle->rhelper), pBlock, NULL) == 0) {
+  if (blockLoaded) {
     SDataBlockLoadInfo* pBlockLoadInfo = &pQueryHandle->dataBlockLoadInfo;
 
     pBlockLoadInfo->fileGroup = pQueryHandle->pFileGroup;
     pBlockLoadInfo->slot = pQueryHandle->cur.slot;
     pBlockLoadInfo->tid = pCheckInfo->pTableObj->tableId.tid;
-
-    blockLoaded = true;
   }
 
   taosArrayDestroy(sa);
-  tfree(data);
-
   return blockLoaded;
 }
 
@@ -516,6 +571,7 @@ static void handleDataMergeIfNeeded(STsdbQueryHandle* pQueryHandle, SCompBlock*
   SDataBlockInfo binfo = getTrueDataBlockInfo(pCheckInfo, pBlock);
   /*bool hasData = */ initTableMemIterator(pQueryHandle, pCheckInfo);
   
+  // the cached row with the same key of the first row in block is dropped, unless it replaces the row in block
   TSKEY k1 = TSKEY_INITIAL_VAL, k2 = TSKEY_INITIAL_VAL;
   if (pCheckInfo->iter != NULL && tSkipListIterGet(pCheckInfo->iter) != NULL) {
     SSkipListNode* node = tSkipListIterGet(pCheckInfo->iter);
@@ -523,7 +579,7 @@ static void handleDataMergeIfNeeded(STsdbQueryHandle* pQueryHandle, SCompBlock*
     SDataRow row = SL_GET_NODE_DATA(node);
     k1 = dataRowKey(row);
     
-    if (k1 == binfo.window.skey) {
+    if (k1 == binfo.window.skey && !pQueryHandle->rhelper.config.update) {
       if (tSkipListIterNext(pCheckInfo->iter)) {
         node = tSkipListIterGet(pCheckInfo->iter);
         row = SL_GET_NODE_DATA(node);
@@ -540,7 +596,7 @@ static void handleDataMergeIfNeeded(STsdbQueryHandle* pQueryHandle, SCompBlock*
     SDataRow row = SL_GET_NODE_DATA(node);
     k2 = dataRowKey(row);
     
-    if (k2 == binfo.window.skey) {
+    if (k2 == binfo.window.skey && !pQueryHandle->rhelper.config.update) {
       if (tSkipListIterNext(pCheckInfo->iiter)) {
         node = tSkipListIterGet(pCheckInfo->iiter);
         row = SL_GET_NODE_DATA(node);
@@ -895,6 +951,20 @@ static void doMergeTwoLevelData(STsdbQueryHandle* pQueryHandle, STableCheckInfo*
         cur->mixBlock = true;
 
         tSkipListIterNext(pCheckInfo->iter);
+      } else if (key == tsArray[pos] && pQueryHandle->rhelper.config.update) {
+        // data in buffer has the same timestamp of data in file block, and replaces it
+        copyOneRowFromMem(pQueryHandle, pCheckInfo, pQueryHandle->outputCapacity, numOfRows, row, pSchema);
+        numOfRows += 1;
+        if (cur->win.skey == TSKEY_INITIAL_VAL) {
+          cur->win.skey = key;
+        }
+
+        cur->win.ekey = key;
+        cur->lastKey  = key + step;
+        cur->mixBlock = true;
+
+        tSkipListIterNext(pCheckInfo->iter);
+        pos += step;
       } else if (key == tsArray[pos]) {  // data in buffer has the same timestamp of data in file block, ignore it
         tSkipListIterNext(pCheckInfo->iter);
       } else if ((key > tsArray[pos] && ASCENDING_TRAVERSE(pQueryHandle->order)) ||
@@ -905,8 +975,13 @@ static void doMergeTwoLevelData(STsdbQueryHandle* pQueryHandle, STableCheckInfo*
 
         int32_t order = ASCENDING_TRAVERSE(pQueryHandle->order) ? TSDB_ORDER_DESC : TSDB_ORDER_ASC;
         int32_t end = vnodeBinarySearchKey(pCols->cols[0].pData, pCols->numOfRows, key, order);
-        if (tsArray[end] == key) { // the value of key in cache equals to the end timestamp value, ignore it
-          tSkipListIterNext(pCheckInfo->iter);
+        if (tsArray[end] == key) {
+          if (pQueryHandle->rhelper.config.update) {
+            // leave the row of the same key in file to the cached one
+            end -= step;
+          } else {  // the value of key in cache equals to the end timestamp value, ignore it
+            tSkipListIterNext(pCheckInfo->iter);
+          }
         }
         
         int32_t start = -1;
@@ -1072,36 +1147,6 @@ static void cleanBlockOrderSupporter(SBlockOrderSupporter* pSupporter, int32_t n
   tfree(pSupporter->pDataBlockInfo);
 }
 
-static int32_t dataBlockOrderCompar(const void* pLeft, const void* pRight, void* param) {
-  int32_t leftTableIndex = *(int32_t*)pLeft;
-  int32_t rightTableIndex = *(int32_t*)pRight;
-
-  SBlockOrderSupporter* pSupporter = (SBlockOrderSupporter*)param;
-
-  int32_t leftTableBlockIndex = pSupporter->blockIndexArray[leftTableIndex];
-  int32_t rightTableBlockIndex = pSupporter->blockIndexArray[rightTableIndex];
-
-  if (leftTableBlockIndex > pSupporter->numOfBlocksPerTable[leftTableIndex]) {
-    /* left block is empty */
-    return 1;
-  } else if (rightTableBlockIndex > pSupporter->numOfBlocksPerTable[rightTableIndex]) {
-    /* right block is empty */
-    return -1;
-  }
-
-  STableBlockInfo* pLeftBlockInfoEx = &pSupporter->pDataBlockInfo[leftTableIndex][leftTableBlockIndex];
-  STableBlockInfo* pRightBlockInfoEx = &pSupporter->pDataBlockInfo[rightTableIndex][rightTableBlockIndex];
-
-  //    assert(pLeftBlockInfoEx->compBlock->offset != pRightBlockInfoEx->compBlock->offset);
-  if (pLeftBlockInfoEx->compBlock->offset == pRightBlockInfoEx->compBlock->offset &&
-      pLeftBlockInfoEx->compBlock->last == pRightBlockInfoEx->compBlock->last) {
-    // todo add more information
-    uError("error in header file, two block with same offset:%p", pLeftBlockInfoEx->compBlock->offset);
-  }
-
-  return pLeftBlockInfoEx->compBlock->offset > pRightBlockInfoEx->compBlock->offset ? 1 : -1;
-}
-
 static int32_t createDataBlocksInfo(STsdbQueryHandle* pQueryHandle, int32_t numOfBlocks, int32_t* numOfAllocBlocks) {
   char* tmp = realloc(pQueryHandle->pDataBlockInfo, sizeof(STableBlockInfo) * numOfBlocks);
   if (tmp == NULL) {
@@ -1162,29 +1207,45 @@ static int32_t createDataBlocksInfo(STsdbQueryHandle* pQueryHandle, int32_t numO
 
   assert(cnt <= numOfBlocks && numOfQualTables <= numOfTables);  // the pTableQueryInfo[j]->numOfBlocks may be 0
   sup.numOfTables = numOfQualTables;
-  SLoserTreeInfo* pTree = NULL;
+  if (numOfQualTables == 0) {
+    cleanBlockOrderSupporter(&sup, numOfTables);
+    return TSDB_CODE_SUCCESS;
+  }
 
-  uint8_t ret = tLoserTreeCreate(&pTree, sup.numOfTables, &sup, dataBlockOrderCompar);
-  if (ret != TSDB_CODE_SUCCESS) {
+  // the blocks of all tables are ordered by the offset in file, and the blocks of each table are already in order
+  SMergeTree* pTree = tMergeTreeCreate(sup.numOfTables);
+  if (pTree == NULL) {
     cleanBlockOrderSupporter(&sup, numOfTables);
     return TSDB_CODE_SERV_OUT_OF_MEMORY;
   }
 
+  for (int32_t i = 0; i < sup.numOfTables; ++i) {
+    tMergeTreeSetKey(pTree, i, MERGE_TREE_KEY(sup.pDataBlockInfo[i][0].compBlock->offset, TSDB_ORDER_ASC));
+  }
+
+  tMergeTreeBuild(pTree);
+
   int32_t numOfTotal = 0;
 
   while (numOfTotal < cnt) {
-    int32_t pos = pTree->pNode[0].index;
-    int32_t index = sup.blockIndexArray[pos]++;
+    int32_t pos = pTree->winner;
+    assert(pos >= 0);
 
     STableBlockInfo* pBlocksInfo = sup.pDataBlockInfo[pos];
-    pQueryHandle->pDataBlockInfo[numOfTotal++] = pBlocksInfo[index];
+    int32_t          index = sup.blockIndexArray[pos];
 
-    // set data block index overflow, in order to disable the offset comparator
-    if (sup.blockIndexArray[pos] >= sup.numOfBlocksPerTable[pos]) {
-      sup.blockIndexArray[pos] = sup.numOfBlocksPerTable[pos] + 1;
-    }
+    // all the following blocks of this table before the head block of any other table are taken at once
+    do {
+      pQueryHandle->pDataBlockInfo[numOfTotal++] = pBlocksInfo[index++];
+    } while (index < sup.numOfBlocksPerTable[pos] &&
+             tMergeTreeBeforeBound(pTree, MERGE_TREE_KEY(pBlocksInfo[index].compBlock->offset, TSDB_ORDER_ASC)));
 
-    tLoserTreeAdjust(pTree, pos + sup.numOfTables);
+    sup.blockIndexArray[pos] = index;
+    if (index >= sup.numOfBlocksPerTable[pos]) {
+      tMergeTreeExhaust(pTree);
+    } else {
+      tMergeTreeAdvance(pTree, MERGE_TREE_KEY(pBlocksInfo[index].compBlock->offset, TSDB_ORDER_ASC));
+    }
   }
 
   /*
@@ -1201,6 +1262,28 @@ static int32_t createDataBlocksInfo(STsdbQueryHandle* pQueryHandle, int32_t numO
   return TSDB_CODE_SUCCESS;
 }
 
+/*
+ * Check the in-memory summary of the file group, the files are opened only if the group overlaps the query time
+ * window and any of the queried tables has data blocks in it.
+ */
+static bool fileGroupHasQueriedData(STsdbQueryHandle* pQueryHandle, SFileGroup* pGroup) {
+  TSKEY skey = MIN(pQueryHandle->window.skey, pQueryHandle->window.ekey);
+  TSKEY ekey = MAX(pQueryHandle->window.skey, pQueryHandle->window.ekey);
+  if (pGroup->keyFirst > ekey || pGroup->keyLast < skey) {
+    return false;
+  }
+
+  size_t numOfTables = taosArrayGetSize(pQueryHandle->pTableCheckInfo);
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    STableCheckInfo* pCheckInfo = taosArrayGet(pQueryHandle->pTableCheckInfo, i);
+    if (tsdbFGroupHasTable(pGroup, pCheckInfo->tableId.tid)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 // todo opt for only one table case
 static bool getDataBlocksInFilesImpl(STsdbQueryHandle* pQueryHandle) {
   pQueryHandle->numOfBlocks = 0;
@@ -1209,7 +1292,22 @@ static bool getDataBlocksInFilesImpl(STsdbQueryHandle* pQueryHandle) {
   int32_t numOfBlocks = 0;
   int32_t numOfTables = taosArrayGetSize(pQueryHandle->pTableCheckInfo);
   
+  // file groups are sorted by time, no group beyond the one of the end key of query window has data to return
+  STsdbCfg* pCfg = &pQueryHandle->pTsdb->config;
+  int64_t   lastFid = tsdbGetKeyFileId(pQueryHandle->window.ekey, pCfg->daysPerFile, pCfg->precision);
+
   while ((pQueryHandle->pFileGroup = tsdbGetFileGroupNext(&pQueryHandle->fileIter)) != NULL) {
+    if ((ASCENDING_TRAVERSE(pQueryHandle->order) && pQueryHandle->pFileGroup->fileId > lastFid) ||
+        (!ASCENDING_TRAVERSE(pQueryHandle->order) && pQueryHandle->pFileGroup->fileId < lastFid)) {
+      pQueryHandle->pFileGroup = NULL;
+      break;
+    }
+
+    if (!fileGroupHasQueriedData(pQueryHandle, pQueryHandle->pFileGroup)) {
+      uTrace("%p no queried data in file, skip it, fid:%d", pQueryHandle, pQueryHandle->pFileGroup->fileId);
+      continue;
+    }
+
     int32_t type = ASCENDING_TRAVERSE(pQueryHandle->order)? QUERY_RANGE_GREATER_EQUAL:QUERY_RANGE_LESS_EQUAL;
     if (getFileCompInfo(pQueryHandle, &numOfBlocks, type) != TSDB_CODE_SUCCESS) {
       break;
@@ -1256,6 +1354,9 @@ static bool getDataBlocksInFiles(STsdbQueryHandle* pQueryHandle) {
   // find the start data block in file
   if (!pQueryHandle->locateStart) {
     pQueryHandle->locateStart = true;
+    pQueryHandle->sharedScan = true;
+    tsdbAttachSharedScan(pQueryHandle->pTsdb);
+
     int32_t fid = getFileIdFromKey(pQueryHandle->window.skey, pQueryHandle->pTsdb->config.daysPerFile);
     
     tsdbInitFileGroupIter(pFileHandle, &pQueryHandle->fileIter, pQueryHandle->order);
@@ -1320,6 +1421,11 @@ bool tsdbNextDataBlock(TsdbQueryHandleT* pqHandle) {
   
     pQueryHandle->activeIndex = 0;
     pQueryHandle->checkFiles  = false;
+
+    if (pQueryHandle->sharedScan) {
+      pQueryHandle->sharedScan = false;
+      tsdbDetachSharedScan(pQueryHandle->pTsdb);
+    }
   }
   
   // TODO: opt by using lastKeyOnFile
@@ -1520,6 +1626,58 @@ SDataBlockInfo tsdbRetrieveDataBlockInfo(TsdbQueryHandleT* pQueryHandle) {
   }
 }
 
+bool tsdbBlockMayContainValue(TsdbQueryHandleT* pQueryHandle, int16_t colId, const char* val, int32_t len) {
+  STsdbQueryHandle* pHandle = (STsdbQueryHandle*) pQueryHandle;
+
+  SQueryFilePos* cur = &pHandle->cur;
+  if (cur->mixBlock) {
+    return true;
+  }
+
+  STableBlockInfo* pBlockInfo = &pHandle->pDataBlockInfo[cur->slot];
+  if (pBlockInfo->compBlock->numOfSubBlocks > 1) {
+    return true;
+  }
+
+  if (tsdbLoadCompData(&pHandle->rhelper, pBlockInfo->compBlock, NULL) < 0) {
+    return true;
+  }
+
+  pHandle->bloomChecks++;
+  if (tsdbBloomMayContain(&pHandle->rhelper, pBlockInfo->compBlock, colId, val, len)) {
+    return true;
+  }
+
+  pHandle->bloomSkips++;
+  return false;
+}
+
+SDataRollup* tsdbRetrieveDataBlockRollup(TsdbQueryHandleT* pQueryHandle, int64_t interval, int64_t origin) {
+  STsdbQueryHandle* pHandle = (STsdbQueryHandle*) pQueryHandle;
+
+  SQueryFilePos* cur = &pHandle->cur;
+  if (cur->mixBlock || cur->slot < 0 || cur->slot >= pHandle->numOfBlocks) {
+    return NULL;
+  }
+
+  STableBlockInfo* pBlockInfo = &pHandle->pDataBlockInfo[cur->slot];
+  if (pBlockInfo->compBlock->numOfSubBlocks > 1) {
+    return NULL;
+  }
+
+  if (tsdbLoadCompData(&pHandle->rhelper, pBlockInfo->compBlock, NULL) < 0) {
+    return NULL;
+  }
+
+  size_t numOfCols = QH_GET_NUM_OF_COLS(pHandle);
+  if (tsdbGetDataRollup(&pHandle->rhelper, pBlockInfo->compBlock, interval, origin, pHandle->statis, numOfCols,
+                        &pHandle->rollup) < 0) {
+    return NULL;
+  }
+
+  return &pHandle->rollup;
+}
+
 /*
  * return null for mixed data block, if not a complete file data block, the statistics value will always return NULL
  */
@@ -1536,6 +1694,13 @@ int32_t tsdbRetrieveDataBlockStatisInfo(TsdbQueryHandleT* pQueryHandle, SDataSta
       ((cur->slot == pHandle->numOfBlocks) && (cur->slot == 0)));
   
   STableBlockInfo* pBlockInfo = &pHandle->pDataBlockInfo[cur->slot];
+
+  // the statistics of a block with sub-blocks only cover the first sub-block, they can not be used
+  if (pBlockInfo->compBlock->numOfSubBlocks > 1) {
+    *pBlockStatis = NULL;
+    return TSDB_CODE_SUCCESS;
+  }
+
   tsdbLoadCompData(&pHandle->rhelper, pBlockInfo->compBlock, NULL);
   
   size_t numOfCols = QH_GET_NUM_OF_COLS(pHandle);
@@ -2008,6 +2173,20 @@ void tsdbCleanupQueryHandle(TsdbQueryHandleT queryHandle) {
   if (pQueryHandle == NULL) {
     return;
   }
+
+  if (pQueryHandle->bloomChecks > 0) {
+    uTrace("%p bloom filter checks:%d, value absent:%d", pQueryHandle, pQueryHandle->bloomChecks,
+           pQueryHandle->bloomSkips);
+  }
+
+  if (pQueryHandle->sharedScan) {
+    tsdbDetachSharedScan(pQueryHandle->pTsdb);
+  }
+
+  if (pQueryHandle->numOfBlocksRead > 0 || pQueryHandle->numOfBlocksShared > 0) {
+    uTrace("%p data blocks read:%d, shared:%d", pQueryHandle, pQueryHandle->numOfBlocksRead,
+           pQueryHandle->numOfBlocksShared);
+  }
   
   size_t size = taosArrayGetSize(pQueryHandle->pTableCheckInfo);
   for (int32_t i = 0; i < size; ++i) {
@@ -2033,6 +2212,9 @@ void tsdbCleanupQueryHandle(TsdbQueryHandleT queryHandle) {
   taosArrayDestroy(pQueryHandle->pColumns);
   tfree(pQueryHandle->pDataBlockInfo);
   tfree(pQueryHandle->statis);
+  tfree(pQueryHandle->rollup.skey);
+  tfree(pQueryHandle->rollup.numOfRows);
+  tfree(pQueryHandle->rollup.statis);
   
   tsdbDestroyHelper(&pQueryHandle->rhelper);
   
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "os.h"
+#include "tsdbMain.h"
+
+static void tsdbFreeSharedBlock(SSharedBlock *pBlock) {
+  tfree(pBlock->cols);
+  memset(pBlock, 0, sizeof(SSharedBlock));
+}
+
+static void tsdbFreeSharedBlocks(STsdbSharedScan *pShared) {
+  for (int i = 0; i < pShared->capacity; i++) {
+    if (pShared->blocks[i].cols != NULL) tsdbFreeSharedBlock(pShared->blocks + i);
+  }
+
+  pShared->next = 0;
+}
+
+static bool tsdbSharedBlockKeyEqual(SSharedBlockKey *pKey1, SSharedBlockKey *pKey2) {
+  return pKey1->uid == pKey2->uid && pKey1->offset == pKey2->offset && pKey1->fid == pKey2->fid &&
+         pKey1->generation == pKey2->generation && pKey1->numOfRows == pKey2->numOfRows &&
+         pKey1->last == pKey2->last && pKey1->numOfSubBlocks == pKey2->numOfSubBlocks;
+}
+
+// both the column id list and the columns of the block are in ascending order of id
+static bool tsdbColIdsCovered(int16_t *colIds, int numOfColIds, SSharedBlock *pBlock) {
+  int j = 0;
+  for (int i = 0; i < numOfColIds; i++) {
+    while (j < pBlock->numOfCols && pBlock->cols[j].colId < colIds[i]) j++;
+    if (j >= pBlock->numOfCols || pBlock->cols[j].colId != colIds[i]) return false;
+  }
+
+  return true;
+}
+
+static SDataCol *tsdbGetDataColById(SDataCol *cols, int numOfCols, int16_t colId) {
+  for (int i = 0; i < numOfCols; i++) {
+    if (cols[i].colId == colId) return cols + i;
+  }
+
+  return NULL;
+}
+
+static bool tsdbIsVarDataCol(SDataCol *pCol) {
+  return pCol->type == TSDB_DATA_TYPE_BINARY || pCol->type == TSDB_DATA_TYPE_NCHAR;
+}
+
+// the columns are matched by id, as the schema of the scan may be newer than the one of the scan loading the block
+static bool tsdbCopySharedBlock(SSharedBlock *pBlock, int16_t *colIds, int numOfColIds, SDataCols *target) {
+  for (int i = 0; i < numOfColIds; i++) {
+    SDataCol *pSrc = tsdbGetDataColById(pBlock->cols, pBlock->numOfCols, colIds[i]);
+    SDataCol *pDst = tsdbGetDataColById(target->cols, target->numOfCols, colIds[i]);
+    if (pSrc == NULL || pDst == NULL || pSrc->type != pDst->type || pSrc->bytes != pDst->bytes) return false;
+
+    pDst->len = pSrc->len;
+    memcpy(pDst->pData, pSrc->pData, pSrc->len);
+    if (tsdbIsVarDataCol(pSrc)) memcpy(pDst->dataOff, pSrc->dataOff, sizeof(VarDataOffsetT) * pBlock->numOfRows);
+  }
+
+  target->numOfRows = pBlock->numOfRows;
+  return true;
+}
+
+/*
+ * Keep the columns loaded of a block in one buffer, sized by the rows of the block rather than the max rows of the
+ * SDataCols, so the memory of the ring is bounded by the blocks actually read.
+ */
+static bool tsdbDupSharedBlock(SSharedBlock *pBlock, int16_t *colIds, int numOfColIds, SDataCols *pDataCols) {
+  size_t size = sizeof(SDataCol) * numOfColIds;
+  for (int i = 0; i < numOfColIds; i++) {
+    SDataCol *pCol = tsdbGetDataColById(pDataCols->cols, pDataCols->numOfCols, colIds[i]);
+    if (pCol == NULL) return false;
+
+    size += pCol->len;
+    if (tsdbIsVarDataCol(pCol)) size += sizeof(VarDataOffsetT) * pDataCols->numOfRows;
+  }
+
+  pBlock->cols = (SDataCol *)malloc(size);
+  if (pBlock->cols == NULL) return false;
+
+  void *pBuf = POINTER_SHIFT(pBlock->cols, sizeof(SDataCol) * numOfColIds);
+  for (int i = 0; i < numOfColIds; i++) {
+    SDataCol *pSrc = tsdbGetDataColById(pDataCols->cols, pDataCols->numOfCols, colIds[i]);
+    SDataCol *pDst = pBlock->cols + i;
+
+    *pDst = *pSrc;
+    pDst->spaceSize = pSrc->len;
+    pDst->dataOff = NULL;
+    if (tsdbIsVarDataCol(pSrc)) {
+      pDst->dataOff = (VarDataOffsetT *)pBuf;
+      memcpy(pDst->dataOff, pSrc->dataOff, sizeof(VarDataOffsetT) * pDataCols->numOfRows);
+      pBuf = POINTER_SHIFT(pBuf, sizeof(VarDataOffsetT) * pDataCols->numOfRows);
+    }
+
+    pDst->pData = pBuf;
+    memcpy(pDst->pData, pSrc->pData, pSrc->len);
+    pBuf = POINTER_SHIFT(pBuf, pSrc->len);
+  }
+
+  pBlock->numOfRows = pDataCols->numOfRows;
+  pBlock->numOfCols = numOfColIds;
+  return true;
+}
+
+int tsdbInitSharedScan(STsdbRepo *pRepo) {
+  STsdbSharedScan *pShared = &pRepo->sharedScan;
+
+  memset(pShared, 0, sizeof(STsdbSharedScan));
+  pthread_mutex_init(&pShared->mutex, NULL);
+
+  if (tsSharedScanBlocks > 0) {
+    pShared->blocks = (SSharedBlock *)calloc(tsSharedScanBlocks, sizeof(SSharedBlock));
+    if (pShared->blocks == NULL) return -1;
+    pShared->capacity = tsSharedScanBlocks;
+  }
+
+  return 0;
+}
+
+void tsdbDestroySharedScan(STsdbRepo *pRepo) {
+  STsdbSharedScan *pShared = &pRepo->sharedScan;
+
+  tsdbFreeSharedBlocks(pShared);
+  tfree(pShared->blocks);
+  pShared->capacity = 0;
+
+  pthread_mutex_destroy(&pShared->mutex);
+}
+
+void tsdbAttachSharedScan(STsdbRepo *pRepo) {
+  STsdbSharedScan *pShared = &pRepo->sharedScan;
+
+  pthread_mutex_lock(&pShared->mutex);
+  pShared->numOfScans++;
+  pthread_mutex_unlock(&pShared->mutex);
+}
+
+// the blocks are released once no scan is attached
+void tsdbDetachSharedScan(STsdbRepo *pRepo) {
+  STsdbSharedScan *pShared = &pRepo->sharedScan;
+
+  pthread_mutex_lock(&pShared->mutex);
+  ASSERT(pShared->numOfScans > 0);
+  if (--pShared->numOfScans == 0) tsdbFreeSharedBlocks(pShared);
+  pthread_mutex_unlock(&pShared->mutex);
+}
+
+/*
+ * Called at the start and the end of a commit, which may rewrite the files. The blocks of the files opened before are
+ * not shared with the scans opening them after, and no block of the files opened during the commit is shared.
+ */
+void tsdbInvalidateSharedScan(STsdbRepo *pRepo) {
+  STsdbSharedScan *pShared = &pRepo->sharedScan;
+
+  pthread_mutex_lock(&pShared->mutex);
+  pShared->generation++;
+  tsdbFreeSharedBlocks(pShared);
+  pthread_mutex_unlock(&pShared->mutex);
+}
+
+int64_t tsdbGetSharedScanGeneration(STsdbRepo *pRepo) {
+  STsdbSharedScan *pShared = &pRepo->sharedScan;
+
+  pthread_mutex_lock(&pShared->mutex);
+  int64_t generation = pShared->generation;
+  pthread_mutex_unlock(&pShared->mutex);
+
+  return generation;
+}
+
+/**
+ * Copy the columns of a block loaded by another scan to target, which is initialized by the schema of the table.
+ *
+ * @return true if the block is found with all the columns required
+ */
+bool tsdbLoadSharedBlock(STsdbRepo *pRepo, SSharedBlockKey *pKey, int16_t *colIds, int numOfColIds,
+                         SDataCols *target) {
+  STsdbSharedScan *pShared = &pRepo->sharedScan;
+  if (pShared->capacity == 0 || pKey->generation < 0) return false;
+
+  bool found = false;
+
+  pthread_mutex_lock(&pShared->mutex);
+  if (pShared->numOfScans > 1) {
+    for (int i = 0; i < pShared->capacity; i++) {
+      SSharedBlock *pBlock = pShared->blocks + i;
+      if (pBlock->cols == NULL || !tsdbSharedBlockKeyEqual(&pBlock->key, pKey)) continue;
+
+      if (tsdbColIdsCovered(colIds, numOfColIds, pBlock)) {
+        found = tsdbCopySharedBlock(pBlock, colIds, numOfColIds, target);
+      }
+      break;
+    }
+  }
+  pthread_mutex_unlock(&pShared->mutex);
+
+  return found;
+}
+
+// keep a block just loaded for the other attached scans, which replaces the oldest one in the ring
+void tsdbPublishSharedBlock(STsdbRepo *pRepo, SSharedBlockKey *pKey, int16_t *colIds, int numOfColIds,
+                            SDataCols *pDataCols) {
+  STsdbSharedScan *pShared = &pRepo->sharedScan;
+  if (pShared->capacity == 0 || pKey->generation < 0) return;
+
+  pthread_mutex_lock(&pShared->mutex);
+  if (pShared->numOfScans <= 1 || pKey->generation != pShared->generation) {
+    pthread_mutex_unlock(&pShared->mutex);
+    return;
+  }
+
+  SSharedBlock *pBlock = NULL;
+  for (int i = 0; i < pShared->capacity; i++) {
+    if (pShared->blocks[i].cols != NULL && tsdbSharedBlockKeyEqual(&pShared->blocks[i].key, pKey)) {
+      pBlock = pShared->blocks + i;  // loaded with other columns by another scan
+      break;
+    }
+  }
+
+  if (pBlock == NULL) {
+    pBlock = pShared->blocks + pShared->next;
+    pShared->next = (pShared->next + 1) % pShared->capacity;
+  }
+
+  if (pBlock->cols != NULL) tsdbFreeSharedBlock(pBlock);
+
+  if (tsdbDupSharedBlock(pBlock, colIds, numOfColIds, pDataCols)) {
+    pBlock->key = *pKey;
+  } else {
+    tsdbFreeSharedBlock(pBlock);
+  }
+
+  pthread_mutex_unlock(&pShared->mutex);
+}
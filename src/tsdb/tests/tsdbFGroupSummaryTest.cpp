@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "taos.h"
+#include "tdataformat.h"
+#include "tglobal.h"
+#include "tsdb.h"
+#include "tsdbMain.h"
+#include "ttime.h"
+#include "tutil.h"
+
+namespace {
+const uint64_t TABLE_UID = 987607499877700L;
+const int32_t  MAX_TABLES = 10;
+const int64_t  MS_PER_DAY = 86400 * 1000L;
+
+const SColumnInfo allCols[] = {{0, TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t)},
+                               {1, TSDB_DATA_TYPE_INT, sizeof(int32_t)}};
+
+int32_t numOfCommits = 0;
+
+int notifyStatus(void* appH, int status) {
+  if (status == TSDB_STATUS_COMMIT_OVER) atomic_add_fetch_32(&numOfCommits, 1);
+  return 0;
+}
+
+STSchema* createSchema() {
+  STSchema* pSchema = tdNewSchema(tListLen(allCols));
+  for (int32_t i = 0; i < tListLen(allCols); ++i) {
+    tdSchemaAddCol(pSchema, allCols[i].type, allCols[i].colId, allCols[i].bytes);
+  }
+
+  return pSchema;
+}
+
+// the keys inserted into each table, the value of c1 is the key in minutes
+std::map<int32_t, std::vector<TSKEY> > tableKeys;
+
+// insert numOfRows rows of one minute interval from startTime into the table
+void insertRows(TsdbRepoT* pRepo, STSchema* pSchema, int32_t tid, TSKEY startTime, int32_t numOfRows) {
+  size_t      size = sizeof(SSubmitMsg) + sizeof(SSubmitBlk) + dataRowMaxBytesFromSchema(pSchema) * numOfRows;
+  SSubmitMsg* pMsg = (SSubmitMsg*)calloc(1, size);
+
+  SSubmitBlk* pBlock = pMsg->blocks;
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    SDataRow row = (SDataRow)(pBlock->data + pBlock->len);
+    tdInitDataRow(row, pSchema);
+
+    TSKEY   key = startTime + i * 60000L;
+    int32_t c1 = (int32_t)(key / 60000L);
+    void*   vals[] = {&key, &c1};
+    for (int32_t j = 0; j < schemaNCols(pSchema); ++j) {
+      STColumn* pCol = schemaColAt(pSchema, j);
+      tdAppendColVal(row, vals[j], pCol->type, pCol->bytes, pCol->offset);
+    }
+
+    pBlock->len += dataRowLen(row);
+    tableKeys[tid].push_back(key);
+  }
+
+  pMsg->length = htonl(sizeof(SSubmitMsg) + sizeof(SSubmitBlk) + pBlock->len);
+  pMsg->numOfBlocks = htonl(1);
+  pBlock->uid = htobe64(TABLE_UID + tid);
+  pBlock->tid = htonl(tid);
+  pBlock->sversion = htonl(0);
+  pBlock->numOfRows = htons(numOfRows);
+  pBlock->len = htonl(pBlock->len);
+
+  SShellSubmitRspMsg rsp = {0};
+  ASSERT_EQ(tsdbInsertData(pRepo, pMsg, &rsp), TSDB_CODE_SUCCESS);
+  free(pMsg);
+}
+
+void commit(TsdbRepoT* pRepo) {
+  int32_t commits = numOfCommits;
+  ASSERT_EQ(tsdbTriggerCommit(pRepo), 0);
+  for (int32_t i = 0; i < 1000 && atomic_load_32(&numOfCommits) == commits; ++i) {
+    taosMsleep(10);
+  }
+  ASSERT_EQ(numOfCommits, commits + 1);
+}
+
+// the keys of the rows of the table read by a query in [skey, ekey], the blocks are returned in the order of the query
+std::vector<TSKEY> scan(TsdbRepoT* pRepo, int32_t tid, TSKEY skey, TSKEY ekey, int32_t order) {
+  SColumnInfo    cols[] = {allCols[0], allCols[1]};
+  STsdbQueryCond cond = {{skey, ekey}, order, tListLen(cols), cols};
+  if (order == TSDB_ORDER_DESC) {
+    std::swap(cond.twindow.skey, cond.twindow.ekey);
+  }
+
+  STableId id = {TABLE_UID + tid, tid};
+  SArray*  group = (SArray*)taosArrayInit(1, sizeof(STableId));
+  taosArrayPush(group, &id);
+  STableGroupInfo groupInfo = {1, (SArray*)taosArrayInit(1, POINTER_BYTES)};
+  taosArrayPush(groupInfo.pGroupList, &group);
+
+  TsdbQueryHandleT*  pHandle = tsdbQueryTables(pRepo, &cond, &groupInfo);
+  std::vector<TSKEY> keys;
+  STimeWindow        prev = {0};
+  while (tsdbNextDataBlock(pHandle)) {
+    SDataBlockInfo info = tsdbRetrieveDataBlockInfo(pHandle);
+    SArray*        pCols = tsdbRetrieveDataBlock(pHandle, NULL);
+    if (!keys.empty()) {
+      EXPECT_TRUE(order == TSDB_ORDER_ASC ? info.window.skey > prev.ekey : info.window.ekey < prev.skey);
+    }
+    prev = info.window;
+
+    SColumnInfoData* pKeys = (SColumnInfoData*)taosArrayGet(pCols, 0);
+    SColumnInfoData* pVals = (SColumnInfoData*)taosArrayGet(pCols, 1);
+    for (int32_t i = 0; i < info.rows; ++i) {
+      TSKEY key = ((TSKEY*)pKeys->pData)[i];
+      EXPECT_EQ(((int32_t*)pVals->pData)[i], (int32_t)(key / 60000L));
+
+      // the rows of a block out of the window are filtered by the query executor
+      if (key >= skey && key <= ekey) keys.push_back(key);
+    }
+  }
+
+  tsdbCleanupQueryHandle(pHandle);
+  taosArrayDestroy(group);
+  taosArrayDestroy(groupInfo.pGroupList);
+
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+std::vector<TSKEY> expectedKeys(int32_t tid, TSKEY skey, TSKEY ekey) {
+  std::vector<TSKEY> keys;
+  for (size_t i = 0; i < tableKeys[tid].size(); ++i) {
+    if (tableKeys[tid][i] >= skey && tableKeys[tid][i] <= ekey) keys.push_back(tableKeys[tid][i]);
+  }
+
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+// every table queried in windows within, across and between the file groups, in both orders, gets all its rows
+void checkQueries(TsdbRepoT* pRepo, TSKEY startTime, int32_t numOfDays) {
+  std::vector<std::pair<TSKEY, TSKEY> > windows = {
+      {0, INT64_MAX},
+      {startTime + MS_PER_DAY, startTime + 2 * MS_PER_DAY - 1},
+      {startTime + 3600000L + 50 * 60000L, startTime + MS_PER_DAY + 3600000L + 30 * 60000L},
+      {startTime + 2 * MS_PER_DAY + 3600000L, startTime + numOfDays * MS_PER_DAY},
+      {startTime + 3 * 3600000L, startTime + 4 * 3600000L},
+      {startTime + 10 * 3600000L, startTime + MS_PER_DAY + 3600000L}};
+
+  int32_t orders[] = {TSDB_ORDER_ASC, TSDB_ORDER_DESC};
+  for (int32_t tid = 1; tid <= 3; ++tid) {
+    for (size_t w = 0; w < windows.size(); ++w) {
+      for (int32_t o = 0; o < tListLen(orders); ++o) {
+        TSKEY skey = windows[w].first, ekey = windows[w].second;
+        ASSERT_TRUE(scan(pRepo, tid, skey, ekey, orders[o]) == expectedKeys(tid, skey, ekey))
+            << "tid:" << tid << " window:" << w << " order:" << orders[o];
+      }
+    }
+  }
+}
+
+void checkGroup(SFileGroup* pGroup, TSKEY keyFirst, TSKEY keyLast, const std::vector<int32_t>& tids) {
+  ASSERT_EQ(pGroup->keyFirst, keyFirst) << "fid:" << pGroup->fileId;
+  ASSERT_EQ(pGroup->keyLast, keyLast) << "fid:" << pGroup->fileId;
+  for (int32_t tid = 1; tid < MAX_TABLES; ++tid) {
+    bool has = std::find(tids.begin(), tids.end(), tid) != tids.end();
+    ASSERT_EQ(tsdbFGroupHasTable(pGroup, tid), has) << "fid:" << pGroup->fileId << " tid:" << tid;
+  }
+
+  // the tables created after the bitmap is allocated are always taken as present
+  ASSERT_TRUE(tsdbFGroupHasTable(pGroup, MAX_TABLES));
+}
+}  // namespace
+
+/*
+ * Each file group keeps the key range and the tables having data blocks in it. The summary is exact after the commit
+ * to the group, and after the repository is opened again only the first key of the file id is taken as the first key.
+ * The queries skipping the file groups by the summary still get all the rows.
+ */
+TEST(testCase, tsdb_fgroup_summary_test) {
+  char rootDir[] = "/tmp/tsdbFGroupSummaryTestXXXXXX";
+  ASSERT_TRUE(mkdtemp(rootDir) != NULL);
+  strcat(rootDir, "/tsdb");
+
+  STsdbCfg config;
+  tsdbSetDefaultCfg(&config);
+  config.maxTables = MAX_TABLES;
+  config.cacheBlockSize = 1;
+  config.totalBlocks = 4;
+  config.daysPerFile = 1;
+  ASSERT_EQ(tsdbCreateRepo(rootDir, &config, NULL), 0);
+
+  STsdbAppH appH = {0};
+  appH.notifyStatus = notifyStatus;
+  TsdbRepoT* pRepo = tsdbOpenRepo(rootDir, &appH);
+  ASSERT_TRUE(pRepo != NULL);
+
+  STSchema* pSchema = createSchema();
+  for (int32_t tid = 1; tid <= 3; ++tid) {
+    STableCfg tCfg;
+    ASSERT_EQ(tsdbInitTableCfg(&tCfg, TSDB_NORMAL_TABLE, TABLE_UID + tid, tid), 0);
+    tsdbTableSetName(&tCfg, (char*)(std::string("t") + std::to_string(tid)).c_str(), true);
+    tsdbTableSetSchema(&tCfg, pSchema, true);
+    ASSERT_EQ(tsdbCreateTable(pRepo, &tCfg), 0);
+    tsdbClearTableCfg(&tCfg);
+  }
+
+  // t1 has rows in each of the 3 days, t2 only in the second day and t3 only in the third day, 100 minutes from 1:00
+  TSKEY startTime = (taosGetTimestampMs() / MS_PER_DAY - 10) * MS_PER_DAY;
+  TSKEY hour = 3600000L, rowsEnd = hour + 99 * 60000L;
+  tableKeys.clear();
+  for (int32_t day = 0; day < 3; ++day) {
+    insertRows(pRepo, pSchema, 1, startTime + day * MS_PER_DAY + hour, 100);
+  }
+  insertRows(pRepo, pSchema, 2, startTime + MS_PER_DAY + hour, 100);
+  insertRows(pRepo, pSchema, 3, startTime + 2 * MS_PER_DAY + hour, 100);
+  commit(pRepo);
+
+  STsdbFileH* pFileH = ((STsdbRepo*)pRepo)->tsdbFileH;
+  ASSERT_EQ(pFileH->numOfFGroups, 3);
+  checkGroup(&pFileH->fGroup[0], startTime + hour, startTime + rowsEnd, {1});
+  checkGroup(&pFileH->fGroup[1], startTime + MS_PER_DAY + hour, startTime + MS_PER_DAY + rowsEnd, {1, 2});
+  checkGroup(&pFileH->fGroup[2], startTime + 2 * MS_PER_DAY + hour, startTime + 2 * MS_PER_DAY + rowsEnd, {1, 3});
+  checkQueries(pRepo, startTime, 3);
+
+  // the first keys are not kept in the files
+  tsdbCloseRepo(pRepo, 1);
+  pRepo = tsdbOpenRepo(rootDir, &appH);
+  ASSERT_TRUE(pRepo != NULL);
+
+  pFileH = ((STsdbRepo*)pRepo)->tsdbFileH;
+  ASSERT_EQ(pFileH->numOfFGroups, 3);
+  checkGroup(&pFileH->fGroup[0], startTime, startTime + rowsEnd, {1});
+  checkGroup(&pFileH->fGroup[1], startTime + MS_PER_DAY, startTime + MS_PER_DAY + rowsEnd, {1, 2});
+  checkGroup(&pFileH->fGroup[2], startTime + 2 * MS_PER_DAY, startTime + 2 * MS_PER_DAY + rowsEnd, {1, 3});
+  checkQueries(pRepo, startTime, 3);
+
+  // the rows of t2 after those of t1 in the first day extend the summary, and the rows of t3 make a new group
+  insertRows(pRepo, pSchema, 2, startTime + 5 * hour, 100);
+  insertRows(pRepo, pSchema, 3, startTime + 3 * MS_PER_DAY + 2 * hour, 100);
+  commit(pRepo);
+
+  ASSERT_EQ(pFileH->numOfFGroups, 4);
+  checkGroup(&pFileH->fGroup[0], startTime, startTime + 5 * hour + 99 * 60000L, {1, 2});
+  checkGroup(&pFileH->fGroup[1], startTime + MS_PER_DAY, startTime + MS_PER_DAY + rowsEnd, {1, 2});
+  checkGroup(&pFileH->fGroup[2], startTime + 2 * MS_PER_DAY, startTime + 2 * MS_PER_DAY + rowsEnd, {1, 3});
+  TSKEY keyFirst = startTime + 3 * MS_PER_DAY + 2 * hour;
+  checkGroup(&pFileH->fGroup[3], keyFirst, keyFirst + 99 * 60000L, {3});
+  checkQueries(pRepo, startTime, 4);
+
+  tsdbCloseRepo(pRepo, 0);
+  tdFreeSchema(pSchema);
+
+  rootDir[strlen(rootDir) - strlen("/tsdb")] = 0;
+  taosRemoveDir(rootDir);
+}
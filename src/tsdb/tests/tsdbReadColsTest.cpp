@@ -0,0 +1,301 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "taos.h"
+#include "tchecksum.h"
+#include "tdataformat.h"
+#include "tglobal.h"
+#include "tname.h"
+#include "tsdb.h"
+#include "tsdbMain.h"
+#include "ttime.h"
+#include "tutil.h"
+
+namespace {
+const uint64_t TABLE_UID = 987607499877674L;
+const int32_t  TABLE_TID = 1;
+const int32_t  BINARY_BYTES = 16 + VARSTR_HEADER_SIZE;
+
+const SColumnInfo allCols[] = {{0, TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t)},
+                               {1, TSDB_DATA_TYPE_INT, sizeof(int32_t)},
+                               {2, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t)},
+                               {3, TSDB_DATA_TYPE_DOUBLE, sizeof(double)},
+                               {4, TSDB_DATA_TYPE_BINARY, BINARY_BYTES}};
+
+STSchema* createSchema() {
+  STSchema* pSchema = tdNewSchema(tListLen(allCols));
+  for (int32_t i = 0; i < tListLen(allCols); ++i) {
+    tdSchemaAddCol(pSchema, allCols[i].type, allCols[i].colId, allCols[i].bytes);
+  }
+
+  return pSchema;
+}
+
+// insert the rows [from, from + numOfRows) of one second interval from startTime, 100 rows in each submit message
+void insertRows(TsdbRepoT* pRepo, STSchema* pSchema, TSKEY startTime, int32_t from, int32_t numOfRows) {
+  const int32_t rowsPerSubmit = 100;
+  size_t        size = sizeof(SSubmitMsg) + sizeof(SSubmitBlk) + dataRowMaxBytesFromSchema(pSchema) * rowsPerSubmit;
+  SSubmitMsg*   pMsg = (SSubmitMsg*)malloc(size);
+
+  for (int32_t k = from; k < from + numOfRows; k += rowsPerSubmit) {
+    memset(pMsg, 0, size);
+
+    SSubmitBlk* pBlock = pMsg->blocks;
+    int32_t     rows = std::min(rowsPerSubmit, from + numOfRows - k);
+    for (int32_t i = 0; i < rows; ++i) {
+      SDataRow row = (SDataRow)(pBlock->data + pBlock->len);
+      tdInitDataRow(row, pSchema);
+
+      TSKEY   key = startTime + (k + i) * 1000L;
+      int32_t c1 = k + i;
+      int64_t c2 = (k + i) * 10L;
+      double  c3 = (k + i) * 0.5;
+      char    c4[BINARY_BYTES] = {0};
+      varDataSetLen(c4, sprintf((char*)varDataVal(c4), "v%d", k + i));
+
+      void* vals[] = {&key, &c1, &c2, &c3, c4};
+      for (int32_t j = 0; j < schemaNCols(pSchema); ++j) {
+        STColumn* pCol = schemaColAt(pSchema, j);
+        tdAppendColVal(row, vals[j], pCol->type, pCol->bytes, pCol->offset);
+      }
+
+      pBlock->len += dataRowLen(row);
+    }
+
+    pMsg->length = htonl(sizeof(SSubmitMsg) + sizeof(SSubmitBlk) + pBlock->len);
+    pMsg->numOfBlocks = htonl(1);
+    pBlock->uid = htobe64(TABLE_UID);
+    pBlock->tid = htonl(TABLE_TID);
+    pBlock->sversion = htonl(0);
+    pBlock->numOfRows = htons(rows);
+    pBlock->len = htonl(pBlock->len);
+
+    SShellSubmitRspMsg rsp = {0};
+    ASSERT_EQ(tsdbInsertData(pRepo, pMsg, &rsp), TSDB_CODE_SUCCESS);
+  }
+
+  free(pMsg);
+}
+
+// the value of the column in the nth row inserted, or in the row read, as a string
+std::string valueToString(int8_t type, const char* p) {
+  switch (type) {
+    case TSDB_DATA_TYPE_INT:
+      return std::to_string(*(int32_t*)p);
+    case TSDB_DATA_TYPE_DOUBLE:
+      return std::to_string(*(double*)p);
+    case TSDB_DATA_TYPE_BINARY:
+      return std::string((char*)varDataVal(p), varDataLen(p));
+    default:
+      return std::to_string(*(int64_t*)p);
+  }
+}
+
+std::string expectedValue(int16_t colId, TSKEY startTime, int32_t n) {
+  switch (colId) {
+    case 0:
+      return std::to_string(startTime + n * 1000L);
+    case 1:
+      return std::to_string(n);
+    case 2:
+      return std::to_string(n * 10L);
+    case 3:
+      return std::to_string(n * 0.5);
+    default:
+      return "v" + std::to_string(n);
+  }
+}
+
+std::vector<std::string> expectedRows(const std::vector<int16_t>& colIds, TSKEY startTime, int32_t numOfRows) {
+  std::vector<std::string> rows;
+  for (int32_t n = 0; n < numOfRows; ++n) {
+    std::string row;
+    for (size_t j = 0; j < colIds.size(); ++j) {
+      row += expectedValue(colIds[j], startTime, n) + "|";
+    }
+    rows.push_back(row);
+  }
+
+  return rows;
+}
+
+// read the columns of all the rows in [skey, ekey] by a query, the rows are kept as strings to be compared
+std::vector<std::string> scanAll(TsdbRepoT* pRepo, const std::vector<int16_t>& colIds, TSKEY skey, TSKEY ekey) {
+  std::vector<SColumnInfo> cols;
+  for (size_t i = 0; i < colIds.size(); ++i) {
+    cols.push_back(allCols[colIds[i]]);
+  }
+
+  STsdbQueryCond cond = {{skey, ekey}, TSDB_ORDER_ASC, (int32_t)cols.size(), &cols[0]};
+  STableId       id = {TABLE_UID, TABLE_TID};
+
+  SArray* group = (SArray*)taosArrayInit(1, sizeof(STableId));
+  taosArrayPush(group, &id);
+  STableGroupInfo groupInfo = {1, (SArray*)taosArrayInit(1, POINTER_BYTES)};
+  taosArrayPush(groupInfo.pGroupList, &group);
+
+  TsdbQueryHandleT*        pHandle = tsdbQueryTables(pRepo, &cond, &groupInfo);
+  std::vector<std::string> rows;
+  while (tsdbNextDataBlock(pHandle)) {
+    SDataBlockInfo info = tsdbRetrieveDataBlockInfo(pHandle);
+    SArray*        pCols = tsdbRetrieveDataBlock(pHandle, NULL);
+
+    for (int32_t i = 0; i < info.rows; ++i) {
+      std::string row;
+      for (size_t j = 0; j < cols.size(); ++j) {
+        SColumnInfoData* pColInfo = (SColumnInfoData*)taosArrayGet(pCols, j);
+        row += valueToString(pColInfo->info.type, (char*)pColInfo->pData + i * pColInfo->info.bytes) + "|";
+      }
+      rows.push_back(row);
+    }
+  }
+
+  tsdbCleanupQueryHandle(pHandle);
+  taosArrayDestroy(group);
+  taosArrayDestroy(groupInfo.pGroupList);
+  return rows;
+}
+
+// the rows of the block loaded into the helper must be the inserted ones from the nth
+void checkLoadedCol(SRWHelper* pHelper, int16_t colId, TSKEY startTime, int32_t from) {
+  SDataCols* pDataCols = pHelper->pDataCols[0];
+  SDataCol*  pDataCol = &pDataCols->cols[colId];
+  ASSERT_EQ(pDataCol->colId, colId);
+
+  for (int32_t i = 0; i < pDataCols->numOfRows; ++i) {
+    ASSERT_EQ(valueToString(pDataCol->type, (char*)tdGetColDataOfRow(pDataCol, i)),
+              expectedValue(colId, startTime, from + i));
+  }
+}
+}  // namespace
+
+/*
+ * Only the queried columns of a block are read from file. The data of a column not queried is overwritten in the file,
+ * the queries over the other columns still read the right rows, while the corrupted column fails the checksum once it
+ * is queried. The columns not loaded are reset, or set to NULL to be merged with the sub-blocks.
+ */
+TEST(testCase, tsdb_read_cols_test) {
+  int16_t subBlocksToMerge = tsSubBlocksToMerge;
+  tsSubBlocksToMerge = 0;
+
+  char rootDir[] = "/tmp/tsdbReadColsTestXXXXXX";
+  ASSERT_TRUE(mkdtemp(rootDir) != NULL);
+  strcat(rootDir, "/tsdb");
+
+  STsdbCfg config;
+  tsdbSetDefaultCfg(&config);
+  config.maxTables = 10;
+  config.cacheBlockSize = 1;
+  config.totalBlocks = 4;
+  config.daysPerFile = 10;
+  config.minRowsPerFileBlock = 100;
+  config.maxRowsPerFileBlock = 1000;
+  ASSERT_EQ(tsdbCreateRepo(rootDir, &config, NULL), 0);
+
+  STsdbAppH  appH = {0};
+  TsdbRepoT* pRepo = tsdbOpenRepo(rootDir, &appH);
+  ASSERT_TRUE(pRepo != NULL);
+
+  STableCfg tCfg;
+  STSchema* pSchema = createSchema();
+  ASSERT_EQ(tsdbInitTableCfg(&tCfg, TSDB_NORMAL_TABLE, TABLE_UID, TABLE_TID), 0);
+  tsdbTableSetName(&tCfg, (char*)"t", true);
+  tsdbTableSetSchema(&tCfg, pSchema, true);
+  ASSERT_EQ(tsdbCreateTable(pRepo, &tCfg), 0);
+  tsdbClearTableCfg(&tCfg);
+
+  // four blocks in the data file, and the small batches committed one by one make a block of sub-blocks in .last
+  int64_t interval = config.daysPerFile * 86400 * 1000L;
+  TSKEY   startTime = taosGetTimestampMs() / interval * interval;
+  insertRows(pRepo, pSchema, startTime, 0, 2500);
+  tsdbCloseRepo(pRepo, 1);
+
+  for (int32_t i = 0; i < 3; ++i) {
+    pRepo = tsdbOpenRepo(rootDir, &appH);
+    ASSERT_TRUE(pRepo != NULL);
+    insertRows(pRepo, pSchema, startTime, 2500 + i * 10, 10);
+    tsdbCloseRepo(pRepo, 1);
+  }
+
+  const int32_t numOfRows = 2530;
+  std::vector<std::vector<int16_t> > subsets = {{0, 1, 2, 3, 4}, {0}, {0, 1}, {0, 3}, {0, 2, 4}, {0, 4}, {0, 1, 3, 4}};
+
+  pRepo = tsdbOpenRepo(rootDir, &appH);
+  ASSERT_TRUE(pRepo != NULL);
+  for (size_t i = 0; i < subsets.size(); ++i) {
+    ASSERT_TRUE(scanAll(pRepo, subsets[i], startTime, INT64_MAX) == expectedRows(subsets[i], startTime, numOfRows));
+  }
+
+  // the blocks of the table, the last one is made of the sub-blocks
+  STsdbRepo* pTsdb = (STsdbRepo*)pRepo;
+  STable*    pTable = tsdbGetTableByUid(pTsdb->tsdbMeta, TABLE_UID);
+  ASSERT_TRUE(pTable != NULL);
+  ASSERT_EQ(pTsdb->tsdbFileH->numOfFGroups, 1);
+
+  SRWHelper helper;
+  ASSERT_EQ(tsdbInitReadHelper(&helper, pTsdb), 0);
+  ASSERT_EQ(tsdbSetAndOpenHelperFile(&helper, &pTsdb->tsdbFileH->fGroup[0]), 0);
+  tsdbSetHelperTable(&helper, pTable, pTsdb);
+  ASSERT_EQ(tsdbLoadCompInfo(&helper, NULL), 0);
+  ASSERT_EQ(helper.pCompIdx[TABLE_TID].numOfBlocks, 5);
+
+  SCompBlock* pLastBlock = blockAtIdx(&helper, 4);
+  ASSERT_TRUE(pLastBlock->last);
+  ASSERT_EQ(pLastBlock->numOfSubBlocks, 3);
+
+  int16_t colIds[] = {0, 3};
+  ASSERT_EQ(tsdbLoadBlockDataCols(&helper, NULL, pLastBlock, colIds, tListLen(colIds)), 0);
+  ASSERT_EQ(helper.pDataCols[0]->numOfRows, 30);
+  checkLoadedCol(&helper, 0, startTime, 2500);
+  checkLoadedCol(&helper, 3, startTime, 2500);
+  for (int32_t i = 0; i < helper.pDataCols[0]->numOfRows; ++i) {
+    ASSERT_TRUE(isNull((char*)tdGetColDataOfRow(&helper.pDataCols[0]->cols[1], i), TSDB_DATA_TYPE_INT));
+  }
+
+  // overwrite the middle of the data of c2 in the first block
+  SCompBlock* pBlock = blockAtIdx(&helper, 0);
+  ASSERT_EQ(pBlock->numOfSubBlocks, 1);
+  ASSERT_EQ(tsdbLoadCompData(&helper, pBlock, NULL), 0);
+
+  SCompCol* pCompCol = &helper.pCompData->cols[2];
+  ASSERT_EQ(pCompCol->colId, 2);
+  int64_t offset = pBlock->offset + sizeof(SCompData) + sizeof(SCompCol) * pBlock->numOfCols + sizeof(TSCKSUM) +
+                   pCompCol->offset + pCompCol->len / 2;
+
+  int fd = open(helper.files.dataF.fname, O_WRONLY);
+  ASSERT_GE(fd, 0);
+  char garbage[8];
+  memset(garbage, 0x5a, sizeof(garbage));
+  ASSERT_EQ(pwrite(fd, garbage, sizeof(garbage), offset), sizeof(garbage));
+  close(fd);
+
+  int16_t otherColIds[] = {0, 1, 3, 4};
+  ASSERT_EQ(tsdbLoadBlockDataCols(&helper, NULL, pBlock, otherColIds, tListLen(otherColIds)), 0);
+  ASSERT_EQ(helper.pDataCols[0]->numOfRows, pBlock->numOfRows);
+  for (int32_t i = 0; i < tListLen(otherColIds); ++i) {
+    checkLoadedCol(&helper, otherColIds[i], startTime, 0);
+  }
+  ASSERT_EQ(helper.pDataCols[0]->cols[2].len, 0);
+
+  int16_t corruptedColIds[] = {0, 2};
+  ASSERT_LT(tsdbLoadBlockDataCols(&helper, NULL, pBlock, corruptedColIds, tListLen(corruptedColIds)), 0);
+  ASSERT_LT(tsdbLoadBlockData(&helper, pBlock, NULL), 0);
+  tsdbDestroyHelper(&helper);
+
+  for (size_t i = 0; i < subsets.size(); ++i) {
+    if (std::find(subsets[i].begin(), subsets[i].end(), 2) == subsets[i].end()) {
+      ASSERT_TRUE(scanAll(pRepo, subsets[i], startTime, INT64_MAX) == expectedRows(subsets[i], startTime, numOfRows));
+    }
+  }
+  tsdbCloseRepo(pRepo, 0);
+
+  tsSubBlocksToMerge = subBlocksToMerge;
+  tdFreeSchema(pSchema);
+
+  rootDir[strlen(rootDir) - strlen("/tsdb")] = 0;
+  taosRemoveDir(rootDir);
+}
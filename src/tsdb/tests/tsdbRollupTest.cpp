@@ -0,0 +1,304 @@
+#include <gtest/gtest.h>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "taos.h"
+#include "tdataformat.h"
+#include "tglobal.h"
+#include "tname.h"
+#include "tsdb.h"
+#include "tsdbMain.h"
+#include "ttime.h"
+#include "tutil.h"
+
+namespace {
+const uint64_t TABLE_UID = 987607499877674L;
+const int32_t  TABLE_TID = 1;
+const int64_t  MINUTE = 60 * 1000L;
+const int64_t  HOUR = 60 * MINUTE;
+const int64_t  DAY = 24 * HOUR;
+const int64_t  TIERS[] = {MINUTE, HOUR};
+
+// the int column has NULLs in every window, the double one has windows of NULLs only and the bigint one is NULL in
+// all the rows of the second day, so it is not written to the blocks of that day
+const SColumnInfo allCols[] = {{0, TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t)},
+                               {1, TSDB_DATA_TYPE_INT, sizeof(int32_t)},
+                               {2, TSDB_DATA_TYPE_DOUBLE, sizeof(double)},
+                               {3, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t)}};
+
+STSchema* createSchema() {
+  STSchema* pSchema = tdNewSchema(tListLen(allCols));
+  for (int32_t i = 0; i < tListLen(allCols); ++i) {
+    tdSchemaAddCol(pSchema, allCols[i].type, allCols[i].colId, allCols[i].bytes);
+  }
+
+  return pSchema;
+}
+
+// insert the rows [from, from + numOfRows) of the interval from startTime
+void insertRows(TsdbRepoT* pRepo, STSchema* pSchema, TSKEY startTime, int64_t interval, int32_t from,
+                int32_t numOfRows, bool nullBigint) {
+  const int32_t rowsPerSubmit = 100;
+  size_t        size = sizeof(SSubmitMsg) + sizeof(SSubmitBlk) + dataRowMaxBytesFromSchema(pSchema) * rowsPerSubmit;
+  SSubmitMsg*   pMsg = (SSubmitMsg*)malloc(size);
+
+  for (int32_t k = from; k < from + numOfRows; k += rowsPerSubmit) {
+    memset(pMsg, 0, size);
+
+    SSubmitBlk* pBlock = pMsg->blocks;
+    int32_t     rows = std::min(rowsPerSubmit, from + numOfRows - k);
+    for (int32_t i = 0; i < rows; ++i) {
+      SDataRow row = (SDataRow)(pBlock->data + pBlock->len);
+      tdInitDataRow(row, pSchema);
+
+      int32_t n = k + i;
+      TSKEY   key = startTime + n * interval;
+      int32_t c1 = n - 1000;
+      double  c2 = n * 0.25;
+      int64_t c3 = n * 3L;
+      if (n % 7 == 0) setNull((char*)&c1, TSDB_DATA_TYPE_INT, sizeof(int32_t));
+      if (n % 200 < 30) setNull((char*)&c2, TSDB_DATA_TYPE_DOUBLE, sizeof(double));
+      if (nullBigint) setNull((char*)&c3, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t));
+
+      void* vals[] = {&key, &c1, &c2, &c3};
+      for (int32_t j = 0; j < schemaNCols(pSchema); ++j) {
+        STColumn* pCol = schemaColAt(pSchema, j);
+        tdAppendColVal(row, vals[j], pCol->type, pCol->bytes, pCol->offset);
+      }
+
+      pBlock->len += dataRowLen(row);
+    }
+
+    pMsg->length = htonl(sizeof(SSubmitMsg) + sizeof(SSubmitBlk) + pBlock->len);
+    pMsg->numOfBlocks = htonl(1);
+    pBlock->uid = htobe64(TABLE_UID);
+    pBlock->tid = htonl(TABLE_TID);
+    pBlock->sversion = htonl(0);
+    pBlock->numOfRows = htons(rows);
+    pBlock->len = htonl(pBlock->len);
+
+    SShellSubmitRspMsg rsp = {0};
+    ASSERT_EQ(tsdbInsertData(pRepo, pMsg, &rsp), TSDB_CODE_SUCCESS);
+  }
+
+  free(pMsg);
+}
+
+TSKEY windowStart(TSKEY key, int64_t interval) { return key - ((key % interval) + interval) % interval; }
+
+// the tier of the rollup expected for the query windows, 0 if there is none
+int64_t expectedTier(TSKEY* keys, int32_t rows, int64_t interval, TSKEY origin) {
+  for (int32_t i = tListLen(TIERS) - 1; i >= 0; --i) {
+    int64_t tier = TIERS[i];
+    if (interval % tier != 0 || windowStart(origin, tier) != origin) continue;
+
+    int32_t numOfWindows = 1;
+    for (int32_t j = 1; j < rows; ++j) {
+      if (windowStart(keys[j], tier) != windowStart(keys[j - 1], tier)) numOfWindows++;
+    }
+
+    // the tier is not kept if its windows have too few rows
+    if (numOfWindows <= rows / TSDB_ROLLUP_MIN_ROWS_PER_WINDOW) return tier;
+  }
+
+  return 0;
+}
+
+// check the statistics of each window of the rollup against the rows of the block
+void checkRollup(SDataRollup* pRollup, SArray* pCols, TSKEY* keys, int32_t rows) {
+  int32_t w = -1;
+  for (int32_t start = 0, end = 0; start < rows; start = end) {
+    TSKEY skey = windowStart(keys[start], pRollup->interval);
+    while (end < rows && windowStart(keys[end], pRollup->interval) == skey) end++;
+
+    w++;
+    ASSERT_LT(w, pRollup->numOfWindows);
+    ASSERT_EQ(pRollup->skey[w], skey);
+    ASSERT_EQ(pRollup->numOfRows[w], end - start);
+
+    for (int32_t c = 0; c < tListLen(allCols); ++c) {
+      SColumnInfoData* pColInfo = (SColumnInfoData*)taosArrayGet(pCols, c);
+      SDataStatis*     pStatis = pRollup->statis + w * pRollup->numOfCols + c;
+      ASSERT_EQ(pStatis->colId, pColInfo->info.colId);
+
+      int16_t numOfNull = 0;
+      int64_t isum = 0, imin = INT64_MAX, imax = INT64_MIN;
+      double  dsum = 0, dmin = DBL_MAX, dmax = -DBL_MAX;
+      for (int32_t i = start; i < end; ++i) {
+        char* p = (char*)pColInfo->pData + i * pColInfo->info.bytes;
+        if (isNull(p, pColInfo->info.type)) {
+          numOfNull++;
+        } else if (pColInfo->info.type == TSDB_DATA_TYPE_DOUBLE) {
+          dsum += *(double*)p;
+          dmin = std::min(dmin, *(double*)p);
+          dmax = std::max(dmax, *(double*)p);
+        } else {
+          int64_t v = (pColInfo->info.type == TSDB_DATA_TYPE_INT) ? *(int32_t*)p : *(int64_t*)p;
+          isum += v;
+          imin = std::min(imin, v);
+          imax = std::max(imax, v);
+        }
+      }
+
+      ASSERT_EQ(pStatis->numOfNull, numOfNull);
+      if (numOfNull == end - start) continue;
+
+      if (pColInfo->info.type == TSDB_DATA_TYPE_TIMESTAMP) {
+        ASSERT_EQ(pStatis->min, keys[start]);
+        ASSERT_EQ(pStatis->max, keys[end - 1]);
+      } else if (pColInfo->info.type == TSDB_DATA_TYPE_DOUBLE) {
+        ASSERT_DOUBLE_EQ(*(double*)&pStatis->sum, dsum);
+        ASSERT_DOUBLE_EQ(*(double*)&pStatis->min, dmin);
+        ASSERT_DOUBLE_EQ(*(double*)&pStatis->max, dmax);
+      } else {
+        ASSERT_EQ(pStatis->sum, isum);
+        ASSERT_EQ(pStatis->min, imin);
+        ASSERT_EQ(pStatis->max, imax);
+      }
+    }
+  }
+
+  ASSERT_EQ(w + 1, pRollup->numOfWindows);
+}
+
+// the number of blocks answered by the rollups of each tier, and by none of them
+struct SRollupCount {
+  int32_t numOfTier[tListLen(TIERS)];
+  int32_t numOfNone;
+};
+
+/*
+ * Get the rollups of each file block for the query windows of the intervals with the origin moved by the offsets,
+ * and check them against the rows of the block.
+ */
+void checkAllBlocks(TsdbRepoT* pRepo, TSKEY startTime, const std::vector<std::pair<int64_t, int64_t> >& cases,
+                    std::vector<SRollupCount>& counts, int32_t* totalRows) {
+  STsdbQueryCond cond = {{startTime, INT64_MAX}, TSDB_ORDER_ASC, tListLen(allCols), (SColumnInfo*)allCols};
+  STableId       id = {TABLE_UID, TABLE_TID};
+
+  SArray*         group = (SArray*)taosArrayInit(1, sizeof(STableId));
+  STableGroupInfo groupInfo = {0};
+  taosArrayPush(group, &id);
+  groupInfo.numOfTables = 1;
+  groupInfo.pGroupList = (SArray*)taosArrayInit(1, POINTER_BYTES);
+  taosArrayPush(groupInfo.pGroupList, &group);
+
+  TsdbQueryHandleT* pHandle = tsdbQueryTables(pRepo, &cond, &groupInfo);
+  *totalRows = 0;
+  counts.assign(cases.size(), SRollupCount());
+
+  while (tsdbNextDataBlock(pHandle)) {
+    SDataBlockInfo info = tsdbRetrieveDataBlockInfo(pHandle);
+    SArray*        pCols = tsdbRetrieveDataBlock(pHandle, NULL);
+    TSKEY*         keys = (TSKEY*)((SColumnInfoData*)taosArrayGet(pCols, 0))->pData;
+    *totalRows += info.rows;
+
+    for (size_t i = 0; i < cases.size(); ++i) {
+      int64_t interval = cases[i].first;
+      TSKEY   origin = windowStart(info.window.skey, interval) + cases[i].second;
+
+      int64_t      tier = expectedTier(keys, info.rows, interval, origin);
+      SDataRollup* pRollup = tsdbRetrieveDataBlockRollup(pHandle, interval, origin);
+      if (tier == 0) {
+        ASSERT_TRUE(pRollup == NULL);
+        counts[i].numOfNone++;
+        continue;
+      }
+
+      ASSERT_TRUE(pRollup != NULL);
+      ASSERT_EQ(pRollup->interval, tier);
+      checkRollup(pRollup, pCols, keys, info.rows);
+      counts[i].numOfTier[tier == MINUTE ? 0 : 1]++;
+    }
+  }
+
+  tsdbCleanupQueryHandle(pHandle);
+  taosArrayDestroy(group);
+  taosArrayDestroy(groupInfo.pGroupList);
+}
+}  // namespace
+
+/*
+ * The rollups are written with the blocks at commit time and read for the query windows consisting of their windows.
+ * The blocks of the second day have 2 rows per minute, so only the tier of one hour is kept for them.
+ */
+TEST(testCase, tsdb_rollup_test) {
+  std::string rollupInterval = tsRollupInterval;
+  strcpy(tsRollupInterval, "1h, 1m");
+
+  char rootDir[] = "/tmp/tsdbRollupTestXXXXXX";
+  ASSERT_TRUE(mkdtemp(rootDir) != NULL);
+  strcat(rootDir, "/tsdb");
+
+  STsdbCfg config;
+  tsdbSetDefaultCfg(&config);
+  config.maxTables = 10;
+  config.cacheBlockSize = 1;
+  config.totalBlocks = 4;
+  config.daysPerFile = 1;
+  config.minRowsPerFileBlock = 10;
+  config.maxRowsPerFileBlock = 1000;
+  ASSERT_EQ(tsdbCreateRepo(rootDir, &config, NULL), 0);
+
+  STsdbAppH  appH = {0};
+  TsdbRepoT* pRepo = tsdbOpenRepo(rootDir, &appH);
+  ASSERT_TRUE(pRepo != NULL);
+
+  STableCfg tCfg;
+  STSchema* pSchema = createSchema();
+  ASSERT_EQ(tsdbInitTableCfg(&tCfg, TSDB_NORMAL_TABLE, TABLE_UID, TABLE_TID), 0);
+  tsdbTableSetName(&tCfg, (char*)"t", true);
+  tsdbTableSetSchema(&tCfg, pSchema, true);
+  ASSERT_EQ(tsdbCreateTable(pRepo, &tCfg), 0);
+  tsdbClearTableCfg(&tCfg);
+
+  // 6 hours of rows every 10 seconds, then 12 hours of rows every 30 seconds on the next day
+  TSKEY startTime = taosGetTimestampMs() / DAY * DAY - 2 * DAY;
+  insertRows(pRepo, pSchema, startTime, 10 * 1000L, 0, 2160, false);
+  insertRows(pRepo, pSchema, startTime + DAY, 30 * 1000L, 0, 1440, true);
+  tsdbCloseRepo(pRepo, 1);
+
+  // {interval, offset of the origin}
+  std::vector<std::pair<int64_t, int64_t> > cases = {{MINUTE, 0},        {2 * MINUTE, 0},        {HOUR, 0},
+                                                     {2 * HOUR, 0},      {90 * 1000L, 0},        {MINUTE, 30 * 1000L},
+                                                     {HOUR, 30 * MINUTE}};
+  std::vector<SRollupCount> counts;
+  int32_t                   totalRows = 0;
+
+  pRepo = tsdbOpenRepo(rootDir, &appH);
+  ASSERT_TRUE(pRepo != NULL);
+  checkAllBlocks(pRepo, startTime, cases, counts, &totalRows);
+  ASSERT_EQ(totalRows, 2160 + 1440);
+
+  // the windows of one minute are used for the first day only, and the coarsest tier is used when both fit
+  ASSERT_GT(counts[0].numOfTier[0], 0);
+  ASSERT_GT(counts[0].numOfNone, 0);
+  ASSERT_EQ(counts[2].numOfTier[0], 0);
+  ASSERT_EQ(counts[2].numOfNone, 0);
+  ASSERT_EQ(counts[3].numOfTier[1], counts[2].numOfTier[1]);
+
+  // the query windows not made of whole rollup windows are answered by the block data
+  ASSERT_EQ(counts[4].numOfTier[0] + counts[4].numOfTier[1], 0);
+  ASSERT_EQ(counts[5].numOfTier[0] + counts[5].numOfTier[1], 0);
+  ASSERT_EQ(counts[6].numOfTier[1], 0);
+  ASSERT_EQ(counts[6].numOfTier[0], counts[0].numOfTier[0]);
+
+  // the rows out of order are merged into the blocks of the first day, whose rollups are rebuilt
+  insertRows(pRepo, pSchema, startTime + 5 * 1000L, 10 * 1000L, 500, 100, false);
+  tsdbCloseRepo(pRepo, 1);
+
+  pRepo = tsdbOpenRepo(rootDir, &appH);
+  ASSERT_TRUE(pRepo != NULL);
+  checkAllBlocks(pRepo, startTime, cases, counts, &totalRows);
+  ASSERT_EQ(totalRows, 2160 + 1440 + 100);
+  ASSERT_GT(counts[0].numOfTier[0], 0);
+  tsdbCloseRepo(pRepo, 0);
+
+  strcpy(tsRollupInterval, rollupInterval.c_str());
+  tdFreeSchema(pSchema);
+
+  rootDir[strlen(rootDir) - strlen("/tsdb")] = 0;
+  taosRemoveDir(rootDir);
+}
@@ -0,0 +1,303 @@
+#include <gtest/gtest.h>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "taos.h"
+#include "tdataformat.h"
+#include "tglobal.h"
+#include "tname.h"
+#include "tsdb.h"
+#include "tsdbMain.h"
+#include "ttime.h"
+#include "tutil.h"
+
+namespace {
+const uint64_t TABLE_UID = 987607499877673L;
+const int32_t  TABLE_TID = 1;
+const int32_t  BINARY_BYTES = 16 + VARSTR_HEADER_SIZE;
+
+const SColumnInfo allCols[] = {{0, TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t)},
+                               {1, TSDB_DATA_TYPE_INT, sizeof(int32_t)},
+                               {2, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t)},
+                               {3, TSDB_DATA_TYPE_DOUBLE, sizeof(double)},
+                               {4, TSDB_DATA_TYPE_BINARY, BINARY_BYTES}};
+
+int32_t numOfCommits = 0;
+
+int notifyStatus(void* appH, int status) {
+  if (status == TSDB_STATUS_COMMIT_OVER) atomic_add_fetch_32(&numOfCommits, 1);
+  return 0;
+}
+
+STSchema* createSchema() {
+  STSchema* pSchema = tdNewSchema(tListLen(allCols));
+  for (int32_t i = 0; i < tListLen(allCols); ++i) {
+    tdSchemaAddCol(pSchema, allCols[i].type, allCols[i].colId, allCols[i].bytes);
+  }
+
+  return pSchema;
+}
+
+// insert the rows [from, from + numOfRows) of one second interval from startTime, 100 rows in each submit message
+void insertRows(TsdbRepoT* pRepo, STSchema* pSchema, TSKEY startTime, int32_t from, int32_t numOfRows) {
+  const int32_t rowsPerSubmit = 100;
+  size_t        size = sizeof(SSubmitMsg) + sizeof(SSubmitBlk) + dataRowMaxBytesFromSchema(pSchema) * rowsPerSubmit;
+  SSubmitMsg*   pMsg = (SSubmitMsg*)malloc(size);
+
+  for (int32_t k = from; k < from + numOfRows; k += rowsPerSubmit) {
+    memset(pMsg, 0, size);
+
+    SSubmitBlk* pBlock = pMsg->blocks;
+    int32_t     rows = std::min(rowsPerSubmit, from + numOfRows - k);
+    for (int32_t i = 0; i < rows; ++i) {
+      SDataRow row = (SDataRow)(pBlock->data + pBlock->len);
+      tdInitDataRow(row, pSchema);
+
+      TSKEY   key = startTime + (k + i) * 1000L;
+      int32_t c1 = k + i;
+      int64_t c2 = (k + i) * 10L;
+      double  c3 = (k + i) * 0.5;
+      char    c4[BINARY_BYTES] = {0};
+      varDataSetLen(c4, sprintf((char*)varDataVal(c4), "v%d", k + i));
+
+      void* vals[] = {&key, &c1, &c2, &c3, c4};
+      for (int32_t j = 0; j < schemaNCols(pSchema); ++j) {
+        STColumn* pCol = schemaColAt(pSchema, j);
+        tdAppendColVal(row, vals[j], pCol->type, pCol->bytes, pCol->offset);
+      }
+
+      pBlock->len += dataRowLen(row);
+    }
+
+    pMsg->length = htonl(sizeof(SSubmitMsg) + sizeof(SSubmitBlk) + pBlock->len);
+    pMsg->numOfBlocks = htonl(1);
+    pBlock->uid = htobe64(TABLE_UID);
+    pBlock->tid = htonl(TABLE_TID);
+    pBlock->sversion = htonl(0);
+    pBlock->numOfRows = htons(rows);
+    pBlock->len = htonl(pBlock->len);
+
+    SShellSubmitRspMsg rsp = {0};
+    ASSERT_EQ(tsdbInsertData(pRepo, pMsg, &rsp), TSDB_CODE_SUCCESS);
+  }
+
+  free(pMsg);
+}
+
+// a scan over some of the columns of the table, the rows read are kept as strings to be compared
+struct SScan {
+  TsdbQueryHandleT*        pHandle;
+  SArray*                  group;
+  STableGroupInfo          groupInfo;
+  std::vector<SColumnInfo> cols;
+  std::vector<std::string> rows;
+};
+
+SScan* openScan(TsdbRepoT* pRepo, const std::vector<int16_t>& colIds, TSKEY skey, TSKEY ekey) {
+  SScan* pScan = new SScan();
+  for (size_t i = 0; i < colIds.size(); ++i) {
+    pScan->cols.push_back(allCols[colIds[i]]);
+  }
+
+  STsdbQueryCond cond = {{skey, ekey}, TSDB_ORDER_ASC, (int32_t)pScan->cols.size(), &pScan->cols[0]};
+  STableId       id = {TABLE_UID, TABLE_TID};
+
+  pScan->group = (SArray*)taosArrayInit(1, sizeof(STableId));
+  taosArrayPush(pScan->group, &id);
+  pScan->groupInfo.numOfTables = 1;
+  pScan->groupInfo.pGroupList = (SArray*)taosArrayInit(1, POINTER_BYTES);
+  taosArrayPush(pScan->groupInfo.pGroupList, &pScan->group);
+
+  pScan->pHandle = tsdbQueryTables(pRepo, &cond, &pScan->groupInfo);
+  return pScan;
+}
+
+// read the next data block of the scan, return false if no block is left
+bool nextBlock(SScan* pScan) {
+  if (!tsdbNextDataBlock(pScan->pHandle)) return false;
+
+  SDataBlockInfo info = tsdbRetrieveDataBlockInfo(pScan->pHandle);
+  SArray*        pCols = tsdbRetrieveDataBlock(pScan->pHandle, NULL);
+
+  for (int32_t i = 0; i < info.rows; ++i) {
+    std::string row;
+    for (size_t j = 0; j < pScan->cols.size(); ++j) {
+      SColumnInfoData* pColInfo = (SColumnInfoData*)taosArrayGet(pCols, j);
+      char*            p = (char*)pColInfo->pData + i * pColInfo->info.bytes;
+
+      switch (pColInfo->info.type) {
+        case TSDB_DATA_TYPE_INT:
+          row += std::to_string(*(int32_t*)p);
+          break;
+        case TSDB_DATA_TYPE_DOUBLE:
+          row += std::to_string(*(double*)p);
+          break;
+        case TSDB_DATA_TYPE_BINARY:
+          row += std::string((char*)varDataVal(p), varDataLen(p));
+          break;
+        default:
+          row += std::to_string(*(int64_t*)p);
+          break;
+      }
+      row += "|";
+    }
+
+    pScan->rows.push_back(row);
+  }
+
+  return true;
+}
+
+std::vector<std::string> closeScan(SScan* pScan) {
+  std::vector<std::string> rows = pScan->rows;
+
+  tsdbCleanupQueryHandle(pScan->pHandle);
+  taosArrayDestroy(pScan->group);
+  taosArrayDestroy(pScan->groupInfo.pGroupList);
+  delete pScan;
+  return rows;
+}
+
+std::vector<std::string> scanAll(TsdbRepoT* pRepo, const std::vector<int16_t>& colIds, TSKEY skey, TSKEY ekey) {
+  SScan* pScan = openScan(pRepo, colIds, skey, ekey);
+  while (nextBlock(pScan)) {
+  }
+
+  return closeScan(pScan);
+}
+
+// read the scans block by block in turn, until all of them are over
+void readInTurn(std::vector<SScan*>& scans, int32_t blocksPerScan) {
+  bool more = true;
+  for (int32_t n = 0; more && (blocksPerScan < 0 || n < blocksPerScan); ++n) {
+    more = false;
+    for (size_t i = 0; i < scans.size(); ++i) {
+      more = nextBlock(scans[i]) || more;
+    }
+  }
+}
+
+int64_t getNumOfBlocksShared(TsdbRepoT* pRepo) {
+  STsdbRepoInfo* pInfo = tsdbGetStatus(pRepo);
+  int64_t        shared = pInfo->stat.numOfBlocksShared;
+  free(pInfo);
+  return shared;
+}
+}  // namespace
+
+/*
+ * Concurrent scans over different columns of the same blocks take the blocks loaded by each other. A commit rewriting
+ * the file they are reading must not give them a block of the new files, and each scan must read the same rows as a
+ * scan alone with sharing disabled.
+ */
+TEST(testCase, tsdb_shared_scan_test) {
+  int32_t sharedScanBlocks = tsSharedScanBlocks;
+
+  char rootDir[] = "/tmp/tsdbSharedScanTestXXXXXX";
+  ASSERT_TRUE(mkdtemp(rootDir) != NULL);
+  strcat(rootDir, "/tsdb");
+
+  STsdbCfg config;
+  tsdbSetDefaultCfg(&config);
+  config.maxTables = 10;
+  config.cacheBlockSize = 1;
+  config.totalBlocks = 4;
+  config.daysPerFile = 10;
+  config.minRowsPerFileBlock = 100;
+  config.maxRowsPerFileBlock = 1000;
+  ASSERT_EQ(tsdbCreateRepo(rootDir, &config, NULL), 0);
+
+  STsdbAppH appH = {0};
+  appH.notifyStatus = notifyStatus;
+
+  tsSharedScanBlocks = 0;
+  TsdbRepoT* pRepo = tsdbOpenRepo(rootDir, &appH);
+  ASSERT_TRUE(pRepo != NULL);
+
+  STableCfg tCfg;
+  STSchema* pSchema = createSchema();
+  ASSERT_EQ(tsdbInitTableCfg(&tCfg, TSDB_NORMAL_TABLE, TABLE_UID, TABLE_TID), 0);
+  tsdbTableSetName(&tCfg, (char*)"t", true);
+  tsdbTableSetSchema(&tCfg, pSchema, true);
+  ASSERT_EQ(tsdbCreateTable(pRepo, &tCfg), 0);
+  tsdbClearTableCfg(&tCfg);
+
+  // five blocks in one file, the rows inserted later go to the same file
+  int64_t interval = config.daysPerFile * 86400 * 1000L;
+  TSKEY   startTime = taosGetTimestampMs() / interval * interval;
+  insertRows(pRepo, pSchema, startTime, 0, 4000);
+  tsdbCloseRepo(pRepo, 1);
+
+  // the one with all the columns goes first, so the blocks it loads are taken by the others
+  std::vector<std::vector<int16_t> > subsets = {{0, 1, 2, 3, 4}, {0, 1}, {0, 2, 4}, {0, 3}, {0, 4}};
+  TSKEY ekey = startTime + 4000 * 1000L - 1;
+
+  std::vector<std::vector<std::string> > expected;
+  pRepo = tsdbOpenRepo(rootDir, &appH);
+  ASSERT_TRUE(pRepo != NULL);
+  for (size_t i = 0; i < subsets.size(); ++i) {
+    expected.push_back(scanAll(pRepo, subsets[i], startTime, ekey));
+    ASSERT_EQ(expected[i].size(), 4000);
+  }
+  tsdbCloseRepo(pRepo, 0);
+
+  tsSharedScanBlocks = 32;
+  pRepo = tsdbOpenRepo(rootDir, &appH);
+  ASSERT_TRUE(pRepo != NULL);
+
+  std::vector<SScan*> scans;
+  for (size_t i = 0; i < subsets.size(); ++i) {
+    scans.push_back(openScan(pRepo, subsets[i], startTime, ekey));
+  }
+
+  readInTurn(scans, 2);
+  int64_t shared = getNumOfBlocksShared(pRepo);
+  ASSERT_GT(shared, 0);
+
+  // a commit in the middle of the scans rewrites the file
+  int32_t commits = numOfCommits;
+  insertRows(pRepo, pSchema, startTime, 4000, 1000);
+  ASSERT_EQ(tsdbTriggerCommit(pRepo), 0);
+  for (int32_t i = 0; i < 1000 && atomic_load_32(&numOfCommits) == commits; ++i) {
+    taosMsleep(10);
+  }
+  ASSERT_EQ(numOfCommits, commits + 1);
+
+  readInTurn(scans, -1);
+  for (size_t i = 0; i < scans.size(); ++i) {
+    ASSERT_TRUE(closeScan(scans[i]) == expected[i]);
+  }
+
+  // the scans started after the commit share the blocks of the new file
+  scans.clear();
+  for (size_t i = 0; i < subsets.size(); ++i) {
+    scans.push_back(openScan(pRepo, subsets[i], startTime, INT64_MAX));
+  }
+
+  readInTurn(scans, -1);
+  ASSERT_GT(getNumOfBlocksShared(pRepo), shared);
+
+  std::vector<std::vector<std::string> > results;
+  for (size_t i = 0; i < scans.size(); ++i) {
+    results.push_back(closeScan(scans[i]));
+  }
+  tsdbCloseRepo(pRepo, 0);
+
+  tsSharedScanBlocks = 0;
+  pRepo = tsdbOpenRepo(rootDir, &appH);
+  ASSERT_TRUE(pRepo != NULL);
+  for (size_t i = 0; i < subsets.size(); ++i) {
+    std::vector<std::string> rows = scanAll(pRepo, subsets[i], startTime, INT64_MAX);
+    ASSERT_EQ(rows.size(), 5000);
+    ASSERT_TRUE(results[i] == rows);
+  }
+  tsdbCloseRepo(pRepo, 0);
+
+  tsSharedScanBlocks = sharedScanBlocks;
+  tdFreeSchema(pSchema);
+
+  rootDir[strlen(rootDir) - strlen("/tsdb")] = 0;
+  taosRemoveDir(rootDir);
+}
@@ -0,0 +1,292 @@
+#include <gtest/gtest.h>
+#include <cassert>
+#include <iostream>
+
+#include "taos.h"
+#include "tdataformat.h"
+#include "tglobal.h"
+#include "tname.h"
+#include "tsdb.h"
+#include "ttime.h"
+#include "tutil.h"
+
+namespace {
+const uint64_t TABLE_UID = 987607499877672L;
+const int32_t  TABLE_TID = 1;
+const int32_t  DAYS_PER_FILE = 10;
+
+// the statistics of the repository when the last commit is over, the repository is freed after closed
+STsdbStat commitStat;
+int32_t   numOfCommits = 0;
+
+int notifyStatus(void* appH, int status) {
+  if (status == TSDB_STATUS_COMMIT_OVER) {
+    STsdbRepoInfo* pInfo = tsdbGetStatus(*(TsdbRepoT**)appH);
+    assert(pInfo != NULL);
+
+    commitStat = pInfo->stat;
+    numOfCommits++;
+    free(pInfo);
+  }
+
+  return 0;
+}
+
+STSchema* createSchema() {
+  STSchema* pSchema = tdNewSchema(2);
+  tdSchemaAddCol(pSchema, TSDB_DATA_TYPE_TIMESTAMP, 0, sizeof(int64_t));
+  tdSchemaAddCol(pSchema, TSDB_DATA_TYPE_INT, 1, sizeof(int32_t));
+  return pSchema;
+}
+
+// insert numOfRows rows of one second interval from startTime, 100 rows in each submit message, the value of a row is
+// its timestamp in seconds
+void insertRows(TsdbRepoT* pRepo, STSchema* pSchema, TSKEY startTime, int32_t numOfRows) {
+  const int32_t rowsPerSubmit = 100;
+  size_t        size = sizeof(SSubmitMsg) + sizeof(SSubmitBlk) + dataRowMaxBytesFromSchema(pSchema) * rowsPerSubmit;
+  SSubmitMsg*   pMsg = (SSubmitMsg*)malloc(size);
+
+  for (int32_t k = 0; k < numOfRows; k += rowsPerSubmit) {
+    memset(pMsg, 0, size);
+
+    SSubmitBlk* pBlock = pMsg->blocks;
+    int32_t     rows = std::min(rowsPerSubmit, numOfRows - k);
+    for (int32_t i = 0; i < rows; ++i) {
+      SDataRow row = (SDataRow)(pBlock->data + pBlock->len);
+      tdInitDataRow(row, pSchema);
+
+      TSKEY   key = startTime + (k + i) * 1000L;
+      int32_t val = (int32_t)(key / 1000);
+      tdAppendColVal(row, &key, TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t), schemaColAt(pSchema, 0)->offset);
+      tdAppendColVal(row, &val, TSDB_DATA_TYPE_INT, sizeof(int32_t), schemaColAt(pSchema, 1)->offset);
+      pBlock->len += dataRowLen(row);
+    }
+
+    pMsg->length = htonl(sizeof(SSubmitMsg) + sizeof(SSubmitBlk) + pBlock->len);
+    pMsg->numOfBlocks = htonl(1);
+    pBlock->uid = htobe64(TABLE_UID);
+    pBlock->tid = htonl(TABLE_TID);
+    pBlock->sversion = htonl(0);
+    pBlock->numOfRows = htons(rows);
+    pBlock->len = htonl(pBlock->len);
+
+    SShellSubmitRspMsg rsp = {0};
+    ASSERT_EQ(tsdbInsertData(pRepo, pMsg, &rsp), TSDB_CODE_SUCCESS);
+  }
+
+  free(pMsg);
+}
+
+// create a repository of 100 to 1000 rows in a block with the table, return NULL for failure
+TsdbRepoT* createRepo(char* rootDir, STsdbAppH* pAppH, STSchema* pSchema) {
+  STsdbCfg config;
+  tsdbSetDefaultCfg(&config);
+  config.maxTables = 10;
+  config.cacheBlockSize = 1;
+  config.totalBlocks = 4;
+  config.daysPerFile = DAYS_PER_FILE;
+  config.minRowsPerFileBlock = 100;
+  config.maxRowsPerFileBlock = 1000;
+  if (tsdbCreateRepo(rootDir, &config, NULL) < 0) return NULL;
+
+  TsdbRepoT* pRepo = tsdbOpenRepo(rootDir, pAppH);
+  if (pRepo == NULL) return NULL;
+
+  STableCfg tCfg;
+  tsdbInitTableCfg(&tCfg, TSDB_NORMAL_TABLE, TABLE_UID, TABLE_TID);
+  tsdbTableSetName(&tCfg, (char*)"t", true);
+  tsdbTableSetSchema(&tCfg, pSchema, true);
+  int32_t code = tsdbCreateTable(pRepo, &tCfg);
+  tsdbClearTableCfg(&tCfg);
+
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbCloseRepo(pRepo, 0);
+    return NULL;
+  }
+
+  return pRepo;
+}
+
+// the first key of the data file of now
+TSKEY getFileStartTime() {
+  int64_t interval = DAYS_PER_FILE * 86400 * 1000L;
+  return taosGetTimestampMs() / interval * interval;
+}
+
+// read all the data blocks of the table, the rows must be the ones inserted from startTime without a gap
+// return the number of rows, -1 if a row is not the expected one
+int32_t readAll(TsdbRepoT* pRepo, TSKEY startTime, int32_t* numOfBlocks) {
+  SColumnInfo cols[2] = {{0, TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t)}, {1, TSDB_DATA_TYPE_INT, sizeof(int32_t)}};
+
+  STsdbQueryCond cond = {{INT64_MIN, INT64_MAX}, TSDB_ORDER_ASC, 2, cols};
+  STableId       id = {TABLE_UID, TABLE_TID};
+
+  SArray* group = (SArray*)taosArrayInit(1, sizeof(STableId));
+  taosArrayPush(group, &id);
+  STableGroupInfo groupInfo = {1, (SArray*)taosArrayInit(1, POINTER_BYTES)};
+  taosArrayPush(groupInfo.pGroupList, &group);
+
+  TsdbQueryHandleT* pHandle = tsdbQueryTables(pRepo, &cond, &groupInfo);
+
+  int32_t rows = 0;
+  *numOfBlocks = 0;
+  while (tsdbNextDataBlock(pHandle)) {
+    SDataBlockInfo info = tsdbRetrieveDataBlockInfo(pHandle);
+    SArray*        pCols = tsdbRetrieveDataBlock(pHandle, NULL);
+
+    TSKEY*   keys = (TSKEY*)((SColumnInfoData*)taosArrayGet(pCols, 0))->pData;
+    int32_t* vals = (int32_t*)((SColumnInfoData*)taosArrayGet(pCols, 1))->pData;
+    bool     match = true;
+    for (int32_t i = 0; i < info.rows && match; ++i) {
+      TSKEY key = startTime + (rows + i) * 1000L;
+      match = (keys[i] == key && vals[i] == (int32_t)(key / 1000));
+    }
+
+    if (!match) {
+      rows = -1;
+      break;
+    }
+
+    rows += info.rows;
+    *numOfBlocks += 1;
+  }
+
+  tsdbCleanupQueryHandle(pHandle);
+  taosArrayDestroy(group);
+  taosArrayDestroy(groupInfo.pGroupList);
+  return rows;
+}
+}  // namespace
+
+TEST(testCase, tsdb_stat_test) {
+  char rootDir[] = "/tmp/tsdbStatTestXXXXXX";
+  ASSERT_TRUE(mkdtemp(rootDir) != NULL);
+  strcat(rootDir, "/tsdb");
+
+  TsdbRepoT* pRepo = NULL;
+  STsdbAppH  appH = {0};
+  appH.appH = &pRepo;
+  appH.notifyStatus = notifyStatus;
+
+  STSchema* pSchema = createSchema();
+  pRepo = createRepo(rootDir, &appH, pSchema);
+  ASSERT_TRUE(pRepo != NULL);
+
+  // commit writes blocks of 4/5 of the max rows, the rows of one file are committed into two blocks of 800 rows and
+  // one block of the rest, no sub-block or block in .last
+  numOfCommits = 0;
+  TSKEY startTime = getFileStartTime();
+  insertRows(pRepo, pSchema, startTime, 2000);
+  tsdbCloseRepo(pRepo, 1);
+
+  ASSERT_EQ(numOfCommits, 1);
+  ASSERT_EQ(commitStat.numOfBlocks, 3);
+  ASSERT_EQ(commitStat.numOfSubBlocks, 0);
+  ASSERT_EQ(commitStat.numOfLastBlocks, 0);
+  ASSERT_EQ(commitStat.numOfBlocksRead, 0);
+
+  // each block is read once by a query, and no block is shared without concurrent queries
+  pRepo = tsdbOpenRepo(rootDir, &appH);
+  ASSERT_TRUE(pRepo != NULL);
+
+  int32_t numOfBlocks = 0;
+  ASSERT_EQ(readAll(pRepo, startTime, &numOfBlocks), 2000);
+  ASSERT_EQ(numOfBlocks, 3);
+
+  STsdbRepoInfo* pInfo = tsdbGetStatus(pRepo);
+  ASSERT_EQ(pInfo->stat.numOfBlocksRead, 3);
+  ASSERT_EQ(pInfo->stat.numOfFragmentsRead, 3);
+  ASSERT_EQ(pInfo->stat.numOfBlocksShared, 0);
+  free(pInfo);
+
+  // a few rows appended to the last block are kept in .last, and counted with the blocks read before
+  insertRows(pRepo, pSchema, startTime + 2000 * 1000L, 50);
+  tsdbCloseRepo(pRepo, 1);
+
+  ASSERT_EQ(numOfCommits, 2);
+  ASSERT_EQ(commitStat.numOfBlocks, 4);
+  ASSERT_EQ(commitStat.numOfLastBlocks, 1);
+  ASSERT_EQ(commitStat.numOfBlocksRead, 3);
+
+  tdFreeSchema(pSchema);
+
+  rootDir[strlen(rootDir) - strlen("/tsdb")] = 0;
+  taosRemoveDir(rootDir);
+}
+
+// small batches committed one by one are appended to the block in .last as sub-blocks, the block is rewritten once it
+// has subBlocksToMerge fragments, and the data read back is the same either way
+TEST(testCase, tsdb_consolidate_test) {
+  int16_t   subBlocksToMerge = tsSubBlocksToMerge;
+  STSchema* pSchema = createSchema();
+
+  for (int16_t merge = 0; merge <= 4; merge += 4) {
+    tsSubBlocksToMerge = merge;
+
+    char rootDir[] = "/tmp/tsdbConsolidateTestXXXXXX";
+    ASSERT_TRUE(mkdtemp(rootDir) != NULL);
+    strcat(rootDir, "/tsdb");
+
+    TsdbRepoT* pRepo = NULL;
+    STsdbAppH  appH = {0};
+    appH.appH = &pRepo;
+    appH.notifyStatus = notifyStatus;
+
+    pRepo = createRepo(rootDir, &appH, pSchema);
+    ASSERT_TRUE(pRepo != NULL);
+
+    // one block in the data file, the small batches after it make a block in .last
+    TSKEY startTime = getFileStartTime();
+    insertRows(pRepo, pSchema, startTime, 150);
+    tsdbCloseRepo(pRepo, 1);
+
+    ASSERT_EQ(commitStat.numOfBlocks, 1);
+    ASSERT_EQ(commitStat.numOfLastBlocks, 0);
+
+    // fragments of the block in .last
+    int64_t merged = 0;
+    int64_t fragments = 0;
+    for (int32_t i = 0; i < 8; ++i) {
+      pRepo = tsdbOpenRepo(rootDir, &appH);
+      ASSERT_TRUE(pRepo != NULL);
+      insertRows(pRepo, pSchema, startTime + (150 + i * 10) * 1000L, 10);
+      tsdbCloseRepo(pRepo, 1);
+
+      ASSERT_EQ(commitStat.numOfBlocks, 2);
+      ASSERT_EQ(commitStat.numOfLastBlocks, 1);
+
+      fragments++;
+      if (merge > 0 && fragments >= merge) {
+        ASSERT_EQ(commitStat.numOfMergedBlocks, fragments);
+        fragments = 1;
+      } else {
+        ASSERT_EQ(commitStat.numOfMergedBlocks, 0);
+      }
+
+      ASSERT_EQ(commitStat.numOfSubBlocks, fragments > 1 ? fragments : 0);
+      merged += commitStat.numOfMergedBlocks;
+    }
+
+    ASSERT_EQ(merged, merge > 0 ? 8 : 0);
+
+    pRepo = tsdbOpenRepo(rootDir, &appH);
+    ASSERT_TRUE(pRepo != NULL);
+
+    int32_t numOfBlocks = 0;
+    ASSERT_EQ(readAll(pRepo, startTime, &numOfBlocks), 230);
+    ASSERT_EQ(numOfBlocks, 2);
+
+    // the block in the data file and the fragments of the one in .last
+    STsdbRepoInfo* pInfo = tsdbGetStatus(pRepo);
+    ASSERT_EQ(pInfo->stat.numOfBlocksRead, 2);
+    ASSERT_EQ(pInfo->stat.numOfFragmentsRead, 1 + fragments);
+    free(pInfo);
+    tsdbCloseRepo(pRepo, 0);
+
+    rootDir[strlen(rootDir) - strlen("/tsdb")] = 0;
+    taosRemoveDir(rootDir);
+  }
+
+  tsSubBlocksToMerge = subBlocksToMerge;
+  tdFreeSchema(pSchema);
+}
@@ -66,7 +66,7 @@ static int insertData(SInsertInfo *pInfo) {
     pMsg->numOfBlocks = 1;
 
     pBlock->len = htonl(pBlock->len);
-    pBlock->numOfRows = htonl(pBlock->numOfRows);
+    pBlock->numOfRows = htons(pInfo->rowsPerSubmit);
     pBlock->uid = htobe64(pBlock->uid);
     pBlock->tid = htonl(pBlock->tid);
 
@@ -77,7 +77,8 @@ static int insertData(SInsertInfo *pInfo) {
     pMsg->numOfBlocks = htonl(pMsg->numOfBlocks);
     pMsg->compressed = htonl(pMsg->numOfBlocks);
 
-    if (tsdbInsertData(pInfo->pRepo, pMsg) < 0) {
+    SShellSubmitRspMsg rsp = {0};
+    if (tsdbInsertData(pInfo->pRepo, pMsg, &rsp) < 0) {
       tfree(pMsg);
       return -1;
     }
@@ -132,18 +133,22 @@ TEST(TsdbTest, createRepo) {
   STsdbCfg config;
   STsdbRepo *repo;
 
+  char rootDir[] = "/tmp/tsdbTestXXXXXX";
+  ASSERT_TRUE(mkdtemp(rootDir) != NULL);
+  strcat(rootDir, "/vnode0");
+
   // 1. Create a tsdb repository
   tsdbSetDefaultCfg(&config);
-  ASSERT_EQ(tsdbCreateRepo("/home/ubuntu/work/ttest/vnode0", &config, NULL), 0);
+  ASSERT_EQ(tsdbCreateRepo(rootDir, &config, NULL), 0);
 
-  TsdbRepoT *pRepo = tsdbOpenRepo("/home/ubuntu/work/ttest/vnode0", NULL);
+  TsdbRepoT *pRepo = tsdbOpenRepo(rootDir, NULL);
   ASSERT_NE(pRepo, nullptr);
 
   // 2. Create a normal table
   STableCfg tCfg;
   ASSERT_EQ(tsdbInitTableCfg(&tCfg, TSDB_SUPER_TABLE, 987607499877672L, 0), -1);
   ASSERT_EQ(tsdbInitTableCfg(&tCfg, TSDB_NORMAL_TABLE, 987607499877672L, 0), 0);
-  tsdbTableSetName(&tCfg, "test", false);
+  tsdbTableSetName(&tCfg, (char *)"test", false);
 
   int       nCols = 5;
   STSchema *schema = tdNewSchema(nCols);
@@ -170,7 +175,7 @@ TEST(TsdbTest, createRepo) {
     .sversion = tCfg.sversion,
     .startTime = 1584081000000,
     .interval = 1000,
-    .totalRows = 10000000,
+    .totalRows = 100000,
     .rowsPerSubmit = 1,
     .pSchema = schema
   };
@@ -178,10 +183,10 @@ TEST(TsdbTest, createRepo) {
   ASSERT_EQ(insertData(&iInfo), 0);
 
   // Close the repository
-  tsdbCloseRepo(pRepo);
+  tsdbCloseRepo(pRepo, 1);
 
   // Open the repository again
-  pRepo = tsdbOpenRepo("/home/ubuntu/work/ttest/vnode0", NULL);
+  pRepo = tsdbOpenRepo(rootDir, NULL);
   repo = (STsdbRepo *)pRepo;
   ASSERT_NE(pRepo, nullptr);
 
@@ -214,7 +219,11 @@ TEST(TsdbTest, createRepo) {
   // ASSERT_EQ(tsdbLoadCompInfo(&rhelper, NULL), 0);
   // ASSERT_EQ(tsdbLoadBlockData(&rhelper, blockAtIdx(&rhelper, 0), NULL), 0);
 
-  int k = 0;
+  tsdbCloseRepo(pRepo, 0);
+  tdFreeSchema(schema);
+
+  rootDir[strlen(rootDir) - strlen("/vnode0")] = 0;
+  taosRemoveDir(rootDir);
 }
 
 TEST(TsdbTest, DISABLED_openRepo) {
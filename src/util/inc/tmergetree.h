@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TDENGINE_TMERGETREE_H
+#define TDENGINE_TMERGETREE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * The k-way merge of sources ordered by integer or timestamp keys. Unlike SLoserTreeInfo, which calls the compare
+ * function on each tree node with the data of both sources, the head keys of all sources are cached in one array and
+ * compared directly.
+ *
+ * The runner-up, i.e., the smallest head of the sources other than the winner, is kept too once the same source wins
+ * twice in a row. As long as the next key of the winner is still before the runner-up, the winner advances without
+ * adjusting the tree, and the caller may take a whole run of rows, or blocks, from the winner at once, see
+ * tMergeTreeBeforeBound.
+ *
+ * The sources of the same key are popped in the order of their indices.
+ */
+typedef struct SMergeTree {
+  int32_t   numOfEntries;
+  int32_t   winner;    // the source of the smallest head key, -1 if all sources are exhausted
+  int32_t   runnerUp;  // the source of the second smallest head key, -1 if there is only one source, see below
+  uint64_t *pKey;      // the head key of each source
+  int8_t *  pExhausted;
+  int32_t * pLoser;    // the loser of each internal node, pLoser[1] is the root
+  int32_t * pWinner;   // the winner of each node, only used when the tree is built
+} SMergeTree;
+
+// the runner-up is not found after the winner changes, until tMergeTreeBeforeBound is called
+#define MERGE_TREE_UNKNOWN_RUNNER_UP (-2)
+
+// the unsigned key of a signed integer or timestamp value, of which the order is the same as the value in order type
+#define MERGE_TREE_KEY(_v, _order) \
+  ((((uint64_t)(int64_t)(_v)) ^ (1ULL << 63u)) ^ (((_order) == TSDB_ORDER_DESC) ? UINT64_MAX : 0))
+
+/**
+ * create the merge tree, of which all the sources are exhausted. The head keys of the non-empty sources are set by
+ * tMergeTreeSetKey before tMergeTreeBuild is called. The tree is released by free.
+ * @return  NULL if out of memory
+ */
+SMergeTree *tMergeTreeCreate(int32_t numOfEntries);
+
+void tMergeTreeSetKey(SMergeTree *pTree, int32_t idx, uint64_t key);
+
+void tMergeTreeBuild(SMergeTree *pTree);
+
+/**
+ * @return  true if the key of the winner source is still before the heads of all the other sources
+ */
+bool tMergeTreeBeforeBound(SMergeTree *pTree, uint64_t key);
+
+/**
+ * the winner source moves to the next key
+ */
+void tMergeTreeAdvance(SMergeTree *pTree, uint64_t key);
+
+/**
+ * the winner source has no more data
+ */
+void tMergeTreeExhaust(SMergeTree *pTree);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // TDENGINE_TMERGETREE_H
@@ -33,6 +33,11 @@ extern "C" {
 #define NO_COMPRESSION 0
 #define ONE_STAGE_COMP 1
 #define TWO_STAGE_COMP 2
+#define TWO_STAGE_COMP_ZSTD 3  // same as TWO_STAGE_COMP, but zstd instead of LZ4 for the second stage
+
+#define IS_TWO_STAGE_COMP(_a) ((_a) == TWO_STAGE_COMP || (_a) == TWO_STAGE_COMP_ZSTD)
+
+extern int32_t tsZstdLevel;
 
 extern int tsCompressINTImp(const char *const input, const int nelements, char *const output, const char type);
 extern int tsDecompressINTImp(const char *const input, const int nelements, char *const output, const char type);
@@ -40,20 +45,35 @@ extern int tsCompressBoolImp(const char *const input, const int nelements, char
 extern int tsDecompressBoolImp(const char *const input, const int nelements, char *const output);
 extern int tsCompressStringImp(const char *const input, int inputSize, char *const output, int outputSize);
 extern int tsDecompressStringImp(const char *const input, int compressedSize, char *const output, int outputSize);
+extern int tsCompressStringZstdImp(const char *const input, int inputSize, char *const output, int outputSize);
 extern int tsCompressTimestampImp(const char *const input, const int nelements, char *const output);
 extern int tsDecompressTimestampImp(const char *const input, const int nelements, char *const output);
 extern int tsCompressDoubleImp(const char *const input, const int nelements, char *const output);
 extern int tsDecompressDoubleImp(const char *const input, const int nelements, char *const output);
 extern int tsCompressFloatImp(const char *const input, const int nelements, char *const output);
 extern int tsDecompressFloatImp(const char *const input, const int nelements, char *const output);
+extern int tsCompressRLEImp(const char *const input, const int nelements, const int bytes, char *const output);
+extern int tsDecompressRLEImp(const char *const input, const int nelements, const int bytes, char *const output);
+extern int tsCompressDictImp(const char *const input, const int nelements, const int bytes, char *const output);
+extern int tsDecompressDictImp(const char *const input, const int nelements, const int bytes, char *const output);
+
+// The second stage is decompressed by tsDecompressStringImp whichever compressor is used, the first byte tells.
+static FORCE_INLINE int tsCompressSecondStage(const char *const input, int inputSize, char *const output, int outputSize,
+                                              char algorithm) {
+  if (algorithm == TWO_STAGE_COMP_ZSTD) {
+    return tsCompressStringZstdImp(input, inputSize, output, outputSize);
+  } else {
+    return tsCompressStringImp(input, inputSize, output, outputSize);
+  }
+}
 
 static FORCE_INLINE int tsCompressTinyint(const char *const input, int inputSize, const int nelements, char *const output, int outputSize, char algorithm,
                       char *const buffer, int bufferSize) {
   if (algorithm == ONE_STAGE_COMP) {
     return tsCompressINTImp(input, nelements, output, TSDB_DATA_TYPE_TINYINT);
-  } else if (algorithm == TWO_STAGE_COMP) {
+  } else if (IS_TWO_STAGE_COMP(algorithm)) {
     int len = tsCompressINTImp(input, nelements, buffer, TSDB_DATA_TYPE_TINYINT);
-    return tsCompressStringImp(buffer, len, output, outputSize);
+    return tsCompressSecondStage(buffer, len, output, outputSize, algorithm);
   } else {
     assert(0);
   }
@@ -63,7 +83,7 @@ static FORCE_INLINE int tsDecompressTinyint(const char *const input, int compres
                         int outputSize, char algorithm, char *const buffer, int bufferSize) {
   if (algorithm == ONE_STAGE_COMP) {
     return tsDecompressINTImp(input, nelements, output, TSDB_DATA_TYPE_TINYINT);
-  } else if (algorithm == TWO_STAGE_COMP) {
+  } else if (IS_TWO_STAGE_COMP(algorithm)) {
     tsDecompressStringImp(input, compressedSize, buffer, bufferSize);
     return tsDecompressINTImp(buffer, nelements, output, TSDB_DATA_TYPE_TINYINT);
   } else {
@@ -75,9 +95,9 @@ static FORCE_INLINE int tsCompressSmallint(const char *const input, int inputSiz
                        char *const buffer, int bufferSize) {
   if (algorithm == ONE_STAGE_COMP) {
     return tsCompressINTImp(input, nelements, output, TSDB_DATA_TYPE_SMALLINT);
-  } else if (algorithm == TWO_STAGE_COMP) {
+  } else if (IS_TWO_STAGE_COMP(algorithm)) {
     int len = tsCompressINTImp(input, nelements, buffer, TSDB_DATA_TYPE_SMALLINT);
-    return tsCompressStringImp(buffer, len, output, outputSize);
+    return tsCompressSecondStage(buffer, len, output, outputSize, algorithm);
   } else {
     assert(0);
   }
@@ -87,7 +107,7 @@ static FORCE_INLINE int tsDecompressSmallint(const char *const input, int compre
                          int outputSize, char algorithm, char *const buffer, int bufferSize) {
   if (algorithm == ONE_STAGE_COMP) {
     return tsDecompressINTImp(input, nelements, output, TSDB_DATA_TYPE_SMALLINT);
-  } else if (algorithm == TWO_STAGE_COMP) {
+  } else if (IS_TWO_STAGE_COMP(algorithm)) {
     tsDecompressStringImp(input, compressedSize, buffer, bufferSize);
     return tsDecompressINTImp(buffer, nelements, output, TSDB_DATA_TYPE_SMALLINT);
   } else {
@@ -99,9 +119,9 @@ static FORCE_INLINE int tsCompressInt(const char *const input, int inputSize, co
                   char *const buffer, int bufferSize) {
   if (algorithm == ONE_STAGE_COMP) {
     return tsCompressINTImp(input, nelements, output, TSDB_DATA_TYPE_INT);
-  } else if (algorithm == TWO_STAGE_COMP) {
+  } else if (IS_TWO_STAGE_COMP(algorithm)) {
     int len = tsCompressINTImp(input, nelements, buffer, TSDB_DATA_TYPE_INT);
-    return tsCompressStringImp(buffer, len, output, outputSize);
+    return tsCompressSecondStage(buffer, len, output, outputSize, algorithm);
   } else {
     assert(0);
   }
@@ -111,7 +131,7 @@ static FORCE_INLINE int tsDecompressInt(const char *const input, int compressedS
                     int outputSize, char algorithm, char *const buffer, int bufferSize) {
   if (algorithm == ONE_STAGE_COMP) {
     return tsDecompressINTImp(input, nelements, output, TSDB_DATA_TYPE_INT);
-  } else if (algorithm == TWO_STAGE_COMP) {
+  } else if (IS_TWO_STAGE_COMP(algorithm)) {
     tsDecompressStringImp(input, compressedSize, buffer, bufferSize);
     return tsDecompressINTImp(buffer, nelements, output, TSDB_DATA_TYPE_INT);
   } else {
@@ -123,9 +143,9 @@ static FORCE_INLINE int tsCompressBigint(const char *const input, int inputSize,
                      char algorithm, char *const buffer, int bufferSize) {
   if (algorithm == ONE_STAGE_COMP) {
     return tsCompressINTImp(input, nelements, output, TSDB_DATA_TYPE_BIGINT);
-  } else if (algorithm == TWO_STAGE_COMP) {
+  } else if (IS_TWO_STAGE_COMP(algorithm)) {
     int len = tsCompressINTImp(input, nelements, buffer, TSDB_DATA_TYPE_BIGINT);
-    return tsCompressStringImp(buffer, len, output, outputSize);
+    return tsCompressSecondStage(buffer, len, output, outputSize, algorithm);
   } else {
     assert(0);
   }
@@ -135,7 +155,7 @@ static FORCE_INLINE int tsDecompressBigint(const char *const input, int compress
                        int outputSize, char algorithm, char *const buffer, int bufferSize) {
   if (algorithm == ONE_STAGE_COMP) {
     return tsDecompressINTImp(input, nelements, output, TSDB_DATA_TYPE_BIGINT);
-  } else if (algorithm == TWO_STAGE_COMP) {
+  } else if (IS_TWO_STAGE_COMP(algorithm)) {
     tsDecompressStringImp(input, compressedSize, buffer, bufferSize);
     return tsDecompressINTImp(buffer, nelements, output, TSDB_DATA_TYPE_BIGINT);
   } else {
@@ -147,9 +167,9 @@ static FORCE_INLINE int tsCompressBool(const char *const input, int inputSize, c
                    char algorithm, char *const buffer, int bufferSize) {
   if (algorithm == ONE_STAGE_COMP) {
     return tsCompressBoolImp(input, nelements, output);
-  } else if (algorithm == TWO_STAGE_COMP) {
+  } else if (IS_TWO_STAGE_COMP(algorithm)) {
     int len = tsCompressBoolImp(input, nelements, buffer);
-    return tsCompressStringImp(buffer, len, output, outputSize);
+    return tsCompressSecondStage(buffer, len, output, outputSize, algorithm);
   } else {
     assert(0);
   }
@@ -159,7 +179,7 @@ static FORCE_INLINE int tsDecompressBool(const char *const input, int compressed
                      int outputSize, char algorithm, char *const buffer, int bufferSize) {
   if (algorithm == ONE_STAGE_COMP) {
     return tsDecompressBoolImp(input, nelements, output);
-  } else if (algorithm == TWO_STAGE_COMP) {
+  } else if (IS_TWO_STAGE_COMP(algorithm)) {
     tsDecompressStringImp(input, compressedSize, buffer, bufferSize);
     return tsDecompressBoolImp(buffer, nelements, output);
   } else {
@@ -169,7 +189,7 @@ static FORCE_INLINE int tsDecompressBool(const char *const input, int compressed
 
 static FORCE_INLINE int tsCompressString(const char *const input, int inputSize, const int nelements, char *const output, int outputSize,
                      char algorithm, char *const buffer, int bufferSize) {
-  return tsCompressStringImp(input, inputSize, output, outputSize);
+  return tsCompressSecondStage(input, inputSize, output, outputSize, algorithm);
 }
 
 static FORCE_INLINE int tsDecompressString(const char *const input, int compressedSize, const int nelements, char *const output,
@@ -181,9 +201,9 @@ static FORCE_INLINE int tsCompressFloat(const char *const input, int inputSize,
                     char algorithm, char *const buffer, int bufferSize) {
   if (algorithm == ONE_STAGE_COMP) {
     return tsCompressFloatImp(input, nelements, output);
-  } else if (algorithm == TWO_STAGE_COMP) {
+  } else if (IS_TWO_STAGE_COMP(algorithm)) {
     int len = tsCompressFloatImp(input, nelements, buffer);
-    return tsCompressStringImp(buffer, len, output, outputSize);
+    return tsCompressSecondStage(buffer, len, output, outputSize, algorithm);
   } else {
     assert(0);
   }
@@ -193,7 +213,7 @@ static FORCE_INLINE int tsDecompressFloat(const char *const input, int compresse
                       int outputSize, char algorithm, char *const buffer, int bufferSize) {
   if (algorithm == ONE_STAGE_COMP) {
     return tsDecompressFloatImp(input, nelements, output);
-  } else if (algorithm == TWO_STAGE_COMP) {
+  } else if (IS_TWO_STAGE_COMP(algorithm)) {
     tsDecompressStringImp(input, compressedSize, buffer, bufferSize);
     return tsDecompressFloatImp(buffer, nelements, output);
   } else {
@@ -205,9 +225,9 @@ static FORCE_INLINE int tsCompressDouble(const char *const input, int inputSize,
                      char algorithm, char *const buffer, int bufferSize) {
   if (algorithm == ONE_STAGE_COMP) {
     return tsCompressDoubleImp(input, nelements, output);
-  } else if (algorithm == TWO_STAGE_COMP) {
+  } else if (IS_TWO_STAGE_COMP(algorithm)) {
     int len = tsCompressDoubleImp(input, nelements, buffer);
-    return tsCompressStringImp(buffer, len, output, outputSize);
+    return tsCompressSecondStage(buffer, len, output, outputSize, algorithm);
   } else {
     assert(0);
   }
@@ -217,7 +237,7 @@ static FORCE_INLINE int tsDecompressDouble(const char *const input, int compress
                        int outputSize, char algorithm, char *const buffer, int bufferSize) {
   if (algorithm == ONE_STAGE_COMP) {
     return tsDecompressDoubleImp(input, nelements, output);
-  } else if (algorithm == TWO_STAGE_COMP) {
+  } else if (IS_TWO_STAGE_COMP(algorithm)) {
     tsDecompressStringImp(input, compressedSize, buffer, bufferSize);
     return tsDecompressDoubleImp(buffer, nelements, output);
   } else {
@@ -229,9 +249,9 @@ static FORCE_INLINE int tsCompressTimestamp(const char *const input, int inputSi
                         char algorithm, char *const buffer, int bufferSize) {
   if (algorithm == ONE_STAGE_COMP) {
     return tsCompressTimestampImp(input, nelements, output);
-  } else if (algorithm == TWO_STAGE_COMP) {
+  } else if (IS_TWO_STAGE_COMP(algorithm)) {
     int len = tsCompressTimestampImp(input, nelements, buffer);
-    return tsCompressStringImp(buffer, len, output, outputSize);
+    return tsCompressSecondStage(buffer, len, output, outputSize, algorithm);
   } else {
     assert(0);
   }
@@ -241,7 +261,7 @@ static FORCE_INLINE int tsDecompressTimestamp(const char *const input, int compr
                           int outputSize, char algorithm, char *const buffer, int bufferSize) {
   if (algorithm == ONE_STAGE_COMP) {
     return tsDecompressTimestampImp(input, nelements, output);
-  } else if (algorithm == TWO_STAGE_COMP) {
+  } else if (IS_TWO_STAGE_COMP(algorithm)) {
     tsDecompressStringImp(input, compressedSize, buffer, bufferSize);
     return tsDecompressTimestampImp(buffer, nelements, output);
   } else {
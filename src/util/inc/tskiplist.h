@@ -102,8 +102,13 @@ typedef struct tSkipListState {
   uint64_t nTotalElapsedTimeForInsert;
 } tSkipListState;
 
+// how the node with a key already in the skip list is handled
+#define SL_DISCARD_DUP_KEY 0  // the new node is discarded
+#define SL_ALLOW_DUP_KEY   1  // both nodes are kept
+#define SL_UPDATE_DUP_KEY  2  // the new node replaces the old one
+
 typedef struct SSkipListKeyInfo {
-  uint8_t dupKey : 2;  // if allow duplicated key in the skip list
+  uint8_t dupKey : 2;  // SL_*_DUP_KEY
   uint8_t type : 4;    // key type
   uint8_t freeNode:2;  // free node when destroy the skiplist
   uint8_t len;         // maximum key length, used in case of string key
@@ -120,6 +125,7 @@ typedef struct SSkipList {
   SSkipListNode *   pHead;    // point to the first element
   SSkipListNode *   pTail;    // point to the last element
   void *            lastKey;  // last key in the skiplist
+  SArray *          pReplaced;  // nodes replaced in SL_UPDATE_DUP_KEY mode, freed with the skiplist if freeNode is set
 #if SKIP_LIST_RECORD_PERFORMANCE
   tSkipListState state;  // skiplist state
 #endif
@@ -142,7 +148,7 @@ typedef struct SSkipListIterator {
  *
  * @param nMaxLevel   maximum skip list level
  * @param keyType     type of key
- * @param dupKey      allow the duplicated key in the skip list
+ * @param dupKey      SL_DISCARD_DUP_KEY, SL_ALLOW_DUP_KEY or SL_UPDATE_DUP_KEY
  * @return
  */
 SSkipList *tSkipListCreate(uint8_t nMaxLevel, uint8_t keyType, uint8_t keyLen, uint8_t dupKey, uint8_t threadsafe,
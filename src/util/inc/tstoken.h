@@ -24,14 +24,15 @@ extern "C" {
 #include "tutil.h"
 #include "ttokendef.h"
 
-#define TK_SPACE      200
-#define TK_COMMENT    201
-#define TK_ILLEGAL    202
-#define TK_HEX        203   // hex number  0x123
-#define TK_OCT        204   // oct number
-#define TK_BIN        205   // bin format data 0b111
-#define TK_FILE       206
-#define TK_QUESTION   207   // denoting the placeholder of "?",when invoking statement bind query
+// tokens not passed to the parser, numbered above the ones of the grammar in ttokendef.h
+#define TK_SPACE      300
+#define TK_COMMENT    301
+#define TK_ILLEGAL    302
+#define TK_HEX        303   // hex number  0x123
+#define TK_OCT        304   // oct number
+#define TK_BIN        305   // bin format data 0b111
+#define TK_FILE       306
+#define TK_QUESTION   307   // denoting the placeholder of "?",when invoking statement bind query
 
 #define TSQL_TBNAME   "TBNAME"
 #define TSQL_TBNAME_L "tbname"
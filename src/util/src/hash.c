@@ -454,8 +454,14 @@ int32_t taosHashGetMaxOverflowLinkLength(const SHashObj *pHashObj) {
 }
 
 void doUpdateHashTable(SHashObj *pHashObj, SHashNode *pNode) {
-  if (pNode->prev1) {
-    pNode->prev1->next = pNode;
+  int32_t     index = HASH_INDEX(pNode->hashVal, pHashObj->capacity);
+  SHashEntry *pEntry = pHashObj->hashList[index];
+
+  // the node may be moved by realloc, the previous node, or the entry if it is the first one, should point to it
+  if (pNode->prev1 == pEntry) {
+    pEntry->next = pNode;
+  } else if (pNode->prev) {
+    pNode->prev->next = pNode;
   }
   
   if (pNode->next) {
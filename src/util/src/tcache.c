@@ -222,7 +222,12 @@ static FORCE_INLINE void taosCacheReleaseNode(SCacheObj *pCacheObj, SCacheDataNo
  * @param pNode
  */
 static FORCE_INLINE void taosCacheMoveToTrash(SCacheObj *pCacheObj, SCacheDataNode *pNode) {
-  taosHashRemove(pCacheObj->pHashTable, pNode->key, pNode->keySize);
+  // the key may have been updated by another thread, then the new node of the key is kept in hash table
+  SCacheDataNode **pt = (SCacheDataNode **)taosHashGet(pCacheObj->pHashTable, pNode->key, pNode->keySize);
+  if (pt != NULL && *pt == pNode) {
+    taosHashRemove(pCacheObj->pHashTable, pNode->key, pNode->keySize);
+  }
+
   taosAddToTrash(pCacheObj, pNode);
 }
 
@@ -542,15 +547,18 @@ void taosCacheRelease(SCacheObj *pCacheObj, void **data, bool _remove) {
   }
   
   *data = NULL;
-  int16_t ref = T_REF_DEC(pNode);
-  uTrace("%p data released, refcnt:%d", pNode, ref);
   
   if (_remove) {
+    // pNode may be updated in place by taosCachePut once its reference count is 0, so it is moved into trash before
+    // the reference count is decreased, both with the lock held
     __cache_wr_lock(pCacheObj);
-    // pNode may be released immediately by other thread after the reference count of pNode is set to 0,
-    // So we need to lock it in the first place.
     taosCacheMoveToTrash(pCacheObj, pNode);
+    int16_t ref = T_REF_DEC(pNode);
     __cache_unlock(pCacheObj);
+    uTrace("%p data released, refcnt:%d", pNode, ref);
+  } else {
+    int16_t ref = T_REF_DEC(pNode);
+    uTrace("%p data released, refcnt:%d", pNode, ref);
   }
 }
 
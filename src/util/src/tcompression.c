@@ -36,7 +36,8 @@
  *   better when there are a lot of consecutive true values or false values.
  *
  * STRING Compression Algorithm:
- *   We us LZ4 method to compress the string type.
+ *   We us LZ4 method to compress the string type. It is also the second stage of the two stage compression, where
+ *   zstd may be used instead to trade compression speed for a better compression ratio.
  *
  * FLOAT Compression Algorithm:
  *   We use the same method with Akumuli to compress float and double types. The compression
@@ -45,12 +46,19 @@
  *   of leading zeros are larger than the trailing zeros, then record the last serveral bytes
  *   of the XORed value with informations. If not, record the first corresponding bytes.
  *
+ * RLE/DICTIONARY Compression Algorithm (for values of any fixed size):
+ *   Run length encoding records each run of identical values as the run length and the value.
+ *   Dictionary encoding records at most 256 distinct values and a one byte index for each value.
+ *   They are chosen per column block instead of the algorithm of the type when they work better.
+ *
  */
 
 #include "os.h"
 #include "lz4.h"
+#include "zstd.h"
 #include "tscompression.h"
 #include "taosdef.h"
+#include "hashfunc.h"
 
 const int TEST_NUMBER = 1;
 #define is_bigendian() ((*(char *)&TEST_NUMBER) == 0)
@@ -387,6 +395,171 @@ int tsDecompressBoolRLEImp(const char *const input, const int nelements, char *c
   }
 }
 
+/* Run Length Encoding(RLE) for fixed size values: | run (uint16_t) | value | ... */
+int tsCompressRLEImp(const char *const input, const int nelements, const int bytes, char *const output) {
+  int _pos = 0;
+
+  for (int i = 0; i < nelements;) {
+    const char *val = input + i * bytes;
+    uint16_t    counter = 1;
+
+    for (++i; i < nelements && counter < UINT16_MAX; i++, counter++) {
+      if (memcmp(val, input + i * bytes, bytes) != 0) break;
+    }
+
+    memcpy(output + _pos, &counter, sizeof(counter));
+    memcpy(output + _pos + sizeof(counter), val, bytes);
+    _pos += sizeof(counter) + bytes;
+  }
+
+  return _pos;
+}
+
+int tsDecompressRLEImp(const char *const input, const int nelements, const int bytes, char *const output) {
+  int ipos = 0, opos = 0;
+  while (opos < nelements) {
+    uint16_t counter = 0;
+    memcpy(&counter, input + ipos, sizeof(counter));
+    ipos += sizeof(counter);
+
+    for (int i = 0; i < counter && opos < nelements; i++, opos++) {
+      memcpy(output + opos * bytes, input + ipos, bytes);
+    }
+    ipos += bytes;
+  }
+
+  return nelements * bytes;
+}
+
+/*
+ * Dictionary encoding for fixed size values: | numOfEntries (uint16_t) | entries | index (uint8_t) of each value |
+ * The output must be able to hold sizeof(uint16_t) + DICT_MAX_ENTRIES * bytes + nelements bytes.
+ * Return -1 if there are more than DICT_MAX_ENTRIES distinct values.
+ */
+#define DICT_MAX_ENTRIES 256
+#define DICT_HASH_SLOTS (DICT_MAX_ENTRIES * 2)
+
+int tsCompressDictImp(const char *const input, const int nelements, const int bytes, char *const output) {
+  char    *entries = output + sizeof(uint16_t);
+  uint8_t *index = (uint8_t *)entries + DICT_MAX_ENTRIES * bytes;
+  int16_t  slots[DICT_HASH_SLOTS];
+  uint16_t numOfEntries = 0;
+
+  memset(slots, -1, sizeof(slots));
+
+  for (int i = 0; i < nelements; i++) {
+    const char *val = input + i * bytes;
+
+    // open addressing, the table never gets full as it has twice the slots of entries
+    uint32_t slot = MurmurHash3_32(val, bytes) % DICT_HASH_SLOTS;
+    while (slots[slot] >= 0 && memcmp(entries + slots[slot] * bytes, val, bytes) != 0) {
+      slot = (slot + 1) % DICT_HASH_SLOTS;
+    }
+
+    if (slots[slot] < 0) {
+      if (numOfEntries >= DICT_MAX_ENTRIES) return -1;
+      memcpy(entries + numOfEntries * bytes, val, bytes);
+      slots[slot] = numOfEntries++;
+    }
+
+    index[i] = (uint8_t)slots[slot];
+  }
+
+  memcpy(output, &numOfEntries, sizeof(numOfEntries));
+  memmove(entries + numOfEntries * bytes, index, nelements);
+
+  return sizeof(uint16_t) + numOfEntries * bytes + nelements;
+}
+
+int tsDecompressDictImp(const char *const input, const int nelements, const int bytes, char *const output) {
+  uint16_t numOfEntries = 0;
+  memcpy(&numOfEntries, input, sizeof(numOfEntries));
+
+  const char    *entries = input + sizeof(uint16_t);
+  const uint8_t *index = (const uint8_t *)entries + numOfEntries * bytes;
+
+  for (int i = 0; i < nelements; i++) {
+    memcpy(output + i * bytes, entries + index[i] * bytes, bytes);
+  }
+
+  return nelements * bytes;
+}
+
+/* ----------------------------------------------Zstd Compression
+ * ---------------------------------------------- */
+int32_t tsZstdLevel = 3;
+
+// The zstd contexts are kept per thread and reused, as creating a context costs more than compressing a block.
+static pthread_once_t zstdCtxOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t  zstdCCtxKey;
+static pthread_key_t  zstdDCtxKey;
+
+static void tsFreeZstdCCtx(void *ctx) { ZSTD_freeCCtx((ZSTD_CCtx *)ctx); }
+static void tsFreeZstdDCtx(void *ctx) { ZSTD_freeDCtx((ZSTD_DCtx *)ctx); }
+
+static void tsInitZstdCtxKeys(void) {
+  pthread_key_create(&zstdCCtxKey, tsFreeZstdCCtx);
+  pthread_key_create(&zstdDCtxKey, tsFreeZstdDCtx);
+}
+
+static ZSTD_CCtx *tsGetZstdCCtx() {
+  pthread_once(&zstdCtxOnce, tsInitZstdCtxKeys);
+  ZSTD_CCtx *ctx = pthread_getspecific(zstdCCtxKey);
+  if (ctx == NULL) {
+    ctx = ZSTD_createCCtx();
+    pthread_setspecific(zstdCCtxKey, ctx);
+  }
+  return ctx;
+}
+
+static ZSTD_DCtx *tsGetZstdDCtx() {
+  pthread_once(&zstdCtxOnce, tsInitZstdCtxKeys);
+  ZSTD_DCtx *ctx = pthread_getspecific(zstdDCtxKey);
+  if (ctx == NULL) {
+    ctx = ZSTD_createDCtx();
+    pthread_setspecific(zstdDCtxKey, ctx);
+  }
+  return ctx;
+}
+
+// Same output format as tsCompressStringImp, with indicator 2 for data compressed by zstd.
+int tsCompressStringZstdImp(const char *const input, int inputSize, char *const output, int outputSize) {
+  size_t     compressed_data_size = 0;
+  ZSTD_CCtx *ctx = tsGetZstdCCtx();
+
+  if (ctx != NULL) {
+    compressed_data_size = ZSTD_compressCCtx(ctx, output + 1, outputSize - 1, input, inputSize, tsZstdLevel);
+  }
+
+  // If cannot compress or after compression, data becomes larger.
+  if (ctx == NULL || ZSTD_isError(compressed_data_size) || compressed_data_size > (size_t)inputSize) {
+    output[0] = 0;
+    memcpy(output + 1, input, inputSize);
+    return inputSize + 1;
+  }
+
+  output[0] = 2;
+  return (int)compressed_data_size + 1;
+}
+
+static int tsDecompressStringZstdImp(const char *const input, int compressedSize, char *const output, int outputSize) {
+  ZSTD_DCtx *ctx = tsGetZstdDCtx();
+  if (ctx == NULL) {
+    perror("Failed to create zstd decompression context!\n");
+    exit(EXIT_FAILURE);
+  }
+
+  size_t decompressed_size = ZSTD_decompressDCtx(ctx, output, outputSize, input, compressedSize);
+  if (ZSTD_isError(decompressed_size)) {
+    char msg[128] = {0};
+    sprintf(msg, "%s, Error decompress in zstd algorithm!\n", ZSTD_getErrorName(decompressed_size));
+    perror(msg);
+    exit(EXIT_FAILURE);
+  }
+
+  return (int)decompressed_size;
+}
+
 /* ----------------------------------------------String Compression
  * ---------------------------------------------- */
 // Note: the size of the output must be larger than input_size + 1 and
@@ -421,6 +594,9 @@ int tsDecompressStringImp(const char *const input, int compressedSize, char *con
     }
 
     return decompressed_size;
+  } else if (input[0] == 2) {
+    /* It is compressed by zstd algorithm */
+    return tsDecompressStringZstdImp(input + 1, compressedSize - 1, output, outputSize);
   } else if (input[0] == 0) {
     /* It is not compressed by LZ4 algorithm */
     memcpy(output, input + 1, compressedSize - 1);
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "os.h"
+#include "tulog.h"
+#include "tutil.h"
+#include "tmergetree.h"
+
+/*
+ * The sources are the leaves numOfEntries, ..., 2 * numOfEntries - 1 of the implicit binary tree, and the internal
+ * nodes 1, ..., numOfEntries - 1 keep the loser of the match between the winners of their children.
+ */
+
+// the exhausted sources are after all the others
+static FORCE_INLINE bool isBefore(SMergeTree *pTree, int32_t left, int32_t right) {
+  if (pTree->pKey[left] != pTree->pKey[right]) {
+    return pTree->pKey[left] < pTree->pKey[right];
+  }
+
+  if (pTree->pExhausted[left] != pTree->pExhausted[right]) {
+    return pTree->pExhausted[right];
+  }
+
+  return left < right;
+}
+
+// the runner-up is one of the sources that lost to the winner, which are the losers on the path of the winner
+static void updateRunnerUp(SMergeTree *pTree) {
+  pTree->runnerUp = -1;
+
+  for (int32_t p = (pTree->winner + pTree->numOfEntries) >> 1; p > 0; p >>= 1) {
+    int32_t loser = pTree->pLoser[p];
+    if (pTree->runnerUp == -1 || isBefore(pTree, loser, pTree->runnerUp)) {
+      pTree->runnerUp = loser;
+    }
+  }
+}
+
+SMergeTree *tMergeTreeCreate(int32_t numOfEntries) {
+  assert(numOfEntries > 0);
+
+  // the winners of all the nodes are kept when the tree is built
+  size_t size = sizeof(SMergeTree) + (sizeof(uint64_t) + sizeof(int32_t) * 3 + sizeof(int8_t)) * numOfEntries;
+
+  SMergeTree *p = (SMergeTree *)calloc(1, size);
+  if (p == NULL) {
+    uError("allocate memory for merge tree failed. reason:%s", strerror(errno));
+    return NULL;
+  }
+
+  p->numOfEntries = numOfEntries;
+  p->pKey = (uint64_t *)((char *)p + sizeof(SMergeTree));
+  p->pLoser = (int32_t *)((char *)p->pKey + sizeof(uint64_t) * numOfEntries);
+  p->pWinner = p->pLoser + numOfEntries;
+  p->pExhausted = (int8_t *)((char *)p->pWinner + sizeof(int32_t) * numOfEntries * 2);
+
+  for (int32_t i = 0; i < numOfEntries; ++i) {
+    p->pKey[i] = UINT64_MAX;
+    p->pExhausted[i] = 1;
+  }
+
+  p->winner = -1;
+  p->runnerUp = MERGE_TREE_UNKNOWN_RUNNER_UP;
+  return p;
+}
+
+void tMergeTreeSetKey(SMergeTree *pTree, int32_t idx, uint64_t key) {
+  assert(idx >= 0 && idx < pTree->numOfEntries);
+
+  pTree->pKey[idx] = key;
+  pTree->pExhausted[idx] = 0;
+}
+
+void tMergeTreeBuild(SMergeTree *pTree) {
+  int32_t  num = pTree->numOfEntries;
+  int32_t *pWinner = pTree->pWinner;
+
+  for (int32_t i = 0; i < num; ++i) {
+    pWinner[num + i] = i;
+  }
+
+  for (int32_t p = num - 1; p > 0; --p) {
+    int32_t left = pWinner[p << 1];
+    int32_t right = pWinner[(p << 1) + 1];
+
+    if (isBefore(pTree, left, right)) {
+      pWinner[p] = left;
+      pTree->pLoser[p] = right;
+    } else {
+      pWinner[p] = right;
+      pTree->pLoser[p] = left;
+    }
+  }
+
+  pTree->winner = (num == 1) ? 0 : pWinner[1];
+  pTree->runnerUp = MERGE_TREE_UNKNOWN_RUNNER_UP;
+
+  if (pTree->pExhausted[pTree->winner]) {
+    pTree->winner = -1;
+  }
+}
+
+bool tMergeTreeBeforeBound(SMergeTree *pTree, uint64_t key) {
+  if (pTree->runnerUp == MERGE_TREE_UNKNOWN_RUNNER_UP) {
+    updateRunnerUp(pTree);
+  }
+
+  int32_t r = pTree->runnerUp;
+  if (r == -1 || pTree->pExhausted[r]) {
+    return true;
+  }
+
+  return key < pTree->pKey[r] || (key == pTree->pKey[r] && pTree->winner < r);
+}
+
+static void adjust(SMergeTree *pTree) {
+  int32_t w = pTree->winner;
+
+  for (int32_t p = (w + pTree->numOfEntries) >> 1; p > 0; p >>= 1) {
+    if (isBefore(pTree, pTree->pLoser[p], w)) {
+      int32_t t = pTree->pLoser[p];
+      pTree->pLoser[p] = w;
+      w = t;
+    }
+  }
+
+  /*
+   * the runner-up is found again only if the same source wins, which is likely to have a run of keys before all the
+   * others. When the sources are interleaved, the walk of the path of the new winner is saved.
+   */
+  bool sameWinner = (w == pTree->winner);
+
+  pTree->winner = w;
+  pTree->runnerUp = MERGE_TREE_UNKNOWN_RUNNER_UP;
+
+  if (pTree->pExhausted[w]) {
+    pTree->winner = -1;
+  } else if (sameWinner) {
+    updateRunnerUp(pTree);
+  }
+}
+
+void tMergeTreeAdvance(SMergeTree *pTree, uint64_t key) {
+  assert(pTree->winner >= 0);
+
+  // the winner is still before all the others, so are the results of all the matches on its path
+  bool before = (pTree->runnerUp != MERGE_TREE_UNKNOWN_RUNNER_UP) && tMergeTreeBeforeBound(pTree, key);
+  pTree->pKey[pTree->winner] = key;
+
+  if (!before) {
+    adjust(pTree);
+  }
+}
+
+void tMergeTreeExhaust(SMergeTree *pTree) {
+  assert(pTree->winner >= 0);
+
+  pTree->pKey[pTree->winner] = UINT64_MAX;
+  pTree->pExhausted[pTree->winner] = 1;
+  adjust(pTree);
+}
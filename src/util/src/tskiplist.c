@@ -71,6 +71,8 @@ memset(pNode, 0, SL_NODE_HEADER_SIZE(_l));\
 } while(0)
 
 static void tSkipListDoInsert(SSkipList *pSkipList, SSkipListNode **forward, SSkipListNode *pNode);
+static void tSkipListDoReplace(SSkipList *pSkipList, SSkipListNode **forward, SSkipListNode *pOld,
+                               SSkipListNode *pNode);
 static SSkipListNode* tSkipListPushBack(SSkipList *pSkipList, SSkipListNode *pNode);
 static SSkipListNode* tSkipListPushFront(SSkipList* pSkipList, SSkipListNode *pNode);
 static SSkipListIterator* doCreateSkipListIterator(SSkipList *pSkipList, int32_t order);
@@ -205,6 +207,13 @@ void *tSkipListDestroy(SSkipList *pSkipList) {
     }
   }
 
+  if (pSkipList->pReplaced != NULL) {
+    for (int32_t i = 0; i < taosArrayGetSize(pSkipList->pReplaced); ++i) {
+      free(taosArrayGetP(pSkipList->pReplaced, i));
+    }
+    taosArrayDestroy(pSkipList->pReplaced);
+  }
+
   if (pSkipList->lock) {
     pthread_rwlock_unlock(pSkipList->lock);
     pthread_rwlock_destroy(pSkipList->lock);
@@ -272,14 +281,19 @@ SSkipListNode *tSkipListPut(SSkipList *pSkipList, SSkipListNode *pNode) {
   }
 
   // if the skip list does not allowed identical key inserted, the new data will be discarded.
-  if (pSkipList->keyInfo.dupKey == 0 && ret == 0) {
+  if (pSkipList->keyInfo.dupKey == SL_DISCARD_DUP_KEY && ret == 0) {
     if (pSkipList->lock) {
       pthread_rwlock_unlock(pSkipList->lock);
     }
 
     return forward[0];
   }
-  
+
+  if (pSkipList->keyInfo.dupKey == SL_UPDATE_DUP_KEY && ret == 0) {
+    tSkipListDoReplace(pSkipList, forward, SL_GET_FORWARD_POINTER(forward[0], 0), pNode);
+    return pNode;
+  }
+
   tSkipListDoInsert(pSkipList, forward, pNode);
   return pNode;
 }
@@ -675,6 +689,49 @@ void tSkipListDoInsert(SSkipList *pSkipList, SSkipListNode **forward, SSkipListN
   }
 }
 
+/*
+ * The new node takes the place of the node with the identical key. At each level, the link to the old node is
+ * switched to the new one by a single store, and the pointers of the old node are kept, so an iterator reading
+ * without the lock sees either the old node or the new one, and one staying on the old node moves on to its
+ * successor. For the same reason, the old node is not freed until the skip list is destroyed.
+ */
+void tSkipListDoReplace(SSkipList *pSkipList, SSkipListNode **forward, SSkipListNode *pOld, SSkipListNode *pNode) {
+  DO_MEMSET_PTR_AREA(pNode);
+
+  int32_t level = MAX(pOld->level, pNode->level);
+  for (int32_t i = 0; i < level; ++i) {
+    SSkipListNode *prev = forward[i];
+    SSkipListNode *next = SL_GET_FORWARD_POINTER(prev, i);
+    if (i < pOld->level) {
+      assert(next == pOld);
+      next = SL_GET_FORWARD_POINTER(pOld, i);
+    }
+
+    if (i < pNode->level) {
+      SL_GET_BACKWARD_POINTER(pNode, i) = prev;
+      SL_GET_FORWARD_POINTER(pNode, i) = next;
+      atomic_store_ptr(&SL_GET_FORWARD_POINTER(prev, i), pNode);
+      atomic_store_ptr(&SL_GET_BACKWARD_POINTER(next, i), pNode);
+    } else {
+      atomic_store_ptr(&SL_GET_FORWARD_POINTER(prev, i), next);
+      atomic_store_ptr(&SL_GET_BACKWARD_POINTER(next, i), prev);
+    }
+  }
+
+  if (SL_GET_FORWARD_POINTER(pNode, 0) == pSkipList->pTail) {
+    pSkipList->lastKey = SL_GET_NODE_KEY(pSkipList, pNode);
+  }
+
+  if (pSkipList->keyInfo.freeNode) {
+    if (pSkipList->pReplaced == NULL) pSkipList->pReplaced = taosArrayInit(4, POINTER_BYTES);
+    taosArrayPush(pSkipList->pReplaced, &pOld);
+  }
+
+  if (pSkipList->lock) {
+    pthread_rwlock_unlock(pSkipList->lock);
+  }
+}
+
 SSkipListNode* tSkipListPushFront(SSkipList* pSkipList, SSkipListNode *pNode) {
   SSkipListNode* forward[MAX_SKIP_LIST_LEVEL] = {0};
   for(int32_t i = 0; i < pSkipList->level; ++i) {
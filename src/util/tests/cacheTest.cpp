@@ -135,4 +135,30 @@ TEST(testCase, cache_resize_test) {
   printf("retrieve %d object cost:%" PRIu64 " us,avg:%f\n", num, endTime - startTime, (endTime - startTime)/(double)num);
 
   taosCacheCleanup(pCache);
-}
\ No newline at end of file
+}
+// a node released and removed after its key is updated by another put, the new node of the key is kept in cache
+TEST(testCase, cache_remove_updated_test) {
+  void* tscTmr = taosTmrInit(100, 200, 6000, "TSC");
+  auto* pCache = taosCacheInit(tscTmr, 2);
+
+  const char* key = "updated";
+  char data1[] = "data1";
+  char data2[] = "data2";
+
+  char* pOld = (char*)taosCachePut(pCache, key, data1, sizeof(data1), 20);
+  ASSERT_TRUE(pOld != NULL);
+
+  // the old node is referenced, so it is moved into trash by the update
+  char* pNew = (char*)taosCachePut(pCache, key, data2, sizeof(data2), 20);
+  ASSERT_TRUE(pNew != NULL && pNew != pOld);
+  taosCacheRelease(pCache, (void**)&pNew, false);
+
+  taosCacheRelease(pCache, (void**)&pOld, true);
+
+  char* p = (char*)taosCacheAcquireByName(pCache, key);
+  ASSERT_TRUE(p != NULL);
+  ASSERT_STREQ(p, data2);
+  taosCacheRelease(pCache, (void**)&p, false);
+
+  taosCacheCleanup(pCache);
+}
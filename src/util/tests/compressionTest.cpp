@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+#include "tscompression.h"
+#include "ttime.h"
+
+namespace {
+// output buffer large enough for both the RLE and dictionary codecs
+size_t codecBufferSize(int nelements, int bytes) {
+  size_t rle = nelements * (sizeof(uint16_t) + bytes);
+  size_t dict = sizeof(uint16_t) + 256 * bytes + nelements;
+  return rle > dict ? rle : dict;
+}
+
+template <typename T>
+void checkRLE(const std::vector<T> &input) {
+  int               n = (int)input.size();
+  std::vector<char> buf(codecBufferSize(n, sizeof(T)));
+  std::vector<T>    output(n);
+
+  int len = tsCompressRLEImp((const char *)input.data(), n, sizeof(T), buf.data());
+  ASSERT_GT(len, 0);
+  ASSERT_EQ(tsDecompressRLEImp(buf.data(), n, sizeof(T), (char *)output.data()), (int)(n * sizeof(T)));
+  ASSERT_EQ(memcmp(input.data(), output.data(), n * sizeof(T)), 0);
+}
+
+template <typename T>
+int checkDict(const std::vector<T> &input) {
+  int               n = (int)input.size();
+  std::vector<char> buf(codecBufferSize(n, sizeof(T)));
+  std::vector<T>    output(n);
+
+  int len = tsCompressDictImp((const char *)input.data(), n, sizeof(T), buf.data());
+  if (len < 0) return len;
+
+  EXPECT_EQ(tsDecompressDictImp(buf.data(), n, sizeof(T), (char *)output.data()), (int)(n * sizeof(T)));
+  EXPECT_EQ(memcmp(input.data(), output.data(), n * sizeof(T)), 0);
+  return len;
+}
+}  // namespace
+
+TEST(compressionTest, rle) {
+  std::vector<int64_t> constant(4096, 42);
+  checkRLE(constant);
+
+  // runs longer than a uint16_t counter
+  std::vector<int8_t> longRuns(100000, 1);
+  for (size_t i = 70000; i < longRuns.size(); i++) longRuns[i] = 2;
+  checkRLE(longRuns);
+
+  std::mt19937        gen(1);
+  std::vector<double> random(4096);
+  for (auto &v : random) v = (double)gen();
+  checkRLE(random);
+
+  std::vector<int32_t> steps(4096);
+  for (size_t i = 0; i < steps.size(); i++) steps[i] = (int32_t)(i / 100);
+  checkRLE(steps);
+
+  std::vector<int16_t> one(1, -1);
+  checkRLE(one);
+}
+
+TEST(compressionTest, dictionary) {
+  std::mt19937 gen(2);
+
+  std::vector<int64_t> lowCardinality(4096);
+  for (auto &v : lowCardinality) v = (int64_t)(gen() % 16) * 1000000007LL;
+  int len = checkDict(lowCardinality);
+  ASSERT_EQ(len, (int)(sizeof(uint16_t) + 16 * sizeof(int64_t) + lowCardinality.size()));
+
+  std::vector<int32_t> full(4096);
+  for (size_t i = 0; i < full.size(); i++) full[i] = (int32_t)(i % 256) - 128;
+  ASSERT_GT(checkDict(full), 0);
+
+  std::vector<float> floats(1000);
+  for (auto &v : floats) v = (float)(gen() % 3) / 7;
+  ASSERT_GT(checkDict(floats), 0);
+
+  // more than 256 distinct values can not be encoded
+  std::vector<int32_t> tooMany(4096);
+  for (size_t i = 0; i < tooMany.size(); i++) tooMany[i] = (int32_t)(i % 257);
+  ASSERT_EQ(checkDict(tooMany), -1);
+}
+
+namespace {
+typedef int (*CompressFunc)(const char *const, int, const int, char *const, int, char, char *const, int);
+typedef int (*DecompressFunc)(const char *const, int, const int, char *const, int, char, char *const, int);
+
+struct StageResult {
+  int     len;
+  int64_t compressUs;
+  int64_t decompressUs;
+};
+
+// Compress and decompress the data a few rounds by the algorithm, and check the data read back.
+StageResult checkTwoStage(CompressFunc compFunc, DecompressFunc decompFunc, const std::vector<char> &input,
+                          int nelements, char algorithm) {
+  const int         rounds = 10;
+  int               size = (int)input.size();
+  std::vector<char> output(size * 2 + 64), buffer(size * 2 + 64), decoded(size + 64);
+  StageResult       result = {0, 0, 0};
+
+  int64_t st = taosGetTimestampUs();
+  for (int i = 0; i < rounds; i++) {
+    result.len = compFunc(input.data(), size, nelements, output.data(), (int)output.size(), algorithm, buffer.data(),
+                          (int)buffer.size());
+  }
+  result.compressUs = (taosGetTimestampUs() - st) / rounds;
+
+  int len = 0;
+  st = taosGetTimestampUs();
+  for (int i = 0; i < rounds; i++) {
+    len = decompFunc(output.data(), result.len, nelements, decoded.data(), (int)decoded.size(), algorithm,
+                     buffer.data(), (int)buffer.size());
+  }
+  result.decompressUs = (taosGetTimestampUs() - st) / rounds;
+
+  EXPECT_EQ(len, size);
+  EXPECT_EQ(memcmp(input.data(), decoded.data(), size), 0);
+  return result;
+}
+
+// Compare zstd with LZ4 as the second stage, return the output size of both.
+void compareSecondStage(const char *name, CompressFunc compFunc, DecompressFunc decompFunc,
+                        const std::vector<char> &input, int nelements, int *lz4Len, int *zstdLen) {
+  StageResult lz4 = checkTwoStage(compFunc, decompFunc, input, nelements, TWO_STAGE_COMP);
+  StageResult zstd = checkTwoStage(compFunc, decompFunc, input, nelements, TWO_STAGE_COMP_ZSTD);
+
+  printf("%-10s raw:%8d  lz4:%8d (%.2fx, %5" PRId64 "us/%5" PRId64 "us)  zstd:%8d (%.2fx, %5" PRId64 "us/%5" PRId64
+         "us)\n",
+         name, (int)input.size(), lz4.len, (double)input.size() / lz4.len, lz4.compressUs, lz4.decompressUs, zstd.len,
+         (double)input.size() / zstd.len, zstd.compressUs, zstd.decompressUs);
+
+  *lz4Len = lz4.len;
+  *zstdLen = zstd.len;
+}
+
+template <typename T>
+std::vector<char> toBytes(const std::vector<T> &vals) {
+  std::vector<char> bytes(vals.size() * sizeof(T));
+  memcpy(bytes.data(), vals.data(), bytes.size());
+  return bytes;
+}
+}  // namespace
+
+TEST(compressionTest, zstd_second_stage) {
+  const int    rows = 4096;
+  std::mt19937 gen(3);
+  int          lz4Len = 0, zstdLen = 0;
+
+  // timestamps of a 1s interval with jitter
+  std::vector<int64_t> ts(rows);
+  for (int i = 0; i < rows; i++) ts[i] = 1600000000000LL + i * 1000 + gen() % 10;
+  compareSecondStage("timestamp", tsCompressTimestamp, tsDecompressTimestamp, toBytes(ts), rows, &lz4Len, &zstdLen);
+  EXPECT_LE(zstdLen, lz4Len);
+
+  // readings of a sensor wandering around
+  std::vector<int32_t> ints(rows);
+  for (int i = 0; i < rows; i++) ints[i] = (i == 0 ? 200 : ints[i - 1]) + (int32_t)(gen() % 7) - 3;
+  compareSecondStage("int", tsCompressInt, tsDecompressInt, toBytes(ints), rows, &lz4Len, &zstdLen);
+  EXPECT_LE(zstdLen, lz4Len);
+
+  std::vector<double> doubles(rows);
+  for (int i = 0; i < rows; i++) doubles[i] = 20.0 + (double)(gen() % 100) / 10;
+  compareSecondStage("double", tsCompressDouble, tsDecompressDouble, toBytes(doubles), rows, &lz4Len, &zstdLen);
+  EXPECT_LE(zstdLen, lz4Len);
+
+  std::vector<int8_t> bools(rows);
+  for (int i = 0; i < rows; i++) bools[i] = (i / 64) % 2;
+  compareSecondStage("bool", tsCompressBool, tsDecompressBool, toBytes(bools), rows, &lz4Len, &zstdLen);
+  EXPECT_LE(zstdLen, lz4Len + 16);  // frame header of zstd outweighs tiny outputs
+
+  // binary column of log like lines
+  const char       *levels[] = {"INFO", "WARN", "ERROR", "DEBUG"};
+  std::vector<char> text;
+  for (int i = 0; i < rows; i++) {
+    char    line[64] = {0};
+    int16_t len = (int16_t)snprintf(line, sizeof(line), "%s device-%03u temperature=%u", levels[gen() % 4],
+                                    (unsigned)(gen() % 200), (unsigned)(gen() % 1000));
+    text.insert(text.end(), (char *)&len, (char *)&len + sizeof(len));
+    text.insert(text.end(), line, line + len);
+  }
+  compareSecondStage("binary", tsCompressString, tsDecompressString, text, rows, &lz4Len, &zstdLen);
+  EXPECT_LT(zstdLen, lz4Len);
+}
+
+TEST(compressionTest, zstd_incompressible) {
+  std::mt19937      gen(4);
+  std::vector<char> input(8192);
+  for (auto &c : input) c = (char)gen();
+
+  std::vector<char> output(input.size() + 1), decoded(input.size());
+  int               len = tsCompressStringZstdImp(input.data(), (int)input.size(), output.data(), (int)output.size());
+
+  // stored as it is when zstd can not make it smaller
+  ASSERT_EQ(len, (int)input.size() + 1);
+  ASSERT_EQ(output[0], 0);
+  ASSERT_EQ(tsDecompressStringImp(output.data(), len, decoded.data(), (int)decoded.size()), (int)input.size());
+  ASSERT_EQ(memcmp(input.data(), decoded.data(), input.size()), 0);
+}
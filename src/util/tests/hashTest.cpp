@@ -88,6 +88,32 @@ void stringKeyTest() {
   taosHashCleanup(hashTable);
 }
 
+// update the values of existed keys, the keys like the timestamps in milliseconds make long overflow linked lists
+void updateTest() {
+  auto* hashTable = (SHashObj*) taosHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), false);
+
+  for(int64_t i = 0; i < 1000; ++i) {
+    int64_t k = i * 1000;
+    taosHashPut(hashTable, (const char*) &k, sizeof(int64_t), (char*) &i, sizeof(int64_t));
+  }
+
+  for(int64_t i = 0; i < 1000; ++i) {
+    int64_t k = i * 1000, v = i * 2;
+    taosHashPut(hashTable, (const char*) &k, sizeof(int64_t), (char*) &v, sizeof(int64_t));
+  }
+
+  ASSERT_EQ(taosHashGetSize(hashTable), 1000);
+
+  for(int64_t i = 0; i < 1000; ++i) {
+    int64_t k = i * 1000;
+    char* p = (char*) taosHashGet(hashTable, (const char*) &k, sizeof(int64_t));
+    ASSERT_TRUE(p != nullptr);
+    ASSERT_EQ(*reinterpret_cast<int64_t*>(p), i * 2);
+  }
+
+  taosHashCleanup(hashTable);
+}
+
 void functionTest() {
 
 }
@@ -153,4 +179,8 @@ TEST(testCase, hashTest) {
 //  stringKeyTest();
 //  noLockPerformanceTest();
 //  multithreadsTest();
-}
\ No newline at end of file
+}
+
+TEST(testCase, hashUpdateTest) {
+  updateTest();
+}
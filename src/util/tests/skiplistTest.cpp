@@ -2,6 +2,7 @@
 #include <limits.h>
 #include <taosdef.h>
 #include <iostream>
+#include <thread>
 
 #include "taosmsg.h"
 #include "tskiplist.h"
@@ -332,8 +333,122 @@ void duplicatedKeyTest() {
   tSkipListDestroy(pSkipList);
 }
 
+void updateKeyTest() {
+  SSkipList *pSkipList =
+      tSkipListCreate(MAX_SKIP_LIST_LEVEL, TSDB_DATA_TYPE_INT, sizeof(int32_t), SL_UPDATE_DUP_KEY, false, true, getkey);
+
+  // the node data is the key followed by a version of the row
+  auto put = [pSkipList](int32_t key, int32_t version) {
+    int32_t level, size;
+    tSkipListNewNodeInfo(pSkipList, &level, &size);
+    SSkipListNode* d = (SSkipListNode*)calloc(1, size + sizeof(int32_t) * 2);
+    d->level = level;
+    int32_t* data = (int32_t*)SL_GET_NODE_KEY(pSkipList, d);
+    data[0] = key;
+    data[1] = version;
+    tSkipListPut(pSkipList, d);
+  };
+
+  const int32_t num = 1000;
+  for (int32_t i = 0; i < num; ++i) {
+    put(i, 0);
+  }
+
+  // overwrite the first, the last and random keys in between
+  put(0, 1);
+  put(num - 1, 1);
+  for (int32_t i = 0; i < num; ++i) {
+    put(rand() % num, 1);
+  }
+  for (int32_t i = 0; i < num; i += 2) {
+    put(i, 2);
+  }
+
+  assert(tSkipListGetSize(pSkipList) == num);
+  assert(*(int32_t*)pSkipList->lastKey == num - 1 && ((int32_t*)pSkipList->lastKey)[1] == 1);
+
+  SSkipListIterator* iter = tSkipListCreateIter(pSkipList);
+  int32_t            count = 0;
+  while (tSkipListIterNext(iter)) {
+    int32_t* data = (int32_t*)SL_GET_NODE_KEY(pSkipList, tSkipListIterGet(iter));
+    assert(data[0] == count);
+    assert(count % 2 == 0 ? data[1] == 2 : data[1] <= 1);
+    count++;
+  }
+  assert(count == num);
+  tSkipListDestroyIter(iter);
+
+  int32_t key = 1;
+  SArray* nodes = tSkipListGet(pSkipList, (char*)(&key));
+  assert(taosArrayGetSize(nodes) == 1);
+  taosArrayDestroy(nodes);
+
+  tSkipListDestroy(pSkipList);
+}
+
+// the keys are replaced by one thread while another one iterates over them without the lock, as tsdb reads the
+// memtable in the update mode
+void concurrentUpdateKeyTest() {
+  SSkipList *pSkipList =
+      tSkipListCreate(MAX_SKIP_LIST_LEVEL, TSDB_DATA_TYPE_INT, sizeof(int32_t), SL_UPDATE_DUP_KEY, false, true, getkey);
+
+  auto put = [pSkipList](int32_t key, int32_t version) {
+    int32_t level, size;
+    tSkipListNewNodeInfo(pSkipList, &level, &size);
+    SSkipListNode* d = (SSkipListNode*)calloc(1, size + sizeof(int32_t) * 2);
+    d->level = level;
+    int32_t* data = (int32_t*)SL_GET_NODE_KEY(pSkipList, d);
+    data[0] = key;
+    data[1] = version;
+    tSkipListPut(pSkipList, d);
+  };
+
+  const int32_t num = 2000;
+  for (int32_t i = 0; i < num; ++i) {
+    put(i, 0);
+  }
+
+  volatile bool stop = false;
+  std::thread writer([&]() {
+    for (int32_t version = 1; version <= 10; ++version) {
+      for (int32_t i = 0; i < num; ++i) {
+        put(rand() % num, version);
+      }
+    }
+    stop = true;
+  });
+
+  // each pass sees every key exactly once, in either order
+  int32_t passes = 0;
+  bool    missed = false;
+  while ((!stop || passes < 2) && !missed) {
+    int32_t            order = (passes % 2 == 0) ? TSDB_ORDER_ASC : TSDB_ORDER_DESC;
+    SSkipListIterator* iter = tSkipListCreateIterFromVal(pSkipList, NULL, TSDB_DATA_TYPE_INT, order);
+    int32_t            count = 0;
+    while (tSkipListIterNext(iter) && !missed) {
+      int32_t* data = (int32_t*)SL_GET_NODE_KEY(pSkipList, tSkipListIterGet(iter));
+      missed = (data[0] != ((order == TSDB_ORDER_ASC) ? count : num - 1 - count));
+      count++;
+    }
+    missed = missed || (count != num);
+    tSkipListDestroyIter(iter);
+    passes++;
+  }
+
+  writer.join();
+  ASSERT_FALSE(missed) << "a key is missed or repeated in pass " << passes;
+  ASSERT_EQ(tSkipListGetSize(pSkipList), num);
+
+  tSkipListDestroy(pSkipList);
+}
+
 }  // namespace
 
+TEST(testCase, skiplist_concurrent_update_test) {
+  srand(time(NULL));
+  concurrentUpdateKeyTest();
+}
+
 TEST(testCase, skiplist_test) {
   assert(sizeof(SSkipListKey) == 8);
   srand(time(NULL));
@@ -342,6 +457,7 @@ TEST(testCase, skiplist_test) {
   doubleSkipListTest();
   skiplistPerformanceTest();
   duplicatedKeyTest();
+  updateKeyTest();
   randKeyTest();
 
   //  tSKipListQueryCond q;
@@ -47,6 +47,7 @@ typedef struct {
   void        *events;
   void        *cq;  // continuous query
   int32_t      cfgVersion;
+  SVnodeLoad   lastLoad;  // load in the last status msg, in host byte order
   STsdbCfg     tsdbCfg;
   SSyncCfg     syncCfg;
   SWalCfg      walCfg;
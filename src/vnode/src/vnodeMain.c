@@ -108,6 +108,7 @@ int32_t vnodeCreate(SMDCreateVnodeMsg *pVnodeCfg) {
   tsdbCfg.maxRowsPerFileBlock = pVnodeCfg->cfg.maxRowsPerFileBlock;
   tsdbCfg.precision           = pVnodeCfg->cfg.precision;
   tsdbCfg.compression         = pVnodeCfg->cfg.compression;;
+  tsdbCfg.update              = pVnodeCfg->cfg.update;
   
   char tsdbDir[TSDB_FILENAME_LEN] = {0};
   sprintf(tsdbDir, "%s/vnode%d/tsdb", tsVnodeDir, pVnodeCfg->cfg.vgId);
@@ -353,22 +354,33 @@ void *vnodeGetWal(void *pVnode) {
   return ((SVnodeObj *)pVnode)->wal; 
 }
 
-static void vnodeBuildVloadMsg(SVnodeObj *pVnode, SDMStatusMsg *pStatus) {
+static void vnodeBuildVloadMsg(SVnodeObj *pVnode, SDMStatusMsg *pStatus, bool fullReport) {
   if (pVnode->status == TAOS_VN_STATUS_DELETING) return;
   if (pStatus->openVnodes >= TSDB_MAX_VNODES) return;
 
+  SVnodeLoad load = {0};
+  load.vgId = pVnode->vgId;
+  load.cfgVersion = pVnode->cfgVersion;
+  load.status = pVnode->status;
+  load.role = pVnode->role;
+  load.replica = pVnode->syncCfg.replica;
+
+  // only the changed vnodes are reported, the others are known by mnode since the last status msg
+  if (!fullReport && memcmp(&load, &pVnode->lastLoad, sizeof(SVnodeLoad)) == 0) return;
+  pVnode->lastLoad = load;
+
   SVnodeLoad *pLoad = &pStatus->load[pStatus->openVnodes++];
-  pLoad->vgId = htonl(pVnode->vgId);
-  pLoad->cfgVersion = htonl(pVnode->cfgVersion);
-  pLoad->totalStorage = htobe64(pLoad->totalStorage);
-  pLoad->compStorage = htobe64(pLoad->compStorage);
-  pLoad->pointsWritten = htobe64(pLoad->pointsWritten);
-  pLoad->status = pVnode->status;
-  pLoad->role = pVnode->role;
-  pLoad->replica = pVnode->syncCfg.replica;
+  pLoad->vgId = htonl(load.vgId);
+  pLoad->cfgVersion = htonl(load.cfgVersion);
+  pLoad->totalStorage = htobe64(load.totalStorage);
+  pLoad->compStorage = htobe64(load.compStorage);
+  pLoad->pointsWritten = htobe64(load.pointsWritten);
+  pLoad->status = load.status;
+  pLoad->role = load.role;
+  pLoad->replica = load.replica;
 }
 
-void vnodeBuildStatusMsg(void *param) {
+void vnodeBuildStatusMsg(void *param, bool fullReport) {
   SDMStatusMsg *pStatus = param;
   SHashMutableIterator *pIter = taosHashCreateIter(tsDnodeVnodesHash);
 
@@ -377,7 +389,7 @@ void vnodeBuildStatusMsg(void *param) {
     if (pVnode == NULL) continue;
     if (*pVnode == NULL) continue;
 
-    vnodeBuildVloadMsg(*pVnode, pStatus);
+    vnodeBuildVloadMsg(*pVnode, pStatus, fullReport);
   }
 
   taosHashDestroyIter(pIter);
@@ -415,6 +427,18 @@ static void vnodeCleanUp(SVnodeObj *pVnode) {
 }
 
 // TODO: this is a simple implement
+static void vnodeTraceTsdbStatus(SVnodeObj *pVnode) {
+  STsdbRepoInfo *pInfo = tsdbGetStatus(pVnode->tsdb);
+  if (pInfo == NULL) return;
+
+  STsdbStat *pStat = &pInfo->stat;
+  vTrace("vgId:%d, commit over, blocks:%" PRId64 " subBlocks:%" PRId64 " lastBlocks:%" PRId64 " merged:%" PRId64
+         ", blocks read:%" PRId64 " fragments read:%" PRId64 " shared:%" PRId64,
+         pVnode->vgId, pStat->numOfBlocks, pStat->numOfSubBlocks, pStat->numOfLastBlocks, pStat->numOfMergedBlocks,
+         pStat->numOfBlocksRead, pStat->numOfFragmentsRead, pStat->numOfBlocksShared);
+  free(pInfo);
+}
+
 static int vnodeProcessTsdbStatus(void *arg, int status) {
   SVnodeObj *pVnode = arg;
 
@@ -423,8 +447,10 @@ static int vnodeProcessTsdbStatus(void *arg, int status) {
     return walRenew(pVnode->wal);
   }
 
-  if (status == TSDB_STATUS_COMMIT_OVER)
+  if (status == TSDB_STATUS_COMMIT_OVER) {
+    vnodeTraceTsdbStatus(pVnode);
     return vnodeSaveVersion(pVnode);
+  }
 
   return 0; 
 }
@@ -500,6 +526,7 @@ static int32_t vnodeSaveCfg(SMDCreateVnodeMsg *pVnodeCfg) {
   len += snprintf(content + len, maxLen - len, "  \"commitTime\": %d,\n", pVnodeCfg->cfg.commitTime);  
   len += snprintf(content + len, maxLen - len, "  \"precision\": %d,\n", pVnodeCfg->cfg.precision);
   len += snprintf(content + len, maxLen - len, "  \"compression\": %d,\n", pVnodeCfg->cfg.compression);
+  len += snprintf(content + len, maxLen - len, "  \"update\": %d,\n", pVnodeCfg->cfg.update);
   len += snprintf(content + len, maxLen - len, "  \"walLevel\": %d,\n", pVnodeCfg->cfg.walLevel);
   len += snprintf(content + len, maxLen - len, "  \"replica\": %d,\n", pVnodeCfg->cfg.replications);
   len += snprintf(content + len, maxLen - len, "  \"wals\": %d,\n", pVnodeCfg->cfg.wals);
@@ -648,6 +675,12 @@ static int32_t vnodeReadCfg(SVnodeObj *pVnode) {
   }
   pVnode->tsdbCfg.compression = (int8_t)compression->valueint;
 
+  // absent in the cfg of the vnodes created before the option is added
+  cJSON *update = cJSON_GetObjectItem(root, "update");
+  if (update && update->type == cJSON_Number) {
+    pVnode->tsdbCfg.update = (int8_t)update->valueint;
+  }
+
   cJSON *walLevel = cJSON_GetObjectItem(root, "walLevel");
   if (!walLevel || walLevel->type != cJSON_Number) {
     vError("vgId:%d, failed to read vnode cfg, walLevel not found", pVnode->vgId);
@@ -183,6 +183,8 @@ static int32_t vnodeProcessAlterTableMsg(SVnodeObj *pVnode, void *pCont, SRspRet
   int32_t sid           = htonl(pTable->sid);
   uint64_t uid          = htobe64(pTable->uid);
   SSchema *pSchema = (SSchema *) pTable->data;
+  STSchema *pDestTagSchema = NULL;
+  SDataRow  dataRow = NULL;
 
   int32_t totalCols = numOfColumns + numOfTags;
   
@@ -196,7 +198,7 @@ static int32_t vnodeProcessAlterTableMsg(SVnodeObj *pVnode, void *pCont, SRspRet
   tsdbTableSetSchema(&tCfg, pDestSchema, false);
 
   if (numOfTags != 0) {
-    STSchema *pDestTagSchema = tdNewSchema(numOfTags);
+    pDestTagSchema = tdNewSchema(numOfTags);
     for (int i = numOfColumns; i < totalCols; i++) {
       tdSchemaAddCol(pDestTagSchema, pSchema[i].type, htons(pSchema[i].colId), htons(pSchema[i].bytes));
     }
@@ -204,7 +206,7 @@ static int32_t vnodeProcessAlterTableMsg(SVnodeObj *pVnode, void *pCont, SRspRet
 
     char *pTagData = pTable->data + totalCols * sizeof(SSchema);
     int accumBytes = 0;
-    SDataRow dataRow = tdNewDataRowFromSchema(pDestTagSchema);
+    dataRow = tdNewDataRowFromSchema(pDestTagSchema);
 
     for (int i = 0; i < numOfTags; i++) {
       STColumn *pTCol = schemaColAt(pDestTagSchema, i);
@@ -215,7 +217,8 @@ static int32_t vnodeProcessAlterTableMsg(SVnodeObj *pVnode, void *pCont, SRspRet
   }
 
   code = tsdbAlterTable(pVnode->tsdb, &tCfg);
-
+  tdFreeDataRow(dataRow);
+  tfree(pDestTagSchema);
   tfree(pDestSchema);
 
   vTrace("vgId:%d, table:%s, alter table result:%d", pVnode->vgId, pTable->tableId, code);
@@ -14,10 +14,13 @@ python3 ./test.py -f insert/nchar-boundary.py
 python3 ./test.py -f insert/nchar-unicode.py
 python3 ./test.py -f insert/multi.py
 python3 ./test.py -f insert/randomNullCommit.py
+python3 ./test.py -f insert/updateMode.py
+python3 ./test.py -f insert/metaBatch.py
 
 python3 ./test.py -f table/column_name.py
 python3 ./test.py -f table/column_num.py
 python3 ./test.py -f table/db_table.py
+python3 ./test.py -f table/child_tables.py
 python3 ./test.py -f table/tablename-boundary.py
 
 # tag
@@ -132,3 +135,11 @@ python3 ./test.py -f query/filter.py
 python3 ./test.py $1 -f query/filterCombo.py
 python3 ./test.py $1 -f query/queryNormal.py
 python3 ./test.py $1 -f query/queryError.py
+python3 ./test.py $1 -f query/queryWindow.py
+python3 ./test.py $1 -f query/querySqlCache.py
+python3 ./test.py $1 -f query/queryResultCache.py
+python3 ./test.py $1 -f query/queryRollup.py
+python3 ./test.py $1 -f query/queryTagBloom.py
+python3 ./test.py $1 -f query/queryBinaryStatis.py
+python3 ./test.py $1 -f query/queryBloomFilter.py
+python3 ./test.py $1 -f query/queryConcurrentSubqueries.py
@@ -0,0 +1,159 @@
+###################################################################
+#           Copyright (c) 2016 by TAOS Technologies, Inc.
+#                     All rights reserved.
+#
+#  This file is proprietary and confidential to TAOS Technologies.
+#  No part of this file may be reproduced, stored, transmitted,
+#  disclosed or used in any form or by any means other than as
+#  expressly provided by the written permission from Jianhui Tao
+#
+###################################################################
+
+# -*- coding: utf-8 -*-
+
+import sys
+import os
+import re
+import taos
+from util.log import *
+from util.cases import *
+from util.sql import *
+from util.dnodes import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql):
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor(), logSql)
+
+    # the lines of the dnode log matching the pattern, which are written synchronously
+    def logLines(self, pattern):
+        lines = []
+        logDir = tdDnodes.dnodes[0].logDir
+        for name in sorted(os.listdir(logDir)):
+            with open(os.path.join(logDir, name), errors="ignore") as f:
+                lines += [line for line in f if re.search(pattern, line)]
+        return lines
+
+    # the numbers of the single table meta requests, and of the tables in each multi table meta request, received by
+    # mnode for the insert, the meta in cache is removed first by default
+    def metaRequests(self, sql, reset=True):
+        single = "table meta msg is received"
+        multi = "multi table meta msg is received"
+        numOfSingle = len(self.logLines(single))
+        numOfMulti = len(self.logLines(multi))
+
+        if reset:
+            tdSql.execute("reset query cache")
+        tdSql.execute(sql)
+
+        tables = [int(re.search(r"tables:(\d+)", line).group(1)) for line in self.logLines(multi)[numOfMulti:]]
+        return len(self.logLines(single)) - numOfSingle - len(tables), tables
+
+    def values(self, tb, i, numOfRows):
+        rows = ["(%d, %d)" % (1520000000000 + i * 1000 + j, i) for j in range(numOfRows)]
+        return "%s values %s" % (tb, " ".join(rows))
+
+    def checkRows(self, tb, numOfRows):
+        tdSql.query("select count(*) from %s" % tb)
+        tdSql.checkData(0, 0, numOfRows)
+
+    def run(self):
+        # the meta requests are counted in the log of the dnode
+        tdDnodes.stop(1)
+        tdDnodes.deploy(1)
+        tdDnodes.start(1)
+
+        tdSql.execute("drop database if exists db")
+        tdSql.execute("create database db")
+        tdSql.execute("use db")
+        tdSql.execute("create table st (ts timestamp, i int) tags(j int)")
+        for i in range(30):
+            tdSql.execute("create table t%d (ts timestamp, i int)" % i)
+        for i in range(10):
+            tdSql.execute("create table c%d using st tags(%d)" % (i, i))
+
+        print("==============step1")
+        # the meta of all the tables is retrieved by one request
+        tables = ["t%d" % i for i in range(30)] + ["c%d" % i for i in range(10)]
+        sql = "insert into %s" % " ".join([self.values(tb, i, 5) for i, tb in enumerate(tables)])
+        single, multi = self.metaRequests(sql)
+        if single != 0 or multi != [len(tables)]:
+            tdLog.exit("%s failed: %d single and %s multi table meta requests, expect:0 and [%d]" %
+                       (__file__, single, multi, len(tables)))
+        for tb in tables:
+            self.checkRows(tb, 5)
+
+        # the tables listed more than once, and with the columns, are retrieved once
+        sql = "insert into t0 (ts, i) values(now, 1) t1 values(now, 1) t0 (ts) values(now + 1s) t1 values(now + 1s, 2)"
+        single, multi = self.metaRequests(sql)
+        if single != 0 or multi != [2]:
+            tdLog.exit("%s failed: %d single and %s multi table meta requests, expect:0 and [2]" %
+                       (__file__, single, multi))
+        self.checkRows("t0", 7)
+        self.checkRows("t1", 7)
+
+        print("==============step2")
+        # the meta of the tables in cache is not retrieved again
+        sql = "insert into %s %s" % (self.values("t2", 100, 1), self.values("t3", 100, 1))
+        single, multi = self.metaRequests(sql)
+        if single != 0 or multi != [2]:
+            tdLog.exit("%s failed: %d single and %s multi table meta requests, expect:0 and [2]" %
+                       (__file__, single, multi))
+
+        sql = "insert into %s %s" % (self.values("t2", 101, 1), self.values("t3", 101, 1))
+        single, multi = self.metaRequests(sql, reset=False)
+        if single != 0 or multi != []:
+            tdLog.exit("%s failed: %d single and %s multi table meta requests for the tables in cache" %
+                       (__file__, single, multi))
+
+        # a single table missing needs no multi table request
+        single, multi = self.metaRequests("insert into %s" % self.values("t4", 100, 1))
+        if single != 1 or multi != []:
+            tdLog.exit("%s failed: %d single and %s multi table meta requests for a table, expect:1 and []" %
+                       (__file__, single, multi))
+
+        sql = "insert into %s %s" % (self.values("t4", 101, 1), self.values("t8", 101, 1))
+        single, multi = self.metaRequests(sql, reset=False)
+        if single != 1 or multi != []:
+            tdLog.exit("%s failed: %d single and %s multi table meta requests for a table missing, expect:1 and []" %
+                       (__file__, single, multi))
+        for tb in ["t2", "t3", "t4"]:
+            self.checkRows(tb, 7)
+        self.checkRows("t8", 6)
+
+        print("==============step3")
+        # the tables created by the using clause are created one by one, after the meta of the super table is retrieved
+        tables = ["d%d using st tags(%d) %s" % (i, i, self.values("", i, 3)) for i in range(5)]
+        sql = "insert into %s" % " ".join(tables + [self.values("t5", 200, 3), self.values("c0", 200, 3)])
+        single, multi = self.metaRequests(sql)
+        if single != 5 or multi != [8]:
+            tdLog.exit("%s failed: %d single and %s multi table meta requests, expect:5 and [8]" %
+                       (__file__, single, multi))
+        for i in range(5):
+            self.checkRows("d%d" % i, 3)
+        self.checkRows("t5", 8)
+        self.checkRows("c0", 8)
+        tdSql.query("select count(*) from st")
+        tdSql.checkData(0, 0, 10 * 5 + 5 * 3 + 3)
+
+        print("==============step4")
+        # the table not existing is reported as before, and nothing of the statement is inserted
+        tdSql.execute("reset query cache")
+        tdSql.error("insert into %s %s" % (self.values("t6", 300, 1), self.values("nosuchtable", 300, 1)))
+        self.checkRows("t6", 5)
+
+        # the statements which can not be scanned are parsed as before
+        tdSql.execute("reset query cache")
+        tdSql.error("insert into t6 values(now, 1) t7 values")
+        tdSql.error("insert into t6 values(now, 1) t7 (ts, i values(now, 1)")
+        tdSql.execute("insert into t6 values(now + 1s, 1) t7 values(now + 1s, 1)")
+        self.checkRows("t7", 6)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,95 @@
+###################################################################
+#           Copyright (c) 2016 by TAOS Technologies, Inc.
+#                     All rights reserved.
+#
+#  This file is proprietary and confidential to TAOS Technologies.
+#  No part of this file may be reproduced, stored, transmitted,
+#  disclosed or used in any form or by any means other than as
+#  expressly provided by the written permission from Jianhui Tao
+#
+###################################################################
+
+# -*- coding: utf-8 -*-
+
+import sys
+import taos
+from util.log import *
+from util.cases import *
+from util.sql import *
+from util.dnodes import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql):
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor(), logSql)
+
+    def insert(self, rows):
+        sqlcmd = ['insert into t values']
+        for key, val in rows.items():
+            sqlcmd.append('(%d, %d)' % (self.startTime + key, val))
+            self.expected[key] = val
+        tdSql.execute(" ".join(sqlcmd))
+
+    # the table keeps one row of each timestamp, with the value written last
+    def checkAll(self):
+        keys = sorted(self.expected.keys())
+        tdSql.query("select * from t")
+        tdSql.checkRows(len(keys))
+        for i in range(len(keys)):
+            tdSql.checkData(i, 1, self.expected[keys[i]])
+
+        tdSql.query("select count(*), sum(v) from t")
+        tdSql.checkData(0, 0, len(keys))
+        tdSql.checkData(0, 1, sum(self.expected.values()))
+
+    # the memtable is committed when the vnode is closed
+    def restart(self):
+        tdDnodes.stop(1)
+        tdDnodes.start(1)
+        tdSql.execute("use db")
+
+    def run(self):
+        self.startTime = 1520000010000
+        self.expected = {}
+
+        tdDnodes.stop(1)
+        tdDnodes.deploy(1)
+        tdDnodes.cfg(1, "update", "1")
+        tdDnodes.start(1)
+
+        tdSql.prepare()
+        tdSql.execute("create table t (ts timestamp, v int)")
+
+        print("==============step1")
+        # the rows with existing timestamps replace the ones in the memtable, the first and the last included
+        self.insert(dict((key, key) for key in range(20)))
+        self.insert({0: 100, 7: 107, 19: 119})
+        self.insert({7: 207, 8: 208})
+        self.checkAll()
+
+        print("==============step2")
+        self.restart()
+        self.checkAll()
+
+        print("==============step3")
+        # the rows in the memtable replace the committed ones
+        self.insert({0: 300, 10: 310, 19: 319, 25: 325})
+        self.checkAll()
+
+        print("==============step4")
+        # the committed rows are merged with the ones in the file
+        self.restart()
+        self.checkAll()
+
+        self.insert({5: 405, 25: 425})
+        self.restart()
+        self.checkAll()
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
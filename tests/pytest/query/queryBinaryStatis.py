@@ -0,0 +1,130 @@
+###################################################################
+#           Copyright (c) 2016 by TAOS Technologies, Inc.
+#                     All rights reserved.
+#
+#  This file is proprietary and confidential to TAOS Technologies.
+#  No part of this file may be reproduced, stored, transmitted,
+#  disclosed or used in any form or by any means other than as
+#  expressly provided by the written permission from Jianhui Tao
+#
+###################################################################
+
+# -*- coding: utf-8 -*-
+
+import sys
+import os
+import re
+import taos
+from util.log import *
+from util.cases import *
+from util.sql import *
+from util.dnodes import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql):
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor(), logSql)
+
+    # the lines of the dnode log matching the pattern, which are written synchronously
+    def logLines(self, pattern):
+        lines = []
+        logDir = tdDnodes.dnodes[0].logDir
+        for name in sorted(os.listdir(logDir)):
+            with open(os.path.join(logDir, name), errors="ignore") as f:
+                lines += [line for line in f if re.search(pattern, line)]
+        return lines
+
+    # the number of the blocks which are discarded by the statistics for the condition on t
+    def discardedBlocks(self, cond, rows):
+        discarded = "data block discarded by pre-filter"
+        count = len(self.logLines(discarded))
+        tdSql.query("select * from t where %s" % cond)
+        tdSql.checkRows(rows)
+        return len(self.logLines(discarded)) - count
+
+    def b(self, row):
+        return "v%07d" % row
+
+    def n(self, row):
+        return "%02d%05d" % (row // 100, row)
+
+    def run(self):
+        # the blocks discarded are counted in the log of the dnode
+        tdDnodes.stop(1)
+        tdDnodes.deploy(1)
+        tdDnodes.start(1)
+
+        tdSql.execute("drop database if exists db")
+        tdSql.execute("create database db maxrows 200")
+        tdSql.execute("use db")
+
+        print("==============step1")
+        # the values of b and n increase with the rows, so the blocks hold disjoint ranges of them, c is always NULL,
+        # and the values of d share the leading 8 bytes. The prefix of nchar keeps only 2 chars, which are the hundreds
+        # of the row in n
+        tdSql.execute("create table t (ts timestamp, b binary(10), n nchar(10), c binary(8), d binary(20))")
+        self.numOfRows = 2000
+        for i in range(0, self.numOfRows, 100):
+            values = ["(%d, '%s', '%s', NULL, 'device-%07d')" % (1520000000000 + j, self.b(j), self.n(j), j)
+                      for j in range(i, i + 100)]
+            tdSql.execute("insert into t values %s" % " ".join(values))
+
+        # the rows are committed to the file blocks
+        tdDnodes.stop(1)
+        tdDnodes.start(1)
+        tdSql.execute("use db")
+
+        print("==============step2")
+        # every block is discarded for the value out of the range of all the blocks
+        numOfBlocks = self.discardedBlocks("b = 'z'", 0)
+        if numOfBlocks < self.numOfRows // 200:
+            tdLog.exit("%s failed: %d blocks are discarded for an absent value" % (__file__, numOfBlocks))
+        tdLog.info("%d blocks are discarded for an absent value" % numOfBlocks)
+
+        # only the block holding the value is loaded, the values of n in 2 blocks may share the prefix
+        for v in [0, 777, self.numOfRows - 1]:
+            discarded = self.discardedBlocks("b = '%s'" % self.b(v), 1)
+            if discarded != numOfBlocks - 1:
+                tdLog.exit("%s failed: %d blocks are discarded for b = '%s', expect:%d" %
+                           (__file__, discarded, self.b(v), numOfBlocks - 1))
+
+            discarded = self.discardedBlocks("n = '%s'" % self.n(v), 1)
+            if discarded < numOfBlocks - 2:
+                tdLog.exit("%s failed: %d blocks are discarded for n = '%s', expect:%d at least" %
+                           (__file__, discarded, self.n(v), numOfBlocks - 2))
+
+        for sql in ["b = '%s'" % self.b(self.numOfRows), "n = '%s'" % self.n(self.numOfRows)]:
+            discarded = self.discardedBlocks(sql, 0)
+            if discarded != numOfBlocks:
+                tdLog.exit("%s failed: %d blocks are discarded for %s beyond the last value, expect:%d" %
+                           (__file__, discarded, sql, numOfBlocks))
+
+        # the value longer than the prefix is not discarded by the prefix alone
+        self.discardedBlocks("b = 'v0000777x'", 0)
+
+        print("==============step3")
+        # no block is discarded by the values sharing the prefix
+        for v in [0, 1234, self.numOfRows - 1]:
+            if self.discardedBlocks("d = 'device-%07d'" % v, 1) != 0:
+                tdLog.exit("%s failed: blocks are discarded for d = 'device-%07d'" % (__file__, v))
+
+        # the blocks of NULL values are discarded, while they are counted by the statistics
+        if self.discardedBlocks("c = 'x'", 0) != numOfBlocks:
+            tdLog.exit("%s failed: the blocks of NULL values are not discarded" % __file__)
+        tdSql.query("select count(c), count(b), count(n) from t")
+        tdSql.checkData(0, 0, 0)
+        tdSql.checkData(0, 1, self.numOfRows)
+        tdSql.checkData(0, 2, self.numOfRows)
+
+        # the filters not of equality are not affected
+        tdSql.query("select count(*) from t where b like 'v000077%'")
+        tdSql.checkData(0, 0, 10)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,139 @@
+###################################################################
+#           Copyright (c) 2016 by TAOS Technologies, Inc.
+#                     All rights reserved.
+#
+#  This file is proprietary and confidential to TAOS Technologies.
+#  No part of this file may be reproduced, stored, transmitted,
+#  disclosed or used in any form or by any means other than as
+#  expressly provided by the written permission from Jianhui Tao
+#
+###################################################################
+
+# -*- coding: utf-8 -*-
+
+import sys
+import os
+import re
+import taos
+from util.log import *
+from util.cases import *
+from util.sql import *
+from util.dnodes import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql):
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor(), logSql)
+
+    # the lines of the dnode log matching the pattern, which are written synchronously
+    def logLines(self, pattern):
+        lines = []
+        logDir = tdDnodes.dnodes[0].logDir
+        for name in sorted(os.listdir(logDir)):
+            with open(os.path.join(logDir, name), errors="ignore") as f:
+                lines += [line for line in f if re.search(pattern, line)]
+        return lines
+
+    # the number of the blocks which are discarded before loaded for the condition on the table
+    def discardedBlocks(self, tb, cond, rows):
+        discarded = "data block discarded by pre-filter"
+        count = len(self.logLines(discarded))
+        tdSql.query("select * from %s where %s" % (tb, cond))
+        tdSql.checkRows(rows)
+        return len(self.logLines(discarded)) - count
+
+    # the even values are spread over all the blocks, so the range of every block covers the odd ones which are absent
+    def value(self, row):
+        return 2 * ((row * 7919) % self.numOfRows)
+
+    def insertRows(self, tb):
+        tdSql.execute("create table %s (ts timestamp, id binary(12), code int, nm nchar(8), f float)" % tb)
+        for i in range(0, self.numOfRows, 100):
+            values = ["(%d, 'id%05d', %d, 'n%05d', %f)" % (1520000000000 + j, self.value(j), self.value(j),
+                                                            self.value(j), self.value(j) + 0.5)
+                      for j in range(i, i + 100)]
+            tdSql.execute("insert into %s values %s" % (tb, " ".join(values)))
+
+        # the rows are committed to the file blocks
+        tdDnodes.stop(1)
+        tdDnodes.start(1)
+        tdSql.execute("use db")
+
+    # the number of the blocks discarded for the absent values of the column
+    def discardedByAbsent(self, tb, fmt):
+        discarded = 0
+        for v in range(1, 2 * self.numOfRows, 2 * self.numOfRows // 20):
+            discarded += self.discardedBlocks(tb, fmt % v, 0)
+        return discarded
+
+    # every row is found by the filters, even if the blocks are discarded by them
+    def checkPresent(self, tb):
+        for row in range(0, self.numOfRows, self.numOfRows // 20):
+            v = self.value(row)
+            for cond in ["id = 'id%05d'" % v, "code = %d" % v, "nm = 'n%05d'" % v, "f = %f" % (v + 0.5)]:
+                self.discardedBlocks(tb, cond, 1)
+
+    def run(self):
+        # the blocks discarded are counted in the log of the dnode
+        tdDnodes.stop(1)
+        tdDnodes.deploy(1)
+        tdDnodes.start(1)
+
+        tdSql.execute("drop database if exists db")
+        tdSql.execute("create database db maxrows 200")
+        tdSql.execute("use db")
+        self.numOfRows = 2000
+
+        print("==============step1")
+        # the blocks of t are written without bloom filter by default
+        self.insertRows("t")
+        numOfBlocks = self.discardedBlocks("t", "id = 'zzz'", 0)
+        if numOfBlocks < self.numOfRows // 200:
+            tdLog.exit("%s failed: %d blocks are discarded for an absent value" % (__file__, numOfBlocks))
+        tdLog.info("%d blocks are discarded for an absent value" % numOfBlocks)
+
+        self.checkPresent("t")
+        if self.discardedByAbsent("t", "code = %d") != 0:
+            tdLog.exit("%s failed: the blocks without bloom filter are discarded" % __file__)
+        if len(self.logLines("bloom filter checks:\\d+, value absent:[1-9]")) != 0:
+            tdLog.exit("%s failed: the values are absent by the bloom filters while they are disabled" % __file__)
+
+        print("==============step2")
+        # the blocks of t2 are written with bloom filters
+        tdDnodes.stop(1)
+        tdDnodes.cfg(1, "bloomFilterFpp", "0.01")
+        tdDnodes.start(1)
+        tdSql.execute("use db")
+        self.insertRows("t2")
+        if self.discardedBlocks("t2", "id = 'zzz'", 0) != numOfBlocks:
+            tdLog.exit("%s failed: the blocks of t2 are not the same as those of t" % __file__)
+
+        self.checkPresent("t2")
+        for fmt in ["code = %d", "id = 'id%05d'", "nm = 'n%05d'"]:
+            discarded = self.discardedByAbsent("t2", fmt)
+            # a few blocks may be loaded due to the false positive
+            if discarded < 20 * numOfBlocks * 0.9:
+                tdLog.exit("%s failed: %d blocks are discarded for the absent values of %s, expect:%d" %
+                           (__file__, discarded, fmt, 20 * numOfBlocks))
+            tdLog.info("%d blocks are discarded for the absent values of %s" % (discarded, fmt))
+
+        # float columns have no bloom filter
+        if self.discardedByAbsent("t2", "f = %d.5") != 0:
+            tdLog.exit("%s failed: the blocks are discarded for the float column" % __file__)
+        if len(self.logLines("bloom filter checks:\\d+, value absent:[1-9]")) == 0:
+            tdLog.exit("%s failed: no value is absent by the bloom filters" % __file__)
+
+        print("==============step3")
+        # the blocks written before are still read without bloom filter
+        self.checkPresent("t")
+        if self.discardedByAbsent("t", "code = %d") != 0:
+            tdLog.exit("%s failed: the blocks without bloom filter are discarded" % __file__)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,149 @@
+###################################################################
+#           Copyright (c) 2016 by TAOS Technologies, Inc.
+#                     All rights reserved.
+#
+#  This file is proprietary and confidential to TAOS Technologies.
+#  No part of this file may be reproduced, stored, transmitted,
+#  disclosed or used in any form or by any means other than as
+#  expressly provided by the written permission from Jianhui Tao
+#
+###################################################################
+
+# -*- coding: utf-8 -*-
+
+import sys
+import os
+import re
+import subprocess
+import taos
+from util.log import *
+from util.cases import *
+from util.sql import *
+from util.dnodes import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql):
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor(), logSql)
+
+    def getShellPath(self):
+        selfPath = os.path.dirname(os.path.realpath(__file__))
+        projPath = selfPath + "/../../../"
+        for root, dirs, files in os.walk(projPath):
+            if ("taosd" in files and "taos" in files):
+                rootRealPath = os.path.dirname(os.path.realpath(root))
+                if ("packaging" not in rootRealPath):
+                    return os.path.join(root, "taos")
+
+        tdLog.exit("taos not found!")
+
+    # the client config is read once by the connection of the case, so the sql is run by the shell with its own config
+    def deployShell(self):
+        self.shell = self.getShellPath()
+        self.cfgDir = "%s/concurrent/cfg" % os.path.dirname(tdDnodes.sim.logDir)
+        self.logDir = "%s/concurrent/log" % os.path.dirname(tdDnodes.sim.logDir)
+        os.system("rm -rf %s %s; mkdir -p %s %s" % (self.cfgDir, self.logDir, self.cfgDir, self.logDir))
+
+        with open(tdDnodes.getSimCfgPath() + "/taos.cfg") as f:
+            cfg = [line for line in f if not line.startswith("logDir")]
+        with open(self.cfgDir + "/taos.cfg", "w") as f:
+            f.writelines(cfg)
+            f.write("logDir %s\n" % self.logDir)
+            f.write("maxConcurrentSubqueries 2\n")
+            f.write("maxNumOfOrderedRes 70000\n")
+
+    def shellQuery(self, sql):
+        try:
+            output = subprocess.check_output([self.shell, "-c", self.cfgDir, "-s", sql], stderr=subprocess.STDOUT,
+                                             timeout=60)
+        except subprocess.TimeoutExpired:
+            tdLog.exit("%s failed: sql:%s is not completed in 60 seconds" % (__file__, sql))
+        except subprocess.CalledProcessError as e:
+            tdLog.exit("%s failed: sql:%s, shell exits with %d" % (__file__, sql, e.returncode))
+
+        return output.decode("utf-8", "ignore")
+
+    # the values in the rows of the result printed by the shell
+    def shellResult(self, sql):
+        rows = []
+        for line in self.shellQuery(sql).splitlines():
+            cells = [cell.strip() for cell in line.split("|")]
+            if len(cells) > 1 and re.match("^-?\d+$", cells[0]):
+                rows.append([int(cell) for cell in cells if cell != ""])
+        return rows
+
+    def logLines(self, pattern):
+        lines = []
+        for name in sorted(os.listdir(self.logDir)):
+            with open(os.path.join(self.logDir, name), errors="ignore") as f:
+                lines += [line for line in f if re.search(pattern, line)]
+        return lines
+
+    def checkResult(self, sql, expected):
+        result = self.shellResult(sql)
+        if sorted(result) != sorted(expected):
+            tdLog.exit("%s failed: sql:%s, %s != expect:%s" % (__file__, sql, result[:5], expected[:5]))
+        tdLog.info("sql:%s, %d rows are expected" % (sql, len(expected)))
+
+    def run(self):
+        tdSql.prepare()
+
+        print("==============step1")
+        # 40 tables in 10 vgroups, each of which has 40000 rows
+        tdSql.execute("drop database if exists db")
+        tdSql.execute("create database db maxTables 4")
+        tdSql.execute("use db")
+        tdSql.execute("create table st (ts timestamp, v int) tags(t int)")
+
+        numOfTables = 40
+        numOfRows = 10000
+        startTime = 1520000000000
+        for i in range(numOfTables):
+            tdSql.execute("create table t%d using st tags(%d)" % (i, i))
+            for k in range(0, numOfRows, 1000):
+                values = ["(%d, %d)" % (startTime + n * 1000, i * numOfRows + n) for n in range(k, k + 1000)]
+                tdSql.execute("insert into t%d values %s" % (i, " ".join(values)))
+
+        tdSql.query("show vgroups")
+        tdSql.checkRows(10)
+
+        self.deployShell()
+
+        print("==============step2")
+        # at most 2 subqueries are running, the results of all the vgroups are merged
+        total = numOfTables * numOfRows
+        self.checkResult("select count(*), sum(v) from db.st", [[total, total * (total - 1) // 2]])
+
+        expected = []
+        for i in range(numOfTables):
+            first = i * numOfRows
+            expected.append([numOfRows, (first + first + numOfRows - 1) * numOfRows // 2, i])
+        self.checkResult("select count(*), sum(v) from db.st group by t", expected)
+
+        self.checkResult("select count(*), max(v), min(v) from db.st where ts < %d" % (startTime + 30000),
+                         [[numOfTables * 30, (numOfTables - 1) * numOfRows + 29, 0]])
+
+        if len(self.logLines("2 subqueries are launched, 8 queued")) != 3:
+            tdLog.exit("%s failed: the subqueries are not queued" % __file__)
+
+        print("==============step3")
+        # the rows of the ordered projection query are over maxNumOfOrderedRes before the third vgroup is retrieved,
+        # then the queued subqueries are released without being sent
+        output = self.shellQuery("select * from db.st order by ts")
+        if "sorted res too many" not in output:
+            tdLog.exit("%s failed: the query is not aborted, %s" % (__file__, output[-200:]))
+        if len(self.logLines("query cancelled or failed, \d+ queued subqueries are released")) != 1:
+            tdLog.exit("%s failed: the queued subqueries are not released" % __file__)
+
+        # the following queries are not affected
+        self.checkResult("select count(*), sum(v) from db.st", [[total, total * (total - 1) // 2]])
+        self.checkResult("select count(*) from db.st where t < 2", [[2 * numOfRows]])
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
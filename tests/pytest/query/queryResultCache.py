@@ -0,0 +1,106 @@
+###################################################################
+#           Copyright (c) 2016 by TAOS Technologies, Inc.
+#                     All rights reserved.
+#
+#  This file is proprietary and confidential to TAOS Technologies.
+#  No part of this file may be reproduced, stored, transmitted,
+#  disclosed or used in any form or by any means other than as
+#  expressly provided by the written permission from Jianhui Tao
+#
+###################################################################
+
+# -*- coding: utf-8 -*-
+
+import sys
+import taos
+from util.log import *
+from util.cases import *
+from util.sql import *
+from util.dnodes import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql):
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor(), logSql)
+
+    # run the query twice, the second one is answered by the result cache of vnode
+    def cacheQuery(self, sql, rows):
+        for i in range(2):
+            tdSql.query(sql)
+            tdSql.checkRows(rows)
+
+    def run(self):
+        tdDnodes.stop(1)
+        tdDnodes.deploy(1)
+        tdDnodes.cfg(1, "queryCacheKeepTimer", "600")
+        tdDnodes.start(1)
+
+        tdSql.prepare()
+
+        print("==============step1")
+        tdSql.execute(
+            "create table if not exists st (ts timestamp, v int) tags(t1 int, t2 binary(10))")
+        tdSql.execute("create table if not exists c0 using st tags(1, 'a')")
+        tdSql.execute("create table if not exists c1 using st tags(2, 'b')")
+        tdSql.execute(
+            """insert into c0 values('2020-05-13 10:00:00.000', 1) ('2020-05-13 10:00:10.000', 2)
+            ('2020-05-13 10:00:20.000', 3) c1 values('2020-05-13 10:00:00.000', 4) ('2020-05-13 10:00:20.000', 5)""")
+
+        print("==============step2")
+        # a row earlier than the last key of the table changes the version of its data, the cached result is dropped
+        self.cacheQuery(
+            "select count(*), sum(v) from st where ts < '2020-05-13 10:01:00.000' interval(10s)", 3)
+        tdSql.checkData(1, 1, 1)
+        tdSql.checkData(1, 2, 2)
+
+        tdSql.execute("insert into c1 values('2020-05-13 10:00:10.000', 10)")
+        tdSql.query("select count(*), sum(v) from st where ts < '2020-05-13 10:01:00.000' interval(10s)")
+        tdSql.checkRows(3)
+        tdSql.checkData(1, 1, 2)
+        tdSql.checkData(1, 2, 12)
+
+        self.cacheQuery("select count(*) from c0 where ts < '2020-05-13 10:01:00.000'", 1)
+        tdSql.checkData(0, 0, 3)
+        tdSql.execute("insert into c0 values('2020-05-13 10:00:05.000', 7)")
+        tdSql.query("select count(*) from c0 where ts < '2020-05-13 10:01:00.000'")
+        tdSql.checkData(0, 0, 4)
+
+        print("==============step3")
+        # the tag values are set in vnode, the results cached with the old values are not reused
+        self.cacheQuery("select count(*) from st where t1 = 1", 1)
+        tdSql.checkData(0, 0, 4)
+
+        tdSql.execute("alter table c0 set tag t1 = 3")
+        tdSql.query("select count(*) from st where t1 = 1")
+        tdSql.checkRows(0)
+        tdSql.query("select count(*) from st where t1 = 3")
+        tdSql.checkRows(1)
+        tdSql.checkData(0, 0, 4)
+
+        self.cacheQuery("select count(*) from st where t2 = 'b'", 1)
+        tdSql.checkData(0, 0, 3)
+        tdSql.execute("alter table c1 set tag t2 = 'c'")
+        tdSql.query("select count(*) from st where t2 = 'b'")
+        tdSql.checkRows(0)
+        tdSql.query("select count(*) from st where t2 = 'c'")
+        tdSql.checkRows(1)
+        tdSql.checkData(0, 0, 3)
+
+        tdSql.query("select t2 from st where t1 = 3")
+        tdSql.checkRows(1)
+        tdSql.checkData(0, 0, 'a')
+        tdSql.query("select t1 from st where t2 = 'c'")
+        tdSql.checkRows(1)
+        tdSql.checkData(0, 0, 2)
+
+        tdSql.error("alter table c0 set tag t3 = 1")
+        tdSql.error("alter table c0 set tag t2 = 'abcdefghijkl'")
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,120 @@
+###################################################################
+#           Copyright (c) 2016 by TAOS Technologies, Inc.
+#                     All rights reserved.
+#
+#  This file is proprietary and confidential to TAOS Technologies.
+#  No part of this file may be reproduced, stored, transmitted,
+#  disclosed or used in any form or by any means other than as
+#  expressly provided by the written permission from Jianhui Tao
+#
+###################################################################
+
+# -*- coding: utf-8 -*-
+
+import sys
+import taos
+from util.log import *
+from util.cases import *
+from util.sql import *
+from util.dnodes import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql):
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor(), logSql)
+
+    # c1 is NULL in every 7th row, c2 in 30 rows out of every 200, and c3 in all rows if nullC3 is set
+    def insertRows(self, tb, step, numOfRows, nullC3):
+        for k in range(0, numOfRows, 200):
+            values = []
+            for n in range(k, min(k + 200, numOfRows)):
+                c1 = None if n % 7 == 0 else n - 1000
+                c2 = None if n % 200 < 30 else n * 0.25
+                c3 = None if nullC3 else n * 3
+                self.rows.append((self.startTime + n * step, c1, c2, c3))
+                values.append("(%d, %s, %s, %s)" % (self.startTime + n * step, "null" if c1 is None else c1,
+                                                     "null" if c2 is None else c2, "null" if c3 is None else c3))
+            tdSql.execute("insert into %s values %s" % (tb, " ".join(values)))
+        self.tables[tb] = self.rows[-numOfRows:]
+
+    # the results of the windows with rows, computed from the rows written
+    def expected(self, rows, interval, skey, ekey):
+        windows = {}
+        for row in rows:
+            if skey <= row[0] <= ekey:
+                windows.setdefault(row[0] - row[0] % interval, []).append(row)
+
+        result = []
+        for start in sorted(windows.keys()):
+            c1 = [r[1] for r in windows[start] if r[1] is not None]
+            c2 = [r[2] for r in windows[start] if r[2] is not None]
+            c3 = [r[3] for r in windows[start] if r[3] is not None]
+            result.append((len(windows[start]), len(c1), sum(c1) if c1 else None, min(c1) if c1 else None,
+                           max(c1) if c1 else None, float(max(c1) - min(c1)) if c1 else None,
+                           sum(c2) / len(c2) if c2 else None, max(c2) if c2 else None, sum(c3) if c3 else None))
+        return result
+
+    def checkQuery(self, tb, interval, unit, skey, ekey):
+        sql = ("select count(*), count(c1), sum(c1), min(c1), max(c1), spread(c1), avg(c2), max(c2), sum(c3) "
+               "from %s where ts >= %d and ts <= %d interval(%d%s)" % (tb, skey, ekey, interval, unit))
+        rows = self.rows if tb == "st" else self.tables[tb]
+        expected = self.expected(rows, interval * {"s": 1000, "m": 60000, "h": 3600000}[unit], skey, ekey)
+
+        tdSql.query(sql)
+        tdSql.checkRows(len(expected))
+        for i in range(len(expected)):
+            if tuple(tdSql.queryResult[i][1:]) != expected[i]:
+                tdLog.exit("%s failed: sql:%s, row:%d %s != expect:%s" %
+                           (__file__, sql, i, tdSql.queryResult[i][1:], expected[i]))
+
+    def checkAll(self):
+        ekey = self.startTime + 86400000
+        for tb in ["t0", "t1", "st"]:
+            # the windows of whole rollup windows, in the coarsest tier or not
+            self.checkQuery(tb, 1, "m", self.startTime, ekey)
+            self.checkQuery(tb, 2, "m", self.startTime, ekey)
+            self.checkQuery(tb, 1, "h", self.startTime, ekey)
+            self.checkQuery(tb, 2, "h", self.startTime, ekey)
+
+            # the windows not made of rollup windows and the blocks partly in the time range read the block data
+            self.checkQuery(tb, 90, "s", self.startTime, ekey)
+            self.checkQuery(tb, 1, "m", self.startTime + 35000, self.startTime + 3 * 3600000 + 35000)
+
+    def run(self):
+        tdDnodes.stop(1)
+        tdDnodes.deploy(1)
+        tdDnodes.cfg(1, "rollupInterval", "1m,1h")
+        tdDnodes.start(1)
+
+        tdSql.prepare()
+
+        print("==============step1")
+        self.startTime = 1600041600000
+        self.rows = []
+        self.tables = {}
+        tdSql.execute("create table st (ts timestamp, c1 int, c2 double, c3 bigint) tags(t int)")
+        tdSql.execute("create table t0 using st tags(0)")
+        tdSql.execute("create table t1 using st tags(1)")
+
+        # t1 has 2 rows per minute, so the blocks of it keep only the tier of one hour
+        self.insertRows("t0", 10000, 2160, False)
+        self.insertRows("t1", 30000, 720, True)
+
+        # the rows in cache have no rollup
+        self.checkAll()
+
+        print("==============step2")
+        # the rollups are written by the commit when the vnode is closed
+        tdDnodes.stop(1)
+        tdDnodes.start(1)
+        tdSql.execute("use db")
+        self.checkAll()
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
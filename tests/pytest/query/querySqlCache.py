@@ -0,0 +1,201 @@
+###################################################################
+#           Copyright (c) 2016 by TAOS Technologies, Inc.
+#                     All rights reserved.
+#
+#  This file is proprietary and confidential to TAOS Technologies.
+#  No part of this file may be reproduced, stored, transmitted,
+#  disclosed or used in any form or by any means other than as
+#  expressly provided by the written permission from Jianhui Tao
+#
+###################################################################
+
+# -*- coding: utf-8 -*-
+
+import sys
+import os
+import re
+import subprocess
+import taos
+from util.log import *
+from util.cases import *
+from util.sql import *
+from util.dnodes import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql):
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor(), logSql)
+
+    def getShellPath(self):
+        selfPath = os.path.dirname(os.path.realpath(__file__))
+        projPath = selfPath + "/../../../"
+        for root, dirs, files in os.walk(projPath):
+            if ("taosd" in files and "taos" in files):
+                rootRealPath = os.path.dirname(os.path.realpath(root))
+                if ("packaging" not in rootRealPath):
+                    return os.path.join(root, "taos")
+
+        tdLog.exit("taos not found!")
+
+    # the sql cache is disabled by default, so the statements are run by the shell with its own config
+    def deployShell(self):
+        self.shell = self.getShellPath()
+        self.cfgDir = "%s/sqlcache/cfg" % os.path.dirname(tdDnodes.sim.logDir)
+        self.logDir = "%s/sqlcache/log" % os.path.dirname(tdDnodes.sim.logDir)
+        os.system("rm -rf %s %s; mkdir -p %s %s" % (self.cfgDir, self.logDir, self.cfgDir, self.logDir))
+
+        with open(tdDnodes.getSimCfgPath() + "/taos.cfg") as f:
+            cfg = [line for line in f if not line.startswith("logDir")]
+        with open(self.cfgDir + "/taos.cfg", "w") as f:
+            f.writelines(cfg)
+            f.write("logDir %s\n" % self.logDir)
+            f.write("sqlCacheKeepTimer 600\n")
+
+    # the statements are run in one shell, so the templates cached by the former ones are used by the latter ones
+    def runScript(self, sqls):
+        script = os.path.dirname(self.cfgDir) + "/sqlcache.sql"
+        with open(script, "w") as f:
+            f.write("\n".join(sqls) + "\n")
+
+        try:
+            output = subprocess.check_output([self.shell, "-c", self.cfgDir, "-f", script], stderr=subprocess.DEVNULL,
+                                             timeout=60)
+        except subprocess.TimeoutExpired:
+            tdLog.exit("%s failed: %s is not completed in 60 seconds" % (__file__, script))
+        except subprocess.CalledProcessError as e:
+            tdLog.exit("%s failed: %s, shell exits with %d" % (__file__, script, e.returncode))
+
+        # the lines printed for each statement follow the statement itself, while the lines of the client log are
+        # written to stdout between the buffered outputs of the shell, even in the middle of a line
+        logLine = "\\d{2}/\\d{2} \\d{2}:\\d{2}:\\d{2}\\.\\d{6} 0x\\d+ [^\\n]*\\n"
+        output = re.sub(logLine, "", output.decode("utf-8", "ignore"))
+        self.outputs = {}
+        lines = None
+        for line in output.splitlines():
+            if line.startswith("taos> "):
+                lines = []
+                self.outputs.setdefault(line[len("taos> "):].strip(), []).append(lines)
+            elif lines is not None:
+                lines.append(line)
+
+    # the columns and the rows printed for the nth run of the statement, or None if it failed
+    def result(self, sql, nth):
+        lines = self.outputs[sql][nth]
+        if not any(line.startswith("Query OK") for line in lines):
+            return None
+
+        table = [[cell.strip() for cell in line.split("|")][:-1] for line in lines if "|" in line]
+        return table[0], table[1:]
+
+    def checkResult(self, sql, nth, numOfCols, rows):
+        result = self.result(sql, nth)
+        if result is None or len(result[0]) != numOfCols or sorted(result[1]) != sorted(rows):
+            tdLog.exit("%s failed: run:%d of sql:%s, %s != expect:%d columns, %s" %
+                       (__file__, nth, sql, result, numOfCols, rows))
+        tdLog.info("run:%d of sql:%s, %d rows are expected" % (nth, sql, len(rows)))
+
+    def checkError(self, sql, nth):
+        if self.result(sql, nth) is not None:
+            tdLog.exit("%s failed: run:%d of sql:%s is expected to fail, %s" %
+                       (__file__, nth, sql, self.result(sql, nth)))
+        tdLog.info("run:%d of sql:%s is failed as expected" % (nth, sql))
+
+    def logLines(self, pattern):
+        lines = []
+        for name in sorted(os.listdir(self.logDir)):
+            with open(os.path.join(self.logDir, name), errors="ignore") as f:
+                lines += [line for line in f if re.search(pattern, line)]
+        return lines
+
+    def run(self):
+        tdSql.prepare()
+
+        print("==============step1")
+        tdSql.execute(
+            "create table if not exists st (ts timestamp, v int, v2 int) tags(t1 int, t2 int)")
+        tdSql.execute('create table if not exists c0 using st tags(1, 10)')
+        tdSql.execute('create table if not exists c1 using st tags(2, 20)')
+        tdSql.execute(
+            """insert into c0 values('2020-05-13 10:00:00.000', 1, 10) ('2020-05-13 10:00:01.000', 2, 20)
+            c1 values('2020-05-13 10:00:00.000', 3, 30)""")
+
+        self.deployShell()
+        groupByT1 = "select count(*) from db.st group by t1;"
+        groupByT2 = "select count(*) from db.st group by t2;"
+        selectAll = "select * from db.st where ts >= '2020-05-13 10:00:00.000';"
+        countByT3 = "select count(*) from db.st where t3 = 2;"
+        self.runScript([
+            # the tag is renamed between two identical statements, the meta of the super table is removed from the
+            # cache by the alter, so the second one is parsed again
+            groupByT1, groupByT1,
+            "alter table db.st change tag t1 t3;",
+            groupByT1,
+            "select count(*) from db.st group by t3;",
+
+            # a column is dropped between two identical statements, it is not returned by the second one
+            selectAll, selectAll,
+            "alter table db.st drop column v2;",
+            selectAll, selectAll,
+
+            # the tag value of a table is changed between two identical statements, the tags are filtered by vnodes
+            countByT3, countByT3,
+            "alter table db.c0 set tag t3 = 2;",
+            countByT3,
+
+            # the tag is dropped and another one is added, only the tag version is changed, and the new meta of the
+            # super table is retrieved by another statement, so the cached template finds the changed schema
+            groupByT2, groupByT2,
+            "alter table db.st drop tag t2;",
+            "alter table db.st add tag t4 int;",
+            "select count(*) from db.st;",
+            groupByT2,
+            "select count(*) from db.st group by t4;",
+        ])
+
+        print("==============step2")
+        self.checkResult(groupByT1, 0, 2, [["2", "1"], ["1", "2"]])
+        self.checkResult(groupByT1, 1, 2, [["2", "1"], ["1", "2"]])
+        self.checkError(groupByT1, 2)
+        self.checkResult("select count(*) from db.st group by t3;", 0, 2, [["2", "1"], ["1", "2"]])
+
+        print("==============step3")
+        # the tags follow the columns
+        rows = [["2020-05-13 10:00:00.000", "1"], ["2020-05-13 10:00:01.000", "2"], ["2020-05-13 10:00:00.000", "3"]]
+        tags = [["1", "10"], ["1", "10"], ["2", "20"]]
+        self.checkResult(selectAll, 0, 5, [rows[i] + [str((i + 1) * 10)] + tags[i] for i in range(3)])
+        self.checkResult(selectAll, 1, 5, [rows[i] + [str((i + 1) * 10)] + tags[i] for i in range(3)])
+        self.checkResult(selectAll, 2, 4, [rows[i] + tags[i] for i in range(3)])
+        self.checkResult(selectAll, 3, 4, [rows[i] + tags[i] for i in range(3)])
+
+        print("==============step4")
+        self.checkResult(countByT3, 0, 1, [["1"]])
+        self.checkResult(countByT3, 1, 1, [["1"]])
+        self.checkResult(countByT3, 2, 1, [["3"]])
+
+        print("==============step5")
+        self.checkResult(groupByT2, 0, 2, [["2", "10"], ["1", "20"]])
+        self.checkResult(groupByT2, 1, 2, [["2", "10"], ["1", "20"]])
+        self.checkError(groupByT2, 2)
+        self.checkResult("select count(*) from db.st;", 0, 1, [["3"]])
+
+        # the existing tables have the same value of the new tag
+        result = self.result("select count(*) from db.st group by t4;", 0)
+        if result is None or [row[0] for row in result[1]] != ["3"]:
+            tdLog.exit("%s failed: the tables are not in one group of the new tag, %s" % (__file__, result))
+
+        # the templates are used by the second ones of the identical statements, and after the tag value is changed,
+        # while not after the schema is changed
+        if len(self.logLines("query is built from the sql template")) != 6:
+            tdLog.exit("%s failed: %d statements are built from the templates, expect:6" %
+                       (__file__, len(self.logLines("query is built from the sql template"))))
+        if len(self.logLines("table meta of \\S*st is changed, the sql template is not used")) != 1:
+            tdLog.exit("%s failed: the changed schema is not found by the template" % __file__)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,141 @@
+###################################################################
+#           Copyright (c) 2016 by TAOS Technologies, Inc.
+#                     All rights reserved.
+#
+#  This file is proprietary and confidential to TAOS Technologies.
+#  No part of this file may be reproduced, stored, transmitted,
+#  disclosed or used in any form or by any means other than as
+#  expressly provided by the written permission from Jianhui Tao
+#
+###################################################################
+
+# -*- coding: utf-8 -*-
+
+import sys
+import os
+import re
+import taos
+from util.log import *
+from util.cases import *
+from util.sql import *
+from util.dnodes import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql):
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor(), logSql)
+
+    # the lines of the dnode log matching the pattern, which are written synchronously
+    def logLines(self, pattern):
+        lines = []
+        logDir = tdDnodes.dnodes[0].logDir
+        for name in sorted(os.listdir(logDir)):
+            with open(os.path.join(logDir, name), errors="ignore") as f:
+                lines += [line for line in f if re.search(pattern, line)]
+        return lines
+
+    # the number of vgroups queried for the condition
+    def checkQueriedVgroups(self, cond, match, numOfVgroups):
+        queried = "vgId:\\d+, QInfo:\\S+, dnode query msg disposed"
+        count = len(self.logLines(queried))
+        self.checkCond(cond, match)
+        if len(self.logLines(queried)) - count != numOfVgroups:
+            tdLog.exit("%s failed: %d vgroups are queried for %s, expect:%d" %
+                       (__file__, len(self.logLines(queried)) - count, cond, numOfVgroups))
+
+    # every table whose tags match the condition is queried, as if no vgroup is skipped
+    def checkCond(self, cond, match):
+        expected = [tb for tb, tags in self.tables.items() if match(tags)]
+        tdSql.query("select * from st where %s" % cond)
+        tdSql.checkRows(2 * len(expected))
+
+    def checkAll(self):
+        for v in list(range(-1, 13)) + [100, 101, 102, 103]:
+            self.checkCond("t1 = %d" % v, lambda tags: tags[0] == v)
+        for v in ["g0", "g1", "g2", "g3", "g4", "h"]:
+            self.checkCond("t2 = '%s'" % v, lambda tags: tags[1] == v)
+
+        self.checkCond("t1 = 1 or t1 = 10", lambda tags: tags[0] in [1, 10])
+        self.checkCond("t1 = 7 and t2 = 'g3'", lambda tags: tags[0] == 7 and tags[1] == "g3")
+        self.checkCond("t1 = 7 and t2 = 'g0'", lambda tags: False)
+        # the vgroup of t2 and t3 may match, while none of its tables does
+        self.checkCond("(t1 = 2 or t1 = 11) and t2 = 'g3'", lambda tags: tags[0] in [2, 11] and tags[1] == "g3")
+
+        # float tags are not summarized
+        self.checkCond("t3 = 4.5", lambda tags: tags[2] == 4.5)
+
+    def run(self):
+        # the vgroups queried are counted in the log of the dnode
+        tdDnodes.stop(1)
+        tdDnodes.deploy(1)
+        tdDnodes.start(1)
+
+        tdSql.execute("drop database if exists db")
+        tdSql.execute("create database db maxTables 4")
+        tdSql.execute("use db")
+
+        print("==============step1")
+        # the tables fill 3 vgroups in turn
+        tdSql.execute("create table st (ts timestamp, v int) tags(t1 int, t2 binary(10), t3 float)")
+        self.tables = {}
+        for i in range(12):
+            tb = "t%d" % i
+            self.tables[tb] = [i, "g%d" % (i % 4), i * 1.5]
+            tdSql.execute("create table %s using st tags(%d, 'g%d', %f)" % (tb, i, i % 4, i * 1.5))
+            tdSql.execute("insert into %s values(1520000010000, %d) (1520000020000, %d)" % (tb, i, i))
+
+        tdSql.query("show vgroups")
+        tdSql.checkRows(3)
+        self.checkAll()
+
+        # only the vgroups which may hold the qualified tables are queried
+        self.checkQueriedVgroups("t1 = 5", lambda tags: tags[0] == 5, 1)
+        self.checkQueriedVgroups("t1 = 1 or t1 = 10", lambda tags: tags[0] in [1, 10], 2)
+        self.checkQueriedVgroups("t1 = 20", lambda tags: False, 0)
+        self.checkQueriedVgroups("t3 = 4.5", lambda tags: tags[2] == 4.5, 3)
+
+        print("==============step2")
+        # the new values of the tags are added to the filters
+        for i in range(4):
+            tdSql.execute("alter table t%d set tag t1 = %d" % (i, 100 + i))
+            self.tables["t%d" % i][0] = 100 + i
+        tdSql.execute("alter table t5 set tag t2 = 'h'")
+        self.tables["t5"][1] = "h"
+        self.checkAll()
+
+        print("==============step3")
+        # the values of the dropped tables are kept in the filters, while no more tables are dropped than remain
+        for i in [4, 6, 8, 9]:
+            tdSql.execute("drop table t%d" % i)
+            del self.tables["t%d" % i]
+        self.checkAll()
+
+        # the vgroup of t4-t7 is still queried for the values of the dropped tables
+        self.checkQueriedVgroups("t1 = 4", lambda tags: False, 1)
+
+        # the filter of it is rebuilt when more tables are dropped than remain
+        tdSql.execute("drop table t5")
+        del self.tables["t5"]
+        if len(self.logLines("stable:\\S*st, tag bloom filter of vgId:\\d+ is rebuilt, numOfTables:1")) != 1:
+            tdLog.exit("%s failed: the tag bloom filter is not rebuilt after the tables are dropped" % __file__)
+
+        self.checkAll()
+        self.checkQueriedVgroups("t1 = 4", lambda tags: False, 0)
+        self.checkQueriedVgroups("t1 = 7", lambda tags: tags[0] == 7, 1)
+
+        print("==============step4")
+        # the filters are rebuilt from the hashes of the tables kept by mnode
+        tdDnodes.stop(1)
+        tdDnodes.start(1)
+        tdSql.execute("use db")
+        self.checkAll()
+        self.checkQueriedVgroups("t1 = 4", lambda tags: False, 0)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
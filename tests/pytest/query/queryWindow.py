@@ -0,0 +1,119 @@
+###################################################################
+#           Copyright (c) 2016 by TAOS Technologies, Inc.
+#                     All rights reserved.
+#
+#  This file is proprietary and confidential to TAOS Technologies.
+#  No part of this file may be reproduced, stored, transmitted,
+#  disclosed or used in any form or by any means other than as
+#  expressly provided by the written permission from Jianhui Tao
+#
+###################################################################
+
+# -*- coding: utf-8 -*-
+
+import sys
+import datetime
+import taos
+from util.log import *
+from util.cases import *
+from util.sql import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql):
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor(), logSql)
+
+    # the start of a window, in seconds from the first row
+    def startOf(self, seconds):
+        return self.startTime + datetime.timedelta(seconds=seconds)
+
+    def checkWindows(self, windows):
+        tdSql.checkRows(len(windows))
+        for i in range(len(windows)):
+            for j in range(len(windows[i])):
+                tdSql.checkData(i, j, windows[i][j])
+
+    def run(self):
+        tdSql.prepare()
+        self.startTime = datetime.datetime(2020, 5, 13, 10, 0, 0)
+
+        print("==============step1")
+        tdSql.execute(
+            "create table if not exists st (ts timestamp, v int, f float, s int) tags(g int)")
+        tdSql.execute('create table if not exists t0 using st tags(1)')
+        tdSql.execute('create table if not exists t1 using st tags(1)')
+        tdSql.execute('create table if not exists t2 using st tags(2)')
+
+        print("==============step2")
+        tdSql.execute(
+            """insert into t0 values('2020-05-13 10:00:00.000', 1, 0.1, 1) ('2020-05-13 10:00:05.000', 2, 0.2, 1)
+            ('2020-05-13 10:00:10.000', 3, 0.3, 2) ('2020-05-13 10:00:30.000', 4, 0.4, 2)
+            ('2020-05-13 10:00:35.000', 5, 0.5, 2) ('2020-05-13 10:01:40.000', 6, 0.6, 1)
+            t1 values('2020-05-13 10:00:03.000', 10, 1.0, 5) ('2020-05-13 10:00:50.000', 20, 2.0, 5)
+            ('2020-05-13 10:00:53.000', 30, 3.0, 6) ('2020-05-13 10:02:00.000', 40, 4.0, 6)
+            t2 values('2020-05-13 10:00:00.000', 100, 10.0, 7) ('2020-05-13 10:00:15.000', 200, 20.0, 7)
+            ('2020-05-13 10:00:30.000', 300, 30.0, 7)""")
+
+        # session window on a normal table, the start of each window is the first column
+        tdSql.query("select count(*), sum(v) from t0 session(ts, 10s)")
+        self.checkWindows([
+            [self.startOf(0), 3, 6],
+            [self.startOf(30), 2, 9],
+            [self.startOf(100), 1, 6]])
+
+        # session window on a super table, the rows of all the tables are in the same windows
+        tdSql.query("select count(*), sum(v) from st session(ts, 10s)")
+        self.checkWindows([
+            [self.startOf(0), 6, 316],
+            [self.startOf(30), 3, 309],
+            [self.startOf(50), 2, 50],
+            [self.startOf(100), 1, 6],
+            [self.startOf(120), 1, 40]])
+
+        # session window on a super table grouped by tag
+        tdSql.query("select count(*), sum(v) from st session(ts, 10s) group by g")
+        self.checkWindows([
+            [self.startOf(0), 4, 16, 1],
+            [self.startOf(30), 2, 9, 1],
+            [self.startOf(50), 2, 50, 1],
+            [self.startOf(100), 1, 6, 1],
+            [self.startOf(120), 1, 40, 1],
+            [self.startOf(0), 1, 100, 2],
+            [self.startOf(15), 1, 200, 2],
+            [self.startOf(30), 1, 300, 2]])
+
+        # state window on a normal table
+        tdSql.query("select count(*), sum(v) from t0 state_window(s)")
+        self.checkWindows([
+            [self.startOf(0), 2, 3],
+            [self.startOf(10), 3, 12],
+            [self.startOf(100), 1, 6]])
+
+        # state window on a super table grouped by tbname
+        tdSql.query("select count(*), sum(v) from st state_window(s) group by tbname")
+        self.checkWindows([
+            [self.startOf(0), 2, 3, "t0"],
+            [self.startOf(10), 3, 12, "t0"],
+            [self.startOf(100), 1, 6, "t0"],
+            [self.startOf(3), 2, 30, "t1"],
+            [self.startOf(53), 2, 70, "t1"],
+            [self.startOf(0), 3, 600, "t2"]])
+
+        # state window on the timestamp, on a column that is not integer, and on a super table without tbname
+        tdSql.error("select count(*) from t0 state_window(ts)")
+        tdSql.error("select count(*) from t0 state_window(f)")
+        tdSql.error("select count(*) from st state_window(s)")
+        tdSql.error("select count(*) from st state_window(s) group by g")
+
+        # session window on a column other than the timestamp, or without the gap
+        tdSql.error("select count(*) from t0 session(v, 10s)")
+        tdSql.error("select count(*) from t0 session(ts)")
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
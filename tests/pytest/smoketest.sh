@@ -24,6 +24,10 @@ python3 ./test.py $1 -f insert/nchar.py
 python3 ./test.py $1 -s && sleep 1
 python3 ./test.py $1 -f insert/multi.py
 python3 ./test.py $1 -s && sleep 1
+python3 ./test.py $1 -f insert/updateMode.py
+python3 ./test.py $1 -s && sleep 1
+python3 ./test.py $1 -f insert/metaBatch.py
+python3 ./test.py $1 -s && sleep 1
 
 # table
 python3 ./test.py $1 -f table/column_name.py
@@ -32,6 +36,8 @@ python3 ./test.py $1 -f table/column_num.py
 python3 ./test.py $1 -s && sleep 1
 python3 ./test.py $1 -f table/db_table.py
 python3 ./test.py $1 -s && sleep 1
+python3 ./test.py $1 -f table/child_tables.py
+python3 ./test.py $1 -s && sleep 1
 
 # import
 python3 ./test.py $1 -f import_merge/importDataLastSub.py
@@ -62,4 +68,19 @@ python3 ./test.py $1 -f query/queryNormal.py
 python3 ./test.py $1 -s && sleep 1
 python3 ./test.py $1 -f query/queryError.py
 python3 ./test.py $1 -s && sleep 1
+python3 ./test.py $1 -f query/queryWindow.py
+python3 ./test.py $1 -s && sleep 1
+python3 ./test.py $1 -f query/querySqlCache.py
+python3 ./test.py $1 -f query/queryResultCache.py
+python3 ./test.py $1 -s && sleep 1
 
+python3 ./test.py $1 -f query/queryRollup.py
+python3 ./test.py $1 -s && sleep 1
+python3 ./test.py $1 -f query/queryTagBloom.py
+python3 ./test.py $1 -s && sleep 1
+python3 ./test.py $1 -f query/queryBinaryStatis.py
+python3 ./test.py $1 -s && sleep 1
+python3 ./test.py $1 -f query/queryBloomFilter.py
+python3 ./test.py $1 -s && sleep 1
+python3 ./test.py $1 -f query/queryConcurrentSubqueries.py
+python3 ./test.py $1 -s && sleep 1
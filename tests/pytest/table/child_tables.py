@@ -0,0 +1,135 @@
+###################################################################
+#           Copyright (c) 2016 by TAOS Technologies, Inc.
+#                     All rights reserved.
+#
+#  This file is proprietary and confidential to TAOS Technologies.
+#  No part of this file may be reproduced, stored, transmitted,
+#  disclosed or used in any form or by any means other than as
+#  expressly provided by the written permission from Jianhui Tao
+#
+###################################################################
+
+# -*- coding: utf-8 -*-
+
+import sys
+import taos
+from util.log import *
+from util.cases import *
+from util.sql import *
+from util.dnodes import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql):
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor(), logSql)
+
+    # the tables of show tables are compared with the expected ones, they are retrieved in batches of 100 rows
+    def checkTables(self, sql, tables):
+        tdSql.query(sql)
+        names = sorted([row[0] for row in tdSql.queryResult])
+        if names != sorted(tables):
+            tdLog.exit("%s failed: %s returns %d tables, expect:%d, unexpected:%s, missing:%s" %
+                       (__file__, sql, len(names), len(tables), sorted(set(names) - set(tables))[:5],
+                        sorted(set(tables) - set(names))[:5]))
+        tdLog.info("%s returns %d tables" % (sql, len(names)))
+
+    # the number of child tables of the super table in show stables
+    def checkChildTables(self, db, stable, numOfTables):
+        tdSql.query("show %s.stables" % db)
+        tables = [row[4] for row in tdSql.queryResult if row[0] == stable]
+        if tables != [numOfTables]:
+            tdLog.exit("%s failed: %s.%s has child tables:%s, expect:%d" % (__file__, db, stable, tables, numOfTables))
+
+    def createTables(self, db, stable, prefix, numOfTables):
+        for i in range(numOfTables):
+            tdSql.execute("create table %s.%s%d using %s.%s tags(%d)" % (db, prefix, i, db, stable, i))
+        return ["%s%d" % (prefix, i) for i in range(numOfTables)]
+
+    def run(self):
+        tdSql.execute("drop database if exists db")
+        tdSql.execute("drop database if exists db2")
+
+        print("==============step1")
+        # the tables are spread over many vgroups of 10 tables, and db2 has the name of db as its prefix
+        tdSql.execute("create database db maxtables 10")
+        tdSql.execute("create database db2 maxtables 10")
+        tdSql.execute("use db")
+        tdSql.execute("create table st1 (ts timestamp, i int) tags(j int)")
+        tdSql.execute("create table st2 (ts timestamp, i int) tags(j int)")
+        tdSql.execute("create table db2.st1 (ts timestamp, i int) tags(j int)")
+
+        ct = self.createTables("db", "st1", "ct", 120)
+        cu = self.createTables("db", "st2", "cu", 60)
+        nt = ["nt%d" % i for i in range(30)]
+        for name in nt:
+            tdSql.execute("create table %s (ts timestamp, i int)" % name)
+        dt = self.createTables("db2", "st1", "dt", 20)
+
+        print("==============step2")
+        # only the tables of the db are listed, and the pattern is applied to each of them
+        self.checkTables("show tables", ct + cu + nt)
+        self.checkTables("show tables like 'cu%'", cu)
+        self.checkTables("show db2.tables", dt)
+        self.checkChildTables("db", "st1", 120)
+        self.checkChildTables("db", "st2", 60)
+        self.checkChildTables("db2", "st1", 20)
+
+        print("==============step3")
+        # the child tables dropped one by one, or altered, are kept in the list of their super table
+        for i in range(20):
+            tdSql.execute("drop table ct%d" % i)
+        ct = ct[20:]
+        tdSql.execute("alter table ct20 set tag j = 1000")
+        tdSql.execute("alter table st1 add column k int")
+        tdSql.execute("insert into ct20 values(now, 1, 2)")
+        self.checkChildTables("db", "st1", 100)
+
+        # only the child tables of the super table dropped are dropped
+        tdSql.execute("drop table st2")
+        self.checkTables("show tables", ct + nt)
+        self.checkTables("show db2.tables", dt)
+        self.checkChildTables("db", "st1", 100)
+
+        print("==============step4")
+        # the lists are built again when the tables are loaded after restart
+        tdDnodes.stop(1)
+        tdDnodes.start(1)
+        tdSql.execute("use db")
+        self.checkTables("show tables", ct + nt)
+        self.checkChildTables("db", "st1", 100)
+
+        self.createTables("db", "st1", "cv", 15)
+        self.checkChildTables("db", "st1", 115)
+        tdSql.query("select * from ct20")
+        tdSql.checkRows(1)
+
+        tdSql.execute("drop table st1")
+        self.checkTables("show tables", nt)
+        self.checkTables("show db2.tables", dt)
+
+        # the names of the tables dropped can be used again
+        tdSql.execute("create table st1 (ts timestamp, i int) tags(j int)")
+        ct = self.createTables("db", "st1", "ct", 5)
+        self.checkTables("show tables", ct + nt)
+        self.checkChildTables("db", "st1", 5)
+
+        print("==============step5")
+        # dropping db leaves the tables of db2
+        tdSql.execute("drop database db")
+        self.checkTables("show db2.tables", dt)
+        self.checkChildTables("db2", "st1", 20)
+
+        tdDnodes.stop(1)
+        tdDnodes.start(1)
+        self.checkTables("show db2.tables", dt)
+        self.checkChildTables("db2", "st1", 20)
+        tdSql.execute("drop database db2")
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _DEFAULT_SOURCE
+#include "os.h"
+#include "taos.h"
+#include "tulog.h"
+#include "ttime.h"
+#include "tutil.h"
+#include "tglobal.h"
+
+#define GREEN "\033[1;32m"
+#define NC "\033[0m"
+
+typedef struct {
+  int       threadIndex;
+  int64_t   numOfReqs;
+  int64_t   numOfFailed;
+  pthread_t thread;
+} SInfo;
+
+void  shellParseArgument(int argc, char *argv[]);
+void  createDbAndTable();
+void  insertData();
+void  runTest();
+void *queryTest(void *param);
+
+// different aggregates over the same columns of the super table, so the concurrent queries read the same blocks. The
+// filter keeps the queries from being answered by the statistics of blocks
+const char *aggregates[] = {"count(*)", "avg(f)", "max(f), min(f)", "sum(f), sum(i)", "spread(f)", "stddev(f)"};
+
+int64_t numOfTables = 100;
+int64_t rowsPerTable = 10000;
+int64_t numOfThreads = 4;
+int64_t seconds = 10;
+int     queryOnly = 0;
+char    dbName[32] = "db";
+char    stableName[64] = "st";
+
+volatile int stopped = 0;
+
+int main(int argc, char *argv[]) {
+  shellParseArgument(argc, argv);
+  taos_init();
+  if (!queryOnly) {
+    createDbAndTable();
+    insertData();
+  }
+  runTest();
+}
+
+TAOS *connectDb() {
+  char     fqdn[TSDB_FQDN_LEN];
+  uint16_t port;
+
+  taosGetFqdnPortFromEp(tsFirst, fqdn, &port);
+
+  TAOS *con = taos_connect(fqdn, tsDefaultUser, tsDefaultPass, NULL, port);
+  if (con == NULL) {
+    pError("failed to connect to DB, reason:%s", taos_errstr(con));
+    exit(1);
+  }
+
+  return con;
+}
+
+void createDbAndTable() {
+  pPrint("start to create table");
+
+  TAOS *con = connectDb();
+  char  qstr[1024];
+
+  sprintf(qstr, "create database if not exists %s maxtables %" PRId64, dbName, numOfTables + 100);
+  if (taos_query(con, qstr)) {
+    pError("failed to create database:%s, code:%d reason:%s", dbName, taos_errno(con), taos_errstr(con));
+    exit(0);
+  }
+
+  sprintf(qstr, "use %s", dbName);
+  if (taos_query(con, qstr)) {
+    pError("failed to use db, code:%d reason:%s", taos_errno(con), taos_errstr(con));
+    exit(0);
+  }
+
+  sprintf(qstr, "create table if not exists %s(ts timestamp, f double, i int) tags(t int)", stableName);
+  if (taos_query(con, qstr)) {
+    pError("failed to create stable, code:%d reason:%s", taos_errno(con), taos_errstr(con));
+    exit(0);
+  }
+
+  for (int64_t t = 0; t < numOfTables; ++t) {
+    sprintf(qstr, "create table if not exists %s%" PRId64 " using %s tags(%" PRId64 ")", stableName, t, stableName, t);
+    if (taos_query(con, qstr)) {
+      pError("failed to create table %s%" PRId64 ", reason:%s", stableName, t, taos_errstr(con));
+      exit(0);
+    }
+  }
+
+  taos_close(con);
+}
+
+void insertData() {
+  pPrint("start to insert data");
+
+  TAOS *  con = connectDb();
+  char *  qstr = malloc(65536);
+  int64_t st = taosGetTimestampMs();
+  int64_t startTs = 1500000000000L;
+
+  for (int64_t t = 0; t < numOfTables; ++t) {
+    for (int64_t r = 0; r < rowsPerTable;) {
+      int len = sprintf(qstr, "insert into %s.%s%" PRId64 " values", dbName, stableName, t);
+      for (int k = 0; k < 500 && r < rowsPerTable; ++k, ++r) {
+        len += sprintf(qstr + len, "(%" PRId64 ", %f, %d)", startTs + r * 1000, (double)(r % 1000) / 7, (int)(r * t));
+      }
+
+      if (taos_query(con, qstr)) {
+        pError("failed to insert into %s%" PRId64 ", reason:%s", stableName, t, taos_errstr(con));
+        exit(0);
+      }
+    }
+  }
+
+  pPrint("%.1f seconds to insert %" PRId64 " rows, restart taosd to commit them into files and run with -q",
+         (taosGetTimestampMs() - st) / 1000.0, numOfTables * rowsPerTable);
+  free(qstr);
+  taos_close(con);
+}
+
+void runTest() {
+  SInfo *pInfo = (SInfo *)calloc(numOfThreads, sizeof(SInfo));
+
+  pPrint("%" PRId64 " query threads are spawned", numOfThreads);
+
+  pthread_attr_t thattr;
+  pthread_attr_init(&thattr);
+  pthread_attr_setdetachstate(&thattr, PTHREAD_CREATE_JOINABLE);
+
+  for (int i = 0; i < numOfThreads; ++i) {
+    pInfo[i].threadIndex = i;
+    pthread_create(&(pInfo[i].thread), &thattr, queryTest, (void *)(pInfo + i));
+  }
+
+  taosMsleep(seconds * 1000);
+  stopped = 1;
+
+  int64_t queries = 0, failed = 0;
+  for (int i = 0; i < numOfThreads; i++) {
+    pthread_join(pInfo[i].thread, NULL);
+    queries += pInfo[i].numOfReqs;
+    failed += pInfo[i].numOfFailed;
+  }
+
+  pPrint("%sall threads finished in %" PRId64 " seconds, queries:%" PRId64 " (%.1lf/s), failed:%" PRId64 "%s", GREEN,
+         seconds, queries, (double)queries / seconds, failed, NC);
+
+  pthread_attr_destroy(&thattr);
+  free(pInfo);
+}
+
+/*
+ * each thread repeats its own aggregate over all the rows of the super table, so the scans of the same vnode overlap
+ * in time and read the same data blocks
+ */
+void *queryTest(void *param) {
+  SInfo *pInfo = (SInfo *)param;
+  TAOS * con = connectDb();
+  char   qstr[256];
+
+  const char *agg = aggregates[pInfo->threadIndex % (sizeof(aggregates) / sizeof(aggregates[0]))];
+  sprintf(qstr, "select %s from %s.%s where f > 10", agg, dbName, stableName);
+
+  while (!stopped) {
+    if (taos_query(con, qstr)) {
+      pInfo->numOfFailed++;
+    } else {
+      TAOS_RES *result = taos_use_result(con);
+      if (taos_fetch_row(result) == NULL) pInfo->numOfFailed++;
+      taos_free_result(result);
+    }
+    pInfo->numOfReqs++;
+  }
+
+  taos_close(con);
+  return NULL;
+}
+
+void printHelp() {
+  char indent[10] = "        ";
+  printf("Used to test the performance of concurrent queries scanning the same data blocks\n");
+
+  printf("%s%s\n", indent, "-d");
+  printf("%s%s%s%s\n", indent, indent, "The name of the database to be created, default is ", dbName);
+  printf("%s%s\n", indent, "-s");
+  printf("%s%s%s%s\n", indent, indent, "The name of the super table to be created, default is ", stableName);
+  printf("%s%s\n", indent, "-c");
+  printf("%s%s%s%s\n", indent, indent, "Configuration directory, default is ", configDir);
+  printf("%s%s\n", indent, "-n");
+  printf("%s%s%s%" PRId64 "\n", indent, indent, "Number of tables to be created, default is ", numOfTables);
+  printf("%s%s\n", indent, "-r");
+  printf("%s%s%s%" PRId64 "\n", indent, indent, "Number of rows inserted into each table, default is ", rowsPerTable);
+  printf("%s%s\n", indent, "-t");
+  printf("%s%s%s%" PRId64 "\n", indent, indent, "Number of query threads, default is ", numOfThreads);
+  printf("%s%s\n", indent, "-l");
+  printf("%s%s%s%" PRId64 "\n", indent, indent, "Seconds to run the test, default is ", seconds);
+  printf("%s%s\n", indent, "-q");
+  printf("%s%s%s\n", indent, indent, "Only run the queries on the data inserted before");
+
+  exit(EXIT_SUCCESS);
+}
+
+void shellParseArgument(int argc, char *argv[]) {
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+      printHelp();
+      exit(0);
+    } else if (strcmp(argv[i], "-d") == 0) {
+      strcpy(dbName, argv[++i]);
+    } else if (strcmp(argv[i], "-c") == 0) {
+      strcpy(configDir, argv[++i]);
+    } else if (strcmp(argv[i], "-s") == 0) {
+      strcpy(stableName, argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0) {
+      numOfTables = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-r") == 0) {
+      rowsPerTable = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-t") == 0) {
+      numOfThreads = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-l") == 0) {
+      seconds = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-q") == 0) {
+      queryOnly = 1;
+    } else {
+    }
+  }
+
+  if (numOfTables < 1) numOfTables = 1;
+  if (numOfThreads < 1) numOfThreads = 1;
+
+  pPrint("%snumOfTables:%" PRId64 "%s", GREEN, numOfTables, NC);
+  pPrint("%srowsPerTable:%" PRId64 "%s", GREEN, rowsPerTable, NC);
+  pPrint("%snumOfThreads:%" PRId64 "%s", GREEN, numOfThreads, NC);
+  pPrint("%sseconds:%" PRId64 "%s", GREEN, seconds, NC);
+  pPrint("%sdbName:%s%s", GREEN, dbName, NC);
+  pPrint("%sstableName:%s%s", GREEN, stableName, NC);
+  pPrint("%sstart to run%s", GREEN, NC);
+}
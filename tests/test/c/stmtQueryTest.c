@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _DEFAULT_SOURCE
+#include "os.h"
+#include "taos.h"
+#include "taoserror.h"
+#include "tulog.h"
+#include "ttime.h"
+#include "tutil.h"
+#include "tglobal.h"
+
+#define GREEN "\033[1;32m"
+#define NC "\033[0m"
+
+#define NUM_OF_ROWS 100
+
+void  shellParseArgument(int argc, char *argv[]);
+TAOS *connectDb();
+void  execute(TAOS *con, char *qstr);
+void  checkFilters(TAOS *con, char *col, int type);
+void  checkLimit(TAOS *con);
+
+int64_t numOfRounds = 10;
+char    dbName[32] = "sqdb";
+int64_t startTs = 1500000000000;
+
+int main(int argc, char *argv[]) {
+  shellParseArgument(argc, argv);
+  taos_init();
+
+  // row k of the table is (startTs + k seconds, k, k * 0.5)
+  TAOS *con = connectDb();
+  char  qstr[256];
+  sprintf(qstr, "create database if not exists %s", dbName);
+  execute(con, qstr);
+  sprintf(qstr, "use %s", dbName);
+  execute(con, qstr);
+  execute(con, "create table if not exists t (ts timestamp, i int, d double)");
+  for (int32_t k = 0; k < NUM_OF_ROWS; ++k) {
+    sprintf(qstr, "insert into t values(%" PRId64 ", %d, %f)", startTs + k * 1000L, k, k * 0.5);
+    execute(con, qstr);
+  }
+
+  checkFilters(con, "i", TSDB_DATA_TYPE_INT);
+  checkFilters(con, "d", TSDB_DATA_TYPE_DOUBLE);
+  checkLimit(con);
+
+  taos_close(con);
+
+  pPrint("%sall checks passed%s", GREEN, NC);
+  return 0;
+}
+
+TAOS *connectDb() {
+  char     fqdn[TSDB_FQDN_LEN];
+  uint16_t port;
+
+  taosGetFqdnPortFromEp(tsFirst, fqdn, &port);
+
+  TAOS *con = taos_connect(fqdn, tsDefaultUser, tsDefaultPass, NULL, port);
+  if (con == NULL) {
+    pError("failed to connect to DB, reason:%s", taos_errstr(con));
+    exit(1);
+  }
+
+  return con;
+}
+
+void execute(TAOS *con, char *qstr) {
+  if (taos_query(con, qstr)) {
+    pError("failed to run sql:%s, reason:%s", qstr, taos_errstr(con));
+    exit(1);
+  }
+}
+
+TAOS_RES *executeStmt(TAOS_STMT *stmt, TAOS_BIND *bind) {
+  if (taos_stmt_bind_param(stmt, bind) != 0 || taos_stmt_execute(stmt) != 0) {
+    pError("failed to execute the prepared statement");
+    exit(1);
+  }
+
+  return taos_stmt_use_result(stmt);
+}
+
+bool matchOperator(char *optr, double val, double bound) {
+  if (strcmp(optr, "<") == 0) return val < bound;
+  if (strcmp(optr, "<=") == 0) return val <= bound;
+  if (strcmp(optr, ">") == 0) return val > bound;
+  if (strcmp(optr, ">=") == 0) return val >= bound;
+  if (strcmp(optr, "=") == 0) return val == bound;
+  return val != bound;
+}
+
+/*
+ * The statement is parsed by the first execution, and later ones bind the values into the query kept as its template.
+ * Each bound value is set into the upper or the lower bound of the filter according to its operator, and the time
+ * range is moved by the params on the primary timestamp column.
+ */
+void checkFilters(TAOS *con, char *col, int type) {
+  char *optrs[] = {"<", "<=", ">", ">=", "=", "<>"};
+  char  qstr[256];
+
+  for (int32_t o = 0; o < tListLen(optrs); ++o) {
+    sprintf(qstr, "select count(*), sum(i) from t where ts >= ? and ts < ? and %s %s ?", col, optrs[o]);
+
+    TAOS_STMT *stmt = taos_stmt_init(con);
+    if (taos_stmt_prepare(stmt, qstr, 0) != 0) {
+      pError("failed to prepare sql:%s", qstr);
+      exit(1);
+    }
+
+    for (int64_t r = 0; r < numOfRounds; ++r) {
+      int64_t skey = startTs + r * 7 * 1000L;
+      int64_t ekey = skey + 50 * 1000L;
+      int32_t ival = 20 + (int32_t)r * 5;
+      double  dval = 10.5 + r * 2.5;
+
+      TAOS_BIND bind[3] = {{0}};
+      bind[0].buffer_type = TSDB_DATA_TYPE_TIMESTAMP;
+      bind[0].buffer = &skey;
+      bind[1].buffer_type = TSDB_DATA_TYPE_TIMESTAMP;
+      bind[1].buffer = &ekey;
+      bind[2].buffer_type = type;
+      bind[2].buffer = (type == TSDB_DATA_TYPE_INT) ? (void *)&ival : (void *)&dval;
+
+      int64_t count = 0;
+      int64_t sum = 0;
+      for (int32_t k = 0; k < NUM_OF_ROWS; ++k) {
+        int64_t key = startTs + k * 1000L;
+        double  val = (type == TSDB_DATA_TYPE_INT) ? k : k * 0.5;
+        double  bound = (type == TSDB_DATA_TYPE_INT) ? ival : dval;
+        if (key >= skey && key < ekey && matchOperator(optrs[o], val, bound)) {
+          count++;
+          sum += k;
+        }
+      }
+
+      // no row is returned if no row matches
+      TAOS_RES *result = executeStmt(stmt, bind);
+      TAOS_ROW  row = taos_fetch_row(result);
+      int64_t   rcount = (row == NULL) ? 0 : *(int64_t *)row[0];
+      int64_t   rsum = (row == NULL || row[1] == NULL) ? 0 : *(int64_t *)row[1];
+      taos_free_result(result);
+
+      if (rcount != count || rsum != sum) {
+        pError("sql:%s, round:%" PRId64 ", count:%" PRId64 " sum:%" PRId64 ", expect count:%" PRId64 " sum:%" PRId64,
+               qstr, r, rcount, rsum, count, sum);
+        exit(1);
+      }
+    }
+
+    taos_stmt_close(stmt);
+  }
+
+  pPrint("%sthe bound values of the filters on %s are checked%s", GREEN, col, NC);
+}
+
+void checkLimit(TAOS *con) {
+  char *qstr = "select ts, i from t where ts >= ? limit ? offset ?";
+
+  TAOS_STMT *stmt = taos_stmt_init(con);
+  if (taos_stmt_prepare(stmt, qstr, 0) != 0) {
+    pError("failed to prepare sql:%s", qstr);
+    exit(1);
+  }
+
+  for (int64_t r = 0; r < numOfRounds; ++r) {
+    int64_t skey = startTs + r * 3 * 1000L;
+    int64_t limit = 10 + r * 7;
+    int32_t offset = (int32_t)r * 9;
+
+    TAOS_BIND bind[3] = {{0}};
+    bind[0].buffer_type = TSDB_DATA_TYPE_TIMESTAMP;
+    bind[0].buffer = &skey;
+    bind[1].buffer_type = TSDB_DATA_TYPE_BIGINT;
+    bind[1].buffer = &limit;
+    bind[2].buffer_type = TSDB_DATA_TYPE_INT;
+    bind[2].buffer = &offset;
+
+    // the rows from the offset of the ones in the time range
+    int32_t first = (int32_t)r * 3 + offset;
+    int32_t rows = MAX(0, MIN((int32_t)limit, NUM_OF_ROWS - first));
+
+    TAOS_RES *result = executeStmt(stmt, bind);
+    TAOS_ROW  row = NULL;
+    int32_t   n = 0;
+    while ((row = taos_fetch_row(result)) != NULL) {
+      if (*(int32_t *)row[1] != first + n) break;
+      n++;
+    }
+    taos_free_result(result);
+
+    if (n != rows || row != NULL) {
+      pError("sql:%s, round:%" PRId64 ", %d rows are read from %d, expect %d", qstr, r, n, first, rows);
+      exit(1);
+    }
+  }
+
+  taos_stmt_close(stmt);
+  pPrint("%sthe bound values of limit and offset are checked%s", GREEN, NC);
+}
+
+void printHelp() {
+  char indent[10] = "        ";
+  printf("Used to check the results of prepared select statements executed with different bound values\n");
+
+  printf("%s%s\n", indent, "-d");
+  printf("%s%s%s%s\n", indent, indent, "The name of the database to be created, default is ", dbName);
+  printf("%s%s\n", indent, "-c");
+  printf("%s%s%s%s\n", indent, indent, "Configuration directory, default is ", configDir);
+  printf("%s%s\n", indent, "-n");
+  printf("%s%s%s%" PRId64 "\n", indent, indent, "Number of executions of each statement, default is ", numOfRounds);
+
+  exit(EXIT_SUCCESS);
+}
+
+void shellParseArgument(int argc, char *argv[]) {
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+      printHelp();
+      exit(0);
+    } else if (strcmp(argv[i], "-d") == 0) {
+      strcpy(dbName, argv[++i]);
+    } else if (strcmp(argv[i], "-c") == 0) {
+      strcpy(configDir, argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0) {
+      numOfRounds = atoi(argv[++i]);
+    } else {
+    }
+  }
+
+  if (numOfRounds < 1) numOfRounds = 1;
+
+  pPrint("%snumOfRounds:%" PRId64 "%s", GREEN, numOfRounds, NC);
+  pPrint("%sdbName:%s%s", GREEN, dbName, NC);
+  pPrint("%sstart to run%s", GREEN, NC);
+}
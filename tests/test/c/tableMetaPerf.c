@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _DEFAULT_SOURCE
+#include "os.h"
+#include "taos.h"
+#include "tulog.h"
+#include "ttime.h"
+#include "tutil.h"
+#include "tglobal.h"
+
+#define GREEN "\033[1;32m"
+#define NC "\033[0m"
+
+typedef struct {
+  int       threadIndex;
+  int       ddl;         // create and drop tables instead of querying the meta data
+  int64_t   numOfReqs;
+  int64_t   numOfFailed;
+  pthread_t thread;
+} SInfo;
+
+void  shellParseArgument(int argc, char *argv[]);
+void  createDbAndTable();
+void  runTest();
+void *lookupTest(void *param);
+void *ddlTest(void *param);
+
+int64_t numOfTables = 1000;
+int64_t numOfThreads = 4;
+int64_t numOfDdlThreads = 1;
+int64_t tablesPerRequest = 10;
+int64_t seconds = 10;
+char    dbName[32] = "db";
+char    stableName[64] = "st";
+
+volatile int stopped = 0;
+
+int main(int argc, char *argv[]) {
+  shellParseArgument(argc, argv);
+  taos_init();
+  createDbAndTable();
+  runTest();
+}
+
+TAOS *connectDb() {
+  char     fqdn[TSDB_FQDN_LEN];
+  uint16_t port;
+
+  taosGetFqdnPortFromEp(tsFirst, fqdn, &port);
+
+  TAOS *con = taos_connect(fqdn, tsDefaultUser, tsDefaultPass, NULL, port);
+  if (con == NULL) {
+    pError("failed to connect to DB, reason:%s", taos_errstr(con));
+    exit(1);
+  }
+
+  return con;
+}
+
+void createDbAndTable() {
+  pPrint("start to create table");
+
+  TAOS *  con = connectDb();
+  char    qstr[1024];
+  int64_t st = taosGetTimestampMs();
+
+  sprintf(qstr, "create database if not exists %s maxtables %" PRId64, dbName, numOfTables + 1000);
+  if (taos_query(con, qstr)) {
+    pError("failed to create database:%s, code:%d reason:%s", dbName, taos_errno(con), taos_errstr(con));
+    exit(0);
+  }
+
+  sprintf(qstr, "use %s", dbName);
+  if (taos_query(con, qstr)) {
+    pError("failed to use db, code:%d reason:%s", taos_errno(con), taos_errstr(con));
+    exit(0);
+  }
+
+  sprintf(qstr, "create table if not exists %s(ts timestamp, f double) tags(t int)", stableName);
+  if (taos_query(con, qstr)) {
+    pError("failed to create stable, code:%d reason:%s", taos_errno(con), taos_errstr(con));
+    exit(0);
+  }
+
+  for (int64_t t = 0; t < numOfTables; ++t) {
+    sprintf(qstr, "create table if not exists %s%" PRId64 " using %s tags(%" PRId64 ")", stableName, t, stableName, t);
+    if (taos_query(con, qstr)) {
+      pError("failed to create table %s%" PRId64 ", reason:%s", stableName, t, taos_errstr(con));
+      exit(0);
+    }
+  }
+
+  pPrint("%.1f seconds to create %" PRId64 " tables", (taosGetTimestampMs() - st) / 1000.0, numOfTables);
+  taos_close(con);
+}
+
+void runTest() {
+  int64_t total = numOfThreads + numOfDdlThreads;
+  SInfo * pInfo = (SInfo *)calloc(total, sizeof(SInfo));
+
+  pPrint("%" PRId64 " lookup threads and %" PRId64 " ddl threads are spawned", numOfThreads, numOfDdlThreads);
+
+  pthread_attr_t thattr;
+  pthread_attr_init(&thattr);
+  pthread_attr_setdetachstate(&thattr, PTHREAD_CREATE_JOINABLE);
+
+  for (int i = 0; i < total; ++i) {
+    pInfo[i].threadIndex = i;
+    pInfo[i].ddl = (i >= numOfThreads);
+    pthread_create(&(pInfo[i].thread), &thattr, pInfo[i].ddl ? ddlTest : lookupTest, (void *)(pInfo + i));
+  }
+
+  taosMsleep(seconds * 1000);
+  stopped = 1;
+
+  int64_t lookups = 0, ddls = 0, failed = 0;
+  for (int i = 0; i < total; i++) {
+    pthread_join(pInfo[i].thread, NULL);
+    if (pInfo[i].ddl) {
+      ddls += pInfo[i].numOfReqs;
+    } else {
+      lookups += pInfo[i].numOfReqs;
+    }
+    failed += pInfo[i].numOfFailed;
+  }
+
+  pPrint("%sall threads finished in %" PRId64 " seconds, meta queries:%" PRId64 " (%.1lf/s), ddl:%" PRId64
+         " (%.1lf/s), failed:%" PRId64 "%s",
+         GREEN, seconds, lookups, (double)lookups / seconds, ddls, (double)ddls / seconds, failed, NC);
+
+  pthread_attr_destroy(&thattr);
+  free(pInfo);
+}
+
+/*
+ * table meta is cached at the client, so the meta data is loaded by taos_load_table_info, which always sends one
+ * multi-table meta request to mnode for the tables in the list, the super table included
+ */
+void *lookupTest(void *param) {
+  SInfo * pInfo = (SInfo *)param;
+  TAOS *  con = connectDb();
+  char    tableList[32 * 1024];
+  int64_t next = pInfo->threadIndex;
+
+  while (!stopped) {
+    int len = sprintf(tableList, "%s.%s", dbName, stableName);
+    for (int64_t i = 0; i < tablesPerRequest; ++i) {
+      len += sprintf(tableList + len, ",%s.%s%" PRId64, dbName, stableName, next);
+      next = (next + 1) % numOfTables;
+    }
+
+    if (taos_load_table_info(con, tableList) != 0) pInfo->numOfFailed++;
+    pInfo->numOfReqs++;
+  }
+
+  taos_close(con);
+  return NULL;
+}
+
+/*
+ * child tables are created and dropped, and a column is added to and dropped from the super table, so the schema
+ * serialized by the meta requests is changed at the same time
+ */
+void *ddlTest(void *param) {
+  SInfo * pInfo = (SInfo *)param;
+  TAOS *  con = connectDb();
+  char    qstr[256];
+  int64_t seq = 0;
+
+  sprintf(qstr, "use %s", dbName);
+  taos_query(con, qstr);
+
+  while (!stopped) {
+    sprintf(qstr, "create table if not exists ddl%d_%" PRId64 " using %s tags(0)", pInfo->threadIndex, seq, stableName);
+    if (taos_query(con, qstr)) pInfo->numOfFailed++;
+    sprintf(qstr, "alter table %s add column c%d int", stableName, pInfo->threadIndex);
+    if (taos_query(con, qstr)) pInfo->numOfFailed++;
+    sprintf(qstr, "alter table %s drop column c%d", stableName, pInfo->threadIndex);
+    if (taos_query(con, qstr)) pInfo->numOfFailed++;
+    sprintf(qstr, "drop table if exists ddl%d_%" PRId64, pInfo->threadIndex, seq);
+    if (taos_query(con, qstr)) pInfo->numOfFailed++;
+
+    pInfo->numOfReqs += 4;
+    seq++;
+  }
+
+  taos_close(con);
+  return NULL;
+}
+
+void printHelp() {
+  char indent[10] = "        ";
+  printf("Used to test the performance of querying the meta data from mnode while tables are created and dropped\n");
+
+  printf("%s%s\n", indent, "-d");
+  printf("%s%s%s%s\n", indent, indent, "The name of the database to be created, default is ", dbName);
+  printf("%s%s\n", indent, "-s");
+  printf("%s%s%s%s\n", indent, indent, "The name of the super table to be created, default is ", stableName);
+  printf("%s%s\n", indent, "-c");
+  printf("%s%s%s%s\n", indent, indent, "Configuration directory, default is ", configDir);
+  printf("%s%s\n", indent, "-n");
+  printf("%s%s%s%" PRId64 "\n", indent, indent, "Number of tables to be created, default is ", numOfTables);
+  printf("%s%s\n", indent, "-t");
+  printf("%s%s%s%" PRId64 "\n", indent, indent, "Number of threads querying the meta data, default is ", numOfThreads);
+  printf("%s%s\n", indent, "-m");
+  printf("%s%s%s%" PRId64 "\n", indent, indent, "Number of child tables in each meta request, default is ",
+         tablesPerRequest);
+  printf("%s%s\n", indent, "-w");
+  printf("%s%s%s%" PRId64 "\n", indent, indent, "Number of threads creating and dropping tables, default is ",
+         numOfDdlThreads);
+  printf("%s%s\n", indent, "-l");
+  printf("%s%s%s%" PRId64 "\n", indent, indent, "Seconds to run the test, default is ", seconds);
+
+  exit(EXIT_SUCCESS);
+}
+
+void shellParseArgument(int argc, char *argv[]) {
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+      printHelp();
+      exit(0);
+    } else if (strcmp(argv[i], "-d") == 0) {
+      strcpy(dbName, argv[++i]);
+    } else if (strcmp(argv[i], "-c") == 0) {
+      strcpy(configDir, argv[++i]);
+    } else if (strcmp(argv[i], "-s") == 0) {
+      strcpy(stableName, argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0) {
+      numOfTables = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-t") == 0) {
+      numOfThreads = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-m") == 0) {
+      tablesPerRequest = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-w") == 0) {
+      numOfDdlThreads = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-l") == 0) {
+      seconds = atoi(argv[++i]);
+    } else {
+    }
+  }
+
+  if (numOfTables < 1) numOfTables = 1;
+  if (tablesPerRequest < 1) tablesPerRequest = 1;
+  if (tablesPerRequest > 100) tablesPerRequest = 100;
+
+  pPrint("%snumOfTables:%" PRId64 "%s", GREEN, numOfTables, NC);
+  pPrint("%snumOfThreads:%" PRId64 "%s", GREEN, numOfThreads, NC);
+  pPrint("%snumOfDdlThreads:%" PRId64 "%s", GREEN, numOfDdlThreads, NC);
+  pPrint("%stablesPerRequest:%" PRId64 "%s", GREEN, tablesPerRequest, NC);
+  pPrint("%sseconds:%" PRId64 "%s", GREEN, seconds, NC);
+  pPrint("%sdbName:%s%s", GREEN, dbName, NC);
+  pPrint("%sstableName:%s%s", GREEN, stableName, NC);
+  pPrint("%sstart to run%s", GREEN, NC);
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _DEFAULT_SOURCE
+#include "os.h"
+#include "taos.h"
+#include "tulog.h"
+#include "ttime.h"
+#include "tutil.h"
+#include "tglobal.h"
+
+#define GREEN "\033[1;32m"
+#define NC "\033[0m"
+
+typedef struct {
+  int       threadIndex;
+  int64_t   numOfRows;
+  int64_t   numOfFailed;
+  pthread_t thread;
+} SInfo;
+
+void  shellParseArgument(int argc, char *argv[]);
+void  createDbAndTable();
+void  runTest();
+void  checkRows(int64_t expected);
+void *insertTest(void *param);
+
+int64_t numOfThreads = 64;
+int64_t rowsPerThread = 1000;
+int64_t rowsPerInsert = 1;
+char    dbName[32] = "db";
+char    stableName[64] = "st";
+
+int main(int argc, char *argv[]) {
+  shellParseArgument(argc, argv);
+  taos_init();
+  createDbAndTable();
+  runTest();
+}
+
+TAOS *connectDb() {
+  char     fqdn[TSDB_FQDN_LEN];
+  uint16_t port;
+
+  taosGetFqdnPortFromEp(tsFirst, fqdn, &port);
+
+  TAOS *con = taos_connect(fqdn, tsDefaultUser, tsDefaultPass, NULL, port);
+  if (con == NULL) {
+    pError("failed to connect to DB, reason:%s", taos_errstr(con));
+    exit(1);
+  }
+
+  return con;
+}
+
+void createDbAndTable() {
+  pPrint("start to create table");
+
+  TAOS *con = connectDb();
+  char  qstr[1024];
+
+  sprintf(qstr, "create database if not exists %s maxtables %" PRId64, dbName, numOfThreads + 100);
+  if (taos_query(con, qstr)) {
+    pError("failed to create database:%s, code:%d reason:%s", dbName, taos_errno(con), taos_errstr(con));
+    exit(0);
+  }
+
+  sprintf(qstr, "use %s", dbName);
+  if (taos_query(con, qstr)) {
+    pError("failed to use db, code:%d reason:%s", taos_errno(con), taos_errstr(con));
+    exit(0);
+  }
+
+  sprintf(qstr, "create table if not exists %s(ts timestamp, f double) tags(t int)", stableName);
+  if (taos_query(con, qstr)) {
+    pError("failed to create stable, code:%d reason:%s", taos_errno(con), taos_errstr(con));
+    exit(0);
+  }
+
+  for (int64_t t = 0; t < numOfThreads; ++t) {
+    sprintf(qstr, "create table if not exists %s%" PRId64 " using %s tags(%" PRId64 ")", stableName, t, stableName, t);
+    if (taos_query(con, qstr)) {
+      pError("failed to create table %s%" PRId64 ", reason:%s", stableName, t, taos_errstr(con));
+      exit(0);
+    }
+  }
+
+  taos_close(con);
+}
+
+void runTest() {
+  SInfo *pInfo = (SInfo *)calloc(numOfThreads, sizeof(SInfo));
+
+  pPrint("%" PRId64 " threads are spawned, each inserts %" PRId64 " rows into its own table, %" PRId64
+         " rows per insert, write buffer:%d",
+         numOfThreads, rowsPerThread, rowsPerInsert, tsWriteBuffer);
+
+  pthread_attr_t thattr;
+  pthread_attr_init(&thattr);
+  pthread_attr_setdetachstate(&thattr, PTHREAD_CREATE_JOINABLE);
+
+  int64_t st = taosGetTimestampMs();
+
+  for (int i = 0; i < numOfThreads; ++i) {
+    pInfo[i].threadIndex = i;
+    pthread_create(&(pInfo[i].thread), &thattr, insertTest, (void *)(pInfo + i));
+  }
+
+  int64_t rows = 0, failed = 0;
+  for (int i = 0; i < numOfThreads; i++) {
+    pthread_join(pInfo[i].thread, NULL);
+    rows += pInfo[i].numOfRows;
+    failed += pInfo[i].numOfFailed;
+  }
+
+  double seconds = (taosGetTimestampMs() - st) / 1000.0;
+  pPrint("%sall threads finished in %.2lf seconds, rows:%" PRId64 " (%.1lf/s), failed inserts:%" PRId64 "%s", GREEN,
+         seconds, rows, rows / seconds, failed, NC);
+
+  checkRows(rows);
+
+  pthread_attr_destroy(&thattr);
+  free(pInfo);
+}
+
+// each insert is notified with its own rows, so the sum of the affected rows must be the rows in the table
+void checkRows(int64_t expected) {
+  TAOS *con = connectDb();
+  char  qstr[256];
+
+  sprintf(qstr, "select count(*) from %s.%s", dbName, stableName);
+  if (taos_query(con, qstr)) {
+    pError("failed to count the rows, reason:%s", taos_errstr(con));
+    exit(1);
+  }
+
+  TAOS_RES *result = taos_use_result(con);
+  TAOS_ROW  row = taos_fetch_row(result);
+  int64_t   count = (row != NULL) ? *(int64_t *)row[0] : 0;
+  taos_free_result(result);
+  taos_close(con);
+
+  if (count != expected) {
+    pError("rows in table:%" PRId64 ", affected rows reported:%" PRId64, count, expected);
+    exit(1);
+  }
+
+  pPrint("%srows in table:%" PRId64 "%s", GREEN, count, NC);
+}
+
+void *insertTest(void *param) {
+  SInfo * pInfo = (SInfo *)param;
+  TAOS *  con = connectDb();
+  char *  qstr = malloc(rowsPerInsert * 64 + 128);
+  int64_t ts = 1500000000000;
+
+  for (int64_t r = 0; r < rowsPerThread; r += rowsPerInsert) {
+    int len = sprintf(qstr, "insert into %s.%s%d values", dbName, stableName, pInfo->threadIndex);
+    for (int64_t i = 0; i < rowsPerInsert && r + i < rowsPerThread; ++i) {
+      len += sprintf(qstr + len, " (%" PRId64 ", %" PRId64 ")", ts++, r + i);
+    }
+
+    if (taos_query(con, qstr)) {
+      pInfo->numOfFailed++;
+    } else {
+      pInfo->numOfRows += taos_affected_rows(con);
+    }
+  }
+
+  free(qstr);
+  taos_close(con);
+  return NULL;
+}
+
+void printHelp() {
+  char indent[10] = "        ";
+  printf("Used to test the performance of small inserts issued concurrently by many threads of a client\n");
+
+  printf("%s%s\n", indent, "-d");
+  printf("%s%s%s%s\n", indent, indent, "The name of the database to be created, default is ", dbName);
+  printf("%s%s\n", indent, "-s");
+  printf("%s%s%s%s\n", indent, indent, "The name of the super table to be created, default is ", stableName);
+  printf("%s%s\n", indent, "-c");
+  printf("%s%s%s%s\n", indent, indent, "Configuration directory, default is ", configDir);
+  printf("%s%s\n", indent, "-t");
+  printf("%s%s%s%" PRId64 "\n", indent, indent, "Number of threads, each inserts into its own table, default is ",
+         numOfThreads);
+  printf("%s%s\n", indent, "-n");
+  printf("%s%s%s%" PRId64 "\n", indent, indent, "Number of rows inserted by each thread, default is ", rowsPerThread);
+  printf("%s%s\n", indent, "-r");
+  printf("%s%s%s%" PRId64 "\n", indent, indent, "Number of rows in each insert, default is ", rowsPerInsert);
+
+  exit(EXIT_SUCCESS);
+}
+
+void shellParseArgument(int argc, char *argv[]) {
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+      printHelp();
+      exit(0);
+    } else if (strcmp(argv[i], "-d") == 0) {
+      strcpy(dbName, argv[++i]);
+    } else if (strcmp(argv[i], "-c") == 0) {
+      strcpy(configDir, argv[++i]);
+    } else if (strcmp(argv[i], "-s") == 0) {
+      strcpy(stableName, argv[++i]);
+    } else if (strcmp(argv[i], "-t") == 0) {
+      numOfThreads = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0) {
+      rowsPerThread = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-r") == 0) {
+      rowsPerInsert = atoi(argv[++i]);
+    } else {
+    }
+  }
+
+  if (numOfThreads < 1) numOfThreads = 1;
+  if (rowsPerInsert < 1) rowsPerInsert = 1;
+
+  pPrint("%snumOfThreads:%" PRId64 "%s", GREEN, numOfThreads, NC);
+  pPrint("%srowsPerThread:%" PRId64 "%s", GREEN, rowsPerThread, NC);
+  pPrint("%srowsPerInsert:%" PRId64 "%s", GREEN, rowsPerInsert, NC);
+  pPrint("%sdbName:%s%s", GREEN, dbName, NC);
+  pPrint("%sstableName:%s%s", GREEN, stableName, NC);
+  pPrint("%sstart to run%s", GREEN, NC);
+}
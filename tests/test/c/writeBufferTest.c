@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _DEFAULT_SOURCE
+#include "os.h"
+#include "taos.h"
+#include "taoserror.h"
+#include "tulog.h"
+#include "ttime.h"
+#include "tutil.h"
+#include "tglobal.h"
+
+#define GREEN "\033[1;32m"
+#define NC "\033[0m"
+
+#define LARGE_INSERT_ROWS 200
+
+typedef struct {
+  int32_t numOfRows;  // rows in the insert
+  int32_t code;       // given to the callback
+} SInsert;
+
+void  shellParseArgument(int argc, char *argv[]);
+TAOS *connectDb();
+void  execute(TAOS *con, char *qstr);
+void  checkOrder(TAOS *con);
+void  checkError(TAOS *con);
+void *loadTest(void *param);
+
+int64_t numOfRounds = 50;
+int64_t insertsPerRound = 8;
+int64_t numOfLoaders = 8;
+char    dbName[32] = "wbdb";
+
+int32_t numOfFinished = 0;
+int32_t stopLoaders = 0;
+int64_t startTs = 1500000000000;
+
+int main(int argc, char *argv[]) {
+  shellParseArgument(argc, argv);
+
+  // the large inserts are sent in the messages by themselves
+  tsWriteBuffer = 1;
+  tsWriteBufferSize = 1024;
+  taos_init();
+
+  // the connection is made before the other callers start
+  TAOS *con = connectDb();
+  char  qstr[256];
+  sprintf(qstr, "create database if not exists %s", dbName);
+  execute(con, qstr);
+
+  pthread_t *loaders = calloc(numOfLoaders, sizeof(pthread_t));
+  for (int64_t i = 0; i < numOfLoaders; ++i) {
+    pthread_create(loaders + i, NULL, loadTest, (void *)i);
+  }
+
+  checkOrder(con);
+  checkError(con);
+
+  atomic_store_32(&stopLoaders, 1);
+  for (int64_t i = 0; i < numOfLoaders; ++i) {
+    pthread_join(loaders[i], NULL);
+  }
+  free(loaders);
+  taos_close(con);
+
+  pPrint("%sall checks passed%s", GREEN, NC);
+  return 0;
+}
+
+TAOS *connectDb() {
+  char     fqdn[TSDB_FQDN_LEN];
+  uint16_t port;
+
+  taosGetFqdnPortFromEp(tsFirst, fqdn, &port);
+
+  TAOS *con = taos_connect(fqdn, tsDefaultUser, tsDefaultPass, NULL, port);
+  if (con == NULL) {
+    pError("failed to connect to DB, reason:%s", taos_errstr(con));
+    exit(1);
+  }
+
+  return con;
+}
+
+void execute(TAOS *con, char *qstr) {
+  if (taos_query(con, qstr)) {
+    pError("failed to run sql:%s, reason:%s", qstr, taos_errstr(con));
+    exit(1);
+  }
+}
+
+int64_t queryValue(TAOS *con, char *qstr) {
+  execute(con, qstr);
+
+  TAOS_RES *result = taos_use_result(con);
+  TAOS_ROW  row = taos_fetch_row(result);
+  int       type = taos_fetch_fields(result)[0].type;
+  int64_t   value = -1;
+  if (row != NULL) {
+    value = (type == TSDB_DATA_TYPE_BIGINT) ? *(int64_t *)row[0] : *(int32_t *)row[0];
+  }
+
+  taos_free_result(result);
+  return value;
+}
+
+// the inserts of other callers keep the submit messages to the vgroup in flight, so the checked ones wait in the buffer
+void *loadTest(void *param) {
+  int64_t index = (int64_t)param;
+  TAOS *  con = connectDb();
+  char    qstr[256];
+  int64_t ts = startTs;
+
+  sprintf(qstr, "create table if not exists %s.lt%" PRId64 " (ts timestamp, v int)", dbName, index);
+  execute(con, qstr);
+
+  while (atomic_load_32(&stopLoaders) == 0) {
+    sprintf(qstr, "insert into %s.lt%" PRId64 " values(%" PRId64 ", 0)", dbName, index, ts++);
+    execute(con, qstr);
+  }
+
+  taos_close(con);
+  return NULL;
+}
+
+void insertCallback(void *param, TAOS_RES *tres, int code) {
+  SInsert *pInsert = param;
+  pInsert->code = code;
+  atomic_add_fetch_32(&numOfFinished, 1);
+}
+
+// the inserts are issued one by one without waiting, so they are put into the write buffer in this order
+void insertAsync(TAOS *con, char **sqls, SInsert *pInserts, int32_t numOfInserts) {
+  atomic_store_32(&numOfFinished, 0);
+
+  for (int32_t i = 0; i < numOfInserts; ++i) {
+    taos_query_a(con, sqls[i], insertCallback, pInserts + i);
+  }
+
+  while (atomic_load_32(&numOfFinished) < numOfInserts) {
+    taosMsleep(1);
+  }
+}
+
+/*
+ * The first insert of each round is in flight while the others wait in the buffer. The others write the same key and
+ * the value of the first one written is kept, so they must be written in the order they are issued, including the
+ * large ones which are sent in the messages by themselves.
+ */
+void checkOrder(TAOS *con) {
+  char qstr[256];
+
+  sprintf(qstr, "create table if not exists %s.ot (ts timestamp, v int)", dbName);
+  execute(con, qstr);
+
+  // the meta of the table is cached, so the inserts are parsed and sent by this thread in order
+  sprintf(qstr, "insert into %s.ot values(%" PRId64 ", -1)", dbName, startTs - 1);
+  execute(con, qstr);
+
+  char ** sqls = calloc(insertsPerRound, POINTER_BYTES);
+  SInsert *pInserts = calloc(insertsPerRound, sizeof(SInsert));
+  for (int32_t k = 0; k < insertsPerRound; ++k) {
+    sqls[k] = malloc(LARGE_INSERT_ROWS * 40 + 128);
+  }
+
+  int64_t expectedRows = 1;
+  int64_t ts = startTs + numOfRounds;
+
+  for (int64_t r = 0; r < numOfRounds; ++r) {
+    for (int32_t k = 0; k < insertsPerRound; ++k) {
+      int len = sprintf(sqls[k], "insert into %s.ot values(%" PRId64 ", %d)", dbName, (k == 0) ? ts++ : startTs + r, k);
+      pInserts[k].numOfRows = 1;
+
+      if (k % 3 == 2) {
+        for (int32_t i = 0; i < LARGE_INSERT_ROWS; ++i) {
+          len += sprintf(sqls[k] + len, " (%" PRId64 ", %d)", ts++, k);
+        }
+        pInserts[k].numOfRows += LARGE_INSERT_ROWS;
+        expectedRows += LARGE_INSERT_ROWS;
+      }
+    }
+
+    expectedRows += (insertsPerRound > 1) ? 2 : 1;
+    insertAsync(con, sqls, pInserts, insertsPerRound);
+
+    // each insert is notified with its own rows
+    for (int32_t k = 0; k < insertsPerRound; ++k) {
+      if (pInserts[k].code != pInserts[k].numOfRows) {
+        pError("round:%" PRId64 " insert:%d, affected rows:%d, expected:%d", r, k, pInserts[k].code,
+               pInserts[k].numOfRows);
+        exit(1);
+      }
+    }
+
+    if (insertsPerRound == 1) continue;
+
+    sprintf(qstr, "select v from %s.ot where ts = %" PRId64, dbName, startTs + r);
+    int64_t value = queryValue(con, qstr);
+    if (value != 1) {
+      pError("round:%" PRId64 ", value:%" PRId64 " is kept, the inserts are written out of order", r, value);
+      exit(1);
+    }
+  }
+
+  sprintf(qstr, "select count(*) from %s.ot", dbName);
+  int64_t count = queryValue(con, qstr);
+  if (count != expectedRows) {
+    pError("rows in table:%" PRId64 ", expected:%" PRId64, count, expectedRows);
+    exit(1);
+  }
+
+  for (int32_t k = 0; k < insertsPerRound; ++k) {
+    free(sqls[k]);
+  }
+  free(sqls);
+  free(pInserts);
+
+  pPrint("%s%" PRId64 " rounds of inserts are written in order, rows:%" PRId64 "%s", GREEN, numOfRounds, count, NC);
+}
+
+// the coalesced submit fails, each insert gets its own result once they are sent one by one
+void checkError(TAOS *con) {
+  char qstr[256];
+
+  sprintf(qstr, "create table if not exists %s.et (ts timestamp, v int)", dbName);
+  execute(con, qstr);
+  sprintf(qstr, "insert into %s.et values(%" PRId64 ", 0)", dbName, startTs);
+  execute(con, qstr);
+
+  int64_t now = taosGetTimestampMs();
+  int64_t outOfRange = now + 365 * 86400000L;  // later than the days of a file from now
+
+  char    sqls[4][256];
+  char *  pSqls[4] = {sqls[0], sqls[1], sqls[2], sqls[3]};
+  SInsert inserts[4] = {{.numOfRows = 1}, {.numOfRows = 1}, {.numOfRows = 1}, {.numOfRows = 2}};
+
+  sprintf(sqls[0], "insert into %s.et values(%" PRId64 ", 1)", dbName, now);
+  sprintf(sqls[1], "insert into %s.et values(%" PRId64 ", 2)", dbName, now + 1);
+  sprintf(sqls[2], "insert into %s.et values(%" PRId64 ", 3)", dbName, outOfRange);
+  sprintf(sqls[3], "insert into %s.et values(%" PRId64 ", 4) (%" PRId64 ", 5)", dbName, now + 2, now + 3);
+
+  insertAsync(con, pSqls, inserts, 4);
+
+  for (int32_t i = 0; i < 4; ++i) {
+    int32_t expected = (i == 2) ? TSDB_CODE_TIMESTAMP_OUT_OF_RANGE : inserts[i].numOfRows;
+    if (inserts[i].code != expected) {
+      pError("insert:%d, code:0x%x, expected:0x%x", i, inserts[i].code, expected);
+      exit(1);
+    }
+  }
+
+  sprintf(qstr, "select count(*) from %s.et", dbName);
+  int64_t count = queryValue(con, qstr);
+  if (count != 5) {
+    pError("rows in table:%" PRId64 ", expected:5", count);
+    exit(1);
+  }
+
+  pPrint("%sthe error of the failed insert is reported to its own caller%s", GREEN, NC);
+}
+
+void printHelp() {
+  char indent[10] = "        ";
+  printf("Used to check the order, affected rows and errors of the inserts coalesced by the write buffer\n");
+
+  printf("%s%s\n", indent, "-d");
+  printf("%s%s%s%s\n", indent, indent, "The name of the database to be created, default is ", dbName);
+  printf("%s%s\n", indent, "-c");
+  printf("%s%s%s%s\n", indent, indent, "Configuration directory, default is ", configDir);
+  printf("%s%s\n", indent, "-n");
+  printf("%s%s%s%" PRId64 "\n", indent, indent, "Number of rounds, default is ", numOfRounds);
+  printf("%s%s\n", indent, "-i");
+  printf("%s%s%s%" PRId64 "\n", indent, indent, "Number of inserts in each round, default is ", insertsPerRound);
+  printf("%s%s\n", indent, "-t");
+  printf("%s%s%s%" PRId64 "\n", indent, indent, "Number of threads inserting into the other tables, default is ",
+         numOfLoaders);
+
+  exit(EXIT_SUCCESS);
+}
+
+void shellParseArgument(int argc, char *argv[]) {
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+      printHelp();
+      exit(0);
+    } else if (strcmp(argv[i], "-d") == 0) {
+      strcpy(dbName, argv[++i]);
+    } else if (strcmp(argv[i], "-c") == 0) {
+      strcpy(configDir, argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0) {
+      numOfRounds = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-i") == 0) {
+      insertsPerRound = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-t") == 0) {
+      numOfLoaders = atoi(argv[++i]);
+    } else {
+    }
+  }
+
+  if (numOfRounds < 1) numOfRounds = 1;
+  if (insertsPerRound < 1) insertsPerRound = 1;
+  if (numOfLoaders < 0) numOfLoaders = 0;
+
+  pPrint("%snumOfRounds:%" PRId64 "%s", GREEN, numOfRounds, NC);
+  pPrint("%sinsertsPerRound:%" PRId64 "%s", GREEN, insertsPerRound, NC);
+  pPrint("%snumOfLoaders:%" PRId64 "%s", GREEN, numOfLoaders, NC);
+  pPrint("%sdbName:%s%s", GREEN, dbName, NC);
+  pPrint("%sstart to run%s", GREEN, NC);
+}